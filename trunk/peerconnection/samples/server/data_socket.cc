@@ -271,7 +271,9 @@ bool ListeningSocket::Listen(unsigned short port) {
     printf("bind failed\n");
     return false;
   }
-  return listen(socket_, 5) != SOCKET_ERROR;
+  // Many peers may connect at the same time when the server is used for
+  // load tests.
+  return listen(socket_, SOMAXCONN) != SOCKET_ERROR;
 }
 
 DataSocket* ListeningSocket::Accept() const {
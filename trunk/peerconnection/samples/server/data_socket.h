@@ -19,6 +19,7 @@ typedef int socklen_t;
 #include <netinet/in.h>
 #include <sys/select.h>
 #include <sys/socket.h>
+#include <unistd.h>
 #define closesocket close
 #endif
 
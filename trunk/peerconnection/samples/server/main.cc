@@ -12,13 +12,27 @@
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(__linux__)
+#include <errno.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <set>
+#else
 #include <vector>
+#endif
 
 #include "peerconnection/samples/server/data_socket.h"
 #include "peerconnection/samples/server/peer_channel.h"
 #include "peerconnection/samples/server/utils.h"
 
+#if defined(__linux__)
+// The most events handled per epoll_wait() call.
+static const int kMaxEvents = 256;
+#else
 static const size_t kMaxConnections = (FD_SETSIZE - 2);
+#endif
 
 void HandleBrowserRequest(DataSocket* ds, bool* quit) {
   assert(ds && ds->valid());
@@ -45,30 +59,146 @@ void HandleBrowserRequest(DataSocket* ds, bool* quit) {
   }
 }
 
-int main(int argc, char** argv) {
-  // TODO(tommi): make configurable.
-  static const unsigned short port = 8888;
+// Reads the data available on |s| and handles the request once all of it
+// has been received.  Returns true if the socket should be closed.  |quit|
+// is set if the request asks the server to quit.
+bool HandleSocketData(DataSocket* s, PeerChannel* clients, bool* quit) {
+  assert(s && clients && quit);
+  bool socket_done = true;
+  if (s->OnDataAvailable(&socket_done) && s->request_received()) {
+    ChannelMember* member = clients->Lookup(s);
+    if (member || PeerChannel::IsPeerConnection(s)) {
+      if (!member) {
+        if (s->PathEquals("/sign_in")) {
+          clients->AddMember(s);
+        } else {
+          printf("No member found for: %s\n",
+              s->request_path().c_str());
+          s->Send("500 Error", true, "text/plain", "",
+                  "Peer most likely gone.");
+        }
+      } else if (member->is_wait_request(s)) {
+        // no need to do anything.
+        socket_done = false;
+      } else {
+        ChannelMember* target = clients->IsTargetedRequest(s);
+        if (target) {
+          member->ForwardRequestToPeer(s, target);
+        } else if (s->PathEquals("/sign_out")) {
+          s->Send("200 OK", true, "text/plain", "", "");
+        } else {
+          printf("Couldn't find target for request: %s\n",
+              s->request_path().c_str());
+          s->Send("500 Error", true, "text/plain", "",
+                  "Peer most likely gone.");
+        }
+      }
+    } else {
+      HandleBrowserRequest(s, quit);
+    }
+  }
+  return socket_done;
+}
 
-  ListeningSocket listener;
-  if (!listener.Create()) {
-    printf("Failed to create server socket\n");
-    return -1;
-  } else if (!listener.Listen(port)) {
-    printf("Failed to listen on server socket\n");
-    return -1;
+#if defined(__linux__)
+
+// Unlike select(), epoll isn't limited to FD_SETSIZE sockets and only reports
+// the sockets that are ready, so the loop scales to thousands of peers.
+void RunEventLoop(ListeningSocket* listener, PeerChannel* clients) {
+  // Allow as many connections as the hard limit of open files permits.
+  struct rlimit limit;
+  if (getrlimit(RLIMIT_NOFILE, &limit) == 0 &&
+      limit.rlim_cur < limit.rlim_max) {
+    limit.rlim_cur = limit.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &limit);
   }
 
-  printf("Server listening on port %i\n", port);
+  int epoll_fd = epoll_create(kMaxEvents);
+  if (epoll_fd == SOCKET_ERROR) {
+    printf("epoll_create failed\n");
+    return;
+  }
 
-  PeerChannel clients;
+  // Each event carries its DataSocket, or NULL for the listening socket.
+  struct epoll_event event;
+  memset(&event, 0, sizeof(event));
+  event.events = EPOLLIN;
+  event.data.ptr = NULL;
+  if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, listener->socket(),
+                &event) == SOCKET_ERROR) {
+    printf("epoll_ctl failed\n");
+    close(epoll_fd);
+    return;
+  }
+
+  typedef std::set<DataSocket*> SocketSet;
+  SocketSet sockets;
+  struct epoll_event events[kMaxEvents];
+  bool quit = false;
+  while (!quit) {
+    int count = epoll_wait(epoll_fd, events, kMaxEvents, 10 * 1000);
+    if (count == SOCKET_ERROR) {
+      if (errno == EINTR)
+        continue;
+      printf("epoll_wait failed\n");
+      break;
+    }
+
+    for (int i = 0; i < count; ++i) {
+      DataSocket* s = static_cast<DataSocket*>(events[i].data.ptr);
+      if (!s) {
+        if (!listener->valid())
+          continue;
+        s = listener->Accept();
+        if (!s)
+          continue;
+        event.data.ptr = s;
+        if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, s->socket(),
+                      &event) == SOCKET_ERROR) {
+          delete s;
+          printf("Connection limit reached\n");
+        } else {
+          sockets.insert(s);
+          printf("New connection...\n");
+        }
+        continue;
+      }
+
+      if (HandleSocketData(s, clients, &quit)) {
+        printf("Disconnecting socket\n");
+        clients->OnClosing(s);
+        assert(s->valid());  // Close must not have been called yet.
+        epoll_ctl(epoll_fd, EPOLL_CTL_DEL, s->socket(), &event);
+        sockets.erase(s);
+        delete s;
+      }
+
+      if (quit && listener->valid()) {
+        printf("Quitting...\n");
+        listener->Close();
+        clients->CloseAll();
+      }
+    }
+
+    clients->CheckForTimeout();
+  }
+
+  for (SocketSet::iterator i = sockets.begin(); i != sockets.end(); ++i)
+    delete (*i);
+  close(epoll_fd);
+}
+
+#else  // defined(__linux__)
+
+void RunEventLoop(ListeningSocket* listener, PeerChannel* clients) {
   typedef std::vector<DataSocket*> SocketArray;
   SocketArray sockets;
   bool quit = false;
   while (!quit) {
     fd_set socket_set;
     FD_ZERO(&socket_set);
-    if (listener.valid())
-      FD_SET(listener.socket(), &socket_set);
+    if (listener->valid())
+      FD_SET(listener->socket(), &socket_set);
 
     for (SocketArray::iterator i = sockets.begin(); i != sockets.end(); ++i)
       FD_SET((*i)->socket(), &socket_set);
@@ -81,53 +211,20 @@ int main(int argc, char** argv) {
 
     for (SocketArray::iterator i = sockets.begin(); i != sockets.end(); ++i) {
       DataSocket* s = *i;
-      bool socket_done = true;
+      bool socket_done = false;
       if (FD_ISSET(s->socket(), &socket_set)) {
-        if (s->OnDataAvailable(&socket_done) && s->request_received()) {
-          ChannelMember* member = clients.Lookup(s);
-          if (member || PeerChannel::IsPeerConnection(s)) {
-            if (!member) {
-              if (s->PathEquals("/sign_in")) {
-                clients.AddMember(s);
-              } else {
-                printf("No member found for: %s\n",
-                    s->request_path().c_str());
-                s->Send("500 Error", true, "text/plain", "",
-                        "Peer most likely gone.");
-              }
-            } else if (member->is_wait_request(s)) {
-              // no need to do anything.
-              socket_done = false;
-            } else {
-              ChannelMember* target = clients.IsTargetedRequest(s);
-              if (target) {
-                member->ForwardRequestToPeer(s, target);
-              } else if (s->PathEquals("/sign_out")) {
-                s->Send("200 OK", true, "text/plain", "", "");
-              } else {
-                printf("Couldn't find target for request: %s\n",
-                    s->request_path().c_str());
-                s->Send("500 Error", true, "text/plain", "",
-                        "Peer most likely gone.");
-              }
-            }
-          } else {
-            HandleBrowserRequest(s, &quit);
-            if (quit) {
-              printf("Quitting...\n");
-              FD_CLR(listener.socket(), &socket_set);
-              listener.Close();
-              clients.CloseAll();
-            }
-          }
+        socket_done = HandleSocketData(s, clients, &quit);
+        if (quit && listener->valid()) {
+          printf("Quitting...\n");
+          FD_CLR(listener->socket(), &socket_set);
+          listener->Close();
+          clients->CloseAll();
         }
-      } else {
-        socket_done = false;
       }
 
       if (socket_done) {
         printf("Disconnecting socket\n");
-        clients.OnClosing(s);
+        clients->OnClosing(s);
         assert(s->valid());  // Close must not have been called yet.
         FD_CLR(s->socket(), &socket_set);
         delete (*i);
@@ -137,10 +234,12 @@ int main(int argc, char** argv) {
       }
     }
 
-    clients.CheckForTimeout();
+    clients->CheckForTimeout();
 
-    if (FD_ISSET(listener.socket(), &socket_set)) {
-      DataSocket* s = listener.Accept();
+    if (listener->valid() && FD_ISSET(listener->socket(), &socket_set)) {
+      DataSocket* s = listener->Accept();
+      if (!s)
+        continue;
       if (sockets.size() >= kMaxConnections) {
         delete s;  // sorry, that's all we can take.
         printf("Connection limit reached\n");
@@ -154,6 +253,27 @@ int main(int argc, char** argv) {
   for (SocketArray::iterator i = sockets.begin(); i != sockets.end(); ++i)
     delete (*i);
   sockets.clear();
+}
+
+#endif  // defined(__linux__)
+
+int main(int argc, char** argv) {
+  // TODO(tommi): make configurable.
+  static const unsigned short port = 8888;
+
+  ListeningSocket listener;
+  if (!listener.Create()) {
+    printf("Failed to create server socket\n");
+    return -1;
+  } else if (!listener.Listen(port)) {
+    printf("Failed to listen on server socket\n");
+    return -1;
+  }
+
+  printf("Server listening on port %i\n", port);
+
+  PeerChannel clients;
+  RunEventLoop(&listener, &clients);
 
   return 0;
 }
@@ -143,7 +143,7 @@ void ChannelMember::SetWaitingSocket(DataSocket* ds) {
   assert(ds->method() == DataSocket::GET);
   if (ds && !queue_.empty()) {
     assert(waiting_socket_ == NULL);
-    const QueuedResponse& response = queue_.back();
+    const QueuedResponse& response = queue_.front();
     ds->Send(response.status, true, response.content_type,
              response.extra_headers, response.data);
     queue_.pop();
@@ -164,7 +164,7 @@ bool PeerChannel::IsPeerConnection(const DataSocket* ds) {
          (ds->method() == DataSocket::GET && ds->PathEquals("/sign_in"));
 }
 
-ChannelMember* PeerChannel::Lookup(DataSocket* ds) const {
+ChannelMember* PeerChannel::Lookup(DataSocket* ds) {
   assert(ds);
 
   if (ds->method() != DataSocket::GET && ds->method() != DataSocket::POST)
@@ -186,18 +186,19 @@ ChannelMember* PeerChannel::Lookup(DataSocket* ds) const {
     return NULL;
 
   int id = atoi(&args[found + ARRAYSIZE(kPeerId) - 1]);
-  Members::const_iterator iter = members_.begin();
-  for (; iter != members_.end(); ++iter) {
-    if (id == (*iter)->id()) {
-      if (i == kWait)
-        (*iter)->SetWaitingSocket(ds);
-      if (i == kSignOut)
-        (*iter)->set_disconnected();
-      return *iter;
-    }
-  }
+  ChannelMember* member = Find(id);
+  if (!member)
+    return NULL;
 
-  return NULL;
+  if (i == kWait) {
+    member->SetWaitingSocket(ds);
+    waiting_sockets_[ds] = id;
+  }
+  if (i == kSignOut && member->connected()) {
+    member->set_disconnected();
+    signed_out_.push_back(member);
+  }
+  return member;
 }
 
 ChannelMember* PeerChannel::IsTargetedRequest(const DataSocket* ds) const {
@@ -221,13 +222,7 @@ ChannelMember* PeerChannel::IsTargetedRequest(const DataSocket* ds) const {
     args = found + ARRAYSIZE(kTargetPeerIdParam) - 1;
   } while (true);
   int id = atoi(&path[found]);
-  Members::const_iterator i = members_.begin();
-  for (; i != members_.end(); ++i) {
-    if ((*i)->id() == id) {
-      return *i;
-    }
-  }
-  return NULL;
+  return Find(id);
 }
 
 bool PeerChannel::AddMember(DataSocket* ds) {
@@ -237,6 +232,7 @@ bool PeerChannel::AddMember(DataSocket* ds) {
   BroadcastChangedState(*new_guy, &failures);
   HandleDeliveryFailures(&failures);
   members_.push_back(new_guy);
+  members_by_id_[new_guy->id()] = new_guy;
 
   printf("New member added (total=%s): %s\n",
       size_t2str(members_.size()).c_str(), new_guy->name().c_str());
@@ -258,28 +254,39 @@ void PeerChannel::CloseAll() {
 }
 
 void PeerChannel::OnClosing(DataSocket* ds) {
-  for (Members::iterator i = members_.begin(); i != members_.end(); ++i) {
-    ChannelMember* m = (*i);
-    m->OnClosing(ds);
-    if (!m->connected()) {
-      i = members_.erase(i);
-      Members failures;
-      BroadcastChangedState(*m, &failures);
-      HandleDeliveryFailures(&failures);
-      delete m;
-      if (i == members_.end())
-        break;
-    }
+  WaitingSockets::iterator waiting = waiting_sockets_.find(ds);
+  if (waiting != waiting_sockets_.end()) {
+    ChannelMember* m = Find(waiting->second);
+    if (m)
+      m->OnClosing(ds);
+    waiting_sockets_.erase(waiting);
+  }
+
+  while (!signed_out_.empty()) {
+    ChannelMember* m = signed_out_.back();
+    signed_out_.pop_back();
+    RemoveMember(m);
+    Members failures;
+    BroadcastChangedState(*m, &failures);
+    HandleDeliveryFailures(&failures);
+    delete m;
   }
   printf("Total connected: %s\n", size_t2str(members_.size()).c_str());
 }
 
 void PeerChannel::CheckForTimeout() {
+  time_t now = time(NULL);
+  if (now == last_timeout_check_)
+    return;
+  last_timeout_check_ = now;
+
   for (Members::iterator i = members_.begin(); i != members_.end(); ++i) {
     ChannelMember* m = (*i);
-    if (m->TimedOut()) {
+    // Members that have signed out are removed by OnClosing.
+    if (m->connected() && m->TimedOut()) {
       printf("Timeout: %s\n", m->name().c_str());
       m->set_disconnected();
+      members_by_id_.erase(m->id());
       i = members_.erase(i);
       Members failures;
       BroadcastChangedState(*m, &failures);
@@ -291,10 +298,25 @@ void PeerChannel::CheckForTimeout() {
   }
 }
 
+ChannelMember* PeerChannel::Find(int id) const {
+  MembersById::const_iterator found = members_by_id_.find(id);
+  return found != members_by_id_.end() ? found->second : NULL;
+}
+
+void PeerChannel::RemoveMember(ChannelMember* member) {
+  Members::iterator i = std::find(members_.begin(), members_.end(), member);
+  if (i != members_.end())
+    members_.erase(i);
+  members_by_id_.erase(member->id());
+}
+
 void PeerChannel::DeleteAll() {
   for (Members::iterator i = members_.begin(); i != members_.end(); ++i)
     delete (*i);
   members_.clear();
+  members_by_id_.clear();
+  waiting_sockets_.clear();
+  signed_out_.clear();
 }
 
 void PeerChannel::BroadcastChangedState(const ChannelMember& member,
@@ -312,6 +334,7 @@ void PeerChannel::BroadcastChangedState(const ChannelMember& member,
       if (!(*i)->NotifyOfOtherMember(member)) {
         (*i)->set_disconnected();
         delivery_failures->push_back(*i);
+        members_by_id_.erase((*i)->id());
         i = members_.erase(i);
         if (i == members_.end())
           break;
@@ -18,6 +18,12 @@
 #include <string>
 #include <vector>
 
+#ifdef WIN32
+#include <unordered_map>
+#else
+#include <tr1/unordered_map>
+#endif
+
 class DataSocket;
 
 // Represents a single peer connected to the server.
@@ -69,7 +75,7 @@ class PeerChannel {
  public:
   typedef std::vector<ChannelMember*> Members;
 
-  PeerChannel() {
+  PeerChannel() : last_timeout_check_(0) {
   }
 
   ~PeerChannel() {
@@ -83,7 +89,7 @@ class PeerChannel {
   static bool IsPeerConnection(const DataSocket* ds);
 
   // Finds a connected peer that's associated with the |ds| socket.
-  ChannelMember* Lookup(DataSocket* ds) const;
+  ChannelMember* Lookup(DataSocket* ds);
 
   // Checks if the request has a "peer_id" parameter and if so, looks up the
   // peer for which the request is targeted at.
@@ -101,9 +107,21 @@ class PeerChannel {
   // connection went dead).
   void OnClosing(DataSocket* ds);
 
+  // Removes peers that haven't had a pending wait request for 30 seconds.
+  // Looks at the peers at most once per second.
   void CheckForTimeout();
 
  protected:
+  typedef std::tr1::unordered_map<int, ChannelMember*> MembersById;
+  typedef std::tr1::unordered_map<const DataSocket*, int> WaitingSockets;
+
+  // Returns the member with the given |id|, or NULL.
+  ChannelMember* Find(int id) const;
+
+  // Removes |member| from members_ and the lookup tables, but doesn't
+  // delete it.
+  void RemoveMember(ChannelMember* member);
+
   void DeleteAll();
   void BroadcastChangedState(const ChannelMember& member,
                              Members* delivery_failures);
@@ -114,7 +132,15 @@ class PeerChannel {
                                         std::string* content_type);
 
  protected:
+  // In the order the members signed in.
   Members members_;
+  MembersById members_by_id_;
+  // The id of the member that each pending wait request belongs to.  An entry
+  // stays until its socket closes, also when the request has been answered.
+  WaitingSockets waiting_sockets_;
+  // Members that have signed out.  They're removed when a socket closes.
+  Members signed_out_;
+  time_t last_timeout_check_;
 };
 
 #endif  // PEERCONNECTION_SAMPLES_SERVER_PEER_CHANNEL_H_
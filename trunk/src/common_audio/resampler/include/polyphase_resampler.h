@@ -0,0 +1,70 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+
+/*
+ * A single-stage resampler for arbitrary rational ratios, e.g. 44.1 kHz to
+ * 48 kHz, using a polyphase FIR filter bank.
+ */
+
+#ifndef WEBRTC_RESAMPLER_POLYPHASE_RESAMPLER_H_
+#define WEBRTC_RESAMPLER_POLYPHASE_RESAMPLER_H_
+
+#include "typedefs.h"
+
+namespace webrtc
+{
+
+class PolyphaseResampler
+{
+public:
+    // Number of filter taps applied per output sample.
+    enum { kTapsPerPhase = 32 };
+    // Largest supported interpolation factor after reducing the rates with
+    // their GCD; 44.1 kHz <-> 48 kHz needs 160.
+    enum { kMaxPhases = 1024 };
+
+    PolyphaseResampler();
+    ~PolyphaseResampler();
+
+    // Computes the filter bank for inFreq -> outFreq and clears the history.
+    // Returns -1 if the ratio needs more than kMaxPhases phases.
+    int Reset(int inFreq, int outFreq);
+
+    // Resamples lengthIn mono samples. Since the filter state carries over
+    // between calls, outLen is lengthIn * outFreq / inFreq rounded up or
+    // down so that the total output count stays exact; for 10 ms blocks of
+    // rates that are multiples of 100 Hz it is always the exact value.
+    // Returns -1 if more than maxLen samples would be produced.
+    int Push(const WebRtc_Word16* samplesIn, int lengthIn,
+             WebRtc_Word16* samplesOut, int maxLen, int &outLen);
+
+private:
+    // kTapsPerPhase coefficients in Q14 for each of the interp_ phases,
+    // ordered so that each phase is a forward dot product with the input.
+    WebRtc_Word16* filter_bank_;
+
+    // The last kTapsPerPhase - 1 input samples followed by the new input.
+    WebRtc_Word16* buffer_;
+    int buffer_size_;
+    int buffer_size_max_;
+
+    // Rates reduced by their GCD: interp_ output samples per decim_ input.
+    int interp_;
+    int decim_;
+
+    // Position of the next output sample in units of 1 / interp_ input
+    // samples, counted from the first sample of its filter window.
+    int position_;
+};
+
+} // namespace webrtc
+
+#endif // WEBRTC_RESAMPLER_POLYPHASE_RESAMPLER_H_
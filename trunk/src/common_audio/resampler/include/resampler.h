@@ -21,6 +21,8 @@
 namespace webrtc
 {
 
+class PolyphaseResampler;
+
 // TODO(andrew): the implementation depends on the exact values of this enum.
 // It should be rewritten in a less fragile way.
 enum ResamplerType
@@ -58,7 +60,9 @@ enum ResamplerMode
     kResamplerMode3To2,
     kResamplerMode11To2,
     kResamplerMode11To4,
-    kResamplerMode11To8
+    kResamplerMode11To8,
+    // Any other ratio, in a single polyphase stage.
+    kResamplerModePolyphase
 };
 
 class Resampler
@@ -91,6 +95,7 @@ private:
     void* state1_;
     void* state2_;
     void* state3_;
+    PolyphaseResampler* polyphase_;
 
     // Storage if needed
     WebRtc_Word16* in_buffer_;
@@ -101,6 +106,8 @@ private:
     int out_buffer_size_max_;
 
     // State
+    int my_in_frequency_hz_;
+    int my_out_frequency_hz_;
     int my_in_frequency_khz_;
     int my_out_frequency_khz_;
     ResamplerMode my_mode_;
@@ -0,0 +1,255 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+
+/*
+ * A single-stage resampler for arbitrary rational ratios, e.g. 44.1 kHz to
+ * 48 kHz, using a polyphase FIR filter bank.
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(WEBRTC_USE_SSE2)
+#include <emmintrin.h>
+#elif defined(WEBRTC_ARCH_ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#include "signal_processing_library.h"
+#include "polyphase_resampler.h"
+
+namespace webrtc
+{
+
+namespace
+{
+
+const int kTaps = PolyphaseResampler::kTapsPerPhase;
+
+const double kPi = 3.14159265358979323846;
+
+// Cutoff relative to the Nyquist frequency of the lower of the two rates.
+const double kCutoff = 0.9;
+// Kaiser window shape, roughly 60 dB stopband attenuation.
+const double kKaiserBeta = 6.0;
+
+// Zeroth order modified Bessel function of the first kind.
+double BesselI0(double x)
+{
+    double sum = 1.0;
+    double term = 1.0;
+    for (int k = 1; k < 32; k++)
+    {
+        term *= (x / (2.0 * k)) * (x / (2.0 * k));
+        sum += term;
+    }
+    return sum;
+}
+
+// Returns the Q14 dot product of kTaps input samples and coefficients.
+inline WebRtc_Word32 FilterPhase(const WebRtc_Word16* x,
+                                 const WebRtc_Word16* h)
+{
+#if defined(WEBRTC_USE_SSE2)
+    __m128i acc = _mm_setzero_si128();
+    for (int i = 0; i < kTaps; i += 8)
+    {
+        const __m128i x8 =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(&x[i]));
+        const __m128i h8 =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(&h[i]));
+        acc = _mm_add_epi32(acc, _mm_madd_epi16(x8, h8));
+    }
+    acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(1, 0, 3, 2)));
+    acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(acc);
+#elif defined(WEBRTC_ARCH_ARM_NEON)
+    int32x4_t acc = vdupq_n_s32(0);
+    for (int i = 0; i < kTaps; i += 4)
+    {
+        acc = vmlal_s16(acc, vld1_s16(&x[i]), vld1_s16(&h[i]));
+    }
+    int32x2_t sum = vadd_s32(vget_low_s32(acc), vget_high_s32(acc));
+    sum = vpadd_s32(sum, sum);
+    return vget_lane_s32(sum, 0);
+#else
+    WebRtc_Word32 acc = 0;
+    for (int i = 0; i < kTaps; i++)
+    {
+        acc += x[i] * h[i];
+    }
+    return acc;
+#endif
+}
+
+} // namespace
+
+PolyphaseResampler::PolyphaseResampler()
+    : filter_bank_(NULL),
+      buffer_(NULL),
+      buffer_size_(0),
+      buffer_size_max_(0),
+      interp_(1),
+      decim_(1),
+      position_(0)
+{
+}
+
+PolyphaseResampler::~PolyphaseResampler()
+{
+    if (filter_bank_)
+    {
+        free(filter_bank_);
+    }
+    if (buffer_)
+    {
+        free(buffer_);
+    }
+}
+
+int PolyphaseResampler::Reset(int inFreq, int outFreq)
+{
+    if (inFreq <= 0 || outFreq <= 0)
+    {
+        return -1;
+    }
+
+    // Euclid's algorithm to find the gcd.
+    int a = inFreq;
+    int b = outFreq;
+    int c = a % b;
+    while (c != 0)
+    {
+        a = b;
+        b = c;
+        c = a % b;
+    }
+    if (outFreq / b > kMaxPhases)
+    {
+        return -1;
+    }
+    interp_ = outFreq / b;
+    decim_ = inFreq / b;
+
+    // Windowed sinc prototype at interp_ times the input rate. Its cutoff is
+    // below the Nyquist frequency of both rates, so the same filter does
+    // anti-imaging and anti-aliasing.
+    const int length = kTaps * interp_;
+    const double center = (length - 1) / 2.0;
+    const double cutoff = 0.5 * kCutoff /
+        (interp_ > decim_ ? interp_ : decim_);
+    const double window_norm = BesselI0(kKaiserBeta);
+
+    double* prototype = static_cast<double*>(malloc(length * sizeof(double)));
+    for (int i = 0; i < length; i++)
+    {
+        const double t = i - center;
+        const double r = t / (center + 1.0);
+        const double window = BesselI0(kKaiserBeta * sqrt(1.0 - r * r)) /
+            window_norm;
+        const double arg = 2.0 * kPi * cutoff * t;
+        const double sinc = (t == 0.0) ? 1.0 : sin(arg) / arg;
+        prototype[i] = 2.0 * cutoff * sinc * window;
+    }
+
+    // Split into phases. Each phase is normalized to unity DC gain, which
+    // also compensates for the interp_ zeros stuffed between input samples.
+    filter_bank_ = static_cast<WebRtc_Word16*>(
+        realloc(filter_bank_, length * sizeof(WebRtc_Word16)));
+    for (int phase = 0; phase < interp_; phase++)
+    {
+        double sum = 0.0;
+        for (int k = 0; k < kTaps; k++)
+        {
+            sum += prototype[k * interp_ + phase];
+        }
+        WebRtc_Word16* coefficients = &filter_bank_[phase * kTaps];
+        for (int k = 0; k < kTaps; k++)
+        {
+            // Reverse the taps so that the oldest sample comes first.
+            const double h = prototype[k * interp_ + phase] / sum;
+            coefficients[kTaps - 1 - k] =
+                static_cast<WebRtc_Word16>(floor(h * (1 << 14) + 0.5));
+        }
+    }
+    free(prototype);
+
+    // Start with a zero history, so that the first output sample depends on
+    // the first input sample only.
+    buffer_size_ = kTaps - 1;
+    if (buffer_size_ > buffer_size_max_)
+    {
+        buffer_ = static_cast<WebRtc_Word16*>(
+            realloc(buffer_, buffer_size_ * sizeof(WebRtc_Word16)));
+        buffer_size_max_ = buffer_size_;
+    }
+    memset(buffer_, 0, buffer_size_ * sizeof(WebRtc_Word16));
+    position_ = 0;
+
+    return 0;
+}
+
+int PolyphaseResampler::Push(const WebRtc_Word16* samplesIn, int lengthIn,
+                             WebRtc_Word16* samplesOut, int maxLen,
+                             int &outLen)
+{
+    if (filter_bank_ == NULL || lengthIn < 0)
+    {
+        return -1;
+    }
+
+    // Output sample n can be computed once its last filter tap is buffered,
+    // i.e. while position_ + n * decim_ < (buffered - kTaps + 1) * interp_.
+    const int available = buffer_size_ + lengthIn;
+    const int limit = (available - kTaps + 1) * interp_ - position_;
+    const int numOut = (limit > 0) ? (limit + decim_ - 1) / decim_ : 0;
+    if (numOut > maxLen)
+    {
+        return -1;
+    }
+
+    if (available > buffer_size_max_)
+    {
+        buffer_ = static_cast<WebRtc_Word16*>(
+            realloc(buffer_, available * sizeof(WebRtc_Word16)));
+        buffer_size_max_ = available;
+    }
+    memcpy(buffer_ + buffer_size_, samplesIn,
+           lengthIn * sizeof(WebRtc_Word16));
+    buffer_size_ = available;
+
+    for (int n = 0; n < numOut; n++)
+    {
+        const int start = position_ / interp_;
+        const int phase = position_ - start * interp_;
+        const WebRtc_Word32 acc = FilterPhase(&buffer_[start],
+                                              &filter_bank_[phase * kTaps]);
+        samplesOut[n] = WebRtcSpl_SatW32ToW16((acc + (1 << 13)) >> 14);
+        position_ += decim_;
+    }
+    outLen = numOut;
+
+    // Drop the samples that no later output sample will use.
+    int consumed = position_ / interp_;
+    if (consumed > buffer_size_)
+    {
+        consumed = buffer_size_;
+    }
+    memmove(buffer_, buffer_ + consumed,
+            (buffer_size_ - consumed) * sizeof(WebRtc_Word16));
+    buffer_size_ -= consumed;
+    position_ -= consumed * interp_;
+
+    return 0;
+}
+
+} // namespace webrtc
@@ -17,6 +17,7 @@
 #include <string.h>
 
 #include "signal_processing_library.h"
+#include "polyphase_resampler.h"
 #include "resampler.h"
 
 
@@ -28,6 +29,7 @@ Resampler::Resampler()
     state1_ = NULL;
     state2_ = NULL;
     state3_ = NULL;
+    polyphase_ = NULL;
     in_buffer_ = NULL;
     out_buffer_ = NULL;
     in_buffer_size_ = 0;
@@ -35,6 +37,8 @@ Resampler::Resampler()
     in_buffer_size_max_ = 0;
     out_buffer_size_max_ = 0;
     // we need a reset before we will work
+    my_in_frequency_hz_ = 0;
+    my_out_frequency_hz_ = 0;
     my_in_frequency_khz_ = 0;
     my_out_frequency_khz_ = 0;
     my_mode_ = kResamplerMode1To1;
@@ -48,6 +52,7 @@ Resampler::Resampler(int inFreq, int outFreq, ResamplerType type)
     state1_ = NULL;
     state2_ = NULL;
     state3_ = NULL;
+    polyphase_ = NULL;
     in_buffer_ = NULL;
     out_buffer_ = NULL;
     in_buffer_size_ = 0;
@@ -55,6 +60,8 @@ Resampler::Resampler(int inFreq, int outFreq, ResamplerType type)
     in_buffer_size_max_ = 0;
     out_buffer_size_max_ = 0;
     // we need a reset before we will work
+    my_in_frequency_hz_ = 0;
+    my_out_frequency_hz_ = 0;
     my_in_frequency_khz_ = 0;
     my_out_frequency_khz_ = 0;
     my_mode_ = kResamplerMode1To1;
@@ -79,6 +86,10 @@ Resampler::~Resampler()
     {
         free(state3_);
     }
+    if (polyphase_)
+    {
+        delete polyphase_;
+    }
     if (in_buffer_)
     {
         free(in_buffer_);
@@ -99,10 +110,8 @@ Resampler::~Resampler()
 
 int Resampler::ResetIfNeeded(int inFreq, int outFreq, ResamplerType type)
 {
-    int tmpInFreq_kHz = inFreq / 1000;
-    int tmpOutFreq_kHz = outFreq / 1000;
-
-    if ((tmpInFreq_kHz != my_in_frequency_khz_) || (tmpOutFreq_kHz != my_out_frequency_khz_)
+    // Compare in Hz, so that e.g. 44000 and 44100 are told apart.
+    if ((inFreq != my_in_frequency_hz_) || (outFreq != my_out_frequency_hz_)
             || (type != my_type_))
     {
         return Reset(inFreq, outFreq, type);
@@ -130,6 +139,11 @@ int Resampler::Reset(int inFreq, int outFreq, ResamplerType type)
         free(state3_);
         state3_ = NULL;
     }
+    if (polyphase_)
+    {
+        delete polyphase_;
+        polyphase_ = NULL;
+    }
     if (in_buffer_)
     {
         free(in_buffer_);
@@ -173,6 +187,8 @@ int Resampler::Reset(int inFreq, int outFreq, ResamplerType type)
     // b is now the gcd;
 
     // We need to track what domain we're in.
+    my_in_frequency_hz_ = inFreq;
+    my_out_frequency_hz_ = outFreq;
     my_in_frequency_khz_ = inFreq / 1000;
     my_out_frequency_khz_ = outFreq / 1000;
 
@@ -213,8 +229,8 @@ int Resampler::Reset(int inFreq, int outFreq, ResamplerType type)
                 my_mode_ = kResamplerMode1To12;
                 break;
             default:
-                my_type_ = kResamplerInvalid;
-                return -1;
+                my_mode_ = kResamplerModePolyphase;
+                break;
         }
     } else if (outFreq == 1)
     {
@@ -236,8 +252,8 @@ int Resampler::Reset(int inFreq, int outFreq, ResamplerType type)
                 my_mode_ = kResamplerMode12To1;
                 break;
             default:
-                my_type_ = kResamplerInvalid;
-                return -1;
+                my_mode_ = kResamplerModePolyphase;
+                break;
         }
     } else if ((inFreq == 2) && (outFreq == 3))
     {
@@ -271,8 +287,7 @@ int Resampler::Reset(int inFreq, int outFreq, ResamplerType type)
         my_mode_ = kResamplerMode11To8;
     } else
     {
-        my_type_ = kResamplerInvalid;
-        return -1;
+        my_mode_ = kResamplerModePolyphase;
     }
 
     // Now create the states we need
@@ -421,6 +436,14 @@ int Resampler::Reset(int inFreq, int outFreq, ResamplerType type)
             state1_ = malloc(sizeof(WebRtcSpl_State22khzTo16khz));
             WebRtcSpl_ResetResample22khzTo16khz((WebRtcSpl_State22khzTo16khz *)state1_);
             break;
+        case kResamplerModePolyphase:
+            polyphase_ = new PolyphaseResampler();
+            if (polyphase_->Reset(inFreq, outFreq) != 0)
+            {
+                my_type_ = kResamplerInvalid;
+                return -1;
+            }
+            break;
 
     }
 
@@ -987,6 +1010,9 @@ int Resampler::Push(const WebRtc_Word16 * samplesIn, int lengthIn, WebRtc_Word16
             free(tmp_mem);
             return 0;
             break;
+        case kResamplerModePolyphase:
+            return polyphase_->Push(samplesIn, lengthIn, samplesOut, maxLen,
+                                    outLen);
 
     }
     return 0;
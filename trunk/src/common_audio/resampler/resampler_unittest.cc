@@ -8,8 +8,11 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <math.h>
+
 #include "gtest/gtest.h"
 
+#include "common_audio/resampler/include/polyphase_resampler.h"
 #include "common_audio/resampler/include/resampler.h"
 
 // TODO(andrew): this is a work-in-progress. Many more tests are needed.
@@ -32,23 +35,13 @@ const int kRates[] = {
   16000,
   32000,
   44000,
+  44100,
   48000,
   kMaxRate
 };
 const size_t kRatesSize = sizeof(kRates) / sizeof(*kRates);
 const size_t kDataSize = kMaxRate / 100;
 
-// TODO(andrew): should we be supporting these combinations?
-bool ValidRates(int in_rate, int out_rate) {
-  // Not the most compact notation, for clarity.
-  if ((in_rate == 44000 && (out_rate == 48000 || out_rate == 96000)) ||
-      (out_rate == 44000 && (in_rate == 48000 || in_rate == 96000))) {
-    return false;
-  }
-
-  return true;
-}
-
 class ResamplerTest : public testing::Test {
  protected:
   ResamplerTest();
@@ -82,10 +75,7 @@ TEST_F(ResamplerTest, Reset) {
         ss << "Input rate: " << kRates[i] << ", output rate: " << kRates[j]
             << ", type: " << kTypes[k];
         SCOPED_TRACE(ss.str());
-        if (ValidRates(kRates[i], kRates[j]))
-          EXPECT_EQ(0, rs_.Reset(kRates[i], kRates[j], kTypes[k]));
-        else
-          EXPECT_EQ(-1, rs_.Reset(kRates[i], kRates[j], kTypes[k]));
+        EXPECT_EQ(0, rs_.Reset(kRates[i], kRates[j], kTypes[k]));
       }
     }
   }
@@ -98,20 +88,98 @@ TEST_F(ResamplerTest, Synchronous) {
       ss << "Input rate: " << kRates[i] << ", output rate: " << kRates[j];
       SCOPED_TRACE(ss.str());
 
-      if (ValidRates(kRates[i], kRates[j])) {
-        int in_length = kRates[i] / 100;
-        int out_length = 0;
-        EXPECT_EQ(0, rs_.Reset(kRates[i], kRates[j], kResamplerSynchronous));
-        EXPECT_EQ(0, rs_.Push(data_in_, in_length, data_out_, kDataSize,
-                              out_length));
-        EXPECT_EQ(kRates[j] / 100, out_length);
-      } else {
-        EXPECT_EQ(-1, rs_.Reset(kRates[i], kRates[j], kResamplerSynchronous));
-      }
+      int in_length = kRates[i] / 100;
+      int out_length = 0;
+      EXPECT_EQ(0, rs_.Reset(kRates[i], kRates[j], kResamplerSynchronous));
+      EXPECT_EQ(0, rs_.Push(data_in_, in_length, data_out_, kDataSize,
+                            out_length));
+      EXPECT_EQ(kRates[j] / 100, out_length);
     }
   }
 
   // TODO(andrew): test stereo.
 }
+
+TEST_F(ResamplerTest, SynchronousStereoPolyphase) {
+  const int kInRate = 44100;
+  const int kOutRate = 48000;
+  // Same content in both channels.
+  for (int i = 0; i < kInRate / 100; i++) {
+    data_in_[2 * i] = data_in_[2 * i + 1] = static_cast<int16_t>(i * 50);
+  }
+  EXPECT_EQ(0, rs_.Reset(kInRate, kOutRate, kResamplerSynchronousStereo));
+  int out_length = 0;
+  EXPECT_EQ(0, rs_.Push(data_in_, 2 * kInRate / 100, data_out_, kDataSize,
+                        out_length));
+  EXPECT_EQ(2 * kOutRate / 100, out_length);
+  for (int i = 0; i < out_length; i += 2) {
+    EXPECT_EQ(data_out_[i], data_out_[i + 1]);
+  }
+}
+
+// Feeds a sine through the polyphase resampler in 10 ms blocks and compares
+// the output to the ideal sine, delayed by the filter.
+TEST(PolyphaseResamplerTest, SineAccuracy) {
+  const int kRatePairs[][2] = {
+    { 44100, 48000 },
+    { 48000, 44100 },
+    { 8000, 44100 },
+    { 44100, 16000 },
+    { 16000, 48000 },
+    { 48000, 32000 },
+  };
+  const double kFreqHz = 1000.0;
+  const double kAmplitude = 10000.0;
+  const double kPi = 3.14159265358979323846;
+  const int kTaps = PolyphaseResampler::kTapsPerPhase;
+  for (size_t p = 0; p < sizeof(kRatePairs) / sizeof(*kRatePairs); p++) {
+    const int in_rate = kRatePairs[p][0];
+    const int out_rate = kRatePairs[p][1];
+    std::ostringstream ss;
+    ss << "Input rate: " << in_rate << ", output rate: " << out_rate;
+    SCOPED_TRACE(ss.str());
+
+    PolyphaseResampler resampler;
+    ASSERT_EQ(0, resampler.Reset(in_rate, out_rate));
+    // The prototype filter is centered (kTaps - 1 / interp) / 2 input
+    // samples before the newest sample of each window.
+    int gcd = in_rate;
+    for (int b = out_rate; b != 0;) {
+      const int c = gcd % b;
+      gcd = b;
+      b = c;
+    }
+    const double delay = (kTaps - static_cast<double>(gcd) / out_rate) / 2;
+
+    int16_t in[kMaxRate / 100];
+    int16_t out[kMaxRate / 100];
+    const int in_length = in_rate / 100;
+    int out_index = 0;
+    double signal_energy = 0;
+    double error_energy = 0;
+    for (int block = 0; block < 50; block++) {
+      for (int i = 0; i < in_length; i++) {
+        in[i] = static_cast<int16_t>(kAmplitude * sin(
+            2 * kPi * kFreqHz * (block * in_length + i) / in_rate));
+      }
+      int out_length = 0;
+      ASSERT_EQ(0, resampler.Push(in, in_length, out, kMaxRate / 100,
+                                  out_length));
+      ASSERT_EQ(out_rate / 100, out_length);
+      for (int i = 0; i < out_length; i++, out_index++) {
+        // Skip the first blocks while the filter fills up.
+        if (block < 2) {
+          continue;
+        }
+        const double t = static_cast<double>(out_index) / out_rate -
+            delay / in_rate;
+        const double expected = kAmplitude * sin(2 * kPi * kFreqHz * t);
+        signal_energy += expected * expected;
+        error_energy += (out[i] - expected) * (out[i] - expected);
+      }
+    }
+    EXPECT_GT(10 * log10(signal_energy / error_energy), 50);
+  }
+}
 }  // namespace
 }  // namespace webrtc
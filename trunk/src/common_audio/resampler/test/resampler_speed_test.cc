@@ -0,0 +1,107 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/*
+ * resampler_speed_test.cc : Measures the time to resample 10 ms with
+ * Resampler, which uses its multi-stage modes wherever they exist, next to a
+ * PolyphaseResampler for the same rates.
+ *
+ * Usage: resampler_speed_test [seconds per measurement]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "common_audio/resampler/include/polyphase_resampler.h"
+#include "common_audio/resampler/include/resampler.h"
+#include "system_wrappers/interface/tick_util.h"
+
+using webrtc::PolyphaseResampler;
+using webrtc::Resampler;
+using webrtc::TickTime;
+using webrtc::kResamplerSynchronous;
+
+namespace {
+
+const int kMaxRate = 48000;
+const int kDataSize = kMaxRate / 100;
+
+const int kRatePairs[][2] = {
+  { 16000, 48000 },
+  { 48000, 16000 },
+  { 32000, 48000 },
+  { 48000, 32000 },
+  { 8000, 44000 },
+  { 44000, 16000 },
+  { 44100, 48000 },
+  { 48000, 44100 },
+};
+
+WebRtc_Word16 data_in[kDataSize];
+WebRtc_Word16 data_out[kDataSize];
+
+// Pushes 10 ms through |resampler| for about |seconds| and returns the time
+// per call in us, or -1 on error.
+template <typename T>
+double Measure(T* resampler, int in_rate, double seconds) {
+  const int in_length = in_rate / 100;
+  int out_length = 0;
+  const TickTime start = TickTime::Now();
+  WebRtc_Word64 elapsed_us = 0;
+  int runs = 0;
+  do {
+    for (int i = 0; i < 100; i++) {
+      if (resampler->Push(data_in, in_length, data_out, kDataSize,
+                          out_length) != 0) {
+        return -1;
+      }
+    }
+    runs += 100;
+    elapsed_us = (TickTime::Now() - start).Microseconds();
+  } while (elapsed_us < seconds * 1000000);
+  return static_cast<double>(elapsed_us) / runs;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  double seconds = 1.0;
+  if (argc > 1) {
+    seconds = atof(argv[1]);
+  }
+
+  for (int i = 0; i < kDataSize; i++) {
+    data_in[i] = static_cast<WebRtc_Word16>((i * 1237) % 20000 - 10000);
+  }
+
+  printf("Resampling 10 ms [us]:  Resampler  Polyphase\n");
+  for (size_t p = 0; p < sizeof(kRatePairs) / sizeof(*kRatePairs); p++) {
+    const int in_rate = kRatePairs[p][0];
+    const int out_rate = kRatePairs[p][1];
+
+    Resampler resampler;
+    PolyphaseResampler polyphase;
+    if (resampler.Reset(in_rate, out_rate, kResamplerSynchronous) != 0 ||
+        polyphase.Reset(in_rate, out_rate) != 0) {
+      fprintf(stderr, "Unsupported rates %d -> %d\n", in_rate, out_rate);
+      return 1;
+    }
+    const double resampler_us = Measure(&resampler, in_rate, seconds);
+    const double polyphase_us = Measure(&polyphase, in_rate, seconds);
+    if (resampler_us < 0 || polyphase_us < 0) {
+      fprintf(stderr, "Resampling %d -> %d failed\n", in_rate, out_rate);
+      return 1;
+    }
+    printf("%5d -> %5d:         %9.2f  %9.2f\n", in_rate, out_rate,
+           resampler_us, polyphase_us);
+  }
+
+  return 0;
+}
@@ -43,8 +43,10 @@ LOCAL_SRC_FILES := \
     resample_by_2.c \
     resample_by_2_internal.c \
     resample_fractional.c \
+    spl_init.c \
     spl_sqrt.c \
     spl_sqrt_floor.c \
+    spl_sse2.c \
     spl_version.c \
     splitting_filter.c \
     sqrt_of_one_minus_x_squared.c \
@@ -56,15 +58,19 @@ LOCAL_CFLAGS := \
 
 LOCAL_C_INCLUDES := \
     $(LOCAL_PATH)/include \
-    $(LOCAL_PATH)/../.. 
+    $(LOCAL_PATH)/../.. \
+    $(LOCAL_PATH)/../../system_wrappers/interface
 
 ifeq ($(ARCH_ARM_HAVE_NEON),true)
 LOCAL_SRC_FILES += \
-    min_max_operations_neon.c
+    min_max_operations_neon.c \
+    spl_neon.c
 LOCAL_CFLAGS += \
     $(MY_ARM_CFLAGS_NEON)
 endif
 
+LOCAL_STATIC_LIBRARIES += libwebrtc_system_wrappers
+
 LOCAL_SHARED_LIBRARIES := libstlport
 
 ifeq ($(TARGET_OS)-$(TARGET_SIMULATOR),linux-true)
@@ -24,7 +24,7 @@ int WebRtcSpl_AutoCorrelation(G_CONST WebRtc_Word16* in_vector,
                               int* scale)
 {
     WebRtc_Word32 sum;
-    int i, j;
+    int i;
     WebRtc_Word16 smax; // Sample max
     G_CONST WebRtc_Word16* xptr1;
     G_CONST WebRtc_Word16* xptr2;
@@ -33,6 +33,7 @@ int WebRtcSpl_AutoCorrelation(G_CONST WebRtc_Word16* in_vector,
 
 #ifdef _ARM_OPT_
 #pragma message("NOTE: _ARM_OPT_ optimizations are used")
+    int j;
     WebRtc_Word16 loops4;
 #endif
 
@@ -73,10 +74,10 @@ int WebRtcSpl_AutoCorrelation(G_CONST WebRtc_Word16* in_vector,
         xptr1 = in_vector;
         xptr2 = &in_vector[i];
 #ifndef _ARM_OPT_
-        for (j = loops; j > 0; j--)
-        {
-            sum += WEBRTC_SPL_MUL_16_16_RSFT(*xptr1++, *xptr2++, scaling);
-        }
+        // Through the function pointer, to use the SIMD version if available.
+        sum = WebRtcSpl_DotProductWithScale((WebRtc_Word16*) xptr1,
+                                            (WebRtc_Word16*) xptr2,
+                                            loops, scaling);
 #else
         loops4 = (loops >> 2) << 2;
 
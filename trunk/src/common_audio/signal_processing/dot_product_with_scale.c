@@ -10,15 +10,17 @@
 
 
 /*
- * This file contains the function WebRtcSpl_DotProductWithScale().
+ * This file contains the function WebRtcSpl_DotProductWithScaleC(), the generic C version
+ * of WebRtcSpl_DotProductWithScale().
  * The description header can be found in signal_processing_library.h
  *
  */
 
 #include "signal_processing_library.h"
 
-WebRtc_Word32 WebRtcSpl_DotProductWithScale(WebRtc_Word16 *vector1, WebRtc_Word16 *vector2,
-                                            int length, int scaling)
+WebRtc_Word32 WebRtcSpl_DotProductWithScaleC(WebRtc_Word16 *vector1,
+                                             WebRtc_Word16 *vector2,
+                                             int length, int scaling)
 {
     WebRtc_Word32 sum;
     int i;
@@ -10,17 +10,18 @@
 
 
 /*
- * This file contains the function WebRtcSpl_DownsampleFast().
+ * This file contains the function WebRtcSpl_DownsampleFastC(), the generic C version
+ * of WebRtcSpl_DownsampleFast().
  * The description header can be found in signal_processing_library.h
  *
  */
 
 #include "signal_processing_library.h"
 
-int WebRtcSpl_DownsampleFast(WebRtc_Word16 *in_ptr, WebRtc_Word16 in_length,
-                             WebRtc_Word16 *out_ptr, WebRtc_Word16 out_length,
-                             WebRtc_Word16 *B, WebRtc_Word16 B_length, WebRtc_Word16 factor,
-                             WebRtc_Word16 delay)
+int WebRtcSpl_DownsampleFastC(WebRtc_Word16 *in_ptr, WebRtc_Word16 in_length,
+                              WebRtc_Word16 *out_ptr, WebRtc_Word16 out_length,
+                              WebRtc_Word16 *B, WebRtc_Word16 B_length,
+                              WebRtc_Word16 factor, WebRtc_Word16 delay)
 {
     WebRtc_Word32 o;
     int i, j;
@@ -10,18 +10,19 @@
 
 
 /*
- * This file contains the function WebRtcSpl_FilterMAFastQ12().
+ * This file contains the function WebRtcSpl_FilterMAFastQ12C(), the generic C version
+ * of WebRtcSpl_FilterMAFastQ12().
  * The description header can be found in signal_processing_library.h
  *
  */
 
 #include "signal_processing_library.h"
 
-void WebRtcSpl_FilterMAFastQ12(WebRtc_Word16* in_ptr,
-                               WebRtc_Word16* out_ptr,
-                               WebRtc_Word16* B,
-                               WebRtc_Word16 B_length,
-                               WebRtc_Word16 length)
+void WebRtcSpl_FilterMAFastQ12C(WebRtc_Word16* in_ptr,
+                                WebRtc_Word16* out_ptr,
+                                WebRtc_Word16* B,
+                                WebRtc_Word16 B_length,
+                                WebRtc_Word16 length)
 {
     WebRtc_Word32 o;
     int i, j;
@@ -181,6 +181,14 @@ extern "C"
 WebRtc_Word16 WebRtcSpl_get_version(char* version,
                                     WebRtc_Word16 length_in_bytes);
 
+// Initialize the function pointers below to the fastest versions for the CPU.
+// Implementation in spl_init.c. Descriptions at bottom of file.
+void WebRtcSpl_Init(void);
+// Point the function pointers to the SSE2, respectively ARM Neon, versions.
+// Implementations in spl_sse2.c and spl_neon.c, used by WebRtcSpl_Init().
+void WebRtcSpl_InitSSE2(void);
+void WebRtcSpl_InitNeon(void);
+
 int WebRtcSpl_GetScalingSquare(WebRtc_Word16* in_vector,
                                int in_vector_length,
                                int times);
@@ -326,13 +334,21 @@ void WebRtcSpl_LpcToReflCoef(WebRtc_Word16* lpc_coef,
 void WebRtcSpl_AutoCorrToReflCoef(G_CONST WebRtc_Word32* auto_corr,
                                   int use_order,
                                   WebRtc_Word16* refl_coef);
-void WebRtcSpl_CrossCorrelation(WebRtc_Word32* cross_corr,
-                                WebRtc_Word16* vector1,
-                                WebRtc_Word16* vector2,
-                                WebRtc_Word16 dim_vector,
-                                WebRtc_Word16 dim_cross_corr,
-                                WebRtc_Word16 right_shifts,
-                                WebRtc_Word16 step_vector2);
+typedef void (*CrossCorrelation)(WebRtc_Word32* cross_corr,
+                                 WebRtc_Word16* vector1,
+                                 WebRtc_Word16* vector2,
+                                 WebRtc_Word16 dim_vector,
+                                 WebRtc_Word16 dim_cross_corr,
+                                 WebRtc_Word16 right_shifts,
+                                 WebRtc_Word16 step_vector2);
+extern CrossCorrelation WebRtcSpl_CrossCorrelation;
+void WebRtcSpl_CrossCorrelationC(WebRtc_Word32* cross_corr,
+                                 WebRtc_Word16* vector1,
+                                 WebRtc_Word16* vector2,
+                                 WebRtc_Word16 dim_vector,
+                                 WebRtc_Word16 dim_cross_corr,
+                                 WebRtc_Word16 right_shifts,
+                                 WebRtc_Word16 step_vector2);
 void WebRtcSpl_GetHanningWindow(WebRtc_Word16* window, WebRtc_Word16 size);
 void WebRtcSpl_SqrtOfOneMinusXSquared(WebRtc_Word16* in_vector,
                                       int vector_length,
@@ -367,10 +383,15 @@ WebRtc_Word32 WebRtcSpl_Energy(WebRtc_Word16* vector,
                                int vector_length,
                                int* scale_factor);
 
-WebRtc_Word32 WebRtcSpl_DotProductWithScale(WebRtc_Word16* vector1,
-                                            WebRtc_Word16* vector2,
-                                            int vector_length,
-                                            int scaling);
+typedef WebRtc_Word32 (*DotProductWithScale)(WebRtc_Word16* vector1,
+                                             WebRtc_Word16* vector2,
+                                             int vector_length,
+                                             int scaling);
+extern DotProductWithScale WebRtcSpl_DotProductWithScale;
+WebRtc_Word32 WebRtcSpl_DotProductWithScaleC(WebRtc_Word16* vector1,
+                                             WebRtc_Word16* vector2,
+                                             int vector_length,
+                                             int scaling);
 
 // Filter operations.
 int WebRtcSpl_FilterAR(G_CONST WebRtc_Word16* ar_coef, int ar_coef_length,
@@ -380,24 +401,39 @@ int WebRtcSpl_FilterAR(G_CONST WebRtc_Word16* ar_coef, int ar_coef_length,
                        int filter_state_low_length, WebRtc_Word16* out_vector,
                        WebRtc_Word16* out_vector_low, int out_vector_low_length);
 
-void WebRtcSpl_FilterMAFastQ12(WebRtc_Word16* in_vector,
-                               WebRtc_Word16* out_vector,
-                               WebRtc_Word16* ma_coef,
-                               WebRtc_Word16 ma_coef_length,
-                               WebRtc_Word16 vector_length);
+typedef void (*FilterMAFastQ12)(WebRtc_Word16* in_vector,
+                                WebRtc_Word16* out_vector,
+                                WebRtc_Word16* ma_coef,
+                                WebRtc_Word16 ma_coef_length,
+                                WebRtc_Word16 vector_length);
+extern FilterMAFastQ12 WebRtcSpl_FilterMAFastQ12;
+void WebRtcSpl_FilterMAFastQ12C(WebRtc_Word16* in_vector,
+                                WebRtc_Word16* out_vector,
+                                WebRtc_Word16* ma_coef,
+                                WebRtc_Word16 ma_coef_length,
+                                WebRtc_Word16 vector_length);
 void WebRtcSpl_FilterARFastQ12(WebRtc_Word16* in_vector,
                                WebRtc_Word16* out_vector,
                                WebRtc_Word16* ar_coef,
                                WebRtc_Word16 ar_coef_length,
                                WebRtc_Word16 vector_length);
-int WebRtcSpl_DownsampleFast(WebRtc_Word16* in_vector,
-                             WebRtc_Word16 in_vector_length,
-                             WebRtc_Word16* out_vector,
-                             WebRtc_Word16 out_vector_length,
-                             WebRtc_Word16* ma_coef,
-                             WebRtc_Word16 ma_coef_length,
-                             WebRtc_Word16 factor,
-                             WebRtc_Word16 delay);
+typedef int (*DownsampleFast)(WebRtc_Word16* in_vector,
+                              WebRtc_Word16 in_vector_length,
+                              WebRtc_Word16* out_vector,
+                              WebRtc_Word16 out_vector_length,
+                              WebRtc_Word16* ma_coef,
+                              WebRtc_Word16 ma_coef_length,
+                              WebRtc_Word16 factor,
+                              WebRtc_Word16 delay);
+extern DownsampleFast WebRtcSpl_DownsampleFast;
+int WebRtcSpl_DownsampleFastC(WebRtc_Word16* in_vector,
+                              WebRtc_Word16 in_vector_length,
+                              WebRtc_Word16* out_vector,
+                              WebRtc_Word16 out_vector_length,
+                              WebRtc_Word16* ma_coef,
+                              WebRtc_Word16 ma_coef_length,
+                              WebRtc_Word16 factor,
+                              WebRtc_Word16 delay);
 // End: Filter operations.
 
 // FFT operations
@@ -1684,3 +1720,14 @@ void WebRtcSpl_SynthesisQMF(const WebRtc_Word16* low_band,
 // Output:
 //      - version           : Pointer to a buffer where the version number is written to.
 //
+
+//
+// void WebRtcSpl_Init(void)
+//
+// Points WebRtcSpl_CrossCorrelation, WebRtcSpl_DotProductWithScale,
+// WebRtcSpl_FilterMAFastQ12 and WebRtcSpl_DownsampleFast to SSE2 or ARM Neon
+// versions when the CPU supports them. The pointers start out at the generic
+// C versions (the ...C functions), so calling this is optional; all versions
+// give bit-exact results. Components using these functions call it from
+// their init functions.
+//
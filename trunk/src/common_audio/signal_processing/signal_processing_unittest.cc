@@ -446,3 +446,112 @@ TEST_F(SplTest, FFTTest) {
         //EXPECT_EQ(A[kk], B[kk]);
     }
 }
+
+TEST_F(SplTest, DispatchedFunctionsMatchCTest) {
+    // The function pointers point to the fastest versions for the CPU after
+    // WebRtcSpl_Init(), which must be bit-exact with the C versions. Full
+    // scale input and coefficients, with runs of -32768, make the 32-bit sums
+    // wrap around and the outputs saturate.
+    const int kMaxFilterLength = 40;
+    const int kLength = 300;
+    WebRtc_Word16 x[kMaxFilterLength + kLength];
+    WebRtc_Word16 coefs[kMaxFilterLength];
+    WebRtc_Word16 outC[kLength];
+    WebRtc_Word16 out[kLength];
+    WebRtc_Word32 corrC[kLength];
+    WebRtc_Word32 corr[kLength];
+    WebRtc_UWord32 seed = 12345;
+
+    WebRtcSpl_Init();
+
+    for (int kk = 0; kk < kMaxFilterLength + kLength; ++kk) {
+        seed = seed * 69069 + 1;
+        x[kk] = (kk % 41 < 4) ? WEBRTC_SPL_WORD16_MIN
+                              : static_cast<WebRtc_Word16>(seed >> 16);
+    }
+    for (int kk = 0; kk < kMaxFilterLength; ++kk) {
+        seed = seed * 69069 + 1;
+        coefs[kk] = (kk % 5 == 0) ? WEBRTC_SPL_WORD16_MIN
+                                  : static_cast<WebRtc_Word16>(seed >> 16);
+    }
+    // Input with the filter state before it.
+    WebRtc_Word16* in = &x[kMaxFilterLength];
+
+    for (int length = 0; length < 70; ++length) {
+        for (int scaling = 0; scaling < 4; ++scaling) {
+            // Unaligned vectors too.
+            for (int offset = 0; offset < 3; ++offset) {
+                EXPECT_EQ(WebRtcSpl_DotProductWithScaleC(&x[offset], &x[7],
+                                                         length, scaling),
+                          WebRtcSpl_DotProductWithScale(&x[offset], &x[7],
+                                                        length, scaling))
+                    << "length " << length << " scaling " << scaling;
+            }
+        }
+    }
+
+    for (int dim = 1; dim < 70; dim += 3) {
+        for (int step = -1; step <= 1; step += 2) {
+            WebRtcSpl_CrossCorrelationC(corrC, in, &in[100], dim, 50, 2, step);
+            WebRtcSpl_CrossCorrelation(corr, in, &in[100], dim, 50, 2, step);
+            for (int kk = 0; kk < 50; ++kk) {
+                ASSERT_EQ(corrC[kk], corr[kk]) << "dim " << dim;
+            }
+        }
+    }
+
+    for (int order = 0; order < kMaxFilterLength; ++order) {
+        for (int length = 1; length < 20; ++length) {
+            WebRtcSpl_FilterMAFastQ12C(in, outC, coefs, order + 1, length);
+            WebRtcSpl_FilterMAFastQ12(in, out, coefs, order + 1, length);
+            for (int kk = 0; kk < length; ++kk) {
+                ASSERT_EQ(outC[kk], out[kk]) << "order " << order;
+            }
+        }
+        // Small coefficients, as in real filters, so that not all outputs
+        // saturate.
+        WebRtc_Word16 small_coefs[kMaxFilterLength];
+        for (int kk = 0; kk <= order; ++kk) {
+            small_coefs[kk] = coefs[kk] >> 6;
+        }
+        WebRtcSpl_FilterMAFastQ12C(in, outC, small_coefs, order + 1, kLength);
+        WebRtcSpl_FilterMAFastQ12(in, out, small_coefs, order + 1, kLength);
+        for (int kk = 0; kk < kLength; ++kk) {
+            ASSERT_EQ(outC[kk], out[kk]) << "order " << order;
+        }
+    }
+
+    for (int order = 0; order < kMaxFilterLength; ++order) {
+        for (int factor = 1; factor <= 12; ++factor) {
+            for (int delay = 0; delay < 2; ++delay) {
+                // As many outputs as fit, and one less.
+                const int out_length = (kLength - 1 - delay) / factor + 1;
+                for (int kk = out_length - 1; kk <= out_length; ++kk) {
+                    EXPECT_EQ(WebRtcSpl_DownsampleFastC(
+                        in, kLength, outC, kk, coefs, order + 1, factor,
+                        delay),
+                        WebRtcSpl_DownsampleFast(
+                            in, kLength, out, kk, coefs, order + 1, factor,
+                            delay));
+                    for (int ii = 0; ii < kk; ++ii) {
+                        ASSERT_EQ(outC[ii], out[ii]) << "order " << order
+                            << " factor " << factor;
+                    }
+                }
+                // Too short input.
+                EXPECT_EQ(-1, WebRtcSpl_DownsampleFast(in, kLength, out,
+                                                       out_length + 1, coefs,
+                                                       order + 1, factor,
+                                                       delay));
+            }
+        }
+    }
+
+    // WebRtcSpl_AutoCorrelation() uses WebRtcSpl_DotProductWithScale().
+    int scale = 0;
+    EXPECT_EQ(11, WebRtcSpl_AutoCorrelation(in, kLength, 10, corr, &scale));
+    for (int kk = 0; kk <= 10; ++kk) {
+        EXPECT_EQ(WebRtcSpl_DotProductWithScaleC(in, &in[kk], kLength - kk,
+                                                 scale), corr[kk]);
+    }
+}
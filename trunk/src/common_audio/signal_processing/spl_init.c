@@ -0,0 +1,47 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+
+/*
+ * This file contains the function WebRtcSpl_Init() and the function pointers
+ * it initializes.
+ * The description header can be found in signal_processing_library.h
+ *
+ */
+
+#include "signal_processing_library.h"
+#include "cpu_features_wrapper.h"
+
+// The generic C versions until WebRtcSpl_Init() is called.
+CrossCorrelation WebRtcSpl_CrossCorrelation = WebRtcSpl_CrossCorrelationC;
+DotProductWithScale WebRtcSpl_DotProductWithScale =
+    WebRtcSpl_DotProductWithScaleC;
+FilterMAFastQ12 WebRtcSpl_FilterMAFastQ12 = WebRtcSpl_FilterMAFastQ12C;
+DownsampleFast WebRtcSpl_DownsampleFast = WebRtcSpl_DownsampleFastC;
+
+void WebRtcSpl_Init(void)
+{
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    if (WebRtc_GetCPUInfo(kSSE2))
+    {
+#if defined(WEBRTC_USE_SSE2)
+        WebRtcSpl_InitSSE2();
+#endif
+    }
+#elif defined(WEBRTC_DETECT_ARM_NEON)
+    uint64_t features = WebRtc_GetCPUFeaturesARM();
+    if ((features & kCPUFeatureNEON) != 0)
+    {
+        WebRtcSpl_InitNeon();
+    }
+#elif defined(WEBRTC_ARCH_ARM_NEON)
+    WebRtcSpl_InitNeon();
+#endif
+}
@@ -0,0 +1,190 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+
+/*
+ * This file contains the ARM Neon versions of
+ * WebRtcSpl_DotProductWithScale(), WebRtcSpl_CrossCorrelation(),
+ * WebRtcSpl_FilterMAFastQ12() and WebRtcSpl_DownsampleFast(), and
+ * WebRtcSpl_InitNeon().
+ *
+ * The sums wrap around in 32 bits exactly like the C versions, and the
+ * saturations are the same, so the results are bit-exact.
+ */
+
+#include <arm_neon.h>
+
+#include "signal_processing_library.h"
+
+// Longest filter handled by DownsampleFastNeon(), longer ones go to the C
+// version.
+#define SPL_NEON_MAX_FILTER_LENGTH 32
+
+// Returns the sum of the four 32-bit elements of |sum|.
+static __inline WebRtc_Word32 HorizontalSum(int32x4_t sum)
+{
+    int32x2_t sum2 = vadd_s32(vget_low_s32(sum), vget_high_s32(sum));
+    sum2 = vpadd_s32(sum2, sum2);
+    return vget_lane_s32(sum2, 0);
+}
+
+static WebRtc_Word32 DotProductWithScaleNeon(WebRtc_Word16* vector1,
+                                             WebRtc_Word16* vector2,
+                                             int length,
+                                             int scaling)
+{
+    int32x4_t sum = vdupq_n_s32(0);
+    // A negative shift to the left is a shift to the right.
+    const int32x4_t shift = vdupq_n_s32(-scaling);
+    WebRtc_Word32 result;
+    int i = 0;
+
+    for (; i <= length - 8; i += 8)
+    {
+        int16x8_t a = vld1q_s16(&vector1[i]);
+        int16x8_t b = vld1q_s16(&vector2[i]);
+        int32x4_t low = vmull_s16(vget_low_s16(a), vget_low_s16(b));
+        int32x4_t high = vmull_s16(vget_high_s16(a), vget_high_s16(b));
+        sum = vaddq_s32(sum, vshlq_s32(low, shift));
+        sum = vaddq_s32(sum, vshlq_s32(high, shift));
+    }
+
+    result = HorizontalSum(sum);
+    for (; i < length; i++)
+    {
+        result += WEBRTC_SPL_MUL_16_16_RSFT(vector1[i], vector2[i], scaling);
+    }
+    return result;
+}
+
+static void CrossCorrelationNeon(WebRtc_Word32* cross_correlation,
+                                 WebRtc_Word16* seq1,
+                                 WebRtc_Word16* seq2,
+                                 WebRtc_Word16 dim_seq,
+                                 WebRtc_Word16 dim_cross_correlation,
+                                 WebRtc_Word16 right_shifts,
+                                 WebRtc_Word16 step_seq2)
+{
+    int i;
+    for (i = 0; i < dim_cross_correlation; i++)
+    {
+        cross_correlation[i] = DotProductWithScaleNeon(
+            seq1, seq2 + step_seq2 * i, dim_seq, right_shifts);
+    }
+}
+
+static void FilterMAFastQ12Neon(WebRtc_Word16* in_ptr,
+                                WebRtc_Word16* out_ptr,
+                                WebRtc_Word16* B,
+                                WebRtc_Word16 B_length,
+                                WebRtc_Word16 length)
+{
+    const int32x4_t max_value = vdupq_n_s32(134215679);
+    const int32x4_t min_value = vdupq_n_s32(-134217728);
+    const int32x4_t round = vdupq_n_s32(2048);
+    int i, j;
+
+    // Four outputs at a time.
+    for (i = 0; i <= length - 4; i += 4)
+    {
+        int32x4_t sum = vdupq_n_s32(0);
+        for (j = 0; j < B_length; j++)
+        {
+            sum = vmlal_n_s16(sum, vld1_s16(&in_ptr[i - j]), B[j]);
+        }
+        sum = vminq_s32(vmaxq_s32(sum, min_value), max_value);
+        sum = vshrq_n_s32(vaddq_s32(sum, round), 12);
+        vst1_s16(&out_ptr[i], vmovn_s32(sum));
+    }
+
+    if (i < length)
+    {
+        WebRtcSpl_FilterMAFastQ12C(&in_ptr[i], &out_ptr[i], B, B_length,
+                                   (WebRtc_Word16) (length - i));
+    }
+}
+
+static int DownsampleFastNeon(WebRtc_Word16* in_ptr,
+                              WebRtc_Word16 in_length,
+                              WebRtc_Word16* out_ptr,
+                              WebRtc_Word16 out_length,
+                              WebRtc_Word16* B,
+                              WebRtc_Word16 B_length,
+                              WebRtc_Word16 factor,
+                              WebRtc_Word16 delay)
+{
+    // The coefficients in reversed order, zero padded to a multiple of 4, so
+    // that each output is a dot product with the input starting at its
+    // oldest sample.
+    WebRtc_Word16 coefs[SPL_NEON_MAX_FILTER_LENGTH];
+    WebRtc_Word16 endpos = delay
+            + (WebRtc_Word16)WEBRTC_SPL_MUL_16_16(factor, (out_length - 1)) + 1;
+    int num_blocks, padding, simd_endpos;
+    int i, j;
+
+    if (in_length < endpos)
+    {
+        return -1;
+    }
+    if (B_length > SPL_NEON_MAX_FILTER_LENGTH)
+    {
+        return WebRtcSpl_DownsampleFastC(in_ptr, in_length, out_ptr,
+                                         out_length, B, B_length, factor,
+                                         delay);
+    }
+
+    num_blocks = (B_length + 3) >> 2;
+    padding = (num_blocks << 2) - B_length;
+    for (j = 0; j < B_length; j++)
+    {
+        coefs[j] = B[B_length - 1 - j];
+    }
+    for (; j < (num_blocks << 2); j++)
+    {
+        coefs[j] = 0;
+    }
+
+    // The loads read |padding| samples past the newest one, with zero
+    // weight, which must stay within |in_ptr|.
+    simd_endpos = WEBRTC_SPL_MIN(endpos, in_length - padding);
+
+    for (i = delay; i < simd_endpos; i += factor)
+    {
+        const WebRtc_Word16* x_ptr = &in_ptr[i - B_length + 1];
+        int32x4_t sum = vdupq_n_s32(0);
+        for (j = 0; j < num_blocks; j++)
+        {
+            sum = vmlal_s16(sum, vld1_s16(&x_ptr[j << 2]),
+                            vld1_s16(&coefs[j << 2]));
+        }
+        *out_ptr++ = WebRtcSpl_SatW32ToW16(
+            WEBRTC_SPL_RSHIFT_W32(HorizontalSum(sum) + 2048, 12));
+    }
+
+    for (; i < endpos; i += factor)
+    {
+        WebRtc_Word32 o = 2048;
+        for (j = 0; j < B_length; j++)
+        {
+            o += WEBRTC_SPL_MUL_16_16(B[j], in_ptr[i - j]);
+        }
+        *out_ptr++ = WebRtcSpl_SatW32ToW16(WEBRTC_SPL_RSHIFT_W32(o, 12));
+    }
+
+    return 0;
+}
+
+void WebRtcSpl_InitNeon(void)
+{
+    WebRtcSpl_CrossCorrelation = CrossCorrelationNeon;
+    WebRtcSpl_DotProductWithScale = DotProductWithScaleNeon;
+    WebRtcSpl_FilterMAFastQ12 = FilterMAFastQ12Neon;
+    WebRtcSpl_DownsampleFast = DownsampleFastNeon;
+}
@@ -0,0 +1,291 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+
+/*
+ * This file contains the SSE2 versions of WebRtcSpl_DotProductWithScale(),
+ * WebRtcSpl_CrossCorrelation(), WebRtcSpl_FilterMAFastQ12() and
+ * WebRtcSpl_DownsampleFast(), and WebRtcSpl_InitSSE2().
+ *
+ * The sums wrap around in 32 bits exactly like the C versions, and the
+ * saturations are the same, so the results are bit-exact.
+ */
+
+#include "typedefs.h"
+
+#if defined(WEBRTC_USE_SSE2)
+#include <emmintrin.h>
+
+#include "signal_processing_library.h"
+
+// Longest filters handled here, longer ones go to the C versions.
+#define SPL_SSE2_MAX_FILTER_LENGTH 32
+
+// Returns the sum of the four 32-bit elements of |sum|.
+static __inline WebRtc_Word32 HorizontalSum(__m128i sum)
+{
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(sum);
+}
+
+// Returns the sums of the elements of each of |sum0| .. |sum3|, in order.
+static __inline __m128i HorizontalSum4(__m128i sum0, __m128i sum1,
+                                       __m128i sum2, __m128i sum3)
+{
+    __m128i sum01 = _mm_add_epi32(_mm_unpacklo_epi32(sum0, sum1),
+                                  _mm_unpackhi_epi32(sum0, sum1));
+    __m128i sum23 = _mm_add_epi32(_mm_unpacklo_epi32(sum2, sum3),
+                                  _mm_unpackhi_epi32(sum2, sum3));
+    return _mm_add_epi32(_mm_unpacklo_epi64(sum01, sum23),
+                         _mm_unpackhi_epi64(sum01, sum23));
+}
+
+static WebRtc_Word32 DotProductWithScaleSSE2(WebRtc_Word16* vector1,
+                                             WebRtc_Word16* vector2,
+                                             int length,
+                                             int scaling)
+{
+    __m128i sum = _mm_setzero_si128();
+    WebRtc_Word32 result;
+    int i = 0;
+
+    if (scaling == 0)
+    {
+        // Pairwise products added in 32 bits, as in the C version.
+        for (; i <= length - 8; i += 8)
+        {
+            __m128i a = _mm_loadu_si128((const __m128i*) &vector1[i]);
+            __m128i b = _mm_loadu_si128((const __m128i*) &vector2[i]);
+            sum = _mm_add_epi32(sum, _mm_madd_epi16(a, b));
+        }
+    }
+    else
+    {
+        // Each product is shifted before it is added.
+        const __m128i shift = _mm_cvtsi32_si128(scaling);
+        for (; i <= length - 8; i += 8)
+        {
+            __m128i a = _mm_loadu_si128((const __m128i*) &vector1[i]);
+            __m128i b = _mm_loadu_si128((const __m128i*) &vector2[i]);
+            __m128i low = _mm_mullo_epi16(a, b);
+            __m128i high = _mm_mulhi_epi16(a, b);
+            sum = _mm_add_epi32(sum, _mm_sra_epi32(
+                _mm_unpacklo_epi16(low, high), shift));
+            sum = _mm_add_epi32(sum, _mm_sra_epi32(
+                _mm_unpackhi_epi16(low, high), shift));
+        }
+    }
+
+    result = HorizontalSum(sum);
+    for (; i < length; i++)
+    {
+        result += WEBRTC_SPL_MUL_16_16_RSFT(vector1[i], vector2[i], scaling);
+    }
+    return result;
+}
+
+static void CrossCorrelationSSE2(WebRtc_Word32* cross_correlation,
+                                 WebRtc_Word16* seq1,
+                                 WebRtc_Word16* seq2,
+                                 WebRtc_Word16 dim_seq,
+                                 WebRtc_Word16 dim_cross_correlation,
+                                 WebRtc_Word16 right_shifts,
+                                 WebRtc_Word16 step_seq2)
+{
+    int i;
+    for (i = 0; i < dim_cross_correlation; i++)
+    {
+        cross_correlation[i] = DotProductWithScaleSSE2(
+            seq1, seq2 + step_seq2 * i, dim_seq, right_shifts);
+    }
+}
+
+static void FilterMAFastQ12SSE2(WebRtc_Word16* in_ptr,
+                                WebRtc_Word16* out_ptr,
+                                WebRtc_Word16* B,
+                                WebRtc_Word16 B_length,
+                                WebRtc_Word16 length)
+{
+    // Pairs of coefficients (B[j], B[j + 1]) in each 32-bit element, the
+    // last one padded with a zero.
+    __m128i coef_pairs[(SPL_SSE2_MAX_FILTER_LENGTH + 1) / 2];
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i max_value = _mm_set1_epi32(134215679);
+    const __m128i min_value = _mm_set1_epi32(-134217728);
+    const __m128i round = _mm_set1_epi32(1024);
+    int i, j;
+
+    if (B_length > SPL_SSE2_MAX_FILTER_LENGTH)
+    {
+        WebRtcSpl_FilterMAFastQ12C(in_ptr, out_ptr, B, B_length, length);
+        return;
+    }
+
+    for (j = 0; j < B_length; j += 2)
+    {
+        WebRtc_UWord16 next = (j + 1 < B_length) ? (WebRtc_UWord16) B[j + 1] : 0;
+        coef_pairs[j >> 1] = _mm_set1_epi32(
+            (WebRtc_Word32) (((WebRtc_UWord32) next << 16) |
+                             (WebRtc_UWord16) B[j]));
+    }
+
+    // Eight outputs at a time, two coefficients at a time. Interleaving
+    // x[i - j] and x[i - j - 1] lets _mm_madd_epi16() do both products and
+    // their sum for four outputs.
+    for (i = 0; i <= length - 8; i += 8)
+    {
+        __m128i sum_low = _mm_setzero_si128();
+        __m128i sum_high = _mm_setzero_si128();
+        __m128i low, high;
+
+        for (j = 0; j < B_length - 1; j += 2)
+        {
+            __m128i x0 = _mm_loadu_si128((const __m128i*) &in_ptr[i - j]);
+            __m128i x1 = _mm_loadu_si128((const __m128i*) &in_ptr[i - j - 1]);
+            sum_low = _mm_add_epi32(sum_low, _mm_madd_epi16(
+                _mm_unpacklo_epi16(x0, x1), coef_pairs[j >> 1]));
+            sum_high = _mm_add_epi32(sum_high, _mm_madd_epi16(
+                _mm_unpackhi_epi16(x0, x1), coef_pairs[j >> 1]));
+        }
+        if (j < B_length)
+        {
+            // The last coefficient, paired with zeros so that nothing before
+            // the filter state is read.
+            __m128i x0 = _mm_loadu_si128((const __m128i*) &in_ptr[i - j]);
+            sum_low = _mm_add_epi32(sum_low, _mm_madd_epi16(
+                _mm_unpacklo_epi16(x0, zero), coef_pairs[j >> 1]));
+            sum_high = _mm_add_epi32(sum_high, _mm_madd_epi16(
+                _mm_unpackhi_epi16(x0, zero), coef_pairs[j >> 1]));
+        }
+
+        // Saturate to the Q12 range of a WebRtc_Word16. SSE2 has no 32-bit
+        // min and max.
+        low = _mm_cmpgt_epi32(sum_low, max_value);
+        sum_low = _mm_or_si128(_mm_and_si128(low, max_value),
+                               _mm_andnot_si128(low, sum_low));
+        low = _mm_cmplt_epi32(sum_low, min_value);
+        sum_low = _mm_or_si128(_mm_and_si128(low, min_value),
+                               _mm_andnot_si128(low, sum_low));
+        high = _mm_cmpgt_epi32(sum_high, max_value);
+        sum_high = _mm_or_si128(_mm_and_si128(high, max_value),
+                                _mm_andnot_si128(high, sum_high));
+        high = _mm_cmplt_epi32(sum_high, min_value);
+        sum_high = _mm_or_si128(_mm_and_si128(high, min_value),
+                                _mm_andnot_si128(high, sum_high));
+
+        // (o + 2048) >> 12, done as ((o >> 1) + 1024) >> 11, which gives the
+        // same result.
+        sum_low = _mm_srai_epi32(_mm_add_epi32(_mm_srai_epi32(sum_low, 1),
+                                               round), 11);
+        sum_high = _mm_srai_epi32(_mm_add_epi32(_mm_srai_epi32(sum_high, 1),
+                                                round), 11);
+        _mm_storeu_si128((__m128i*) &out_ptr[i],
+                         _mm_packs_epi32(sum_low, sum_high));
+    }
+
+    if (i < length)
+    {
+        WebRtcSpl_FilterMAFastQ12C(&in_ptr[i], &out_ptr[i], B, B_length,
+                                   (WebRtc_Word16) (length - i));
+    }
+}
+
+static int DownsampleFastSSE2(WebRtc_Word16* in_ptr,
+                              WebRtc_Word16 in_length,
+                              WebRtc_Word16* out_ptr,
+                              WebRtc_Word16 out_length,
+                              WebRtc_Word16* B,
+                              WebRtc_Word16 B_length,
+                              WebRtc_Word16 factor,
+                              WebRtc_Word16 delay)
+{
+    // The coefficients in reversed order, zero padded to a multiple of 8, so
+    // that each output is a dot product with the input starting at its
+    // oldest sample.
+    __m128i coefs[SPL_SSE2_MAX_FILTER_LENGTH / 8];
+    WebRtc_Word16* coef_ptr = (WebRtc_Word16*) coefs;
+    const __m128i round = _mm_set1_epi32(2048);
+    WebRtc_Word16 endpos = delay
+            + (WebRtc_Word16)WEBRTC_SPL_MUL_16_16(factor, (out_length - 1)) + 1;
+    int num_blocks, padding, simd_endpos;
+    int i, j, k;
+
+    if (in_length < endpos)
+    {
+        return -1;
+    }
+    if (B_length > SPL_SSE2_MAX_FILTER_LENGTH)
+    {
+        return WebRtcSpl_DownsampleFastC(in_ptr, in_length, out_ptr,
+                                         out_length, B, B_length, factor,
+                                         delay);
+    }
+
+    num_blocks = (B_length + 7) >> 3;
+    padding = (num_blocks << 3) - B_length;
+    for (j = 0; j < B_length; j++)
+    {
+        coef_ptr[j] = B[B_length - 1 - j];
+    }
+    for (; j < (num_blocks << 3); j++)
+    {
+        coef_ptr[j] = 0;
+    }
+
+    // The loads read |padding| samples past the newest one, with zero
+    // weight, which must stay within |in_ptr|.
+    simd_endpos = WEBRTC_SPL_MIN(endpos, in_length - padding);
+
+    // Four outputs at a time.
+    for (i = delay; i + 3 * factor < simd_endpos; i += 4 * factor)
+    {
+        __m128i sum[4];
+        __m128i result;
+        for (k = 0; k < 4; k++)
+        {
+            const WebRtc_Word16* x_ptr = &in_ptr[i + k * factor - B_length + 1];
+            sum[k] = _mm_setzero_si128();
+            for (j = 0; j < num_blocks; j++)
+            {
+                __m128i x = _mm_loadu_si128((const __m128i*) &x_ptr[j << 3]);
+                sum[k] = _mm_add_epi32(sum[k], _mm_madd_epi16(x, coefs[j]));
+            }
+        }
+        result = _mm_add_epi32(HorizontalSum4(sum[0], sum[1], sum[2], sum[3]),
+                               round);
+        result = _mm_srai_epi32(result, 12);
+        // Saturating pack, as WebRtcSpl_SatW32ToW16().
+        _mm_storel_epi64((__m128i*) out_ptr, _mm_packs_epi32(result, result));
+        out_ptr += 4;
+    }
+
+    for (; i < endpos; i += factor)
+    {
+        WebRtc_Word32 o = 2048;
+        for (j = 0; j < B_length; j++)
+        {
+            o += WEBRTC_SPL_MUL_16_16(B[j], in_ptr[i - j]);
+        }
+        *out_ptr++ = WebRtcSpl_SatW32ToW16(WEBRTC_SPL_RSHIFT_W32(o, 12));
+    }
+
+    return 0;
+}
+
+void WebRtcSpl_InitSSE2(void)
+{
+    WebRtcSpl_CrossCorrelation = CrossCorrelationSSE2;
+    WebRtcSpl_DotProductWithScale = DotProductWithScaleSSE2;
+    WebRtcSpl_FilterMAFastQ12 = FilterMAFastQ12SSE2;
+    WebRtcSpl_DownsampleFast = DownsampleFastSSE2;
+}
+
+#endif  // WEBRTC_USE_SSE2
@@ -0,0 +1,148 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/*
+ * signal_processing_speed_test.cc : Measures the time per call of the
+ * generic C versions of the functions dispatched by WebRtcSpl_Init(), and of
+ * the versions it selects for this CPU, with sizes as used by NetEq and iLBC.
+ *
+ * Usage: signal_processing_speed_test [seconds per measurement]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "signal_processing_library.h"
+#include "tick_util.h"
+
+using webrtc::TickTime;
+
+namespace
+{
+
+const int kMaxFilterLength = 16;
+const int kLength = 480;
+
+WebRtc_Word16 input[kMaxFilterLength + kLength];
+WebRtc_Word16* const speech = &input[kMaxFilterLength];
+WebRtc_Word16 output[kLength];
+WebRtc_Word32 correlation[kLength];
+WebRtc_Word16 coefficients[kMaxFilterLength];
+volatile WebRtc_Word32 sink;
+
+DotProductWithScale dotProduct;
+CrossCorrelation crossCorrelation;
+FilterMAFastQ12 filterMA;
+DownsampleFast downsample;
+
+// Energy of a 10 ms frame at 32 kHz.
+void DotProduct320()
+{
+    sink = dotProduct(speech, speech, 320, 2);
+}
+
+// Pitch search in the 4 kHz domain, as in NetEq's correlator.
+void CrossCorrelation60x54()
+{
+    crossCorrelation(correlation, speech, &speech[60], 60, 54, 3, -1);
+}
+
+// Codebook search, as in iLBC.
+void CrossCorrelation40x128()
+{
+    crossCorrelation(correlation, speech, &speech[200], 40, 128, 0, -1);
+}
+
+// LPC analysis filter of order 10 over a 30 ms frame at 8 kHz, as in iLBC.
+void FilterMA240Order10()
+{
+    filterMA(speech, output, coefficients, 11, 240);
+}
+
+// Downsampling from 48 kHz to 4 kHz, as in NetEq.
+void Downsample48To4()
+{
+    downsample(speech, kLength, output, 40, coefficients, 7, 12, 0);
+}
+
+// Downsampling from 8 kHz to 4 kHz, as in NetEq.
+void Downsample8To4()
+{
+    downsample(speech, 160, output, 80, coefficients, 3, 2, 0);
+}
+
+// Runs |function| for about |seconds| and returns the time per call in ns.
+double Measure(void (*function)(), double seconds)
+{
+    const TickTime start = TickTime::Now();
+    WebRtc_Word64 elapsedUs = 0;
+    int runs = 0;
+    do
+    {
+        for (int i = 0; i < 100; i++)
+        {
+            function();
+        }
+        runs += 100;
+        elapsedUs = (TickTime::Now() - start).Microseconds();
+    } while (elapsedUs < seconds * 1000000);
+    return 1000.0 * elapsedUs / runs;
+}
+
+void Compare(const char* name, void (*function)(), double seconds)
+{
+    dotProduct = WebRtcSpl_DotProductWithScaleC;
+    crossCorrelation = WebRtcSpl_CrossCorrelationC;
+    filterMA = WebRtcSpl_FilterMAFastQ12C;
+    downsample = WebRtcSpl_DownsampleFastC;
+    const double generic = Measure(function, seconds);
+
+    dotProduct = WebRtcSpl_DotProductWithScale;
+    crossCorrelation = WebRtcSpl_CrossCorrelation;
+    filterMA = WebRtcSpl_FilterMAFastQ12;
+    downsample = WebRtcSpl_DownsampleFast;
+    const double dispatched = Measure(function, seconds);
+
+    printf("%-32s %10.0f ns %10.0f ns %6.2fx\n", name, generic, dispatched,
+           generic / dispatched);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    double seconds = 1.0;
+    if (argc > 1)
+    {
+        seconds = atof(argv[1]);
+    }
+
+    srand(0);
+    for (int n = 0; n < kMaxFilterLength + kLength; n++)
+    {
+        input[n] = static_cast<WebRtc_Word16>((rand() % 16384) - 8192);
+    }
+    for (int n = 0; n < kMaxFilterLength; n++)
+    {
+        coefficients[n] = static_cast<WebRtc_Word16>((rand() % 2048) - 1024);
+    }
+
+    WebRtcSpl_Init();
+
+    printf("%-32s %13s %13s\n", "Time per call", "C", "WebRtcSpl_Init");
+    Compare("DotProductWithScale 320", DotProduct320, seconds);
+    Compare("CrossCorrelation 60 x 54", CrossCorrelation60x54, seconds);
+    Compare("CrossCorrelation 40 x 128", CrossCorrelation40x128, seconds);
+    Compare("FilterMAFastQ12 240, order 10", FilterMA240Order10, seconds);
+    Compare("DownsampleFast 48 to 4 kHz", Downsample48To4, seconds);
+    Compare("DownsampleFast 8 to 4 kHz", Downsample8To4, seconds);
+
+    return 0;
+}
@@ -21,7 +21,8 @@ LOCAL_SRC_FILES := \
     vad_core.c \
     vad_filterbank.c \
     vad_gmm.c \
-    vad_sp.c
+    vad_sp.c \
+    vad_sse2.c
 
 # Flags passed to both C and C++ files.
 LOCAL_CFLAGS := \
@@ -30,7 +31,10 @@ LOCAL_CFLAGS := \
 LOCAL_C_INCLUDES := \
     $(LOCAL_PATH)/include \
     $(LOCAL_PATH)/../.. \
-    $(LOCAL_PATH)/../signal_processing/include 
+    $(LOCAL_PATH)/../signal_processing/include \
+    $(LOCAL_PATH)/../../system_wrappers/interface
+
+LOCAL_STATIC_LIBRARIES += libwebrtc_system_wrappers
 
 LOCAL_SHARED_LIBRARIES := \
     libdl \
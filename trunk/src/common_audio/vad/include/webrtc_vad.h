@@ -152,6 +152,40 @@ WebRtc_Word16 WebRtcVad_Process(VadInst *vad_inst,
                                 WebRtc_Word16 *speech_frame,
                                 WebRtc_Word16 frame_length);
 
+/****************************************************************************
+ * WebRtcVad_ProcessBatch(...)
+ *
+ * This function does a VAD for one speech frame of each of several VAD
+ * instances, e.g. one per channel, with the same sampling frequency and frame
+ * length. The result and the updated state of each instance are the same as
+ * from WebRtcVad_Process() on its own frame, so the instances can be used with
+ * either function. The channels are processed a few at a time with SIMD
+ * instructions where the CPU supports them.
+ *
+ * Input
+ *        - vad_insts     : VAD instances, one per channel. Need to be
+ *                          initiated before call.
+ *        - num_channels  : Number of channels
+ *        - fs            : sampling frequency (Hz): 8000, 16000, or 32000
+ *        - speech_frames : Pointer to the speech frame buffer of each channel
+ *        - frame_length  : Length of each speech frame buffer in number of
+ *                          samples
+ *
+ * Output:
+ *        - vad_insts     : Updated VAD instances
+ *        - vad_decisions : VAD decision of each channel, 1 - Active Voice,
+ *                          0 - Non-active Voice
+ *
+ * Return value          :  0 - Ok
+ *                         -1 - Error, no instance has been updated
+ */
+WebRtc_Word16 WebRtcVad_ProcessBatch(VadInst **vad_insts,
+                                     int num_channels,
+                                     WebRtc_Word16 fs,
+                                     WebRtc_Word16 **speech_frames,
+                                     WebRtc_Word16 frame_length,
+                                     WebRtc_Word16 *vad_decisions);
+
 #ifdef __cplusplus
 }
 #endif
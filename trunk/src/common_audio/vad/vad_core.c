@@ -16,6 +16,7 @@
 
 #include "vad_core.h"
 
+#include "cpu_features_wrapper.h"
 #include "signal_processing_library.h"
 #include "typedefs.h"
 #include "vad_defines.h"
@@ -62,11 +63,29 @@ static const WebRtc_Word16 kSpeechDataStds[12] = {
 
 static const int kInitCheck = 42;
 
+// The generic C version, until WebRtcVad_InitCore() selects a faster one.
+CalcVadX4 WebRtcVad_CalcVadX4 = WebRtcVad_CalcVadX4C;
+
+// Select the fastest versions of the functions dispatched through pointers.
+static void InitFunctions(void)
+{
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    if (WebRtc_GetCPUInfo(kSSE2))
+    {
+#if defined(WEBRTC_USE_SSE2)
+        WebRtcVad_InitSSE2();
+#endif
+    }
+#endif
+}
+
 // Initialize VAD
 int WebRtcVad_InitCore(VadInstT *inst, short mode)
 {
     int i;
 
+    InitFunctions();
+
     // Initialization of struct
     inst->vad = 1;
     inst->frame_counter = 0;
@@ -324,15 +343,106 @@ WebRtc_Word16 WebRtcVad_CalcVad8khz(VadInstT *inst, WebRtc_Word16 *speech_frame,
     return inst->vad;
 }
 
+// Calculate VAD decision for one instance at any of the sampling frequencies.
+static WebRtc_Word16 CalcVad(VadInstT *inst, WebRtc_Word16 fs,
+                             WebRtc_Word16 *speech_frame, int frame_length)
+{
+    if (fs == 32000)
+    {
+        return WebRtcVad_CalcVad32khz(inst, speech_frame, frame_length);
+    } else if (fs == 16000)
+    {
+        return WebRtcVad_CalcVad16khz(inst, speech_frame, frame_length);
+    }
+    return WebRtcVad_CalcVad8khz(inst, speech_frame, frame_length);
+}
+
+void WebRtcVad_CalcVadX4C(VadInstT **insts, WebRtc_Word16 fs,
+                          WebRtc_Word16 **speech_frames, int frame_length,
+                          WebRtc_Word16 *vad)
+{
+    int i;
+
+    for (i = 0; i < 4; i++)
+    {
+        vad[i] = CalcVad(insts[i], fs, speech_frames[i], frame_length);
+    }
+}
+
+void WebRtcVad_CalcVadBatch(VadInstT **insts, int num_insts, WebRtc_Word16 fs,
+                            WebRtc_Word16 **speech_frames, int frame_length,
+                            WebRtc_Word16 *vad)
+{
+    int i = 0;
+
+    for (; i + 4 <= num_insts; i += 4)
+    {
+        WebRtcVad_CalcVadX4(&insts[i], fs, &speech_frames[i], frame_length,
+                            &vad[i]);
+    }
+    for (; i < num_insts; i++)
+    {
+        vad[i] = CalcVad(insts[i], fs, speech_frames[i], frame_length);
+    }
+}
+
 // Calculate probability for both speech and background noise, and perform a
 // hypothesis-test.
 WebRtc_Word16 WebRtcVad_GmmProbability(VadInstT *inst, WebRtc_Word16 *feature_vector,
                                        WebRtc_Word16 total_power, int frame_length)
+{
+    WebRtc_Word32 noise_probability[NUM_TABLE_VALUES];
+    WebRtc_Word32 speech_probability[NUM_TABLE_VALUES];
+    WebRtc_Word16 deltaN[NUM_TABLE_VALUES], deltaS[NUM_TABLE_VALUES];
+
+    if (total_power > MIN_ENERGY)
+    {
+        WebRtcVad_GaussianProbabilities(inst, feature_vector, noise_probability,
+                                        speech_probability, deltaN, deltaS);
+    }
+
+    return WebRtcVad_GmmDecision(inst, feature_vector, total_power, frame_length,
+                                 noise_probability, speech_probability, deltaN,
+                                 deltaS);
+}
+
+// Evaluate the Gaussians of both models in all channels.
+void WebRtcVad_GaussianProbabilities(VadInstT *inst, WebRtc_Word16 *feature_vector,
+                                     WebRtc_Word32 *noise_probability,
+                                     WebRtc_Word32 *speech_probability,
+                                     WebRtc_Word16 *deltaN, WebRtc_Word16 *deltaS)
+{
+    int n, k, pos, table_index;
+
+    for (n = 0; n < NUM_CHANNELS; n++)
+    {
+        for (k = 0; k < NUM_MODELS; k++)
+        {
+            pos = WEBRTC_SPL_LSHIFT_W16(n, 1) + k;
+            table_index = k * NUM_CHANNELS + n;
+            noise_probability[pos] = WebRtcVad_GaussianProbability(
+                feature_vector[n], inst->noise_means[table_index],
+                inst->noise_stds[table_index], &deltaN[pos]);
+            speech_probability[pos] = WebRtcVad_GaussianProbability(
+                feature_vector[n], inst->speech_means[table_index],
+                inst->speech_stds[table_index], &deltaS[pos]);
+        }
+    }
+}
+
+// Perform the hypothesis-test on Gaussians evaluated by
+// WebRtcVad_GaussianProbabilities(), and update the models.
+WebRtc_Word16 WebRtcVad_GmmDecision(VadInstT *inst, WebRtc_Word16 *feature_vector,
+                                    WebRtc_Word16 total_power, int frame_length,
+                                    const WebRtc_Word32 *noise_probability,
+                                    const WebRtc_Word32 *speech_probability,
+                                    const WebRtc_Word16 *deltaN,
+                                    const WebRtc_Word16 *deltaS)
 {
     int n, k;
     WebRtc_Word16 backval;
     WebRtc_Word16 h0, h1;
-    WebRtc_Word16 ratvec, xval;
+    WebRtc_Word16 ratvec;
     WebRtc_Word16 vadflag;
     WebRtc_Word16 shifts0, shifts1;
     WebRtc_Word16 tmp16, tmp16_1, tmp16_2;
@@ -340,7 +450,6 @@ WebRtc_Word16 WebRtcVad_GmmProbability(VadInstT *inst, WebRtc_Word16 *feature_ve
     WebRtc_Word16 nmk, nmk2, nmk3, smk, smk2, nsk, ssk;
     WebRtc_Word16 delt, ndelt;
     WebRtc_Word16 maxspe, maxmu;
-    WebRtc_Word16 deltaN[NUM_TABLE_VALUES], deltaS[NUM_TABLE_VALUES];
     WebRtc_Word16 ngprvec[NUM_TABLE_VALUES], sgprvec[NUM_TABLE_VALUES];
     WebRtc_Word32 h0test, h1test;
     WebRtc_Word32 tmp32_1, tmp32_2;
@@ -378,41 +487,24 @@ WebRtc_Word16 WebRtcVad_GmmProbability(VadInstT *inst, WebRtc_Word16 *feature_ve
     if (total_power > MIN_ENERGY)
     { // If signal present at all
 
-        // Set pointers to the gaussian parameters
-        nmean1ptr = &inst->noise_means[0];
-        nmean2ptr = &inst->noise_means[NUM_CHANNELS];
-        smean1ptr = &inst->speech_means[0];
-        smean2ptr = &inst->speech_means[NUM_CHANNELS];
-        nstd1ptr = &inst->noise_stds[0];
-        nstd2ptr = &inst->noise_stds[NUM_CHANNELS];
-        sstd1ptr = &inst->speech_stds[0];
-        sstd2ptr = &inst->speech_stds[NUM_CHANNELS];
-
         vadflag = 0;
         dotVal = 0;
         for (n = 0; n < NUM_CHANNELS; n++)
         { // For all channels
 
             pos = WEBRTC_SPL_LSHIFT_W16(n, 1);
-            xval = feature_vector[n];
 
             // Probability for Noise, Q7 * Q20 = Q27
-            tmp32_1 = WebRtcVad_GaussianProbability(xval, *nmean1ptr++, *nstd1ptr++,
-                                                    &deltaN[pos]);
-            probn[0] = (WebRtc_Word32)(kNoiseDataWeights[n] * tmp32_1);
-            tmp32_1 = WebRtcVad_GaussianProbability(xval, *nmean2ptr++, *nstd2ptr++,
-                                                    &deltaN[pos + 1]);
-            probn[1] = (WebRtc_Word32)(kNoiseDataWeights[n + NUM_CHANNELS] * tmp32_1);
+            probn[0] = (WebRtc_Word32)(kNoiseDataWeights[n] * noise_probability[pos]);
+            probn[1] = (WebRtc_Word32)(kNoiseDataWeights[n + NUM_CHANNELS]
+                    * noise_probability[pos + 1]);
             h0test = probn[0] + probn[1]; // Q27
             h0 = (WebRtc_Word16)WEBRTC_SPL_RSHIFT_W32(h0test, 12); // Q15
 
             // Probability for Speech
-            tmp32_1 = WebRtcVad_GaussianProbability(xval, *smean1ptr++, *sstd1ptr++,
-                                                    &deltaS[pos]);
-            probs[0] = (WebRtc_Word32)(kSpeechDataWeights[n] * tmp32_1);
-            tmp32_1 = WebRtcVad_GaussianProbability(xval, *smean2ptr++, *sstd2ptr++,
-                                                    &deltaS[pos + 1]);
-            probs[1] = (WebRtc_Word32)(kSpeechDataWeights[n + NUM_CHANNELS] * tmp32_1);
+            probs[0] = (WebRtc_Word32)(kSpeechDataWeights[n] * speech_probability[pos]);
+            probs[1] = (WebRtc_Word32)(kSpeechDataWeights[n + NUM_CHANNELS]
+                    * speech_probability[pos + 1]);
             h1test = probs[0] + probs[1]; // Q27
             h1 = (WebRtc_Word16)WEBRTC_SPL_RSHIFT_W32(h1test, 12); // Q15
 
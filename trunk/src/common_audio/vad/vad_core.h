@@ -129,4 +129,83 @@ WebRtc_Word16 WebRtcVad_CalcVad8khz(VadInstT* inst, WebRtc_Word16* speech_frame,
 WebRtc_Word16 WebRtcVad_GmmProbability(VadInstT* inst, WebRtc_Word16* feature_vector,
                                        WebRtc_Word16 total_power, int frame_length);
 
+/****************************************************************************
+ * WebRtcVad_GaussianProbabilities(...)
+ * WebRtcVad_GmmDecision(...)
+ *
+ * The two halves of WebRtcVad_GmmProbability(). The first evaluates the
+ * Gaussians of the noise and speech models in all channels, the second
+ * makes the VAD decision from them and updates the models. The second only
+ * reads the Gaussians when total_power > MIN_ENERGY.
+ *
+ * Input:
+ *      - inst              : Pointer to VAD instance
+ *      - feature_vector    : Feature vector = log10(energy in frequency band)
+ *      - total_power       : Total power in frame.
+ *      - frame_length      : Number of input samples
+ *
+ * Output (WebRtcVad_GaussianProbabilities),
+ * Input (WebRtcVad_GmmDecision):
+ *      - noise_probability : Gaussian probabilities of the noise model, Q20,
+ *                            at index 2 * channel + gaussian
+ *      - speech_probability: Gaussian probabilities of the speech model
+ *      - deltaN            : (x - mean) / std^2 for the noise model, Q11
+ *      - deltaS            : (x - mean) / std^2 for the speech model, Q11
+ *
+ * Return value (WebRtcVad_GmmDecision) : VAD decision as for
+ *                                        WebRtcVad_GmmProbability()
+ */
+void WebRtcVad_GaussianProbabilities(VadInstT* inst, WebRtc_Word16* feature_vector,
+                                     WebRtc_Word32* noise_probability,
+                                     WebRtc_Word32* speech_probability,
+                                     WebRtc_Word16* deltaN, WebRtc_Word16* deltaS);
+
+WebRtc_Word16 WebRtcVad_GmmDecision(VadInstT* inst, WebRtc_Word16* feature_vector,
+                                    WebRtc_Word16 total_power, int frame_length,
+                                    const WebRtc_Word32* noise_probability,
+                                    const WebRtc_Word32* speech_probability,
+                                    const WebRtc_Word16* deltaN,
+                                    const WebRtc_Word16* deltaS);
+
+/****************************************************************************
+ * WebRtcVad_CalcVadX4(...)
+ *
+ * Calculates the VAD decisions of four instances, each on its own frame of
+ * the same sampling frequency and length, with the same results as
+ * WebRtcVad_CalcVad32khz(), WebRtcVad_CalcVad16khz() or
+ * WebRtcVad_CalcVad8khz() for each of them. Points to the fastest version
+ * for this CPU once an instance has been initialized.
+ *
+ * Input:
+ *      - insts         : Four initialized instances
+ *      - fs            : Sampling frequency, 8000, 16000 or 32000
+ *      - speech_frames : Input speech frame of each instance
+ *      - frame_length  : Number of input samples in each frame
+ *
+ * Output:
+ *      - insts         : Updated filter states etc.
+ *      - vad           : VAD decision of each instance
+ */
+typedef void (*CalcVadX4)(VadInstT** insts, WebRtc_Word16 fs,
+                          WebRtc_Word16** speech_frames, int frame_length,
+                          WebRtc_Word16* vad);
+extern CalcVadX4 WebRtcVad_CalcVadX4;
+
+void WebRtcVad_CalcVadX4C(VadInstT** insts, WebRtc_Word16 fs,
+                          WebRtc_Word16** speech_frames, int frame_length,
+                          WebRtc_Word16* vad);
+
+void WebRtcVad_InitSSE2(void);
+
+/****************************************************************************
+ * WebRtcVad_CalcVadBatch(...)
+ *
+ * Calculates the VAD decisions of |num_insts| instances, four at a time
+ * through WebRtcVad_CalcVadX4(). The arguments are as for
+ * WebRtcVad_CalcVadX4(), with |num_insts| elements instead of four.
+ */
+void WebRtcVad_CalcVadBatch(VadInstT** insts, int num_insts, WebRtc_Word16 fs,
+                            WebRtc_Word16** speech_frames, int frame_length,
+                            WebRtc_Word16* vad);
+
 #endif // WEBRTC_VAD_CORE_H_
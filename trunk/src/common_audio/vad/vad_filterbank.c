@@ -214,6 +214,29 @@ WebRtc_Word16 WebRtcVad_get_features(VadInstT *inst,
     return power;
 }
 
+WebRtc_Word16 WebRtcVad_SubbandFeatures(WebRtc_Word16* const* subbands,
+                                        int frame_size,
+                                        WebRtc_Word16 *out_vector)
+{
+    int band, curlen;
+    WebRtc_Word16 power = 0;
+
+    // Same order as in WebRtcVad_get_features(), since the total power stops
+    // being updated once it exceeds MIN_ENERGY.
+    for (band = NUM_CHANNELS - 1; band >= 0; band--)
+    {
+        curlen = WEBRTC_SPL_RSHIFT_W16(frame_size, 2);
+        if (band < 3)
+        {
+            curlen = WEBRTC_SPL_RSHIFT_W16(curlen, band < 2 ? 2 : 1);
+        }
+        WebRtcVad_LogOfEnergy(subbands[band], &out_vector[band], &power,
+                              kOffsetVector[band], curlen);
+    }
+
+    return power;
+}
+
 void WebRtcVad_LogOfEnergy(WebRtc_Word16 *vector,
                            WebRtc_Word16 *enerlogval,
                            WebRtc_Word16 *power,
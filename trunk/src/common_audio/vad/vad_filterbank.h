@@ -140,4 +140,26 @@ void WebRtcVad_LogOfEnergy(WebRtc_Word16* vector,
                            WebRtc_Word16 offset,
                            int vector_length);
 
+/****************************************************************************
+ * WebRtcVad_SubbandFeatures(...)
+ *
+ * This function gives the same features as WebRtcVad_get_features(), from
+ * the six frequency band signals its filterbank produces.
+ *
+ * Input:
+ *      - subbands    : Signal of each frequency band, lowest band first. The
+ *                      three upper bands have frame_size / 4 samples, the
+ *                      next one frame_size / 8 and the two lowest
+ *                      frame_size / 16.
+ *      - frame_size  : Frame size, in number of samples
+ *
+ * Output:
+ *      - out_vector  : 10*log10(power in each freq. band), Q4
+ *
+ * Return: total power in the signal, as for WebRtcVad_get_features()
+ */
+WebRtc_Word16 WebRtcVad_SubbandFeatures(WebRtc_Word16* const* subbands,
+                                        int frame_size,
+                                        WebRtc_Word16* out_vector);
+
 #endif // WEBRTC_VAD_FILTERBANK_H_
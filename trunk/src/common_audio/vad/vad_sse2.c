@@ -0,0 +1,482 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+
+/*
+ * This file contains the SSE2 version of WebRtcVad_CalcVadX4(), and
+ * WebRtcVad_InitSSE2().
+ *
+ * The four 32-bit elements of a vector hold the same value of four
+ * instances, so the downsampling, the filterbank and the Gaussians run on
+ * four frames at once. Each element follows the C code step by step, with
+ * the same truncations to 16 bits, so the results are bit-exact. The
+ * energies, the hypothesis test and the model update are done per instance
+ * by the C functions.
+ */
+
+#include "typedefs.h"
+
+#if defined(WEBRTC_USE_SSE2)
+#include <emmintrin.h>
+
+#include "vad_core.h"
+#include "vad_defines.h"
+#include "vad_filterbank.h"
+
+// Longest frame, 30 ms at 32 kHz.
+#define VAD_MAX_FRAME_LENGTH 960
+
+// Arrays of vectors are stored as WebRtc_Word32, four per sample.
+#define LOAD(p, n) _mm_loadu_si128((const __m128i*) &(p)[4 * (n)])
+#define STORE(p, n, v) _mm_storeu_si128((__m128i*) &(p)[4 * (n)], (v))
+
+// Loads |field| of the four instances.
+#define GATHER(insts, field) \
+    _mm_setr_epi32((insts)[0]->field, (insts)[1]->field, (insts)[2]->field, \
+                   (insts)[3]->field)
+
+// Stores the elements of |v| in |field| of the four instances.
+#define SCATTER(insts, field, type, v) \
+    do { \
+        WebRtc_Word32 lanes[4]; \
+        _mm_storeu_si128((__m128i*) lanes, (v)); \
+        (insts)[0]->field = (type) lanes[0]; \
+        (insts)[1]->field = (type) lanes[1]; \
+        (insts)[2]->field = (type) lanes[2]; \
+        (insts)[3]->field = (type) lanes[3]; \
+    } while (0)
+
+// Coefficients as in vad_sp.c, vad_filterbank.c and vad_gmm.c.
+static const WebRtc_Word16 kAllPassCoefsQ13[2] = {5243, 1392};
+static const WebRtc_Word16 kAllPassCoefsQ15[2] = {20972, 5571};
+static const WebRtc_Word16 kHpZeroCoefs[3] = {6631, -13262, 6631};
+static const WebRtc_Word16 kHpPoleCoefs[3] = {16384, -7756, 5620};
+static const WebRtc_Word32 kCompVar = 22005;
+static const WebRtc_Word16 kLog10Const = 5909;
+
+// Sign extends the low 16 bits of each element, as a cast to WebRtc_Word16.
+static __inline __m128i Wrap16(__m128i x)
+{
+    return _mm_srai_epi32(_mm_slli_epi32(x, 16), 16);
+}
+
+// Returns a 16-bit constant in the form Mul16() takes.
+static __inline __m128i Constant16(WebRtc_Word16 c)
+{
+    return _mm_set1_epi32(c & 0x0000FFFF);
+}
+
+// WEBRTC_SPL_MUL_16_16(a, b) of each element, with the upper 16 bits of
+// each element of |b| zero.
+static __inline __m128i Mul16(__m128i a, __m128i b)
+{
+    return _mm_madd_epi16(a, b);
+}
+
+// WEBRTC_SPL_MUL_16_16(a, b) of each element.
+static __inline __m128i Mul16Var(__m128i a, __m128i b)
+{
+    return _mm_madd_epi16(a, _mm_and_si128(b, _mm_set1_epi32(0x0000FFFF)));
+}
+
+// x / y of each element, truncated towards zero as in WebRtcSpl_DivW32W16().
+// The doubles hold the quotients of 32-bit numbers exactly enough for that.
+static __inline __m128i Div(__m128i x, __m128i y)
+{
+    const __m128d q_low = _mm_div_pd(_mm_cvtepi32_pd(x), _mm_cvtepi32_pd(y));
+    const __m128d q_high = _mm_div_pd(_mm_cvtepi32_pd(_mm_srli_si128(x, 8)),
+                                      _mm_cvtepi32_pd(_mm_srli_si128(y, 8)));
+    return _mm_unpacklo_epi64(_mm_cvttpd_epi32(q_low),
+                              _mm_cvttpd_epi32(q_high));
+}
+
+// x >> shift of each element, for shifts of 0 to 31.
+static __inline __m128i ShiftRightVar(__m128i x, __m128i shift)
+{
+    __m128i bit, mask;
+
+#define SHIFT_BIT(b) \
+    bit = _mm_set1_epi32(b); \
+    mask = _mm_cmpeq_epi32(_mm_and_si128(shift, bit), bit); \
+    x = _mm_or_si128(_mm_and_si128(mask, _mm_srai_epi32(x, b)), \
+                     _mm_andnot_si128(mask, x));
+    SHIFT_BIT(1)
+    SHIFT_BIT(2)
+    SHIFT_BIT(4)
+    SHIFT_BIT(8)
+    SHIFT_BIT(16)
+#undef SHIFT_BIT
+
+    return x;
+}
+
+// Interleaves the four frames into |out|.
+static void Gather(WebRtc_Word16** speech_frames, int frame_length,
+                   WebRtc_Word32* out)
+{
+    int n;
+
+    for (n = 0; n + 8 <= frame_length; n += 8)
+    {
+        const __m128i a = _mm_loadu_si128((const __m128i*) &speech_frames[0][n]);
+        const __m128i b = _mm_loadu_si128((const __m128i*) &speech_frames[1][n]);
+        const __m128i c = _mm_loadu_si128((const __m128i*) &speech_frames[2][n]);
+        const __m128i d = _mm_loadu_si128((const __m128i*) &speech_frames[3][n]);
+        const __m128i ab_low = _mm_unpacklo_epi16(a, b);
+        const __m128i ab_high = _mm_unpackhi_epi16(a, b);
+        const __m128i cd_low = _mm_unpacklo_epi16(c, d);
+        const __m128i cd_high = _mm_unpackhi_epi16(c, d);
+        __m128i abcd[4];
+        int i;
+
+        abcd[0] = _mm_unpacklo_epi32(ab_low, cd_low);
+        abcd[1] = _mm_unpackhi_epi32(ab_low, cd_low);
+        abcd[2] = _mm_unpacklo_epi32(ab_high, cd_high);
+        abcd[3] = _mm_unpackhi_epi32(ab_high, cd_high);
+        for (i = 0; i < 4; i++)
+        {
+            // Sign extend to 32 bits.
+            STORE(out, n + 2 * i,
+                  _mm_srai_epi32(_mm_unpacklo_epi16(abcd[i], abcd[i]), 16));
+            STORE(out, n + 2 * i + 1,
+                  _mm_srai_epi32(_mm_unpackhi_epi16(abcd[i], abcd[i]), 16));
+        }
+    }
+    for (; n < frame_length; n++)
+    {
+        STORE(out, n, _mm_setr_epi32(speech_frames[0][n], speech_frames[1][n],
+                                     speech_frames[2][n], speech_frames[3][n]));
+    }
+}
+
+// Copies the elements of instance |lane| out of |in|.
+static void Extract(const WebRtc_Word32* in, int lane, int length,
+                    WebRtc_Word16* out)
+{
+    int n;
+
+    for (n = 0; n < length; n++)
+    {
+        out[n] = (WebRtc_Word16) in[4 * n + lane];
+    }
+}
+
+// As WebRtcVad_Downsampling().
+static void DownsamplingX4(const WebRtc_Word32* signal_in,
+                           WebRtc_Word32* signal_out,
+                           __m128i* filter_state, int inlen)
+{
+    const __m128i coef1 = Constant16(kAllPassCoefsQ13[0]);
+    const __m128i coef2 = Constant16(kAllPassCoefsQ13[1]);
+    __m128i state1 = filter_state[0];
+    __m128i state2 = filter_state[1];
+    int n;
+
+    for (n = 0; n < (inlen >> 1); n++)
+    {
+        const __m128i in1 = LOAD(signal_in, 2 * n);
+        const __m128i in2 = LOAD(signal_in, 2 * n + 1);
+        const __m128i out1 = Wrap16(_mm_add_epi32(
+            _mm_srai_epi32(state1, 1), _mm_srai_epi32(Mul16(in1, coef1), 14)));
+        const __m128i out2 = Wrap16(_mm_add_epi32(
+            _mm_srai_epi32(state2, 1), _mm_srai_epi32(Mul16(in2, coef2), 14)));
+
+        state1 = _mm_sub_epi32(in1, _mm_srai_epi32(Mul16(out1, coef1), 12));
+        state2 = _mm_sub_epi32(in2, _mm_srai_epi32(Mul16(out2, coef2), 12));
+        STORE(signal_out, n, Wrap16(_mm_add_epi32(out1, out2)));
+    }
+
+    filter_state[0] = state1;
+    filter_state[1] = state2;
+}
+
+// As WebRtcVad_Allpass(), on every second element of |in_vector|.
+static void AllpassX4(const WebRtc_Word32* in_vector,
+                      WebRtc_Word32* out_vector,
+                      WebRtc_Word16 filter_coefficients, int vector_length,
+                      __m128i* filter_state)
+{
+    const __m128i coef = Constant16(filter_coefficients);
+    __m128i state32 = _mm_slli_epi32(*filter_state, 16);
+    int n;
+
+    for (n = 0; n < vector_length; n++)
+    {
+        const __m128i in = LOAD(in_vector, 2 * n);
+        const __m128i out = _mm_srai_epi32(
+            _mm_add_epi32(state32, Mul16(in, coef)), 16);
+
+        STORE(out_vector, n, out);
+        state32 = _mm_slli_epi32(
+            _mm_sub_epi32(_mm_slli_epi32(in, 14), Mul16(out, coef)), 1);
+    }
+
+    *filter_state = _mm_srai_epi32(state32, 16);
+}
+
+// As WebRtcVad_SplitFilter().
+static void SplitFilterX4(const WebRtc_Word32* in_vector,
+                          WebRtc_Word32* out_vector_hp,
+                          WebRtc_Word32* out_vector_lp,
+                          __m128i* upper_state, __m128i* lower_state,
+                          int in_vector_length)
+{
+    const int halflen = in_vector_length >> 1;
+    int k;
+
+    AllpassX4(&in_vector[0], out_vector_hp, kAllPassCoefsQ15[0], halflen,
+              upper_state);
+    AllpassX4(&in_vector[4], out_vector_lp, kAllPassCoefsQ15[1], halflen,
+              lower_state);
+
+    for (k = 0; k < halflen; k++)
+    {
+        const __m128i hp = LOAD(out_vector_hp, k);
+        const __m128i lp = LOAD(out_vector_lp, k);
+        STORE(out_vector_hp, k, Wrap16(_mm_sub_epi32(hp, lp)));
+        STORE(out_vector_lp, k, Wrap16(_mm_add_epi32(lp, hp)));
+    }
+}
+
+// As WebRtcVad_HpOutput().
+static void HpOutputX4(const WebRtc_Word32* in_vector, int in_vector_length,
+                       WebRtc_Word32* out_vector, __m128i* filter_state)
+{
+    const __m128i zero0 = Constant16(kHpZeroCoefs[0]);
+    const __m128i zero1 = Constant16(kHpZeroCoefs[1]);
+    const __m128i zero2 = Constant16(kHpZeroCoefs[2]);
+    const __m128i pole1 = Constant16(kHpPoleCoefs[1]);
+    const __m128i pole2 = Constant16(kHpPoleCoefs[2]);
+    __m128i state0 = filter_state[0];
+    __m128i state1 = filter_state[1];
+    __m128i state2 = filter_state[2];
+    __m128i state3 = filter_state[3];
+    int i;
+
+    for (i = 0; i < in_vector_length; i++)
+    {
+        const __m128i in = LOAD(in_vector, i);
+        __m128i tmp32 = _mm_add_epi32(
+            _mm_add_epi32(Mul16(in, zero0), Mul16(state0, zero1)),
+            Mul16(state1, zero2));
+
+        state1 = state0;
+        state0 = in;
+        tmp32 = _mm_sub_epi32(
+            _mm_sub_epi32(tmp32, Mul16(state2, pole1)), Mul16(state3, pole2));
+        state3 = state2;
+        state2 = Wrap16(_mm_srai_epi32(tmp32, 14));
+        STORE(out_vector, i, state2);
+    }
+
+    filter_state[0] = state0;
+    filter_state[1] = state1;
+    filter_state[2] = state2;
+    filter_state[3] = state3;
+}
+
+// As WebRtcVad_GaussianProbability(). The standard deviations are never
+// below the minimum the models are limited to, so they are never zero.
+static __inline __m128i GaussianProbabilityX4(__m128i in_sample, __m128i mean,
+                                              __m128i std, __m128i* delta)
+{
+    __m128i tmp16, tmp32, tmpDiv, tmpDiv2, expVal, tmp16_1, tmp16_2, mask;
+
+    // 1 / std in Q10, and 1 / std^2 in Q14.
+    tmp32 = _mm_add_epi32(_mm_srai_epi32(std, 1), _mm_set1_epi32(131072));
+    tmpDiv = Wrap16(Div(tmp32, std));
+    tmp16 = _mm_srai_epi32(tmpDiv, 2);
+    tmpDiv2 = Wrap16(_mm_srai_epi32(Mul16Var(tmp16, tmp16), 2));
+
+    // (x - m) / std^2 in Q11, and (x - m)^2 / (2 * std^2) in Q10.
+    tmp16 = Wrap16(_mm_sub_epi32(_mm_slli_epi32(in_sample, 3), mean));
+    *delta = Wrap16(_mm_srai_epi32(Mul16Var(tmpDiv2, tmp16), 10));
+    tmp32 = _mm_srai_epi32(Mul16Var(*delta, tmp16), 9);
+
+    // exp(-tmp32), zero where tmp32 >= kCompVar.
+    mask = _mm_cmplt_epi32(tmp32, _mm_set1_epi32(kCompVar));
+    tmp16 = Wrap16(_mm_srai_epi32(Mul16(tmp32, Constant16(kLog10Const)), 12));
+    tmp16 = Wrap16(_mm_sub_epi32(_mm_setzero_si128(), tmp16));
+    tmp16_2 = _mm_or_si128(_mm_set1_epi32(0x0400),
+                           _mm_and_si128(tmp16, _mm_set1_epi32(0x03FF)));
+    tmp16_1 = Wrap16(_mm_xor_si128(tmp16, _mm_set1_epi32(0xFFFF)));
+    tmp16 = _mm_add_epi32(_mm_srai_epi32(tmp16_1, 10), _mm_set1_epi32(1));
+    expVal = _mm_and_si128(mask, Wrap16(ShiftRightVar(tmp16_2, tmp16)));
+
+    return Mul16Var(tmpDiv, expVal);
+}
+
+// As WebRtcVad_GaussianProbabilities(), for the four instances.
+static void GaussianProbabilitiesX4(VadInstT** insts,
+                                    WebRtc_Word16 feature_vector[4][NUM_CHANNELS],
+                                    WebRtc_Word32 noise_probability[4][NUM_TABLE_VALUES],
+                                    WebRtc_Word32 speech_probability[4][NUM_TABLE_VALUES],
+                                    WebRtc_Word16 deltaN[4][NUM_TABLE_VALUES],
+                                    WebRtc_Word16 deltaS[4][NUM_TABLE_VALUES])
+{
+    WebRtc_Word32 probability[2][4], delta[2][4];
+    int n, k, pos, table_index, i;
+
+    for (n = 0; n < NUM_CHANNELS; n++)
+    {
+        const __m128i feature = _mm_setr_epi32(feature_vector[0][n],
+                                               feature_vector[1][n],
+                                               feature_vector[2][n],
+                                               feature_vector[3][n]);
+        for (k = 0; k < NUM_MODELS; k++)
+        {
+            __m128i deltas;
+
+            pos = (n << 1) + k;
+            table_index = k * NUM_CHANNELS + n;
+            _mm_storeu_si128((__m128i*) probability[0], GaussianProbabilityX4(
+                feature, GATHER(insts, noise_means[table_index]),
+                GATHER(insts, noise_stds[table_index]), &deltas));
+            _mm_storeu_si128((__m128i*) delta[0], deltas);
+            _mm_storeu_si128((__m128i*) probability[1], GaussianProbabilityX4(
+                feature, GATHER(insts, speech_means[table_index]),
+                GATHER(insts, speech_stds[table_index]), &deltas));
+            _mm_storeu_si128((__m128i*) delta[1], deltas);
+            for (i = 0; i < 4; i++)
+            {
+                noise_probability[i][pos] = probability[0][i];
+                speech_probability[i][pos] = probability[1][i];
+                deltaN[i][pos] = (WebRtc_Word16) delta[0][i];
+                deltaS[i][pos] = (WebRtc_Word16) delta[1][i];
+            }
+        }
+    }
+}
+
+// As WebRtcVad_CalcVad8khz(), for the four instances.
+static void CalcVad8khzX4(VadInstT** insts, const WebRtc_Word32* speech_frame,
+                          int frame_length, WebRtc_Word16* vad)
+{
+    // The six bands, and the signals the filterbank splits them from.
+    WebRtc_Word32 vecHP1[4 * 120], vecLP1[4 * 120];
+    WebRtc_Word32 vecHP2[4 * 60], vecLP2[4 * 60];
+    WebRtc_Word32 vecHP3[4 * 60], vecLP3[4 * 60];
+    WebRtc_Word32 vecHP4[4 * 30], vecLP4[4 * 30];
+    WebRtc_Word32 vecHP5[4 * 15], vecLP5[4 * 15];
+    WebRtc_Word32 vecHP6[4 * 15];
+    const WebRtc_Word32* bands[NUM_CHANNELS] = {
+        vecHP6, vecHP5, vecHP4, vecHP3, vecLP2, vecHP2 };
+    WebRtc_Word16 subband_samples[NUM_CHANNELS][60];
+    WebRtc_Word16* subbands[NUM_CHANNELS];
+    WebRtc_Word16 feature_vector[4][NUM_CHANNELS], total_power[4];
+    WebRtc_Word32 noise_probability[4][NUM_TABLE_VALUES];
+    WebRtc_Word32 speech_probability[4][NUM_TABLE_VALUES];
+    WebRtc_Word16 deltaN[4][NUM_TABLE_VALUES], deltaS[4][NUM_TABLE_VALUES];
+    __m128i upper_state[5], lower_state[5], hp_filter_state[4];
+    int i, band, band_length;
+
+    for (i = 0; i < 5; i++)
+    {
+        upper_state[i] = GATHER(insts, upper_state[i]);
+        lower_state[i] = GATHER(insts, lower_state[i]);
+    }
+    for (i = 0; i < 4; i++)
+    {
+        hp_filter_state[i] = GATHER(insts, hp_filter_state[i]);
+    }
+
+    // The filterbank of WebRtcVad_get_features().
+    SplitFilterX4(speech_frame, vecHP1, vecLP1, &upper_state[0],
+                  &lower_state[0], frame_length);
+    SplitFilterX4(vecHP1, vecHP2, vecLP2, &upper_state[1], &lower_state[1],
+                  frame_length >> 1);
+    SplitFilterX4(vecLP1, vecHP3, vecLP3, &upper_state[2], &lower_state[2],
+                  frame_length >> 1);
+    SplitFilterX4(vecLP3, vecHP4, vecLP4, &upper_state[3], &lower_state[3],
+                  frame_length >> 2);
+    SplitFilterX4(vecLP4, vecHP5, vecLP5, &upper_state[4], &lower_state[4],
+                  frame_length >> 3);
+    HpOutputX4(vecLP5, frame_length >> 4, vecHP6, hp_filter_state);
+
+    for (i = 0; i < 5; i++)
+    {
+        SCATTER(insts, upper_state[i], WebRtc_Word16, upper_state[i]);
+        SCATTER(insts, lower_state[i], WebRtc_Word16, lower_state[i]);
+    }
+    for (i = 0; i < 4; i++)
+    {
+        SCATTER(insts, hp_filter_state[i], WebRtc_Word16, hp_filter_state[i]);
+    }
+
+    for (i = 0; i < 4; i++)
+    {
+        for (band = 0; band < NUM_CHANNELS; band++)
+        {
+            band_length = frame_length >> (band < 2 ? 4 : (band < 3 ? 3 : 2));
+            Extract(bands[band], i, band_length, subband_samples[band]);
+            subbands[band] = subband_samples[band];
+        }
+        total_power[i] = WebRtcVad_SubbandFeatures(subbands, frame_length,
+                                                   feature_vector[i]);
+    }
+
+    GaussianProbabilitiesX4(insts, feature_vector, noise_probability,
+                            speech_probability, deltaN, deltaS);
+
+    for (i = 0; i < 4; i++)
+    {
+        insts[i]->vad = WebRtcVad_GmmDecision(insts[i], feature_vector[i],
+                                              total_power[i], frame_length,
+                                              noise_probability[i],
+                                              speech_probability[i],
+                                              deltaN[i], deltaS[i]);
+        vad[i] = insts[i]->vad;
+    }
+}
+
+static void CalcVadX4SSE2(VadInstT** insts, WebRtc_Word16 fs,
+                          WebRtc_Word16** speech_frames, int frame_length,
+                          WebRtc_Word16* vad)
+{
+    WebRtc_Word32 speech[4 * VAD_MAX_FRAME_LENGTH];
+    WebRtc_Word32 speechWB[4 * VAD_MAX_FRAME_LENGTH / 2];
+    __m128i filter_state[4];
+    WebRtc_Word32* speechNB = speech;
+    int i;
+
+    Gather(speech_frames, frame_length, speech);
+
+    if (fs != 8000)
+    {
+        for (i = 0; i < 4; i++)
+        {
+            filter_state[i] = GATHER(insts, downsampling_filter_states[i]);
+        }
+        if (fs == 32000)
+        {
+            DownsamplingX4(speech, speechWB, &filter_state[2], frame_length);
+            frame_length >>= 1;
+            speechNB = speechWB;
+        }
+        // Downsample 16 -> 8 kHz in place.
+        DownsamplingX4(speechNB, speech, &filter_state[0], frame_length);
+        frame_length >>= 1;
+        speechNB = speech;
+        for (i = 0; i < 4; i++)
+        {
+            SCATTER(insts, downsampling_filter_states[i], WebRtc_Word32,
+                    filter_state[i]);
+        }
+    }
+
+    CalcVad8khzX4(insts, speechNB, frame_length, vad);
+}
+
+void WebRtcVad_InitSSE2(void)
+{
+    WebRtcVad_CalcVadX4 = CalcVadX4SSE2;
+}
+
+#endif  // WEBRTC_USE_SSE2
@@ -10,6 +10,7 @@
 
 #include <stddef.h> // size_t
 #include <stdlib.h>
+#include <string.h>
 
 #include "gtest/gtest.h"
 #include "typedefs.h"
@@ -152,6 +153,92 @@ TEST_F(VadTest, ApiTest) {
   EXPECT_EQ(0, WebRtcVad_Free(handle));
 }
 
+TEST_F(VadTest, ProcessBatchMatchesProcess) {
+  // Seven channels, so that the batch is not a multiple of the number of
+  // channels processed at once.
+  const int kChannels = 7;
+  const int kFrames = 200;
+  int handle_size_bytes = 0;
+  ASSERT_EQ(0, WebRtcVad_AssignSize(&handle_size_bytes));
+  char* memory = static_cast<char*>(malloc(2 * kChannels * handle_size_bytes));
+  int16_t* frames = static_cast<int16_t*>(
+      malloc(kChannels * kMaxFrameLength * sizeof(int16_t)));
+  VadInst* batch_handles[kChannels];
+  VadInst* handles[kChannels];
+  int16_t* speech[kChannels];
+  int16_t decisions[kChannels];
+
+  srand(17);
+  for (size_t i = 0; i < kRatesSize; i++) {
+    for (size_t j = 0; j < kFrameLengthsSize; j++) {
+      if (!ValidRatesAndFrameLengths(kRates[i], kFrameLengths[j])) {
+        continue;
+      }
+      // Instances in memory of our own, to compare their states.
+      memset(memory, 0, 2 * kChannels * handle_size_bytes);
+      for (int c = 0; c < kChannels; c++) {
+        ASSERT_EQ(0, WebRtcVad_Assign(&batch_handles[c],
+                                      &memory[c * handle_size_bytes]));
+        ASSERT_EQ(0, WebRtcVad_Assign(
+            &handles[c], &memory[(kChannels + c) * handle_size_bytes]));
+        ASSERT_EQ(0, WebRtcVad_Init(batch_handles[c]));
+        ASSERT_EQ(0, WebRtcVad_Init(handles[c]));
+        ASSERT_EQ(0, WebRtcVad_set_mode(batch_handles[c],
+                                        kModes[c % kModesSize]));
+        ASSERT_EQ(0, WebRtcVad_set_mode(handles[c], kModes[c % kModesSize]));
+        speech[c] = &frames[c * kMaxFrameLength];
+      }
+
+      for (int frame = 0; frame < kFrames; frame++) {
+        // Noise with bursts of different levels, so that the channels both
+        // trigger the VAD and adapt their noise models.
+        for (int c = 0; c < kChannels; c++) {
+          const int level = ((frame / 10 + c) % 4 == 0) ? 8000 :
+              (((frame / 3 + c) % 5 == 0) ? 0 : 30 * (c + 1));
+          for (int n = 0; n < kFrameLengths[j]; n++) {
+            speech[c][n] = static_cast<int16_t>(
+                level > 0 ? (rand() % (2 * level)) - level : 0);
+          }
+        }
+
+        ASSERT_EQ(0, WebRtcVad_ProcessBatch(batch_handles, kChannels,
+                                            kRates[i], speech,
+                                            kFrameLengths[j], decisions));
+        for (int c = 0; c < kChannels; c++) {
+          EXPECT_EQ(WebRtcVad_Process(handles[c], kRates[i], speech[c],
+                                      kFrameLengths[j]), decisions[c]);
+        }
+        ASSERT_EQ(0, memcmp(memory, &memory[kChannels * handle_size_bytes],
+                            kChannels * handle_size_bytes))
+            << "rate " << kRates[i] << ", frame length " << kFrameLengths[j]
+            << ", frame " << frame;
+      }
+    }
+  }
+
+  // Errors leave all instances as they were.
+  EXPECT_EQ(-1, WebRtcVad_ProcessBatch(NULL, kChannels, kRates[0], speech,
+                                       kFrameLengths[0], decisions));
+  EXPECT_EQ(-1, WebRtcVad_ProcessBatch(batch_handles, kChannels, kRates[0],
+                                       NULL, kFrameLengths[0], decisions));
+  EXPECT_EQ(-1, WebRtcVad_ProcessBatch(batch_handles, kChannels, kRates[0],
+                                       speech, kFrameLengths[0], NULL));
+  EXPECT_EQ(-1, WebRtcVad_ProcessBatch(batch_handles, kChannels, 9999, speech,
+                                       kFrameLengths[0], decisions));
+  EXPECT_EQ(-1, WebRtcVad_ProcessBatch(batch_handles, kChannels, kRates[0],
+                                       speech, kFrameLengths[3], decisions));
+  speech[kChannels - 1] = NULL;
+  EXPECT_EQ(-1, WebRtcVad_ProcessBatch(batch_handles, kChannels, kRates[0],
+                                       speech, kFrameLengths[0], decisions));
+  EXPECT_EQ(0, memcmp(memory, &memory[kChannels * handle_size_bytes],
+                      kChannels * handle_size_bytes));
+  EXPECT_EQ(0, WebRtcVad_ProcessBatch(batch_handles, 0, kRates[0], speech,
+                                      kFrameLengths[0], decisions));
+
+  free(frames);
+  free(memory);
+}
+
 // TODO(bjornv): Add a process test, run on file.
 
 }  // namespace
@@ -195,3 +195,65 @@ WebRtc_Word16 WebRtcVad_Process(VadInst *vad_inst,
         return -1;
     }
 }
+
+WebRtc_Word16 WebRtcVad_ProcessBatch(VadInst **vad_insts,
+                                     int num_channels,
+                                     WebRtc_Word16 fs,
+                                     WebRtc_Word16 **speech_frames,
+                                     WebRtc_Word16 frame_length,
+                                     WebRtc_Word16 *vad_decisions)
+{
+    int i;
+
+    if ((vad_insts == NULL) || (speech_frames == NULL) || (vad_decisions == NULL)
+            || (num_channels < 0))
+    {
+        return -1;
+    }
+
+    // Check all channels first, so that an error leaves every instance as it was
+    for (i = 0; i < num_channels; i++)
+    {
+        if ((vad_insts[i] == NULL) || (speech_frames[i] == NULL))
+        {
+            return -1;
+        }
+        if (((VadInstT*)vad_insts[i])->init_flag != kInitCheck)
+        {
+            return -1;
+        }
+    }
+
+    if (fs == 32000)
+    {
+        if ((frame_length != 320) && (frame_length != 640) && (frame_length != 960))
+        {
+            return -1;
+        }
+    } else if (fs == 16000)
+    {
+        if ((frame_length != 160) && (frame_length != 320) && (frame_length != 480))
+        {
+            return -1;
+        }
+    } else if (fs == 8000)
+    {
+        if ((frame_length != 80) && (frame_length != 160) && (frame_length != 240))
+        {
+            return -1;
+        }
+    } else
+    {
+        return -1; // Not a supported sampling frequency
+    }
+
+    WebRtcVad_CalcVadBatch((VadInstT**)vad_insts, num_channels, fs, speech_frames,
+                           frame_length, vad_decisions);
+
+    for (i = 0; i < num_channels; i++)
+    {
+        vad_decisions[i] = (vad_decisions[i] > 0) ? 1 : 0;
+    }
+
+    return 0;
+}
@@ -195,6 +195,42 @@ protected:
     Transport() {}
 };
 
+// ==================================================================
+// Pipeline latency types
+// ==================================================================
+
+// Stages of the media pipeline for which the latency is measured per channel.
+enum LatencyStage
+{
+    kLatencyCaptureToEncode = 0, // captured until handed to the encoder
+    kLatencyEncode          = 1, // encoder input until encoded output
+    kLatencyPacketize       = 2, // encoded output until packetized and sent
+    kLatencyTransport       = 3, // time spent in Transport::SendPacket()
+    kLatencyJitterBuffer    = 4, // last packet received until decoding starts
+    kLatencyDecode          = 5, // decoder input until decoded output
+    kLatencyRender          = 6, // decoded until rendered
+    kNumLatencyStages       = 7
+};
+
+enum { kLatencyHistogramBins = 10 };
+
+// Latency distribution of one pipeline stage. The upper limits of the bins
+// are 1, 2, 5, 10, 20, 50, 100, 200 and 500 ms; the last bin counts all
+// samples above 500 ms.
+struct LatencyHistogram
+{
+    unsigned int samples;
+    int minMs;
+    int maxMs;
+    int averageMs;
+    unsigned int bins[kLatencyHistogramBins];
+};
+
+struct LatencyStatistics
+{
+    LatencyHistogram stages[kNumLatencyStages];
+};
+
 // ==================================================================
 // Voice specific types
 // ==================================================================
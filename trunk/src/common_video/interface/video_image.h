@@ -17,6 +17,8 @@
 namespace webrtc
 {
 
+class PlaneReleaseCallback;
+
 enum VideoFrameType
 {
     kKeyFrame = 0,
@@ -30,12 +32,21 @@ class RawImage
 {
 public:
     RawImage() :    _width(0), _height(0), _timeStamp(0), _buffer(NULL),
-                    _length(0), _size(0) {}
+                    _length(0), _size(0), _releaseCallback(NULL)
+    {
+        _planes[0] = _planes[1] = _planes[2] = NULL;
+        _strides[0] = _strides[1] = _strides[2] = 0;
+    }
 
     RawImage(WebRtc_UWord8* buffer, WebRtc_UWord32 length,
              WebRtc_UWord32 size) :
                     _width(0), _height(0), _timeStamp(0),
-                    _buffer(buffer), _length(length), _size(size) {}
+                    _buffer(buffer), _length(length), _size(size),
+                    _releaseCallback(NULL)
+    {
+        _planes[0] = _planes[1] = _planes[2] = NULL;
+        _strides[0] = _strides[1] = _strides[2] = 0;
+    }
 
     WebRtc_UWord32    _width;
     WebRtc_UWord32    _height;
@@ -43,6 +54,13 @@ public:
     WebRtc_UWord8*    _buffer;
     WebRtc_UWord32    _length;
     WebRtc_UWord32    _size;
+
+    // If _planes[0] is not NULL, the I420 picture is not packed in _buffer
+    // but described by _planes and _strides. If it is lent by its owner,
+    // _releaseCallback must be called once it is no longer referenced.
+    WebRtc_UWord8*        _planes[3];
+    int                   _strides[3];
+    PlaneReleaseCallback* _releaseCallback;
 };
 
 class EncodedImage
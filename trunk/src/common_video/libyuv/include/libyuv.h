@@ -306,6 +306,71 @@ int ConvertToI420AndRotate(const uint8_t* src_frame,
                            int width,
                            VideoType src_video_type,
                            VideoRotationMode mode);
+
+// Planar I420 image.
+// Each of the Y, U and V planes is given by a pointer to its first row and
+// its stride, the distance in bytes between the starts of two rows. Rows
+// need not follow each other, so an image can be a crop of a larger one,
+// or have its rows padded to aligned addresses, without being copied. The
+// chroma planes are (width + 1) / 2 by (height + 1) / 2 pixels.
+enum I420PlaneType {
+  kYPlane = 0,
+  kUPlane = 1,
+  kVPlane = 2,
+  kNumOfI420Planes = 3
+};
+
+struct I420Planes {
+  I420Planes();
+
+  uint8_t* plane[kNumOfI420Planes];
+  int stride[kNumOfI420Planes];
+  int width;
+  int height;
+};
+
+// Describes a packed I420 buffer, with a stride equal to the plane width.
+// This is the layout that the functions above expect.
+void I420PlanesFromBuffer(uint8_t* buffer, int width, int height,
+                          I420Planes* planes);
+
+// Sets dst_planes to the width x height rectangle of src_planes whose top
+// left corner is at (left, top). Nothing is copied. left and top must be
+// even, since the chroma planes are subsampled.
+// Return value: 0 if OK, < 0 otherwise.
+int CropI420Planes(const I420Planes& src_planes,
+                   int left, int top,
+                   int width, int height,
+                   I420Planes* dst_planes);
+
+// The following functions are the strided versions of those above. The
+// destination planes must be allocated by the caller, and be as large as
+// the source, or transposed for 90 and 270 degree rotations.
+// Return value: 0 if OK, < 0 otherwise.
+int CopyI420(const I420Planes& src_planes, const I420Planes& dst_planes);
+
+// dst_stride is in bytes; 0 means packed rows.
+int ConvertFromI420(VideoType dst_video_type,
+                    const I420Planes& src_planes,
+                    uint8_t* dst_frame,
+                    int dst_stride);
+
+// Rotation is supported for I420, YV12, NV12 and NV21 sources only.
+int ConvertToI420(VideoType src_video_type,
+                  const uint8_t* src_frame,
+                  int src_width,
+                  int src_height,
+                  const I420Planes& dst_planes,
+                  VideoRotationMode rotate);
+
+int I420Rotate(const I420Planes& src_planes,
+               const I420Planes& dst_planes,
+               VideoRotationMode rotation_mode);
+
+int MirrorI420LeftRight(const I420Planes& src_planes,
+                        const I420Planes& dst_planes);
+int MirrorI420UpDown(const I420Planes& src_planes,
+                     const I420Planes& dst_planes);
 }
 
 #endif  // WEBRTC_COMMON_VIDEO_LIBYUV_INCLUDE_LIBYUV_H_
@@ -53,6 +53,15 @@ class Scaler {
             uint8_t*& dst_frame,
             int& dst_size);
 
+  // Scale frame with strided planes
+  // src_planes and dst_planes must have the sizes given to Set(), and
+  // dst_planes must be allocated by the caller.
+  // Return value: 0 - OK,
+  //               -1 - parameter error
+  //               -2 - scaler not set
+  int Scale(const I420Planes& src_planes,
+            const I420Planes& dst_planes);
+
  private:
   // Determine if the VideoTypes are currently supported.
   bool SupportedVideoType(VideoType src_video_type,
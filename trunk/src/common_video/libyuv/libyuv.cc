@@ -11,6 +11,7 @@
 #include "common_video/libyuv/include/libyuv.h"
 
 #include <assert.h>
+#include <stddef.h>  // NULL
 
 // LibYuv includes
 #ifdef WEBRTC_ANDROID
@@ -891,4 +892,253 @@ int ConvertToI420AndRotate180(const uint8_t* src_frame,
                             src_width, src_height,
                             libyuv::kRotate180);
 }
+
+I420Planes::I420Planes()
+    : width(0),
+      height(0) {
+  for (int i = 0; i < kNumOfI420Planes; ++i) {
+    plane[i] = NULL;
+    stride[i] = 0;
+  }
+}
+
+void I420PlanesFromBuffer(uint8_t* buffer, int width, int height,
+                          I420Planes* planes) {
+  const int half_width = (width + 1) >> 1;
+  const int half_height = (height + 1) >> 1;
+  planes->plane[kYPlane] = buffer;
+  planes->plane[kUPlane] = buffer + width * height;
+  planes->plane[kVPlane] = planes->plane[kUPlane] + half_width * half_height;
+  planes->stride[kYPlane] = width;
+  planes->stride[kUPlane] = half_width;
+  planes->stride[kVPlane] = half_width;
+  planes->width = width;
+  planes->height = height;
+}
+
+int CropI420Planes(const I420Planes& src_planes,
+                   int left, int top,
+                   int width, int height,
+                   I420Planes* dst_planes) {
+  if (left < 0 || top < 0 || (left & 1) || (top & 1) ||
+      width < 1 || height < 1 ||
+      left + width > src_planes.width || top + height > src_planes.height)
+    return -1;
+  for (int i = 0; i < kNumOfI420Planes; ++i) {
+    const int x = (i == kYPlane) ? left : left >> 1;
+    const int y = (i == kYPlane) ? top : top >> 1;
+    dst_planes->plane[i] = src_planes.plane[i] + y * src_planes.stride[i] + x;
+    dst_planes->stride[i] = src_planes.stride[i];
+  }
+  dst_planes->width = width;
+  dst_planes->height = height;
+  return 0;
+}
+
+int CopyI420(const I420Planes& src_planes, const I420Planes& dst_planes) {
+  return libyuv::I420Copy(src_planes.plane[kYPlane], src_planes.stride[kYPlane],
+                          src_planes.plane[kUPlane], src_planes.stride[kUPlane],
+                          src_planes.plane[kVPlane], src_planes.stride[kVPlane],
+                          dst_planes.plane[kYPlane], dst_planes.stride[kYPlane],
+                          dst_planes.plane[kUPlane], dst_planes.stride[kUPlane],
+                          dst_planes.plane[kVPlane], dst_planes.stride[kVPlane],
+                          src_planes.width, src_planes.height);
+}
+
+int ConvertFromI420(VideoType dst_video_type,
+                    const I420Planes& src_planes,
+                    uint8_t* dst_frame,
+                    int dst_stride) {
+  const int width = src_planes.width;
+  const int height = src_planes.height;
+  const uint8_t* yplane = src_planes.plane[kYPlane];
+  const uint8_t* uplane = src_planes.plane[kUPlane];
+  const uint8_t* vplane = src_planes.plane[kVPlane];
+  const int ystride = src_planes.stride[kYPlane];
+  const int ustride = src_planes.stride[kUPlane];
+  const int vstride = src_planes.stride[kVPlane];
+  if (dst_stride == 0) {
+    const int bytes_per_pixel =
+        (dst_video_type == kI420 || dst_video_type == kYV12) ? 1 :
+        CalcBufferSize(dst_video_type, 1, 2) / 2;
+    dst_stride = width * bytes_per_pixel;
+  }
+  switch (dst_video_type) {
+    case kRGB24:
+      return libyuv::I420ToRGB24(yplane, ystride, uplane, ustride,
+                                 vplane, vstride, dst_frame, dst_stride,
+                                 width, height);
+    case kARGB:
+      return libyuv::I420ToARGB(yplane, ystride, uplane, ustride,
+                                vplane, vstride, dst_frame, dst_stride,
+                                width, height);
+    case kARGB4444:
+      return libyuv::I420ToARGB4444(yplane, ystride, uplane, ustride,
+                                    vplane, vstride, dst_frame, dst_stride,
+                                    width, height);
+    // These two count their destination stride in pixels.
+    case kARGB1555:
+      return libyuv::I420ToARGB1555(yplane, ystride, uplane, ustride,
+                                    vplane, vstride, dst_frame,
+                                    dst_stride / 2, width, height);
+    case kRGB565:
+      return libyuv::I420ToRGB565(yplane, ystride, uplane, ustride,
+                                  vplane, vstride, dst_frame, dst_stride / 2,
+                                  width, height);
+    case kUYVY:
+      return libyuv::I420ToUYVY(yplane, ystride, uplane, ustride,
+                                vplane, vstride, dst_frame, dst_stride,
+                                width, height);
+    case kYUY2:
+      return libyuv::I420ToYUY2(yplane, ystride, uplane, ustride,
+                                vplane, vstride, dst_frame, dst_stride,
+                                width, height);
+    case kI420:
+    case kYV12: {
+      // Packed chroma rows of half the luma stride. YV12 is YVU.
+      const int half_stride = (dst_stride + 1) >> 1;
+      uint8_t* dst_uplane = dst_frame + dst_stride * height;
+      uint8_t* dst_vplane = dst_uplane + half_stride * ((height + 1) >> 1);
+      if (dst_video_type == kYV12) {
+        uint8_t* tmp = dst_uplane;
+        dst_uplane = dst_vplane;
+        dst_vplane = tmp;
+      }
+      return libyuv::I420Copy(yplane, ystride, uplane, ustride,
+                              vplane, vstride,
+                              dst_frame, dst_stride,
+                              dst_uplane, half_stride,
+                              dst_vplane, half_stride,
+                              width, height);
+    }
+    case kRGBAMac:
+      return libyuv::I420ToBGRA(yplane, ystride, vplane, vstride,
+                                uplane, ustride, dst_frame, dst_stride,
+                                width, height);
+    case kARGBMac:
+      return libyuv::I420ToARGB(yplane, ystride, vplane, vstride,
+                                uplane, ustride, dst_frame, dst_stride,
+                                width, height);
+    default:
+      return -1;
+  }
+}
+
+int ConvertToI420(VideoType src_video_type,
+                  const uint8_t* src_frame,
+                  int src_width,
+                  int src_height,
+                  const I420Planes& dst_planes,
+                  VideoRotationMode rotate) {
+  uint8_t* yplane = dst_planes.plane[kYPlane];
+  uint8_t* uplane = dst_planes.plane[kUPlane];
+  uint8_t* vplane = dst_planes.plane[kVPlane];
+  const int ystride = dst_planes.stride[kYPlane];
+  const int ustride = dst_planes.stride[kUPlane];
+  const int vstride = dst_planes.stride[kVPlane];
+  const int half_width = (src_width + 1) >> 1;
+  const int half_height = (src_height + 1) >> 1;
+  const libyuv::RotationMode mode = static_cast<libyuv::RotationMode>(rotate);
+  switch (src_video_type) {
+    case kI420:
+    case kYV12: {
+      const uint8_t* src_uplane = src_frame + src_width * src_height;
+      const uint8_t* src_vplane = src_uplane + half_width * half_height;
+      if (src_video_type == kYV12) {
+        const uint8_t* tmp = src_uplane;
+        src_uplane = src_vplane;
+        src_vplane = tmp;
+      }
+      return libyuv::I420Rotate(src_frame, src_width,
+                                src_uplane, half_width,
+                                src_vplane, half_width,
+                                yplane, ystride, uplane, ustride,
+                                vplane, vstride,
+                                src_width, src_height, mode);
+    }
+    case kNV12:
+      return libyuv::NV12ToI420Rotate(src_frame, src_width,
+                                      src_frame + src_width * src_height,
+                                      src_width,
+                                      yplane, ystride, uplane, ustride,
+                                      vplane, vstride,
+                                      src_width, src_height, mode);
+    case kNV21:
+      // NV21 is NV12 with V before U.
+      return libyuv::NV12ToI420Rotate(src_frame, src_width,
+                                      src_frame + src_width * src_height,
+                                      src_width,
+                                      yplane, ystride, vplane, vstride,
+                                      uplane, ustride,
+                                      src_width, src_height, mode);
+    default:
+      break;
+  }
+  if (rotate != kRotateNone)
+    return -1;
+  switch (src_video_type) {
+    case kRGB24:
+      // WebRtc expects a vertically flipped image.
+      return libyuv::RGB24ToI420(src_frame, src_width * 3,
+                                 yplane, ystride, uplane, ustride,
+                                 vplane, vstride,
+                                 src_width, -src_height);
+    case kARGB:
+      return libyuv::BGRAToI420(src_frame, src_width * 4,
+                                yplane, ystride, uplane, ustride,
+                                vplane, vstride,
+                                src_width, src_height);
+    case kYUY2:
+      return libyuv::YUY2ToI420(src_frame, 2 * src_width,
+                                yplane, ystride, uplane, ustride,
+                                vplane, vstride,
+                                src_width, src_height);
+    case kUYVY:
+      return libyuv::UYVYToI420(src_frame, 2 * src_width,
+                                yplane, ystride, uplane, ustride,
+                                vplane, vstride,
+                                src_width, src_height);
+    default:
+      return -1;
+  }
+}
+
+int I420Rotate(const I420Planes& src_planes,
+               const I420Planes& dst_planes,
+               VideoRotationMode rotation_mode) {
+  return libyuv::I420Rotate(
+      src_planes.plane[kYPlane], src_planes.stride[kYPlane],
+      src_planes.plane[kUPlane], src_planes.stride[kUPlane],
+      src_planes.plane[kVPlane], src_planes.stride[kVPlane],
+      dst_planes.plane[kYPlane], dst_planes.stride[kYPlane],
+      dst_planes.plane[kUPlane], dst_planes.stride[kUPlane],
+      dst_planes.plane[kVPlane], dst_planes.stride[kVPlane],
+      src_planes.width, src_planes.height,
+      static_cast<libyuv::RotationMode>(rotation_mode));
+}
+
+int MirrorI420LeftRight(const I420Planes& src_planes,
+                        const I420Planes& dst_planes) {
+  return libyuv::I420Mirror(
+      src_planes.plane[kYPlane], src_planes.stride[kYPlane],
+      src_planes.plane[kUPlane], src_planes.stride[kUPlane],
+      src_planes.plane[kVPlane], src_planes.stride[kVPlane],
+      dst_planes.plane[kYPlane], dst_planes.stride[kYPlane],
+      dst_planes.plane[kUPlane], dst_planes.stride[kUPlane],
+      dst_planes.plane[kVPlane], dst_planes.stride[kVPlane],
+      src_planes.width, src_planes.height);
+}
+
+int MirrorI420UpDown(const I420Planes& src_planes,
+                     const I420Planes& dst_planes) {
+  // Inserting negative height flips the frame.
+  return libyuv::I420Copy(
+      src_planes.plane[kYPlane], src_planes.stride[kYPlane],
+      src_planes.plane[kUPlane], src_planes.stride[kUPlane],
+      src_planes.plane[kVPlane], src_planes.stride[kVPlane],
+      dst_planes.plane[kYPlane], dst_planes.stride[kYPlane],
+      dst_planes.plane[kUPlane], dst_planes.stride[kUPlane],
+      dst_planes.plane[kVPlane], dst_planes.stride[kVPlane],
+      src_planes.width, -src_planes.height);
+}
 }  // namespace webrtc
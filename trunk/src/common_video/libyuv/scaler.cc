@@ -70,21 +70,37 @@ int Scaler::Scale(const uint8_t* src_frame,
   }
 
   // Converting to planes:
-  const uint8_t* src_yplane = src_frame;
-  const uint8_t* src_uplane = src_frame + src_width_ * src_height_;
-  const uint8_t* src_vplane = src_uplane + src_width_ * src_height_ / 4;
+  I420Planes src_planes;
+  I420Planes dst_planes;
+  I420PlanesFromBuffer(const_cast<uint8_t*>(src_frame), src_width_,
+                       src_height_, &src_planes);
+  I420PlanesFromBuffer(dst_frame, dst_width_, dst_height_, &dst_planes);
+  return Scale(src_planes, dst_planes);
+}
 
-  uint8_t* dst_yplane = dst_frame;
-  uint8_t* dst_uplane = dst_frame + dst_width_ * dst_height_;
-  uint8_t* dst_vplane = dst_uplane + dst_width_ * dst_height_ / 4;
+int Scaler::Scale(const I420Planes& src_planes,
+                  const I420Planes& dst_planes) {
+  if (src_planes.plane[kYPlane] == NULL || dst_planes.plane[kYPlane] == NULL)
+    return -1;
+  if (!set_)
+    return -2;
+  if (src_planes.width != src_width_ || src_planes.height != src_height_ ||
+      dst_planes.width != dst_width_ || dst_planes.height != dst_height_)
+    return -1;
 
-  return libyuv::I420Scale(src_yplane, src_width_,
-                           src_uplane, src_width_ / 2,
-                           src_vplane, src_width_ / 2,
+  return libyuv::I420Scale(src_planes.plane[kYPlane],
+                           src_planes.stride[kYPlane],
+                           src_planes.plane[kUPlane],
+                           src_planes.stride[kUPlane],
+                           src_planes.plane[kVPlane],
+                           src_planes.stride[kVPlane],
                            src_width_, src_height_,
-                           dst_yplane, dst_width_,
-                           dst_uplane, dst_width_ / 2,
-                           dst_vplane, dst_width_ / 2,
+                           dst_planes.plane[kYPlane],
+                           dst_planes.stride[kYPlane],
+                           dst_planes.plane[kUPlane],
+                           dst_planes.stride[kUPlane],
+                           dst_planes.plane[kVPlane],
+                           dst_planes.stride[kVPlane],
                            dst_width_, dst_height_,
                            libyuv::FilterMode(method_));
 }
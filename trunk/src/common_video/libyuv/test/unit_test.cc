@@ -337,6 +337,128 @@ TEST_F(LibYuvTest, MirrorTest) {
   delete [] test_frame2;
 }
 
+// Allocates a width x height I420 image whose rows start at 16 byte
+// aligned offsets, with padding at the end of each row.
+static uint8_t* CreateAlignedPlanes(int width, int height,
+                                    I420Planes* planes) {
+  const int half_width = (width + 1) / 2;
+  const int half_height = (height + 1) / 2;
+  planes->stride[kYPlane] = (width + 15) & ~15;
+  planes->stride[kUPlane] = (half_width + 15) & ~15;
+  planes->stride[kVPlane] = planes->stride[kUPlane];
+  const int y_size = planes->stride[kYPlane] * height;
+  const int uv_size = planes->stride[kUPlane] * half_height;
+  uint8_t* buffer = new uint8_t[y_size + 2 * uv_size];
+  memset(buffer, 0x55, y_size + 2 * uv_size);
+  planes->plane[kYPlane] = buffer;
+  planes->plane[kUPlane] = buffer + y_size;
+  planes->plane[kVPlane] = buffer + y_size + uv_size;
+  planes->width = width;
+  planes->height = height;
+  return buffer;
+}
+
+TEST(LibYuvPlanesTest, StridedMatchesPacked) {
+  const int width = 90;
+  const int height = 60;
+  const int length = CalcBufferSize(kI420, width, height);
+  uint8_t* packed = new uint8_t[length];
+  for (int i = 0; i < length; ++i) {
+    packed[i] = static_cast<uint8_t>((i * 7) ^ (i >> 5));
+  }
+  I420Planes packed_planes;
+  I420PlanesFromBuffer(packed, width, height, &packed_planes);
+  I420Planes aligned_planes;
+  uint8_t* aligned = CreateAlignedPlanes(width, height, &aligned_planes);
+  EXPECT_EQ(0, CopyI420(packed_planes, aligned_planes));
+
+  // Back to a packed buffer.
+  uint8_t* out = new uint8_t[width * height * 4];
+  EXPECT_EQ(0, ConvertFromI420(kI420, aligned_planes, out, 0));
+  EXPECT_EQ(0, memcmp(packed, out, length));
+
+  // Conversions read the same pixels as from the packed buffer.
+  uint8_t* ref = new uint8_t[width * height * 4];
+  EXPECT_EQ(0, ConvertI420ToARGB(packed, ref, width, height, 0));
+  EXPECT_EQ(0, ConvertFromI420(kARGB, aligned_planes, out, 0));
+  EXPECT_EQ(0, memcmp(ref, out, width * height * 4));
+  EXPECT_EQ(0, ConvertI420ToYUY2(packed, ref, width, height, 0));
+  EXPECT_EQ(0, ConvertFromI420(kYUY2, aligned_planes, out, 0));
+  EXPECT_EQ(0, memcmp(ref, out, width * height * 2));
+
+  // And write the same pixels.
+  I420Planes converted_planes;
+  uint8_t* converted = CreateAlignedPlanes(width, height, &converted_planes);
+  EXPECT_EQ(0, ConvertToI420(kYUY2, ref, width, height, converted_planes,
+                             kRotateNone));
+  EXPECT_EQ(0, ConvertToI420(kYUY2, ref, width, height, out, false,
+                             kRotateNone));
+  EXPECT_EQ(0, ConvertFromI420(kI420, converted_planes, ref, 0));
+  EXPECT_EQ(0, memcmp(ref, out, length));
+
+  // Mirroring twice restores the image.
+  EXPECT_EQ(0, MirrorI420LeftRight(aligned_planes, converted_planes));
+  EXPECT_EQ(0, MirrorI420LeftRight(converted_planes, aligned_planes));
+  EXPECT_EQ(0, ConvertFromI420(kI420, aligned_planes, out, 0));
+  EXPECT_EQ(0, memcmp(packed, out, length));
+
+  // Scaling.
+  Scaler scaler;
+  EXPECT_EQ(0, scaler.Set(width, height, width / 2, height / 2, kI420, kI420,
+                          kScaleBox));
+  uint8_t* scaled = NULL;
+  int scaled_size = 0;
+  EXPECT_EQ(0, scaler.Scale(packed, scaled, scaled_size));
+  I420Planes scaled_planes;
+  uint8_t* aligned_scaled = CreateAlignedPlanes(width / 2, height / 2,
+                                                &scaled_planes);
+  EXPECT_EQ(-1, scaler.Scale(aligned_planes, aligned_planes));
+  EXPECT_EQ(0, scaler.Scale(aligned_planes, scaled_planes));
+  EXPECT_EQ(0, ConvertFromI420(kI420, scaled_planes, out, 0));
+  EXPECT_EQ(0, memcmp(scaled, out, scaled_size));
+
+  delete [] scaled;
+  delete [] aligned_scaled;
+  delete [] converted;
+  delete [] aligned;
+  delete [] ref;
+  delete [] out;
+  delete [] packed;
+}
+
+TEST(LibYuvPlanesTest, Crop) {
+  const int width = 64;
+  const int height = 48;
+  I420Planes planes;
+  uint8_t* buffer = CreateAlignedPlanes(width, height, &planes);
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      planes.plane[kYPlane][y * planes.stride[kYPlane] + x] =
+          static_cast<uint8_t>(x + y);
+    }
+  }
+
+  I420Planes crop;
+  EXPECT_EQ(-1, CropI420Planes(planes, 1, 0, 16, 16, &crop));
+  EXPECT_EQ(-1, CropI420Planes(planes, 0, 0, width + 2, 16, &crop));
+  EXPECT_EQ(0, CropI420Planes(planes, 8, 6, 32, 20, &crop));
+  EXPECT_EQ(32, crop.width);
+  EXPECT_EQ(20, crop.height);
+  EXPECT_EQ(planes.stride[kYPlane], crop.stride[kYPlane]);
+  EXPECT_EQ(8 + 6, crop.plane[kYPlane][0]);
+  EXPECT_EQ(planes.plane[kUPlane] + 3 * planes.stride[kUPlane] + 4,
+            crop.plane[kUPlane]);
+
+  // A crop can be copied out like any other image.
+  uint8_t* out = new uint8_t[CalcBufferSize(kI420, 32, 20)];
+  EXPECT_EQ(0, ConvertFromI420(kI420, crop, out, 0));
+  EXPECT_EQ(8 + 6 + 31, out[31]);
+  EXPECT_EQ(8 + 7, out[32]);
+
+  delete [] out;
+  delete [] buffer;
+}
+
 // TODO (mikhal): Move part to a separate scale test.
 void ScaleSequence(ScaleMethod method,
                    FILE* source_file, std::string out_name,
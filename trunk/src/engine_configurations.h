@@ -87,6 +87,7 @@
 
 #define WEBRTC_VIDEO_ENGINE_CAPTURE_API
 #define WEBRTC_VIDEO_ENGINE_CODEC_API
+#define WEBRTC_VIDEO_ENGINE_COMPOSITOR_API
 #define WEBRTC_VIDEO_ENGINE_ENCRYPTION_API
 #define WEBRTC_VIDEO_ENGINE_FILE_API
 #define WEBRTC_VIDEO_ENGINE_IMAGE_PROCESS_API
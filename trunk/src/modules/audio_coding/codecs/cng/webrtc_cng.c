@@ -237,6 +237,9 @@ WebRtc_Word16 WebRtcCng_InitEnc(CNG_enc_inst *cng_inst,
     
     memset(inst, 0, sizeof(WebRtcCngEncInst_t));
 
+    /* Use the fastest SPL functions for the CPU */
+    WebRtcSpl_Init();
+
      /* Check LPC order */
 
     if (quality>WEBRTC_CNG_MAX_LPC_ORDER) {
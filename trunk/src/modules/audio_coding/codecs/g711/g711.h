@@ -374,6 +374,56 @@ WebRtc_UWord8 alaw_to_ulaw(WebRtc_UWord8 alaw);
 */
 WebRtc_UWord8 ulaw_to_alaw(WebRtc_UWord8 ulaw);
 
+/*! \brief Decode a block of A-law samples, using a table lookup per sample.
+    \param alaw The A-law samples to decode.
+    \param len The number of samples.
+    \param linear The decoded samples.
+*/
+void alaw_to_linear_block(const WebRtc_UWord8 *alaw, int len,
+                          WebRtc_Word16 *linear);
+
+/*! \brief Decode a block of u-law samples, using a table lookup per sample.
+    \param ulaw The u-law samples to decode.
+    \param len The number of samples.
+    \param linear The decoded samples.
+*/
+void ulaw_to_linear_block(const WebRtc_UWord8 *ulaw, int len,
+                          WebRtc_Word16 *linear);
+
+/*! \brief Encode a block of linear samples to A-law. Gives the same result as
+           linear_to_alaw(), using a table lookup per sample.
+    \param linear The samples to encode.
+    \param len The number of samples.
+    \param alaw The A-law values.
+*/
+void linear_to_alaw_block(const WebRtc_Word16 *linear, int len,
+                          WebRtc_UWord8 *alaw);
+
+/*! \brief Encode a block of linear samples to u-law. Gives the same result as
+           linear_to_ulaw(), using a table lookup per sample.
+    \param linear The samples to encode.
+    \param len The number of samples.
+    \param ulaw The u-law values.
+*/
+void linear_to_ulaw_block(const WebRtc_Word16 *linear, int len,
+                          WebRtc_UWord8 *ulaw);
+
+/*! \brief Transcode a block from A-law to u-law, as alaw_to_ulaw().
+    \param alaw The A-law samples to transcode.
+    \param len The number of samples.
+    \param ulaw The u-law values.
+*/
+void alaw_to_ulaw_block(const WebRtc_UWord8 *alaw, int len,
+                        WebRtc_UWord8 *ulaw);
+
+/*! \brief Transcode a block from u-law to A-law, as ulaw_to_alaw().
+    \param ulaw The u-law samples to transcode.
+    \param len The number of samples.
+    \param alaw The A-law values.
+*/
+void ulaw_to_alaw_block(const WebRtc_UWord8 *ulaw, int len,
+                        WebRtc_UWord8 *alaw);
+
 #ifdef __cplusplus
 }
 #endif
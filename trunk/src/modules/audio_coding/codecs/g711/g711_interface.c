@@ -12,14 +12,15 @@
 #include "g711_interface.h"
 #include "typedefs.h"
 
+// The encoded data holds one byte per sample in memory order, i.e. the first
+// sample is in the low byte of encoded[0] on little-endian platforms and in
+// the high byte on big-endian ones.
+
 WebRtc_Word16 WebRtcG711_EncodeA(void *state,
                                  WebRtc_Word16 *speechIn,
                                  WebRtc_Word16 len,
                                  WebRtc_Word16 *encoded)
 {
-    int n;
-    WebRtc_UWord16 tempVal,  tempVal2;
-
     // Set and discard to avoid getting warnings
     (void)(state = NULL);
 
@@ -28,26 +29,7 @@ WebRtc_Word16 WebRtcG711_EncodeA(void *state,
         return (-1);
     }
 
-    // Loop over all samples
-    for (n = 0; n < len; n++) {
-        tempVal = (WebRtc_UWord16)linear_to_alaw(speechIn[n]);
-
-#ifdef WEBRTC_BIG_ENDIAN
-        if ((n & 0x1) == 1) {
-            encoded[n>>1]|=((WebRtc_UWord16)tempVal);
-        } else {
-            encoded[n>>1]=((WebRtc_UWord16)tempVal)<<8;
-        }
-#else
-        if ((n & 0x1) == 1) {
-            tempVal2 |= ((WebRtc_UWord16) tempVal) << 8;
-            encoded[n >> 1] |= ((WebRtc_UWord16) tempVal) << 8;
-        } else {
-            tempVal2 = ((WebRtc_UWord16) tempVal);
-            encoded[n >> 1] = ((WebRtc_UWord16) tempVal);
-        }
-#endif
-    }
+    linear_to_alaw_block(speechIn, len, (WebRtc_UWord8*) encoded);
     return (len);
 }
 
@@ -56,9 +38,6 @@ WebRtc_Word16 WebRtcG711_EncodeU(void  *state,
                                  WebRtc_Word16 len,
                                  WebRtc_Word16 *encoded)
 {
-    int n;
-    WebRtc_UWord16 tempVal;
-
     // Set and discard to avoid getting warnings
     (void)(state = NULL);
 
@@ -67,24 +46,7 @@ WebRtc_Word16 WebRtcG711_EncodeU(void  *state,
         return (-1);
     }
 
-    // Loop over all samples
-    for (n = 0; n < len; n++) {
-        tempVal = (WebRtc_UWord16)linear_to_ulaw(speechIn[n]);
-
- #ifdef WEBRTC_BIG_ENDIAN
-        if ((n & 0x1) == 1) {
-            encoded[n>>1]|=((WebRtc_UWord16)tempVal);
-        } else {
-            encoded[n>>1]=((WebRtc_UWord16)tempVal)<<8;
-        }
- #else
-        if ((n & 0x1) == 1) {
-            encoded[n >> 1] |= ((WebRtc_UWord16) tempVal) << 8;
-        } else {
-            encoded[n >> 1] = ((WebRtc_UWord16) tempVal);
-        }
- #endif
-    }
+    linear_to_ulaw_block(speechIn, len, (WebRtc_UWord8*) encoded);
     return (len);
 }
 
@@ -94,9 +56,6 @@ WebRtc_Word16 WebRtcG711_DecodeA(void *state,
                                  WebRtc_Word16 *decoded,
                                  WebRtc_Word16 *speechType)
 {
-    int n;
-    WebRtc_UWord16 tempVal;
-
     // Set and discard to avoid getting warnings
     (void)(state = NULL);
 
@@ -105,22 +64,7 @@ WebRtc_Word16 WebRtcG711_DecodeA(void *state,
         return (-1);
     }
 
-    for (n = 0; n < len; n++) {
- #ifdef WEBRTC_BIG_ENDIAN
-        if ((n & 0x1) == 1) {
-            tempVal=((WebRtc_UWord16)encoded[n>>1] & 0xFF);
-        } else {
-            tempVal=((WebRtc_UWord16)encoded[n>>1] >> 8);
-        }
- #else
-        if ((n & 0x1) == 1) {
-            tempVal = (encoded[n >> 1] >> 8);
-        } else {
-            tempVal = (encoded[n >> 1] & 0xFF);
-        }
- #endif
-        decoded[n] = (WebRtc_Word16) alaw_to_linear(tempVal);
-    }
+    alaw_to_linear_block((const WebRtc_UWord8*) encoded, len, decoded);
 
     *speechType = 1;
     return (len);
@@ -132,9 +76,6 @@ WebRtc_Word16 WebRtcG711_DecodeU(void *state,
                                  WebRtc_Word16 *decoded,
                                  WebRtc_Word16 *speechType)
 {
-    int n;
-    WebRtc_UWord16 tempVal;
-
     // Set and discard to avoid getting warnings
     (void)(state = NULL);
 
@@ -143,27 +84,38 @@ WebRtc_Word16 WebRtcG711_DecodeU(void *state,
         return (-1);
     }
 
-    for (n = 0; n < len; n++) {
- #ifdef WEBRTC_BIG_ENDIAN
-        if ((n & 0x1) == 1) {
-            tempVal=((WebRtc_UWord16)encoded[n>>1] & 0xFF);
-        } else {
-            tempVal=((WebRtc_UWord16)encoded[n>>1] >> 8);
-        }
- #else
-        if ((n & 0x1) == 1) {
-            tempVal = (encoded[n >> 1] >> 8);
-        } else {
-            tempVal = (encoded[n >> 1] & 0xFF);
-        }
- #endif
-        decoded[n] = (WebRtc_Word16) ulaw_to_linear(tempVal);
-    }
+    ulaw_to_linear_block((const WebRtc_UWord8*) encoded, len, decoded);
 
     *speechType = 1;
     return (len);
 }
 
+WebRtc_Word16 WebRtcG711_TranscodeAToU(const WebRtc_UWord8 *alaw,
+                                       WebRtc_Word16 len,
+                                       WebRtc_UWord8 *ulaw)
+{
+    // Sanity check of input length
+    if (len < 0) {
+        return (-1);
+    }
+
+    alaw_to_ulaw_block(alaw, len, ulaw);
+    return (len);
+}
+
+WebRtc_Word16 WebRtcG711_TranscodeUToA(const WebRtc_UWord8 *ulaw,
+                                       WebRtc_Word16 len,
+                                       WebRtc_UWord8 *alaw)
+{
+    // Sanity check of input length
+    if (len < 0) {
+        return (-1);
+    }
+
+    ulaw_to_alaw_block(ulaw, len, alaw);
+    return (len);
+}
+
 WebRtc_Word16 WebRtcG711_Version(char* version, WebRtc_Word16 lenBytes)
 {
     strncpy(version, "2.0.0", lenBytes);
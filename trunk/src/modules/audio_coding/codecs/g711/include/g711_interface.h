@@ -123,6 +123,48 @@ WebRtc_Word16 WebRtcG711_DecodeU(void *state,
                                  WebRtc_Word16 *decoded,
                                  WebRtc_Word16 *speechType);
 
+/****************************************************************************
+ * WebRtcG711_TranscodeAToU(...)
+ *
+ * This function converts an A-law frame to u-law directly, as specified in
+ * G.711, without decoding it. Input and output are one byte per sample.
+ *
+ * Input:
+ *      - alaw               : A-law encoded data
+ *      - len                : Bytes in alaw vector
+ *
+ * Output:
+ *      - ulaw               : u-law encoded data, can be the same as alaw
+ *
+ * Return value              : >=0 - Length (in bytes) of ulaw
+ *                             -1 - Error
+ */
+
+WebRtc_Word16 WebRtcG711_TranscodeAToU(const WebRtc_UWord8 *alaw,
+                                       WebRtc_Word16 len,
+                                       WebRtc_UWord8 *ulaw);
+
+/****************************************************************************
+ * WebRtcG711_TranscodeUToA(...)
+ *
+ * This function converts a u-law frame to A-law directly, as specified in
+ * G.711, without decoding it. Input and output are one byte per sample.
+ *
+ * Input:
+ *      - ulaw               : u-law encoded data
+ *      - len                : Bytes in ulaw vector
+ *
+ * Output:
+ *      - alaw               : A-law encoded data, can be the same as ulaw
+ *
+ * Return value              : >=0 - Length (in bytes) of alaw
+ *                             -1 - Error
+ */
+
+WebRtc_Word16 WebRtcG711_TranscodeUToA(const WebRtc_UWord8 *ulaw,
+                                       WebRtc_Word16 len,
+                                       WebRtc_UWord8 *alaw);
+
 /**********************************************************************
 * WebRtcG711_Version(...)
 *
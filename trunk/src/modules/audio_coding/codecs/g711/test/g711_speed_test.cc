@@ -0,0 +1,194 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/*
+ * g711_speed_test.cc : Measures the throughput of the G.711 routines, per
+ * sample as in g711.h and in blocks as used by g711_interface.c, and of
+ * transcoding between A-law and u-law, through linear or directly.
+ *
+ * Usage: g711_speed_test [seconds per measurement]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "g711.h"
+#include "g711_interface.h"
+#include "tick_util.h"
+
+using webrtc::TickTime;
+
+namespace
+{
+
+// 20 ms packets at 8 kHz.
+const int kFrameLength = 160;
+const int kNumFrames = 1000;
+const int kNumSamples = kFrameLength * kNumFrames;
+
+WebRtc_Word16 speech[kNumSamples];
+WebRtc_Word16 decoded[kNumSamples];
+WebRtc_UWord8 alaw[kNumSamples];
+WebRtc_UWord8 ulaw[kNumSamples];
+
+void EncodeAPerSample()
+{
+    for (int n = 0; n < kNumSamples; n++)
+    {
+        alaw[n] = linear_to_alaw(speech[n]);
+    }
+}
+
+void EncodeUPerSample()
+{
+    for (int n = 0; n < kNumSamples; n++)
+    {
+        ulaw[n] = linear_to_ulaw(speech[n]);
+    }
+}
+
+void DecodeAPerSample()
+{
+    for (int n = 0; n < kNumSamples; n++)
+    {
+        decoded[n] = alaw_to_linear(alaw[n]);
+    }
+}
+
+void DecodeUPerSample()
+{
+    for (int n = 0; n < kNumSamples; n++)
+    {
+        decoded[n] = ulaw_to_linear(ulaw[n]);
+    }
+}
+
+void EncodeABlock()
+{
+    for (int i = 0; i < kNumSamples; i += kFrameLength)
+    {
+        WebRtcG711_EncodeA(NULL, &speech[i], kFrameLength,
+                           reinterpret_cast<WebRtc_Word16*>(&alaw[i]));
+    }
+}
+
+void EncodeUBlock()
+{
+    for (int i = 0; i < kNumSamples; i += kFrameLength)
+    {
+        WebRtcG711_EncodeU(NULL, &speech[i], kFrameLength,
+                           reinterpret_cast<WebRtc_Word16*>(&ulaw[i]));
+    }
+}
+
+void DecodeABlock()
+{
+    WebRtc_Word16 speechType;
+    for (int i = 0; i < kNumSamples; i += kFrameLength)
+    {
+        WebRtcG711_DecodeA(NULL, reinterpret_cast<WebRtc_Word16*>(&alaw[i]),
+                           kFrameLength, &decoded[i], &speechType);
+    }
+}
+
+void DecodeUBlock()
+{
+    WebRtc_Word16 speechType;
+    for (int i = 0; i < kNumSamples; i += kFrameLength)
+    {
+        WebRtcG711_DecodeU(NULL, reinterpret_cast<WebRtc_Word16*>(&ulaw[i]),
+                           kFrameLength, &decoded[i], &speechType);
+    }
+}
+
+void TranscodeAToUThroughLinear()
+{
+    WebRtc_Word16 speechType;
+    for (int i = 0; i < kNumSamples; i += kFrameLength)
+    {
+        WebRtcG711_DecodeA(NULL, reinterpret_cast<WebRtc_Word16*>(&alaw[i]),
+                           kFrameLength, &decoded[i], &speechType);
+        WebRtcG711_EncodeU(NULL, &decoded[i], kFrameLength,
+                           reinterpret_cast<WebRtc_Word16*>(&ulaw[i]));
+    }
+}
+
+void TranscodeAToUDirect()
+{
+    for (int i = 0; i < kNumSamples; i += kFrameLength)
+    {
+        WebRtcG711_TranscodeAToU(&alaw[i], kFrameLength, &ulaw[i]);
+    }
+}
+
+void TranscodeUToADirect()
+{
+    for (int i = 0; i < kNumSamples; i += kFrameLength)
+    {
+        WebRtcG711_TranscodeUToA(&ulaw[i], kFrameLength, &alaw[i]);
+    }
+}
+
+// Runs |function| for about |seconds| and prints the throughput.
+void Measure(const char* name, void (*function)(), double seconds)
+{
+    const TickTime start = TickTime::Now();
+    WebRtc_Word64 elapsedUs = 0;
+    int runs = 0;
+    do
+    {
+        function();
+        runs++;
+        elapsedUs = (TickTime::Now() - start).Microseconds();
+    } while (elapsedUs < seconds * 1000000);
+
+    const double samplesPerUs =
+        static_cast<double>(runs) * kNumSamples / elapsedUs;
+    // Realtime channels at 8 kHz that one core could handle.
+    printf("%-32s %8.1f Msamples/s %10.0f channels\n", name, samplesPerUs,
+           samplesPerUs * 1000000 / 8000);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    double seconds = 1.0;
+    if (argc > 1)
+    {
+        seconds = atof(argv[1]);
+    }
+
+    // Speech-like levels, with random signs so that branches on the sign
+    // are hard to predict.
+    srand(0);
+    for (int n = 0; n < kNumSamples; n++)
+    {
+        speech[n] = static_cast<WebRtc_Word16>((rand() % 16384) - 8192);
+    }
+    EncodeABlock();
+    EncodeUBlock();
+
+    printf("G.711 throughput, %d samples per call\n\n", kFrameLength);
+    Measure("Encode A-law per sample", EncodeAPerSample, seconds);
+    Measure("Encode A-law block", EncodeABlock, seconds);
+    Measure("Encode u-law per sample", EncodeUPerSample, seconds);
+    Measure("Encode u-law block", EncodeUBlock, seconds);
+    Measure("Decode A-law per sample", DecodeAPerSample, seconds);
+    Measure("Decode A-law block", DecodeABlock, seconds);
+    Measure("Decode u-law per sample", DecodeUPerSample, seconds);
+    Measure("Decode u-law block", DecodeUBlock, seconds);
+    Measure("A-law to u-law through linear", TranscodeAToUThroughLinear,
+            seconds);
+    Measure("A-law to u-law direct", TranscodeAToUDirect, seconds);
+    Measure("u-law to A-law direct", TranscodeUToADirect, seconds);
+
+    return 0;
+}
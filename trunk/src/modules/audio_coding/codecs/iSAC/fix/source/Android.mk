@@ -115,7 +115,8 @@ LOCAL_C_INCLUDES := \
 LOCAL_STATIC_LIBRARIES := \
     libwebrtc_isacfix \
     libwebrtc_isacfix_neon \
-    libwebrtc_spl
+    libwebrtc_spl \
+    libwebrtc_system_wrappers
 
 LOCAL_SHARED_LIBRARIES := \
     libutils
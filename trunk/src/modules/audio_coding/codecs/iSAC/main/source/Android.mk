@@ -32,6 +32,7 @@ LOCAL_SRC_FILES := \
     filterbank_tables.c \
     intialize.c \
     isac.c \
+    isac_sse2.c \
     filterbanks.c \
     pitch_lag_tables.c \
     lattice.c \
@@ -53,7 +54,10 @@ LOCAL_CFLAGS := \
 LOCAL_C_INCLUDES := \
     $(LOCAL_PATH)/../interface \
     $(LOCAL_PATH)/../../../../../.. \
-    $(LOCAL_PATH)/../../../../../../common_audio/signal_processing/include 
+    $(LOCAL_PATH)/../../../../../../common_audio/signal_processing/include \
+    $(LOCAL_PATH)/../../../../../../system_wrappers/interface
+
+LOCAL_STATIC_LIBRARIES += libwebrtc_system_wrappers
 
 LOCAL_SHARED_LIBRARIES := \
     libcutils \
@@ -193,6 +193,12 @@ void WebRtcIsac_InitPitchFilter(PitchFiltstr *pitchfiltdata);
 
 void WebRtcIsac_InitPitchAnalysis(PitchAnalysisStruct *State);
 
+/* Points the dispatched functions below at the fastest versions for this
+ * CPU. Called by WebRtcIsac_Create(). */
+void WebRtcIsac_InitFunctions(void);
+
+void WebRtcIsac_InitSSE2(void);
+
 
 /**************************** transform functions ****************************/
 
@@ -231,9 +237,62 @@ void WebRtcIsac_ZeroPoleFilter(double *In,
                               int     orderCoef,
                               double *Out);
 
+/* r[lag] = sum over n of x[n] * x[n + lag], for lag = 0 .. order. */
+typedef void (*AutoCorr)(double *r,
+                         const double *x,
+                         int N,
+                         int order);
+extern AutoCorr WebRtcIsac_AutoCorr;
+
+void WebRtcIsac_AutoCorrC(double *r,
+                          const double *x,
+                          int N,
+                          int order);
+
+/* corr[k] = sum over n < length of x[n] * y[k + n], for k < numLags. */
+typedef void (*CrossCorr)(double *corr,
+                          const double *x,
+                          const double *y,
+                          int length,
+                          int numLags);
+extern CrossCorr WebRtcIsac_CrossCorr;
+
+void WebRtcIsac_CrossCorrC(double *corr,
+                           const double *x,
+                           const double *y,
+                           int length,
+                           int numLags);
+
 
 /***************************** filterbank functions **************************/
 
+/* All-pass filters two channels, each in place with its own section factors
+ * and states, as two calls of WebRtcIsac_AllPassFilter2Float would. */
+typedef void (*AllPassFilter2FloatPair)(float *InOut1,
+                                        float *InOut2,
+                                        const float *APSectionFactors1,
+                                        const float *APSectionFactors2,
+                                        int lengthInOut,
+                                        int NumberOfSections,
+                                        float *FilterState1,
+                                        float *FilterState2);
+extern AllPassFilter2FloatPair WebRtcIsac_AllPassFilter2FloatPair;
+
+void WebRtcIsac_AllPassFilter2Float(float *InOut,
+                                    const float *APSectionFactors,
+                                    int lengthInOut,
+                                    int NumberOfSections,
+                                    float *FilterState);
+
+void WebRtcIsac_AllPassFilter2FloatPairC(float *InOut1,
+                                         float *InOut2,
+                                         const float *APSectionFactors1,
+                                         const float *APSectionFactors2,
+                                         int lengthInOut,
+                                         int NumberOfSections,
+                                         float *FilterState1,
+                                         float *FilterState2);
+
 void WebRtcIsac_SplitAndFilter(double         *in,
                               double         *LP,
                               double         *HP,
@@ -284,9 +343,4 @@ void WebRtcIsac_Dir2Lat(double *a,
                         float *sth,
                         float *cth);
 
-void WebRtcIsac_AutoCorr(double *r,
-                        const double *x,
-                        int N,
-                        int order);
-
 #endif /* WEBRTC_MODULES_AUDIO_CODING_CODECS_ISAC_MAIN_SOURCE_CODEC_H_ */
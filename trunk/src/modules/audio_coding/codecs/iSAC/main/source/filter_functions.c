@@ -84,7 +84,10 @@ void WebRtcIsac_ZeroPoleFilter(double *In, double *ZeroCoef, double *PoleCoef, i
 }
 
 
-void WebRtcIsac_AutoCorr(
+/* The generic C version until WebRtcIsac_InitFunctions() is called. */
+AutoCorr WebRtcIsac_AutoCorr = WebRtcIsac_AutoCorrC;
+
+void WebRtcIsac_AutoCorrC(
     double *r,
     const double *x,
     int N,
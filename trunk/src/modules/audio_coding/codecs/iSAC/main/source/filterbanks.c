@@ -12,9 +12,10 @@
  * filterbanks.c
  *
  * This file contains function WebRtcIsac_AllPassFilter2Float,
- * WebRtcIsac_SplitAndFilter, and WebRtcIsac_FilterAndCombine
- * which implement filterbanks that produce decimated lowpass and
- * highpass versions of a signal, and performs reconstruction.
+ * WebRtcIsac_AllPassFilter2FloatPairC, WebRtcIsac_SplitAndFilter,
+ * and WebRtcIsac_FilterAndCombine which implement filterbanks that
+ * produce decimated lowpass and highpass versions of a signal, and
+ * performs reconstruction.
  *
  */
 
@@ -26,9 +27,9 @@
  * sections are used to filter the input in a cascade manner.
  * The input is overwritten!!
  */
-static void WebRtcIsac_AllPassFilter2Float(float *InOut, const float *APSectionFactors,
-                                           int lengthInOut, int NumberOfSections,
-                                           float *FilterState)
+void WebRtcIsac_AllPassFilter2Float(float *InOut, const float *APSectionFactors,
+                                    int lengthInOut, int NumberOfSections,
+                                    float *FilterState)
 {
   int n, j;
   float temp;
@@ -41,6 +42,23 @@ static void WebRtcIsac_AllPassFilter2Float(float *InOut, const float *APSectionF
   }
 }
 
+/* The generic C version until WebRtcIsac_InitFunctions() is called. */
+AllPassFilter2FloatPair WebRtcIsac_AllPassFilter2FloatPair =
+    WebRtcIsac_AllPassFilter2FloatPairC;
+
+void WebRtcIsac_AllPassFilter2FloatPairC(float *InOut1, float *InOut2,
+                                         const float *APSectionFactors1,
+                                         const float *APSectionFactors2,
+                                         int lengthInOut, int NumberOfSections,
+                                         float *FilterState1,
+                                         float *FilterState2)
+{
+  WebRtcIsac_AllPassFilter2Float(InOut1, APSectionFactors1, lengthInOut,
+                                 NumberOfSections, FilterState1);
+  WebRtcIsac_AllPassFilter2Float(InOut2, APSectionFactors2, lengthInOut,
+                                 NumberOfSections, FilterState2);
+}
+
 /* HPstcoeff_in = {a1, a2, b1 - b0 * a1, b2 - b0 * a2}; */
 static const float kHpStCoefInFloat[4] =
 {-1.94895953203325f, 0.94984516000000f, -0.05101826139794f, 0.05015484000000f};
@@ -86,9 +104,11 @@ void WebRtcIsac_SplitAndFilterFloat(float *pin, float *LP, float *HP,
 {
   int k,n;
   float CompositeAPFilterState[NUMBEROFCOMPOSITEAPSECTIONS];
+  float CompositeAPFilterState2[NUMBEROFCOMPOSITEAPSECTIONS];
   float ForTransform_CompositeAPFilterState[NUMBEROFCOMPOSITEAPSECTIONS];
   float ForTransform_CompositeAPFilterState2[NUMBEROFCOMPOSITEAPSECTIONS];
   float tempinoutvec[FRAMESAMPLES+MAX_AR_MODEL_ORDER];
+  float tempinoutvec2[FRAMESAMPLES+MAX_AR_MODEL_ORDER];
   float tempin_ch1[FRAMESAMPLES+MAX_AR_MODEL_ORDER];
   float tempin_ch2[FRAMESAMPLES+MAX_AR_MODEL_ORDER];
   float in[FRAMESAMPLES];
@@ -117,39 +137,50 @@ void WebRtcIsac_SplitAndFilterFloat(float *pin, float *LP, float *HP,
     the upper and lower channel all-pass filsters in series) is used for the
     filtering. */
 
-  /* First Channel */
+  /* Both channels are filtered together, the first channel holds the odd
+     samples (upper channel) and the second the even samples (lower channel). */
 
   /*initial state of composite filter is zero */
   for (k=0;k<NUMBEROFCOMPOSITEAPSECTIONS;k++){
     CompositeAPFilterState[k] = 0.0;
+    CompositeAPFilterState2[k] = 0.0;
   }
   /* put every other sample of input into a temporary vector in reverse (backward) order*/
   for (k=0;k<FRAMESAMPLES_HALF;k++) {
     tempinoutvec[k] = in[FRAMESAMPLES-1-2*k];
+    tempinoutvec2[k] = in[FRAMESAMPLES-2-2*k];
   }
 
-  /* now all-pass filter the backwards vector.  Output values overwrite the input vector. */
-  WebRtcIsac_AllPassFilter2Float(tempinoutvec, WebRtcIsac_kCompositeApFactorsFloat,
-                                 FRAMESAMPLES_HALF, NUMBEROFCOMPOSITEAPSECTIONS, CompositeAPFilterState);
+  /* now all-pass filter the backwards vectors.  Output values overwrite the input vectors. */
+  WebRtcIsac_AllPassFilter2FloatPair(tempinoutvec, tempinoutvec2,
+                                     WebRtcIsac_kCompositeApFactorsFloat,
+                                     WebRtcIsac_kCompositeApFactorsFloat,
+                                     FRAMESAMPLES_HALF, NUMBEROFCOMPOSITEAPSECTIONS,
+                                     CompositeAPFilterState, CompositeAPFilterState2);
 
   /* save the backwards filtered output for later forward filtering,
      but write it in forward order*/
   for (k=0;k<FRAMESAMPLES_HALF;k++) {
     tempin_ch1[FRAMESAMPLES_HALF+QLOOKAHEAD-1-k] = tempinoutvec[k];
+    tempin_ch2[FRAMESAMPLES_HALF+QLOOKAHEAD-1-k] = tempinoutvec2[k];
   }
 
   /* save the backwards filter state  becaue it will be transformed
      later into a forward state */
   for (k=0; k<NUMBEROFCOMPOSITEAPSECTIONS; k++) {
     ForTransform_CompositeAPFilterState[k] = CompositeAPFilterState[k];
+    ForTransform_CompositeAPFilterState2[k] = CompositeAPFilterState2[k];
   }
 
-  /* now backwards filter the samples in the lookahead buffer. The samples were
+  /* now backwards filter the samples in the lookahead buffers. The samples were
      placed there in the encoding of the previous frame.  The output samples
      overwrite the input samples */
-  WebRtcIsac_AllPassFilter2Float(prefiltdata->INLABUF1_float,
-                                 WebRtcIsac_kCompositeApFactorsFloat, QLOOKAHEAD,
-                                 NUMBEROFCOMPOSITEAPSECTIONS, CompositeAPFilterState);
+  WebRtcIsac_AllPassFilter2FloatPair(prefiltdata->INLABUF1_float,
+                                     prefiltdata->INLABUF2_float,
+                                     WebRtcIsac_kCompositeApFactorsFloat,
+                                     WebRtcIsac_kCompositeApFactorsFloat,
+                                     QLOOKAHEAD, NUMBEROFCOMPOSITEAPSECTIONS,
+                                     CompositeAPFilterState, CompositeAPFilterState2);
 
   /* save the output, but write it in forward order */
   /* write the lookahead samples for the next encoding iteration. Every other
@@ -158,35 +189,6 @@ void WebRtcIsac_SplitAndFilterFloat(float *pin, float *LP, float *HP,
   for (k=0;k<QLOOKAHEAD;k++) {
     tempin_ch1[QLOOKAHEAD-1-k]=prefiltdata->INLABUF1_float[k];
     prefiltdata->INLABUF1_float[k]=in[FRAMESAMPLES-1-2*k];
-  }
-
-  /* Second Channel.  This is exactly like the first channel, except that the
-     even samples are now filtered instead (lower channel). */
-  for (k=0;k<NUMBEROFCOMPOSITEAPSECTIONS;k++){
-    CompositeAPFilterState[k] = 0.0;
-  }
-
-  for (k=0;k<FRAMESAMPLES_HALF;k++) {
-    tempinoutvec[k] = in[FRAMESAMPLES-2-2*k];
-  }
-
-  WebRtcIsac_AllPassFilter2Float(tempinoutvec, WebRtcIsac_kCompositeApFactorsFloat,
-                                 FRAMESAMPLES_HALF, NUMBEROFCOMPOSITEAPSECTIONS, CompositeAPFilterState);
-
-  for (k=0;k<FRAMESAMPLES_HALF;k++) {
-    tempin_ch2[FRAMESAMPLES_HALF+QLOOKAHEAD-1-k] = tempinoutvec[k];
-  }
-
-  for (k=0; k<NUMBEROFCOMPOSITEAPSECTIONS; k++) {
-    ForTransform_CompositeAPFilterState2[k] = CompositeAPFilterState[k];
-  }
-
-
-  WebRtcIsac_AllPassFilter2Float(prefiltdata->INLABUF2_float,
-                                 WebRtcIsac_kCompositeApFactorsFloat, QLOOKAHEAD,NUMBEROFCOMPOSITEAPSECTIONS,
-                                 CompositeAPFilterState);
-
-  for (k=0;k<QLOOKAHEAD;k++) {
     tempin_ch2[QLOOKAHEAD-1-k]=prefiltdata->INLABUF2_float[k];
     prefiltdata->INLABUF2_float[k]=in[FRAMESAMPLES-2-2*k];
   }
@@ -214,10 +216,12 @@ void WebRtcIsac_SplitAndFilterFloat(float *pin, float *LP, float *HP,
   /* the backward filtered samples are now forward filtered with the corresponding channel filters */
   /* The all pass filtering automatically updates the filter states which are exported in the
      prefiltdata structure */
-  WebRtcIsac_AllPassFilter2Float(tempin_ch1,WebRtcIsac_kUpperApFactorsFloat,
-                                 FRAMESAMPLES_HALF, NUMBEROFCHANNELAPSECTIONS, prefiltdata->INSTAT1_float);
-  WebRtcIsac_AllPassFilter2Float(tempin_ch2,WebRtcIsac_kLowerApFactorsFloat,
-                                 FRAMESAMPLES_HALF, NUMBEROFCHANNELAPSECTIONS, prefiltdata->INSTAT2_float);
+  WebRtcIsac_AllPassFilter2FloatPair(tempin_ch1, tempin_ch2,
+                                     WebRtcIsac_kUpperApFactorsFloat,
+                                     WebRtcIsac_kLowerApFactorsFloat,
+                                     FRAMESAMPLES_HALF, NUMBEROFCHANNELAPSECTIONS,
+                                     prefiltdata->INSTAT1_float,
+                                     prefiltdata->INSTAT2_float);
 
   /* Now Construct low-pass and high-pass signals as combinations of polyphase components */
   for (k=0; k<FRAMESAMPLES_HALF; k++) {
@@ -240,10 +244,12 @@ void WebRtcIsac_SplitAndFilterFloat(float *pin, float *LP, float *HP,
 
   /* the input filter states are passed in and updated by the all-pass filtering routine and
      exported in the prefiltdata structure*/
-  WebRtcIsac_AllPassFilter2Float(tempin_ch1,WebRtcIsac_kUpperApFactorsFloat,
-                                 FRAMESAMPLES_HALF, NUMBEROFCHANNELAPSECTIONS, prefiltdata->INSTATLA1_float);
-  WebRtcIsac_AllPassFilter2Float(tempin_ch2,WebRtcIsac_kLowerApFactorsFloat,
-                                 FRAMESAMPLES_HALF, NUMBEROFCHANNELAPSECTIONS, prefiltdata->INSTATLA2_float);
+  WebRtcIsac_AllPassFilter2FloatPair(tempin_ch1, tempin_ch2,
+                                     WebRtcIsac_kUpperApFactorsFloat,
+                                     WebRtcIsac_kLowerApFactorsFloat,
+                                     FRAMESAMPLES_HALF, NUMBEROFCHANNELAPSECTIONS,
+                                     prefiltdata->INSTATLA1_float,
+                                     prefiltdata->INSTATLA2_float);
 
   for (k=0; k<FRAMESAMPLES_HALF; k++) {
     LP_la[k] = (float)(0.5f*(tempin_ch1[k] + tempin_ch2[k])); /*low pass */
@@ -304,15 +310,16 @@ void WebRtcIsac_FilterAndCombineFloat(float *InLP,
   /* all-pass filter the new upper channel signal. HOWEVER, use the all-pass filter factors
      that were used as a lower channel at the encoding side.  So at the decoder, the
      corresponding all-pass filter factors for each channel are swapped.*/
-  WebRtcIsac_AllPassFilter2Float(tempin_ch1, WebRtcIsac_kLowerApFactorsFloat,
-                                 FRAMESAMPLES_HALF, NUMBEROFCHANNELAPSECTIONS,postfiltdata->STATE_0_UPPER_float);
-
-  /* Now, all-pass filter the new lower channel signal. But since all-pass filter factors
+  /* Likewise, all-pass filter the new lower channel signal. But since all-pass filter factors
      at the decoder are swapped from the ones at the encoder, the 'upper' channel
      all-pass filter factors (WebRtcIsac_kUpperApFactorsFloat) are used to filter this new
      lower channel signal */
-  WebRtcIsac_AllPassFilter2Float(tempin_ch2, WebRtcIsac_kUpperApFactorsFloat,
-                                 FRAMESAMPLES_HALF, NUMBEROFCHANNELAPSECTIONS,postfiltdata->STATE_0_LOWER_float);
+  WebRtcIsac_AllPassFilter2FloatPair(tempin_ch1, tempin_ch2,
+                                     WebRtcIsac_kLowerApFactorsFloat,
+                                     WebRtcIsac_kUpperApFactorsFloat,
+                                     FRAMESAMPLES_HALF, NUMBEROFCHANNELAPSECTIONS,
+                                     postfiltdata->STATE_0_UPPER_float,
+                                     postfiltdata->STATE_0_LOWER_float);
 
 
   /* Merge outputs to form the full length output signal.*/
@@ -23,6 +23,7 @@
 #include "structs.h"
 #include "signal_processing_library.h"
 #include "lpc_shape_swb16_tables.h"
+#include "cpu_features_wrapper.h"
 
 #include <stdio.h>
 #include <string.h>
@@ -230,6 +231,25 @@ static void GetSendBandwidthInfo(
 }
 
 
+/****************************************************************************
+ * WebRtcIsac_InitFunctions()
+ *
+ * Points the function pointers declared in codec.h at the SIMD versions when
+ * they are built in and the CPU supports them. The C versions are used
+ * otherwise. Every selection computes the same results as the C version.
+ */
+void WebRtcIsac_InitFunctions(void)
+{
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kSSE2)) {
+#if defined(WEBRTC_USE_SSE2)
+    WebRtcIsac_InitSSE2();
+#endif
+  }
+#endif
+}
+
+
 /****************************************************************************
  * WebRtcIsac_AssignSize(...)
  *
@@ -274,6 +294,8 @@ WebRtc_Word16 WebRtcIsac_Assign(
       instISAC->errorCode = 0;
       instISAC->initFlag = 0;
 
+      WebRtcIsac_InitFunctions();
+
       // Assign the address
       *ISAC_main_inst = (ISACStruct*)instISAC_Addr;
 
@@ -313,6 +335,8 @@ WebRtc_Word16 WebRtcIsac_Create(
     {
       instISAC->errorCode = 0;
       instISAC->initFlag = 0;
+
+      WebRtcIsac_InitFunctions();
       // Default is wideband
       instISAC->bandwidthKHz           = isac8kHz;
       instISAC->encoderSamplingRateKHz = kIsacWideband;
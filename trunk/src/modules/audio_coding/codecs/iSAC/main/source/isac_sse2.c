@@ -0,0 +1,200 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/*
+ * isac_sse2.c
+ *
+ * This file contains the SSE2 versions of WebRtcIsac_AutoCorr(),
+ * WebRtcIsac_CrossCorr() and WebRtcIsac_AllPassFilter2FloatPair(), and
+ * WebRtcIsac_InitSSE2().
+ *
+ * The vectors run over independent sums or filters, each of which is computed
+ * in the same order as in the C version, so the results are bit-exact.
+ */
+
+#include "typedefs.h"
+
+#if defined(WEBRTC_USE_SSE2)
+#include <emmintrin.h>
+
+#include "codec.h"
+
+/* out[i] = sum over n < length of x[n] * y[n + i], for i < 8, accumulated
+ * in order of increasing n like the C versions. */
+static __inline void CorrelateEightLags(double *out, const double *x,
+                                        const double *y, int length)
+{
+  __m128d sum0 = _mm_setzero_pd();
+  __m128d sum1 = _mm_setzero_pd();
+  __m128d sum2 = _mm_setzero_pd();
+  __m128d sum3 = _mm_setzero_pd();
+  int n;
+
+  for (n = 0; n < length; n++) {
+    const __m128d xn = _mm_load1_pd(&x[n]);
+    const double *yn = &y[n];
+    sum0 = _mm_add_pd(sum0, _mm_mul_pd(xn, _mm_loadu_pd(&yn[0])));
+    sum1 = _mm_add_pd(sum1, _mm_mul_pd(xn, _mm_loadu_pd(&yn[2])));
+    sum2 = _mm_add_pd(sum2, _mm_mul_pd(xn, _mm_loadu_pd(&yn[4])));
+    sum3 = _mm_add_pd(sum3, _mm_mul_pd(xn, _mm_loadu_pd(&yn[6])));
+  }
+  _mm_storeu_pd(&out[0], sum0);
+  _mm_storeu_pd(&out[2], sum1);
+  _mm_storeu_pd(&out[4], sum2);
+  _mm_storeu_pd(&out[6], sum3);
+}
+
+/* As CorrelateEightLags(), for i < 2. */
+static __inline void CorrelateTwoLags(double *out, const double *x,
+                                      const double *y, int length)
+{
+  __m128d sum = _mm_setzero_pd();
+  int n;
+
+  for (n = 0; n < length; n++) {
+    sum = _mm_add_pd(sum, _mm_mul_pd(_mm_load1_pd(&x[n]),
+                                     _mm_loadu_pd(&y[n])));
+  }
+  _mm_storeu_pd(out, sum);
+}
+
+/* The lags of a block share the samples they all reach, and each lag then
+ * adds the rest of its own products in order. */
+static void AutoCorrSSE2(double *r, const double *x, int N, int order)
+{
+  double sum;
+  int lag = 0;
+  int i, n;
+
+  for (; lag + 7 <= order && N - lag - 7 > 0; lag += 8) {
+    CorrelateEightLags(&r[lag], x, &x[lag], N - lag - 7);
+    for (i = 0; i < 7; i++) {
+      for (n = N - lag - 7; n < N - lag - i; n++) {
+        r[lag + i] += x[n] * x[n + lag + i];
+      }
+    }
+  }
+  for (; lag + 1 <= order && N - lag - 1 > 0; lag += 2) {
+    CorrelateTwoLags(&r[lag], x, &x[lag], N - lag - 1);
+    r[lag] += x[N - lag - 1] * x[N - 1];
+  }
+  for (; lag <= order; lag++) {
+    sum = 0.0;
+    for (n = 0; n < N - lag; n++) {
+      sum += x[n] * x[n + lag];
+    }
+    r[lag] = sum;
+  }
+}
+
+static void CrossCorrSSE2(double *corr, const double *x, const double *y,
+                          int length, int numLags)
+{
+  double sum;
+  int k = 0;
+  int n;
+
+  for (; k + 8 <= numLags; k += 8) {
+    CorrelateEightLags(&corr[k], x, &y[k], length);
+  }
+  for (; k + 2 <= numLags; k += 2) {
+    CorrelateTwoLags(&corr[k], x, &y[k], length);
+  }
+  for (; k < numLags; k++) {
+    sum = 0.0;
+    for (n = 0; n < length; n++) {
+      sum += x[n] * y[k + n];
+    }
+    corr[k] = sum;
+  }
+}
+
+/* The four lanes hold sections j and j + 1 of both channels. Section j + 1
+ * runs one sample behind section j, so that at each step it filters the
+ * sample that section j produced at the previous step. The first sample of
+ * section j and the last sample of section j + 1 are filtered on their own. */
+static void AllPassFilter2FloatPairSSE2(float *InOut1, float *InOut2,
+                                        const float *APSectionFactors1,
+                                        const float *APSectionFactors2,
+                                        int lengthInOut, int NumberOfSections,
+                                        float *FilterState1,
+                                        float *FilterState2)
+{
+  float lanes[4];
+  float temp1, temp2;
+  int n, j;
+
+  if (lengthInOut <= 0) {
+    return;
+  }
+
+  for (j = 0; j + 1 < NumberOfSections; j += 2) {
+    const __m128 factors = _mm_setr_ps(APSectionFactors1[j],
+                                       APSectionFactors2[j],
+                                       APSectionFactors1[j + 1],
+                                       APSectionFactors2[j + 1]);
+    const __m128 negFactors = _mm_setr_ps(-APSectionFactors1[j],
+                                          -APSectionFactors2[j],
+                                          -APSectionFactors1[j + 1],
+                                          -APSectionFactors2[j + 1]);
+    __m128 state, temp, in;
+
+    temp1 = FilterState1[j] + APSectionFactors1[j] * InOut1[0];
+    FilterState1[j] = -APSectionFactors1[j] * temp1 + InOut1[0];
+    temp2 = FilterState2[j] + APSectionFactors2[j] * InOut2[0];
+    FilterState2[j] = -APSectionFactors2[j] * temp2 + InOut2[0];
+
+    state = _mm_setr_ps(FilterState1[j], FilterState2[j],
+                        FilterState1[j + 1], FilterState2[j + 1]);
+    temp = _mm_setr_ps(temp1, temp2, 0.0f, 0.0f);
+
+    for (n = 1; n < lengthInOut; n++) {
+      in = _mm_movelh_ps(_mm_unpacklo_ps(_mm_load_ss(&InOut1[n]),
+                                         _mm_load_ss(&InOut2[n])),
+                         temp);
+      temp = _mm_add_ps(state, _mm_mul_ps(factors, in));
+      state = _mm_add_ps(_mm_mul_ps(negFactors, temp), in);
+      _mm_storeu_ps(lanes, temp);
+      InOut1[n - 1] = lanes[2];
+      InOut2[n - 1] = lanes[3];
+    }
+
+    _mm_storeu_ps(lanes, state);
+    FilterState1[j] = lanes[0];
+    FilterState2[j] = lanes[1];
+    FilterState1[j + 1] = lanes[2];
+    FilterState2[j + 1] = lanes[3];
+    _mm_storeu_ps(lanes, temp);
+    temp1 = lanes[0];
+    temp2 = lanes[1];
+
+    n = lengthInOut - 1;
+    InOut1[n] = FilterState1[j + 1] + APSectionFactors1[j + 1] * temp1;
+    FilterState1[j + 1] = -APSectionFactors1[j + 1] * InOut1[n] + temp1;
+    InOut2[n] = FilterState2[j + 1] + APSectionFactors2[j + 1] * temp2;
+    FilterState2[j + 1] = -APSectionFactors2[j + 1] * InOut2[n] + temp2;
+  }
+
+  if (j < NumberOfSections) {
+    WebRtcIsac_AllPassFilter2FloatPairC(InOut1, InOut2,
+                                        &APSectionFactors1[j],
+                                        &APSectionFactors2[j], lengthInOut, 1,
+                                        &FilterState1[j], &FilterState2[j]);
+  }
+}
+
+void WebRtcIsac_InitSSE2(void)
+{
+  WebRtcIsac_AutoCorr = AutoCorrSSE2;
+  WebRtcIsac_CrossCorr = CrossCorrSSE2;
+  WebRtcIsac_AllPassFilter2FloatPair = AllPassFilter2FloatPairSSE2;
+}
+
+#endif  /* WEBRTC_USE_SSE2 */
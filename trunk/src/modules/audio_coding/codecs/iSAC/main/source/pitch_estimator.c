@@ -9,6 +9,7 @@
  */
 
 #include "pitch_estimator.h"
+#include "codec.h"
 
 #include <math.h>
 #include <memory.h>
@@ -87,37 +88,53 @@ __inline static void Intrpol2D(double T[3][3], double *x, double *y, double *pea
 }
 
 
+/* The generic C version until WebRtcIsac_InitFunctions() is called. */
+CrossCorr WebRtcIsac_CrossCorr = WebRtcIsac_CrossCorrC;
+
+void WebRtcIsac_CrossCorrC(double *corr, const double *x, const double *y,
+                           int length, int numLags)
+{
+  double sum, prod;
+  const double *yptr;
+  int k, n;
+
+  for (k = 0; k < numLags; k++) {
+    sum = 0.0;
+    yptr = &y[k];
+    prod = x[0] * yptr[0];
+    for (n = 1; n < length; n++) {
+      sum += prod;
+      prod = x[n] * yptr[n];
+    }
+    sum += prod;
+    corr[k] = sum;
+  }
+}
+
 static void PCorr(const double *in, double *outcorr)
 {
-  double sum, ysum, prod;
-  const double *x, *inptr;
+  double sum[PITCH_LAG_SPAN2];
+  double ysum;
+  const double *x;
   int k, n;
 
+  x = in + PITCH_MAX_LAG/2 + 2;
+  WebRtcIsac_CrossCorr(sum, x, in, PITCH_CORR_LEN2, PITCH_LAG_SPAN2);
+
   //ysum = 1e-6;          /* use this with float (i.s.o. double)! */
   ysum = 1e-13;
-  sum = 0.0;
-  x = in + PITCH_MAX_LAG/2 + 2;
   for (n = 0; n < PITCH_CORR_LEN2; n++) {
     ysum += in[n] * in[n];
-    sum += x[n] * in[n];
   }
 
   outcorr += PITCH_LAG_SPAN2 - 1;     /* index of last element in array */
-  *outcorr = sum / sqrt(ysum);
+  *outcorr = sum[0] / sqrt(ysum);
 
   for (k = 1; k < PITCH_LAG_SPAN2; k++) {
     ysum -= in[k-1] * in[k-1];
     ysum += in[PITCH_CORR_LEN2 + k - 1] * in[PITCH_CORR_LEN2 + k - 1];
-    sum = 0.0;
-    inptr = &in[k];
-    prod = x[0] * inptr[0];
-    for (n = 1; n < PITCH_CORR_LEN2; n++) {
-      sum += prod;
-      prod = x[n] * inptr[n];
-    }
-    sum += prod;
     outcorr--;
-    *outcorr = sum / sqrt(ysum);
+    *outcorr = sum[k] / sqrt(ysum);
   }
 }
 
@@ -0,0 +1,227 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// SimdTest.cc : Checks that the functions selected by
+// WebRtcIsac_InitFunctions() give the same results as the C versions, and
+// that the encoder produces the same bitstream with either of them. Prints
+// the encode time per 30 ms frame for both.
+//
+// Usage: iSACSimdTest <32 kHz input PCM file, e.g. testfile32kHz.pcm>
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <vector>
+
+#include "isac.h"
+#include "tick_util.h"
+extern "C" {
+#include "codec.h"
+}
+
+using webrtc::TickTime;
+
+namespace {
+
+struct Functions {
+  AutoCorr autoCorr;
+  CrossCorr crossCorr;
+  AllPassFilter2FloatPair allPassFilter2FloatPair;
+};
+
+const Functions kFunctionsC = {
+  WebRtcIsac_AutoCorrC,
+  WebRtcIsac_CrossCorrC,
+  WebRtcIsac_AllPassFilter2FloatPairC
+};
+
+void SetFunctions(const Functions& functions) {
+  WebRtcIsac_AutoCorr = functions.autoCorr;
+  WebRtcIsac_CrossCorr = functions.crossCorr;
+  WebRtcIsac_AllPassFilter2FloatPair = functions.allPassFilter2FloatPair;
+}
+
+double RandomSample() {
+  return (rand() % 65536) - 32768;
+}
+
+bool TestAutoCorr(const Functions& functions, int length, int order) {
+  std::vector<double> x(length);
+  double expected[32];
+  double actual[32];
+  for (int n = 0; n < length; n++) {
+    x[n] = RandomSample();
+  }
+  kFunctionsC.autoCorr(expected, &x[0], length, order);
+  functions.autoCorr(actual, &x[0], length, order);
+  if (memcmp(expected, actual, sizeof(double) * (order + 1)) != 0) {
+    printf("AutoCorr differs, length %d, order %d\n", length, order);
+    return false;
+  }
+  return true;
+}
+
+bool TestCrossCorr(const Functions& functions, int length, int numLags) {
+  std::vector<double> x(length);
+  std::vector<double> y(length + numLags);
+  std::vector<double> expected(numLags);
+  std::vector<double> actual(numLags);
+  for (int n = 0; n < length; n++) {
+    x[n] = RandomSample();
+  }
+  for (int n = 0; n < length + numLags; n++) {
+    y[n] = RandomSample();
+  }
+  kFunctionsC.crossCorr(&expected[0], &x[0], &y[0], length, numLags);
+  functions.crossCorr(&actual[0], &x[0], &y[0], length, numLags);
+  if (expected != actual) {
+    printf("CrossCorr differs, length %d, %d lags\n", length, numLags);
+    return false;
+  }
+  return true;
+}
+
+bool TestAllPassFilter2FloatPair(const Functions& functions, int length,
+                                 int sections) {
+  std::vector<float> factors(2 * sections);
+  std::vector<float> expected(2 * (length + sections));
+  for (int j = 0; j < 2 * sections; j++) {
+    factors[j] = static_cast<float>(rand()) / RAND_MAX;
+  }
+  for (size_t n = 0; n < expected.size(); n++) {
+    expected[n] = static_cast<float>(RandomSample());
+  }
+  std::vector<float> actual(expected);
+
+  // Two blocks, to check the states carried from the first to the second.
+  for (int block = 0; block < 2; block++) {
+    std::vector<float>* data[2] = { &expected, &actual };
+    const AllPassFilter2FloatPair filter[2] = {
+      kFunctionsC.allPassFilter2FloatPair,
+      functions.allPassFilter2FloatPair
+    };
+    for (int i = 0; i < 2; i++) {
+      float* inOut1 = &(*data[i])[0];
+      float* inOut2 = &(*data[i])[length];
+      float* states = &(*data[i])[2 * length];
+      filter[i](inOut1, inOut2, &factors[0], &factors[sections], length,
+                sections, &states[0], &states[sections]);
+    }
+  }
+  if (expected != actual) {
+    printf("AllPassFilter2FloatPair differs, length %d, %d sections\n",
+           length, sections);
+    return false;
+  }
+  return true;
+}
+
+// Encodes |speech| and returns the bitstream, and the encode time per frame
+// in |usPerFrame|.
+std::vector<WebRtc_UWord8> Encode(const std::vector<WebRtc_Word16>& speech,
+                                  enum IsacSamplingRate rate,
+                                  const Functions& functions,
+                                  double* usPerFrame) {
+  std::vector<WebRtc_UWord8> bitstream;
+  WebRtc_Word16 payload[600];
+  ISACStruct* inst;
+  const int samplesPer10Ms = rate * 10;
+  int frames = 0;
+
+  WebRtcIsac_Create(&inst);
+  WebRtcIsac_SetEncSampRate(inst, rate);
+  WebRtcIsac_EncoderInit(inst, 1);
+  WebRtcIsac_Control(inst, rate == kIsacWideband ? 32000 : 56000, 30);
+  // WebRtcIsac_Create() selects the functions, set the ones to measure.
+  SetFunctions(functions);
+
+  const TickTime start = TickTime::Now();
+  for (size_t n = 0; n + samplesPer10Ms <= speech.size();
+       n += samplesPer10Ms) {
+    const WebRtc_Word16 bytes = WebRtcIsac_Encode(inst, &speech[n], payload);
+    if (bytes > 0) {
+      const WebRtc_UWord8* data =
+          reinterpret_cast<const WebRtc_UWord8*>(payload);
+      bitstream.insert(bitstream.end(), data, data + bytes);
+      frames++;
+    }
+  }
+  const WebRtc_Word64 elapsedUs = (TickTime::Now() - start).Microseconds();
+
+  WebRtcIsac_Free(inst);
+  *usPerFrame = frames > 0 ? static_cast<double>(elapsedUs) / frames : 0;
+  return bitstream;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc != 2) {
+    printf("Usage: %s <32 kHz input PCM file>\n", argv[0]);
+    return 1;
+  }
+  FILE* inFile = fopen(argv[1], "rb");
+  if (inFile == NULL) {
+    printf("Cannot open %s\n", argv[1]);
+    return 1;
+  }
+  std::vector<WebRtc_Word16> speech;
+  WebRtc_Word16 block[320];
+  size_t read;
+  while ((read = fread(block, sizeof(WebRtc_Word16), 320, inFile)) > 0) {
+    speech.insert(speech.end(), block, block + read);
+  }
+  fclose(inFile);
+
+  WebRtcIsac_InitFunctions();
+  const Functions dispatched = {
+    WebRtcIsac_AutoCorr,
+    WebRtcIsac_CrossCorr,
+    WebRtcIsac_AllPassFilter2FloatPair
+  };
+
+  // Sizes as used by the encoder, and a few odd ones.
+  bool ok = true;
+  srand(0);
+  ok &= TestAutoCorr(dispatched, 256, 13);
+  ok &= TestAutoCorr(dispatched, 256, 6);
+  ok &= TestAutoCorr(dispatched, 256, 5);
+  ok &= TestAutoCorr(dispatched, 240, 6);
+  ok &= TestAutoCorr(dispatched, 9, 8);
+  ok &= TestAutoCorr(dispatched, 31, 0);
+  ok &= TestCrossCorr(dispatched, 60, 65);
+  ok &= TestCrossCorr(dispatched, 7, 3);
+  ok &= TestAllPassFilter2FloatPair(dispatched, 240, 4);
+  ok &= TestAllPassFilter2FloatPair(dispatched, 240, 2);
+  ok &= TestAllPassFilter2FloatPair(dispatched, 24, 3);
+  ok &= TestAllPassFilter2FloatPair(dispatched, 1, 2);
+  printf("Functions: %s\n", ok ? "identical to C" : "DIFFER FROM C");
+
+  const enum IsacSamplingRate rates[2] = {kIsacWideband, kIsacSuperWideband};
+  printf("\n%-24s %12s %12s\n", "Encode time per 30 ms", "C",
+         "InitFunctions");
+  for (int i = 0; i < 2; i++) {
+    double usC, usDispatched;
+    const std::vector<WebRtc_UWord8> bitstreamC =
+        Encode(speech, rates[i], kFunctionsC, &usC);
+    const std::vector<WebRtc_UWord8> bitstreamDispatched =
+        Encode(speech, rates[i], dispatched, &usDispatched);
+    const bool identical = (bitstreamC == bitstreamDispatched);
+    printf("%-24s %9.1f us %9.1f us %6.2fx  bitstreams %s\n",
+           rates[i] == kIsacWideband ? "Wideband" : "Super-wideband", usC,
+           usDispatched, usC / usDispatched,
+           identical ? "identical" : "DIFFER");
+    ok &= identical;
+  }
+
+  return ok ? 0 : 1;
+}
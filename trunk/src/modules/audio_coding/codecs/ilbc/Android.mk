@@ -122,7 +122,8 @@ LOCAL_C_INCLUDES := \
 
 LOCAL_STATIC_LIBRARIES := \
     libwebrtc_ilbc \
-    libwebrtc_spl
+    libwebrtc_spl \
+    libwebrtc_system_wrappers
 
 LOCAL_SHARED_LIBRARIES := \
     libutils
@@ -151,7 +152,8 @@ LOCAL_C_INCLUDES := \
 
 LOCAL_STATIC_LIBRARIES := \
     libwebrtc_ilbc \
-    libwebrtc_spl
+    libwebrtc_spl \
+    libwebrtc_system_wrappers
 
 LOCAL_SHARED_LIBRARIES := \
     libutils
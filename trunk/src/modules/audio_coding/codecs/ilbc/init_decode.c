@@ -31,6 +31,9 @@ WebRtc_Word16 WebRtcIlbcfix_InitDecode(		/* (o) Number of decoded samples */
                                                 ) {
   int i;
 
+  /* Use the fastest SPL functions for the CPU */
+  WebRtcSpl_Init();
+
   iLBCdec_inst->mode = mode;
 
   /* Set all the variables that are dependent on the frame size mode */
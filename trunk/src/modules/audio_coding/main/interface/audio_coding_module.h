@@ -18,6 +18,7 @@
 namespace webrtc {
 
 // forward declarations
+class Clock;
 struct CodecInst;
 
 #define WEBRTC_10MS_PCM_AUDIO 960 // 16 bits super wideband 48 Khz
@@ -74,6 +75,11 @@ class AudioCodingModule: public Module {
   //
   static AudioCodingModule* Create(const WebRtc_Word32 id);
 
+  // Creates a module that stamps received packets with the time of |clock|,
+  // e.g. a SimulatedClock when replaying a recorded session. The clock must
+  // outlive the module.
+  static AudioCodingModule* Create(const WebRtc_Word32 id, Clock* clock);
+
   static void Destroy(AudioCodingModule* module);
 
   ///////////////////////////////////////////////////////////////////////////
@@ -598,6 +604,33 @@ class AudioCodingModule: public Module {
                                         const WebRtc_UWord8 payloadType,
                                         const WebRtc_UWord32 timestamp = 0) = 0;
 
+  ///////////////////////////////////////////////////////////////////////////
+  // WebRtc_Word32 TranscodeG711Packet()
+  // Sends a received PCMU or PCMA payload to the transport callback as the
+  // registered send codec, converting it directly between u-law and A-law
+  // if the two differ, instead of decoding it in NetEQ and encoding it
+  // again. This is meant for gateways relaying a stream which doesn't need
+  // to be mixed or otherwise processed. The payload is not played out.
+  //
+  // The payload-type of the packet has to be registered as a PCMU or PCMA
+  // receive codec, the send codec has to be PCMU or PCMA with the same number
+  // of channels, and neither VAD/DTX nor FEC may be enabled.
+  //
+  // Inputs:
+  //   -incomingPayload    : received payload.
+  //   -payloadLengthByte  : the length of payload in bytes.
+  //   -rtpInfo            : the relevant information retrieved from RTP
+  //                         header.
+  //
+  // Return value:
+  //   -1 if the payload can't be transcoded this way or failed to be sent,
+  //    0 if the payload is passed to the transport callback.
+  //
+  virtual WebRtc_Word32 TranscodeG711Packet(
+      const WebRtc_UWord8* incomingPayload,
+      const WebRtc_Word32 payloadLengthByte,
+      const WebRtcRTPHeader& rtpInfo) = 0;
+
   ///////////////////////////////////////////////////////////////////////////
   // WebRtc_Word32 SetMinimumPlayoutDelay()
   // Set Minimum playout delay, used for lip-sync.
@@ -757,6 +790,36 @@ class AudioCodingModule: public Module {
   //
   virtual AudioPlayoutMode PlayoutMode() const = 0;
 
+  ///////////////////////////////////////////////////////////////////////////
+  // WebRtc_Word32 SetDecodeOnReceive()
+  // Call this API to decode incoming packets as they arrive, in
+  // IncomingPacket(), instead of in PlayoutData10Ms(). The playout callback
+  // then only runs NetEQ's time-stretching, which makes its execution time
+  // short and predictable, while the decoding is spread over the threads
+  // delivering packets. In this mode the codec-internal packet loss
+  // concealment and comfort noise are replaced by those of NetEQ. Changing
+  // the mode flushes the jitter buffer.
+  //
+  // Input:
+  //   -enable             : if true, decode packets on receive,
+  //                         if false, decode packets on playout (default).
+  //
+  // Return value:
+  //   -1 if failed to set the mode,
+  //    0 if succeeding.
+  //
+  virtual WebRtc_Word32 SetDecodeOnReceive(const bool enable) = 0;
+
+  ///////////////////////////////////////////////////////////////////////////
+  // bool DecodeOnReceive()
+  // Get whether incoming packets are decoded on receive.
+  //
+  // Return value:
+  //   true if packets are decoded in IncomingPacket(),
+  //   false if packets are decoded in PlayoutData10Ms().
+  //
+  virtual bool DecodeOnReceive() const = 0;
+
   ///////////////////////////////////////////////////////////////////////////
   // WebRtc_Word32 PlayoutData10Ms(
   // Get 10 milliseconds of raw audio data for playout, at the given sampling
@@ -12,11 +12,11 @@
 #include <stdlib.h> // malloc
 
 #include "acm_neteq.h"
+#include "clock.h"
 #include "common_types.h"
 #include "critical_section_wrapper.h"
 #include "rw_lock_wrapper.h"
 #include "signal_processing_library.h"
-#include "tick_util.h"
 #include "trace.h"
 #include "webrtc_neteq.h"
 #include "webrtc_neteq_internal.h"
@@ -30,12 +30,14 @@ namespace webrtc
 #define NETEQ_ERR_MSG_LEN_BYTE (WEBRTC_NETEQ_MAX_ERROR_NAME + 1)
 
 
-ACMNetEQ::ACMNetEQ()
+ACMNetEQ::ACMNetEQ(Clock* clock)
 :
+_clock(clock),
 _id(0),
 _currentSampFreqKHz(NETEQ_INIT_FREQ_KHZ),
 _avtPlayout(false),
 _playoutMode(voice),
+_decodeOnReceive(false),
 _netEqCritSect(CriticalSectionWrapper::CreateCriticalSection()),
 _vadStatus(false),
 _vadMode(VADNormal),
@@ -198,6 +200,13 @@ ACMNetEQ::InitByIdxSafe(
         _isInitialized[idx] = false;
         return -1;
     }
+    // Has to be set before the packet buffer is allocated.
+    if (WebRtcNetEQ_SetDecodeOnReceive(_inst[idx], (_decodeOnReceive) ? 1 : 0) != 0)
+    {
+        LogError("SetDecodeOnReceive", idx);
+        _isInitialized[idx] = false;
+        return -1;
+    }
     _isInitialized[idx] = true;
     return 0;
 }
@@ -439,6 +448,71 @@ ACMNetEQ::PlayoutMode() const
     return _playoutMode;
 }
 
+WebRtc_Word32
+ACMNetEQ::SetDecodeOnReceive(
+    const bool                enable,
+    const WebRtcNetEQDecoder* usedCodecs,
+    WebRtc_Word16             noOfCodecs)
+{
+    CriticalSectionScoped lock(*_netEqCritSect);
+    if(_decodeOnReceive != enable)
+    {
+        for(WebRtc_Word16 idx = 0; idx < _numSlaves + 1; idx++)
+        {
+            if(SetDecodeOnReceiveByIdxSafe(enable, usedCodecs, noOfCodecs,
+                idx) < 0)
+            {
+                // Put the instances up to idx back, so that master and
+                // slave keep decoding in the same place.
+                for(WebRtc_Word16 k = 0; k <= idx; k++)
+                {
+                    if(_isInitialized[k])
+                    {
+                        SetDecodeOnReceiveByIdxSafe(_decodeOnReceive,
+                            usedCodecs, noOfCodecs, k);
+                    }
+                }
+                return -1;
+            }
+        }
+        _decodeOnReceive = enable;
+    }
+    return 0;
+}
+
+WebRtc_Word16
+ACMNetEQ::SetDecodeOnReceiveByIdxSafe(
+    const bool                enable,
+    const WebRtcNetEQDecoder* usedCodecs,
+    WebRtc_Word16             noOfCodecs,
+    const WebRtc_Word16       idx)
+{
+    if(!_isInitialized[idx])
+    {
+        WEBRTC_TRACE(webrtc::kTraceError, webrtc::kTraceAudioCoding, _id,
+            "SetDecodeOnReceive: NetEq is not initialized.");
+        return -1;
+    }
+    if(WebRtcNetEQ_SetDecodeOnReceive(_inst[idx], (enable) ? 1 : 0) < 0)
+    {
+        LogError("SetDecodeOnReceive", idx);
+        return -1;
+    }
+    // Decoded payloads need a larger packet buffer.
+    if(AllocatePacketBufferByIdxSafe(usedCodecs, noOfCodecs, idx) < 0)
+    {
+        return -1;
+    }
+    return 0;
+}
+
+bool
+ACMNetEQ::DecodeOnReceive() const
+{
+    CriticalSectionScoped lock(*_netEqCritSect);
+    return _decodeOnReceive;
+}
+
 
 WebRtc_Word32
 ACMNetEQ::NetworkStatistics(
@@ -490,7 +564,7 @@ ACMNetEQ::RecIn(
     // we masked 6 most significant bits of 32-bit so we don't loose resolution
     // when do the following multiplication.
     const WebRtc_UWord32 nowInMs = static_cast<WebRtc_UWord32>(
-        TickTime::MillisecondTimestamp() & 0x03ffffff);
+        _clock->TimeInMilliseconds() & 0x03ffffff);
     WebRtc_UWord32 recvTimestamp = static_cast<WebRtc_UWord32>
         (_currentSampFreqKHz * nowInMs);
 
@@ -505,7 +579,7 @@ ACMNetEQ::RecIn(
             return -1;
         }
         // PUSH into Master
-        status = WebRtcNetEQ_RecInRTPStruct(_inst[0], &netEqRTPInfo,
+        status = RecInByIdxSafe(0, netEqRTPInfo,
             (WebRtc_UWord8 *)incomingPayload, (WebRtc_Word16)payloadLength,
             recvTimestamp);
         if(status < 0)
@@ -525,7 +599,7 @@ ACMNetEQ::RecIn(
             return -1;
         }
         // PUSH into Slave
-        status = WebRtcNetEQ_RecInRTPStruct(_inst[1], &netEqRTPInfo,
+        status = RecInByIdxSafe(1, netEqRTPInfo,
             (WebRtc_UWord8 *)incomingPayload, (WebRtc_Word16)payloadLength,
             recvTimestamp);
         if(status < 0)
@@ -548,6 +622,25 @@ ACMNetEQ::RecIn(
     return 0;
 }
 
+int
+ACMNetEQ::RecInByIdxSafe(
+    const WebRtc_Word16  idx,
+    WebRtcNetEQ_RTPInfo& rtpInfo,
+    const WebRtc_UWord8* payload,
+    const WebRtc_Word16  payloadLengthBytes,
+    const WebRtc_UWord32 recvTimestamp)
+{
+    if(!_decodeOnReceive)
+    {
+        return WebRtcNetEQ_RecInRTPStruct(_inst[idx], &rtpInfo, payload,
+            payloadLengthBytes, recvTimestamp);
+    }
+    // NetEq decodes the payload, protect the decoder instances.
+    WriteLockScoped lockCodec(*_decodeLock);
+    return WebRtcNetEQ_RecInRTPStruct(_inst[idx], &rtpInfo, payload,
+        payloadLengthBytes, recvTimestamp);
+}
+
 WebRtc_Word32
 ACMNetEQ::RecOut(
     AudioFrame& audioFrame)
@@ -17,10 +17,12 @@
 #include "module_common_types.h"
 #include "typedefs.h"
 #include "webrtc_neteq.h"
+#include "webrtc_neteq_internal.h"
 #include "webrtc_vad.h"
 
 namespace webrtc {
 
+class Clock;
 class CriticalSectionWrapper;
 class RWLockWrapper;
 struct CodecInst;
@@ -32,8 +34,9 @@ enum ACMSpeechType;
 class ACMNetEQ
 {
 public:
-    // Constructor of the class
-    ACMNetEQ();
+    // Constructor of the class. Received packets are stamped with the time
+    // of |clock|, which must outlive this object.
+    ACMNetEQ(Clock* clock);
 
     // Destructor of the class.
     ~ACMNetEQ();
@@ -200,6 +203,36 @@ public:
     //
     AudioPlayoutMode PlayoutMode() const;
 
+    //
+    // SetDecodeOnReceive()
+    // Enable/disable decoding of the payloads in RecIn() instead of in
+    // RecOut(). The packet buffer is reallocated to hold decoded audio.
+    //
+    // Input:
+    //   - enable                : Decode in RecIn() if true, in RecOut()
+    //                             if false.
+    //   - usedCodecs            : An array of the codecs to be used by NetEQ.
+    //   - noOfCodecs            : Number of codecs in usedCodecs.
+    //
+    // Return value              : 0 if ok.
+    //                            <0 if NetEQ returned an error. The master
+    //                            and slave instances are then left in the
+    //                            previous mode.
+    //
+    WebRtc_Word32 SetDecodeOnReceive(
+        const bool                enable,
+        const WebRtcNetEQDecoder* usedCodecs,
+        WebRtc_Word16             noOfCodecs);
+
+    //
+    // DecodeOnReceive()
+    // Get the current decode-on-receive state.
+    //
+    // Return value              : True if payloads are decoded in RecIn().
+    //                             False if payloads are decoded in RecOut().
+    //
+    bool DecodeOnReceive() const;
+
     //
     // NetworkStatistics()
     // Get the current network statistics from NetEQ.
@@ -352,15 +385,36 @@ private:
         WebRtc_Word16       noOfCodecs,
         const WebRtc_Word16 idx);
 
+    // SetDecodeOnReceiveByIdxSafe()
+    // Set the decode-on-receive mode of NetEQ instance idx, and reallocate
+    // its packet buffer for it.
+    WebRtc_Word16 SetDecodeOnReceiveByIdxSafe(
+        const bool                enable,
+        const WebRtcNetEQDecoder* usedCodecs,
+        WebRtc_Word16             noOfCodecs,
+        const WebRtc_Word16       idx);
+
+    // RecInByIdxSafe()
+    // Insert a packet into NetEQ instance idx. In decode-on-receive mode the
+    // payload is decoded here, so the decode lock is held.
+    int RecInByIdxSafe(
+        const WebRtc_Word16  idx,
+        WebRtcNetEQ_RTPInfo& rtpInfo,
+        const WebRtc_UWord8* payload,
+        const WebRtc_Word16  payloadLengthBytes,
+        const WebRtc_UWord32 recvTimestamp);
+
     void*                   _inst[MAX_NUM_SLAVE_NETEQ + 1];
     void*                   _instMem[MAX_NUM_SLAVE_NETEQ + 1];
 
     WebRtc_Word16*          _netEqPacketBuffer[MAX_NUM_SLAVE_NETEQ + 1];
 
+    Clock*                  _clock;
     WebRtc_Word32           _id;
     float                   _currentSampFreqKHz;
     bool                    _avtPlayout;
     AudioPlayoutMode        _playoutMode;
+    bool                    _decodeOnReceive;
     CriticalSectionWrapper* _netEqCritSect;
 
     WebRtcVadInst*          _ptrVADInst[MAX_NUM_SLAVE_NETEQ + 1];
@@ -12,6 +12,7 @@
 #include "acm_dtmf_detection.h"
 #include "audio_coding_module.h"
 #include "audio_coding_module_impl.h"
+#include "clock.h"
 #include "trace.h"
 
 namespace webrtc
@@ -22,7 +23,15 @@ AudioCodingModule*
 AudioCodingModule::Create(
     const WebRtc_Word32 id)
 {
-    return new AudioCodingModuleImpl(id);
+    return Create(id, Clock::GetRealTimeClock());
+}
+
+AudioCodingModule*
+AudioCodingModule::Create(
+    const WebRtc_Word32 id,
+    Clock*              clock)
+{
+    return new AudioCodingModuleImpl(id, clock);
 }
 
 // Destroy module
@@ -16,6 +16,7 @@
 #include "audio_coding_module_impl.h"
 #include "critical_section_wrapper.h"
 #include "engine_configurations.h"
+#include "g711_interface.h"
 #include "rw_lock_wrapper.h"
 #include "trace.h"
 
@@ -45,7 +46,8 @@ enum {
 };
 
 AudioCodingModuleImpl::AudioCodingModuleImpl(
-    const WebRtc_Word32 id):
+    const WebRtc_Word32 id,
+    Clock*              clock):
     _packetizationCallback(NULL),
     _id(id),
     _lastTimestamp(0),
@@ -56,6 +58,7 @@ AudioCodingModuleImpl::AudioCodingModuleImpl(
     _stereoSend(false),
     _currentSendCodecIdx(-1),    // invalid value
     _sendCodecRegistered(false),
+    _netEq(clock),
     _acmCritSect(CriticalSectionWrapper::CreateCriticalSection()),
     _vadCallback(NULL),
     _lastRecvAudioCodecPlType(255),
@@ -1921,6 +1924,25 @@ AudioCodingModuleImpl::PlayoutMode() const
     return _netEq.PlayoutMode();
 }
 
+// Decode packets on receive instead of on playout
+WebRtc_Word32
+AudioCodingModuleImpl::SetDecodeOnReceive(
+    const bool enable)
+{
+    WEBRTC_TRACE(webrtc::kTraceModuleCall, webrtc::kTraceAudioCoding, _id,
+        "SetDecodeOnReceive()");
+    return _netEq.SetDecodeOnReceive(enable, ACMCodecDB::NetEQDecoders(),
+        ACMCodecDB::kNumCodecs);
+}
+
+bool
+AudioCodingModuleImpl::DecodeOnReceive() const
+{
+    WEBRTC_TRACE(webrtc::kTraceModuleCall, webrtc::kTraceAudioCoding, _id,
+        "DecodeOnReceive()");
+    return _netEq.DecodeOnReceive();
+}
+
 
 // Get 10 milliseconds of raw audio data to play out
 // automatic resample to the requested frequency
@@ -2277,6 +2299,95 @@ AudioCodingModuleImpl::IncomingPayload(
     return 0;
 }
 
+WebRtc_Word32
+AudioCodingModuleImpl::TranscodeG711Packet(
+    const WebRtc_UWord8*   incomingPayload,
+    const WebRtc_Word32    payloadLength,
+    const WebRtcRTPHeader& rtpInfo)
+{
+    if((payloadLength < 0) || (payloadLength > MAX_PAYLOAD_SIZE_BYTE))
+    {
+        WEBRTC_TRACE(webrtc::kTraceError, webrtc::kTraceAudioCoding, _id,
+            "TranscodeG711Packet() Error, invalid payload-length");
+        return -1;
+    }
+
+    WebRtc_UWord8 payload[MAX_PAYLOAD_SIZE_BYTE];
+    WebRtc_UWord8 sendPayloadType;
+    {
+        CriticalSectionScoped lock(*_acmCritSect);
+
+        const WebRtc_UWord8 payloadType = rtpInfo.header.payloadType;
+        WebRtc_Word16 receiveCodecId;
+        if(payloadType == _registeredPlTypes[ACMCodecDB::kPCMU])
+        {
+            receiveCodecId = ACMCodecDB::kPCMU;
+        }
+        else if(payloadType == _registeredPlTypes[ACMCodecDB::kPCMA])
+        {
+            receiveCodecId = ACMCodecDB::kPCMA;
+        }
+        else
+        {
+            WEBRTC_TRACE(webrtc::kTraceError, webrtc::kTraceAudioCoding, _id,
+                "TranscodeG711Packet() Error, payload-type %d is not PCMU or "
+                "PCMA", payloadType);
+            return -1;
+        }
+
+        if((_currentSendCodecIdx != ACMCodecDB::kPCMU) &&
+            (_currentSendCodecIdx != ACMCodecDB::kPCMA))
+        {
+            WEBRTC_TRACE(webrtc::kTraceError, webrtc::kTraceAudioCoding, _id,
+                "TranscodeG711Packet() Error, send codec is not PCMU or PCMA");
+            return -1;
+        }
+        if(_vadEnabled || _dtxEnabled || _fecEnabled)
+        {
+            WEBRTC_TRACE(webrtc::kTraceError, webrtc::kTraceAudioCoding, _id,
+                "TranscodeG711Packet() Error, VAD/DTX or FEC is enabled");
+            return -1;
+        }
+        const int receiveChannels = _stereoReceive[receiveCodecId] ? 2 : 1;
+        if(receiveChannels != _sendCodecInst.channels)
+        {
+            WEBRTC_TRACE(webrtc::kTraceError, webrtc::kTraceAudioCoding, _id,
+                "TranscodeG711Packet() Error, number of channels differ");
+            return -1;
+        }
+
+        // Each byte is one sample, also when the channels are interleaved.
+        const WebRtc_Word16 length = (WebRtc_Word16)payloadLength;
+        if(receiveCodecId == _currentSendCodecIdx)
+        {
+            memcpy(payload, incomingPayload, length);
+        }
+        else if(receiveCodecId == ACMCodecDB::kPCMA)
+        {
+            WebRtcG711_TranscodeAToU(incomingPayload, length, payload);
+        }
+        else
+        {
+            WebRtcG711_TranscodeUToA(incomingPayload, length, payload);
+        }
+        sendPayloadType = (WebRtc_UWord8)_sendCodecInst.pltype;
+    }
+
+    CriticalSectionScoped lock(*_callbackCritSect);
+    if(_packetizationCallback == NULL)
+    {
+        return -1;
+    }
+    // Both codecs use an 8 kHz RTP clock, so the timestamp carries over.
+    if(_packetizationCallback->SendData(kAudioFrameSpeech, sendPayloadType,
+        rtpInfo.header.timestamp, payload, (WebRtc_UWord16)payloadLength,
+        NULL) < 0)
+    {
+        return -1;
+    }
+    return 0;
+}
+
 WebRtc_Word16
 AudioCodingModuleImpl::DecoderParamByPlType(
     const WebRtc_UWord8    payloadType,
@@ -39,7 +39,8 @@ class AudioCodingModuleImpl : public AudioCodingModule
 public:
     // constructor
     AudioCodingModuleImpl(
-        const WebRtc_Word32 id);
+        const WebRtc_Word32 id,
+        Clock*              clock);
 
     // destructor
     ~AudioCodingModuleImpl();
@@ -199,6 +200,13 @@ public:
         const WebRtc_UWord8  payloadType,
         const WebRtc_UWord32 timestamp = 0);
 
+    // Incoming PCMU or PCMA payloads sent on with the send codec, converted
+    // directly between u-law and A-law.
+    WebRtc_Word32 TranscodeG711Packet(
+        const WebRtc_UWord8*   incomingPayload,
+        const WebRtc_Word32    payloadLength,
+        const WebRtcRTPHeader& rtpInfo);
+
     // Minimum playout dealy (Used for lip-sync)
     WebRtc_Word32 SetMinimumPlayoutDelay(
         const WebRtc_Word32 timeMs);
@@ -222,6 +230,12 @@ public:
     // Get playout mode voice, fax
     AudioPlayoutMode PlayoutMode() const;
 
+    // Decode packets on receive instead of on playout
+    WebRtc_Word32 SetDecodeOnReceive(
+        const bool enable);
+
+    bool DecodeOnReceive() const;
+
     // Get playout timestamp
     WebRtc_Word32 PlayoutTimestamp(
         WebRtc_UWord32& timestamp);
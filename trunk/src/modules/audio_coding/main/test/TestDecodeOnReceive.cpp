@@ -0,0 +1,213 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "TestDecodeOnReceive.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "audio_coding_module_typedefs.h"
+#include "common_types.h"
+#include "trace.h"
+#include "utility.h"
+
+namespace webrtc {
+
+#define CHECK_TRUE(f)                                                       \
+    do {                                                                    \
+        if(!(f)) {                                                          \
+            char errString[500];                                            \
+            sprintf(errString, "Check failed in file %s at line %d \n",     \
+                __FILE__, __LINE__);                                        \
+            throw errString;                                                \
+        }                                                                   \
+    }while(0)
+
+TestDecodeOnReceive::TestDecodeOnReceive(int testMode):
+_acmA(NULL),
+_acmB(NULL),
+_acmRefA(NULL),
+_acmRefB(NULL),
+_channelA2B(NULL),
+_channelRefA2B(NULL),
+_stereoA2B(NULL),
+_stereoRefA2B(NULL)
+{
+    _testMode = testMode;
+}
+
+TestDecodeOnReceive::~TestDecodeOnReceive()
+{
+    AudioCodingModule::Destroy(_acmA);
+    AudioCodingModule::Destroy(_acmB);
+    AudioCodingModule::Destroy(_acmRefA);
+    AudioCodingModule::Destroy(_acmRefB);
+    delete _channelA2B;
+    delete _channelRefA2B;
+    delete _stereoA2B;
+    delete _stereoRefA2B;
+    _inFileMono.Close();
+    _inFileStereo.Close();
+}
+
+void TestDecodeOnReceive::Perform()
+{
+    if(_testMode == 0)
+    {
+        printf("Running Decode-on-Receive Test");
+        WEBRTC_TRACE(kTraceStateInfo, kTraceAudioCoding, -1,
+                     "---------- TestDecodeOnReceive ----------");
+    }
+
+    char fileName[500];
+    strcpy(fileName, "./test/data/audio_coding/testfile32kHz.pcm");
+    _inFileMono.Open(fileName, 32000, "rb", true);
+    strcpy(fileName, "./test/data/audio_coding/teststereo32kHz.pcm");
+    _inFileStereo.Open(fileName, 32000, "rb", true);
+    _inFileStereo.ReadStereo(true);
+
+    _acmA = AudioCodingModule::Create(0);
+    _acmB = AudioCodingModule::Create(1);
+    _acmRefA = AudioCodingModule::Create(2);
+    _acmRefB = AudioCodingModule::Create(3);
+
+    CHECK_ERROR(_acmB->InitializeReceiver());
+    CHECK_ERROR(_acmRefB->InitializeReceiver());
+
+    // L16 and PCMU, mono and stereo, at the receivers.
+    CodecInst myCodecParam;
+    const WebRtc_UWord8 numEncoders = _acmA->NumberOfCodecs();
+    for(WebRtc_UWord8 n = 0; n < numEncoders; n++)
+    {
+        _acmB->Codec(n, myCodecParam);
+        if(!strcmp(myCodecParam.plname, "L16") ||
+            !strcmp(myCodecParam.plname, "PCMU"))
+        {
+            CHECK_ERROR(_acmB->RegisterReceiveCodec(myCodecParam));
+            CHECK_ERROR(_acmRefB->RegisterReceiveCodec(myCodecParam));
+            myCodecParam.channels = 2;
+            CHECK_ERROR(_acmB->RegisterReceiveCodec(myCodecParam));
+            CHECK_ERROR(_acmRefB->RegisterReceiveCodec(myCodecParam));
+        }
+    }
+
+    _channelA2B = new Channel;
+    _channelA2B->RegisterReceiverACM(_acmB);
+    _channelRefA2B = new Channel;
+    _channelRefA2B->RegisterReceiverACM(_acmRefB);
+    _stereoA2B = new TestPackStereo;
+    _stereoA2B->RegisterReceiverACM(_acmB);
+    _stereoRefA2B = new TestPackStereo;
+    _stereoRefA2B->RegisterReceiverACM(_acmRefB);
+
+    // Decoding on playout is the default.
+    CHECK_TRUE(!_acmB->DecodeOnReceive());
+    SetDecodeOnReceive(true, false);
+    // Setting the current mode again is fine.
+    CHECK_ERROR(_acmB->SetDecodeOnReceive(true));
+    CHECK_TRUE(_acmB->DecodeOnReceive());
+
+    // Stereo, where the slave NetEQ takes the mode of the master.
+    CHECK_ERROR(_acmA->RegisterTransportCallback(_stereoA2B));
+    CHECK_ERROR(_acmRefA->RegisterTransportCallback(_stereoRefA2B));
+    _stereoA2B->SetCodecType(1);
+    _stereoRefA2B->SetCodecType(1);
+    RegisterSendCodec("L16", 32000, 2);
+    Run(_inFileStereo, 100);
+
+    // Switch both receivers, master and slave, the other way. Both jitter
+    // buffers are flushed at the same time, so the output stays the same.
+    SetDecodeOnReceive(false, true);
+    Run(_inFileStereo, 100);
+    _stereoA2B->SetCodecType(0);
+    _stereoRefA2B->SetCodecType(0);
+    RegisterSendCodec("PCMU", 8000, 2);
+    Run(_inFileStereo, 100);
+
+    // Mono.
+    SetDecodeOnReceive(true, false);
+    CHECK_ERROR(_acmA->RegisterTransportCallback(_channelA2B));
+    CHECK_ERROR(_acmRefA->RegisterTransportCallback(_channelRefA2B));
+    RegisterSendCodec("L16", 16000, 1);
+    Run(_inFileMono, 100);
+    RegisterSendCodec("PCMU", 8000, 1);
+    Run(_inFileMono, 100);
+
+    if(_testMode == 0)
+    {
+        printf("Done!\n");
+    }
+}
+
+void TestDecodeOnReceive::RegisterSendCodec(char* codecName,
+                                            WebRtc_Word32 sampFreqHz,
+                                            int channels)
+{
+    CodecInst myCodecParam;
+    CHECK_ERROR(AudioCodingModule::Codec(codecName, myCodecParam,
+                                         sampFreqHz));
+    myCodecParam.channels = channels;
+    CHECK_ERROR(_acmA->RegisterSendCodec(myCodecParam));
+    CHECK_ERROR(_acmRefA->RegisterSendCodec(myCodecParam));
+    if(_testMode != 0)
+    {
+        printf("%s %d Hz, %d channel(s)\n", codecName, sampFreqHz, channels);
+    }
+}
+
+void TestDecodeOnReceive::SetDecodeOnReceive(bool enable, bool enableRef)
+{
+    CHECK_ERROR(_acmB->SetDecodeOnReceive(enable));
+    CHECK_ERROR(_acmRefB->SetDecodeOnReceive(enableRef));
+    CHECK_TRUE(_acmB->DecodeOnReceive() == enable);
+    CHECK_TRUE(_acmRefB->DecodeOnReceive() == enableRef);
+}
+
+void TestDecodeOnReceive::Run(PCMFile& inFile, int numFrames)
+{
+    AudioFrame audioFrame;
+    AudioFrame audioFrameB;
+    AudioFrame audioFrameRefB;
+    const WebRtc_Word32 outFreqHz = 32000;
+    int mismatchingFrames = 0;
+
+    for(int n = 0; n < numFrames; n++)
+    {
+        inFile.Read10MsData(audioFrame);
+        CHECK_ERROR(_acmA->Add10MsData(audioFrame));
+        CHECK_ERROR(_acmRefA->Add10MsData(audioFrame));
+        CHECK_ERROR(_acmA->Process());
+        CHECK_ERROR(_acmRefA->Process());
+
+        CHECK_ERROR(_acmB->PlayoutData10Ms(outFreqHz, audioFrameB));
+        CHECK_ERROR(_acmRefB->PlayoutData10Ms(outFreqHz, audioFrameRefB));
+        const int lengthSmpls = audioFrameB._payloadDataLengthInSamples *
+            audioFrameB._audioChannel;
+        if((audioFrameB._payloadDataLengthInSamples !=
+            audioFrameRefB._payloadDataLengthInSamples) ||
+            (audioFrameB._audioChannel != audioFrameRefB._audioChannel) ||
+            memcmp(audioFrameB._payloadData, audioFrameRefB._payloadData,
+                   lengthSmpls * sizeof(WebRtc_Word16)))
+        {
+            mismatchingFrames++;
+        }
+    }
+    if(_testMode != 0)
+    {
+        printf("  %d of %d frames differ\n", mismatchingFrames, numFrames);
+    }
+    else
+    {
+        printf(".");
+    }
+    CHECK_TRUE(mismatchingFrames == 0);
+}
+
+} // namespace webrtc
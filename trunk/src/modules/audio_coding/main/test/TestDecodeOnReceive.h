@@ -0,0 +1,58 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef TEST_DECODE_ON_RECEIVE_H
+#define TEST_DECODE_ON_RECEIVE_H
+
+#include "ACMTest.h"
+#include "Channel.h"
+#include "PCMFile.h"
+#include "TestStereo.h"
+#include "audio_coding_module.h"
+
+namespace webrtc {
+
+// Sends the same audio to two receivers, one decoding on receive and one
+// decoding on playout, and checks that they play out the same samples, for
+// mono and for stereo, where the slave NetEQ has to follow the master.
+class TestDecodeOnReceive : public ACMTest
+{
+public:
+    TestDecodeOnReceive(int testMode);
+    ~TestDecodeOnReceive();
+
+    void Perform();
+private:
+    void RegisterSendCodec(char* codecName, WebRtc_Word32 sampFreqHz,
+                           int channels);
+    void SetDecodeOnReceive(bool enable, bool enableRef);
+    // Runs numFrames 10 ms frames and throws if the receivers differ.
+    void Run(PCMFile& inFile, int numFrames);
+
+    int                 _testMode;
+
+    // _acmA sends to _acmB, _acmRefA to _acmRefB.
+    AudioCodingModule*  _acmA;
+    AudioCodingModule*  _acmB;
+    AudioCodingModule*  _acmRefA;
+    AudioCodingModule*  _acmRefB;
+
+    Channel*            _channelA2B;
+    Channel*            _channelRefA2B;
+    TestPackStereo*     _stereoA2B;
+    TestPackStereo*     _stereoRefA2B;
+
+    PCMFile             _inFileMono;
+    PCMFile             _inFileStereo;
+};
+
+} // namespace webrtc
+
+#endif
@@ -19,6 +19,7 @@
 #include "iSACTest.h"
 #include "SpatialAudio.h"
 #include "TestAllCodecs.h"
+#include "TestDecodeOnReceive.h"
 #include "TestFEC.h"
 #include "TestStereo.h"
 #include "TestVADDTX.h"
@@ -42,6 +43,7 @@ using webrtc::Trace;
 //#define ACM_TEST_FEC            // Test FEC (also called RED)
 //#define ACM_TEST_CODEC_SPEC_API // Only iSAC has codec specfic APIs in this version
 //#define ACM_TEST_FULL_API       // Test all APIs with threads (long test)
+//#define ACM_TEST_DECODE_ON_RECEIVE // Compare decoding on receive and on playout
 
 
 void PopulateTests(std::vector<ACMTest*>* tests)
@@ -61,6 +63,7 @@ void PopulateTests(std::vector<ACMTest*>* tests)
     tests->push_back(new webrtc::TestVADDTX(0));
     tests->push_back(new webrtc::TestFEC(0));
     tests->push_back(new webrtc::ISACTest(0));
+    tests->push_back(new webrtc::TestDecodeOnReceive(0));
 #endif
 #ifdef ACM_TEST_ENC_DEC
     printf("  ACM encode-decode test\n");
@@ -94,6 +97,10 @@ void PopulateTests(std::vector<ACMTest*>* tests)
 #ifdef ACM_TEST_FULL_API
     printf("  ACM full API test\n");
     tests->push_back(new webrtc::APITest());
+#endif
+#ifdef ACM_TEST_DECODE_ON_RECEIVE
+    printf("  ACM decode-on-receive test\n");
+    tests->push_back(new webrtc::TestDecodeOnReceive(1));
 #endif
     printf("\n");
 }
@@ -213,6 +213,31 @@ int WebRtcNetEQ_RecOutNoDecode(void *inst, WebRtc_Word16 *pw16_outData,
 
 int WebRtcNetEQ_FlushBuffers(void *inst);
 
+/****************************************************************************
+ * WebRtcNetEQ_SetDecodeOnReceive(...)
+ *
+ * Enable or disable decode-on-receive mode. In this mode, payloads are decoded
+ * in RecIn and stored as PCM in the packet buffer, and RecOut only performs
+ * the DSP operations. The decoders are then called from the RecIn thread, and
+ * codec-internal PLC and CNG are replaced by NetEQ's expand and background
+ * noise. Changing the mode flushes the packet buffer.
+ *
+ * Since decoded payloads need more memory, this function should be called
+ * before WebRtcNetEQ_GetRecommendedBufferSize and WebRtcNetEQ_AssignBuffer.
+ *
+ * Input:
+ *      - inst              : NetEQ instance
+ *      - decodeOnReceive   : 1 to decode in RecIn, 0 to decode in RecOut
+ *
+ * Output:
+ *		- inst	            : Updated NetEQ instance
+ *
+ * Return value			    :  0 - Ok
+ *						      -1 - Error
+ */
+
+int WebRtcNetEQ_SetDecodeOnReceive(void *inst, int decodeOnReceive);
+
 #ifdef __cplusplus
 }
 #endif
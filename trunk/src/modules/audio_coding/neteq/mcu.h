@@ -86,6 +86,9 @@ typedef struct
     int usingStereo;
 #endif
 
+    WebRtc_Word16 decodeOnReceive; /* 1 if payloads are decoded in RecIn */
+    WebRtc_Word16 decodedCodec; /* Codec whose decoder was last initialized in RecIn */
+
 } MCUInst_t;
 
 /****************************************************************************
@@ -189,21 +192,28 @@ int WebRtcNetEQ_RecInInternal(MCUInst_t *MCU_inst, RTPPacket_t *RTPpacket,
                               WebRtc_UWord32 uw32_timeRec);
 
 /****************************************************************************
- * WebRtcNetEQ_RecInInternal(...)
+ * WebRtcNetEQ_SplitAndInsertPayload(...)
  *
  * Split the packet according to split_inst and inserts the parts into
- * Buffer_inst.
+ * Buffer_inst. If decoder is non-NULL, each part is decoded and stored as
+ * one speech type word followed by the decoded samples.
  *
  * Input:
- *      - MCU_inst      : MCU instance
- *      - RTPpacket     : The RTP packet, parsed into NetEQ's internal RTP struct
- *      - uw32_timeRec  : Time stamp for the arrival of the packet (not RTP timestamp)
+ *      - packet        : The RTP packet, parsed into NetEQ's internal RTP struct
+ *      - Buffer_inst   : Packet buffer instance
+ *      - split_inst    : Information about how to split the payload
+ *      - decoder       : Decoder to use in decode-on-receive mode, or NULL
+ *
+ * Output:
+ *      - flushed       : 1 if the packet buffer was flushed
  *
  * Return value         :  0 - Ok
- *                        -1 - Error
+ *                        <0 - Error
  */
 int WebRtcNetEQ_SplitAndInsertPayload(RTPPacket_t *packet, PacketBuf_t *Buffer_inst,
-                                      SplitInfo_t *split_inst, WebRtc_Word16 *flushed);
+                                      SplitInfo_t *split_inst,
+                                      const CodecFuncInst_t *decoder,
+                                      WebRtc_Word16 *flushed);
 
 /****************************************************************************
  * WebRtcNetEQ_GetTimestampScaling(...)
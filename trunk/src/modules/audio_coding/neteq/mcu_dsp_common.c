@@ -16,6 +16,8 @@
 
 #include <string.h>
 
+#include "neteq_defines.h"
+
 /* Initialize instances with read and write address */
 int WebRtcNetEQ_DSPinit(MainInst_t *inst)
 {
@@ -31,7 +33,16 @@ int WebRtcNetEQ_DSPinit(MainInst_t *inst)
 /* The DSP side will call this function to interrupt the MCU side */
 int WebRtcNetEQ_DSP2MCUinterrupt(MainInst_t *inst, WebRtc_Word16 *pw16_shared_mem)
 {
+    int res;
+
     inst->MCUinst.pw16_readAddress = pw16_shared_mem;
     inst->MCUinst.pw16_writeAddress = pw16_shared_mem;
-    return WebRtcNetEQ_SignalMcu(&inst->MCUinst);
+    res = WebRtcNetEQ_SignalMcu(&inst->MCUinst);
+
+    /* Tell the DSP side not to decode the payloads once more */
+    if (inst->MCUinst.decodeOnReceive)
+    {
+        inst->MCUinst.pw16_writeAddress[0] |= DSP_DECODED_PAYLOAD;
+    }
+    return res;
 }
@@ -32,6 +32,8 @@ int WebRtcNetEQ_McuReset(MCUInst_t *inst)
     inst->one_desc = 0;
     inst->BufferStat_inst.Automode_inst.extraDelayMs = 0;
     inst->NetEqPlayoutMode = kPlayoutOn;
+    inst->decodeOnReceive = 0;
+    inst->decodedCodec = -1;
 
     WebRtcNetEQ_DbReset(&inst->codec_DB_inst);
     memset(&inst->PayloadSplit_inst, 0, sizeof(SplitInfo_t));
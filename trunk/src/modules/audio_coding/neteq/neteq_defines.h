@@ -171,6 +171,11 @@
 #define DSP_CODEC_ADD_LATE_PKT                   0x0300
 #define DSP_CODEC_RESET                          0x0400
 #define DSP_DTMF_PAYLOAD                         0x0010
+/*
+ * Set when the payload blocks hold PCM that was decoded in RecIn, stored as
+ * one speech type word followed by the samples (decode-on-receive mode).
+ */
+#define DSP_DECODED_PAYLOAD                      0x0020
 
 /*
  * The most significant bit of the payload-length
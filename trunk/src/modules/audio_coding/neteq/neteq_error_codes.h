@@ -40,6 +40,7 @@
 #define RECIN_CNG_ERROR                 -3001
 #define RECIN_UNKNOWNPAYLOAD            -3002
 #define RECIN_BUFFERINSERT_ERROR        -3003
+#define RECIN_DECODE_ERROR              -3004
 
 /* PBUFFER/BUFSTAT ERRORS */
 #define PBUFFER_INIT_ERROR              -4001
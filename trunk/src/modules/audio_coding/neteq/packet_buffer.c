@@ -496,8 +496,41 @@ WebRtc_Word32 WebRtcNetEQ_PacketBufferGetSize(const PacketBuf_t *bufferInst)
 }
 
 
+/*
+ * Returns the number of bytes per ms of decoded speech for a codec.
+ */
+
+static WebRtc_Word16 WebRtcNetEQ_DecodedBytesPerMs(enum WebRtcNetEQDecoder codecID)
+{
+    switch (codecID)
+    {
+        case kDecoderPCM16Bswb48kHz:
+            return 96;
+        case kDecoderISACswb:
+        case kDecoderPCM16Bswb32kHz:
+        case kDecoderG722_1C_24:
+        case kDecoderG722_1C_32:
+        case kDecoderG722_1C_48:
+            return 64;
+        case kDecoderISAC:
+        case kDecoderPCM16Bwb:
+        case kDecoderG722:
+        case kDecoderG729_1:
+        case kDecoderG722_1_16:
+        case kDecoderG722_1_24:
+        case kDecoderG722_1_32:
+        case kDecoderSPEEX_16:
+        case kDecoderAMRWB:
+        case kDecoderArbitrary:
+            return 32;
+        default:
+            return 16;
+    }
+}
+
 int WebRtcNetEQ_GetDefaultCodecSettings(const enum WebRtcNetEQDecoder *codecID,
-                                        int noOfCodecs, int *maxBytes, int *maxSlots)
+                                        int noOfCodecs, int decoded, int *maxBytes,
+                                        int *maxSlots)
 {
     int i;
     int ok = 0;
@@ -677,6 +710,16 @@ int WebRtcNetEQ_GetDefaultCodecSettings(const enum WebRtcNetEQDecoder *codecID,
             ok = CODEC_DB_UNKNOWN_CODEC;
         }
 
+        if (decoded && (codecBuffers > 0))
+        {
+            /*
+             * Decoded payloads: 210 ms of speech at the decoder sample rate, and
+             * one speech type word per slot.
+             */
+            codecBytes = 210 * WebRtcNetEQ_DecodedBytesPerMs(codecID[i])
+                + codecBuffers * sizeof(WebRtc_Word16);
+        }
+
         /* Update max variables */
         *maxBytes = WEBRTC_SPL_MAX((*maxBytes), codecBytes);
         *maxSlots = WEBRTC_SPL_MAX((*maxSlots), codecBuffers);
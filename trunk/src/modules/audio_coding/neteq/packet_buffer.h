@@ -189,6 +189,8 @@ WebRtc_Word32 WebRtcNetEQ_PacketBufferGetSize(const PacketBuf_t *bufferInst);
  * Input:
  *		- codecID	    : An array of codec types that will be used
  *      - noOfCodecs    : Number of codecs in array codecID
+ *      - decoded       : 1 if the buffer will hold decoded payloads
+ *                        (decode-on-receive mode), 0 otherwise
  *
  * Output:
  *		- maxBytes	    : Recommended buffer memory size in bytes
@@ -199,6 +201,7 @@ WebRtc_Word32 WebRtcNetEQ_PacketBufferGetSize(const PacketBuf_t *bufferInst);
  */
 
 int WebRtcNetEQ_GetDefaultCodecSettings(const enum WebRtcNetEQDecoder *codecID,
-                                        int noOfCodecs, int *maxBytes, int *maxSlots);
+                                        int noOfCodecs, int decoded, int *maxBytes,
+                                        int *maxSlots);
 
 #endif /* PACKET_BUFFER_H */
@@ -34,6 +34,7 @@ int WebRtcNetEQ_RecInInternal(MCUInst_t *MCU_inst, RTPPacket_t *RTPpacketInput,
     WebRtc_Word16 flushed = 0;
     WebRtc_Word16 codecPos;
     int curr_Codec;
+    CodecFuncInst_t decoder;
     WebRtc_Word16 isREDPayload = 0;
     WebRtc_Word32 temp_bufsize = MCU_inst->PacketBuffer_inst.numPacketsInBuffer;
 #ifdef NETEQ_RED_CODEC
@@ -69,6 +70,9 @@ int WebRtcNetEQ_RecInInternal(MCUInst_t *MCU_inst, RTPPacket_t *RTPpacketInput,
         /*Set MCU to update codec on next SignalMCU call */
         MCU_inst->new_codec = 1;
 
+        /* Re-initialize the decoder before decoding on receive */
+        MCU_inst->decodedCodec = -1;
+
         /* Reset timestamp scaling */
         MCU_inst->TSscalingInitialized = 0;
 
@@ -248,9 +252,29 @@ int WebRtcNetEQ_RecInInternal(MCUInst_t *MCU_inst, RTPPacket_t *RTPpacketInput,
                 MCU_inst->new_codec = 1;
             }
 
+            if (MCU_inst->decodeOnReceive)
+            {
+                /* Decode the payload here instead of in RecOut */
+                i_ok = WebRtcNetEQ_DbGetPtrs(&MCU_inst->codec_DB_inst,
+                    (enum WebRtcNetEQDecoder) curr_Codec, &decoder);
+                if ((i_ok < 0) || (decoder.funcDecode == NULL))
+                {
+                    return RECIN_UNKNOWNPAYLOAD;
+                }
+                if (MCU_inst->decodedCodec != curr_Codec)
+                {
+                    if (decoder.funcDecodeInit != NULL)
+                    {
+                        decoder.funcDecodeInit(decoder.codec_state);
+                    }
+                    MCU_inst->decodedCodec = curr_Codec;
+                }
+            }
+
             /* Parse the payload and insert it into the buffer */
             i_ok = WebRtcNetEQ_SplitAndInsertPayload(&RTPpacket[i_k],
-                &MCU_inst->PacketBuffer_inst, &MCU_inst->PayloadSplit_inst, &flushed);
+                &MCU_inst->PacketBuffer_inst, &MCU_inst->PayloadSplit_inst,
+                MCU_inst->decodeOnReceive ? &decoder : NULL, &flushed);
             if (i_ok < 0)
             {
                 return i_ok;
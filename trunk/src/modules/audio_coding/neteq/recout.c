@@ -133,6 +133,7 @@ int WebRtcNetEQ_RecOutInternal(DSPInst_t *inst, WebRtc_Word16 *pw16_outData,
     WebRtc_Word16 dtmfValue = -1;
     WebRtc_Word16 dtmfVolume = -1;
     int playDtmf = 0;
+    int decodedPayload = 0;
 #ifdef NETEQ_ATEVENT_DECODE
     int dtmfSwitch = 0;
 #endif
@@ -267,6 +268,12 @@ int WebRtcNetEQ_RecOutInternal(DSPInst_t *inst, WebRtc_Word16 *pw16_outData,
 
     blockPtr = &((inst->pw16_readAddress)[3]);
 
+    /*
+     * Check for decoded payload flag. The payloads were decoded in RecIn, and the
+     * decoder must not be used from here.
+     */
+    decodedPayload = ((inst->pw16_readAddress[0] & DSP_DECODED_PAYLOAD) != 0);
+
     /* Check for DTMF payload flag */
     if ((inst->pw16_readAddress[0] & DSP_DTMF_PAYLOAD) != 0)
     {
@@ -315,7 +322,7 @@ int WebRtcNetEQ_RecOutInternal(DSPInst_t *inst, WebRtc_Word16 *pw16_outData,
         blockLen = (((*blockPtr) & DSP_CODEC_MASK_RED_FLAG) + 1) >> 1;
         payloadLen = ((*blockPtr) & DSP_CODEC_MASK_RED_FLAG);
         blockPtr++;
-        if (inst->codec_ptr_inst.funcDecodeInit != NULL)
+        if ((inst->codec_ptr_inst.funcDecodeInit != NULL) && !decodedPayload)
         {
             inst->codec_ptr_inst.funcDecodeInit(inst->codec_ptr_inst.codec_state);
         }
@@ -338,7 +345,7 @@ int WebRtcNetEQ_RecOutInternal(DSPInst_t *inst, WebRtc_Word16 *pw16_outData,
     else if ((inst->pw16_readAddress[0] & 0x0f00) == DSP_CODEC_RESET)
     {
         /* Reset the current codec (but not DSP struct) */
-        if (inst->codec_ptr_inst.funcDecodeInit != NULL)
+        if ((inst->codec_ptr_inst.funcDecodeInit != NULL) && !decodedPayload)
         {
             inst->codec_ptr_inst.funcDecodeInit(inst->codec_ptr_inst.codec_state);
         }
@@ -357,7 +364,7 @@ int WebRtcNetEQ_RecOutInternal(DSPInst_t *inst, WebRtc_Word16 *pw16_outData,
     /* Add late packet? */
     if ((inst->pw16_readAddress[0] & 0x0f00) == DSP_CODEC_ADD_LATE_PKT)
     {
-        if (inst->codec_ptr_inst.funcAddLatePkt != NULL)
+        if ((inst->codec_ptr_inst.funcAddLatePkt != NULL) && !decodedPayload)
         {
             /* Only do this if the codec has support for Add Late Pkt */
             inst->codec_ptr_inst.funcAddLatePkt(inst->codec_ptr_inst.codec_state, blockPtr,
@@ -374,7 +381,8 @@ int WebRtcNetEQ_RecOutInternal(DSPInst_t *inst, WebRtc_Word16 *pw16_outData,
         == DSP_INSTR_MERGE) || (instr == DSP_INSTR_PREEMPTIVE_EXPAND))
     {
         /* Do we need to update codec-internal PLC state? */
-        if ((instr == DSP_INSTR_MERGE) && (inst->codec_ptr_inst.funcDecodePLC != NULL))
+        if ((instr == DSP_INSTR_MERGE) && (inst->codec_ptr_inst.funcDecodePLC != NULL)
+            && !decodedPayload)
         {
             len = 0;
             len = inst->codec_ptr_inst.funcDecodePLC(inst->codec_ptr_inst.codec_state,
@@ -396,7 +404,18 @@ int WebRtcNetEQ_RecOutInternal(DSPInst_t *inst, WebRtc_Word16 *pw16_outData,
                      * the most significant bit of *(blockPtr - 1) is a flag if set to 1
                      * indicates that the following payload is the redundant payload.
                      */
-                    if (((*(blockPtr - 1) & DSP_CODEC_RED_FLAG) != 0)
+                    if (decodedPayload)
+                    {
+                        /* Already decoded; copy speech type and samples */
+                        speechType = blockPtr[0];
+                        dec_Len = (payloadLen >> 1) - 1;
+                        if ((dec_Len > 0) && (len + dec_Len <= NETEQ_MAX_FRAME_SIZE))
+                        {
+                            WEBRTC_SPL_MEMCPY_W16(&pw16_decoded_buffer[len], &blockPtr[1],
+                                dec_Len);
+                        }
+                    }
+                    else if (((*(blockPtr - 1) & DSP_CODEC_RED_FLAG) != 0)
                         && (inst->codec_ptr_inst.funcDecodeRCU != NULL))
                     {
                         dec_Len = inst->codec_ptr_inst.funcDecodeRCU(
@@ -912,7 +931,7 @@ int WebRtcNetEQ_RecOutInternal(DSPInst_t *inst, WebRtc_Word16 *pw16_outData,
              * do internal CNG.
              */
             len = 0;
-            if (inst->codec_ptr_inst.funcDecode != NULL && !BGNonly)
+            if (inst->codec_ptr_inst.funcDecode != NULL && !BGNonly && !decodedPayload)
             {
                 len = inst->codec_ptr_inst.funcDecode(inst->codec_ptr_inst.codec_state,
                     blockPtr, 0, pw16_decoded_buffer, &speechType);
@@ -1029,7 +1048,7 @@ int WebRtcNetEQ_RecOutInternal(DSPInst_t *inst, WebRtc_Word16 *pw16_outData,
 #endif
 
         case DSP_INSTR_DO_ALTERNATIVE_PLC:
-            if (inst->codec_ptr_inst.funcDecodePLC != 0)
+            if ((inst->codec_ptr_inst.funcDecodePLC != 0) && !decodedPayload)
             {
                 len = inst->codec_ptr_inst.funcDecodePLC(inst->codec_ptr_inst.codec_state,
                     pw16_NetEqAlgorithm_buffer, 1);
@@ -1043,7 +1062,7 @@ int WebRtcNetEQ_RecOutInternal(DSPInst_t *inst, WebRtc_Word16 *pw16_outData,
             inst->ExpandInst.w16_consecExp = 0;
             break;
         case DSP_INSTR_DO_ALTERNATIVE_PLC_INC_TS:
-            if (inst->codec_ptr_inst.funcDecodePLC != 0)
+            if ((inst->codec_ptr_inst.funcDecodePLC != 0) && !decodedPayload)
             {
                 len = inst->codec_ptr_inst.funcDecodePLC(inst->codec_ptr_inst.codec_state,
                     pw16_NetEqAlgorithm_buffer, 1);
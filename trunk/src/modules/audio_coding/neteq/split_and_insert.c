@@ -18,10 +18,80 @@
 
 #include "signal_processing_library.h"
 
+#include "neteq_defines.h"
 #include "neteq_error_codes.h"
 
+/*
+ * Insert one part of a payload into the packet buffer. If decoder is non-NULL,
+ * the part is decoded first, and the speech type followed by the decoded
+ * samples is inserted instead of the encoded data.
+ */
+static int WebRtcNetEQ_InsertPart(PacketBuf_t *Buffer_inst, RTPPacket_t *packet,
+                                  const CodecFuncInst_t *decoder, WebRtc_Word16 *flushed)
+{
+    WebRtc_Word16 pw16_encoded[NETEQ_MAX_FRAME_SIZE];
+    WebRtc_Word16 pw16_decoded[NETEQ_MAX_FRAME_SIZE + 1];
+    RTPPacket_t decoded_packet;
+    WebRtc_Word16 w16_len;
+    int i;
+
+    if (decoder == NULL)
+    {
+        return WebRtcNetEQ_PacketBufferInsert(Buffer_inst, packet, flushed);
+    }
+
+    if ((packet->payloadLen < 0) || (packet->payloadLen > (NETEQ_MAX_FRAME_SIZE << 1)))
+    {
+        return RECIN_DECODE_ERROR;
+    }
+
+    /* Get a 16-bit aligned copy of the payload, since decoders may modify it */
+    if (packet->starts_byte1 == 0)
+    {
+        WEBRTC_SPL_MEMCPY_W16(pw16_encoded, packet->payload, (packet->payloadLen + 1) >> 1);
+    }
+    else
+    {
+        for (i = 0; i < packet->payloadLen; i++)
+        {
+            WEBRTC_SPL_SET_BYTE(pw16_encoded, WEBRTC_SPL_GET_BYTE(packet->payload, (i + 1)), i);
+        }
+    }
+
+    /* Redundant payloads use the RCU decoder, if the codec has one */
+    pw16_decoded[0] = 1; /* speech */
+    if ((packet->rcuPlCntr > 0) && (decoder->funcDecodeRCU != NULL))
+    {
+        w16_len = decoder->funcDecodeRCU(decoder->codec_state, pw16_encoded,
+            packet->payloadLen, &pw16_decoded[1], &pw16_decoded[0]);
+    }
+    else
+    {
+        w16_len = decoder->funcDecode(decoder->codec_state, pw16_encoded,
+            packet->payloadLen, &pw16_decoded[1], &pw16_decoded[0]);
+    }
+    if ((w16_len < 0) || (w16_len > NETEQ_MAX_FRAME_SIZE))
+    {
+        /* Drop the packet and re-initialize the decoder */
+        if (decoder->funcDecodeInit != NULL)
+        {
+            decoder->funcDecodeInit(decoder->codec_state);
+        }
+        return RECIN_DECODE_ERROR;
+    }
+
+    WEBRTC_SPL_MEMCPY_W8(&decoded_packet, packet, sizeof(RTPPacket_t));
+    decoded_packet.payload = pw16_decoded;
+    decoded_packet.payloadLen = (w16_len + 1) << 1;
+    decoded_packet.starts_byte1 = 0;
+
+    return WebRtcNetEQ_PacketBufferInsert(Buffer_inst, &decoded_packet, flushed);
+}
+
 int WebRtcNetEQ_SplitAndInsertPayload(RTPPacket_t *packet, PacketBuf_t *Buffer_inst,
-                                      SplitInfo_t *split_inst, WebRtc_Word16 *flushed)
+                                      SplitInfo_t *split_inst,
+                                      const CodecFuncInst_t *decoder,
+                                      WebRtc_Word16 *flushed)
 {
 
     int i_ok;
@@ -41,11 +111,11 @@ int WebRtcNetEQ_SplitAndInsertPayload(RTPPacket_t *packet, PacketBuf_t *Buffer_i
     if (split_inst->deltaBytes == NO_SPLIT)
     {
         /* Not splittable codec */
-        i_ok = WebRtcNetEQ_PacketBufferInsert(Buffer_inst, packet, &localFlushed);
+        i_ok = WebRtcNetEQ_InsertPart(Buffer_inst, packet, decoder, &localFlushed);
         *flushed |= localFlushed;
         if (i_ok < 0)
         {
-            return PBUFFER_INSERT_ERROR5;
+            return (i_ok == RECIN_DECODE_ERROR) ? i_ok : PBUFFER_INSERT_ERROR5;
         }
     }
     else if (split_inst->deltaBytes < -10)
@@ -76,7 +146,7 @@ int WebRtcNetEQ_SplitAndInsertPayload(RTPPacket_t *packet, PacketBuf_t *Buffer_i
         while (len >= (2 * split_size))
         {
             /* insert every chunk */
-            i_ok = WebRtcNetEQ_PacketBufferInsert(Buffer_inst, &temp_packet, &localFlushed);
+            i_ok = WebRtcNetEQ_InsertPart(Buffer_inst, &temp_packet, decoder, &localFlushed);
             *flushed |= localFlushed;
             temp_packet.timeStamp += ((2 * split_size) >> split_inst->deltaTime);
             i++;
@@ -86,17 +156,17 @@ int WebRtcNetEQ_SplitAndInsertPayload(RTPPacket_t *packet, PacketBuf_t *Buffer_i
             len -= split_size;
             if (i_ok < 0)
             {
-                return PBUFFER_INSERT_ERROR1;
+                return (i_ok == RECIN_DECODE_ERROR) ? i_ok : PBUFFER_INSERT_ERROR1;
             }
         }
 
         /* Insert the rest */
         temp_packet.payloadLen = len;
-        i_ok = WebRtcNetEQ_PacketBufferInsert(Buffer_inst, &temp_packet, &localFlushed);
+        i_ok = WebRtcNetEQ_InsertPart(Buffer_inst, &temp_packet, decoder, &localFlushed);
         *flushed |= localFlushed;
         if (i_ok < 0)
         {
-            return PBUFFER_INSERT_ERROR2;
+            return (i_ok == RECIN_DECODE_ERROR) ? i_ok : PBUFFER_INSERT_ERROR2;
         }
     }
     else
@@ -108,7 +178,7 @@ int WebRtcNetEQ_SplitAndInsertPayload(RTPPacket_t *packet, PacketBuf_t *Buffer_i
         {
 
             temp_packet.payloadLen = split_inst->deltaBytes;
-            i_ok = WebRtcNetEQ_PacketBufferInsert(Buffer_inst, &temp_packet, &localFlushed);
+            i_ok = WebRtcNetEQ_InsertPart(Buffer_inst, &temp_packet, decoder, &localFlushed);
             *flushed |= localFlushed;
             i++;
             temp_packet.payload = &(pw16_startPayload[(i * split_inst->deltaBytes) >> 1]);
@@ -118,7 +188,7 @@ int WebRtcNetEQ_SplitAndInsertPayload(RTPPacket_t *packet, PacketBuf_t *Buffer_i
 
             if (i_ok < 0)
             {
-                return PBUFFER_INSERT_ERROR3;
+                return (i_ok == RECIN_DECODE_ERROR) ? i_ok : PBUFFER_INSERT_ERROR3;
             }
             len -= split_inst->deltaBytes;
 
@@ -127,11 +197,11 @@ int WebRtcNetEQ_SplitAndInsertPayload(RTPPacket_t *packet, PacketBuf_t *Buffer_i
         {
             /* Must be a either an error or a SID frame at the end of the packet. */
             temp_packet.payloadLen = len;
-            i_ok = WebRtcNetEQ_PacketBufferInsert(Buffer_inst, &temp_packet, &localFlushed);
+            i_ok = WebRtcNetEQ_InsertPart(Buffer_inst, &temp_packet, decoder, &localFlushed);
             *flushed |= localFlushed;
             if (i_ok < 0)
             {
-                return PBUFFER_INSERT_ERROR4;
+                return (i_ok == RECIN_DECODE_ERROR) ? i_ok : PBUFFER_INSERT_ERROR4;
             }
         }
     }
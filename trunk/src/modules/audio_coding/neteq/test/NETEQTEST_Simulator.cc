@@ -0,0 +1,454 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "NETEQTEST_Simulator.h"
+
+#include <ctype.h>
+#include <string.h>
+#include <vector>
+
+#include "webrtc_neteq_internal.h"
+
+#include "NETEQTEST_CodecClass.h"
+#include "NETEQTEST_NetEQClass.h"
+#include "NETEQTEST_RTPpacket.h"
+
+namespace {
+
+struct CodecName
+{
+    const char *name;
+    enum WebRtcNetEQDecoder codec;
+    WebRtc_UWord16 fs;
+};
+
+// Codec names as used in ptypes.txt.
+const CodecName kCodecNames[] = {
+#ifdef CODEC_G711
+    {"pcmu", kDecoderPCMu, 8000},
+    {"pcma", kDecoderPCMa, 8000},
+#endif
+#ifdef CODEC_ILBC
+    {"ilbc", kDecoderILBC, 8000},
+#endif
+#ifdef CODEC_ISAC
+    {"isac", kDecoderISAC, 16000},
+#endif
+#ifdef CODEC_ISAC_SWB
+    {"isacswb", kDecoderISACswb, 32000},
+#endif
+#ifdef CODEC_G722
+    {"g722", kDecoderG722, 16000},
+#endif
+#ifdef CODEC_PCM16B
+    {"pcm16b", kDecoderPCM16B, 8000},
+#endif
+#ifdef CODEC_PCM16B_WB
+    {"pcm16b_wb", kDecoderPCM16Bwb, 16000},
+#endif
+#ifdef CODEC_PCM16B_32KHZ
+    {"pcm16b_swb32khz", kDecoderPCM16Bswb32kHz, 32000},
+#endif
+#ifdef CODEC_PCM16B_48KHZ
+    {"pcm16b_swb48khz", kDecoderPCM16Bswb48kHz, 48000},
+#endif
+#ifdef CODEC_CNGCODEC8
+    {"cn", kDecoderCNG, 8000},
+#endif
+#ifdef CODEC_CNGCODEC16
+    {"cn_wb", kDecoderCNG, 16000},
+#endif
+#ifdef CODEC_CNGCODEC32
+    {"cn_swb32", kDecoderCNG, 32000},
+#endif
+#ifdef CODEC_CNGCODEC48
+    {"cn_swb48", kDecoderCNG, 48000},
+#endif
+#ifdef CODEC_ATEVENT_DECODE
+    {"avt", kDecoderAVT, 8000},
+#endif
+#ifdef CODEC_RED
+    {"red", kDecoderRED, 8000},
+#endif
+    {NULL, kDecoderReservedStart, 0}
+};
+
+const int kOutputBufferSize = 640 * 2;
+
+// Converts a Q14 fraction to percent.
+double Q14ToPercent(WebRtc_UWord16 value)
+{
+    return (100.0 * value) / (1 << 14);
+}
+
+bool IsSpeechCodec(enum WebRtcNetEQDecoder codec)
+{
+    return (codec != kDecoderRED && codec != kDecoderAVT &&
+            codec != kDecoderCNG);
+}
+
+} // namespace
+
+
+NETEQTEST_SimulationStats::NETEQTEST_SimulationStats()
+:
+error(0),
+durationMs(0),
+packets(0),
+recInErrors(0),
+intervals(0),
+avgExpandRate(0.0),
+maxExpandRate(0.0),
+avgAccelerateRate(0.0),
+maxAccelerateRate(0.0),
+avgPreemptiveRate(0.0),
+avgPacketLossRate(0.0),
+avgDiscardRate(0.0),
+avgBufferSizeMs(0.0),
+maxBufferSizeMs(0),
+avgPreferredBufferSizeMs(0.0)
+{
+    memset(&rtcp, 0, sizeof(rtcp));
+}
+
+
+NETEQTEST_Simulator::NETEQTEST_Simulator(int statsIntervalMs)
+:
+_statsIntervalMs(statsIntervalMs > 10 ? statsIntervalMs : 10)
+{
+}
+
+
+int NETEQTEST_Simulator::addPayloadType(const char *codecName, int pt)
+{
+    if (codecName == NULL || pt < 0 || pt > 127)
+    {
+        return -1;
+    }
+
+    for (const CodecName *it = kCodecNames; it->name != NULL; it++)
+    {
+        if (strcmp(it->name, codecName) == 0)
+        {
+            PayloadInfo info;
+            info.codec = it->codec;
+            info.fs = it->fs;
+            _payloadTypes[static_cast<WebRtc_UWord8>(pt)] = info;
+            return 0;
+        }
+    }
+
+    return -1;
+}
+
+
+int NETEQTEST_Simulator::readPtypeFile(const char *fileName)
+{
+    FILE *ptypeFile = fopen(fileName, "rt");
+    if (ptypeFile == NULL)
+    {
+        return -1;
+    }
+
+    char codec[100];
+    int pt;
+    int ret = 0;
+    while (fscanf(ptypeFile, "%99s %i\n", codec, &pt) == 2)
+    {
+        // A negative payload type disables the codec, and a name that does
+        // not start with a letter is commented out.
+        if (pt < 0 || !isalpha(codec[0]))
+        {
+            continue;
+        }
+        if (addPayloadType(codec, pt) != 0)
+        {
+            fprintf(stderr, "Unsupported codec %s\n", codec);
+            ret = -1;
+        }
+    }
+
+    fclose(ptypeFile);
+    return ret;
+}
+
+
+NETEQTEST_Decoder * NETEQTEST_Simulator::createDecoder(
+    enum WebRtcNetEQDecoder codec, WebRtc_UWord8 pt, WebRtc_UWord16 fs)
+{
+    switch (codec)
+    {
+#ifdef CODEC_G711
+    case kDecoderPCMu:
+        return new decoder_PCMU(pt);
+    case kDecoderPCMa:
+        return new decoder_PCMA(pt);
+#endif
+#ifdef CODEC_ILBC
+    case kDecoderILBC:
+        return new decoder_ILBC(pt);
+#endif
+#ifdef CODEC_ISAC
+    case kDecoderISAC:
+        return new decoder_iSAC(pt);
+#endif
+#ifdef CODEC_ISAC_SWB
+    case kDecoderISACswb:
+        return new decoder_iSACSWB(pt);
+#endif
+#ifdef CODEC_G722
+    case kDecoderG722:
+        return new decoder_G722(pt);
+#endif
+#ifdef CODEC_PCM16B
+    case kDecoderPCM16B:
+        return new decoder_PCM16B_NB(pt);
+#endif
+#ifdef CODEC_PCM16B_WB
+    case kDecoderPCM16Bwb:
+        return new decoder_PCM16B_WB(pt);
+#endif
+#ifdef CODEC_PCM16B_32KHZ
+    case kDecoderPCM16Bswb32kHz:
+        return new decoder_PCM16B_SWB32(pt);
+#endif
+#ifdef CODEC_PCM16B_48KHZ
+    case kDecoderPCM16Bswb48kHz:
+        return new decoder_PCM16B_SWB48(pt);
+#endif
+#if (defined(CODEC_CNGCODEC8) || defined(CODEC_CNGCODEC16) || \
+    defined(CODEC_CNGCODEC32) || defined(CODEC_CNGCODEC48))
+    case kDecoderCNG:
+        return new decoder_CNG(pt, fs);
+#endif
+#ifdef CODEC_ATEVENT_DECODE
+    case kDecoderAVT:
+        return new decoder_AVT(pt);
+#endif
+#ifdef CODEC_RED
+    case kDecoderRED:
+        return new decoder_RED(pt);
+#endif
+    default:
+        return NULL;
+    }
+}
+
+
+int NETEQTEST_Simulator::run(const char *rtpFile,
+                             NETEQTEST_SimulationStats &stats) const
+{
+    stats = NETEQTEST_SimulationStats();
+    stats.error = -1;
+
+    if (_payloadTypes.empty())
+    {
+        return -1;
+    }
+
+    FILE *inFile = fopen(rtpFile, "rb");
+    if (inFile == NULL)
+    {
+        return -1;
+    }
+    if (NETEQTEST_RTPpacket::skipFileHeader(inFile) != 0)
+    {
+        fclose(inFile);
+        return -1;
+    }
+
+    // Use the sample rate of the first speech packet.
+    NETEQTEST_RTPpacket rtp;
+    WebRtc_UWord16 fs = 8000;
+    long firstPacketPos = ftell(inFile);
+    while (rtp.readFromFile(inFile) >= 0)
+    {
+        std::map<WebRtc_UWord8, PayloadInfo>::const_iterator it =
+            _payloadTypes.find(rtp.payloadType());
+        if (it != _payloadTypes.end() && IsSpeechCodec(it->second.codec))
+        {
+            fs = it->second.fs;
+            break;
+        }
+    }
+    fseek(inFile, firstPacketPos, SEEK_SET);
+
+    std::vector<enum WebRtcNetEQDecoder> usedCodec;
+    std::map<WebRtc_UWord8, PayloadInfo>::const_iterator it;
+    for (it = _payloadTypes.begin(); it != _payloadTypes.end(); it++)
+    {
+        usedCodec.push_back(it->second.codec);
+    }
+
+    NETEQTEST_NetEQClass neteq(&usedCodec[0], static_cast<int>(usedCodec.size()),
+                               fs, kTCPLargeJitter);
+    if (neteq.instance() == NULL)
+    {
+        fclose(inFile);
+        return -1;
+    }
+
+    std::vector<NETEQTEST_Decoder *> decoders;
+    int err = 0;
+    for (it = _payloadTypes.begin(); it != _payloadTypes.end() && !err; it++)
+    {
+        NETEQTEST_Decoder *dec = createDecoder(it->second.codec, it->first,
+                                               it->second.fs);
+        if (dec == NULL)
+        {
+            err = -1;
+            break;
+        }
+        decoders.push_back(dec);
+        err = dec->loadToNetEQ(neteq);
+    }
+    WebRtcNetEQ_SetAVTPlayout(neteq.instance(), 1);
+
+    rtp.readFromFile(inFile);
+    if (err || rtp.dataLen() < 0)
+    {
+        for (size_t i = 0; i < decoders.size(); i++)
+        {
+            delete decoders[i];
+        }
+        fclose(inFile);
+        return -1;
+    }
+
+    WebRtc_Word16 outData[kOutputBufferSize];
+    WebRtc_UWord32 simClock = rtp.time(); // start with the first packet
+    const WebRtc_UWord32 startClock = simClock;
+    WebRtc_UWord32 lastStatsClock = simClock;
+    WebRtc_UWord32 statsMs = 0;
+    double expandSum = 0.0, accelerateSum = 0.0, preemptiveSum = 0.0;
+    double lossSum = 0.0, discardSum = 0.0;
+    double bufferSum = 0.0, preferredBufferSum = 0.0;
+
+    // Run until the last packet has been inserted, and query the statistics
+    // once more for the last, possibly shorter, interval.
+    bool done = false;
+    while (!done)
+    {
+        while (simClock >= rtp.time() && rtp.dataLen() >= 0)
+        {
+            if (rtp.dataLen() > 0)
+            {
+                stats.packets++;
+                if (neteq.recIn(rtp) != 0)
+                {
+                    stats.recInErrors++;
+                }
+            }
+            rtp.readFromFile(inFile);
+        }
+        done = (rtp.dataLen() < 0);
+
+        if ((simClock % 10) == 0)
+        {
+            neteq.recOut(outData);
+        }
+
+        const WebRtc_UWord32 intervalMs = simClock - lastStatsClock;
+        if (intervalMs >= static_cast<WebRtc_UWord32>(_statsIntervalMs) ||
+            (done && intervalMs > 0))
+        {
+            WebRtcNetEQ_NetworkStatistics netStats;
+            if (WebRtcNetEQ_GetNetworkStatistics(neteq.instance(),
+                                                 &netStats) == 0)
+            {
+                const double expandRate =
+                    Q14ToPercent(netStats.currentExpandRate);
+                const double accelerateRate =
+                    Q14ToPercent(netStats.currentAccelerateRate);
+
+                expandSum += expandRate * intervalMs;
+                accelerateSum += accelerateRate * intervalMs;
+                preemptiveSum +=
+                    Q14ToPercent(netStats.currentPreemptiveRate) * intervalMs;
+                lossSum +=
+                    Q14ToPercent(netStats.currentPacketLossRate) * intervalMs;
+                discardSum +=
+                    Q14ToPercent(netStats.currentDiscardRate) * intervalMs;
+                bufferSum +=
+                    static_cast<double>(netStats.currentBufferSize) * intervalMs;
+                preferredBufferSum +=
+                    static_cast<double>(netStats.preferredBufferSize) *
+                    intervalMs;
+                statsMs += intervalMs;
+                stats.intervals++;
+
+                if (expandRate > stats.maxExpandRate)
+                {
+                    stats.maxExpandRate = expandRate;
+                }
+                if (accelerateRate > stats.maxAccelerateRate)
+                {
+                    stats.maxAccelerateRate = accelerateRate;
+                }
+                if (netStats.currentBufferSize > stats.maxBufferSizeMs)
+                {
+                    stats.maxBufferSizeMs = netStats.currentBufferSize;
+                }
+            }
+            lastStatsClock = simClock;
+        }
+
+        simClock++;
+    }
+
+    stats.durationMs = simClock - startClock;
+    if (statsMs > 0)
+    {
+        stats.avgExpandRate = expandSum / statsMs;
+        stats.avgAccelerateRate = accelerateSum / statsMs;
+        stats.avgPreemptiveRate = preemptiveSum / statsMs;
+        stats.avgPacketLossRate = lossSum / statsMs;
+        stats.avgDiscardRate = discardSum / statsMs;
+        stats.avgBufferSizeMs = bufferSum / statsMs;
+        stats.avgPreferredBufferSizeMs = preferredBufferSum / statsMs;
+    }
+    WebRtcNetEQ_GetRTCPStats(neteq.instance(), &stats.rtcp);
+
+    for (size_t i = 0; i < decoders.size(); i++)
+    {
+        delete decoders[i];
+    }
+    fclose(inFile);
+
+    stats.error = 0;
+    return 0;
+}
+
+
+void NETEQTEST_Simulator::printCsvHeader(FILE *fp)
+{
+    fprintf(fp, "file,error,duration_ms,packets,recin_errors,"
+        "expand_rate_avg,expand_rate_max,accelerate_rate_avg,"
+        "accelerate_rate_max,preemptive_rate_avg,packet_loss_rate_avg,"
+        "discard_rate_avg,buffer_ms_avg,buffer_ms_max,"
+        "preferred_buffer_ms_avg,cum_lost,jitter\n");
+}
+
+
+void NETEQTEST_Simulator::printCsv(FILE *fp, const char *rtpFile,
+                                   const NETEQTEST_SimulationStats &stats)
+{
+    fprintf(fp, "%s,%d,%u,%u,%u,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,"
+        "%.1f,%u,%.1f,%u,%u\n",
+        rtpFile, stats.error, stats.durationMs, stats.packets,
+        stats.recInErrors, stats.avgExpandRate, stats.maxExpandRate,
+        stats.avgAccelerateRate, stats.maxAccelerateRate,
+        stats.avgPreemptiveRate, stats.avgPacketLossRate,
+        stats.avgDiscardRate, stats.avgBufferSizeMs,
+        static_cast<unsigned int>(stats.maxBufferSizeMs),
+        stats.avgPreferredBufferSizeMs,
+        static_cast<unsigned int>(stats.rtcp.cum_lost),
+        static_cast<unsigned int>(stats.rtcp.jitter));
+}
@@ -0,0 +1,94 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef NETEQTEST_SIMULATOR_H
+#define NETEQTEST_SIMULATOR_H
+
+#include <stdio.h>
+#include <map>
+
+#include "typedefs.h"
+#include "webrtc_neteq.h"
+
+class NETEQTEST_Decoder;
+
+// Summary of one simulated call. Rates are in percent and delays in ms. The
+// averages are taken over the statistics intervals of the call, weighted by
+// interval length.
+struct NETEQTEST_SimulationStats
+{
+    NETEQTEST_SimulationStats();
+
+    int error;                      // 0 if the file was simulated
+    WebRtc_UWord32 durationMs;      // simulated call duration
+    WebRtc_UWord32 packets;         // packets inserted with RecIn
+    WebRtc_UWord32 recInErrors;     // packets rejected by RecIn
+    WebRtc_UWord32 intervals;       // number of statistics queries
+    double avgExpandRate;
+    double maxExpandRate;
+    double avgAccelerateRate;
+    double maxAccelerateRate;
+    double avgPreemptiveRate;
+    double avgPacketLossRate;
+    double avgDiscardRate;
+    double avgBufferSizeMs;
+    WebRtc_UWord16 maxBufferSizeMs;
+    double avgPreferredBufferSizeMs;
+    WebRtcNetEQ_RTCPStat rtcp;
+};
+
+// Runs the NetEQ RecIn/RecOut loop for an rtpdump file on a simulated clock.
+// Packets are inserted at their arrival times and audio is pulled every 10 ms,
+// as in NetEqRTPplay, but without writing output or waiting for real time.
+//
+// The payload type map is set up before the first call to run() and is not
+// modified by it. Each call creates its own NetEQ instance and decoders, so
+// one simulator may run several files concurrently from different threads.
+class NETEQTEST_Simulator
+{
+public:
+    NETEQTEST_Simulator(int statsIntervalMs = 1000);
+    ~NETEQTEST_Simulator() {};
+
+    // Maps |pt| to the codec named |codecName|, using the names of ptypes.txt.
+    // Returns -1 if the codec is unknown or not compiled in.
+    int addPayloadType(const char *codecName, int pt);
+
+    // Reads "name payloadtype" lines as in NetEqRTPplay's ptypes.txt. Lines
+    // that do not start with a letter are comments. Stereo codecs are not
+    // supported. Returns -1 on an unknown codec or if the file cannot be read.
+    int readPtypeFile(const char *fileName);
+
+    // Simulates the call in |rtpFile| and fills in |stats|. Returns 0 on
+    // success and -1 on failure, in which case |stats.error| is also set.
+    int run(const char *rtpFile, NETEQTEST_SimulationStats &stats) const;
+
+    // Writes |stats| for |rtpFile| as one line of comma-separated values, in
+    // the column order of printCsvHeader().
+    static void printCsvHeader(FILE *fp);
+    static void printCsv(FILE *fp, const char *rtpFile,
+                         const NETEQTEST_SimulationStats &stats);
+
+private:
+    struct PayloadInfo
+    {
+        enum WebRtcNetEQDecoder codec;
+        WebRtc_UWord16 fs;
+    };
+
+    static NETEQTEST_Decoder * createDecoder(enum WebRtcNetEQDecoder codec,
+                                             WebRtc_UWord8 pt,
+                                             WebRtc_UWord16 fs);
+
+    std::map<WebRtc_UWord8, PayloadInfo> _payloadTypes;
+    int _statsIntervalMs;
+};
+
+#endif //NETEQTEST_SIMULATOR_H
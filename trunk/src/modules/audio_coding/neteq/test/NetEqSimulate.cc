@@ -0,0 +1,216 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Simulates NetEQ for a batch of rtpdump files, faster than real time and with
+// one file per worker thread, and prints the network statistics of each file
+// as one comma-separated line on stdout.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "critical_section_wrapper.h"
+#include "event_wrapper.h"
+#include "scoped_ptr.h"
+#include "thread_wrapper.h"
+
+#include "NETEQTEST_Simulator.h"
+
+using webrtc::CriticalSectionScoped;
+using webrtc::CriticalSectionWrapper;
+using webrtc::EventWrapper;
+using webrtc::ThreadWrapper;
+
+namespace {
+
+const int kMaxThreads = 64;
+
+// Work queue shared by the worker threads. Each call to Process() simulates
+// the next file in the queue.
+class SimulationQueue
+{
+public:
+    SimulationQueue(const NETEQTEST_Simulator &simulator,
+                    const std::vector<const char *> &files)
+        : _simulator(simulator),
+          _files(files),
+          _stats(files.size()),
+          _crit(CriticalSectionWrapper::CreateCriticalSection()),
+          _doneEvent(EventWrapper::Create()),
+          _next(0),
+          _done(0)
+    {
+    }
+
+    static bool Run(void *obj)
+    {
+        return static_cast<SimulationQueue *>(obj)->Process();
+    }
+
+    // Blocks until all files have been simulated.
+    void WaitForAll()
+    {
+        while (!AllDone())
+        {
+            _doneEvent->Wait(100);
+        }
+    }
+
+    const NETEQTEST_SimulationStats & stats(size_t i) const
+    {
+        return _stats[i];
+    }
+
+private:
+    bool Process()
+    {
+        size_t i;
+        {
+            CriticalSectionScoped lock(*_crit);
+            if (_next == _files.size())
+            {
+                return false;
+            }
+            i = _next++;
+        }
+
+        if (_simulator.run(_files[i], _stats[i]) != 0)
+        {
+            fprintf(stderr, "Could not simulate %s\n", _files[i]);
+        }
+
+        CriticalSectionScoped lock(*_crit);
+        if (++_done == _files.size())
+        {
+            _doneEvent->Set();
+        }
+        return true;
+    }
+
+    bool AllDone()
+    {
+        CriticalSectionScoped lock(*_crit);
+        return (_done == _files.size());
+    }
+
+    const NETEQTEST_Simulator &_simulator;
+    const std::vector<const char *> &_files;
+    std::vector<NETEQTEST_SimulationStats> _stats;
+    webrtc::scoped_ptr<CriticalSectionWrapper> _crit;
+    webrtc::scoped_ptr<EventWrapper> _doneEvent;
+    size_t _next;
+    size_t _done;
+};
+
+void PrintUsage(const char *name)
+{
+    printf("Usage: %s [options] file1.rtp [file2.rtp ...]\n", name);
+    printf("Options:\n");
+    printf("  -ptypes <file>   payload type file (default ptypes.txt)\n");
+    printf("  -threads <n>     number of worker threads (default 1)\n");
+    printf("  -interval <ms>   statistics interval (default 1000)\n");
+}
+
+} // namespace
+
+
+int main(int argc, char* argv[])
+{
+    const char *ptypeFile = "ptypes.txt";
+    int numThreads = 1;
+    int statsIntervalMs = 1000;
+    std::vector<const char *> files;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-ptypes") == 0 && i + 1 < argc)
+        {
+            ptypeFile = argv[++i];
+        }
+        else if (strcmp(argv[i], "-threads") == 0 && i + 1 < argc)
+        {
+            numThreads = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-interval") == 0 && i + 1 < argc)
+        {
+            statsIntervalMs = atoi(argv[++i]);
+        }
+        else if (argv[i][0] == '-')
+        {
+            PrintUsage(argv[0]);
+            return -1;
+        }
+        else
+        {
+            files.push_back(argv[i]);
+        }
+    }
+
+    if (files.empty() || numThreads < 1 || numThreads > kMaxThreads)
+    {
+        PrintUsage(argv[0]);
+        return -1;
+    }
+
+    NETEQTEST_Simulator simulator(statsIntervalMs);
+    if (simulator.readPtypeFile(ptypeFile) != 0)
+    {
+        fprintf(stderr, "Could not read payload types from %s\n", ptypeFile);
+        return -1;
+    }
+
+    SimulationQueue queue(simulator, files);
+    if (numThreads > static_cast<int>(files.size()))
+    {
+        numThreads = static_cast<int>(files.size());
+    }
+
+    std::vector<ThreadWrapper *> threads;
+    for (int i = 0; i < numThreads; i++)
+    {
+        ThreadWrapper *thread = ThreadWrapper::CreateThread(
+            SimulationQueue::Run, &queue, webrtc::kNormalPriority,
+            "NetEqSimulate");
+        unsigned int id = 0;
+        if (thread == NULL || !thread->Start(id))
+        {
+            fprintf(stderr, "Could not start worker thread\n");
+            delete thread;
+            break;
+        }
+        threads.push_back(thread);
+    }
+    if (threads.empty())
+    {
+        // Simulate on this thread instead.
+        while (SimulationQueue::Run(&queue)) {}
+    }
+
+    queue.WaitForAll();
+    for (size_t i = 0; i < threads.size(); i++)
+    {
+        threads[i]->Stop();
+        delete threads[i];
+    }
+
+    int ret = 0;
+    NETEQTEST_Simulator::printCsvHeader(stdout);
+    for (size_t i = 0; i < files.size(); i++)
+    {
+        NETEQTEST_Simulator::printCsv(stdout, files[i], queue.stats(i));
+        if (queue.stats(i).error != 0)
+        {
+            ret = -1;
+        }
+    }
+
+    return ret;
+}
@@ -168,6 +168,11 @@ int WebRtcNetEQ_GetErrorName(int errorCode, WebRtc_Word8 *errorName, int maxStrL
             WebRtcNetEQ_strncpy(errorName, maxStrLen, "RECIN_BUFFERINSERT_ERROR", maxStrLen);
             break;
         }
+        case 3004:
+        {
+            WebRtcNetEQ_strncpy(errorName, maxStrLen, "RECIN_DECODE_ERROR", maxStrLen);
+            break;
+        }
         case 4001:
         {
             WebRtcNetEQ_strncpy(errorName, maxStrLen, "PBUFFER_INIT_ERROR", maxStrLen);
@@ -324,7 +329,8 @@ int WebRtcNetEQ_GetRecommendedBufferSize(void *inst, const enum WebRtcNetEQDecod
     if (NetEqMainInst == NULL) return (-1);
     *MaxNoOfPackets = 0;
     *sizeinbytes = 0;
-    ok = WebRtcNetEQ_GetDefaultCodecSettings(codec, noOfCodecs, sizeinbytes, MaxNoOfPackets);
+    ok = WebRtcNetEQ_GetDefaultCodecSettings(codec, noOfCodecs,
+        NetEqMainInst->MCUinst.decodeOnReceive, sizeinbytes, MaxNoOfPackets);
     if (ok != 0)
     {
         NetEqMainInst->ErrorCode = -ok;
@@ -413,6 +419,9 @@ int WebRtcNetEQ_Init(void *inst, WebRtc_UWord16 fs)
         return (-1);
     }
 
+    /* Use the fastest SPL functions for the CPU */
+    WebRtcSpl_Init();
+
 #ifdef NETEQ_VAD
     /* Start out with no PostDecode VAD instance */
     NetEqMainInst->DSPinst.VADInst.VADState = NULL;
@@ -446,6 +455,7 @@ int WebRtcNetEQ_Init(void *inst, WebRtc_UWord16 fs)
     NetEqMainInst->MCUinst.current_Codec = -1;
     NetEqMainInst->MCUinst.current_Payload = -1;
     NetEqMainInst->MCUinst.first_packet = 1;
+    NetEqMainInst->MCUinst.decodedCodec = -1;
     NetEqMainInst->MCUinst.one_desc = 0;
     NetEqMainInst->MCUinst.BufferStat_inst.Automode_inst.extraDelayMs = 0;
     NetEqMainInst->MCUinst.NoOfExpandCalls = 0;
@@ -554,6 +564,24 @@ int WebRtcNetEQ_SetPlayoutMode(void *inst, enum WebRtcNetEQPlayoutMode playoutMo
     }
 }
 
+int WebRtcNetEQ_SetDecodeOnReceive(void *inst, int decodeOnReceive)
+{
+    int ok = 0;
+    MainInst_t *NetEqMainInst = (MainInst_t*) inst;
+    if (NetEqMainInst == NULL) return (-1);
+
+    if (NetEqMainInst->MCUinst.decodeOnReceive != (decodeOnReceive != 0))
+    {
+        /* Encoded and decoded payloads cannot be mixed in the packet buffer */
+        ok = WebRtcNetEQ_PacketBufferFlush(&NetEqMainInst->MCUinst.PacketBuffer_inst);
+        RETURN_ON_ERROR(ok, NetEqMainInst);
+        NetEqMainInst->MCUinst.new_codec = 1;
+        NetEqMainInst->MCUinst.decodeOnReceive = (decodeOnReceive != 0);
+        NetEqMainInst->MCUinst.decodedCodec = -1;
+    }
+    return (0);
+}
+
 int WebRtcNetEQ_SetBGNMode(void *inst, enum WebRtcNetEQBGNMode bgnMode)
 {
 
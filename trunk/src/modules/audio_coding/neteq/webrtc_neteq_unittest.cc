@@ -22,6 +22,7 @@
 
 #include "modules/audio_coding/neteq/interface/webrtc_neteq.h"
 #include "modules/audio_coding/neteq/interface/webrtc_neteq_help_macros.h"
+#include "modules/audio_coding/neteq/interface/webrtc_neteq_internal.h"
 #include "modules/audio_coding/neteq/test/NETEQTEST_CodecClass.h"
 #include "modules/audio_coding/neteq/test/NETEQTEST_NetEQClass.h"
 #include "modules/audio_coding/neteq/test/NETEQTEST_RTPpacket.h"
@@ -355,4 +356,76 @@ TEST_F(NetEqDecodingTest, TestNetworkStatistics) {
 }
 #endif // _WIN32
 
+// Decodes a PCM16B stream with one lost and two reordered packets, and
+// returns the output. The payloads are decoded in RecIn() if
+// |decode_on_receive| is true, otherwise in RecOut().
+void DecodePcm16bStream(bool decode_on_receive, std::vector<int16_t>* output) {
+  const int kBlockSize = 80;  // 10 ms.
+  const int kPacketSamples = 2 * kBlockSize;
+  const int kNumPackets = 50;
+  NETEQTEST_NetEQClass neteq;
+  ASSERT_EQ(0, neteq.assign());
+  ASSERT_EQ(0, neteq.init(8000));
+  ASSERT_EQ(0, WebRtcNetEQ_SetDecodeOnReceive(neteq.instance(),
+                                              decode_on_receive ? 1 : 0));
+  WebRtcNetEQDecoder used_codec[] = { kDecoderPCM16B };
+  ASSERT_EQ(0, neteq.assignBuffer(used_codec, 1));
+  decoder_PCM16B_NB decoder(93);
+  ASSERT_EQ(0, decoder.loadToNetEQ(neteq));
+
+  int16_t out_data[kPacketSamples];
+  for (int i = 0; i < 2 * kNumPackets; ++i) {
+    if (i % 2 == 0) {
+      int seq_no = i / 2;
+      // Lose packet 10 and swap packets 20 and 21.
+      if (seq_no == 20) {
+        seq_no = 21;
+      } else if (seq_no == 21) {
+        seq_no = 20;
+      }
+      if (seq_no != 10) {
+        uint8_t payload[2 * kPacketSamples];
+        for (int j = 0; j < kPacketSamples; ++j) {
+          // Big-endian sawtooth.
+          int16_t sample = static_cast<int16_t>(
+              ((seq_no * kPacketSamples + j) % 80 - 40) * 200);
+          payload[2 * j] = static_cast<uint8_t>(sample >> 8);
+          payload[2 * j + 1] = static_cast<uint8_t>(sample & 0xFF);
+        }
+        WebRtcNetEQ_RTPInfo rtp_info;
+        rtp_info.payloadType = 93;
+        rtp_info.sequenceNumber = seq_no;
+        rtp_info.timeStamp = seq_no * kPacketSamples;
+        rtp_info.SSRC = 0x1234;
+        rtp_info.markerBit = 0;
+        ASSERT_EQ(0, WebRtcNetEQ_RecInRTPStruct(neteq.instance(), &rtp_info,
+                                                payload, sizeof(payload),
+                                                i * kBlockSize));
+      }
+    }
+    int16_t out_len = neteq.recOut(out_data);
+    ASSERT_EQ(kBlockSize, out_len);
+    output->insert(output->end(), out_data, out_data + out_len);
+  }
+}
+
+TEST(NetEqDecodeOnReceiveTest, MatchesDecodingInRecOut) {
+  std::vector<int16_t> decoded_in_rec_out;
+  std::vector<int16_t> decoded_in_rec_in;
+  DecodePcm16bStream(false, &decoded_in_rec_out);
+  DecodePcm16bStream(true, &decoded_in_rec_in);
+  ASSERT_EQ(decoded_in_rec_out.size(), decoded_in_rec_in.size());
+  int non_zero = 0;
+  for (size_t i = 0; i < decoded_in_rec_out.size(); ++i) {
+    ASSERT_EQ(decoded_in_rec_out[i], decoded_in_rec_in[i]) << "i = " << i;
+    if (decoded_in_rec_out[i] != 0)
+      ++non_zero;
+  }
+  EXPECT_GT(non_zero, 0);
+}
+
+TEST(NetEqDecodeOnReceiveTest, NullInstance) {
+  EXPECT_EQ(-1, WebRtcNetEQ_SetDecodeOnReceive(NULL, 1));
+}
+
 }  // namespace
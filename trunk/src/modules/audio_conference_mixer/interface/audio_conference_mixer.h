@@ -87,6 +87,21 @@ public:
     // downsampling of audio contributing to the mixed audio.
     virtual WebRtc_Word32 SetMinimumMixingFrequency(Frequency freq) = 0;
 
+    // Call the participants' GetAudioFrame() concurrently on numThreads
+    // worker threads instead of one after another in Process(). A participant
+    // that hasn't delivered its frame deadlineMs after Process() started
+    // pulling is treated as passive and silent for that mix iteration, and
+    // the frame is dropped when it arrives. numThreads = 0 pulls serially,
+    // which is the default. In parallel mode GetAudioFrame() must not call
+    // the mixer.
+    virtual WebRtc_Word32 SetParallelPulling(
+        const WebRtc_UWord32 numThreads,
+        const WebRtc_UWord32 deadlineMs) = 0;
+    // stats is set to the time the participant's GetAudioFrame() calls take.
+    virtual WebRtc_Word32 PullStatistics(
+        MixerParticipant& participant,
+        ParticipantPullStatistics& stats) = 0;
+
 protected:
     AudioConferenceMixer() {}
 };
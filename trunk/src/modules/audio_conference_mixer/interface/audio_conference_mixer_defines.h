@@ -47,6 +47,16 @@ struct ParticipantStatistics
     WebRtc_Word32 level;
 };
 
+// Time taken by a participant's GetAudioFrame() calls.
+struct ParticipantPullStatistics
+{
+    WebRtc_UWord32 pulls;     // Completed GetAudioFrame() calls.
+    WebRtc_UWord32 latePulls; // Mix iterations the frame wasn't ready in time.
+    WebRtc_UWord32 lastPullTimeUs;
+    WebRtc_UWord32 averagePullTimeUs;
+    WebRtc_UWord32 maxPullTimeUs;
+};
+
 class AudioMixerStatusReceiver
 {
 public:
@@ -20,6 +20,7 @@ LOCAL_SRC_FILES := \
     audio_frame_manipulator.cc \
     level_indicator.cc \
     audio_conference_mixer_impl.cc \
+    participant_frame_puller.cc \
     time_scheduler.cc
 
 # Flags passed to both C and C++ files.
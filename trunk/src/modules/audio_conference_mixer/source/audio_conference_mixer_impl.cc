@@ -104,6 +104,11 @@ AudioConferenceMixerImpl::AudioConferenceMixerImpl(int id)
       _outputFrequency(kDefaultFrequency),
       _sampleSize(0),
       _audioFramePool(NULL),
+      _framePuller(NULL),
+      _pullParticipants(),
+      _pulledFrames(),
+      _pullResults(),
+      _pullMixableCount(0),
       _participantList(),
       _additionalParticipantList(),
       _amountOfMixableParticipants(0),
@@ -133,6 +138,10 @@ bool AudioConferenceMixerImpl::Init()
     if(_audioFramePool == NULL)
         return false;
 
+    _framePuller.reset(new ParticipantFramePuller(_id, _audioFramePool));
+    if(!_framePuller->Init())
+        return false;
+
     if(SetOutputFrequency(kDefaultFrequency) == -1)
         return false;
 
@@ -165,6 +174,8 @@ bool AudioConferenceMixerImpl::Init()
 
 AudioConferenceMixerImpl::~AudioConferenceMixerImpl()
 {
+    // Late frames are returned to the pool when the worker threads stop.
+    _framePuller.reset();
     MemoryPool<AudioFrame>::DeleteMemoryPool(_audioFramePool);
     assert(_audioFramePool == NULL);
 }
@@ -309,6 +320,7 @@ WebRtc_Word32 AudioConferenceMixerImpl::Process()
             }
         }
 
+        PullAudioFrames();
         UpdateToMix(mixList, rampOutList, mixedParticipantsMap,
                     remainingParticipantsAllowedToMix);
 
@@ -602,6 +614,10 @@ WebRtc_Word32 AudioConferenceMixerImpl::SetMixabilityStatus(
             assert(false);
             return -1;
         }
+        if(!mixable)
+        {
+            _framePuller->RemoveParticipant(participant);
+        }
         amountOfMixableParticipants = _participantList.GetSize();
     }
     // A MixerParticipant was added or removed. Make sure the scratch
@@ -714,6 +730,26 @@ WebRtc_Word32 AudioConferenceMixerImpl::SetMinimumMixingFrequency(
     }
 }
 
+WebRtc_Word32 AudioConferenceMixerImpl::SetParallelPulling(
+    const WebRtc_UWord32 numThreads,
+    const WebRtc_UWord32 deadlineMs)
+{
+    WEBRTC_TRACE(kTraceModuleCall, kTraceAudioMixerServer, _id,
+                 "SetParallelPulling(numThreads:%u,deadlineMs:%u)",
+                 numThreads, deadlineMs);
+    CriticalSectionScoped cs(_cbCrit.get());
+    return _framePuller->SetWorkerThreads(numThreads, deadlineMs);
+}
+
+WebRtc_Word32 AudioConferenceMixerImpl::PullStatistics(
+    MixerParticipant& participant,
+    ParticipantPullStatistics& stats)
+{
+    WEBRTC_TRACE(kTraceModuleCall, kTraceAudioMixerServer, _id,
+                 "PullStatistics(participant,stats)");
+    return _framePuller->Statistics(participant, stats);
+}
+
 // Check all AudioFrames that are to be mixed. The highest sampling frequency
 // found is the lowest that can be used without losing information.
 WebRtc_Word32 AudioConferenceMixerImpl::GetLowestMixingFrequency()
@@ -755,6 +791,55 @@ WebRtc_Word32 AudioConferenceMixerImpl::GetLowestMixingFrequencyFromList(
     return highestFreq;
 }
 
+void AudioConferenceMixerImpl::PullAudioFrames()
+{
+    WEBRTC_TRACE(kTraceStream, kTraceAudioMixerServer, _id,
+                 "PullAudioFrames()");
+    _pullParticipants.clear();
+    ListItem* item = _participantList.First();
+    while(item)
+    {
+        _pullParticipants.push_back(
+            static_cast<MixerParticipant*>(item->GetItem()));
+        item = _participantList.Next(item);
+    }
+    _pullMixableCount = _pullParticipants.size();
+    item = _additionalParticipantList.First();
+    while(item)
+    {
+        _pullParticipants.push_back(
+            static_cast<MixerParticipant*>(item->GetItem()));
+        item = _additionalParticipantList.Next(item);
+    }
+    const WebRtc_UWord32 size =
+        static_cast<WebRtc_UWord32>(_pullParticipants.size());
+    _pulledFrames.resize(size);
+    _pullResults.resize(size);
+    if(size == 0)
+    {
+        return;
+    }
+    _framePuller->PullFrames(_id, _outputFrequency, &_pullParticipants[0],
+                             &_pulledFrames[0], &_pullResults[0], size);
+
+    // The GetAudioFrame() callbacks may have removed participants, or moved
+    // them between the lists. Don't use their frames.
+    for(WebRtc_UWord32 i = 0; i < size; i++)
+    {
+        if(_pulledFrames[i] == NULL)
+        {
+            continue;
+        }
+        ListWrapper& participantList = (i < _pullMixableCount) ?
+            _participantList : _additionalParticipantList;
+        if(!IsParticipantInList(*_pullParticipants[i], participantList))
+        {
+            _audioFramePool->PushMemory(_pulledFrames[i]);
+            _pulledFrames[i] = NULL;
+        }
+    }
+}
+
 void AudioConferenceMixerImpl::UpdateToMix(
     ListWrapper& mixList,
     ListWrapper& rampOutList,
@@ -775,9 +860,16 @@ void AudioConferenceMixerImpl::UpdateToMix(
     };
     ListWrapper passiveWasNotMixedList; // Elements are MixerParticipant
     ListWrapper passiveWasMixedList;    // Elements are MixerParticipant
-    ListItem* item = _participantList.First();
-    while(item)
+    // The frames of _participantList come first in _pulledFrames.
+    for(size_t i = 0; i < _pullMixableCount; i++)
     {
+        AudioFrame* audioFrame = _pulledFrames[i];
+        if(audioFrame == NULL)
+        {
+            // GetAudioFrame() failed, the participant was late and has never
+            // delivered a frame, or it is no longer mixable.
+            continue;
+        }
         // Stop keeping track of passive participants if there are already
         // enough participants available (they wont be mixed anyway).
         bool mustAddToPassiveList = (maxAudioFrameCounter >
@@ -785,28 +877,9 @@ void AudioConferenceMixerImpl::UpdateToMix(
                                      passiveWasMixedList.GetSize() +
                                      passiveWasNotMixedList.GetSize()));
 
-        MixerParticipant* participant = static_cast<MixerParticipant*>(
-            item->GetItem());
+        MixerParticipant* participant = _pullParticipants[i];
         bool wasMixed = false;
         participant->_mixHistory->WasMixed(wasMixed);
-        AudioFrame* audioFrame = NULL;
-        if(_audioFramePool->PopMemory(audioFrame) == -1)
-        {
-            WEBRTC_TRACE(kTraceMemory, kTraceAudioMixerServer, _id,
-                         "failed PopMemory() call");
-            assert(false);
-            return;
-        }
-        audioFrame->_frequencyInHz = _outputFrequency;
-
-        if(participant->GetAudioFrame(_id,*audioFrame) != 0)
-        {
-            WEBRTC_TRACE(kTraceWarning, kTraceAudioMixerServer, _id,
-                         "failed to GetAudioFrame() from participant");
-            _audioFramePool->PushMemory(audioFrame);
-            item = _participantList.Next(item);
-            continue;
-        }
         // TODO(henrike): this assert triggers in some test cases where SRTP is
         // used which prevents NetEQ from making a VAD. Temporarily disable this
         // assert until the problem is fixed on a higher level.
@@ -910,7 +983,6 @@ void AudioConferenceMixerImpl::UpdateToMix(
                 _audioFramePool->PushMemory(audioFrame);
             }
         }
-        item = _participantList.Next(item);
     }
     assert(activeList.GetSize() <= maxAudioFrameCounter);
     // At this point it is known which participants should be mixed. Transfer
@@ -974,41 +1046,23 @@ void AudioConferenceMixerImpl::GetAdditionalAudio(
 {
     WEBRTC_TRACE(kTraceStream, kTraceAudioMixerServer, _id,
                  "GetAdditionalAudio(additionalFramesList)");
-    ListItem* item = _additionalParticipantList.First();
-    while(item)
+    // The frames of _additionalParticipantList follow the ones of
+    // _participantList in _pulledFrames.
+    for(size_t i = _pullMixableCount; i < _pulledFrames.size(); i++)
     {
-        // The GetAudioFrame() callback may remove the current item. Store the
-        // next item just in case that happens.
-        ListItem* nextItem = _additionalParticipantList.Next(item);
-
-        MixerParticipant* participant = static_cast<MixerParticipant*>(
-            item->GetItem());
-        AudioFrame* audioFrame = NULL;
-        if(_audioFramePool->PopMemory(audioFrame) == -1)
+        AudioFrame* audioFrame = _pulledFrames[i];
+        if(audioFrame == NULL)
         {
-            WEBRTC_TRACE(kTraceMemory, kTraceAudioMixerServer, _id,
-                         "failed PopMemory() call");
-            assert(false);
-            return;
-        }
-        audioFrame->_frequencyInHz = _outputFrequency;
-        if(participant->GetAudioFrame(_id, *audioFrame) != 0)
-        {
-            WEBRTC_TRACE(kTraceWarning, kTraceAudioMixerServer, _id,
-                         "failed to GetAudioFrame() from participant");
-            _audioFramePool->PushMemory(audioFrame);
-            item = nextItem;
             continue;
         }
-        if(audioFrame->_payloadDataLengthInSamples == 0)
+        if(audioFrame->_payloadDataLengthInSamples == 0 ||
+           _pullResults[i] == ParticipantFramePuller::kLate)
         {
-            // Empty frame. Don't use it.
+            // Empty or silent frame. Don't use it.
             _audioFramePool->PushMemory(audioFrame);
-            item = nextItem;
             continue;
         }
         additionalFramesList.PushBack(static_cast<void*>(audioFrame));
-        item = nextItem;
     }
 }
 
@@ -11,6 +11,8 @@
 #ifndef WEBRTC_MODULES_AUDIO_CONFERENCE_MIXER_SOURCE_AUDIO_CONFERENCE_MIXER_IMPL_H_
 #define WEBRTC_MODULES_AUDIO_CONFERENCE_MIXER_SOURCE_AUDIO_CONFERENCE_MIXER_IMPL_H_
 
+#include <vector>
+
 #include "atomic32_wrapper.h"
 #include "audio_conference_mixer.h"
 #include "engine_configurations.h"
@@ -18,6 +20,7 @@
 #include "list_wrapper.h"
 #include "memory_pool.h"
 #include "module_common_types.h"
+#include "participant_frame_puller.h"
 #include "scoped_ptr.h"
 #include "time_scheduler.h"
 
@@ -88,6 +91,10 @@ public:
         MixerParticipant& participant, const bool mixable);
     virtual WebRtc_Word32 AnonymousMixabilityStatus(
         MixerParticipant& participant, bool& mixable);
+    virtual WebRtc_Word32 SetParallelPulling(const WebRtc_UWord32 numThreads,
+                                             const WebRtc_UWord32 deadlineMs);
+    virtual WebRtc_Word32 PullStatistics(MixerParticipant& participant,
+                                         ParticipantPullStatistics& stats);
 private:
     enum{DEFAULT_AUDIO_FRAME_POOLSIZE = 50};
 
@@ -99,6 +106,11 @@ private:
     // has changed.
     bool SetNumLimiterChannels(int numChannels);
 
+    // Pulls an AudioFrame from every participant in _participantList and
+    // then _additionalParticipantList into _pulledFrames. Participants that
+    // left their list while being pulled get a NULL frame.
+    void PullAudioFrames();
+
     // Fills mixList with the AudioFrames pointers that should be used when
     // mixing. Fills mixParticipantList with ParticipantStatistics for the
     // participants who's AudioFrames are inside mixList.
@@ -192,6 +204,17 @@ private:
     // Memory pool to avoid allocating/deallocating AudioFrames
     MemoryPool<AudioFrame>* _audioFramePool;
 
+    // Calls the participants' GetAudioFrame().
+    scoped_ptr<ParticipantFramePuller> _framePuller;
+    // The participants of the current mix iteration, and their AudioFrames.
+    // A NULL frame is not to be used. May only be touched in Process().
+    std::vector<MixerParticipant*> _pullParticipants;
+    std::vector<AudioFrame*> _pulledFrames;
+    std::vector<ParticipantFramePuller::PullResult> _pullResults;
+    // The number of _pullParticipants from _participantList. The ones from
+    // _additionalParticipantList follow.
+    size_t _pullMixableCount;
+
     // List of all participants. Note all lists are disjunct
     ListWrapper _participantList;              // May be mixed.
     ListWrapper _additionalParticipantList;    // Always mixed, anonomously.
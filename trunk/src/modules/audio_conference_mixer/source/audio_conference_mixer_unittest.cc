@@ -9,9 +9,270 @@
  */
 
 /*
- * Empty test just to get code coverage metrics for this dir.
+ * Unit tests for pulling participant frames in the AudioConferenceMixer.
  */
 #include "audio_conference_mixer.h"
+#include "audio_conference_mixer_defines.h"
+#include "critical_section_wrapper.h"
+#include "event_wrapper.h"
 #include "gtest/gtest.h"
+#include "module_common_types.h"
+#include "scoped_ptr.h"
+#include "tick_util.h"
+
+namespace webrtc {
+namespace {
+
+const int kFrequencyInHz = 16000;
+const int kSamplesPer10Ms = kFrequencyInHz / 100;
+
+// Delivers a constant, active frame after |delayMs|.
+class FakeParticipant : public MixerParticipant
+{
+public:
+    FakeParticipant(WebRtc_Word32 id, WebRtc_Word16 value,
+                    unsigned long delayMs)
+        : _id(id),
+          _value(value),
+          _crit(CriticalSectionWrapper::CreateCriticalSection()),
+          _delayMs(delayMs),
+          _event(EventWrapper::Create())
+    {
+    }
+
+    virtual WebRtc_Word32 GetAudioFrame(const WebRtc_Word32 /*id*/,
+                                        AudioFrame& audioFrame)
+    {
+        const unsigned long delayMs = DelayMs();
+        if(delayMs > 0)
+        {
+            _event->Wait(delayMs);
+        }
+        WebRtc_Word16 samples[kSamplesPer10Ms];
+        for(int i = 0; i < kSamplesPer10Ms; i++)
+        {
+            samples[i] = _value;
+        }
+        audioFrame.UpdateFrame(_id, 0, samples, kSamplesPer10Ms,
+                               kFrequencyInHz, AudioFrame::kNormalSpeech,
+                               AudioFrame::kVadActive);
+        return 0;
+    }
+
+    virtual WebRtc_Word32 NeededFrequency(const WebRtc_Word32 /*id*/)
+    {
+        return kFrequencyInHz;
+    }
+
+    // May be called while a worker thread pulls.
+    void SetDelayMs(unsigned long delayMs)
+    {
+        CriticalSectionScoped cs(_crit.get());
+        _delayMs = delayMs;
+    }
+
+private:
+    unsigned long DelayMs()
+    {
+        CriticalSectionScoped cs(_crit.get());
+        return _delayMs;
+    }
+
+    WebRtc_Word32 _id;
+    WebRtc_Word16 _value;
+    scoped_ptr<CriticalSectionWrapper> _crit;
+    unsigned long _delayMs;
+    scoped_ptr<EventWrapper> _event;
+};
+
+// Removes itself from the mix when pulled.
+class LeavingParticipant : public FakeParticipant
+{
+public:
+    LeavingParticipant(WebRtc_Word32 id, AudioConferenceMixer* mixer)
+        : FakeParticipant(id, 1000, 0),
+          _mixer(mixer)
+    {
+    }
+
+    virtual WebRtc_Word32 GetAudioFrame(const WebRtc_Word32 id,
+                                        AudioFrame& audioFrame)
+    {
+        EXPECT_EQ(0, _mixer->SetMixabilityStatus(*this, false));
+        return FakeParticipant::GetAudioFrame(id, audioFrame);
+    }
+
+private:
+    AudioConferenceMixer* _mixer;
+};
+
+class MixedAudio : public AudioMixerOutputReceiver
+{
+public:
+    MixedAudio() : _frames(0), _nonZero(false) {}
+
+    virtual void NewMixedAudio(const WebRtc_Word32 /*id*/,
+                               const AudioFrame& generalAudioFrame,
+                               const AudioFrame** /*uniqueAudioFrames*/,
+                               const WebRtc_UWord32 /*size*/)
+    {
+        _frames++;
+        _nonZero = false;
+        for(int i = 0; i < generalAudioFrame._payloadDataLengthInSamples; i++)
+        {
+            if(generalAudioFrame._payloadData[i] != 0)
+            {
+                _nonZero = true;
+            }
+        }
+    }
+
+    int _frames;
+    bool _nonZero;
+};
+
+class ParticipantPullingTest : public ::testing::Test
+{
+protected:
+    ParticipantPullingTest()
+        : _mixer(AudioConferenceMixer::Create(0)),
+          _fast(1, 1000, 0),
+          _slow(2, 1000, 0)
+    {
+        EXPECT_EQ(0, _mixer->RegisterMixedStreamCallback(_mixedAudio));
+        EXPECT_EQ(0, _mixer->SetMixabilityStatus(_fast, true));
+        EXPECT_EQ(0, _mixer->SetMixabilityStatus(_slow, true));
+    }
+
+    ~ParticipantPullingTest()
+    {
+        delete _mixer;
+    }
+
+    AudioConferenceMixer* _mixer;
+    MixedAudio _mixedAudio;
+    FakeParticipant _fast;
+    FakeParticipant _slow;
+};
+
+}  // namespace
 
 TEST(AudioConferenceMixerTest, EmptyTestToGetCodeCoverage) {}
+
+TEST_F(ParticipantPullingTest, SerialPullingRecordsStatistics)
+{
+    for(int i = 0; i < 3; i++)
+    {
+        EXPECT_EQ(0, _mixer->Process());
+    }
+    EXPECT_EQ(3, _mixedAudio._frames);
+    EXPECT_TRUE(_mixedAudio._nonZero);
+
+    ParticipantPullStatistics stats;
+    ASSERT_EQ(0, _mixer->PullStatistics(_fast, stats));
+    EXPECT_EQ(3u, stats.pulls);
+    EXPECT_EQ(0u, stats.latePulls);
+    EXPECT_LE(stats.averagePullTimeUs, stats.maxPullTimeUs);
+
+    FakeParticipant unknown(3, 0, 0);
+    EXPECT_EQ(-1, _mixer->PullStatistics(unknown, stats));
+}
+
+TEST_F(ParticipantPullingTest, ParallelPullingMixesAllParticipants)
+{
+    EXPECT_EQ(0, _mixer->SetParallelPulling(2, 1000));
+    for(int i = 0; i < 3; i++)
+    {
+        EXPECT_EQ(0, _mixer->Process());
+    }
+    EXPECT_EQ(3, _mixedAudio._frames);
+    EXPECT_TRUE(_mixedAudio._nonZero);
+
+    ParticipantPullStatistics stats;
+    ASSERT_EQ(0, _mixer->PullStatistics(_slow, stats));
+    EXPECT_EQ(3u, stats.pulls);
+    EXPECT_EQ(0u, stats.latePulls);
+    bool mixed = false;
+    EXPECT_EQ(0, _slow.IsMixed(mixed));
+    EXPECT_TRUE(mixed);
+
+    // Back to serial pulling.
+    EXPECT_EQ(0, _mixer->SetParallelPulling(0, 0));
+    EXPECT_EQ(0, _mixer->Process());
+    ASSERT_EQ(0, _mixer->PullStatistics(_slow, stats));
+    EXPECT_EQ(4u, stats.pulls);
+}
+
+TEST_F(ParticipantPullingTest, ParticipantMayLeaveWhenPulled)
+{
+    LeavingParticipant leaving(3, _mixer);
+    ASSERT_EQ(0, _mixer->SetMixabilityStatus(leaving, true));
+    EXPECT_EQ(0, _mixer->Process());
+    EXPECT_EQ(1, _mixedAudio._frames);
+    EXPECT_TRUE(_mixedAudio._nonZero);
+
+    bool mixable = true;
+    EXPECT_EQ(0, _mixer->MixabilityStatus(leaving, mixable));
+    EXPECT_FALSE(mixable);
+    ParticipantPullStatistics stats;
+    EXPECT_EQ(-1, _mixer->PullStatistics(leaving, stats));
+    // The frames of the remaining participants are still theirs.
+    EXPECT_EQ(0, _mixer->Process());
+    ASSERT_EQ(0, _mixer->PullStatistics(_slow, stats));
+    EXPECT_EQ(2u, stats.pulls);
+    bool mixed = false;
+    EXPECT_EQ(0, _slow.IsMixed(mixed));
+    EXPECT_TRUE(mixed);
+}
+
+TEST_F(ParticipantPullingTest, LateParticipantDoesNotDelayTheMix)
+{
+    // Generous enough for the fast participant on a loaded machine, and well
+    // below the delay of the slow one.
+    const unsigned long kDeadlineMs = 100;
+    const unsigned long kSlowDelayMs = 1000;
+    EXPECT_EQ(0, _mixer->SetParallelPulling(2, kDeadlineMs));
+    // Let the slow participant deliver a frame first.
+    EXPECT_EQ(0, _mixer->Process());
+
+    _slow.SetDelayMs(kSlowDelayMs);
+    const TickTime startTime = TickTime::Now();
+    EXPECT_EQ(0, _mixer->Process());
+    EXPECT_EQ(0, _mixer->Process());
+    EXPECT_LT((TickTime::Now() - startTime).Milliseconds(), kSlowDelayMs / 2);
+    EXPECT_EQ(3, _mixedAudio._frames);
+    EXPECT_TRUE(_mixedAudio._nonZero);
+
+    ParticipantPullStatistics stats;
+    ASSERT_EQ(0, _mixer->PullStatistics(_slow, stats));
+    EXPECT_EQ(1u, stats.pulls);
+    EXPECT_EQ(2u, stats.latePulls);
+    // The fast participant isn't held up by the slow one.
+    ASSERT_EQ(0, _mixer->PullStatistics(_fast, stats));
+    EXPECT_LT(stats.latePulls, 2u);
+
+    // Removing the participant waits for its late frame.
+    EXPECT_EQ(0, _mixer->SetMixabilityStatus(_slow, false));
+    EXPECT_EQ(-1, _mixer->PullStatistics(_slow, stats));
+    EXPECT_EQ(0, _mixer->Process());
+}
+
+TEST_F(ParticipantPullingTest, LateFramesAreDroppedWhenTheyArrive)
+{
+    EXPECT_EQ(0, _mixer->SetParallelPulling(1, 1));
+    _slow.SetDelayMs(20);
+    for(int i = 0; i < 10; i++)
+    {
+        EXPECT_EQ(0, _mixer->Process());
+    }
+    // Stopping the worker threads waits for the late pull, whose frame goes
+    // back to the memory pool.
+    EXPECT_EQ(0, _mixer->SetParallelPulling(0, 0));
+    ParticipantPullStatistics stats;
+    ASSERT_EQ(0, _mixer->PullStatistics(_slow, stats));
+    EXPECT_GT(stats.latePulls, 0u);
+    EXPECT_GE(stats.pulls, 1u);
+    EXPECT_GE(stats.maxPullTimeUs, 15000u);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,415 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "participant_frame_puller.h"
+
+#include <cassert>
+
+#include "condition_variable_wrapper.h"
+#include "critical_section_wrapper.h"
+#include "thread_wrapper.h"
+#include "tick_util.h"
+#include "trace.h"
+
+namespace webrtc {
+namespace {
+// Upper limit for SetWorkerThreads().
+const WebRtc_UWord32 kMaxWorkerThreads = 32;
+} // namespace
+
+ParticipantFramePuller::Job::Job()
+    : participant(NULL),
+      frame(NULL),
+      mixerId(-1),
+      result(0),
+      state(kIdle),
+      abandoned(false),
+      pullTimeUs(0),
+      hasDelivered(false),
+      lastId(-1),
+      lastChannels(1),
+      stats(),
+      totalPullTimeUs(0)
+{
+}
+
+ParticipantFramePuller::ParticipantFramePuller(
+    WebRtc_Word32 id,
+    MemoryPool<AudioFrame>* audioFramePool)
+    : _id(id),
+      _audioFramePool(audioFramePool),
+      _crit(NULL),
+      _workCond(NULL),
+      _doneCond(NULL),
+      _threads(),
+      _stopWorkers(false),
+      _deadlineMs(0),
+      _jobs(),
+      _tickJobs(),
+      _nextJob(0),
+      _pendingJobs(0)
+{
+}
+
+ParticipantFramePuller::~ParticipantFramePuller()
+{
+    StopWorkers();
+}
+
+bool ParticipantFramePuller::Init()
+{
+    _crit.reset(CriticalSectionWrapper::CreateCriticalSection());
+    if(_crit.get() == NULL)
+        return false;
+
+    _workCond.reset(ConditionVariableWrapper::CreateConditionVariable());
+    if(_workCond.get() == NULL)
+        return false;
+
+    _doneCond.reset(ConditionVariableWrapper::CreateConditionVariable());
+    if(_doneCond.get() == NULL)
+        return false;
+
+    return true;
+}
+
+WebRtc_Word32 ParticipantFramePuller::SetWorkerThreads(
+    const WebRtc_UWord32 numThreads,
+    const WebRtc_UWord32 deadlineMs)
+{
+    if(numThreads > kMaxWorkerThreads)
+    {
+        WEBRTC_TRACE(kTraceError, kTraceAudioMixerServer, _id,
+                     "too many worker threads: %u", numThreads);
+        return -1;
+    }
+    StopWorkers();
+    _deadlineMs = deadlineMs;
+    for(WebRtc_UWord32 i = 0; i < numThreads; i++)
+    {
+        ThreadWrapper* thread = ThreadWrapper::CreateThread(
+            Run, this, kHighPriority, "AudioMixerPullThread");
+        unsigned int threadId = 0;
+        if(thread == NULL || !thread->Start(threadId))
+        {
+            WEBRTC_TRACE(kTraceError, kTraceAudioMixerServer, _id,
+                         "failed to start a worker thread");
+            delete thread;
+            StopWorkers();
+            return -1;
+        }
+        _threads.push_back(thread);
+    }
+    return 0;
+}
+
+void ParticipantFramePuller::StopWorkers()
+{
+    if(_threads.empty())
+    {
+        return;
+    }
+    for(size_t i = 0; i < _threads.size(); i++)
+    {
+        _threads[i]->SetNotAlive();
+    }
+    {
+        CriticalSectionScoped cs(_crit.get());
+        _stopWorkers = true;
+        _workCond->WakeAll();
+    }
+    // Late pulls still running complete before their threads stop.
+    for(size_t i = 0; i < _threads.size(); i++)
+    {
+        if(_threads[i]->Stop())
+        {
+            delete _threads[i];
+        }
+        else
+        {
+            WEBRTC_TRACE(kTraceError, kTraceAudioMixerServer, _id,
+                         "could not stop a worker thread");
+        }
+    }
+    _threads.clear();
+    CriticalSectionScoped cs(_crit.get());
+    _stopWorkers = false;
+}
+
+bool ParticipantFramePuller::Run(void* obj)
+{
+    return static_cast<ParticipantFramePuller*>(obj)->Process();
+}
+
+bool ParticipantFramePuller::Process()
+{
+    _crit->Enter();
+    for(;;)
+    {
+        if(_stopWorkers)
+        {
+            _crit->Leave();
+            return false;
+        }
+        while(_nextJob < _tickJobs.size() &&
+              _tickJobs[_nextJob]->state != kQueued)
+        {
+            _nextJob++;
+        }
+        if(_nextJob < _tickJobs.size())
+        {
+            break;
+        }
+        _workCond->SleepCS(*_crit);
+    }
+    Job& job = *_tickJobs[_nextJob++];
+    job.state = kRunning;
+    _crit->Leave();
+
+    Pull(job);
+
+    CriticalSectionScoped cs(_crit.get());
+    UpdateStatistics(job);
+    if(job.abandoned)
+    {
+        // PullFrames() has moved on without this frame.
+        _audioFramePool->PushMemory(job.frame);
+        job.frame = NULL;
+        job.abandoned = false;
+        job.state = kIdle;
+    }
+    else
+    {
+        job.state = kDone;
+        _pendingJobs--;
+    }
+    _doneCond->WakeAll();
+    return true;
+}
+
+void ParticipantFramePuller::Pull(Job& job)
+{
+    const TickTime startTime = TickTime::Now();
+    job.result = job.participant->GetAudioFrame(job.mixerId, *job.frame);
+    job.pullTimeUs = (TickTime::Now() - startTime).Microseconds();
+}
+
+void ParticipantFramePuller::UpdateStatistics(Job& job)
+{
+    ParticipantPullStatistics& stats = job.stats;
+    const WebRtc_UWord32 pullTimeUs =
+        static_cast<WebRtc_UWord32>(job.pullTimeUs);
+    stats.pulls++;
+    stats.lastPullTimeUs = pullTimeUs;
+    if(pullTimeUs > stats.maxPullTimeUs)
+    {
+        stats.maxPullTimeUs = pullTimeUs;
+    }
+    job.totalPullTimeUs += pullTimeUs;
+    stats.averagePullTimeUs =
+        static_cast<WebRtc_UWord32>(job.totalPullTimeUs / stats.pulls);
+}
+
+ParticipantFramePuller::PullResult ParticipantFramePuller::Complete(
+    Job& job,
+    const bool late,
+    const int frequencyInHz,
+    AudioFrame*& frame)
+{
+    frame = NULL;
+    if(!late)
+    {
+        frame = job.frame;
+        job.frame = NULL;
+        job.state = kIdle;
+        if(job.result != 0)
+        {
+            WEBRTC_TRACE(kTraceWarning, kTraceAudioMixerServer, _id,
+                         "failed to GetAudioFrame() from participant");
+            _audioFramePool->PushMemory(frame);
+            return kFailed;
+        }
+        job.hasDelivered = true;
+        job.lastId = frame->_id;
+        job.lastChannels = frame->_audioChannel;
+        return kPulled;
+    }
+
+    job.stats.latePulls++;
+    if(!job.hasDelivered || _audioFramePool->PopMemory(frame) == -1)
+    {
+        return kLate;
+    }
+    frame->UpdateFrame(job.lastId, 0, NULL,
+                       static_cast<WebRtc_UWord16>(frequencyInHz / 100),
+                       frequencyInHz, AudioFrame::kUndefined,
+                       AudioFrame::kVadPassive, job.lastChannels);
+    return kLate;
+}
+
+void ParticipantFramePuller::PullFrames(
+    const WebRtc_Word32 mixerId,
+    const int frequencyInHz,
+    MixerParticipant* const* participants,
+    AudioFrame** frames,
+    PullResult* results,
+    const WebRtc_UWord32 size)
+{
+    if(_threads.empty())
+    {
+        for(WebRtc_UWord32 i = 0; i < size; i++)
+        {
+            frames[i] = NULL;
+            results[i] = kFailed;
+            {
+                // Start keeping track of a new participant.
+                CriticalSectionScoped cs(_crit.get());
+                _jobs[participants[i]];
+            }
+            // GetAudioFrame() may remove the participant, and with it its
+            // job. Pull into a temporary job and look the real one up after.
+            Job pulled;
+            if(_audioFramePool->PopMemory(pulled.frame) == -1)
+            {
+                WEBRTC_TRACE(kTraceMemory, kTraceAudioMixerServer, _id,
+                             "failed PopMemory() call");
+                continue;
+            }
+            pulled.frame->_frequencyInHz = frequencyInHz;
+            pulled.participant = participants[i];
+            pulled.mixerId = mixerId;
+            Pull(pulled);
+            CriticalSectionScoped cs(_crit.get());
+            JobMap::iterator it = _jobs.find(participants[i]);
+            if(it == _jobs.end())
+            {
+                // Removed during the pull.
+                _audioFramePool->PushMemory(pulled.frame);
+                continue;
+            }
+            Job& job = it->second;
+            job.participant = pulled.participant;
+            job.frame = pulled.frame;
+            job.mixerId = pulled.mixerId;
+            job.result = pulled.result;
+            job.pullTimeUs = pulled.pullTimeUs;
+            UpdateStatistics(job);
+            results[i] = Complete(job, false, frequencyInHz, frames[i]);
+        }
+        return;
+    }
+
+    const TickTime startTime = TickTime::Now();
+    CriticalSectionScoped cs(_crit.get());
+    assert(_tickJobs.empty());
+    _nextJob = 0;
+    _pendingJobs = 0;
+    for(WebRtc_UWord32 i = 0; i < size; i++)
+    {
+        Job& job = _jobs[participants[i]];
+        _tickJobs.push_back(&job);
+        results[i] = kFailed;
+        if(job.state == kRunning)
+        {
+            // Still working on a frame which was late before.
+            results[i] = kLate;
+            continue;
+        }
+        if(_audioFramePool->PopMemory(job.frame) == -1)
+        {
+            WEBRTC_TRACE(kTraceMemory, kTraceAudioMixerServer, _id,
+                         "failed PopMemory() call");
+            continue;
+        }
+        job.frame->_frequencyInHz = frequencyInHz;
+        job.participant = participants[i];
+        job.mixerId = mixerId;
+        job.state = kQueued;
+        _pendingJobs++;
+    }
+    _workCond->WakeAll();
+
+    while(_pendingJobs > 0)
+    {
+        const WebRtc_Word64 elapsedMs =
+            (TickTime::Now() - startTime).Milliseconds();
+        if(elapsedMs >= static_cast<WebRtc_Word64>(_deadlineMs))
+        {
+            break;
+        }
+        _doneCond->SleepCS(*_crit,
+                           static_cast<unsigned long>(_deadlineMs - elapsedMs));
+    }
+
+    for(WebRtc_UWord32 i = 0; i < size; i++)
+    {
+        Job& job = *_tickJobs[i];
+        if(results[i] == kLate)
+        {
+            results[i] = Complete(job, true, frequencyInHz, frames[i]);
+            continue;
+        }
+        switch(job.state)
+        {
+        case kDone:
+            results[i] = Complete(job, false, frequencyInHz, frames[i]);
+            break;
+        case kQueued:
+            // Not started; the frame is untouched.
+            _audioFramePool->PushMemory(job.frame);
+            job.frame = NULL;
+            job.state = kIdle;
+            results[i] = Complete(job, true, frequencyInHz, frames[i]);
+            break;
+        case kRunning:
+            // The worker returns the frame to the pool when done.
+            job.abandoned = true;
+            results[i] = Complete(job, true, frequencyInHz, frames[i]);
+            break;
+        case kIdle:
+            frames[i] = NULL;
+            results[i] = kFailed;
+            break;
+        }
+    }
+    _tickJobs.clear();
+    _nextJob = 0;
+    _pendingJobs = 0;
+}
+
+void ParticipantFramePuller::RemoveParticipant(MixerParticipant& participant)
+{
+    CriticalSectionScoped cs(_crit.get());
+    JobMap::iterator it = _jobs.find(&participant);
+    if(it == _jobs.end())
+    {
+        return;
+    }
+    while(it->second.state == kRunning)
+    {
+        _doneCond->SleepCS(*_crit);
+    }
+    _jobs.erase(it);
+}
+
+WebRtc_Word32 ParticipantFramePuller::Statistics(
+    MixerParticipant& participant,
+    ParticipantPullStatistics& stats) const
+{
+    CriticalSectionScoped cs(_crit.get());
+    JobMap::const_iterator it = _jobs.find(&participant);
+    if(it == _jobs.end())
+    {
+        return -1;
+    }
+    stats = it->second.stats;
+    return 0;
+}
+} // namespace webrtc
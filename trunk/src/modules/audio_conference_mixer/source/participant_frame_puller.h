@@ -0,0 +1,140 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_AUDIO_CONFERENCE_MIXER_SOURCE_PARTICIPANT_FRAME_PULLER_H_
+#define WEBRTC_MODULES_AUDIO_CONFERENCE_MIXER_SOURCE_PARTICIPANT_FRAME_PULLER_H_
+
+#include <map>
+#include <vector>
+
+#include "audio_conference_mixer_defines.h"
+#include "memory_pool.h"
+#include "module_common_types.h"
+#include "scoped_ptr.h"
+#include "typedefs.h"
+
+namespace webrtc {
+class ConditionVariableWrapper;
+class CriticalSectionWrapper;
+class ThreadWrapper;
+
+// Pulls AudioFrames from MixerParticipants, either one after another on the
+// calling thread or concurrently on a pool of worker threads. In the latter
+// case a participant that hasn't delivered its frame by a deadline is late:
+// it gets a silent, passive frame and the frame it is still working on is
+// dropped when it arrives. Keeps track of the time each participant takes.
+class ParticipantFramePuller
+{
+public:
+    enum PullResult
+    {
+        kPulled, // The participant's frame.
+        kLate,   // A silent frame, or NULL if the participant never
+                 // delivered a frame.
+        kFailed  // NULL, GetAudioFrame() failed.
+    };
+
+    ParticipantFramePuller(WebRtc_Word32 id,
+                           MemoryPool<AudioFrame>* audioFramePool);
+    ~ParticipantFramePuller();
+
+    // Must be called after ctor.
+    bool Init();
+
+    // Pulls on |numThreads| worker threads and waits at most |deadlineMs| ms
+    // for them. 0 threads pulls on the calling thread without a deadline.
+    WebRtc_Word32 SetWorkerThreads(const WebRtc_UWord32 numThreads,
+                                   const WebRtc_UWord32 deadlineMs);
+
+    // Pulls a frame at |frequencyInHz| from each of the |size| participants.
+    // Sets frames[i] to a frame from the memory pool, or NULL, according to
+    // results[i]. The caller returns the frames to the pool.
+    void PullFrames(const WebRtc_Word32 mixerId,
+                    const int frequencyInHz,
+                    MixerParticipant* const* participants,
+                    AudioFrame** frames,
+                    PullResult* results,
+                    const WebRtc_UWord32 size);
+
+    // Waits until a late pull from |participant| has completed and forgets
+    // the participant. When pulling on the calling thread, the participant
+    // may remove itself from within GetAudioFrame(); its frame is then
+    // dropped and PullFrames() reports kFailed.
+    void RemoveParticipant(MixerParticipant& participant);
+
+    WebRtc_Word32 Statistics(MixerParticipant& participant,
+                             ParticipantPullStatistics& stats) const;
+
+private:
+    enum JobState
+    {
+        kIdle,
+        kQueued,
+        kRunning,
+        kDone
+    };
+
+    // Per participant state. Protected by _crit while a worker thread may
+    // access it.
+    struct Job
+    {
+        Job();
+
+        MixerParticipant* participant;
+        AudioFrame* frame;
+        WebRtc_Word32 mixerId;
+        WebRtc_Word32 result;
+        JobState state;
+        // Set when the deadline passed while the job was running.
+        bool abandoned;
+        WebRtc_Word64 pullTimeUs;
+
+        // Properties of the last frame delivered, to fake a silent one.
+        bool hasDelivered;
+        WebRtc_Word32 lastId;
+        WebRtc_UWord8 lastChannels;
+
+        ParticipantPullStatistics stats;
+        WebRtc_Word64 totalPullTimeUs;
+    };
+    typedef std::map<MixerParticipant*, Job> JobMap;
+
+    static bool Run(void* obj);
+    bool Process();
+
+    void StopWorkers();
+    // Pulls the frame of |job|. Called without holding _crit.
+    static void Pull(Job& job);
+    // Updates the statistics of |job| after a pull. Holds _crit.
+    static void UpdateStatistics(Job& job);
+    // Returns the outcome of |job|'s pull in |frame|, or a silent frame if
+    // |late|.
+    PullResult Complete(Job& job, const bool late, const int frequencyInHz,
+                        AudioFrame*& frame);
+
+    WebRtc_Word32 _id;
+    MemoryPool<AudioFrame>* _audioFramePool;
+
+    scoped_ptr<CriticalSectionWrapper> _crit;
+    scoped_ptr<ConditionVariableWrapper> _workCond;
+    scoped_ptr<ConditionVariableWrapper> _doneCond;
+    std::vector<ThreadWrapper*> _threads;
+    bool _stopWorkers;
+    WebRtc_UWord32 _deadlineMs;
+
+    JobMap _jobs;
+    // Jobs of the current PullFrames() call, and the next one to run.
+    std::vector<Job*> _tickJobs;
+    size_t _nextJob;
+    WebRtc_UWord32 _pendingJobs;
+};
+} // namespace webrtc
+
+#endif // WEBRTC_MODULES_AUDIO_CONFERENCE_MIXER_SOURCE_PARTICIPANT_FRAME_PULLER_H_
@@ -25,7 +25,8 @@ LOCAL_SRC_FILES := \
     android/audio_device_android_opensles.cc \
     android/audio_device_utility_android.cc \
     dummy/audio_device_utility_dummy.cc \
-    dummy/audio_device_dummy.cc
+    dummy/audio_device_dummy.cc \
+    virtual_clock/audio_device_virtual_clock.cc
 
 # Flags passed to both C and C++ files.
 LOCAL_CFLAGS := \
@@ -37,6 +38,7 @@ LOCAL_C_INCLUDES := \
     $(LOCAL_PATH)/android \
     $(LOCAL_PATH)/dummy \
     $(LOCAL_PATH)/linux \
+    $(LOCAL_PATH)/virtual_clock \
     $(LOCAL_PATH)/../interface \
     $(LOCAL_PATH)/../../../.. \
     $(LOCAL_PATH)/../../../interface \
@@ -0,0 +1,1011 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "audio_device_virtual_clock.h"
+
+#include <math.h>
+#include <string.h>
+
+#include "critical_section_wrapper.h"
+#include "event_wrapper.h"
+#include "thread_wrapper.h"
+#include "trace.h"
+#include "system_wrappers/interface/ref_count.h"
+
+namespace webrtc {
+
+// Wait time of the device thread while neither playing nor recording.
+const unsigned long IDLE_WAIT_MS = 100;
+// Frequency and amplitude of the recorded test tone.
+const double TONE_FREQUENCY_HZ = 1000.0;
+const double TONE_AMPLITUDE = 8000.0;
+// Mic level range reported to the engine.
+const WebRtc_UWord32 MAX_MIC_LEVEL = 255;
+
+// ============================================================================
+//                                   Static methods
+// ============================================================================
+
+AudioDeviceVirtualClock* AudioDeviceVirtualClock::Create(const WebRtc_Word32 id)
+{
+    WEBRTC_TRACE(kTraceModuleCall, kTraceAudioDevice, id, "%s", __FUNCTION__);
+
+    RefCountImpl<AudioDeviceVirtualClock>* audioDevice =
+        new RefCountImpl<AudioDeviceVirtualClock>(id);
+    return audioDevice;
+}
+
+// ============================================================================
+//                            Construction & Destruction
+// ============================================================================
+
+AudioDeviceVirtualClock::AudioDeviceVirtualClock(const WebRtc_Word32 id) :
+    _id(id),
+    _critSect(*CriticalSectionWrapper::CreateCriticalSection()),
+    _critSectCb(*CriticalSectionWrapper::CreateCriticalSection()),
+    _wakeEvent(*EventWrapper::Create()),
+    _ptrThread(NULL),
+    _ptrCbAudioTransport(NULL),
+    _initialized(false),
+    _recIsInitialized(false),
+    _playIsInitialized(false),
+    _recording(false),
+    _playing(false),
+    _speakerIsInitialized(false),
+    _microphoneIsInitialized(false),
+    _agc(false),
+    _recSampleRate(16000),
+    _playSampleRate(16000),
+    _micLevel(MAX_MIC_LEVEL / 2),
+    _speed(0.0f),
+    _pacingStart(TickTime::Now()),
+    _pacedTicks(0),
+    _virtualTimeMs(0)
+{
+    WEBRTC_TRACE(kTraceMemory, kTraceAudioDevice, id, "%s created",
+                 __FUNCTION__);
+
+    memset(_playBuffer, 0, sizeof(_playBuffer));
+    GenerateRecordingSignal();
+    ResetTickHistograms();
+}
+
+AudioDeviceVirtualClock::~AudioDeviceVirtualClock()
+{
+    WEBRTC_TRACE(kTraceMemory, kTraceAudioDevice, _id, "%s destroyed",
+                 __FUNCTION__);
+
+    Terminate();
+
+    delete &_wakeEvent;
+    delete &_critSectCb;
+    delete &_critSect;
+}
+
+// ============================================================================
+//                                  Virtual clock
+// ============================================================================
+
+WebRtc_Word32 AudioDeviceVirtualClock::SetSpeed(const float realTimeFactor)
+{
+    if (realTimeFactor < 0.0f)
+    {
+        WEBRTC_TRACE(kTraceError, kTraceAudioDevice, _id,
+                     "  invalid real-time factor %f", realTimeFactor);
+        return -1;
+    }
+
+    CriticalSectionScoped lock(_critSect);
+    _speed = realTimeFactor;
+    RestartPacing();
+    _wakeEvent.Set();
+    return 0;
+}
+
+float AudioDeviceVirtualClock::Speed() const
+{
+    CriticalSectionScoped lock(_critSect);
+    return _speed;
+}
+
+WebRtc_UWord32 AudioDeviceVirtualClock::VirtualTimeMs() const
+{
+    CriticalSectionScoped lock(_critSect);
+    return _virtualTimeMs;
+}
+
+void AudioDeviceVirtualClock::GetTickHistograms(TickHistogram* recording,
+                                                TickHistogram* playout) const
+{
+    CriticalSectionScoped lock(_critSect);
+    if (recording)
+    {
+        *recording = _recHistogram;
+    }
+    if (playout)
+    {
+        *playout = _playHistogram;
+    }
+}
+
+void AudioDeviceVirtualClock::ResetTickHistograms()
+{
+    CriticalSectionScoped lock(_critSect);
+    memset(&_recHistogram, 0, sizeof(_recHistogram));
+    memset(&_playHistogram, 0, sizeof(_playHistogram));
+}
+
+// ============================================================================
+//                                     Module
+// ============================================================================
+
+WebRtc_Word32 AudioDeviceVirtualClock::Version(
+    WebRtc_Word8* version,
+    WebRtc_UWord32& remainingBufferInBytes,
+    WebRtc_UWord32& position) const
+{
+    const char ourVersion[] = "AudioDeviceVirtualClock 1.0.0";
+    const WebRtc_UWord32 ourLength = sizeof(ourVersion);
+    if (version == NULL || remainingBufferInBytes < ourLength)
+    {
+        return -1;
+    }
+    memcpy(&version[position], ourVersion, ourLength);
+    remainingBufferInBytes -= (ourLength - 1);
+    position += (ourLength - 1);
+    return 0;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::ChangeUniqueId(const WebRtc_Word32 id)
+{
+    _id = id;
+    return 0;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::TimeUntilNextProcess()
+{
+    // There are no device errors to poll for.
+    return 1000;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::Process()
+{
+    return 0;
+}
+
+// ============================================================================
+//                                       API
+// ============================================================================
+
+WebRtc_Word32 AudioDeviceVirtualClock::ActiveAudioLayer(
+    AudioLayer* audioLayer) const
+{
+    *audioLayer = kDummyAudio;
+    return 0;
+}
+
+AudioDeviceModule::ErrorCode AudioDeviceVirtualClock::LastError() const
+{
+    return kAdmErrNone;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::RegisterEventObserver(
+    AudioDeviceObserver* /*eventCallback*/)
+{
+    // No warnings or errors are ever reported.
+    return 0;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::RegisterAudioCallback(
+    AudioTransport* audioCallback)
+{
+    CriticalSectionScoped lock(_critSectCb);
+    _ptrCbAudioTransport = audioCallback;
+    return 0;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::Init()
+{
+    CriticalSectionScoped lock(_critSect);
+
+    if (_initialized)
+    {
+        return 0;
+    }
+
+    // Normal priority; with an unpaced clock this thread never sleeps.
+    _ptrThread = ThreadWrapper::CreateThread(ThreadFunc, this,
+                                             kNormalPriority,
+                                             "webrtc_audio_module_virtual_clock");
+    if (_ptrThread == NULL)
+    {
+        WEBRTC_TRACE(kTraceCritical, kTraceAudioDevice, _id,
+                     "  failed to create the audio thread");
+        return -1;
+    }
+
+    unsigned int threadID(0);
+    if (!_ptrThread->Start(threadID))
+    {
+        WEBRTC_TRACE(kTraceCritical, kTraceAudioDevice, _id,
+                     "  failed to start the audio thread");
+        delete _ptrThread;
+        _ptrThread = NULL;
+        return -1;
+    }
+
+    _initialized = true;
+    return 0;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::Terminate()
+{
+    ThreadWrapper* tmpThread = NULL;
+    {
+        CriticalSectionScoped lock(_critSect);
+        if (!_initialized)
+        {
+            return 0;
+        }
+        _recording = false;
+        _playing = false;
+        _recIsInitialized = false;
+        _playIsInitialized = false;
+        _initialized = false;
+        tmpThread = _ptrThread;
+        _ptrThread = NULL;
+    }
+
+    if (tmpThread)
+    {
+        tmpThread->SetNotAlive();
+        _wakeEvent.Set();
+        if (tmpThread->Stop())
+        {
+            delete tmpThread;
+        }
+        else
+        {
+            WEBRTC_TRACE(kTraceWarning, kTraceAudioDevice, _id,
+                         "  failed to close down the audio thread");
+        }
+    }
+    return 0;
+}
+
+bool AudioDeviceVirtualClock::Initialized() const
+{
+    CriticalSectionScoped lock(_critSect);
+    return _initialized;
+}
+
+WebRtc_Word16 AudioDeviceVirtualClock::PlayoutDevices()
+{
+    return 1;
+}
+
+WebRtc_Word16 AudioDeviceVirtualClock::RecordingDevices()
+{
+    return 1;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::PlayoutDeviceName(
+    WebRtc_UWord16 index,
+    WebRtc_Word8 name[kAdmMaxDeviceNameSize],
+    WebRtc_Word8 guid[kAdmMaxGuidSize])
+{
+    if (index != 0 || name == NULL)
+    {
+        return -1;
+    }
+    strncpy(name, "virtual clock playout", kAdmMaxDeviceNameSize - 1);
+    name[kAdmMaxDeviceNameSize - 1] = '\0';
+    if (guid != NULL)
+    {
+        memset(guid, 0, kAdmMaxGuidSize);
+    }
+    return 0;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::RecordingDeviceName(
+    WebRtc_UWord16 index,
+    WebRtc_Word8 name[kAdmMaxDeviceNameSize],
+    WebRtc_Word8 guid[kAdmMaxGuidSize])
+{
+    if (index != 0 || name == NULL)
+    {
+        return -1;
+    }
+    strncpy(name, "virtual clock recording", kAdmMaxDeviceNameSize - 1);
+    name[kAdmMaxDeviceNameSize - 1] = '\0';
+    if (guid != NULL)
+    {
+        memset(guid, 0, kAdmMaxGuidSize);
+    }
+    return 0;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::SetPlayoutDevice(WebRtc_UWord16 index)
+{
+    return (index == 0) ? 0 : -1;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::SetPlayoutDevice(
+    WindowsDeviceType /*device*/)
+{
+    return 0;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::SetRecordingDevice(WebRtc_UWord16 index)
+{
+    return (index == 0) ? 0 : -1;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::SetRecordingDevice(
+    WindowsDeviceType /*device*/)
+{
+    return 0;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::PlayoutIsAvailable(bool* available)
+{
+    *available = true;
+    return 0;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::InitPlayout()
+{
+    CriticalSectionScoped lock(_critSect);
+    if (_playing)
+    {
+        return -1;
+    }
+    _playIsInitialized = true;
+    return 0;
+}
+
+bool AudioDeviceVirtualClock::PlayoutIsInitialized() const
+{
+    CriticalSectionScoped lock(_critSect);
+    return _playIsInitialized;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::RecordingIsAvailable(bool* available)
+{
+    *available = true;
+    return 0;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::InitRecording()
+{
+    CriticalSectionScoped lock(_critSect);
+    if (_recording)
+    {
+        return -1;
+    }
+    _recIsInitialized = true;
+    return 0;
+}
+
+bool AudioDeviceVirtualClock::RecordingIsInitialized() const
+{
+    CriticalSectionScoped lock(_critSect);
+    return _recIsInitialized;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::StartPlayout()
+{
+    CriticalSectionScoped lock(_critSect);
+    if (!_initialized || !_playIsInitialized)
+    {
+        return -1;
+    }
+    if (!_playing && !_recording)
+    {
+        RestartPacing();
+    }
+    _playing = true;
+    _wakeEvent.Set();
+    return 0;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::StopPlayout()
+{
+    CriticalSectionScoped lock(_critSect);
+    _playing = false;
+    _playIsInitialized = false;
+    return 0;
+}
+
+bool AudioDeviceVirtualClock::Playing() const
+{
+    CriticalSectionScoped lock(_critSect);
+    return _playing;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::StartRecording()
+{
+    CriticalSectionScoped lock(_critSect);
+    if (!_initialized || !_recIsInitialized)
+    {
+        return -1;
+    }
+    if (!_playing && !_recording)
+    {
+        RestartPacing();
+    }
+    _recording = true;
+    _wakeEvent.Set();
+    return 0;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::StopRecording()
+{
+    CriticalSectionScoped lock(_critSect);
+    _recording = false;
+    _recIsInitialized = false;
+    return 0;
+}
+
+bool AudioDeviceVirtualClock::Recording() const
+{
+    CriticalSectionScoped lock(_critSect);
+    return _recording;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::SetAGC(bool enable)
+{
+    CriticalSectionScoped lock(_critSect);
+    _agc = enable;
+    return 0;
+}
+
+bool AudioDeviceVirtualClock::AGC() const
+{
+    CriticalSectionScoped lock(_critSect);
+    return _agc;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::SetWaveOutVolume(
+    WebRtc_UWord16 /*volumeLeft*/,
+    WebRtc_UWord16 /*volumeRight*/)
+{
+    return -1;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::WaveOutVolume(
+    WebRtc_UWord16* /*volumeLeft*/,
+    WebRtc_UWord16* /*volumeRight*/) const
+{
+    return -1;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::SpeakerIsAvailable(bool* available)
+{
+    *available = true;
+    return 0;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::InitSpeaker()
+{
+    CriticalSectionScoped lock(_critSect);
+    _speakerIsInitialized = true;
+    return 0;
+}
+
+bool AudioDeviceVirtualClock::SpeakerIsInitialized() const
+{
+    CriticalSectionScoped lock(_critSect);
+    return _speakerIsInitialized;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::MicrophoneIsAvailable(bool* available)
+{
+    *available = true;
+    return 0;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::InitMicrophone()
+{
+    CriticalSectionScoped lock(_critSect);
+    _microphoneIsInitialized = true;
+    return 0;
+}
+
+bool AudioDeviceVirtualClock::MicrophoneIsInitialized() const
+{
+    CriticalSectionScoped lock(_critSect);
+    return _microphoneIsInitialized;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::SpeakerVolumeIsAvailable(
+    bool* available)
+{
+    *available = false;
+    return 0;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::SetSpeakerVolume(
+    WebRtc_UWord32 /*volume*/)
+{
+    return -1;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::SpeakerVolume(
+    WebRtc_UWord32* /*volume*/) const
+{
+    return -1;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::MaxSpeakerVolume(
+    WebRtc_UWord32* /*maxVolume*/) const
+{
+    return -1;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::MinSpeakerVolume(
+    WebRtc_UWord32* /*minVolume*/) const
+{
+    return -1;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::SpeakerVolumeStepSize(
+    WebRtc_UWord16* /*stepSize*/) const
+{
+    return -1;
+}
+
+// The microphone volume is kept so that the analog AGC can be exercised; it
+// does not affect the recorded signal.
+
+WebRtc_Word32 AudioDeviceVirtualClock::MicrophoneVolumeIsAvailable(
+    bool* available)
+{
+    *available = true;
+    return 0;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::SetMicrophoneVolume(
+    WebRtc_UWord32 volume)
+{
+    if (volume > MAX_MIC_LEVEL)
+    {
+        return -1;
+    }
+    CriticalSectionScoped lock(_critSect);
+    _micLevel = volume;
+    return 0;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::MicrophoneVolume(
+    WebRtc_UWord32* volume) const
+{
+    CriticalSectionScoped lock(_critSect);
+    *volume = _micLevel;
+    return 0;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::MaxMicrophoneVolume(
+    WebRtc_UWord32* maxVolume) const
+{
+    *maxVolume = MAX_MIC_LEVEL;
+    return 0;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::MinMicrophoneVolume(
+    WebRtc_UWord32* minVolume) const
+{
+    *minVolume = 0;
+    return 0;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::MicrophoneVolumeStepSize(
+    WebRtc_UWord16* stepSize) const
+{
+    *stepSize = 1;
+    return 0;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::SpeakerMuteIsAvailable(bool* available)
+{
+    *available = false;
+    return 0;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::SetSpeakerMute(bool /*enable*/)
+{
+    return -1;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::SpeakerMute(bool* /*enabled*/) const
+{
+    return -1;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::MicrophoneMuteIsAvailable(
+    bool* available)
+{
+    *available = false;
+    return 0;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::SetMicrophoneMute(bool /*enable*/)
+{
+    return -1;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::MicrophoneMute(bool* /*enabled*/) const
+{
+    return -1;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::MicrophoneBoostIsAvailable(
+    bool* available)
+{
+    *available = false;
+    return 0;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::SetMicrophoneBoost(bool /*enable*/)
+{
+    return -1;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::MicrophoneBoost(bool* /*enabled*/) const
+{
+    return -1;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::StereoPlayoutIsAvailable(
+    bool* available) const
+{
+    *available = false;
+    return 0;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::SetStereoPlayout(bool enable)
+{
+    return enable ? -1 : 0;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::StereoPlayout(bool* enabled) const
+{
+    *enabled = false;
+    return 0;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::StereoRecordingIsAvailable(
+    bool* available) const
+{
+    *available = false;
+    return 0;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::SetStereoRecording(bool enable)
+{
+    return enable ? -1 : 0;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::StereoRecording(bool* enabled) const
+{
+    *enabled = false;
+    return 0;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::SetRecordingChannel(
+    const ChannelType /*channel*/)
+{
+    return -1;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::RecordingChannel(
+    ChannelType* channel) const
+{
+    *channel = kChannelBoth;
+    return 0;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::SetPlayoutBuffer(
+    const BufferType type,
+    WebRtc_UWord16 /*sizeMS*/)
+{
+    return (type == kFixedBufferSize) ? 0 : -1;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::PlayoutBuffer(
+    BufferType* type,
+    WebRtc_UWord16* sizeMS) const
+{
+    *type = kFixedBufferSize;
+    *sizeMS = kTickMs;
+    return 0;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::PlayoutDelay(
+    WebRtc_UWord16* delayMS) const
+{
+    *delayMS = 0;
+    return 0;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::RecordingDelay(
+    WebRtc_UWord16* delayMS) const
+{
+    *delayMS = 0;
+    return 0;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::CPULoad(WebRtc_UWord16* load) const
+{
+    *load = 0;
+    return 0;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::StartRawOutputFileRecording(
+    const WebRtc_Word8 /*pcmFileNameUTF8*/[kAdmMaxFileNameSize])
+{
+    return -1;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::StopRawOutputFileRecording()
+{
+    return 0;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::StartRawInputFileRecording(
+    const WebRtc_Word8 /*pcmFileNameUTF8*/[kAdmMaxFileNameSize])
+{
+    return -1;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::StopRawInputFileRecording()
+{
+    return 0;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::SetRecordingSampleRate(
+    const WebRtc_UWord32 samplesPerSec)
+{
+    if (!ValidSampleRate(samplesPerSec))
+    {
+        return -1;
+    }
+    CriticalSectionScoped lock(_critSect);
+    if (_recording)
+    {
+        return -1;
+    }
+    _recSampleRate = samplesPerSec;
+    GenerateRecordingSignal();
+    return 0;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::RecordingSampleRate(
+    WebRtc_UWord32* samplesPerSec) const
+{
+    CriticalSectionScoped lock(_critSect);
+    *samplesPerSec = _recSampleRate;
+    return 0;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::SetPlayoutSampleRate(
+    const WebRtc_UWord32 samplesPerSec)
+{
+    if (!ValidSampleRate(samplesPerSec))
+    {
+        return -1;
+    }
+    CriticalSectionScoped lock(_critSect);
+    if (_playing)
+    {
+        return -1;
+    }
+    _playSampleRate = samplesPerSec;
+    return 0;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::PlayoutSampleRate(
+    WebRtc_UWord32* samplesPerSec) const
+{
+    CriticalSectionScoped lock(_critSect);
+    *samplesPerSec = _playSampleRate;
+    return 0;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::ResetAudioDevice()
+{
+    return 0;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::SetLoudspeakerStatus(bool /*enable*/)
+{
+    return -1;
+}
+
+WebRtc_Word32 AudioDeviceVirtualClock::GetLoudspeakerStatus(
+    bool* /*enabled*/) const
+{
+    return -1;
+}
+
+// ============================================================================
+//                                 Private Methods
+// ============================================================================
+
+bool AudioDeviceVirtualClock::ValidSampleRate(
+    const WebRtc_UWord32 samplesPerSec) const
+{
+    return (samplesPerSec == 8000 || samplesPerSec == 16000 ||
+            samplesPerSec == 32000 || samplesPerSec == 44100 ||
+            samplesPerSec == 48000);
+}
+
+void AudioDeviceVirtualClock::GenerateRecordingSignal()
+{
+    // Rates that are a multiple of 1 kHz hold a whole number of tone periods
+    // per tick, so the same frame can be delivered every time.
+    const WebRtc_UWord32 nSamples = _recSampleRate / 100;
+    for (WebRtc_UWord32 i = 0; i < nSamples; i++)
+    {
+        _recBuffer[i] = static_cast<WebRtc_Word16>(TONE_AMPLITUDE *
+            sin(2.0 * 3.14159265358979 * TONE_FREQUENCY_HZ * i /
+                _recSampleRate));
+    }
+}
+
+void AudioDeviceVirtualClock::RestartPacing()
+{
+    _pacingStart = TickTime::Now();
+    _pacedTicks = 0;
+}
+
+void AudioDeviceVirtualClock::AddToHistogram(TickHistogram* histogram,
+                                             const WebRtc_UWord32 timeUs)
+{
+    int bucket = 0;
+    WebRtc_UWord32 value = timeUs;
+    while (value > 0 && bucket < TickHistogram::kNumBuckets - 1)
+    {
+        value >>= 1;
+        bucket++;
+    }
+    histogram->buckets[bucket]++;
+
+    if (histogram->ticks == 0 || timeUs < histogram->minUs)
+    {
+        histogram->minUs = timeUs;
+    }
+    if (timeUs > histogram->maxUs)
+    {
+        histogram->maxUs = timeUs;
+    }
+    histogram->ticks++;
+    histogram->totalUs += timeUs;
+}
+
+// ============================================================================
+//                                  Thread Methods
+// ============================================================================
+
+bool AudioDeviceVirtualClock::ThreadFunc(void* pThis)
+{
+    return (static_cast<AudioDeviceVirtualClock*>(pThis)->ThreadProcess());
+}
+
+bool AudioDeviceVirtualClock::ThreadProcess()
+{
+    _critSect.Enter();
+
+    const bool recording = _recording;
+    const bool playing = _playing;
+    if (!recording && !playing)
+    {
+        _critSect.Leave();
+        _wakeEvent.Wait(IDLE_WAIT_MS);
+        return true;
+    }
+
+    if (_speed > 0.0f)
+    {
+        // Wait until real time has caught up with the paced virtual time.
+        const WebRtc_Word64 dueUs = static_cast<WebRtc_Word64>(
+            _pacedTicks * (1000.0 * kTickMs) / _speed);
+        const WebRtc_Word64 elapsedUs =
+            (TickTime::Now() - _pacingStart).Microseconds();
+        if (elapsedUs < dueUs)
+        {
+            _critSect.Leave();
+            const WebRtc_Word64 waitMs = (dueUs - elapsedUs + 999) / 1000;
+            _wakeEvent.Wait(static_cast<unsigned long>(waitMs));
+            return true;
+        }
+    }
+    _pacedTicks++;
+    _critSect.Leave();
+
+    RunTick(recording, playing);
+    return true;
+}
+
+void AudioDeviceVirtualClock::RunTick(bool recording, bool playing)
+{
+    _critSect.Enter();
+    const WebRtc_UWord32 recSamples = _recSampleRate / 100;
+    const WebRtc_UWord32 recSampleRate = _recSampleRate;
+    const WebRtc_UWord32 playSamples = _playSampleRate / 100;
+    const WebRtc_UWord32 playSampleRate = _playSampleRate;
+    const WebRtc_UWord32 currentMicLevel = _micLevel;
+    _critSect.Leave();
+
+    WebRtc_UWord32 newMicLevel = 0;
+    WebRtc_UWord32 recTimeUs = 0;
+    WebRtc_UWord32 playTimeUs = 0;
+    {
+        CriticalSectionScoped lock(_critSectCb);
+        if (_ptrCbAudioTransport == NULL)
+        {
+            recording = false;
+            playing = false;
+        }
+
+        if (recording)
+        {
+            const TickTime startTime = TickTime::Now();
+#if (DITECH_VERSION==1)
+            _ptrCbAudioTransport->RecordedDataIsAvailable(
+                reinterpret_cast<const char*>(_recBuffer), recSamples,
+                sizeof(WebRtc_Word16), 1, recSampleRate, 0, 0,
+                currentMicLevel, newMicLevel);
+#endif
+#if (DITECH_VERSION==2)
+            _ptrCbAudioTransport->RecordedDataIsAvailable(
+                reinterpret_cast<const char*>(_recBuffer), recSamples,
+                sizeof(WebRtc_Word16), 1, recSampleRate, 0, 0,
+                currentMicLevel, newMicLevel, false);
+#endif
+            recTimeUs = static_cast<WebRtc_UWord32>(
+                (TickTime::Now() - startTime).Microseconds());
+        }
+
+        if (playing)
+        {
+            const TickTime startTime = TickTime::Now();
+            WebRtc_UWord32 nSamplesOut = 0;
+            _ptrCbAudioTransport->NeedMorePlayData(
+                playSamples, sizeof(WebRtc_Word16), 1, playSampleRate,
+                reinterpret_cast<char*>(_playBuffer), nSamplesOut);
+            playTimeUs = static_cast<WebRtc_UWord32>(
+                (TickTime::Now() - startTime).Microseconds());
+            if (nSamplesOut != playSamples)
+            {
+                WEBRTC_TRACE(kTraceError, kTraceAudioDevice, _id,
+                             "  invalid number of output samples(%d)",
+                             nSamplesOut);
+            }
+        }
+    }
+
+    CriticalSectionScoped lock(_critSect);
+    if (recording)
+    {
+        AddToHistogram(&_recHistogram, recTimeUs);
+        if (_agc && newMicLevel != 0)
+        {
+            _micLevel = newMicLevel;
+        }
+    }
+    if (playing)
+    {
+        AddToHistogram(&_playHistogram, playTimeUs);
+    }
+    _virtualTimeMs += kTickMs;
+}
+
+}  // namespace webrtc
@@ -20,6 +20,7 @@ LOCAL_SRC_FILES := \
     $(call all-proto-files-under, .) \
     audio_buffer.cc \
     audio_processing_impl.cc \
+    debug_dump_writer.cc \
     echo_cancellation_impl.cc \
     echo_control_mobile_impl.cc \
     gain_control_impl.cc \
@@ -27,12 +27,7 @@
 #include "voice_detection_impl.h"
 
 #ifdef WEBRTC_AUDIOPROC_DEBUG_DUMP
-// Files generated at build-time by the protobuf compiler.
-#ifdef WEBRTC_ANDROID
-#include "external/webrtc/src/modules/audio_processing/debug.pb.h"
-#else
-#include "webrtc/audio_processing/debug.pb.h"
-#endif
+#include "debug_dump_writer.h"
 #endif  // WEBRTC_AUDIOPROC_DEBUG_DUMP
 
 namespace webrtc {
@@ -68,8 +63,7 @@ AudioProcessingImpl::AudioProcessingImpl(int id)
       render_audio_(NULL),
       capture_audio_(NULL),
 #ifdef WEBRTC_AUDIOPROC_DEBUG_DUMP
-      debug_file_(FileWrapper::Create()),
-      event_msg_(new audioproc::Event()),
+      debug_writer_(new DebugDumpWriter()),
 #endif
       sample_rate_hz_(kSampleRate16kHz),
       split_sample_rate_hz_(kSampleRate16kHz),
@@ -111,9 +105,7 @@ AudioProcessingImpl::~AudioProcessingImpl() {
   }
 
 #ifdef WEBRTC_AUDIOPROC_DEBUG_DUMP
-  if (debug_file_->Open()) {
-    debug_file_->CloseFile();
-  }
+  debug_writer_->Stop();
 #endif
 
   delete crit_;
@@ -171,11 +163,8 @@ int AudioProcessingImpl::InitializeLocked() {
   }
 
 #ifdef WEBRTC_AUDIOPROC_DEBUG_DUMP
-  if (debug_file_->Open()) {
-    int err = WriteInitMessage();
-    if (err != kNoError) {
-      return err;
-    }
+  if (debug_writer_->is_recording()) {
+    WriteInitMessage();
   }
 #endif
 
@@ -274,16 +263,16 @@ int AudioProcessingImpl::ProcessStream(AudioFrame* frame) {
   }
 
 #ifdef WEBRTC_AUDIOPROC_DEBUG_DUMP
-  if (debug_file_->Open()) {
-    event_msg_->set_type(audioproc::Event::STREAM);
-    audioproc::Stream* msg = event_msg_->mutable_stream();
-    const size_t data_size = sizeof(int16_t) *
-                             frame->_payloadDataLengthInSamples *
-                             frame->_audioChannel;
-    msg->set_input_data(frame->_payloadData, data_size);
-    msg->set_delay(stream_delay_ms_);
-    msg->set_drift(echo_cancellation_->stream_drift_samples());
-    msg->set_level(gain_control_->stream_analog_level());
+  if (debug_writer_->is_recording()) {
+    if (debug_writer_->write_error()) {
+      return kFileError;
+    }
+    debug_writer_->BeginStream(frame->_payloadData,
+                               frame->_payloadDataLengthInSamples *
+                               frame->_audioChannel,
+                               stream_delay_ms_,
+                               echo_cancellation_->stream_drift_samples(),
+                               gain_control_->stream_analog_level());
   }
 #endif
 
@@ -367,16 +356,10 @@ int AudioProcessingImpl::ProcessStream(AudioFrame* frame) {
   capture_audio_->InterleaveTo(frame, data_changed);
 
 #ifdef WEBRTC_AUDIOPROC_DEBUG_DUMP
-  if (debug_file_->Open()) {
-    audioproc::Stream* msg = event_msg_->mutable_stream();
-    const size_t data_size = sizeof(int16_t) *
+  if (debug_writer_->is_recording()) {
+    debug_writer_->EndStream(frame->_payloadData,
                              frame->_payloadDataLengthInSamples *
-                             frame->_audioChannel;
-    msg->set_output_data(frame->_payloadData, data_size);
-    err = WriteMessageToDebugFile();
-    if (err != kNoError) {
-      return err;
-    }
+                             frame->_audioChannel);
   }
 #endif
 
@@ -405,17 +388,13 @@ int AudioProcessingImpl::AnalyzeReverseStream(AudioFrame* frame) {
   }
 
 #ifdef WEBRTC_AUDIOPROC_DEBUG_DUMP
-  if (debug_file_->Open()) {
-    event_msg_->set_type(audioproc::Event::REVERSE_STREAM);
-    audioproc::ReverseStream* msg = event_msg_->mutable_reverse_stream();
-    const size_t data_size = sizeof(int16_t) *
-                             frame->_payloadDataLengthInSamples *
-                             frame->_audioChannel;
-    msg->set_data(frame->_payloadData, data_size);
-    err = WriteMessageToDebugFile();
-    if (err != kNoError) {
-      return err;
+  if (debug_writer_->is_recording()) {
+    if (debug_writer_->write_error()) {
+      return kFileError;
     }
+    debug_writer_->WriteReverseStream(frame->_payloadData,
+                                      frame->_payloadDataLengthInSamples *
+                                      frame->_audioChannel);
   }
 #endif
 
@@ -583,6 +562,14 @@ bool AudioProcessingImpl::was_stream_delay_set() const {
   return was_stream_delay_set_;
 }
 
+int AudioProcessingImpl::debug_dump_dropped_events() const {
+#ifdef WEBRTC_AUDIOPROC_DEBUG_DUMP
+  return debug_writer_->dropped_events();
+#else
+  return 0;
+#endif
+}
+
 int AudioProcessingImpl::StartDebugRecording(
     const char filename[AudioProcessing::kMaxFilenameSize]) {
   CriticalSectionScoped crit_scoped(*crit_);
@@ -593,22 +580,12 @@ int AudioProcessingImpl::StartDebugRecording(
   }
 
 #ifdef WEBRTC_AUDIOPROC_DEBUG_DUMP
-  // Stop any ongoing recording.
-  if (debug_file_->Open()) {
-    if (debug_file_->CloseFile() == -1) {
-      return kFileError;
-    }
-  }
-
-  if (debug_file_->OpenFile(filename, false) == -1) {
-    debug_file_->CloseFile();
+  // Any ongoing recording is stopped by Start().
+  if (!debug_writer_->Start(filename)) {
     return kFileError;
   }
 
-  int err = WriteInitMessage();
-  if (err != kNoError) {
-    return err;
-  }
+  WriteInitMessage();
   return kNoError;
 #else
   return kUnsupportedFunctionError;
@@ -620,10 +597,8 @@ int AudioProcessingImpl::StopDebugRecording() {
 
 #ifdef WEBRTC_AUDIOPROC_DEBUG_DUMP
   // We just return if recording hasn't started.
-  if (debug_file_->Open()) {
-    if (debug_file_->CloseFile() == -1) {
-      return kFileError;
-    }
+  if (!debug_writer_->Stop()) {
+    return kFileError;
   }
   return kNoError;
 #else
@@ -767,48 +742,12 @@ bool AudioProcessingImpl::analysis_needed(bool stream_data_changed) const {
 }
 
 #ifdef WEBRTC_AUDIOPROC_DEBUG_DUMP
-int AudioProcessingImpl::WriteMessageToDebugFile() {
-  int32_t size = event_msg_->ByteSize();
-  if (size <= 0) {
-    return kUnspecifiedError;
-  }
-#if defined(WEBRTC_BIG_ENDIAN)
-  // TODO(ajm): Use little-endian "on the wire". For the moment, we can be
-  //            pretty safe in assuming little-endian.
-#endif
-
-  if (!event_msg_->SerializeToString(&event_str_)) {
-    return kUnspecifiedError;
-  }
-
-  // Write message preceded by its size.
-  if (!debug_file_->Write(&size, sizeof(int32_t))) {
-    return kFileError;
-  }
-  if (!debug_file_->Write(event_str_.data(), event_str_.length())) {
-    return kFileError;
-  }
-
-  event_msg_->Clear();
-
-  return 0;
-}
-
-int AudioProcessingImpl::WriteInitMessage() {
-  event_msg_->set_type(audioproc::Event::INIT);
-  audioproc::Init* msg = event_msg_->mutable_init();
-  msg->set_sample_rate(sample_rate_hz_);
-  msg->set_device_sample_rate(echo_cancellation_->device_sample_rate_hz());
-  msg->set_num_input_channels(num_input_channels_);
-  msg->set_num_output_channels(num_output_channels_);
-  msg->set_num_reverse_channels(num_reverse_channels_);
-
-  int err = WriteMessageToDebugFile();
-  if (err != kNoError) {
-    return err;
-  }
-
-  return kNoError;
+void AudioProcessingImpl::WriteInitMessage() {
+  debug_writer_->WriteInit(sample_rate_hz_,
+                           echo_cancellation_->device_sample_rate_hz(),
+                           num_input_channels_,
+                           num_output_channels_,
+                           num_reverse_channels_);
 }
 #endif  // WEBRTC_AUDIOPROC_DEBUG_DUMP
 }  // namespace webrtc
@@ -14,16 +14,15 @@
 #include "audio_processing.h"
 
 #include <list>
-#include <string>
 
 #include "scoped_ptr.h"
 
 namespace webrtc {
 class AudioBuffer;
 class CriticalSectionWrapper;
+class DebugDumpWriter;
 class EchoCancellationImpl;
 class EchoControlMobileImpl;
-class FileWrapper;
 class GainControlImpl;
 class HighPassFilterImpl;
 class LevelEstimatorImpl;
@@ -31,14 +30,6 @@ class NoiseSuppressionImpl;
 class ProcessingComponent;
 class VoiceDetectionImpl;
 
-#ifdef WEBRTC_AUDIOPROC_DEBUG_DUMP
-namespace audioproc {
-
-class Event;
-
-}  // namespace audioproc
-#endif
-
 class AudioProcessingImpl : public AudioProcessing {
  public:
   enum {
@@ -55,6 +46,11 @@ class AudioProcessingImpl : public AudioProcessing {
   int split_sample_rate_hz() const;
   bool was_stream_delay_set() const;
 
+  // Number of debug dump events dropped because the background writer could
+  // not keep up, since the last StartDebugRecording(). Always zero when
+  // debug dumps are not compiled in.
+  int debug_dump_dropped_events() const;
+
   // AudioProcessing methods.
   virtual int Initialize();
   virtual int InitializeLocked();
@@ -112,13 +108,10 @@ class AudioProcessingImpl : public AudioProcessing {
   AudioBuffer* render_audio_;
   AudioBuffer* capture_audio_;
 #ifdef WEBRTC_AUDIOPROC_DEBUG_DUMP
-  // TODO(andrew): make this more graceful. Ideally we would split this stuff
-  // out into a separate class with an "enabled" and "disabled" implementation.
-  int WriteMessageToDebugFile();
-  int WriteInitMessage();
-  scoped_ptr<FileWrapper> debug_file_;
-  scoped_ptr<audioproc::Event> event_msg_; // Protobuf message.
-  std::string event_str_; // Memory for protobuf serialization.
+  // Serialization and file writes happen on the writer's own thread; the
+  // audio threads only queue raw frames.
+  void WriteInitMessage();
+  scoped_ptr<DebugDumpWriter> debug_writer_;
 #endif
 
   int sample_rate_hz_;
@@ -0,0 +1,370 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "debug_dump_writer.h"
+
+#include <assert.h>
+#include <string.h>
+
+#include "condition_variable_wrapper.h"
+#include "critical_section_wrapper.h"
+#include "event_wrapper.h"
+#include "file_wrapper.h"
+#include "thread_wrapper.h"
+
+// Files generated at build-time by the protobuf compiler.
+#ifdef WEBRTC_ANDROID
+#include "external/webrtc/src/modules/audio_processing/debug.pb.h"
+#else
+#include "webrtc/audio_processing/debug.pb.h"
+#endif
+
+namespace webrtc {
+namespace {
+// Upper bound on how long the writer thread sleeps between queue checks.
+const unsigned long kWriterWaitMs = 100;
+// ThreadWrapper::Stop() gives up if the thread does not exit in time, e.g.
+// when it is blocked in a slow file write.
+const int kStopAttempts = 5;
+}  // namespace
+
+struct DebugDumpWriter::EventSlot {
+  audioproc::Event::Type type;
+
+  // INIT
+  int sample_rate;
+  int device_sample_rate;
+  int num_input_channels;
+  int num_output_channels;
+  int num_reverse_channels;
+
+  // STREAM
+  int delay;
+  int drift;
+  int level;
+
+  // REVERSE_STREAM uses |input| only.
+  int input_length;
+  int output_length;
+  int16_t input[kMaxSamplesPerFrame];
+  int16_t output[kMaxSamplesPerFrame];
+};
+
+DebugDumpWriter::DebugDumpWriter()
+    : debug_file_(FileWrapper::Create()),
+      crit_(CriticalSectionWrapper::CreateCriticalSection()),
+      space_available_(ConditionVariableWrapper::CreateConditionVariable()),
+      wake_event_(EventWrapper::Create()),
+      thread_(NULL),
+      event_msg_(new audioproc::Event()),
+      slots_(new EventSlot[kQueueSize]),
+      read_pos_(0),
+      write_pos_(0),
+      count_(0),
+      pending_stream_(new EventSlot),
+      pending_stream_valid_(false),
+      recording_(false),
+      write_error_(false),
+      dropped_events_(0),
+      written_events_(0) {
+}
+
+DebugDumpWriter::~DebugDumpWriter() {
+  Stop();
+}
+
+bool DebugDumpWriter::Start(const char* filename) {
+  if (!Stop()) {
+    return false;
+  }
+
+  if (debug_file_->OpenFile(filename, false) == -1) {
+    debug_file_->CloseFile();
+    return false;
+  }
+
+  {
+    CriticalSectionScoped crit_scoped(*crit_);
+    read_pos_ = 0;
+    write_pos_ = 0;
+    count_ = 0;
+    pending_stream_valid_ = false;
+    write_error_ = false;
+    dropped_events_ = 0;
+    written_events_ = 0;
+  }
+
+  thread_ = ThreadWrapper::CreateThread(Run, this, kLowPriority,
+                                        "AudioProcDebugWriter");
+  unsigned int id = 0;
+  if (thread_ == NULL || !thread_->Start(id)) {
+    delete thread_;
+    thread_ = NULL;
+    debug_file_->CloseFile();
+    return false;
+  }
+
+  CriticalSectionScoped crit_scoped(*crit_);
+  recording_ = true;
+  return true;
+}
+
+bool DebugDumpWriter::Stop() {
+  {
+    CriticalSectionScoped crit_scoped(*crit_);
+    // |thread_| is left if an earlier Stop() failed to stop it.
+    if (!recording_ && thread_ == NULL) {
+      return true;
+    }
+    recording_ = false;
+    pending_stream_valid_ = false;
+    // Release a producer blocked in Reserve(); it will see |recording_|.
+    space_available_->WakeAll();
+  }
+
+  if (thread_ != NULL) {
+    thread_->SetNotAlive();
+    bool stopped = false;
+    for (int i = 0; i < kStopAttempts && !stopped; i++) {
+      wake_event_->Set();
+      stopped = thread_->Stop();
+    }
+    if (!stopped) {
+      // The thread may still use the queue and the file. Keep it, so that
+      // the next Stop() or Start() tries again.
+      return false;
+    }
+    delete thread_;
+    thread_ = NULL;
+  }
+
+  // The writer thread is gone; flush whatever it left behind.
+  Drain();
+
+  if (debug_file_->Open()) {
+    if (debug_file_->CloseFile() == -1) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool DebugDumpWriter::is_recording() const {
+  CriticalSectionScoped crit_scoped(*crit_);
+  return recording_;
+}
+
+bool DebugDumpWriter::write_error() const {
+  CriticalSectionScoped crit_scoped(*crit_);
+  return write_error_;
+}
+
+int DebugDumpWriter::dropped_events() const {
+  CriticalSectionScoped crit_scoped(*crit_);
+  return dropped_events_;
+}
+
+int DebugDumpWriter::written_events() const {
+  CriticalSectionScoped crit_scoped(*crit_);
+  return written_events_;
+}
+
+void DebugDumpWriter::WriteInit(int sample_rate,
+                                int device_sample_rate,
+                                int num_input_channels,
+                                int num_output_channels,
+                                int num_reverse_channels) {
+  EventSlot* slot = Reserve(true);
+  if (slot == NULL) {
+    return;
+  }
+  slot->type = audioproc::Event::INIT;
+  slot->sample_rate = sample_rate;
+  slot->device_sample_rate = device_sample_rate;
+  slot->num_input_channels = num_input_channels;
+  slot->num_output_channels = num_output_channels;
+  slot->num_reverse_channels = num_reverse_channels;
+  Commit();
+}
+
+void DebugDumpWriter::WriteReverseStream(const int16_t* data, int length) {
+  assert(length <= kMaxSamplesPerFrame);
+  EventSlot* slot = Reserve(false);
+  if (slot == NULL) {
+    return;
+  }
+  slot->type = audioproc::Event::REVERSE_STREAM;
+  slot->input_length = length;
+  memcpy(slot->input, data, sizeof(int16_t) * length);
+  Commit();
+}
+
+void DebugDumpWriter::BeginStream(const int16_t* input,
+                                  int length,
+                                  int delay,
+                                  int drift,
+                                  int level) {
+  assert(length <= kMaxSamplesPerFrame);
+  EventSlot* slot = pending_stream_.get();
+  slot->type = audioproc::Event::STREAM;
+  slot->input_length = length;
+  memcpy(slot->input, input, sizeof(int16_t) * length);
+  slot->delay = delay;
+  slot->drift = drift;
+  slot->level = level;
+
+  CriticalSectionScoped crit_scoped(*crit_);
+  pending_stream_valid_ = true;
+}
+
+void DebugDumpWriter::EndStream(const int16_t* output, int length) {
+  assert(length <= kMaxSamplesPerFrame);
+  {
+    CriticalSectionScoped crit_scoped(*crit_);
+    if (!pending_stream_valid_) {
+      return;
+    }
+    pending_stream_valid_ = false;
+  }
+
+  EventSlot* slot = Reserve(false);
+  if (slot == NULL) {
+    return;
+  }
+  const EventSlot& pending = *pending_stream_;
+  slot->type = audioproc::Event::STREAM;
+  slot->input_length = pending.input_length;
+  memcpy(slot->input, pending.input, sizeof(int16_t) * pending.input_length);
+  slot->delay = pending.delay;
+  slot->drift = pending.drift;
+  slot->level = pending.level;
+  slot->output_length = length;
+  memcpy(slot->output, output, sizeof(int16_t) * length);
+  Commit();
+}
+
+DebugDumpWriter::EventSlot* DebugDumpWriter::Reserve(bool wait_for_space) {
+  CriticalSectionScoped crit_scoped(*crit_);
+  if (!recording_) {
+    return NULL;
+  }
+  while (count_ == kQueueSize) {
+    if (!wait_for_space) {
+      dropped_events_++;
+      return NULL;
+    }
+    space_available_->SleepCS(*crit_);
+    if (!recording_) {
+      return NULL;
+    }
+  }
+  // Only the producer advances |write_pos_|, and the consumer never touches
+  // slots beyond |count_|, so the slot can be filled without the lock.
+  return &slots_[write_pos_];
+}
+
+void DebugDumpWriter::Commit() {
+  {
+    CriticalSectionScoped crit_scoped(*crit_);
+    write_pos_ = (write_pos_ + 1) % kQueueSize;
+    count_++;
+  }
+  wake_event_->Set();
+}
+
+bool DebugDumpWriter::Run(void* obj) {
+  return static_cast<DebugDumpWriter*>(obj)->Process();
+}
+
+bool DebugDumpWriter::Process() {
+  wake_event_->Wait(kWriterWaitMs);
+  Drain();
+  return true;
+}
+
+void DebugDumpWriter::Drain() {
+  while (true) {
+    const EventSlot* slot = NULL;
+    {
+      CriticalSectionScoped crit_scoped(*crit_);
+      if (count_ == 0) {
+        break;
+      }
+      slot = &slots_[read_pos_];
+    }
+
+    // The slot stays counted while it is being written, which keeps the
+    // producer away from it.
+    const bool ok = WriteSlot(*slot);
+
+    CriticalSectionScoped crit_scoped(*crit_);
+    read_pos_ = (read_pos_ + 1) % kQueueSize;
+    count_--;
+    if (ok) {
+      written_events_++;
+    } else {
+      write_error_ = true;
+    }
+    space_available_->Wake();
+  }
+}
+
+bool DebugDumpWriter::WriteSlot(const EventSlot& slot) {
+  event_msg_->Clear();
+  event_msg_->set_type(slot.type);
+  switch (slot.type) {
+    case audioproc::Event::INIT: {
+      audioproc::Init* msg = event_msg_->mutable_init();
+      msg->set_sample_rate(slot.sample_rate);
+      msg->set_device_sample_rate(slot.device_sample_rate);
+      msg->set_num_input_channels(slot.num_input_channels);
+      msg->set_num_output_channels(slot.num_output_channels);
+      msg->set_num_reverse_channels(slot.num_reverse_channels);
+      break;
+    }
+    case audioproc::Event::REVERSE_STREAM: {
+      audioproc::ReverseStream* msg = event_msg_->mutable_reverse_stream();
+      msg->set_data(slot.input, sizeof(int16_t) * slot.input_length);
+      break;
+    }
+    case audioproc::Event::STREAM: {
+      audioproc::Stream* msg = event_msg_->mutable_stream();
+      msg->set_input_data(slot.input, sizeof(int16_t) * slot.input_length);
+      msg->set_output_data(slot.output, sizeof(int16_t) * slot.output_length);
+      msg->set_delay(slot.delay);
+      msg->set_drift(slot.drift);
+      msg->set_level(slot.level);
+      break;
+    }
+  }
+
+  int32_t size = event_msg_->ByteSize();
+  if (size <= 0) {
+    return false;
+  }
+#if defined(WEBRTC_BIG_ENDIAN)
+  // TODO(ajm): Use little-endian "on the wire". For the moment, we can be
+  //            pretty safe in assuming little-endian.
+#endif
+
+  if (!event_msg_->SerializeToString(&event_str_)) {
+    return false;
+  }
+
+  // Write message preceded by its size.
+  if (!debug_file_->Write(&size, sizeof(int32_t))) {
+    return false;
+  }
+  if (!debug_file_->Write(event_str_.data(), event_str_.length())) {
+    return false;
+  }
+  return true;
+}
+}  // namespace webrtc
@@ -0,0 +1,136 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_AUDIO_PROCESSING_MAIN_SOURCE_DEBUG_DUMP_WRITER_H_
+#define WEBRTC_MODULES_AUDIO_PROCESSING_MAIN_SOURCE_DEBUG_DUMP_WRITER_H_
+
+#include <string>
+
+#include "scoped_ptr.h"
+#include "typedefs.h"
+
+namespace webrtc {
+class ConditionVariableWrapper;
+class CriticalSectionWrapper;
+class EventWrapper;
+class FileWrapper;
+class ThreadWrapper;
+
+namespace audioproc {
+
+class Event;
+
+}  // namespace audioproc
+
+// Writes audioproc::Event messages to a debug file on a background thread.
+//
+// The capture and render threads only copy raw samples and metadata into a
+// bounded queue of preallocated slots; protobuf serialization and file I/O
+// happen on the writer thread. When the queue is full, stream events are
+// dropped and counted rather than blocking the real-time threads. The file
+// format is unchanged, so unpack_aecdump reads the output as before.
+class DebugDumpWriter {
+ public:
+  enum {
+    // 32 kHz stereo, 10 ms.
+    kMaxSamplesPerFrame = 640,
+    // About one second of capture and render events at 10 ms.
+    kQueueSize = 200
+  };
+
+  DebugDumpWriter();
+  ~DebugDumpWriter();
+
+  // Opens |filename| and starts the writer thread. Any ongoing recording is
+  // stopped first. Returns false on failure.
+  bool Start(const char* filename);
+
+  // Writes all queued events, stops the writer thread and closes the file.
+  // Returns false if the writer thread did not stop or the file could not be
+  // closed; a failed Stop() can be retried. It is fine to call Stop() when no
+  // recording is active.
+  bool Stop();
+
+  bool is_recording() const;
+
+  // Returns true if a write to the file has failed since Start().
+  bool write_error() const;
+
+  // Queues an INIT event. Init events are never dropped; the caller blocks
+  // until a slot is free. They only occur on reconfiguration.
+  void WriteInit(int sample_rate,
+                 int device_sample_rate,
+                 int num_input_channels,
+                 int num_output_channels,
+                 int num_reverse_channels);
+
+  // Queues a REVERSE_STREAM event holding |length| interleaved samples.
+  void WriteReverseStream(const int16_t* data, int length);
+
+  // A STREAM event is recorded in two steps, since the input is only known
+  // before processing and the output after. BeginStream() stages the input
+  // and metadata; EndStream() adds the output and queues the event.
+  void BeginStream(const int16_t* input,
+                   int length,
+                   int delay,
+                   int drift,
+                   int level);
+  void EndStream(const int16_t* output, int length);
+
+  // Number of events dropped because the queue was full, and the number of
+  // events written to file, since Start().
+  int dropped_events() const;
+  int written_events() const;
+
+ private:
+  struct EventSlot;
+
+  static bool Run(void* obj);
+  bool Process();
+
+  // Returns a free slot to fill, or NULL if the queue is full. Must be
+  // followed by Commit() when a slot is returned.
+  EventSlot* Reserve(bool wait_for_space);
+  void Commit();
+
+  // Writes all queued events. Called on the writer thread, or on the caller
+  // thread once the writer thread has stopped.
+  void Drain();
+  bool WriteSlot(const EventSlot& slot);
+
+  scoped_ptr<FileWrapper> debug_file_;
+  scoped_ptr<CriticalSectionWrapper> crit_;
+  scoped_ptr<ConditionVariableWrapper> space_available_;
+  scoped_ptr<EventWrapper> wake_event_;
+  ThreadWrapper* thread_;
+
+  // Only touched by the writer thread (or by Stop() once it has exited).
+  scoped_ptr<audioproc::Event> event_msg_;
+  std::string event_str_;
+
+  scoped_array<EventSlot> slots_;
+  int read_pos_;
+  int write_pos_;
+  int count_;
+
+  // Stream event staged by BeginStream(). Only the capture thread touches
+  // the slot; |pending_stream_valid_| is protected by |crit_|, since Stop()
+  // clears it.
+  scoped_ptr<EventSlot> pending_stream_;
+  bool pending_stream_valid_;
+
+  bool recording_;
+  bool write_error_;
+  int dropped_events_;
+  int written_events_;
+};
+}  // namespace webrtc
+
+#endif  // WEBRTC_MODULES_AUDIO_PROCESSING_MAIN_SOURCE_DEBUG_DUMP_WRITER_H_
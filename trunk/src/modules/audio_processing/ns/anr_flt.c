@@ -20,6 +20,8 @@
 #include "vad.h"
 #include "anr_tab.h"
 #include "anr_math.h"
+#include "typedefs.h"
+#include "ns_core.h"
 
 void anr_flt (
 ANR_STATE_FLT *pANRState,
@@ -30,14 +32,8 @@ ANR_STATE_FLT *pANRStateHc,
 int  hc_flag
 )
 {
-    int   i;
-    FLOAT  stemp1;
-    FLOAT  ltemp, ltemp1, ltemp2;
-   
-	  
-
     FLOAT  fThreshold[NUM_CRITICAL_BAND]; 
-    FLOAT  flamda, falpha, fbeta;
+    FLOAT  flamda;
     FLOAT  ftmp_mag[FFTLENGTH/2+1];
 
     FLOAT  *pfmag;
@@ -81,13 +77,7 @@ int  hc_flag
       /* if non active speech (silence or background noise) : vad_flag = 32768 or 24576 */
       /* pANRState->fest_noise[i] = pANRState->fest_noise[i]*(1-flamda) + fmag[i]*flamda */
 
-       stemp1 = (F)1.0 - flamda;
-       for (i=0; i< FFTLENGTH/2+1; i++)
-       {
-           ltemp1  = ptrANRState->fest_noise[i] * stemp1;
-           ltemp2 =  pfmag[i] * flamda;
-           ptrANRState->fest_noise[i] = ltemp1 + ltemp2;
-       }
+       WebRtcNs_UpdateNoise (ptrANRState->fest_noise, pfmag, flamda);
     }
 
     if (!hc_flag)
@@ -95,15 +85,7 @@ int  hc_flag
       /*-------------------------------*/
       /* Initial Masking Curve         */
       /*-------------------------------*/
-       for (i= 0; i < FFTLENGTH/2+1; i++ )
-       {
-           ltemp1 = fmag[i] - ptrANRState->fest_noise[i];
-		       ftmp_mag[i] = (F)0.0;
-           if (ltemp1 > (F)0.0)
-           {
-              ftmp_mag[i] = fmag[i] - ptrANRState->fest_noise[i];
-           }
-       }
+       WebRtcNs_NoiseResidual (fmag, ptrANRState->fest_noise, ftmp_mag);
     }
 
     fix_compute_mask_threshold_flt (ftmp_mag, fThreshold);
@@ -112,26 +94,8 @@ int  hc_flag
     fix_get_alpha_beta_flt (fThreshold, ptrANRState->fall_alpha, ptrANRState->fall_beta);
 
    /* apply gain function */
-    for (i=0; i< FFTLENGTH/2+1; i++)
-    {
-        falpha = ptrANRState->fall_alpha[i];
-        fbeta  = ptrANRState->fall_beta[i];
-
-        stemp1 = falpha + fbeta;
-        ltemp1 = ptrANRState->fest_noise[i] * stemp1;
-
-        ltemp  = ltemp1 - pfmag[i];
-
-        if (ltemp < (F)0.0)
-        {
-           ltemp1 = ptrANRState->fest_noise[i] * falpha; 
-           pfmag[i] -= ltemp1;
-        }
-        else
-        {
-           pfmag[i] = ptrANRState->fest_noise[i] * fbeta;
-        }
-    }
+    WebRtcNs_SpectralSubtraction (ptrANRState->fest_noise, ptrANRState->fall_alpha,
+                                  ptrANRState->fall_beta, pfmag);
 
    /* 2nd masking curve computation */
     fix_compute_mask_threshold_flt (pfmag, fThreshold);
@@ -147,26 +111,7 @@ int  hc_flag
    /*----------------------------------------------------*/
     if (! ptrANRState->bypass_flag)
 	{
-       if ((ptrANRState->anr_cfg).ss_flag)
-       {
-          buff[0] = ptrANRState->spec_gain[0] * buff[0];
-          buff[1] = ptrANRState->spec_gain[FFTLENGTH/2] * buff[1];
-          for (i = 1; i < FFTLENGTH/2; i++)
-          {
-              buff[2*i]   = ptrANRState->spec_gain[i] * buff[2*i];
-              buff[2*i+1] = ptrANRState->spec_gain[i] * buff[2*i+1];
-          }
-       }
-       else
-       {
-          buff[0] = ptrANRState->spec_gain[0] * buff[0];
-          buff[1] = ptrANRState->spec_gain[FFTLENGTH/2] * buff[1];
-          for (i = 1; i < FFTLENGTH/2; i++)
-          {
-              buff[2*i]   = ptrANRState->spec_gain[i] * buff[2*i];
-              buff[2*i+1] = ptrANRState->spec_gain[i] * buff[2*i+1];
-          }
-       }
+       WebRtcNs_ApplySpectralGain (buff, ptrANRState->spec_gain);
 	}
 
     return;
@@ -17,11 +17,106 @@
 #include "windows_private.h"
 #include "fft4g.h"
 #include "signal_processing_library.h"
+#include "system_wrappers/interface/cpu_features_wrapper.h"
 #if (DITECH_VERSION==DITECH_RELEASE_VERSION)
 static void buffer_write(Buffer *buffer,float *inSpeech,int num);
 static void buffer_read(Buffer *buffer,float *outSpeech,int num);
 static void buffer_init(Buffer *buffer);
 static void upsample_lp_filter(short *buf,filter_state  *filter_s);
+
+// Declare function pointers.
+WebRtcNs_AnalysisWindow_t WebRtcNs_AnalysisWindow;
+WebRtcNs_PowerSpectrum_t WebRtcNs_PowerSpectrum;
+WebRtcNs_UpdateNoise_t WebRtcNs_UpdateNoise;
+WebRtcNs_NoiseResidual_t WebRtcNs_NoiseResidual;
+WebRtcNs_SpectralSubtraction_t WebRtcNs_SpectralSubtraction;
+WebRtcNs_ApplySpectralGain_t WebRtcNs_ApplySpectralGain;
+WebRtcNs_OverlapAdd_t WebRtcNs_OverlapAdd;
+
+static void AnalysisWindowC(float* frame, int len) {
+  const int n = len >> 1;
+  int i;
+
+  for (i = 0; i < n; i++) {
+    frame[i] = tri_win_flt[i] * frame[i];
+    frame[i + n] = tri_win_flt[n - 1 - i] * frame[i + n];
+  }
+}
+
+static void PowerSpectrumC(const float* fft, float* magn, int len) {
+  int i;
+
+  // DC and Nyquist are packed into the first two elements.
+  magn[0] = fft[0] * fft[0];
+  magn[len / 2] = fft[1] * fft[1];
+  for (i = 1; i < len / 2; i++) {
+    magn[i] = fft[2 * i] * fft[2 * i] + fft[2 * i + 1] * fft[2 * i + 1];
+  }
+}
+
+static void UpdateNoiseC(float* noise, const float* magn, float lambda) {
+  const float one_minus_lambda = 1.0f - lambda;
+  int i;
+
+  for (i = 0; i < FFTLENGTH / 2 + 1; i++) {
+    noise[i] = noise[i] * one_minus_lambda + magn[i] * lambda;
+  }
+}
+
+static void NoiseResidualC(const float* magn, const float* noise,
+                           float* residual) {
+  int i;
+
+  for (i = 0; i < FFTLENGTH / 2 + 1; i++) {
+    const float diff = magn[i] - noise[i];
+    residual[i] = diff > 0.0f ? diff : 0.0f;
+  }
+}
+
+static void SpectralSubtractionC(const float* noise, const float* alpha,
+                                 const float* beta, float* magn) {
+  int i;
+
+  for (i = 0; i < FFTLENGTH / 2 + 1; i++) {
+    if (noise[i] * (alpha[i] + beta[i]) - magn[i] < 0.0f) {
+      magn[i] -= noise[i] * alpha[i];
+    } else {
+      magn[i] = noise[i] * beta[i];
+    }
+  }
+}
+
+static void ApplySpectralGainC(float* fft, const float* gain) {
+  int i;
+
+  fft[0] = gain[0] * fft[0];
+  fft[1] = gain[FFTLENGTH / 2] * fft[1];
+  for (i = 1; i < FFTLENGTH / 2; i++) {
+    fft[2 * i] = gain[i] * fft[2 * i];
+    fft[2 * i + 1] = gain[i] * fft[2 * i + 1];
+  }
+}
+
+static void OverlapAddC(float* olp, float* frame, float* out) {
+  int i;
+
+  // Undo the analysis window and apply the rising slope of the synthesis
+  // window, then add the tail of the previous frame.
+  for (i = 0; i < LOOK_AHEAD; i++) {
+    frame[HIST_SIZE + i] = undo_plus_tri_win_flt[i] * frame[HIST_SIZE + i] +
+        olp[i];
+  }
+  // Undo the analysis window over the flat part of the synthesis window.
+  for (i = 0; i < FRAME_SIZE - OLP_SIZE; i++) {
+    frame[HIST_SIZE + LOOK_AHEAD + i] =
+        undo_win_flt[i] * frame[HIST_SIZE + LOOK_AHEAD + i];
+  }
+  // Keep the falling slope for the next frame.
+  for (i = 0; i < OLP_SIZE; i++) {
+    olp[i] = undo_plus_tri_win_ola_flt[i] * frame[HIST_SIZE + FRAME_SIZE + i];
+  }
+  memcpy(out, &frame[HIST_SIZE], sizeof(float) * FRAME_SIZE);
+}
 #endif
 // Set Feature Extraction Parameters
 void WebRtcNs_set_feature_extraction_parameters(NSinst_t* inst) {
@@ -97,6 +192,21 @@ int WebRtcNs_InitCore(NSinst_t* inst, WebRtc_UWord32 fs) {
   SYN_init_FLT(&inst->synState);
   buffer_init(&inst->vadBuffer);
   buffer_init(&inst->anrOutBuffer);
+
+  // Initialize function pointers.
+  WebRtcNs_AnalysisWindow = AnalysisWindowC;
+  WebRtcNs_PowerSpectrum = PowerSpectrumC;
+  WebRtcNs_UpdateNoise = UpdateNoiseC;
+  WebRtcNs_NoiseResidual = NoiseResidualC;
+  WebRtcNs_SpectralSubtraction = SpectralSubtractionC;
+  WebRtcNs_ApplySpectralGain = ApplySpectralGainC;
+  WebRtcNs_OverlapAdd = OverlapAddC;
+
+  if (WebRtc_GetCPUInfo(kSSE2)) {
+#if defined(WEBRTC_USE_SSE2)
+    WebRtcNs_InitSSE2();
+#endif
+  }
 #endif
   inst->windShift = 0;
   if (fs == 8000) {
@@ -209,6 +209,53 @@ int WebRtcNs_ProcessCore(NSinst_t* inst,
                          short* outFrameLow,
                          short* outFrameHigh);
 
+#if (DITECH_VERSION == DITECH_RELEASE_VERSION)
+/****************************************************************************
+ * Some function pointers, for the per-bin loops of WebRtcNs_ProcessCore
+ * shared by SSE2 and generic C code. All of them work on the 256-point
+ * (FFTLENGTH) analysis frame.
+ */
+// Apply the triangular analysis window to a frame of |len| samples.
+typedef void (*WebRtcNs_AnalysisWindow_t)(float* frame, int len);
+extern WebRtcNs_AnalysisWindow_t WebRtcNs_AnalysisWindow;
+
+// Compute the |len| / 2 + 1 bin power spectrum of a packed real FFT.
+typedef void (*WebRtcNs_PowerSpectrum_t)(const float* fft, float* magn,
+                                         int len);
+extern WebRtcNs_PowerSpectrum_t WebRtcNs_PowerSpectrum;
+
+// Smooth the noise estimate towards |magn| with forgetting factor |lambda|.
+typedef void (*WebRtcNs_UpdateNoise_t)(float* noise, const float* magn,
+                                       float lambda);
+extern WebRtcNs_UpdateNoise_t WebRtcNs_UpdateNoise;
+
+// Compute the part of |magn| above the noise estimate, floored at zero.
+typedef void (*WebRtcNs_NoiseResidual_t)(const float* magn,
+                                         const float* noise,
+                                         float* residual);
+extern WebRtcNs_NoiseResidual_t WebRtcNs_NoiseResidual;
+
+// Apply the over/under-subtraction gain function given by |alpha| and
+// |beta| to |magn|.
+typedef void (*WebRtcNs_SpectralSubtraction_t)(const float* noise,
+                                               const float* alpha,
+                                               const float* beta,
+                                               float* magn);
+extern WebRtcNs_SpectralSubtraction_t WebRtcNs_SpectralSubtraction;
+
+// Scale each bin of a packed real FFT by |gain|.
+typedef void (*WebRtcNs_ApplySpectralGain_t)(float* fft, const float* gain);
+extern WebRtcNs_ApplySpectralGain_t WebRtcNs_ApplySpectralGain;
+
+// Undo the analysis window, overlap-add with |olp| and read out one frame.
+typedef void (*WebRtcNs_OverlapAdd_t)(float* olp, float* frame, float* out);
+extern WebRtcNs_OverlapAdd_t WebRtcNs_OverlapAdd;
+
+/****************************************************************************
+ * Initialization of the above function pointers for SSE2.
+ */
+void WebRtcNs_InitSSE2(void);
+#endif
 
 #ifdef __cplusplus
 }
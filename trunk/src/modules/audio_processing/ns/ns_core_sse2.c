@@ -0,0 +1,196 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/*
+ * The floating point noise suppressor, SSE2 version of speed-critical
+ * functions. Each product and sum is evaluated in the same order as in the
+ * generic C code, so the output is bit-exact.
+ */
+
+#include "typedefs.h"
+
+#if defined(WEBRTC_USE_SSE2)
+#include <emmintrin.h>
+#include <string.h>
+
+#include "ns_core.h"
+
+#if (DITECH_VERSION == DITECH_RELEASE_VERSION)
+
+static void AnalysisWindowSSE2(float* frame, int len) {
+  const int n = len >> 1;
+  int i;
+
+  for (i = 0; i + 3 < n; i += 4) {
+    const __m128 win = _mm_loadu_ps(&tri_win_flt[i]);
+    // tri_win_flt[n - 1 - i], ..., tri_win_flt[n - 4 - i].
+    const __m128 win_rev = _mm_shuffle_ps(
+        _mm_loadu_ps(&tri_win_flt[n - 4 - i]),
+        _mm_loadu_ps(&tri_win_flt[n - 4 - i]),
+        _MM_SHUFFLE(0, 1, 2, 3));
+    _mm_storeu_ps(&frame[i], _mm_mul_ps(win, _mm_loadu_ps(&frame[i])));
+    _mm_storeu_ps(&frame[i + n],
+                  _mm_mul_ps(win_rev, _mm_loadu_ps(&frame[i + n])));
+  }
+  for (; i < n; i++) {
+    frame[i] = tri_win_flt[i] * frame[i];
+    frame[i + n] = tri_win_flt[n - 1 - i] * frame[i + n];
+  }
+}
+
+static void PowerSpectrumSSE2(const float* fft, float* magn, int len) {
+  const int n = len >> 1;
+  int i;
+
+  magn[0] = fft[0] * fft[0];
+  magn[n] = fft[1] * fft[1];
+  for (i = 1; i + 3 < n; i += 4) {
+    const __m128 a = _mm_loadu_ps(&fft[2 * i]);
+    const __m128 b = _mm_loadu_ps(&fft[2 * i + 4]);
+    const __m128 re = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+    const __m128 im = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+    _mm_storeu_ps(&magn[i], _mm_add_ps(_mm_mul_ps(re, re),
+                                       _mm_mul_ps(im, im)));
+  }
+  for (; i < n; i++) {
+    magn[i] = fft[2 * i] * fft[2 * i] + fft[2 * i + 1] * fft[2 * i + 1];
+  }
+}
+
+static void UpdateNoiseSSE2(float* noise, const float* magn, float lambda) {
+  const float one_minus_lambda = 1.0f - lambda;
+  const __m128 lambda_4 = _mm_set1_ps(lambda);
+  const __m128 one_minus_lambda_4 = _mm_set1_ps(one_minus_lambda);
+  int i;
+
+  for (i = 0; i + 3 < FFTLENGTH / 2 + 1; i += 4) {
+    const __m128 old_noise = _mm_mul_ps(_mm_loadu_ps(&noise[i]),
+                                        one_minus_lambda_4);
+    const __m128 new_magn = _mm_mul_ps(_mm_loadu_ps(&magn[i]), lambda_4);
+    _mm_storeu_ps(&noise[i], _mm_add_ps(old_noise, new_magn));
+  }
+  for (; i < FFTLENGTH / 2 + 1; i++) {
+    noise[i] = noise[i] * one_minus_lambda + magn[i] * lambda;
+  }
+}
+
+static void NoiseResidualSSE2(const float* magn, const float* noise,
+                              float* residual) {
+  const __m128 zero = _mm_setzero_ps();
+  int i;
+
+  for (i = 0; i + 3 < FFTLENGTH / 2 + 1; i += 4) {
+    const __m128 diff = _mm_sub_ps(_mm_loadu_ps(&magn[i]),
+                                   _mm_loadu_ps(&noise[i]));
+    // Keeps |diff| only where diff > 0, like the C version. Zero and NaN
+    // differences give +0.
+    _mm_storeu_ps(&residual[i], _mm_and_ps(diff, _mm_cmpgt_ps(diff, zero)));
+  }
+  for (; i < FFTLENGTH / 2 + 1; i++) {
+    const float diff = magn[i] - noise[i];
+    residual[i] = diff > 0.0f ? diff : 0.0f;
+  }
+}
+
+static void SpectralSubtractionSSE2(const float* noise, const float* alpha,
+                                    const float* beta, float* magn) {
+  const __m128 zero = _mm_setzero_ps();
+  int i;
+
+  for (i = 0; i + 3 < FFTLENGTH / 2 + 1; i += 4) {
+    const __m128 noise_4 = _mm_loadu_ps(&noise[i]);
+    const __m128 alpha_4 = _mm_loadu_ps(&alpha[i]);
+    const __m128 beta_4 = _mm_loadu_ps(&beta[i]);
+    const __m128 magn_4 = _mm_loadu_ps(&magn[i]);
+    const __m128 over = _mm_sub_ps(
+        _mm_mul_ps(noise_4, _mm_add_ps(alpha_4, beta_4)), magn_4);
+    const __m128 mask = _mm_cmplt_ps(over, zero);
+    const __m128 subtracted = _mm_sub_ps(magn_4, _mm_mul_ps(noise_4, alpha_4));
+    const __m128 floor = _mm_mul_ps(noise_4, beta_4);
+    _mm_storeu_ps(&magn[i], _mm_or_ps(_mm_and_ps(mask, subtracted),
+                                      _mm_andnot_ps(mask, floor)));
+  }
+  for (; i < FFTLENGTH / 2 + 1; i++) {
+    if (noise[i] * (alpha[i] + beta[i]) - magn[i] < 0.0f) {
+      magn[i] -= noise[i] * alpha[i];
+    } else {
+      magn[i] = noise[i] * beta[i];
+    }
+  }
+}
+
+static void ApplySpectralGainSSE2(float* fft, const float* gain) {
+  int i;
+
+  // Bin i of the gain scales both fft[2 * i] and fft[2 * i + 1], except for
+  // i = 0 where the Nyquist bin is packed into fft[1].
+  fft[0] = gain[0] * fft[0];
+  fft[1] = gain[FFTLENGTH / 2] * fft[1];
+  for (i = 1; i + 3 < FFTLENGTH / 2; i += 4) {
+    const __m128 g = _mm_loadu_ps(&gain[i]);
+    const __m128 g_lo = _mm_unpacklo_ps(g, g);
+    const __m128 g_hi = _mm_unpackhi_ps(g, g);
+    _mm_storeu_ps(&fft[2 * i], _mm_mul_ps(g_lo, _mm_loadu_ps(&fft[2 * i])));
+    _mm_storeu_ps(&fft[2 * i + 4],
+                  _mm_mul_ps(g_hi, _mm_loadu_ps(&fft[2 * i + 4])));
+  }
+  for (; i < FFTLENGTH / 2; i++) {
+    fft[2 * i] = gain[i] * fft[2 * i];
+    fft[2 * i + 1] = gain[i] * fft[2 * i + 1];
+  }
+}
+
+static void OverlapAddSSE2(float* olp, float* frame, float* out) {
+  float* rising = &frame[HIST_SIZE];
+  float* flat = &frame[HIST_SIZE + LOOK_AHEAD];
+  const float* falling = &frame[HIST_SIZE + FRAME_SIZE];
+  int i;
+
+  for (i = 0; i + 3 < LOOK_AHEAD; i += 4) {
+    const __m128 undone = _mm_mul_ps(_mm_loadu_ps(&undo_plus_tri_win_flt[i]),
+                                     _mm_loadu_ps(&rising[i]));
+    _mm_storeu_ps(&rising[i], _mm_add_ps(undone, _mm_loadu_ps(&olp[i])));
+  }
+  for (; i < LOOK_AHEAD; i++) {
+    rising[i] = undo_plus_tri_win_flt[i] * rising[i] + olp[i];
+  }
+
+  for (i = 0; i + 3 < FRAME_SIZE - OLP_SIZE; i += 4) {
+    _mm_storeu_ps(&flat[i], _mm_mul_ps(_mm_loadu_ps(&undo_win_flt[i]),
+                                       _mm_loadu_ps(&flat[i])));
+  }
+  for (; i < FRAME_SIZE - OLP_SIZE; i++) {
+    flat[i] = undo_win_flt[i] * flat[i];
+  }
+
+  for (i = 0; i + 3 < OLP_SIZE; i += 4) {
+    _mm_storeu_ps(&olp[i],
+                  _mm_mul_ps(_mm_loadu_ps(&undo_plus_tri_win_ola_flt[i]),
+                             _mm_loadu_ps(&falling[i])));
+  }
+  for (; i < OLP_SIZE; i++) {
+    olp[i] = undo_plus_tri_win_ola_flt[i] * falling[i];
+  }
+
+  memcpy(out, &frame[HIST_SIZE], sizeof(float) * FRAME_SIZE);
+}
+
+void WebRtcNs_InitSSE2(void) {
+  WebRtcNs_AnalysisWindow = AnalysisWindowSSE2;
+  WebRtcNs_PowerSpectrum = PowerSpectrumSSE2;
+  WebRtcNs_UpdateNoise = UpdateNoiseSSE2;
+  WebRtcNs_NoiseResidual = NoiseResidualSSE2;
+  WebRtcNs_SpectralSubtraction = SpectralSubtractionSSE2;
+  WebRtcNs_ApplySpectralGain = ApplySpectralGainSSE2;
+  WebRtcNs_OverlapAdd = OverlapAddSSE2;
+}
+
+#endif  // DITECH_VERSION == DITECH_RELEASE_VERSION
+#endif  // WEBRTC_USE_SSE2
@@ -20,6 +20,8 @@
 #include "syn_process.h"
 #include "anr_tab.h"
 #include "r_fft.h"
+#include "typedefs.h"
+#include "ns_core.h"
 
 /***************************************************************************
  *
@@ -104,10 +106,6 @@ void SYN_process_FLT (SYN_STATE_FLT	*pSYNState, FLOAT *buff, FLOAT *out_data)
  ************************************************************************/
 void syn_ovlp_add_FLT (FLOAT *old_buff, FLOAT *new_buff, FLOAT *out_buff)
 {
-    int	i;
-	FLOAT  acc;
-
-
 /* FOR 10ms operation */
    /*--------------------------------------------------------------------------*/
    /* Two levels of synthesis windowing :                                      */
@@ -179,31 +177,7 @@ void syn_ovlp_add_FLT (FLOAT *old_buff, FLOAT *new_buff, FLOAT *out_buff)
    /*     old_data[i] = 1/tri_win[39-i] * {1-i/39} * new_data[56+160+i]        */
    /*--------------------------------------------------------------------------*/
 
-    for (i=0; i<LOOK_AHEAD; i++)
-    {
-      acc = undo_plus_tri_win_flt[i] * new_buff[i+HIST_SIZE];
-      new_buff[i+HIST_SIZE] = acc + old_buff[i];
-    }
-
-   /* undo the long triangular window for 40 samples */
-    for (i=0; i<(FRAME_SIZE-OLP_SIZE); i++)
-    {
-      new_buff[i+HIST_SIZE+LOOK_AHEAD] = undo_win_flt[i] * new_buff[i+LOOK_AHEAD+HIST_SIZE];
-    }
-
-   /* Updating data buffer */
-   /* update old buffer by undoing the tail end of the full triangular window */
-   /* and applying the new triangular window                                  */
-    for (i=0; i<OLP_SIZE; i++)
-    {
-		old_buff[i] = undo_plus_tri_win_ola_flt[i] * new_buff[i+FRAME_SIZE+HIST_SIZE];
-    }
-
-   /* output data for current frame */
-    for (i=0; i<FRAME_SIZE; i++)
-    {
-        out_buff[i] = new_buff[i+HIST_SIZE];
-    }
+    WebRtcNs_OverlapAdd (old_buff, new_buff, out_buff);
 
     return;
 }
@@ -21,6 +21,8 @@
 #include "vad.h"
 //#include "anr_math.h"
 #include "anr_tab.h"
+#include "typedefs.h"
+#include "ns_core.h"
 
 FLOAT	vad_FLT (
 int	fno,
@@ -566,10 +568,6 @@ void construct_FFTframe_FLT (FLOAT *new_data, FLOAT *curr_data,
 {
     int   i;
     FLOAT  *ptr_dst, *ptr_src;
-
-#if !ZERO_PADDING_IN_FFT
-    int  N;
-#endif
    /* initialization of pointers */
 
 
@@ -651,12 +649,7 @@ void construct_FFTframe_FLT (FLOAT *new_data, FLOAT *curr_data,
    /* Triangular Analysis Windowing prior to Forward RFFT           */
    /*    coefficient table : tri_win[i] = (i/128)*2^15              */
    /*---------------------------------------------------------------*/
-    N = lenRFFT >> 1;
-    for (i=0; i<N; i++)
-    {
-		new_data[i]   = tri_win_flt[i] * new_data[i];
-		new_data[i+N] = tri_win_flt[N-1-i] * new_data[i+N];
-    }
+    WebRtcNs_AnalysisWindow (new_data, lenRFFT);
 #endif
 
     return;
@@ -666,14 +659,7 @@ void construct_FFTframe_FLT (FLOAT *new_data, FLOAT *curr_data,
 
 void compute_power_spectrum_FLT (FLOAT buff[], FLOAT fmag[], int len)
 {
-   int i;
-
-   fmag[0] = buff[0] * buff[0];
-   fmag[len/2] = buff[1] * buff[1];
-   for (i = 1; i < len/2; i++)
-   {
-	   fmag[i] = buff[2*i] * buff[2*i] + buff[2*i+1] * buff[2*i+1];
-   }
+   WebRtcNs_PowerSpectrum (buff, fmag, len);
 
    return;
 }
@@ -19,12 +19,20 @@
 #include "signal_processing_library.h"
 #include "testsupport/fileutils.h"
 #include "thread_wrapper.h"
+#include "tick_util.h"
 #include "trace.h"
 #ifdef WEBRTC_ANDROID
 #include "external/webrtc/src/modules/audio_processing/test/unittest.pb.h"
 #else
 #include "webrtc/audio_processing/unittest.pb.h"
 #endif
+#ifdef WEBRTC_AUDIOPROC_DEBUG_DUMP
+#ifdef WEBRTC_ANDROID
+#include "external/webrtc/src/modules/audio_processing/debug.pb.h"
+#else
+#include "webrtc/audio_processing/debug.pb.h"
+#endif
+#endif  // WEBRTC_AUDIOPROC_DEBUG_DUMP
 
 using webrtc::AudioProcessing;
 using webrtc::AudioFrame;
@@ -246,6 +254,30 @@ void ReadMessageLiteFromFile(const std::string filename,
   fclose(file);
 }
 
+#ifdef WEBRTC_AUDIOPROC_DEBUG_DUMP
+// Reads one size-prefixed message, as written to the debug dump. Returns true
+// on success, false on error or end-of-file.
+bool ReadMessageFromFile(FILE* file,
+                         ::google::protobuf::MessageLite* msg) {
+  int32_t size = 0;
+  if (fread(&size, sizeof(int32_t), 1, file) != 1) {
+    return false;
+  }
+  if (size <= 0) {
+    return false;
+  }
+  const size_t usize = static_cast<size_t>(size);
+
+  scoped_array<char> array(new char[usize]);
+  if (fread(array.get(), sizeof(char), usize, file) != usize) {
+    return false;
+  }
+
+  msg->Clear();
+  return msg->ParseFromArray(array.get(), usize);
+}
+#endif  // WEBRTC_AUDIOPROC_DEBUG_DUMP
+
 struct ThreadData {
   ThreadData(int thread_num_, AudioProcessing* ap_)
       : thread_num(thread_num_),
@@ -740,6 +772,43 @@ TEST_F(ApmTest, NoiseSuppression) {
   EXPECT_FALSE(apm_->noise_suppression()->is_enabled());
 }
 
+// Runs the near-end file through the noise suppressor alone and reports the
+// average time spent per 10 ms frame.
+TEST_F(ApmTest, NoiseSuppressionPerFrameTime) {
+  const int kSampleRates[] = {8000, 16000, 32000};
+  for (size_t i = 0; i < sizeof(kSampleRates) / sizeof(*kSampleRates); i++) {
+    const int samples_per_channel = kSampleRates[i] / 100;
+    ASSERT_EQ(apm_->kNoError, apm_->Initialize());
+    ASSERT_EQ(apm_->kNoError, apm_->set_sample_rate_hz(kSampleRates[i]));
+    ASSERT_EQ(apm_->kNoError, apm_->set_num_channels(1, 1));
+    ASSERT_EQ(apm_->kNoError,
+              apm_->noise_suppression()->set_level(NoiseSuppression::kHigh));
+    ASSERT_EQ(apm_->kNoError, apm_->noise_suppression()->Enable(true));
+    frame_->_payloadDataLengthInSamples = samples_per_channel;
+    frame_->_audioChannel = 1;
+    frame_->_frequencyInHz = kSampleRates[i];
+
+    rewind(near_file_);
+    int frame_count = 0;
+    webrtc::TickInterval process_time;
+    while (fread(frame_->_payloadData, sizeof(int16_t),
+                 samples_per_channel * 2, near_file_) ==
+           static_cast<size_t>(samples_per_channel * 2)) {
+      MixStereoToMono(frame_->_payloadData, frame_->_payloadData,
+                      samples_per_channel);
+      const webrtc::TickTime start = webrtc::TickTime::Now();
+      EXPECT_EQ(apm_->kNoError, apm_->ProcessStream(frame_));
+      process_time += webrtc::TickTime::Now() - start;
+      frame_count++;
+    }
+    ASSERT_GT(frame_count, 0);
+    printf("Noise suppression at %d Hz: %.2f us / frame (%d frames)\n",
+           kSampleRates[i],
+           static_cast<double>(process_time.Microseconds()) / frame_count,
+           frame_count);
+  }
+}
+
 TEST_F(ApmTest, HighPassFilter) {
   // Turing HP filter on/off
   EXPECT_EQ(apm_->kNoError, apm_->high_pass_filter()->Enable(true));
@@ -981,11 +1050,43 @@ TEST_F(ApmTest, DebugDump) {
 
   EXPECT_EQ(apm_->kNoError, apm_->StartDebugRecording(filename.c_str()));
   EXPECT_EQ(apm_->kNoError, apm_->AnalyzeReverseStream(revframe_));
+  webrtc::AudioFrame input_frame;
+  input_frame = *frame_;
   EXPECT_EQ(apm_->kNoError, apm_->ProcessStream(frame_));
   EXPECT_EQ(apm_->kNoError, apm_->StopDebugRecording());
 
-  // Verify the file has been written.
-  ASSERT_TRUE(fopen(filename.c_str(), "r") != NULL);
+  // Verify the file has been written by the background writer, in order and
+  // in the format unpack_aecdump expects.
+  FILE* debug_file = fopen(filename.c_str(), "rb");
+  ASSERT_TRUE(debug_file != NULL);
+  webrtc::audioproc::Event event_msg;
+  ASSERT_TRUE(ReadMessageFromFile(debug_file, &event_msg));
+  EXPECT_EQ(webrtc::audioproc::Event::INIT, event_msg.type());
+  EXPECT_EQ(apm_->sample_rate_hz(), event_msg.init().sample_rate());
+
+  ASSERT_TRUE(ReadMessageFromFile(debug_file, &event_msg));
+  EXPECT_EQ(webrtc::audioproc::Event::REVERSE_STREAM, event_msg.type());
+  const size_t rev_size = sizeof(int16_t) *
+      revframe_->_payloadDataLengthInSamples * revframe_->_audioChannel;
+  ASSERT_EQ(rev_size, event_msg.reverse_stream().data().size());
+  EXPECT_EQ(0, memcmp(revframe_->_payloadData,
+                      event_msg.reverse_stream().data().data(), rev_size));
+
+  ASSERT_TRUE(ReadMessageFromFile(debug_file, &event_msg));
+  EXPECT_EQ(webrtc::audioproc::Event::STREAM, event_msg.type());
+  const size_t input_size = sizeof(int16_t) *
+      input_frame._payloadDataLengthInSamples * input_frame._audioChannel;
+  ASSERT_EQ(input_size, event_msg.stream().input_data().size());
+  EXPECT_EQ(0, memcmp(input_frame._payloadData,
+                      event_msg.stream().input_data().data(), input_size));
+  const size_t output_size = sizeof(int16_t) *
+      frame_->_payloadDataLengthInSamples * frame_->_audioChannel;
+  ASSERT_EQ(output_size, event_msg.stream().output_data().size());
+  EXPECT_EQ(0, memcmp(frame_->_payloadData,
+                      event_msg.stream().output_data().data(), output_size));
+
+  EXPECT_FALSE(ReadMessageFromFile(debug_file, &event_msg));
+  fclose(debug_file);
   // Clean it up.
   ASSERT_EQ(0, remove(filename.c_str()));
 #else
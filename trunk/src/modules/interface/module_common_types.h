@@ -420,6 +420,25 @@ struct VideoContentMetrics
     bool             contentChange;
 };
 
+/*************************************************
+ *
+ * PlaneReleaseCallback class
+ *
+ * Implemented by the owner of an I420 picture that
+ * is lent out by reference instead of being copied,
+ * e.g. a decoder lending its output planes.
+ *
+ *************************************************/
+class PlaneReleaseCallback
+{
+public:
+    virtual ~PlaneReleaseCallback() {}
+    /**
+    *   Called once the borrower no longer references the planes.
+    */
+    virtual void ReleasePlanes() = 0;
+};
+
 /*************************************************
  *
  * VideoFrame class
@@ -427,11 +446,20 @@ struct VideoContentMetrics
  * The VideoFrame class allows storing and
  * handling of video frames.
  *
+ * A frame can also reference an I420 picture owned
+ * by someone else, see SetPlanes(). Such a frame is
+ * handed on by reference until a user that needs a
+ * packed buffer of its own calls Materialize().
+ * AllocatePlanes() gives the frame a picture of its
+ * own with aligned, padded rows. Plane() and Stride()
+ * work for all three layouts.
  *
  *************************************************/
 class VideoFrame
 {
 public:
+    enum { kDefaultPlaneAlignment = 16 };
+
     VideoFrame();
     ~VideoFrame();
     /**
@@ -471,6 +499,58 @@ public:
     */
     void Free();
     /**
+    *    Reference an I420 picture with the given planes and strides instead
+    *    of copying it. Buffer() and Length() do not cover the referenced
+    *    picture, so users that need a packed buffer must call Materialize()
+    *    first. SwapFrame() and CopyFrame() handle referenced pictures. A
+    *    crop of a picture is referenced by offsetting its planes.
+    *    releaseCallback, if not NULL, is called once the frame stops
+    *    referencing the planes.
+    */
+    WebRtc_Word32 SetPlanes(WebRtc_UWord8* const planes[3],
+                            const int strides[3],
+                            WebRtc_UWord32 width,
+                            WebRtc_UWord32 height,
+                            PlaneReleaseCallback* releaseCallback);
+    /**
+    *    Allocate an I420 picture in the frame's own buffer, with every row
+    *    starting at a multiple of alignment bytes (a power of two) and
+    *    padded up to the next one. The content is undefined. As with
+    *    SetPlanes(), the picture is not packed in Buffer(); the packed
+    *    buffer functions (VerifyAndAllocate(), SetLength(), Swap(),
+    *    CopyFrame(length, buffer)) discard it.
+    */
+    WebRtc_Word32 AllocatePlanes(WebRtc_UWord32 width,
+                                 WebRtc_UWord32 height,
+                                 WebRtc_UWord32 alignment =
+                                     kDefaultPlaneAlignment);
+    /**
+    *    True if the picture is laid out by SetPlanes() or AllocatePlanes()
+    *    rather than packed in Buffer()
+    */
+    bool HasPlanes() const {return _planes[0] != NULL;}
+    /**
+    *    True if the picture is lent to the frame by SetPlanes(), and so must
+    *    not be written to
+    */
+    bool ReferencesPlanes() const {return HasPlanes() && !_planesInBuffer;}
+    /**
+    *    First row of plane 0 (Y), 1 (U) or 2 (V) and its stride in bytes,
+    *    for any layout of the picture
+    */
+    WebRtc_UWord8* Plane(int plane) const;
+    int Stride(int plane) const;
+    /**
+    *    Pack the picture into the frame's own buffer, releasing a referenced
+    *    picture. Does nothing if the picture is packed already.
+    */
+    WebRtc_Word32 Materialize();
+    /**
+    *    Discard the picture laid out by SetPlanes() or AllocatePlanes(),
+    *    without copying it
+    */
+    void ReleasePlanes();
+    /**
     *   Set frame timestamp (90kHz)
     */
     void SetTimeStamp(const WebRtc_UWord32 timeStamp) {_timeStamp = timeStamp;}
@@ -523,6 +603,8 @@ private:
              WebRtc_UWord32 size,
              WebRtc_UWord32 length,
              WebRtc_UWord32 timeStamp);
+    // Packs the picture referenced by source into the own buffer.
+    WebRtc_Word32 CopyPlanes(const VideoFrame& source);
 
     WebRtc_UWord8*          _buffer;          // Pointer to frame buffer
     WebRtc_UWord32          _bufferSize;      // Allocated buffer size
@@ -531,6 +613,10 @@ private:
     WebRtc_UWord32          _width;
     WebRtc_UWord32          _height;
     WebRtc_Word64           _renderTimeMs;
+    WebRtc_UWord8*          _planes[3];       // Picture, if not packed
+    int                     _strides[3];
+    PlaneReleaseCallback*   _releaseCallback;
+    bool                    _planesInBuffer;  // Set by AllocatePlanes()
 }; // end of VideoFrame class declaration
 
 // inline implementation of VideoFrame class:
@@ -542,13 +628,20 @@ VideoFrame::VideoFrame():
     _timeStamp(0),
     _width(0),
     _height(0),
-    _renderTimeMs(0)
+    _renderTimeMs(0),
+    _releaseCallback(NULL),
+    _planesInBuffer(false)
 {
-    //
+    for (int i = 0; i < 3; i++)
+    {
+        _planes[i] = NULL;
+        _strides[i] = 0;
+    }
 }
 inline
 VideoFrame::~VideoFrame()
 {
+    ReleasePlanes();
     if(_buffer)
     {
         delete [] _buffer;
@@ -561,6 +654,10 @@ inline
 WebRtc_Word32
 VideoFrame::VerifyAndAllocate(const WebRtc_UWord32 minimumSize)
 {
+    if (_planesInBuffer)
+    {
+        ReleasePlanes();
+    }
     if (minimumSize < 1)
     {
         return -1;
@@ -585,6 +682,10 @@ inline
 WebRtc_Word32
 VideoFrame::SetLength(const WebRtc_UWord32 newLength)
 {
+    if (_planesInBuffer)
+    {
+        ReleasePlanes();
+    }
     if (newLength >_bufferSize )
     { // can't accomodate new value
         return -1;
@@ -597,6 +698,11 @@ inline
 WebRtc_Word32
 VideoFrame::SwapFrame(VideoFrame& videoFrame)
 {
+    // Only buffers of our own can change hands.
+    if (Materialize() != 0 || videoFrame.Materialize() != 0)
+    {
+        return -1;
+    }
     WebRtc_UWord32 tmpTimeStamp  = _timeStamp;
     WebRtc_UWord32 tmpWidth      = _width;
     WebRtc_UWord32 tmpHeight     = _height;
@@ -619,6 +725,8 @@ inline
 WebRtc_Word32
 VideoFrame::Swap(WebRtc_UWord8*& newMemory, WebRtc_UWord32& newLength, WebRtc_UWord32& newSize)
 {
+    // The new buffer replaces the content.
+    ReleasePlanes();
     WebRtc_UWord8* tmpBuffer = _buffer;
     WebRtc_UWord32 tmpLength = _bufferLength;
     WebRtc_UWord32 tmpSize = _bufferSize;
@@ -635,6 +743,7 @@ inline
 WebRtc_Word32
 VideoFrame::CopyFrame(WebRtc_UWord32 length, const WebRtc_UWord8* sourceBuffer)
 {
+    ReleasePlanes();
     if (length > _bufferSize)
     {
         WebRtc_Word32 ret = VerifyAndAllocate(length);
@@ -652,7 +761,19 @@ inline
 WebRtc_Word32
 VideoFrame::CopyFrame(const VideoFrame& videoFrame)
 {
-    if(CopyFrame(videoFrame.Length(), videoFrame.Buffer()) != 0)
+    if (videoFrame.HasPlanes())
+    {
+        if (this == &videoFrame)
+        {
+            return Materialize();
+        }
+        ReleasePlanes();
+        if (CopyPlanes(videoFrame) != 0)
+        {
+            return -1;
+        }
+    }
+    else if(CopyFrame(videoFrame.Length(), videoFrame.Buffer()) != 0)
     {
         return -1;
     }
@@ -667,6 +788,7 @@ inline
 void
 VideoFrame::Free()
 {
+    ReleasePlanes();
     _timeStamp = 0;
     _bufferLength = 0;
     _bufferSize = 0;
@@ -681,6 +803,169 @@ VideoFrame::Free()
     }
 }
 
+inline
+WebRtc_Word32
+VideoFrame::SetPlanes(WebRtc_UWord8* const planes[3],
+                      const int strides[3],
+                      WebRtc_UWord32 width,
+                      WebRtc_UWord32 height,
+                      PlaneReleaseCallback* releaseCallback)
+{
+    if (planes[0] == NULL || planes[1] == NULL || planes[2] == NULL)
+    {
+        return -1;
+    }
+    ReleasePlanes();
+    for (int i = 0; i < 3; i++)
+    {
+        _planes[i] = planes[i];
+        _strides[i] = strides[i];
+    }
+    _releaseCallback = releaseCallback;
+    _width = width;
+    _height = height;
+    _bufferLength = 0;
+    return 0;
+}
+
+inline
+WebRtc_Word32
+VideoFrame::AllocatePlanes(WebRtc_UWord32 width,
+                           WebRtc_UWord32 height,
+                           WebRtc_UWord32 alignment)
+{
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0)
+    {
+        return -1;
+    }
+    ReleasePlanes();
+    const WebRtc_UWord32 mask = alignment - 1;
+    const WebRtc_UWord32 halfHeight = (height + 1) >> 1;
+    const int strides[3] = {
+        static_cast<int>((width + mask) & ~mask),
+        static_cast<int>((((width + 1) >> 1) + mask) & ~mask),
+        static_cast<int>((((width + 1) >> 1) + mask) & ~mask)};
+    // Leave room to align the start of the buffer.
+    const WebRtc_UWord32 size = strides[0] * height +
+        (strides[1] + strides[2]) * halfHeight + mask;
+    if (VerifyAndAllocate(size) != 0)
+    {
+        return -1;
+    }
+    const size_t offset =
+        (alignment - (reinterpret_cast<size_t>(_buffer) & mask)) & mask;
+    _planes[0] = _buffer + offset;
+    _planes[1] = _planes[0] + strides[0] * height;
+    _planes[2] = _planes[1] + strides[1] * halfHeight;
+    for (int i = 0; i < 3; i++)
+    {
+        _strides[i] = strides[i];
+    }
+    _planesInBuffer = true;
+    _width = width;
+    _height = height;
+    _bufferLength = 0;
+    return 0;
+}
+
+inline
+WebRtc_UWord8*
+VideoFrame::Plane(int plane) const
+{
+    if (HasPlanes())
+    {
+        return _planes[plane];
+    }
+    // Packed I420.
+    WebRtc_UWord8* ptr = _buffer;
+    if (plane > 0)
+    {
+        ptr += _width * _height;
+    }
+    if (plane > 1)
+    {
+        ptr += ((_width + 1) >> 1) * ((_height + 1) >> 1);
+    }
+    return ptr;
+}
+
+inline
+int
+VideoFrame::Stride(int plane) const
+{
+    if (HasPlanes())
+    {
+        return _strides[plane];
+    }
+    return plane ? (_width + 1) >> 1 : _width;
+}
+
+inline
+WebRtc_Word32
+VideoFrame::Materialize()
+{
+    if (!HasPlanes())
+    {
+        return 0;
+    }
+    const WebRtc_Word32 ret = CopyPlanes(*this);
+    ReleasePlanes();
+    return ret;
+}
+
+inline
+void
+VideoFrame::ReleasePlanes()
+{
+    if (!HasPlanes())
+    {
+        return;
+    }
+    PlaneReleaseCallback* releaseCallback = _releaseCallback;
+    for (int i = 0; i < 3; i++)
+    {
+        _planes[i] = NULL;
+        _strides[i] = 0;
+    }
+    _releaseCallback = NULL;
+    _planesInBuffer = false;
+    if (releaseCallback)
+    {
+        releaseCallback->ReleasePlanes();
+    }
+}
+
+inline
+WebRtc_Word32
+VideoFrame::CopyPlanes(const VideoFrame& source)
+{
+    const WebRtc_UWord32 halfWidth = (source._width + 1) >> 1;
+    const WebRtc_UWord32 halfHeight = (source._height + 1) >> 1;
+    const WebRtc_UWord32 length = source._width * source._height +
+        2 * halfWidth * halfHeight;
+    // A picture in our own buffer is packed in place; no row moves up.
+    const bool inPlace = (this == &source) && _planesInBuffer;
+    if (!inPlace && VerifyAndAllocate(length) != 0)
+    {
+        return -1;
+    }
+    WebRtc_UWord8* dst = _buffer;
+    for (int plane = 0; plane < 3; plane++)
+    {
+        const WebRtc_UWord32 width = plane ? halfWidth : source._width;
+        const WebRtc_UWord32 height = plane ? halfHeight : source._height;
+        const WebRtc_UWord8* src = source._planes[plane];
+        for (WebRtc_UWord32 y = 0; y < height; y++)
+        {
+            memmove(dst, src, width);
+            dst += width;
+            src += source._strides[plane];
+        }
+    }
+    _bufferLength = length;
+    return 0;
+}
+
 
 /*************************************************
  *
@@ -16,6 +16,7 @@
 
 namespace webrtc {
 // forward declaration
+class Clock;
 class Transport;
 
 class RtpRtcp : public Module
@@ -42,6 +43,20 @@ public:
                                   const bool audio,
                                   RtpRtcpClock* clock);
 
+    /*
+    *   create a RTP/RTCP module object that reads all its times from a Clock,
+    *   e.g. a SimulatedClock when replaying a recorded session
+    *
+    *   id      - unique identifier of this RTP/RTCP module object
+    *   audio   - true for a audio version of the RTP/RTCP module object
+    *             false will create a video version
+    *   clock   - the clock to use to read time; must not be NULL and must
+    *             outlive the module
+    */
+    static RtpRtcp* CreateRtpRtcp(const WebRtc_Word32 id,
+                                  const bool audio,
+                                  Clock* clock);
+
     /*
     *   destroy a RTP/RTCP module object
     *
@@ -536,6 +551,30 @@ public:
                              WebRtc_UWord32* fecRate,
                              WebRtc_UWord32* nackRate) const = 0;
 
+    /*
+    *   Turn on/off pacing of the sent packets, off by default. When on, the
+    *   packets are queued and released from Process() at a multiple of the
+    *   target send bitrate. Re-transmissions are released before the queued
+    *   media packets of the same module. Packets that don't fit into the full
+    *   queue are dropped. Child modules registered later inherit the status.
+    *
+    *   enable              - on/off
+    *   bitrateMultiplier   - pacing rate relative to the target send
+    *                         bitrate, must be at least 1.0
+    *
+    *   return -1 on failure else 0
+    */
+    virtual WebRtc_Word32 SetPacingStatus(const bool enable,
+                                          const float bitrateMultiplier) = 0;
+
+    /*
+    *   get statistics of the pacing queue
+    *
+    *   return -1 on failure else 0
+    */
+    virtual WebRtc_Word32 PacingStatistics(
+        RtpPacerStatistics* statistics) const = 0;
+
     /*
     *   Used by the codec module to deliver a video or audio frame for packetization
     *
@@ -659,6 +698,26 @@ public:
     */
     virtual WebRtc_Word32 SendRTCP(WebRtc_UWord32 rtcpPacketType = kRtcpReport) = 0;
 
+    /*
+    *   Turn on/off aggregation of the RTCP of the child modules, off by
+    *   default. When on, the child modules stop sending their own reports
+    *   and this default module collects the SR/RR, SDES and pending feedback
+    *   of the child modules that share a transport into compound packets of
+    *   at most the MTU, sent on that transport. Child modules without a
+    *   transport send no reports. Feedback sent with SendRTCP(), e.g. NACK
+    *   and PLI, is not delayed.
+    *
+    *   Note: only allowed on a default module
+    *
+    *   return -1 on failure else 0
+    */
+    virtual WebRtc_Word32 SetRTCPAggregationStatus(const bool enable) = 0;
+
+    /*
+    *   Get RTCP aggregation status
+    */
+    virtual bool RTCPAggregation() const = 0;
+
     /*
     *    Good state of RTP receiver inform sender
     */
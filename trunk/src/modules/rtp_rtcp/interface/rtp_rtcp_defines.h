@@ -108,6 +108,20 @@ struct RTCPReportBlock
     WebRtc_UWord32 delaySinceLastSR;
 };
 
+// Statistics of the send-side pacing queue. The delays are the times packets
+// spent in the queue and count the packets released since pacing was turned
+// on.
+struct RtpPacerStatistics
+{
+    WebRtc_UWord32 queuedPackets;       // packets waiting in the queue
+    WebRtc_UWord32 queuedBytes;
+    WebRtc_UWord32 oldestQueueDelayMs;  // age of the oldest queued packet
+    WebRtc_UWord32 sentPackets;
+    WebRtc_UWord32 droppedPackets;      // dropped because the queue was full
+    WebRtc_UWord32 averageQueueDelayMs;
+    WebRtc_UWord32 maxQueueDelayMs;
+};
+
 class RtpData
 {
 public:
@@ -45,7 +45,11 @@ RTCPReceiver::RTCPReceiver(const WebRtc_Word32 id,
     _remoteSenderInfo(),
     _lastReceivedSRNTPsecs(0),
     _lastReceivedSRNTPfrac(0),
+    _receivedReportBlockMap(),
     _receivedInfoMap(),
+    _receivedCnameMap(),
+    _nextReceiveInfoTimeoutMS(0),
+    _receiveInfoDeletePending(false),
     _packetTimeOutMS(0)
 {
     memset(&_remoteSenderInfo, 0, sizeof(_remoteSenderInfo));
@@ -57,60 +61,6 @@ RTCPReceiver::~RTCPReceiver()
     delete _criticalSectionRTCPReceiver;
     delete _criticalSectionFeedbacks;
 
-    bool loop = true;
-    do
-    {
-        MapItem* item = _receivedReportBlockMap.First();
-        if(item)
-        {
-            // delete
-            RTCPReportBlockInformation* block= ((RTCPReportBlockInformation*)item->GetItem());
-            delete block;
-
-            // remove from map and delete Item
-            _receivedReportBlockMap.Erase(item);
-        } else
-        {
-            loop = false;
-        }
-    } while (loop);
-
-    loop = true;
-    do
-    {
-        MapItem* item = _receivedInfoMap.First();
-        if(item)
-        {
-            // delete
-            RTCPReceiveInformation* block= ((RTCPReceiveInformation*)item->GetItem());
-            delete block;
-
-            // remove from map and delete Item
-            _receivedInfoMap.Erase(item);
-        } else
-        {
-            loop = false;
-        }
-    } while (loop);
-
-    loop = true;
-    do
-    {
-        MapItem* item = _receivedCnameMap.First();
-        if(item)
-        {
-            // delete
-            RTCPCnameInformation* block= ((RTCPCnameInformation*)item->GetItem());
-            delete block;
-
-            // remove from map and delete Item
-            _receivedCnameMap.Erase(item);
-        } else
-        {
-            loop = false;
-        }
-    } while (loop);
-
     WEBRTC_TRACE(kTraceMemory, kTraceRtpRtcp, _id, "%s deleted", __FUNCTION__);
 }
 
@@ -485,13 +435,19 @@ RTCPReceiver::HandleReportBlock(const RTCPUtility::RTCPPacket& rtcpPacket,
         }
     }
 
-    _criticalSectionRTCPReceiver->Leave();
-     // to avoid problem with accuireing _criticalSectionRTCPSender while holding _criticalSectionRTCPReceiver
+    // the send time is only needed for the RTT of blocks to us, skip the
+    // lookup for the blocks of other sources in an aggregated packet
+    WebRtc_UWord32 sendTimeMS = 0;
+    if(_SSRC && rtcpPacket.ReportBlockItem.SSRC == _SSRC)
+    {
+        _criticalSectionRTCPReceiver->Leave();
+        // to avoid problem with accuireing _criticalSectionRTCPSender while holding _criticalSectionRTCPReceiver
 
-    WebRtc_UWord32 sendTimeMS = 
-        _rtpRtcp.SendTimeOfSendReport(rtcpPacket.ReportBlockItem.LastSR);
+        sendTimeMS =
+            _rtpRtcp.SendTimeOfSendReport(rtcpPacket.ReportBlockItem.LastSR);
 
-    _criticalSectionRTCPReceiver->Enter();
+        _criticalSectionRTCPReceiver->Enter();
+    }
 
     // ReportBlockItem.SSRC is who it's to
     // we store all incoming reports, used in conference relay
@@ -595,18 +551,7 @@ RTCPReceiver::CreateReportBlockInformation(WebRtc_UWord32 remoteSSRC)
 {
     CriticalSectionScoped lock(_criticalSectionRTCPReceiver);
 
-    RTCPReportBlockInformation* ptrReportBlockInfo = NULL;
-    MapItem* ptrReportBlockInfoItem = _receivedReportBlockMap.Find(remoteSSRC);
-    if (ptrReportBlockInfoItem == NULL)
-    {
-        ptrReportBlockInfo = new RTCPReportBlockInformation;
-        _receivedReportBlockMap.Insert(remoteSSRC, ptrReportBlockInfo);
-    } else
-    {
-        ptrReportBlockInfo = static_cast<RTCPReportBlockInformation*>(ptrReportBlockInfoItem->GetItem());
-    }
-    return ptrReportBlockInfo;
-
+    return _receivedReportBlockMap.FindOrCreate(remoteSSRC);
 }
 
 RTCPReportBlockInformation*
@@ -614,12 +559,7 @@ RTCPReceiver::GetReportBlockInformation(WebRtc_UWord32 remoteSSRC) const
 {
     CriticalSectionScoped lock(_criticalSectionRTCPReceiver);
 
-    MapItem* ptrReportBlockInfoItem = _receivedReportBlockMap.Find(remoteSSRC);
-    if (ptrReportBlockInfoItem == NULL)
-    {
-        return NULL;
-    }
-    return static_cast<RTCPReportBlockInformation*>(ptrReportBlockInfoItem->GetItem());
+    return _receivedReportBlockMap.Find(remoteSSRC);
 }
 
 RTCPCnameInformation*
@@ -627,17 +567,7 @@ RTCPReceiver::CreateCnameInformation(WebRtc_UWord32 remoteSSRC)
 {
     CriticalSectionScoped lock(_criticalSectionRTCPReceiver);
 
-    RTCPCnameInformation* ptrCnameInfo = NULL;
-    MapItem* ptrCnameInfoItem = _receivedCnameMap.Find(remoteSSRC);
-    if (ptrCnameInfoItem == NULL)
-    {
-        ptrCnameInfo = new RTCPCnameInformation;
-        _receivedCnameMap.Insert(remoteSSRC, ptrCnameInfo);
-    } else
-    {
-        ptrCnameInfo = static_cast<RTCPCnameInformation*>(ptrCnameInfoItem->GetItem());
-    }
-    return ptrCnameInfo;
+    return _receivedCnameMap.FindOrCreate(remoteSSRC);
 }
 
 RTCPCnameInformation*
@@ -645,12 +575,7 @@ RTCPReceiver::GetCnameInformation(WebRtc_UWord32 remoteSSRC) const
 {
     CriticalSectionScoped lock(_criticalSectionRTCPReceiver);
 
-    MapItem* ptrCnameInfoItem = _receivedCnameMap.Find(remoteSSRC);
-    if (ptrCnameInfoItem == NULL)
-    {
-        return NULL;
-    }
-    return static_cast<RTCPCnameInformation*>(ptrCnameInfoItem->GetItem());
+    return _receivedCnameMap.Find(remoteSSRC);
 }
 
 RTCPReceiveInformation*
@@ -658,17 +583,7 @@ RTCPReceiver::CreateReceiveInformation(WebRtc_UWord32 remoteSSRC)
 {
     CriticalSectionScoped lock(_criticalSectionRTCPReceiver);
 
-    RTCPReceiveInformation* ptrReceiveInfo = NULL;
-    MapItem* ptrReceiveInfoItem = _receivedInfoMap.Find(remoteSSRC);
-    if (ptrReceiveInfoItem == NULL)
-    {
-        ptrReceiveInfo = new RTCPReceiveInformation;
-        _receivedInfoMap.Insert(remoteSSRC, ptrReceiveInfo);
-    } else
-    {
-        ptrReceiveInfo = static_cast<RTCPReceiveInformation*>(ptrReceiveInfoItem->GetItem());
-    }
-    return ptrReceiveInfo;
+    return _receivedInfoMap.FindOrCreate(remoteSSRC);
 }
 
 RTCPReceiveInformation*
@@ -676,12 +591,7 @@ RTCPReceiver::GetReceiveInformation(WebRtc_UWord32 remoteSSRC)
 {
     CriticalSectionScoped lock(_criticalSectionRTCPReceiver);
 
-    MapItem* ptrReceiveInfoItem = _receivedInfoMap.Find(remoteSSRC);
-    if (ptrReceiveInfoItem == NULL)
-    {
-        return NULL;
-    }
-    return  static_cast<RTCPReceiveInformation*>(ptrReceiveInfoItem->GetItem());
+    return _receivedInfoMap.Find(remoteSSRC);
 }
 
 void
@@ -696,50 +606,63 @@ RTCPReceiver::UpdateRTCPReceiveInformationTimers()
 {
     CriticalSectionScoped lock(_criticalSectionRTCPReceiver);
 
+    // use audio define since we don't know what interval the remote peer is using
+    const WebRtc_UWord32 timeoutMS = 5*RTCP_INTERVAL_AUDIO_MS;
+
     bool updateBoundingSet = false;
     WebRtc_UWord32 timeNow = _clock.GetTimeInMS();
-    MapItem* receiveInfoItem=_receivedInfoMap.First();
 
-    while(receiveInfoItem)
+    // Receive times only move forward, so nothing can time out before the
+    // oldest receive time seen in the last walk does.
+    if (!_receiveInfoDeletePending &&
+        static_cast<WebRtc_Word32>(timeNow - _nextReceiveInfoTimeoutMS) < 0)
     {
-        RTCPReceiveInformation* receiveInfo = (RTCPReceiveInformation*)receiveInfoItem->GetItem();
-        if(receiveInfo == NULL)
-        {
-            return updateBoundingSet;
-        }
+        return updateBoundingSet;
+    }
+    _receiveInfoDeletePending = false;
+
+    WebRtc_UWord32 nextTimeoutMS = timeNow + timeoutMS + 1;
+    WebRtc_UWord32 i = 0;
+    while (i < _receivedInfoMap.Size())
+    {
+        RTCPReceiveInformation* receiveInfo = _receivedInfoMap.ItemAt(i);
+
         // time since last received rtcp packet
         // when we dont have a lastTimeReceived and the object is marked readyForDelete
         // it's removed from the map
         if( receiveInfo->lastTimeReceived)
         {
-            if((timeNow - receiveInfo->lastTimeReceived) > 5*RTCP_INTERVAL_AUDIO_MS)  // use audio define since we don't know what interval the remote peer is using
+            if((timeNow - receiveInfo->lastTimeReceived) > timeoutMS)
             {
                 // no rtcp packet for the last five regular intervals, reset limitations
                 receiveInfo->TmmbrSet.lengthOfSet = 0;
                 receiveInfo->lastTimeReceived = 0; // prevent that we call this over and over again
                 updateBoundingSet = true;  // send new TMMBN to all channels using the default codec
-            }
-            receiveInfoItem = _receivedInfoMap.Next(receiveInfoItem);
-        }else
-        {
-            if(receiveInfo->readyForDelete)
-            {
-                // store our current receiveInfoItem
-                MapItem* receiveInfoItemToBeErased = receiveInfoItem;
-
-                // iterate
-                receiveInfoItem = _receivedInfoMap.Next(receiveInfoItem);
-
-                // delete current
-                delete receiveInfo;
-                _receivedInfoMap.Erase(receiveInfoItemToBeErased);
-            }else
+                if (receiveInfo->readyForDelete)
+                {
+                    // delete it in the next call
+                    _receiveInfoDeletePending = true;
+                }
+            } else
             {
-                receiveInfoItem = _receivedInfoMap.Next(receiveInfoItem);
+                const WebRtc_UWord32 timeoutAtMS =
+                    receiveInfo->lastTimeReceived + timeoutMS + 1;
+                if (static_cast<WebRtc_Word32>(timeoutAtMS - nextTimeoutMS) < 0)
+                {
+                    nextTimeoutMS = timeoutAtMS;
+                }
             }
+            i++;
+        } else if (receiveInfo->readyForDelete)
+        {
+            // the last entry is moved into position i
+            _receivedInfoMap.Erase(_receivedInfoMap.SsrcAt(i));
+        } else
+        {
+            i++;
         }
-
     }
+    _nextReceiveInfoTimeoutMS = nextTimeoutMS;
     return updateBoundingSet;
 }
 
@@ -748,15 +671,9 @@ RTCPReceiver::BoundingSet(bool &tmmbrOwner, TMMBRSet*& boundingSetRec)
 {
     CriticalSectionScoped lock(_criticalSectionRTCPReceiver);
 
-    MapItem* receiveInfoItem=_receivedInfoMap.Find(_remoteSSRC);
-    if(receiveInfoItem )
+    RTCPReceiveInformation* receiveInfo = _receivedInfoMap.Find(_remoteSSRC);
+    if(receiveInfo)
     {
-        RTCPReceiveInformation* receiveInfo = (RTCPReceiveInformation*)receiveInfoItem->GetItem();
-        if(receiveInfo == NULL)
-        {
-            WEBRTC_TRACE(kTraceError, kTraceRtpRtcp, _id, "%s failed to get RTCPReceiveInformation", __FUNCTION__);
-            return -1;
-        }
         if(receiveInfo->TmmbnBoundingSet.lengthOfSet > 0)
         {
             boundingSetRec->VerifyAndAllocateSet(receiveInfo->TmmbnBoundingSet.lengthOfSet + 1);
@@ -866,25 +783,18 @@ RTCPReceiver::HandleBYE(RTCPUtility::RTCPParserV2& rtcpParser)
     // clear our lists
     CriticalSectionScoped lock(_criticalSectionRTCPReceiver);
 
-    MapItem* ptrReportBlockInfoItem = _receivedReportBlockMap.Find(rtcpPacket.BYE.SenderSSRC);
-    if (ptrReportBlockInfoItem != NULL)
-    {
-        delete static_cast<RTCPReportBlockInformation*>(ptrReportBlockInfoItem->GetItem());
-        _receivedReportBlockMap.Erase(ptrReportBlockInfoItem);
-    }
+    _receivedReportBlockMap.Erase(rtcpPacket.BYE.SenderSSRC);
+
     //  we can't delete it due to TMMBR
-    MapItem* ptrReceiveInfoItem = _receivedInfoMap.Find(rtcpPacket.BYE.SenderSSRC);
-    if (ptrReceiveInfoItem != NULL)
+    RTCPReceiveInformation* ptrReceiveInfo =
+        _receivedInfoMap.Find(rtcpPacket.BYE.SenderSSRC);
+    if (ptrReceiveInfo != NULL)
     {
-        static_cast<RTCPReceiveInformation*>(ptrReceiveInfoItem->GetItem())->readyForDelete = true;
+        ptrReceiveInfo->readyForDelete = true;
+        _receiveInfoDeletePending = true;
     }
 
-    MapItem* ptrCnameInfoItem = _receivedCnameMap.Find(rtcpPacket.BYE.SenderSSRC);
-    if (ptrCnameInfoItem != NULL)
-    {
-        delete static_cast<RTCPCnameInformation*>(ptrCnameInfoItem->GetItem());
-        _receivedCnameMap.Erase(ptrCnameInfoItem);
-    }
+    _receivedCnameMap.Erase(rtcpPacket.BYE.SenderSSRC);
     rtcpParser.Iterate();
 }
 
@@ -1493,21 +1403,17 @@ RTCPReceiver::TMMBRReceived(const WebRtc_UWord32 size,
 {
     CriticalSectionScoped lock(_criticalSectionRTCPReceiver);
 
-    MapItem* receiveInfoItem=_receivedInfoMap.First();
-    if(receiveInfoItem == NULL)
+    const WebRtc_UWord32 numReceiveInfo = _receivedInfoMap.Size();
+    if(numReceiveInfo == 0)
     {
         return -1;
     }
     WebRtc_UWord32 num = accNumCandidates;
     if(candidateSet)
     {
-        while( num < size && receiveInfoItem)
+        for (WebRtc_UWord32 n = 0; num < size && n < numReceiveInfo; n++)
         {
-            RTCPReceiveInformation* receiveInfo = (RTCPReceiveInformation*)receiveInfoItem->GetItem();
-            if(receiveInfo == NULL)
-            {
-                return 0;
-            }
+            RTCPReceiveInformation* receiveInfo = _receivedInfoMap.ItemAt(n);
             for (WebRtc_UWord32 i = 0; (num < size) && (i < receiveInfo->TmmbrSet.lengthOfSet); i++)
             {
                 if(receiveInfo->GetTMMBRSet(i, num, candidateSet,
@@ -1516,21 +1422,12 @@ RTCPReceiver::TMMBRReceived(const WebRtc_UWord32 size,
                     num++;
                 }
             }
-            receiveInfoItem = _receivedInfoMap.Next(receiveInfoItem);
         }
     } else
     {
-        while(receiveInfoItem)
+        for (WebRtc_UWord32 n = 0; n < numReceiveInfo; n++)
         {
-            RTCPReceiveInformation* receiveInfo = (RTCPReceiveInformation*)receiveInfoItem->GetItem();
-            if(receiveInfo == NULL)
-            {
-                WEBRTC_TRACE(kTraceError, kTraceRtpRtcp, _id, "%s failed to get RTCPReceiveInformation", __FUNCTION__);
-                return -1;
-            }
-            num += receiveInfo->TmmbrSet.lengthOfSet;
-
-            receiveInfoItem = _receivedInfoMap.Next(receiveInfoItem);
+            num += _receivedInfoMap.ItemAt(n)->TmmbrSet.lengthOfSet;
         }
     }
     return num;
@@ -12,11 +12,11 @@
 #define WEBRTC_MODULES_RTP_RTCP_SOURCE_RTCP_RECEIVER_H_
 
 #include "typedefs.h"
-#include "map_wrapper.h"
 #include "rtp_utility.h"
 #include "rtcp_utility.h"
 #include "rtp_rtcp_defines.h"
 #include "rtcp_receiver_help.h"
+#include "rtcp_ssrc_table.h"
 
 namespace webrtc {
 class ModuleRtpRtcpImpl;
@@ -207,9 +207,18 @@ private:
     WebRtc_UWord32            _lastReceivedSRNTPfrac;
 
     // Received report block
-    MapWrapper                 _receivedReportBlockMap;    // pair SSRC to report block
-    MapWrapper                 _receivedInfoMap;           // pair SSRC of sender to might not be a SSRC that have any data (i.e. a conference)
-    MapWrapper                 _receivedCnameMap;          // pair SSRC to Cname
+    RTCPHelp::RTCPSsrcTable<RTCPHelp::RTCPReportBlockInformation>
+                               _receivedReportBlockMap;    // pair SSRC to report block
+    RTCPHelp::RTCPSsrcTable<RTCPHelp::RTCPReceiveInformation>
+                               _receivedInfoMap;           // pair SSRC of sender to might not be a SSRC that have any data (i.e. a conference)
+    RTCPHelp::RTCPSsrcTable<RTCPUtility::RTCPCnameInformation>
+                               _receivedCnameMap;          // pair SSRC to Cname
+
+    // UpdateRTCPReceiveInformationTimers() only walks _receivedInfoMap when
+    // an entry can have timed out, i.e. at this time, or when a BYE has left
+    // an entry to be deleted.
+    WebRtc_UWord32            _nextReceiveInfoTimeoutMS;
+    bool                      _receiveInfoDeletePending;
 
     // timeout
     WebRtc_UWord32            _packetTimeOutMS;
@@ -128,6 +128,18 @@ RTCPReportBlockInformation::~RTCPReportBlockInformation()
 {
 }
 
+void
+RTCPReportBlockInformation::Reset()
+{
+    memset(&remoteReceiveBlock,0,sizeof(remoteReceiveBlock));
+    remoteMaxJitter = 0;
+    RTT = 0;
+    minRTT = 0;
+    maxRTT = 0;
+    avgRTT = 0;
+    numAverageCalcs = 0;
+}
+
 RTCPReceiveInformation::RTCPReceiveInformation() :
 
     lastTimeReceived(0),
@@ -146,6 +158,17 @@ RTCPReceiveInformation::~RTCPReceiveInformation()
     }
 }
 
+void
+RTCPReceiveInformation::Reset()
+{
+    lastTimeReceived = 0;
+    lastFIRSequenceNumber = -1;
+    lastFIRRequest = 0;
+    TmmbnBoundingSet.lengthOfSet = 0;
+    TmmbrSet.lengthOfSet = 0;
+    readyForDelete = false;
+}
+
 // don't use TmmbrSet.VerifyAndAllocate this version keeps the data
 void
 RTCPReceiveInformation::VerifyAndAllocateTMMBRSet(const WebRtc_UWord32 minimumSize)
@@ -73,6 +73,9 @@ public:
     RTCPReportBlockInformation();
     ~RTCPReportBlockInformation();
 
+    // Restores the constructed state so the object can be reused.
+    void Reset();
+
     // Statistics
     RTCPReportBlock remoteReceiveBlock;
     WebRtc_UWord32        remoteMaxJitter;
@@ -91,6 +94,10 @@ public:
     RTCPReceiveInformation();
     ~RTCPReceiveInformation();
 
+    // Restores the constructed state so the object can be reused. Allocated
+    // TMMBR/TMMBN buffers are kept.
+    void Reset();
+
     void VerifyAndAllocateBoundingSet(const WebRtc_UWord32 minimumSize);
     void VerifyAndAllocateTMMBRSet(const WebRtc_UWord32 minimumSize);
 
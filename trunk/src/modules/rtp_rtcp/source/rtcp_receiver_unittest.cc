@@ -0,0 +1,220 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/*
+ * This file includes unit tests and a parsing benchmark for the
+ * RTCPReceiver per-SSRC state.
+ */
+
+#include <gtest/gtest.h>
+
+#include <stdio.h>
+
+#include "common_types.h"
+#include "rtp_utility.h"
+#include "rtcp_receiver.h"
+#include "rtp_rtcp_config.h"
+#include "rtp_rtcp_impl.h"
+#include "tick_util.h"
+
+namespace {
+
+using namespace webrtc;
+
+class FakeRtcpClock : public RtpRtcpClock {
+ public:
+  FakeRtcpClock() : time_ms_(1000) {}
+  virtual WebRtc_UWord32 GetTimeInMS() { return time_ms_; }
+  virtual void CurrentNTP(WebRtc_UWord32& secs, WebRtc_UWord32& frac) {
+    secs = time_ms_ / 1000;
+    frac = 0;
+  }
+  void AdvanceTimeMs(WebRtc_UWord32 ms) { time_ms_ += ms; }
+ private:
+  WebRtc_UWord32 time_ms_;
+};
+
+void AssignUWord32(WebRtc_UWord8* buffer, int* pos, WebRtc_UWord32 value) {
+  ModuleRTPUtility::AssignUWord32ToBuffer(buffer + *pos, value);
+  *pos += 4;
+}
+
+// Writes one RR from |sender_ssrc| with |num_blocks| report blocks about
+// consecutive media SSRCs starting at |media_ssrc|.
+void BuildReceiverReport(WebRtc_UWord32 sender_ssrc,
+                         WebRtc_UWord32 media_ssrc,
+                         int num_blocks,
+                         WebRtc_UWord8* buffer,
+                         int* pos) {
+  ASSERT_LE(num_blocks, 31);
+  buffer[(*pos)++] = 0x80 + num_blocks;
+  buffer[(*pos)++] = 201;
+  const int length_in_words = 1 + 6 * num_blocks;
+  buffer[(*pos)++] = length_in_words >> 8;
+  buffer[(*pos)++] = length_in_words;
+  AssignUWord32(buffer, pos, sender_ssrc);
+  for (int i = 0; i < num_blocks; i++) {
+    AssignUWord32(buffer, pos, media_ssrc + i);
+    AssignUWord32(buffer, pos, (5 << 24) + 17);  // Fraction and total lost.
+    AssignUWord32(buffer, pos, 1000 + i);         // Extended highest seq num.
+    AssignUWord32(buffer, pos, 20);               // Jitter.
+    AssignUWord32(buffer, pos, 0);                // Last SR.
+    AssignUWord32(buffer, pos, 0);                // Delay since last SR.
+  }
+}
+
+void BuildBye(WebRtc_UWord32 sender_ssrc, WebRtc_UWord8* buffer, int* pos) {
+  buffer[(*pos)++] = 0x81;
+  buffer[(*pos)++] = 203;
+  buffer[(*pos)++] = 0;
+  buffer[(*pos)++] = 1;
+  AssignUWord32(buffer, pos, sender_ssrc);
+}
+
+class RtcpReceiverTest : public ::testing::Test {
+ protected:
+  enum { kMaxPacketSize = 64 * 1024 };
+
+  RtcpReceiverTest()
+      : rtp_rtcp_impl_(new ModuleRtpRtcpImpl(0, false, &clock_)),
+        rtcp_receiver_(new RTCPReceiver(0, &clock_, rtp_rtcp_impl_)),
+        packet_length_(0) {
+    rtcp_receiver_->SetRTCPStatus(kRtcpCompound);
+  }
+
+  ~RtcpReceiverTest() {
+    delete rtcp_receiver_;
+    delete rtp_rtcp_impl_;
+  }
+
+  // Builds a compound packet from |num_senders| senders, each reporting
+  // |blocks_per_sender| report blocks.
+  void BuildCompoundPacket(int num_senders, int blocks_per_sender) {
+    packet_length_ = 0;
+    for (int i = 0; i < num_senders; i++) {
+      BuildReceiverReport(kSenderSsrcBase + i, kMediaSsrcBase,
+                          blocks_per_sender, packet_, &packet_length_);
+    }
+  }
+
+  int InjectPacket() {
+    RTCPUtility::RTCPParserV2 rtcp_parser(packet_, packet_length_, true);
+    EXPECT_TRUE(rtcp_parser.IsValid());
+    RTCPHelp::RTCPPacketInformation rtcp_packet_information;
+    return rtcp_receiver_->IncomingRTCPPacket(rtcp_packet_information,
+                                              &rtcp_parser);
+  }
+
+  static const WebRtc_UWord32 kSenderSsrcBase = 0x10000;
+  static const WebRtc_UWord32 kMediaSsrcBase = 0x20000;
+
+  FakeRtcpClock clock_;
+  ModuleRtpRtcpImpl* rtp_rtcp_impl_;
+  RTCPReceiver* rtcp_receiver_;
+  WebRtc_UWord8 packet_[kMaxPacketSize];
+  int packet_length_;
+};
+
+TEST_F(RtcpReceiverTest, StoresReportBlocksFromManySenders) {
+  BuildCompoundPacket(200, 1);
+  EXPECT_EQ(0, InjectPacket());
+  for (int i = 0; i < 200; i++) {
+    RTCPReportBlock block;
+    ASSERT_EQ(0, rtcp_receiver_->StatisticsReceived(kSenderSsrcBase + i,
+                                                    &block));
+    EXPECT_EQ(5, block.fractionLost);
+    EXPECT_EQ(1000u, block.extendedHighSeqNum);
+  }
+  RTCPReportBlock block;
+  EXPECT_EQ(-1, rtcp_receiver_->StatisticsReceived(kSenderSsrcBase + 200,
+                                                   &block));
+}
+
+TEST_F(RtcpReceiverTest, ByeRemovesSender) {
+  BuildCompoundPacket(2, 1);
+  EXPECT_EQ(0, InjectPacket());
+  EXPECT_EQ(0u, static_cast<WebRtc_UWord32>(
+      rtcp_receiver_->TMMBRReceived(0, 0, NULL)));
+
+  packet_length_ = 0;
+  BuildBye(kSenderSsrcBase, packet_, &packet_length_);
+  EXPECT_EQ(0, InjectPacket());
+  RTCPReportBlock block;
+  EXPECT_EQ(-1, rtcp_receiver_->StatisticsReceived(kSenderSsrcBase, &block));
+  EXPECT_EQ(0, rtcp_receiver_->StatisticsReceived(kSenderSsrcBase + 1,
+                                                  &block));
+
+  // Nothing has timed out yet.
+  EXPECT_FALSE(rtcp_receiver_->UpdateRTCPReceiveInformationTimers());
+
+  // Both senders time out; the one that sent BYE is deleted in the call
+  // after that, the other one is kept.
+  clock_.AdvanceTimeMs(5 * RTCP_INTERVAL_AUDIO_MS + 1);
+  EXPECT_TRUE(rtcp_receiver_->UpdateRTCPReceiveInformationTimers());
+  EXPECT_FALSE(rtcp_receiver_->UpdateRTCPReceiveInformationTimers());
+
+  // The receive information of the remaining sender is reused on a new RR.
+  BuildCompoundPacket(2, 1);
+  EXPECT_EQ(0, InjectPacket());
+  EXPECT_FALSE(rtcp_receiver_->UpdateRTCPReceiveInformationTimers());
+  clock_.AdvanceTimeMs(5 * RTCP_INTERVAL_AUDIO_MS);
+  EXPECT_FALSE(rtcp_receiver_->UpdateRTCPReceiveInformationTimers());
+  clock_.AdvanceTimeMs(1);
+  EXPECT_TRUE(rtcp_receiver_->UpdateRTCPReceiveInformationTimers());
+}
+
+TEST_F(RtcpReceiverTest, TimeoutFollowsMostRecentReport) {
+  BuildCompoundPacket(1, 1);
+  EXPECT_EQ(0, InjectPacket());
+  EXPECT_FALSE(rtcp_receiver_->UpdateRTCPReceiveInformationTimers());
+
+  // A later report postpones the timeout even though the next walk was
+  // scheduled from the first one.
+  clock_.AdvanceTimeMs(RTCP_INTERVAL_AUDIO_MS);
+  EXPECT_EQ(0, InjectPacket());
+  clock_.AdvanceTimeMs(4 * RTCP_INTERVAL_AUDIO_MS + 1);
+  EXPECT_FALSE(rtcp_receiver_->UpdateRTCPReceiveInformationTimers());
+  clock_.AdvanceTimeMs(RTCP_INTERVAL_AUDIO_MS);
+  EXPECT_TRUE(rtcp_receiver_->UpdateRTCPReceiveInformationTimers());
+}
+
+// Measures the time to handle compound packets with 1, 31 and 100+ report
+// blocks, from a single sender and from one sender per block.
+TEST_F(RtcpReceiverTest, ParseCompoundPacketsBenchmark) {
+  const int kNumRuns = 2000;
+  const struct {
+    int num_senders;
+    int blocks_per_sender;
+  } kCases[] = {
+    { 1, 1 },
+    { 1, 31 },
+    { 4, 31 },
+    { 31, 1 },
+    { 124, 1 },
+  };
+
+  printf("\nRTCP compound packet handling [us / packet]:\n");
+  for (size_t n = 0; n < sizeof(kCases) / sizeof(kCases[0]); n++) {
+    BuildCompoundPacket(kCases[n].num_senders, kCases[n].blocks_per_sender);
+    TickInterval acc_ticks;
+    for (int run = 0; run < kNumRuns; run++) {
+      TickTime t0 = TickTime::Now();
+      ASSERT_EQ(0, InjectPacket());
+      rtcp_receiver_->UpdateRTCPReceiveInformationTimers();
+      acc_ticks += TickTime::Now() - t0;
+      clock_.AdvanceTimeMs(10);
+    }
+    printf("%3d senders x %2d blocks: %.2f\n", kCases[n].num_senders,
+           kCases[n].blocks_per_sender,
+           static_cast<double>(acc_ticks.Microseconds()) / kNumRuns);
+  }
+}
+
+} // namespace
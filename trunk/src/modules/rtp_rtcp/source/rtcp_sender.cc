@@ -175,6 +175,13 @@ RTCPSender::RegisterSendTransport(Transport* outgoingTransport)
     return 0;
 }
 
+Transport*
+RTCPSender::SendTransport() const
+{
+    CriticalSectionScoped lock(_criticalSectionTransport);
+    return _cbTransport;
+}
+
 RTCPMethod
 RTCPSender::Status() const
 {
@@ -1631,10 +1638,28 @@ RTCPSender::SendRTCP(const WebRtc_UWord32 packetTypeFlags,
                      const WebRtc_UWord32 RTT,           // FIR
                      const WebRtc_UWord64 pictureID)     // SLI & RPSI
 {
-    WebRtc_UWord32 rtcpPacketTypeFlags = packetTypeFlags;
     WebRtc_UWord32 pos = 0;
     WebRtc_UWord8 rtcpbuffer[IP_PACKET_SIZE];
 
+    if(BuildRTCP(rtcpbuffer, pos, packetTypeFlags, nackSize, nackList, RTT,
+                 pictureID) != 0)
+    {
+        return -1;
+    }
+    return SendToNetwork(rtcpbuffer, (WebRtc_UWord16)pos);
+}
+
+WebRtc_Word32
+RTCPSender::BuildRTCP(WebRtc_UWord8* rtcpbuffer,
+                      WebRtc_UWord32& pos,
+                      const WebRtc_UWord32 packetTypeFlags,
+                      const WebRtc_Word32 nackSize,       // NACK
+                      const WebRtc_UWord16* nackList,     // NACK
+                      const WebRtc_UWord32 RTT,           // FIR
+                      const WebRtc_UWord64 pictureID)     // SLI & RPSI
+{
+    WebRtc_UWord32 rtcpPacketTypeFlags = packetTypeFlags;
+
     do  // only to be able to use break :) (and the critsect must be inside its own scope)
     {
         // collect the received information
@@ -2011,7 +2036,7 @@ RTCPSender::SendRTCP(const WebRtc_UWord32 packetTypeFlags,
         }
     }while (false);
 
-    return SendToNetwork(rtcpbuffer, (WebRtc_UWord16)pos);
+    return 0;
 }
 
 WebRtc_Word32
@@ -35,6 +35,9 @@ public:
 
     WebRtc_Word32 RegisterSendTransport(Transport* outgoingTransport);
 
+    // The transport registered by RegisterSendTransport(), or NULL.
+    Transport* SendTransport() const;
+
     RTCPMethod Status() const;
     WebRtc_Word32 SetRTCPStatus(const RTCPMethod method);
 
@@ -69,6 +72,20 @@ public:
                            const WebRtc_UWord32 RTT = 0,
                            const WebRtc_UWord64 pictureID = 0);
 
+    // Builds the packets SendRTCP() would send into |rtcpbuffer| from |pos|
+    // on, without sending them. Used by a default module that aggregates
+    // the reports of its child modules into one compound packet.
+    WebRtc_Word32 BuildRTCP(WebRtc_UWord8* rtcpbuffer,
+                            WebRtc_UWord32& pos,
+                            const WebRtc_UWord32 rtcpPacketTypeFlags,
+                            const WebRtc_Word32 nackSize = 0,
+                            const WebRtc_UWord16* nackList = 0,
+                            const WebRtc_UWord32 RTT = 0,
+                            const WebRtc_UWord64 pictureID = 0);
+
+    WebRtc_Word32 SendToNetwork(const WebRtc_UWord8* dataBuffer,
+                                const WebRtc_UWord16 length);
+
     WebRtc_Word32 AddReportBlock(const WebRtc_UWord32 SSRC,
                                  const RTCPReportBlock* receiveBlock);
 
@@ -129,9 +146,6 @@ public:
     WebRtc_UWord32 CalculateNewTargetBitrate(WebRtc_UWord32 RTT);
 
 private:
-    WebRtc_Word32 SendToNetwork(const WebRtc_UWord8* dataBuffer,
-                              const WebRtc_UWord16 length);
-
     void UpdatePacketRate();
 
     WebRtc_Word32 AddReportBlocks(WebRtc_UWord8* rtcpbuffer,
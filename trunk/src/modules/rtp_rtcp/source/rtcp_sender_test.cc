@@ -15,10 +15,15 @@
 
 #include <gtest/gtest.h>
 
+#include <stdio.h>
+
+#include <vector>
+
 #include "common_types.h"
 #include "rtp_utility.h"
 #include "rtcp_sender.h"
 #include "rtcp_receiver.h"
+#include "rtp_rtcp_config.h"
 #include "rtp_rtcp_impl.h"
 
 namespace webrtc {
@@ -170,6 +175,155 @@ TEST_F(RtcpSenderTest, TestCompound_NoRtpReceived) {
       kRtcpTransmissionTimeOffset);
 }
 
+class FakeRtcpClock : public RtpRtcpClock {
+ public:
+  FakeRtcpClock() : time_ms_(1000) {}
+  virtual WebRtc_UWord32 GetTimeInMS() { return time_ms_; }
+  virtual void CurrentNTP(WebRtc_UWord32& secs, WebRtc_UWord32& frac) {
+    secs = time_ms_ / 1000;
+    frac = 0;
+  }
+  void AdvanceTimeMs(WebRtc_UWord32 ms) { time_ms_ += ms; }
+ private:
+  WebRtc_UWord32 time_ms_;
+};
+
+// Counts the RTCP packets and the SR/RR packets inside them.
+class RtcpCountingTransport : public Transport {
+ public:
+  RtcpCountingTransport() : rtcp_packets_(0), reports_(0) {}
+
+  virtual int SendPacket(int /*ch*/, const void* /*data*/, int /*len*/) {
+    return -1;
+  }
+
+  virtual int SendRTCPPacket(int /*ch*/, const void *packet, int packet_len) {
+    EXPECT_LE(packet_len, IP_PACKET_SIZE - 28);
+    RTCPUtility::RTCPParserV2 rtcpParser((WebRtc_UWord8*)packet,
+                                         (WebRtc_Word32)packet_len,
+                                         false);  // Must be compound.
+    EXPECT_TRUE(rtcpParser.IsValid());
+    ++rtcp_packets_;
+    RTCPUtility::RTCPPacketTypes type = rtcpParser.Begin();
+    while (type != RTCPUtility::kRtcpNotValidCode) {
+      if (type == RTCPUtility::kRtcpSrCode ||
+          type == RTCPUtility::kRtcpRrCode) {
+        ++reports_;
+      }
+      type = rtcpParser.Iterate();
+    }
+    return packet_len;
+  }
+
+  int rtcp_packets_;
+  int reports_;
+};
+
+// As in ViE, the default module has no transport of its own; its child
+// modules have the transports of their channels.
+class RtcpAggregationTest : public ::testing::Test {
+ protected:
+  RtcpAggregationTest() : default_module_(0, false, &clock_) {}
+
+  ~RtcpAggregationTest() {
+    for (size_t i = 0; i < children_.size(); ++i) {
+      delete children_[i];
+    }
+  }
+
+  void AddChildModules(int num_children, Transport* transport) {
+    for (int i = 0; i < num_children; ++i) {
+      ModuleRtpRtcpImpl* child = new ModuleRtpRtcpImpl(
+          static_cast<WebRtc_Word32>(children_.size() + 1), false, &clock_);
+      char cname[RTCP_CNAME_SIZE];
+      sprintf(cname, "child%03d@example.org", static_cast<int>(i));
+      EXPECT_EQ(0, child->RegisterSendTransport(transport));
+      EXPECT_EQ(0, child->SetRTCPStatus(kRtcpCompound));
+      EXPECT_EQ(0, child->SetCNAME(cname));
+      EXPECT_EQ(0, child->RegisterDefaultModule(&default_module_));
+      children_.push_back(child);
+    }
+  }
+
+  void ProcessAll() {
+    for (size_t i = 0; i < children_.size(); ++i) {
+      children_[i]->Process();
+    }
+    default_module_.Process();
+  }
+
+  FakeRtcpClock clock_;
+  RtcpCountingTransport child_transport_;
+  ModuleRtpRtcpImpl default_module_;
+  std::vector<ModuleRtpRtcpImpl*> children_;
+};
+
+TEST_F(RtcpAggregationTest, DefaultModuleSendsReportsOfAllChildren) {
+  AddChildModules(3, &child_transport_);
+  EXPECT_FALSE(default_module_.RTCPAggregation());
+  EXPECT_EQ(0, default_module_.SetRTCPAggregationStatus(true));
+  EXPECT_TRUE(default_module_.RTCPAggregation());
+  EXPECT_EQ(-1, children_[0]->SetRTCPAggregationStatus(true));
+
+  // The default module has no transport, so the reports are sent on the
+  // transport of the child modules.
+  clock_.AdvanceTimeMs(RTCP_INTERVAL_VIDEO_MS);
+  ProcessAll();
+  EXPECT_EQ(1, child_transport_.rtcp_packets_);
+  EXPECT_EQ(3, child_transport_.reports_);
+
+  // Nothing is due right after the reports were sent.
+  ProcessAll();
+  EXPECT_EQ(1, child_transport_.rtcp_packets_);
+
+  // Without aggregation each child module sends its own report.
+  EXPECT_EQ(0, default_module_.SetRTCPAggregationStatus(false));
+  clock_.AdvanceTimeMs(2 * RTCP_INTERVAL_VIDEO_MS);
+  ProcessAll();
+  EXPECT_EQ(4, child_transport_.rtcp_packets_);
+  EXPECT_EQ(6, child_transport_.reports_);
+}
+
+TEST_F(RtcpAggregationTest, ReportsAreSplitAtTheMtu) {
+  EXPECT_EQ(0, default_module_.SetRTCPAggregationStatus(true));
+  // Registered after aggregation was turned on.
+  AddChildModules(60, &child_transport_);
+
+  clock_.AdvanceTimeMs(RTCP_INTERVAL_VIDEO_MS);
+  ProcessAll();
+  // About 40 bytes per report, i.e. two packets for 60 child modules.
+  EXPECT_EQ(2, child_transport_.rtcp_packets_);
+  EXPECT_EQ(60, child_transport_.reports_);
+
+  // A child module that leaves sends its own reports again.
+  ModuleRtpRtcpImpl* child = children_.back();
+  EXPECT_EQ(0, child->DeRegisterDefaultModule());
+  clock_.AdvanceTimeMs(2 * RTCP_INTERVAL_VIDEO_MS);
+  child->Process();
+  EXPECT_EQ(3, child_transport_.rtcp_packets_);
+  EXPECT_EQ(61, child_transport_.reports_);
+}
+
+TEST_F(RtcpAggregationTest, ReportsAreOnlyAggregatedPerTransport) {
+  // E.g. a conference, where each channel sends to another peer.
+  RtcpCountingTransport default_transport;
+  RtcpCountingTransport other_transport;
+  EXPECT_EQ(0, default_module_.RegisterSendTransport(&default_transport));
+  AddChildModules(2, &child_transport_);
+  AddChildModules(1, &other_transport);
+  AddChildModules(1, NULL);
+  EXPECT_EQ(0, default_module_.SetRTCPAggregationStatus(true));
+
+  clock_.AdvanceTimeMs(RTCP_INTERVAL_VIDEO_MS);
+  ProcessAll();
+  EXPECT_EQ(1, child_transport_.rtcp_packets_);
+  EXPECT_EQ(2, child_transport_.reports_);
+  EXPECT_EQ(1, other_transport.rtcp_packets_);
+  EXPECT_EQ(1, other_transport.reports_);
+  // No report is sent to a peer it is not meant for.
+  EXPECT_EQ(0, default_transport.rtcp_packets_);
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
 
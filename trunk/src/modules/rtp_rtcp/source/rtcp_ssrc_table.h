@@ -0,0 +1,263 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_RTP_RTCP_SOURCE_RTCP_SSRC_TABLE_H_
+#define WEBRTC_MODULES_RTP_RTCP_SOURCE_RTCP_SSRC_TABLE_H_
+
+#include <assert.h>
+#include <string.h>
+
+#include "typedefs.h"
+
+namespace webrtc {
+namespace RTCPHelp
+{
+
+// Open-addressed hash table mapping an SSRC to per-source state of type T.
+//
+// Entries are stored densely so that walking all of them touches contiguous
+// memory, and the hash slots only hold indices into the dense arrays. Objects
+// released by Erase() are kept in a pool and handed out again by
+// FindOrCreate(), so steady-state RTCP handling does not allocate. T must be
+// default constructible and provide a Reset() method that restores the
+// default-constructed state; pointers to entries stay valid until the entry
+// is erased.
+template<class T>
+class RTCPSsrcTable
+{
+public:
+    RTCPSsrcTable();
+    ~RTCPSsrcTable();
+
+    // Returns the entry for |ssrc| or NULL.
+    T* Find(const WebRtc_UWord32 ssrc) const;
+
+    // Returns the entry for |ssrc|, creating it if it does not exist.
+    T* FindOrCreate(const WebRtc_UWord32 ssrc);
+
+    // Removes |ssrc| and returns its object to the pool. The last dense entry
+    // is moved into the freed position. Returns false if |ssrc| is unknown.
+    bool Erase(const WebRtc_UWord32 ssrc);
+
+    // Dense access, 0 <= index < Size(). Erasing the entry at |index| moves
+    // another entry into |index|, so a loop that erases should not advance.
+    WebRtc_UWord32 Size() const { return _size; }
+    WebRtc_UWord32 SsrcAt(const WebRtc_UWord32 index) const;
+    T* ItemAt(const WebRtc_UWord32 index) const;
+
+private:
+    enum { kInitialSlots = 16 };
+    enum { kEmptySlot = -1 };
+
+    // Preferred slot of |ssrc|.
+    WebRtc_UWord32 Home(const WebRtc_UWord32 ssrc) const;
+
+    // Returns the slot holding |ssrc|, or the empty slot where it would go.
+    WebRtc_UWord32 Probe(const WebRtc_UWord32 ssrc) const;
+    void Grow();
+
+    WebRtc_UWord32  _numSlots;    // Power of two.
+    WebRtc_Word32*  _slots;       // Index into the dense arrays or kEmptySlot.
+    WebRtc_UWord32  _capacity;    // Dense capacity, half of _numSlots.
+    WebRtc_UWord32* _ssrcs;
+    T**             _items;
+    WebRtc_UWord32  _size;
+    T**             _pool;
+    WebRtc_UWord32  _poolSize;
+};
+
+template<class T>
+RTCPSsrcTable<T>::RTCPSsrcTable() :
+    _numSlots(kInitialSlots),
+    _slots(new WebRtc_Word32[kInitialSlots]),
+    _capacity(kInitialSlots / 2),
+    _ssrcs(new WebRtc_UWord32[kInitialSlots / 2]),
+    _items(new T*[kInitialSlots / 2]),
+    _size(0),
+    _pool(new T*[kInitialSlots / 2]),
+    _poolSize(0)
+{
+    for (WebRtc_UWord32 i = 0; i < _numSlots; i++)
+    {
+        _slots[i] = kEmptySlot;
+    }
+}
+
+template<class T>
+RTCPSsrcTable<T>::~RTCPSsrcTable()
+{
+    for (WebRtc_UWord32 i = 0; i < _size; i++)
+    {
+        delete _items[i];
+    }
+    for (WebRtc_UWord32 i = 0; i < _poolSize; i++)
+    {
+        delete _pool[i];
+    }
+    delete [] _slots;
+    delete [] _ssrcs;
+    delete [] _items;
+    delete [] _pool;
+}
+
+template<class T>
+WebRtc_UWord32 RTCPSsrcTable<T>::Home(const WebRtc_UWord32 ssrc) const
+{
+    // Fibonacci hashing; SSRCs are random but test setups often use small
+    // consecutive values.
+    const WebRtc_UWord32 hash = ssrc * 2654435761u;
+    return (hash ^ (hash >> 16)) & (_numSlots - 1);
+}
+
+template<class T>
+WebRtc_UWord32 RTCPSsrcTable<T>::Probe(const WebRtc_UWord32 ssrc) const
+{
+    const WebRtc_UWord32 mask = _numSlots - 1;
+    WebRtc_UWord32 slot = Home(ssrc);
+    while (_slots[slot] != kEmptySlot && _ssrcs[_slots[slot]] != ssrc)
+    {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+template<class T>
+T* RTCPSsrcTable<T>::Find(const WebRtc_UWord32 ssrc) const
+{
+    const WebRtc_Word32 index = _slots[Probe(ssrc)];
+    if (index == kEmptySlot)
+    {
+        return NULL;
+    }
+    return _items[index];
+}
+
+template<class T>
+T* RTCPSsrcTable<T>::FindOrCreate(const WebRtc_UWord32 ssrc)
+{
+    WebRtc_UWord32 slot = Probe(ssrc);
+    if (_slots[slot] != kEmptySlot)
+    {
+        return _items[_slots[slot]];
+    }
+    if (_size == _capacity)
+    {
+        Grow();
+        slot = Probe(ssrc);
+    }
+    T* item = NULL;
+    if (_poolSize > 0)
+    {
+        item = _pool[--_poolSize];
+        item->Reset();
+    } else
+    {
+        item = new T;
+    }
+    _ssrcs[_size] = ssrc;
+    _items[_size] = item;
+    _slots[slot] = static_cast<WebRtc_Word32>(_size);
+    _size++;
+    return item;
+}
+
+template<class T>
+bool RTCPSsrcTable<T>::Erase(const WebRtc_UWord32 ssrc)
+{
+    const WebRtc_UWord32 mask = _numSlots - 1;
+    WebRtc_UWord32 slot = Probe(ssrc);
+    const WebRtc_Word32 index = _slots[slot];
+    if (index == kEmptySlot)
+    {
+        return false;
+    }
+    // Objects in the pool plus live entries never exceed the dense capacity.
+    _pool[_poolSize++] = _items[index];
+
+    // Backward-shift deletion keeps probe sequences intact without
+    // tombstones.
+    WebRtc_UWord32 hole = slot;
+    WebRtc_UWord32 next = (hole + 1) & mask;
+    while (_slots[next] != kEmptySlot)
+    {
+        const WebRtc_UWord32 home = Home(_ssrcs[_slots[next]]);
+        // Move the entry back if its home slot is not in (hole, next].
+        if (((next - home) & mask) >= ((next - hole) & mask))
+        {
+            _slots[hole] = _slots[next];
+            hole = next;
+        }
+        next = (next + 1) & mask;
+    }
+    _slots[hole] = kEmptySlot;
+
+    // Keep the dense arrays packed by moving the last entry into the gap.
+    const WebRtc_UWord32 last = _size - 1;
+    if (static_cast<WebRtc_UWord32>(index) != last)
+    {
+        _ssrcs[index] = _ssrcs[last];
+        _items[index] = _items[last];
+        _slots[Probe(_ssrcs[index])] = index;
+    }
+    _size--;
+    return true;
+}
+
+template<class T>
+WebRtc_UWord32 RTCPSsrcTable<T>::SsrcAt(const WebRtc_UWord32 index) const
+{
+    assert(index < _size);
+    return _ssrcs[index];
+}
+
+template<class T>
+T* RTCPSsrcTable<T>::ItemAt(const WebRtc_UWord32 index) const
+{
+    assert(index < _size);
+    return _items[index];
+}
+
+template<class T>
+void RTCPSsrcTable<T>::Grow()
+{
+    const WebRtc_UWord32 numSlots = _numSlots * 2;
+    const WebRtc_UWord32 capacity = numSlots / 2;
+
+    WebRtc_UWord32* ssrcs = new WebRtc_UWord32[capacity];
+    T** items = new T*[capacity];
+    T** pool = new T*[capacity];
+    memcpy(ssrcs, _ssrcs, sizeof(WebRtc_UWord32) * _size);
+    memcpy(items, _items, sizeof(T*) * _size);
+    memcpy(pool, _pool, sizeof(T*) * _poolSize);
+    delete [] _ssrcs;
+    delete [] _items;
+    delete [] _pool;
+    _ssrcs = ssrcs;
+    _items = items;
+    _pool = pool;
+    _capacity = capacity;
+
+    delete [] _slots;
+    _numSlots = numSlots;
+    _slots = new WebRtc_Word32[_numSlots];
+    for (WebRtc_UWord32 i = 0; i < _numSlots; i++)
+    {
+        _slots[i] = kEmptySlot;
+    }
+    for (WebRtc_UWord32 i = 0; i < _size; i++)
+    {
+        _slots[Probe(_ssrcs[i])] = static_cast<WebRtc_Word32>(i);
+    }
+}
+
+} // namespace RTCPHelp
+} // namespace webrtc
+
+#endif // WEBRTC_MODULES_RTP_RTCP_SOURCE_RTCP_SSRC_TABLE_H_
@@ -0,0 +1,127 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/*
+ * This file includes unit tests for the RTCPSsrcTable.
+ */
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <stdlib.h>
+
+#include "typedefs.h"
+#include "rtcp_ssrc_table.h"
+
+namespace {
+
+using webrtc::RTCPHelp::RTCPSsrcTable;
+
+struct TestEntry {
+  TestEntry() : value(0), resets(0) {}
+  void Reset() {
+    value = 0;
+    resets++;
+  }
+  int value;
+  int resets;
+};
+
+TEST(RtcpSsrcTableTest, FindOrCreate) {
+  RTCPSsrcTable<TestEntry> table;
+  EXPECT_EQ(0u, table.Size());
+  EXPECT_TRUE(table.Find(1234) == NULL);
+
+  TestEntry* entry = table.FindOrCreate(1234);
+  ASSERT_TRUE(entry != NULL);
+  entry->value = 17;
+  EXPECT_EQ(1u, table.Size());
+  EXPECT_EQ(entry, table.Find(1234));
+  EXPECT_EQ(entry, table.FindOrCreate(1234));
+  EXPECT_EQ(1u, table.Size());
+  EXPECT_EQ(1234u, table.SsrcAt(0));
+  EXPECT_EQ(entry, table.ItemAt(0));
+}
+
+TEST(RtcpSsrcTableTest, EraseReusesPooledEntries) {
+  RTCPSsrcTable<TestEntry> table;
+  TestEntry* entry = table.FindOrCreate(1);
+  entry->value = 5;
+  EXPECT_FALSE(table.Erase(2));
+  EXPECT_TRUE(table.Erase(1));
+  EXPECT_EQ(0u, table.Size());
+  EXPECT_TRUE(table.Find(1) == NULL);
+
+  // The released object is handed out again, reset.
+  TestEntry* reused = table.FindOrCreate(3);
+  EXPECT_EQ(entry, reused);
+  EXPECT_EQ(0, reused->value);
+  EXPECT_EQ(1, reused->resets);
+}
+
+TEST(RtcpSsrcTableTest, EntriesStayValidWhenGrowing) {
+  RTCPSsrcTable<TestEntry> table;
+  TestEntry* first = table.FindOrCreate(0);
+  first->value = 42;
+  for (WebRtc_UWord32 ssrc = 1; ssrc < 1000; ssrc++) {
+    table.FindOrCreate(ssrc)->value = ssrc;
+  }
+  EXPECT_EQ(1000u, table.Size());
+  EXPECT_EQ(first, table.Find(0));
+  EXPECT_EQ(42, first->value);
+  for (WebRtc_UWord32 ssrc = 1; ssrc < 1000; ssrc++) {
+    ASSERT_TRUE(table.Find(ssrc) != NULL);
+    EXPECT_EQ(static_cast<int>(ssrc), table.Find(ssrc)->value);
+  }
+}
+
+TEST(RtcpSsrcTableTest, EraseWhileIterating) {
+  RTCPSsrcTable<TestEntry> table;
+  for (WebRtc_UWord32 ssrc = 0; ssrc < 100; ssrc++) {
+    table.FindOrCreate(ssrc)->value = ssrc;
+  }
+  // Erase all odd SSRCs without advancing past moved entries.
+  WebRtc_UWord32 i = 0;
+  while (i < table.Size()) {
+    if (table.SsrcAt(i) % 2) {
+      table.Erase(table.SsrcAt(i));
+    } else {
+      i++;
+    }
+  }
+  EXPECT_EQ(50u, table.Size());
+  for (WebRtc_UWord32 ssrc = 0; ssrc < 100; ssrc++) {
+    EXPECT_EQ(ssrc % 2 == 0, table.Find(ssrc) != NULL);
+  }
+}
+
+TEST(RtcpSsrcTableTest, MatchesStdMap) {
+  RTCPSsrcTable<TestEntry> table;
+  std::map<WebRtc_UWord32, int> reference;
+  srand(1234);
+  for (int n = 0; n < 20000; n++) {
+    // A small key space gives many collisions, erases and reinserts.
+    const WebRtc_UWord32 ssrc = (rand() % 300) * 65536;
+    if (rand() % 3 == 0) {
+      EXPECT_EQ(reference.erase(ssrc) == 1, table.Erase(ssrc));
+    } else {
+      table.FindOrCreate(ssrc)->value = n;
+      reference[ssrc] = n;
+    }
+    ASSERT_EQ(reference.size(), table.Size());
+  }
+  std::map<WebRtc_UWord32, int>::const_iterator it;
+  for (it = reference.begin(); it != reference.end(); ++it) {
+    ASSERT_TRUE(table.Find(it->first) != NULL);
+    EXPECT_EQ(it->second, table.Find(it->first)->value);
+  }
+}
+
+} // namespace
@@ -26,6 +26,13 @@ RTCPUtility::RTCPCnameInformation::~RTCPCnameInformation()
 {
 }
 
+void
+RTCPUtility::RTCPCnameInformation::Reset()
+{
+    length = 0;
+    memset(name, 0, sizeof(name));
+}
+
 ///////////
 // RTCPParserV2 : currently read only
 
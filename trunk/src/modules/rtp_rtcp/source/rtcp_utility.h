@@ -26,6 +26,8 @@ namespace RTCPUtility {
         RTCPCnameInformation();
         ~RTCPCnameInformation();
 
+        void Reset();
+
         WebRtc_UWord8      name[RTCP_CNAME_SIZE];
         WebRtc_UWord8      length;
     };
@@ -16,33 +16,29 @@
 namespace webrtc {
 
 RtpHeaderExtensionMap::RtpHeaderExtensionMap() {
+  Erase();
 }
 
 RtpHeaderExtensionMap::~RtpHeaderExtensionMap() {
-  Erase();
 }
 
 void RtpHeaderExtensionMap::Erase() {
-  while (extensionMap_.Size() != 0) {
-    MapItem* item = extensionMap_.First();
-    assert(item);
-    HeaderExtension* extension = (HeaderExtension*)item->GetItem();
-    extensionMap_.Erase(item);
-    delete extension;
+  for (int id = 0; id <= kRtpOneByteHeaderExtensionMaxId; ++id) {
+    types_[id] = NONE;
   }
+  size_ = 0;
 }
 
 WebRtc_Word32 RtpHeaderExtensionMap::Register(const RTPExtensionType type,
                                               const WebRtc_UWord8 id) {
-  if (id < 1 || id > 14) {
+  if (id < 1 || id > kRtpOneByteHeaderExtensionMaxId) {
     return -1;
   }
-  MapItem* item = extensionMap_.Find(id);
-  if (item != NULL) {
+  if (types_[id] != NONE) {
     return -1;
   }
-  HeaderExtension* extension = new HeaderExtension(type);
-  extensionMap_.Insert(id, extension);
+  types_[id] = type;
+  ++size_;
   return 0;
 }
 
@@ -51,39 +47,32 @@ WebRtc_Word32 RtpHeaderExtensionMap::Deregister(const RTPExtensionType type) {
   if (GetId(type, &id) != 0) {
     return -1;
   }
-  MapItem* item = extensionMap_.Find(id);
-  if (item == NULL) {
-    return -1;
-  }
-  HeaderExtension* extension = (HeaderExtension*)item->GetItem();
-  extensionMap_.Erase(item);
-  delete extension;
+  types_[id] = NONE;
+  --size_;
   return 0;
 }
 
 WebRtc_Word32 RtpHeaderExtensionMap::GetType(const WebRtc_UWord8 id,
                                              RTPExtensionType* type) const {
   assert(type);
-  MapItem* item = extensionMap_.Find(id);
-  if (item == NULL) {
+  if (id > kRtpOneByteHeaderExtensionMaxId || types_[id] == NONE) {
     return -1;
   }
-  HeaderExtension* extension = (HeaderExtension*)item->GetItem();
-  *type = extension->type;
+  *type = types_[id];
   return 0;
 }
 
 WebRtc_Word32 RtpHeaderExtensionMap::GetId(const RTPExtensionType type,
                                            WebRtc_UWord8* id) const {
   assert(id);
-  MapItem* item = extensionMap_.First();
-  while (item != NULL) {
-    HeaderExtension* extension = (HeaderExtension*)item->GetItem();
-    if (extension->type == type) {
-      *id = item->GetId();
+  if (type == NONE) {
+    return -1;
+  }
+  for (int i = 1; i <= kRtpOneByteHeaderExtensionMaxId; ++i) {
+    if (types_[i] == type) {
+      *id = static_cast<WebRtc_UWord8>(i);
       return 0;
     }
-    item = extensionMap_.Next(item);
   }
   return -1;
 }
@@ -92,11 +81,10 @@ WebRtc_UWord16 RtpHeaderExtensionMap::GetTotalLengthInBytes() const
 {
   // Get length for each extension block.
   WebRtc_UWord16 length = 0;
-  MapItem* item = extensionMap_.First();
-  while (item != NULL) {
-    HeaderExtension* extension = (HeaderExtension*)item->GetItem();
-    length += extension->length;
-    item = extensionMap_.Next(item);
+  for (int id = 1; id <= kRtpOneByteHeaderExtensionMaxId; ++id) {
+    if (types_[id] != NONE) {
+      length += HeaderExtension(types_[id]).length;
+    }
   }
   // Add RTP extension header length.
   if (length > 0) {
@@ -106,16 +94,16 @@ WebRtc_UWord16 RtpHeaderExtensionMap::GetTotalLengthInBytes() const
 }
 
 WebRtc_Word32 RtpHeaderExtensionMap::Size() const {
-  return extensionMap_.Size();
+  return size_;
 }
 
 RTPExtensionType RtpHeaderExtensionMap::First() const {
-  MapItem* item = extensionMap_.First();
-  if (item == NULL) {
-     return NONE;
+  for (int id = 1; id <= kRtpOneByteHeaderExtensionMaxId; ++id) {
+    if (types_[id] != NONE) {
+      return types_[id];
+    }
   }
-  HeaderExtension* extension = (HeaderExtension*)item->GetItem();
-  return extension->type;
+  return NONE;
 }
 
 RTPExtensionType RtpHeaderExtensionMap::Next(RTPExtensionType type) const
@@ -124,25 +112,20 @@ RTPExtensionType RtpHeaderExtensionMap::Next(RTPExtensionType type) const
   if (GetId(type, &id) != 0) {
     return NONE;
   }
-  MapItem* item = extensionMap_.Find(id);
-  if (item == NULL) {
-    return NONE;
-  }
-  item = extensionMap_.Next(item);
-  if (item == NULL) {
-    return NONE;
+  for (int i = id + 1; i <= kRtpOneByteHeaderExtensionMaxId; ++i) {
+    if (types_[i] != NONE) {
+      return types_[i];
+    }
   }
-  HeaderExtension* extension = (HeaderExtension*)item->GetItem();
-  return extension->type;
+  return NONE;
 }
 
 void RtpHeaderExtensionMap::GetCopy(RtpHeaderExtensionMap* map) const {
   assert(map);
-  MapItem* item = extensionMap_.First();
-  while (item != NULL) {
-    HeaderExtension* extension = (HeaderExtension*)item->GetItem();
-    map->Register(extension->type, item->GetId());
-    item = extensionMap_.Next(item);
+  for (int id = 1; id <= kRtpOneByteHeaderExtensionMaxId; ++id) {
+    if (types_[id] != NONE) {
+      map->Register(types_[id], static_cast<WebRtc_UWord8>(id));
+    }
   }
 }
 } // namespace webrtc
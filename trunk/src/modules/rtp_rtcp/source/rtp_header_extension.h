@@ -11,7 +11,6 @@
 #ifndef WEBRTC_MODULES_RTP_RTCP_RTP_HEADER_EXTENSION_H_
 #define WEBRTC_MODULES_RTP_RTCP_RTP_HEADER_EXTENSION_H_
 
-#include "map_wrapper.h"
 #include "rtp_rtcp_defines.h"
 #include "typedefs.h"
 
@@ -19,6 +18,9 @@ namespace webrtc {
 
 enum {RTP_ONE_BYTE_HEADER_EXTENSION = 0xbede};
 
+// Valid ids for one-byte header extensions are 1 to 14.
+enum {kRtpOneByteHeaderExtensionMaxId = 14};
+
 enum ExtensionLength {
    RTP_ONE_BYTE_HEADER_LENGTH_IN_BYTES = 4,
    TRANSMISSION_TIME_OFFSET_LENGTH_IN_BYTES = 4
@@ -37,6 +39,8 @@ struct HeaderExtension {
    WebRtc_UWord8 length;
 };
 
+// Maps one-byte header extension ids to extension types. The map is a fixed
+// array indexed by id, which doesn't allocate and can be copied by value.
 class RtpHeaderExtensionMap {
  public:
   RtpHeaderExtensionMap();
@@ -63,7 +67,9 @@ class RtpHeaderExtensionMap {
   RTPExtensionType Next(RTPExtensionType type) const;
 
  private:
-  MapWrapper extensionMap_;
+  // NONE for ids that are not registered. Id 0 is never registered.
+  RTPExtensionType types_[kRtpOneByteHeaderExtensionMaxId + 1];
+  WebRtc_Word32 size_;
 };
 }
 #endif // WEBRTC_MODULES_RTP_RTCP_RTP_HEADER_EXTENSION_H_
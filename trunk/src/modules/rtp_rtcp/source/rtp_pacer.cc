@@ -0,0 +1,283 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtp_pacer.h"
+
+#include <string.h>  // memcpy
+
+#include "critical_section_wrapper.h"
+
+namespace webrtc {
+
+// Packets that may be queued before new packets are dropped.
+enum { kMaxQueuedPackets = 1000 };
+// Packet buffers kept for reuse when the queue drains.
+enum { kMaxFreePackets = 64 };
+// The budget never grows larger than what the target rate allows in this
+// time, which bounds the burst sent after an idle period.
+enum { kMaxBudgetMs = 2 * RTPPacer::kProcessIntervalMs };
+
+RTPPacer::RTPPacer(RtpRtcpClock* clock) :
+    _clock(*clock),
+    _critSect(CriticalSectionWrapper::CreateCriticalSection()),
+    _enabled(false),
+    _bitrateMultiplier(1.0f),
+    _targetBitrateKbit(0),
+    _bytesRemaining(0),
+    _lastUpdateTimeMs(0),
+    _freePackets(),
+    _queuedBytes(0),
+    _sentPackets(0),
+    _droppedPackets(0),
+    _totalQueueDelayMs(0),
+    _maxQueueDelayMs(0)
+{
+}
+
+RTPPacer::~RTPPacer()
+{
+    for (int i = 0; i < kNumPriorities; i++)
+    {
+        while (!_queue[i].empty())
+        {
+            delete _queue[i].front();
+            _queue[i].pop_front();
+        }
+    }
+    while (!_freePackets.empty())
+    {
+        delete _freePackets.front();
+        _freePackets.pop_front();
+    }
+    delete _critSect;
+}
+
+WebRtc_Word32
+RTPPacer::SetStatus(const bool enable, const float bitrateMultiplier)
+{
+    if (enable && bitrateMultiplier < 1.0f)
+    {
+        // A rate below the target bitrate would let the queue grow forever.
+        return -1;
+    }
+    CriticalSectionScoped lock(_critSect);
+    if (enable && !_enabled)
+    {
+        _bytesRemaining = 0;
+        _lastUpdateTimeMs = _clock.GetTimeInMS();
+        _sentPackets = 0;
+        _droppedPackets = 0;
+        _totalQueueDelayMs = 0;
+        _maxQueueDelayMs = 0;
+    }
+    _enabled = enable;
+    if (enable)
+    {
+        _bitrateMultiplier = bitrateMultiplier;
+    }
+    return 0;
+}
+
+bool
+RTPPacer::Enabled() const
+{
+    CriticalSectionScoped lock(_critSect);
+    return _enabled;
+}
+
+void
+RTPPacer::Status(bool* enabled, float* bitrateMultiplier) const
+{
+    CriticalSectionScoped lock(_critSect);
+    *enabled = _enabled;
+    *bitrateMultiplier = _bitrateMultiplier;
+}
+
+bool
+RTPPacer::QueuePackets() const
+{
+    CriticalSectionScoped lock(_critSect);
+    return _enabled || !_queue[kHighPriority].empty() ||
+        !_queue[kNormalPriority].empty();
+}
+
+void
+RTPPacer::SetTargetBitrate(const WebRtc_UWord32 bitrateKbit)
+{
+    CriticalSectionScoped lock(_critSect);
+    _targetBitrateKbit = bitrateKbit;
+}
+
+WebRtc_Word32
+RTPPacer::InsertPacket(const WebRtc_UWord8* packet,
+                       const WebRtc_UWord16 length,
+                       const WebRtc_UWord16 rtpHeaderLength,
+                       const Priority priority)
+{
+    if (length > IP_PACKET_SIZE || priority < 0 || priority >= kNumPriorities)
+    {
+        return -1;
+    }
+    CriticalSectionScoped lock(_critSect);
+    if (_queue[kHighPriority].size() + _queue[kNormalPriority].size() >=
+        kMaxQueuedPackets)
+    {
+        _droppedPackets++;
+        return -1;
+    }
+    Packet* queuedPacket = NULL;
+    if (_freePackets.empty())
+    {
+        queuedPacket = new Packet;
+    }
+    else
+    {
+        queuedPacket = _freePackets.front();
+        _freePackets.pop_front();
+    }
+    memcpy(queuedPacket->data, packet, length);
+    queuedPacket->length = length;
+    queuedPacket->rtpHeaderLength = rtpHeaderLength;
+    queuedPacket->enqueueTimeMs = _clock.GetTimeInMS();
+    _queue[priority].push_back(queuedPacket);
+    _queuedBytes += length;
+    return 0;
+}
+
+void
+RTPPacer::UpdateBudget(const WebRtc_UWord32 nowMs)
+{
+    WebRtc_UWord32 elapsedMs = nowMs - _lastUpdateTimeMs;
+    _lastUpdateTimeMs = nowMs;
+    if (elapsedMs > 1000)
+    {
+        // Long enough to pay off any debt; avoids overflowing the budget.
+        elapsedMs = 1000;
+    }
+
+    // kbit/s is bits per ms, i.e. kbit/8 bytes per ms.
+    const float bytesPerMs = _bitrateMultiplier * _targetBitrateKbit / 8;
+    const WebRtc_Word32 maxBudget =
+        static_cast<WebRtc_Word32>(bytesPerMs * kMaxBudgetMs);
+    _bytesRemaining += static_cast<WebRtc_Word32>(bytesPerMs * elapsedMs);
+    if (_bytesRemaining > maxBudget)
+    {
+        _bytesRemaining = maxBudget;
+    }
+}
+
+bool
+RTPPacer::NextPacket(WebRtc_UWord8* buffer,
+                     WebRtc_UWord16* length,
+                     WebRtc_UWord16* rtpHeaderLength,
+                     Priority* priority)
+{
+    CriticalSectionScoped lock(_critSect);
+    int lane = kHighPriority;
+    while (lane < kNumPriorities && _queue[lane].empty())
+    {
+        lane++;
+    }
+    if (lane == kNumPriorities)
+    {
+        return false;
+    }
+    const WebRtc_UWord32 nowMs = _clock.GetTimeInMS();
+    const bool limited = _enabled && _targetBitrateKbit > 0;
+    if (limited)
+    {
+        UpdateBudget(nowMs);
+        if (_bytesRemaining <= 0)
+        {
+            return false;
+        }
+    }
+    Packet* packet = _queue[lane].front();
+    _queue[lane].pop_front();
+    _queuedBytes -= packet->length;
+    if (limited)
+    {
+        _bytesRemaining -= packet->length;
+    }
+
+    memcpy(buffer, packet->data, packet->length);
+    *length = packet->length;
+    *rtpHeaderLength = packet->rtpHeaderLength;
+    *priority = static_cast<Priority>(lane);
+
+    const WebRtc_UWord32 queueDelayMs = nowMs - packet->enqueueTimeMs;
+    _sentPackets++;
+    _totalQueueDelayMs += queueDelayMs;
+    if (queueDelayMs > _maxQueueDelayMs)
+    {
+        _maxQueueDelayMs = queueDelayMs;
+    }
+
+    if (_freePackets.size() < kMaxFreePackets)
+    {
+        _freePackets.push_back(packet);
+    }
+    else
+    {
+        delete packet;
+    }
+    return true;
+}
+
+WebRtc_Word32
+RTPPacer::TimeUntilNextPacket() const
+{
+    CriticalSectionScoped lock(_critSect);
+    if (_queue[kHighPriority].empty() && _queue[kNormalPriority].empty())
+    {
+        return -1;
+    }
+    if (!_enabled || _targetBitrateKbit == 0 || _bytesRemaining > 0)
+    {
+        return 0;
+    }
+    // Time until the budget is positive again.
+    const float bytesPerMs = _bitrateMultiplier * _targetBitrateKbit / 8;
+    const WebRtc_Word32 neededMs =
+        static_cast<WebRtc_Word32>((1 - _bytesRemaining) / bytesPerMs) + 1;
+    const WebRtc_Word32 elapsedMs = _clock.GetTimeInMS() - _lastUpdateTimeMs;
+    if (elapsedMs >= neededMs)
+    {
+        return 0;
+    }
+    return neededMs - elapsedMs;
+}
+
+void
+RTPPacer::Statistics(RtpPacerStatistics* statistics) const
+{
+    CriticalSectionScoped lock(_critSect);
+    const WebRtc_UWord32 nowMs = _clock.GetTimeInMS();
+    statistics->queuedPackets = static_cast<WebRtc_UWord32>(
+        _queue[kHighPriority].size() + _queue[kNormalPriority].size());
+    statistics->queuedBytes = _queuedBytes;
+    statistics->oldestQueueDelayMs = 0;
+    for (int i = 0; i < kNumPriorities; i++)
+    {
+        if (!_queue[i].empty() &&
+            nowMs - _queue[i].front()->enqueueTimeMs >
+                statistics->oldestQueueDelayMs)
+        {
+            statistics->oldestQueueDelayMs =
+                nowMs - _queue[i].front()->enqueueTimeMs;
+        }
+    }
+    statistics->sentPackets = _sentPackets;
+    statistics->droppedPackets = _droppedPackets;
+    statistics->averageQueueDelayMs = (_sentPackets == 0) ? 0 :
+        static_cast<WebRtc_UWord32>(_totalQueueDelayMs / _sentPackets);
+    statistics->maxQueueDelayMs = _maxQueueDelayMs;
+}
+} // namespace webrtc
@@ -0,0 +1,116 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_RTP_RTCP_SOURCE_RTP_PACER_H_
+#define WEBRTC_MODULES_RTP_RTCP_SOURCE_RTP_PACER_H_
+
+#include <list>
+
+#include "rtp_rtcp_config.h"
+#include "rtp_rtcp_defines.h"
+#include "typedefs.h"
+
+namespace webrtc {
+class CriticalSectionWrapper;
+
+// Queue of outgoing RTP packets that are released at a multiple of the target
+// send bitrate, so that the packets of a large frame are spread out in time
+// instead of leaving as one burst. Packets in the high priority lane are
+// always released before the packets in the normal lane. Each RTP module has
+// its own queue, so the lanes only order the packets of one module.
+class RTPPacer
+{
+public:
+    enum Priority
+    {
+        kHighPriority = 0,    // retransmissions and audio
+        kNormalPriority = 1,  // video media
+        kNumPriorities = 2
+    };
+
+    // Period with which Process() of the owning module should release packets
+    // while the queue is not empty.
+    enum { kProcessIntervalMs = 5 };
+
+    RTPPacer(RtpRtcpClock* clock);
+    ~RTPPacer();
+
+    // Turns pacing on or off. Packets are released at |bitrateMultiplier|
+    // times the target bitrate. Packets still queued when pacing is turned off
+    // are released on the next call to NextPacket(), regardless of the rate.
+    WebRtc_Word32 SetStatus(const bool enable, const float bitrateMultiplier);
+    bool Enabled() const;
+    void Status(bool* enabled, float* bitrateMultiplier) const;
+
+    // Returns true if new packets have to go through the queue: pacing is on,
+    // or packets queued before it was turned off are still waiting. Sending
+    // a new packet directly would then overtake them.
+    bool QueuePackets() const;
+
+    void SetTargetBitrate(const WebRtc_UWord32 bitrateKbit);
+
+    // Queues a copy of the packet. Returns -1 if the packet is too large or
+    // the queue is full. The packet is then dropped, since sending it directly
+    // would overtake the queued packets.
+    WebRtc_Word32 InsertPacket(const WebRtc_UWord8* packet,
+                               const WebRtc_UWord16 length,
+                               const WebRtc_UWord16 rtpHeaderLength,
+                               const Priority priority);
+
+    // Copies the next packet that may be sent now into |buffer|, which must
+    // hold IP_PACKET_SIZE bytes. Returns false if the queue is empty or the
+    // budget for this interval is used up.
+    bool NextPacket(WebRtc_UWord8* buffer,
+                    WebRtc_UWord16* length,
+                    WebRtc_UWord16* rtpHeaderLength,
+                    Priority* priority);
+
+    // Returns the time in ms until NextPacket() should be called again, or
+    // -1 if the queue is empty.
+    WebRtc_Word32 TimeUntilNextPacket() const;
+
+    void Statistics(RtpPacerStatistics* statistics) const;
+
+private:
+    struct Packet
+    {
+        WebRtc_UWord8 data[IP_PACKET_SIZE];
+        WebRtc_UWord16 length;
+        WebRtc_UWord16 rtpHeaderLength;
+        WebRtc_UWord32 enqueueTimeMs;
+    };
+
+    void UpdateBudget(const WebRtc_UWord32 nowMs);
+
+    RtpRtcpClock&            _clock;
+    CriticalSectionWrapper*  _critSect;
+
+    bool                     _enabled;
+    float                    _bitrateMultiplier;
+    WebRtc_UWord32           _targetBitrateKbit;
+
+    // Bytes that may still be sent in this interval. It goes negative when a
+    // packet larger than the remaining budget is released.
+    WebRtc_Word32            _bytesRemaining;
+    WebRtc_UWord32           _lastUpdateTimeMs;
+
+    std::list<Packet*>       _queue[kNumPriorities];
+    std::list<Packet*>       _freePackets;
+    WebRtc_UWord32           _queuedBytes;
+
+    // statistics
+    WebRtc_UWord32           _sentPackets;
+    WebRtc_UWord32           _droppedPackets;
+    WebRtc_UWord64           _totalQueueDelayMs;
+    WebRtc_UWord32           _maxQueueDelayMs;
+};
+} // namespace webrtc
+
+#endif // WEBRTC_MODULES_RTP_RTCP_SOURCE_RTP_PACER_H_
@@ -0,0 +1,249 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/*
+ * This file includes unit tests for the RTPPacer.
+ */
+
+#include <string.h>
+
+#include <gtest/gtest.h>
+
+#include "rtp_pacer.h"
+#include "rtp_rtcp_defines.h"
+#include "rtp_rtcp_impl.h"
+#include "typedefs.h"
+
+namespace webrtc {
+
+namespace {
+const int kPacketLength = 1000;
+const int kHeaderLength = 12;
+// 800 kbit/s is 100 bytes per ms, i.e. one packet every 10 ms.
+const WebRtc_UWord32 kTargetBitrateKbit = 800;
+
+class FakeRtpRtcpClock : public RtpRtcpClock {
+ public:
+  FakeRtpRtcpClock() : time_ms_(1000) {}
+  virtual WebRtc_UWord32 GetTimeInMS() { return time_ms_; }
+  virtual void CurrentNTP(WebRtc_UWord32& secs, WebRtc_UWord32& frac) {
+    secs = time_ms_ / 1000;
+    frac = 0;
+  }
+  void AdvanceTimeMs(WebRtc_UWord32 ms) { time_ms_ += ms; }
+ private:
+  WebRtc_UWord32 time_ms_;
+};
+}  // namespace
+
+class RtpPacerTest : public ::testing::Test {
+ protected:
+  RtpPacerTest() : pacer_(&clock_) {
+    memset(packet_, 0, sizeof(packet_));
+    pacer_.SetTargetBitrate(kTargetBitrateKbit);
+    EXPECT_EQ(0, pacer_.SetStatus(true, 1.0f));
+  }
+
+  void InsertPacket(WebRtc_UWord8 id, RTPPacer::Priority priority) {
+    packet_[0] = id;
+    EXPECT_EQ(0, pacer_.InsertPacket(packet_, kPacketLength, kHeaderLength,
+                                     priority));
+  }
+
+  // Returns the id of the released packet, or -1 if none was released.
+  int NextPacket() {
+    WebRtc_UWord16 length = 0;
+    WebRtc_UWord16 header_length = 0;
+    RTPPacer::Priority priority;
+    if (!pacer_.NextPacket(buffer_, &length, &header_length, &priority)) {
+      return -1;
+    }
+    EXPECT_EQ(kPacketLength, length);
+    EXPECT_EQ(kHeaderLength, header_length);
+    return buffer_[0];
+  }
+
+  FakeRtpRtcpClock clock_;
+  RTPPacer pacer_;
+  WebRtc_UWord8 packet_[kPacketLength];
+  WebRtc_UWord8 buffer_[IP_PACKET_SIZE];
+};
+
+TEST_F(RtpPacerTest, ReleasesPacketsAtTargetRate) {
+  for (int i = 0; i < 10; ++i) {
+    InsertPacket(i, RTPPacer::kNormalPriority);
+  }
+  EXPECT_EQ(-1, NextPacket());
+  EXPECT_GT(pacer_.TimeUntilNextPacket(), 0);
+
+  int released = 0;
+  for (int ms = 0; ms < 100; ms += RTPPacer::kProcessIntervalMs) {
+    clock_.AdvanceTimeMs(RTPPacer::kProcessIntervalMs);
+    while (NextPacket() >= 0) {
+      ++released;
+    }
+  }
+  // 100 ms at 100 bytes per ms lets out 10 packets of 1000 bytes.
+  EXPECT_GE(released, 9);
+  EXPECT_LE(released, 10);
+
+  RtpPacerStatistics stats;
+  pacer_.Statistics(&stats);
+  EXPECT_EQ(10u - released, stats.queuedPackets);
+  EXPECT_EQ(static_cast<WebRtc_UWord32>(released), stats.sentPackets);
+  EXPECT_GE(stats.maxQueueDelayMs, 80u);
+  EXPECT_LE(stats.averageQueueDelayMs, stats.maxQueueDelayMs);
+}
+
+TEST_F(RtpPacerTest, HighPriorityLaneGoesFirst) {
+  InsertPacket(1, RTPPacer::kNormalPriority);
+  InsertPacket(2, RTPPacer::kNormalPriority);
+  InsertPacket(3, RTPPacer::kHighPriority);
+  clock_.AdvanceTimeMs(100);
+  EXPECT_EQ(3, NextPacket());
+  clock_.AdvanceTimeMs(10);
+  EXPECT_EQ(1, NextPacket());
+}
+
+TEST_F(RtpPacerTest, TurningPacingOffFlushesTheQueue) {
+  for (int i = 0; i < 5; ++i) {
+    InsertPacket(i, RTPPacer::kNormalPriority);
+  }
+  EXPECT_EQ(-1, NextPacket());
+  EXPECT_EQ(0, pacer_.SetStatus(false, 1.0f));
+  EXPECT_EQ(0, pacer_.TimeUntilNextPacket());
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(i, NextPacket());
+  }
+  EXPECT_EQ(-1, NextPacket());
+  EXPECT_EQ(-1, pacer_.TimeUntilNextPacket());
+}
+
+TEST_F(RtpPacerTest, RejectsRateBelowTarget) {
+  EXPECT_EQ(-1, pacer_.SetStatus(true, 0.5f));
+  EXPECT_TRUE(pacer_.Enabled());
+}
+
+TEST_F(RtpPacerTest, QueuesUntilDrainedAfterTurningPacingOff) {
+  InsertPacket(1, RTPPacer::kNormalPriority);
+  EXPECT_EQ(0, pacer_.SetStatus(false, 1.0f));
+  // A new packet must not overtake the queued one.
+  EXPECT_TRUE(pacer_.QueuePackets());
+  InsertPacket(2, RTPPacer::kNormalPriority);
+  EXPECT_EQ(1, NextPacket());
+  EXPECT_EQ(2, NextPacket());
+  EXPECT_FALSE(pacer_.QueuePackets());
+}
+
+TEST_F(RtpPacerTest, DropsPacketsWhenTheQueueIsFull) {
+  int queued = 0;
+  while (pacer_.InsertPacket(packet_, kPacketLength, kHeaderLength,
+                             RTPPacer::kNormalPriority) == 0) {
+    ++queued;
+    ASSERT_LT(queued, 10000);
+  }
+  EXPECT_EQ(-1, pacer_.InsertPacket(packet_, kPacketLength, kHeaderLength,
+                                    RTPPacer::kHighPriority));
+  RtpPacerStatistics stats;
+  pacer_.Statistics(&stats);
+  EXPECT_EQ(static_cast<WebRtc_UWord32>(queued), stats.queuedPackets);
+  EXPECT_EQ(2u, stats.droppedPackets);
+}
+
+namespace {
+class CountingTransport : public Transport {
+ public:
+  CountingTransport() : rtp_packets_(0) {}
+  virtual int SendPacket(int /*channel*/, const void* /*data*/, int len) {
+    ++rtp_packets_;
+    return len;
+  }
+  virtual int SendRTCPPacket(int /*channel*/, const void* /*data*/,
+                             int len) {
+    return len;
+  }
+  int rtp_packets_;
+};
+}  // namespace
+
+TEST(RtpPacingTest, ChildModuleInheritsPacingStatus) {
+  FakeRtpRtcpClock clock;
+  CountingTransport transport;
+  ModuleRtpRtcpImpl default_module(0, true, &clock);
+  ModuleRtpRtcpImpl child(1, true, &clock);
+  EXPECT_EQ(0, default_module.SetPacingStatus(true, 2.0f));
+
+  CodecInst codec = { 0, "PCMU", 8000, 160, 1, 64000 };
+  EXPECT_EQ(0, child.RegisterSendPayload(codec));
+  EXPECT_EQ(0, child.RegisterSendTransport(&transport));
+  EXPECT_EQ(0, child.SetSendingStatus(true));
+  EXPECT_EQ(0, child.RegisterDefaultModule(&default_module));
+
+  WebRtc_UWord8 payload[160];
+  memset(payload, 0, sizeof(payload));
+  EXPECT_EQ(0, child.SendOutgoingData(kAudioFrameSpeech, 0, 160, payload,
+                                      sizeof(payload)));
+  // Queued rather than sent right away.
+  EXPECT_EQ(0, transport.rtp_packets_);
+  RtpPacerStatistics stats;
+  EXPECT_EQ(0, default_module.PacingStatistics(&stats));
+  EXPECT_EQ(1u, stats.queuedPackets);
+  child.Process();
+  EXPECT_EQ(1, transport.rtp_packets_);
+  EXPECT_EQ(0, child.DeRegisterDefaultModule());
+}
+
+TEST(RtpPacingTest, SimulcastChildIsPacedAtStreamBitrateAfterRemb) {
+  FakeRtpRtcpClock clock;
+  CountingTransport transport;
+  ModuleRtpRtcpImpl default_module(0, false, &clock);
+  ModuleRtpRtcpImpl child(1, false, &clock);
+
+  VideoCodec codec;
+  memset(&codec, 0, sizeof(codec));
+  strncpy(codec.plName, "I420", sizeof(codec.plName));
+  codec.plType = 124;
+  EXPECT_EQ(0, child.RegisterSendPayload(codec));
+  EXPECT_EQ(0, child.RegisterSendTransport(&transport));
+  EXPECT_EQ(0, child.SetSendingStatus(true));
+  EXPECT_EQ(0, child.RegisterDefaultModule(&default_module));
+
+  codec.numberOfSimulcastStreams = 2;
+  codec.simulcastStream[0].maxBitrate = kTargetBitrateKbit;
+  EXPECT_EQ(0, default_module.RegisterSendPayload(codec));
+  EXPECT_EQ(0, default_module.SetSendBitrate(2000000, 0, 0));
+  EXPECT_EQ(0, default_module.SetPacingStatus(true, 1.0f));
+  // Leaves the child its full stream bitrate.
+  default_module.OnReceivedEstimatedMaxBitrate(1000000);
+
+  // 10000 bytes take 100 ms at the stream bitrate.
+  WebRtc_UWord8 payload[10000];
+  memset(payload, 0, sizeof(payload));
+  EXPECT_EQ(0, child.SendOutgoingData(kVideoFrameKey, codec.plType, 0,
+                                      payload, sizeof(payload)));
+  RtpPacerStatistics stats;
+  EXPECT_EQ(0, child.PacingStatistics(&stats));
+  const int total_packets = transport.rtp_packets_ + stats.queuedPackets;
+  EXPECT_GT(stats.queuedPackets, 0u);
+
+  for (int ms = 0; ms < 50; ms += RTPPacer::kProcessIntervalMs) {
+    clock.AdvanceTimeMs(RTPPacer::kProcessIntervalMs);
+    child.Process();
+  }
+  EXPECT_LT(transport.rtp_packets_, total_packets);
+  for (int ms = 0; ms < 100; ms += RTPPacer::kProcessIntervalMs) {
+    clock.AdvanceTimeMs(RTPPacer::kProcessIntervalMs);
+    child.Process();
+  }
+  EXPECT_EQ(total_packets, transport.rtp_packets_);
+  EXPECT_EQ(0, child.DeRegisterDefaultModule());
+}
+
+}  // namespace webrtc
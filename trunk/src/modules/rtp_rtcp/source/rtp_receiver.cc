@@ -48,7 +48,8 @@ RTPReceiver::RTPReceiver(const WebRtc_Word32 id,
 
     _redPayloadType(-1),
     _payloadTypeMap(),
-    _rtpHeaderExtensionMap(),
+    _rtpHeaderExtensionMaps(),
+    _rtpHeaderExtensionMapVersion(0),
     _SSRC(0),
     _numCSRCs(0),
     _currentRemoteCSRC(),
@@ -181,7 +182,7 @@ RTPReceiver::Init()
     _lastReportJitter = 0;
     _lastReportJitterTransmissionTimeOffset = 0;
 
-    _rtpHeaderExtensionMap.Erase();
+    PublishHeaderExtensionMap(RtpHeaderExtensionMap());
 
     // clear db
     bool loop = true;
@@ -697,20 +698,58 @@ RTPReceiver::RegisterRtpHeaderExtension(const RTPExtensionType type,
                                         const WebRtc_UWord8 id)
 {
     CriticalSectionScoped cs(_criticalSectionRTPReceiver);
-    return _rtpHeaderExtensionMap.Register(type, id);
+    RtpHeaderExtensionMap map(_rtpHeaderExtensionMaps[
+        (_rtpHeaderExtensionMapVersion.Value() >> 1) & 1]);
+    if (map.Register(type, id) != 0)
+    {
+        return -1;
+    }
+    PublishHeaderExtensionMap(map);
+    return 0;
 }
 
 WebRtc_Word32
 RTPReceiver::DeregisterRtpHeaderExtension(const RTPExtensionType type)
 {
     CriticalSectionScoped cs(_criticalSectionRTPReceiver);
-    return _rtpHeaderExtensionMap.Deregister(type);
+    RtpHeaderExtensionMap map(_rtpHeaderExtensionMaps[
+        (_rtpHeaderExtensionMapVersion.Value() >> 1) & 1]);
+    if (map.Deregister(type) != 0)
+    {
+        return -1;
+    }
+    PublishHeaderExtensionMap(map);
+    return 0;
 }
 
-void RTPReceiver::GetHeaderExtensionMapCopy(RtpHeaderExtensionMap* map) const
+void RTPReceiver::PublishHeaderExtensionMap(const RtpHeaderExtensionMap& map)
 {
-    CriticalSectionScoped cs(_criticalSectionRTPReceiver);
-    _rtpHeaderExtensionMap.GetCopy(map);
+    // The odd version tells readers which started on the map that is about
+    // to be written to parse again.
+    const WebRtc_Word32 version = ++_rtpHeaderExtensionMapVersion;
+    _rtpHeaderExtensionMaps[((version >> 1) + 1) & 1] = map;
+    ++_rtpHeaderExtensionMapVersion;
+}
+
+bool
+RTPReceiver::ParseRTPHeader(const ModuleRTPUtility::RTPHeaderParser& rtpParser,
+                            WebRtcRTPHeader* rtpHeader) const
+{
+    for (;;)
+    {
+        // Value() is a plain load. Adding zero orders the parse between the
+        // two version loads, as the increments of the writer order its copy.
+        const WebRtc_UWord32 version = (_rtpHeaderExtensionMapVersion += 0);
+        const bool valid = rtpParser.Parse(
+            *rtpHeader, &_rtpHeaderExtensionMaps[(version >> 1) & 1]);
+        // The map read is only written to by the second update after the one
+        // that published it.
+        const WebRtc_UWord32 newVersion = (_rtpHeaderExtensionMapVersion += 0);
+        if (newVersion - (version & ~1u) < 3)
+        {
+            return valid;
+        }
+    }
 }
 
 NACKMethod
@@ -12,6 +12,7 @@
 #define WEBRTC_MODULES_RTP_RTCP_SOURCE_RTP_RECEIVER_H_
 
 #include "typedefs.h"
+#include "atomic32_wrapper.h"
 #include "rtp_utility.h"
 
 #include "rtp_header_extension.h"
@@ -143,7 +144,11 @@ public:
 
     WebRtc_Word32 DeregisterRtpHeaderExtension(const RTPExtensionType type);
 
-    void GetHeaderExtensionMapCopy(RtpHeaderExtensionMap* map) const;
+    // Parses the header of the packet in |rtpParser| with the registered
+    // header extensions. Doesn't lock or copy the extension map, so that it
+    // can be called for every received packet.
+    bool ParseRTPHeader(const ModuleRTPUtility::RTPHeaderParser& rtpParser,
+                        WebRtcRTPHeader* rtpHeader) const;
 
     virtual WebRtc_UWord32 PayloadTypeToPayload(const WebRtc_UWord8 payloadType,
                                                 ModuleRTPUtility::Payload*& payload) const;
@@ -177,6 +182,10 @@ private:
                                       ModuleRTPUtility::AudioPayload& audioSpecific,
                                       ModuleRTPUtility::VideoPayload& videoSpecific);
 
+    // Publishes |map| as the header extension map used by ParseRTPHeader().
+    // Called with _criticalSectionRTPReceiver held.
+    void PublishHeaderExtensionMap(const RtpHeaderExtensionMap& map);
+
     void UpdateNACKBitRate(WebRtc_Word32 bytes, WebRtc_UWord32 now);
     bool ProcessNACKBitRate(WebRtc_UWord32 now);
 
@@ -204,7 +213,13 @@ private:
 
     //
     MapWrapper                _payloadTypeMap;
-    RtpHeaderExtensionMap     _rtpHeaderExtensionMap;
+    // The published header extension map is
+    // _rtpHeaderExtensionMaps[(_rtpHeaderExtensionMapVersion / 2) % 2]. An
+    // update writes the other one while the version is odd. The published
+    // map is immutable until the next update. Readers load the version with
+    // an atomic add of zero, which is also a full memory barrier.
+    RtpHeaderExtensionMap     _rtpHeaderExtensionMaps[2];
+    mutable Atomic32Wrapper   _rtpHeaderExtensionMapVersion;
 
     // SSRCs
     WebRtc_UWord32            _SSRC;
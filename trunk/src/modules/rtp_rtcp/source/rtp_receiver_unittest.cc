@@ -0,0 +1,153 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/*
+ * This file includes unit tests for the RTP receive path with header
+ * extensions. test/testReceivePath benchmarks it.
+ */
+
+#include <gtest/gtest.h>
+
+#include <string.h>
+
+#include "common_types.h"
+#include "rtp_header_extension.h"
+#include "rtp_rtcp_impl.h"
+#include "rtp_utility.h"
+
+namespace {
+
+using namespace webrtc;
+
+class FakeRtpRtcpClock : public RtpRtcpClock {
+ public:
+  FakeRtpRtcpClock() : time_ms_(1000) {}
+  virtual WebRtc_UWord32 GetTimeInMS() { return time_ms_; }
+  virtual void CurrentNTP(WebRtc_UWord32& secs, WebRtc_UWord32& frac) {
+    secs = time_ms_ / 1000;
+    frac = 0;
+  }
+  void AdvanceTimeMs(WebRtc_UWord32 ms) { time_ms_ += ms; }
+ private:
+  WebRtc_UWord32 time_ms_;
+};
+
+class ReceivedHeader : public RtpData {
+ public:
+  ReceivedHeader() : num_packets_(0) {
+    memset(&header_, 0, sizeof(header_));
+  }
+  virtual WebRtc_Word32 OnReceivedPayloadData(
+      const WebRtc_UWord8* payloadData,
+      const WebRtc_UWord16 payloadSize,
+      const WebRtcRTPHeader* rtpHeader) {
+    header_ = *rtpHeader;
+    ++num_packets_;
+    return 0;
+  }
+  WebRtcRTPHeader header_;
+  int num_packets_;
+};
+
+class RtpReceiverTest : public ::testing::Test {
+ protected:
+  enum { kPayloadType = 0 };
+  enum { kPayloadLength = 160 };
+  enum { kExtensionId = 3 };
+  enum { kTimeOffset = 0x123456 };
+
+  RtpReceiverTest()
+      : rtp_rtcp_impl_(new ModuleRtpRtcpImpl(0, true, &clock_)),
+        sequence_number_(0),
+        packet_length_(0) {
+    CodecInst codec = { kPayloadType, "PCMU", 8000, 160, 1, 64000 };
+    EXPECT_EQ(0, rtp_rtcp_impl_->RegisterReceivePayload(codec));
+    EXPECT_EQ(0, rtp_rtcp_impl_->RegisterIncomingDataCallback(&received_));
+  }
+
+  ~RtpReceiverTest() {
+    delete rtp_rtcp_impl_;
+  }
+
+  // Builds the next packet, with a transmission time offset extension.
+  void BuildPacket() {
+    WebRtc_UWord8* ptr = packet_;
+    *ptr++ = 0x90;  // Version 2, extension.
+    *ptr++ = kPayloadType;
+    ModuleRTPUtility::AssignUWord16ToBuffer(ptr, sequence_number_);
+    ModuleRTPUtility::AssignUWord32ToBuffer(ptr + 2, sequence_number_ * 160);
+    ModuleRTPUtility::AssignUWord32ToBuffer(ptr + 6, 0x11223344);
+    ptr += 10;
+    ModuleRTPUtility::AssignUWord16ToBuffer(ptr,
+                                            RTP_ONE_BYTE_HEADER_EXTENSION);
+    ModuleRTPUtility::AssignUWord16ToBuffer(ptr + 2, 1);
+    ptr += 4;
+    *ptr++ = (kExtensionId << 4) + 2;
+    *ptr++ = kTimeOffset >> 16;
+    *ptr++ = (kTimeOffset >> 8) & 0xff;
+    *ptr++ = kTimeOffset & 0xff;
+    memset(ptr, 0xff, kPayloadLength);
+    ptr += kPayloadLength;
+    packet_length_ = static_cast<WebRtc_UWord16>(ptr - packet_);
+    ++sequence_number_;
+  }
+
+  WebRtc_Word32 InjectPacket() {
+    BuildPacket();
+    clock_.AdvanceTimeMs(20);
+    return rtp_rtcp_impl_->IncomingPacket(packet_, packet_length_);
+  }
+
+  FakeRtpRtcpClock clock_;
+  ReceivedHeader received_;
+  ModuleRtpRtcpImpl* rtp_rtcp_impl_;
+  WebRtc_UWord16 sequence_number_;
+  WebRtc_UWord8 packet_[IP_PACKET_SIZE];
+  WebRtc_UWord16 packet_length_;
+};
+
+TEST_F(RtpReceiverTest, ParsesRegisteredExtension) {
+  EXPECT_EQ(0, InjectPacket());
+  EXPECT_EQ(1, received_.num_packets_);
+  EXPECT_EQ(0, received_.header_.extension.transmissionTimeOffset);
+  EXPECT_EQ(20, received_.header_.header.headerLength);
+
+  EXPECT_EQ(0, rtp_rtcp_impl_->RegisterReceiveRtpHeaderExtension(
+      TRANSMISSION_TIME_OFFSET, kExtensionId));
+  EXPECT_EQ(0, InjectPacket());
+  EXPECT_EQ(kTimeOffset, received_.header_.extension.transmissionTimeOffset);
+
+  // A failed registration leaves the extension in place.
+  EXPECT_EQ(-1, rtp_rtcp_impl_->RegisterReceiveRtpHeaderExtension(
+      TRANSMISSION_TIME_OFFSET, kExtensionId));
+  EXPECT_EQ(0, InjectPacket());
+  EXPECT_EQ(kTimeOffset, received_.header_.extension.transmissionTimeOffset);
+
+  EXPECT_EQ(0, rtp_rtcp_impl_->DeregisterReceiveRtpHeaderExtension(
+      TRANSMISSION_TIME_OFFSET));
+  EXPECT_EQ(-1, rtp_rtcp_impl_->DeregisterReceiveRtpHeaderExtension(
+      TRANSMISSION_TIME_OFFSET));
+  EXPECT_EQ(0, InjectPacket());
+  EXPECT_EQ(0, received_.header_.extension.transmissionTimeOffset);
+  EXPECT_EQ(4, received_.num_packets_);
+}
+
+TEST_F(RtpReceiverTest, InitReceiverClearsExtensions) {
+  EXPECT_EQ(0, rtp_rtcp_impl_->RegisterReceiveRtpHeaderExtension(
+      TRANSMISSION_TIME_OFFSET, kExtensionId));
+  EXPECT_EQ(0, rtp_rtcp_impl_->InitReceiver());
+  CodecInst codec = { kPayloadType, "PCMU", 8000, 160, 1, 64000 };
+  EXPECT_EQ(0, rtp_rtcp_impl_->RegisterReceivePayload(codec));
+  EXPECT_EQ(0, rtp_rtcp_impl_->RegisterIncomingDataCallback(&received_));
+  EXPECT_EQ(0, InjectPacket());
+  EXPECT_EQ(0, received_.header_.extension.transmissionTimeOffset);
+}
+
+} // namespace
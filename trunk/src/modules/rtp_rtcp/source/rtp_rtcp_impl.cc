@@ -62,6 +62,19 @@ RtpRtcp::CreateRtpRtcp(const WebRtc_Word32 id,
     return new ModuleRtpRtcpImpl(id, audio, clock);
 }
 
+RtpRtcp*
+RtpRtcp::CreateRtpRtcp(const WebRtc_Word32 id,
+                       const bool audio,
+                       Clock* clock)
+{
+    ModuleRTPUtility::ClockAdapter* adapter =
+        new ModuleRTPUtility::ClockAdapter(clock);
+    ModuleRtpRtcpImpl* module = static_cast<ModuleRtpRtcpImpl*>(
+        CreateRtpRtcp(id, audio, adapter));
+    module->OwnClock(adapter);
+    return module;
+}
+
 void RtpRtcp::DestroyRtpRtcp(RtpRtcp* module)
 {
     if(module)
@@ -95,6 +108,8 @@ ModuleRtpRtcpImpl::ModuleRtpRtcpImpl(const WebRtc_Word32 id,
     _defaultModule(NULL),
     _audioModule(NULL),
     _videoModule(NULL),
+    _rtcpAggregation(false),
+    _rtcpSentByDefaultModule(false),
     _deadOrAliveActive(false),
     _deadOrAliveTimeoutMS(0),
     _deadOrAliveLastTimer(0),
@@ -120,6 +135,12 @@ ModuleRtpRtcpImpl::ModuleRtpRtcpImpl(const WebRtc_Word32 id,
     WEBRTC_TRACE(kTraceMemory, kTraceRtpRtcp, id, "%s created", __FUNCTION__);
 }
 
+void ModuleRtpRtcpImpl::OwnClock(ModuleRTPUtility::ClockAdapter* clock)
+{
+    assert(clock == &_clock);
+    _ownedClock.reset(clock);
+}
+
 ModuleRtpRtcpImpl::~ModuleRtpRtcpImpl()
 {
     WEBRTC_TRACE(kTraceMemory, kTraceRtpRtcp, _id, "%s deleted", __FUNCTION__);
@@ -270,6 +291,7 @@ ModuleRtpRtcpImpl::DeRegisterDefaultModule()
         _defaultModule->DeRegisterChildModule(this);
         _defaultModule = NULL;
     }
+    _rtcpSentByDefaultModule = false;
     return 0;
 }
 
@@ -319,6 +341,14 @@ ModuleRtpRtcpImpl::RegisterChildModule(RtpRtcp* module)
     // messages (BitrateSent and UpdateTMMBR) and _criticalSectionModulePtrs
    //  for all outgoing messages sending packets etc
     _childModules.push_back((ModuleRtpRtcpImpl*)module);
+    ((ModuleRtpRtcpImpl*)module)->_rtcpSentByDefaultModule = _rtcpAggregation;
+
+    // the child sends packets of this module, pace them the same way
+    bool pacingEnabled = false;
+    float bitrateMultiplier = 1.0f;
+    _rtpSender.PacingStatus(&pacingEnabled, &bitrateMultiplier);
+    ((ModuleRtpRtcpImpl*)module)->_rtpSender.SetPacingStatus(
+        pacingEnabled, bitrateMultiplier);
 }
 
 void ModuleRtpRtcpImpl::DeRegisterChildModule(RtpRtcp* removeModule)
@@ -431,7 +461,17 @@ void ModuleRtpRtcpImpl::DeRegisterVideoModule()
 WebRtc_Word32 ModuleRtpRtcpImpl::TimeUntilNextProcess()
 {
     const WebRtc_UWord32 now = _clock.GetTimeInMS();
-    return kRtpRtcpMaxIdleTimeProcess - (now -_lastProcessTime);
+    const WebRtc_Word32 timeUntilProcess =
+        kRtpRtcpMaxIdleTimeProcess - (now -_lastProcessTime);
+
+    // paced packets are released on the process thread
+    const WebRtc_Word32 timeUntilPacing =
+        _rtpSender.TimeUntilNextPacedPacket();
+    if (timeUntilPacing >= 0 && timeUntilPacing < timeUntilProcess)
+    {
+        return timeUntilPacing;
+    }
+    return timeUntilProcess;
 }
 
 // Process any pending tasks such as timeouts
@@ -440,6 +480,8 @@ WebRtc_Word32 ModuleRtpRtcpImpl::Process()
 {
     _lastProcessTime = _clock.GetTimeInMS();
 
+    _rtpSender.ProcessPacing();
+
     _rtpReceiver.PacketTimeout();
     _rtcpReceiver.PacketTimeout();
 
@@ -449,7 +491,12 @@ WebRtc_Word32 ModuleRtpRtcpImpl::Process()
     ProcessDeadOrAliveTimer();
 
     const bool defaultInstance(_childModules.empty() ? false : true);
-    if(!defaultInstance &&_rtcpSender.TimeToSendRTCPReport())
+    if(defaultInstance && _rtcpAggregation)
+    {
+        ProcessAggregatedRTCP();
+    }
+    else if(!defaultInstance && !_rtcpSentByDefaultModule &&
+            _rtcpSender.TimeToSendRTCPReport())
     {
         WebRtc_UWord16 RTT = 0;
         _rtcpReceiver.RTT(_rtpReceiver.SSRC(), &RTT, NULL, NULL, NULL);
@@ -790,10 +837,8 @@ ModuleRtpRtcpImpl::IncomingPacket(const WebRtc_UWord8* incomingPacket,
         WebRtcRTPHeader rtpHeader;
         memset(&rtpHeader, 0, sizeof(rtpHeader));
 
-        RtpHeaderExtensionMap map;
-        _rtpReceiver.GetHeaderExtensionMapCopy(&map);
-
-        const bool validRTPHeader = rtpParser.Parse(rtpHeader, &map);
+        const bool validRTPHeader =
+            _rtpReceiver.ParseRTPHeader(rtpParser, &rtpHeader);
         if(!validRTPHeader)
         {
             WEBRTC_TRACE(kTraceDebug,
@@ -1288,7 +1333,8 @@ ModuleRtpRtcpImpl::SendOutgoingData(const FrameType frameType,
     if(!haveChildModules)
     {
         // Don't sent RTCP from default module
-        if(_rtcpSender.TimeToSendRTCPReport(kVideoFrameKey == frameType))
+        if(!_rtcpSentByDefaultModule &&
+           _rtcpSender.TimeToSendRTCPReport(kVideoFrameKey == frameType))
         {
             WebRtc_UWord16 RTT = 0;
             _rtcpReceiver.RTT(_rtpReceiver.SSRC(), &RTT, NULL, NULL, NULL);
@@ -1639,6 +1685,139 @@ ModuleRtpRtcpImpl::SendRTCP(WebRtc_UWord32 rtcpPacketType)
     return  _rtcpSender.SendRTCP(rtcpPacketType);
 }
 
+WebRtc_Word32
+ModuleRtpRtcpImpl::SetRTCPAggregationStatus(const bool enable)
+{
+    WEBRTC_TRACE(kTraceModuleCall, kTraceRtpRtcp, _id,
+                 "SetRTCPAggregationStatus(%d)", enable);
+
+    CriticalSectionScoped lock(_criticalSectionModulePtrs);
+    if(_defaultModule)
+    {
+        WEBRTC_TRACE(kTraceError, kTraceRtpRtcp, _id,
+                     "%s only allowed on a default module", __FUNCTION__);
+        return -1;
+    }
+    _rtcpAggregation = enable;
+
+    std::list<ModuleRtpRtcpImpl*>::iterator it = _childModules.begin();
+    while (it != _childModules.end())
+    {
+        (*it)->_rtcpSentByDefaultModule = enable;
+        it++;
+    }
+    return 0;
+}
+
+bool
+ModuleRtpRtcpImpl::RTCPAggregation() const
+{
+    WEBRTC_TRACE(kTraceModuleCall, kTraceRtpRtcp, _id, "RTCPAggregation()");
+
+    return _rtcpAggregation;
+}
+
+// Builds the periodic report of a child module, see Process().
+WebRtc_Word32
+ModuleRtpRtcpImpl::BuildRTCPReport(WebRtc_UWord8* rtcpbuffer,
+                                   WebRtc_UWord32& length)
+{
+    WebRtc_UWord16 RTT = 0;
+    _rtcpReceiver.RTT(_rtpReceiver.SSRC(), &RTT, NULL, NULL, NULL);
+    if (TMMBR())
+    {
+        _rtcpSender.CalculateNewTargetBitrate(RTT);
+    }
+    length = 0;
+    return _rtcpSender.BuildRTCP(rtcpbuffer, length, kRtcpReport, 0, 0, RTT);
+}
+
+// Aggregates the reports of the child modules that share a transport, i.e.
+// that send to the same remote peer, such as the simulcast streams of one
+// channel. The default module itself may have no transport.
+void
+ModuleRtpRtcpImpl::ProcessAggregatedRTCP()
+{
+    CriticalSectionScoped lock(_criticalSectionModulePtrs);
+
+    std::list<ModuleRtpRtcpImpl*> pending(_childModules);
+    while (!pending.empty())
+    {
+        Transport* transport = pending.front()->_rtcpSender.SendTransport();
+        std::list<ModuleRtpRtcpImpl*> sameTransport;
+        std::list<ModuleRtpRtcpImpl*>::iterator it = pending.begin();
+        while (it != pending.end())
+        {
+            if ((*it)->_rtcpSender.SendTransport() == transport)
+            {
+                sameTransport.push_back(*it);
+                it = pending.erase(it);
+            } else
+            {
+                it++;
+            }
+        }
+        if (transport != NULL)
+        {
+            SendAggregatedRTCP(sameTransport);
+        }
+    }
+}
+
+// Sends the reports of |modules| in as few compound packets as the MTU
+// allows, on the transport of the first module. The reports are sent
+// together as soon as one module is due; its interval is the shortest.
+void
+ModuleRtpRtcpImpl::SendAggregatedRTCP(
+    const std::list<ModuleRtpRtcpImpl*>& modules)
+{
+    bool timeToSend = false;
+    std::list<ModuleRtpRtcpImpl*>::const_iterator it = modules.begin();
+    while (it != modules.end() && !timeToSend)
+    {
+        timeToSend = (*it)->_rtcpSender.TimeToSendRTCPReport();
+        it++;
+    }
+    if(!timeToSend)
+    {
+        return;
+    }
+
+    ModuleRtpRtcpImpl* sender = modules.front();
+    const WebRtc_UWord16 maxLength = sender->_rtpSender.MaxPayloadLength();
+    WebRtc_UWord8 packet[IP_PACKET_SIZE];
+    WebRtc_UWord16 length = 0;
+
+    for (it = modules.begin(); it != modules.end(); it++)
+    {
+        WebRtc_UWord8 report[IP_PACKET_SIZE];
+        WebRtc_UWord32 reportLength = 0;
+        if ((*it)->BuildRTCPReport(report, reportLength) != 0 ||
+            reportLength == 0)
+        {
+            continue;  // RTCP is off for this child module
+        }
+        if (length > 0 && length + reportLength > maxLength)
+        {
+            // a compound packet may hold any number of reports, but each
+            // report must be complete; continue in a new packet
+            if (sender->_rtcpSender.SendToNetwork(packet, length) != 0)
+            {
+                WEBRTC_TRACE(kTraceWarning, kTraceRtpRtcp, _id,
+                             "%s failed to send RTCP", __FUNCTION__);
+            }
+            length = 0;
+        }
+        memcpy(packet + length, report, reportLength);
+        length += (WebRtc_UWord16)reportLength;
+    }
+    if (length > 0 && sender->_rtcpSender.SendToNetwork(packet, length) != 0)
+    {
+        WEBRTC_TRACE(kTraceWarning, kTraceRtpRtcp, _id,
+                     "%s failed to send RTCP", __FUNCTION__);
+    }
+}
+
 WebRtc_Word32
 ModuleRtpRtcpImpl::SetRTCPApplicationSpecificData(const WebRtc_UWord8 subType,
                                                   const WebRtc_UWord32 name,
@@ -2466,6 +2645,65 @@ void ModuleRtpRtcpImpl::BitrateSent(WebRtc_UWord32* totalRate,
         *nackRate = _rtpSender.NackOverheadRate();
 }
 
+WebRtc_Word32 ModuleRtpRtcpImpl::SetPacingStatus(
+    const bool enable,
+    const float bitrateMultiplier) {
+    WEBRTC_TRACE(kTraceModuleCall, kTraceRtpRtcp, _id,
+                 "SetPacingStatus(enable:%d bitrateMultiplier:%f)",
+                 enable, bitrateMultiplier);
+
+    if (_rtpSender.SetPacingStatus(enable, bitrateMultiplier) != 0) {
+        return -1;
+    }
+    // the child modules send the packets of the default module
+    CriticalSectionScoped lock(_criticalSectionModulePtrs);
+    std::list<ModuleRtpRtcpImpl*>::iterator it = _childModules.begin();
+    while (it != _childModules.end()) {
+        RtpRtcp* module = *it;
+        if (module) {
+            module->SetPacingStatus(enable, bitrateMultiplier);
+        }
+        it++;
+    }
+    return 0;
+}
+
+WebRtc_Word32 ModuleRtpRtcpImpl::PacingStatistics(
+    RtpPacerStatistics* statistics) const {
+    if (statistics == NULL) {
+        return -1;
+    }
+    _rtpSender.PacingStatistics(statistics);
+
+    // the default module adds up the queues of its child modules
+    CriticalSectionScoped lock(_criticalSectionModulePtrs);
+    WebRtc_UWord64 totalQueueDelayMs = static_cast<WebRtc_UWord64>(
+        statistics->averageQueueDelayMs) * statistics->sentPackets;
+    std::list<ModuleRtpRtcpImpl*>::const_iterator it = _childModules.begin();
+    while (it != _childModules.end()) {
+        RtpRtcp* module = *it;
+        RtpPacerStatistics child;
+        if (module && module->PacingStatistics(&child) == 0) {
+            statistics->queuedPackets += child.queuedPackets;
+            statistics->queuedBytes += child.queuedBytes;
+            statistics->sentPackets += child.sentPackets;
+            statistics->droppedPackets += child.droppedPackets;
+            totalQueueDelayMs += static_cast<WebRtc_UWord64>(
+                child.averageQueueDelayMs) * child.sentPackets;
+            if (child.oldestQueueDelayMs > statistics->oldestQueueDelayMs)
+                statistics->oldestQueueDelayMs = child.oldestQueueDelayMs;
+            if (child.maxQueueDelayMs > statistics->maxQueueDelayMs)
+                statistics->maxQueueDelayMs = child.maxQueueDelayMs;
+        }
+        it++;
+    }
+    if (statistics->sentPackets > 0) {
+        statistics->averageQueueDelayMs = static_cast<WebRtc_UWord32>(
+            totalQueueDelayMs / statistics->sentPackets);
+    }
+    return 0;
+}
+
 // for lip sync
 void ModuleRtpRtcpImpl::OnReceivedNTP() {
     // don't do anything if we are the audio module
@@ -2657,20 +2895,23 @@ void ModuleRtpRtcpImpl::OnReceivedEstimatedMaxBitrate(
                 return;
             }
             ModuleRtpRtcpImpl* module = *it;
+            // the stream max is in kbit/s, newBitrate in bit/s
+            const WebRtc_UWord32 streamMaxBitrate =
+                _sendVideoCodec.simulcastStream[idx].maxBitrate * 1000;
             // update all child modules
-            if (newBitrate >= _sendVideoCodec.simulcastStream[idx].maxBitrate) {
+            if (newBitrate >= streamMaxBitrate) {
                 module->_bandwidthManagement.SetSendBitrate(
-                    _sendVideoCodec.simulcastStream[idx].maxBitrate, 0, 0);
-                module->_rtpSender.SetTargetSendBitrate(
-                    _sendVideoCodec.simulcastStream[idx].maxBitrate);
+                    streamMaxBitrate, 0, 0);
+                module->_rtpSender.SetTargetSendBitrate(streamMaxBitrate);
 
-                newBitrate -= _sendVideoCodec.simulcastStream[idx].maxBitrate;
+                newBitrate -= streamMaxBitrate;
             } else {
                 module->_bandwidthManagement.SetSendBitrate(newBitrate, 0, 0);
                 module->_rtpSender.SetTargetSendBitrate(newBitrate);
                 newBitrate -= newBitrate;
             }
             idx++;
+            it++;
         }
     }
 }
@@ -2845,16 +3086,16 @@ void ModuleRtpRtcpImpl::OnPacketLossStatisticsUpdate(
                     return;
                 }
                 ModuleRtpRtcpImpl* module = *it;
+                // the stream max is in kbit/s, newBitrate in bit/s
+                const WebRtc_UWord32 streamMaxBitrate =
+                    _sendVideoCodec.simulcastStream[idx].maxBitrate * 1000;
                 // update all child modules
-                if (newBitrate >=
-                    _sendVideoCodec.simulcastStream[idx].maxBitrate) {
+                if (newBitrate >= streamMaxBitrate) {
                     module->_bandwidthManagement.SetSendBitrate(
-                        _sendVideoCodec.simulcastStream[idx].maxBitrate, 0, 0);
-                    module->_rtpSender.SetTargetSendBitrate(
-                        _sendVideoCodec.simulcastStream[idx].maxBitrate);
+                        streamMaxBitrate, 0, 0);
+                    module->_rtpSender.SetTargetSendBitrate(streamMaxBitrate);
 
-                    newBitrate -=
-                        _sendVideoCodec.simulcastStream[idx].maxBitrate;
+                    newBitrate -= streamMaxBitrate;
                 } else {
                     module->_bandwidthManagement.SetSendBitrate(newBitrate,
                                                                 0,
@@ -2863,6 +3104,7 @@ void ModuleRtpRtcpImpl::OnPacketLossStatisticsUpdate(
                     newBitrate -= newBitrate;
                 }
                 idx++;
+                it++;
             }
         }
     }
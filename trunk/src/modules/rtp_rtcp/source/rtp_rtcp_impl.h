@@ -19,6 +19,8 @@
 #include "rtp_receiver.h"
 #include "rtp_rtcp.h"
 #include "rtp_sender.h"
+#include "rtp_utility.h"
+#include "scoped_ptr.h"
 
 #ifdef MATLAB
 class MatlabPlot;
@@ -35,6 +37,9 @@ public:
 
     virtual ~ModuleRtpRtcpImpl();
 
+    // Takes ownership of |clock|, which the module was constructed with.
+    void OwnClock(ModuleRTPUtility::ClockAdapter* clock);
+
     // get Module ID
     WebRtc_Word32 Id()   {return _id;}
 
@@ -285,6 +290,11 @@ public:
     // normal SR and RR are triggered via the process function
     virtual WebRtc_Word32 SendRTCP(WebRtc_UWord32 rtcpPacketType = kRtcpReport);
 
+    // send the RTCP of all child modules from the default module
+    virtual WebRtc_Word32 SetRTCPAggregationStatus(const bool enable);
+
+    virtual bool RTCPAggregation() const;
+
     // statistics of our localy created statistics of the received RTP stream
     virtual WebRtc_Word32 StatisticsRTP(WebRtc_UWord8  *fraction_lost,
                                       WebRtc_UWord32 *cum_lost,
@@ -491,6 +501,12 @@ public:
                              WebRtc_UWord32* fecRate,
                              WebRtc_UWord32* nackRate) const;
 
+    virtual WebRtc_Word32 SetPacingStatus(const bool enable,
+                                          const float bitrateMultiplier);
+
+    virtual WebRtc_Word32 PacingStatistics(
+        RtpPacerStatistics* statistics) const;
+
     virtual void SetRemoteSSRC(const WebRtc_UWord32 SSRC);
     
     virtual WebRtc_UWord32 SendTimeOfSendReport(const WebRtc_UWord32 sendReport);
@@ -553,6 +569,9 @@ protected:
     // only for internal testing
     WebRtc_UWord32 LastSendReport(WebRtc_UWord32& lastRTCPTime);
 
+    // Declared first so that it outlives the members reading it.
+    scoped_ptr<ModuleRTPUtility::ClockAdapter> _ownedClock;
+
     RTPSender                 _rtpSender;
     RTPReceiver               _rtpReceiver;
 
@@ -563,6 +582,10 @@ protected:
 private:
     void SendKeyFrame();
     void ProcessDefaultModuleBandwidth(bool triggerOnNetworkChanged);
+    void ProcessAggregatedRTCP();
+    void SendAggregatedRTCP(const std::list<ModuleRtpRtcpImpl*>& modules);
+    WebRtc_Word32 BuildRTCPReport(WebRtc_UWord8* rtcpbuffer,
+                                  WebRtc_UWord32& length);
 
     WebRtc_Word32             _id;
     const bool                _audio;
@@ -577,6 +600,11 @@ private:
     ModuleRtpRtcpImpl*            _videoModule;
     std::list<ModuleRtpRtcpImpl*> _childModules;
 
+    // the default module sends the RTCP of its child modules
+    bool                          _rtcpAggregation;
+    // set on a child module whose RTCP is sent by the default module
+    bool                          _rtcpSentByDefaultModule;
+
     // Dead or alive
     bool                  _deadOrAliveActive;
     WebRtc_UWord32        _deadOrAliveTimeoutMS;
@@ -63,6 +63,8 @@ RTPSender::RTPSender(const WebRtc_Word32 id,
     _nackByteCount(),
     _nackBitrate(clock),
 
+    _pacer(clock),
+
     // statistics
     _packetsSent(0),
     _payloadBytesSent(0),
@@ -233,9 +235,47 @@ WebRtc_Word32
 RTPSender::SetTargetSendBitrate(const WebRtc_UWord32 bits)
 {
     _targetSendBitrate = (WebRtc_UWord16)(bits/1000);
+    _pacer.SetTargetBitrate(bits/1000);
     return 0;
 }
 
+WebRtc_Word32
+RTPSender::SetPacingStatus(const bool enable, const float bitrateMultiplier)
+{
+    return _pacer.SetStatus(enable, bitrateMultiplier);
+}
+
+void
+RTPSender::PacingStatus(bool* enable, float* bitrateMultiplier) const
+{
+    _pacer.Status(enable, bitrateMultiplier);
+}
+
+void
+RTPSender::PacingStatistics(RtpPacerStatistics* statistics) const
+{
+    _pacer.Statistics(statistics);
+}
+
+void
+RTPSender::ProcessPacing()
+{
+    WebRtc_UWord8 dataBuffer[IP_PACKET_SIZE];
+    WebRtc_UWord16 length = 0;
+    WebRtc_UWord16 rtpHeaderLength = 0;
+    RTPPacer::Priority priority = RTPPacer::kNormalPriority;
+    while(_pacer.NextPacket(dataBuffer, &length, &rtpHeaderLength, &priority))
+    {
+        SendPacketToTransport(dataBuffer, length, rtpHeaderLength);
+    }
+}
+
+WebRtc_Word32
+RTPSender::TimeUntilNextPacedPacket() const
+{
+    return _pacer.TimeUntilNextPacket();
+}
+
 WebRtc_UWord16
 RTPSender::TargetSendBitrateKbit() const
 {
@@ -909,22 +949,24 @@ RTPSender::ReSendToNetwork(WebRtc_UWord16 packetID,
         // copy to local buffer for callback
         memcpy(dataBuffer, _ptrPrevSentPackets[index], length);
     }
+    // A re-transmit is sent with its whole length counted as header; we on
+    // purpose don't add to _payloadBytesSent since it is not new payload data
+    if(_pacer.QueuePackets())
     {
-        CriticalSectionScoped lock(_transportCritsect);
-        if(_transport)
+        // queued in the priority lane, ahead of the paced media packets
+        if(_pacer.InsertPacket(dataBuffer, (WebRtc_UWord16)length,
+                               (WebRtc_UWord16)length,
+                               RTPPacer::kHighPriority) != 0)
         {
-            i = _transport->SendPacket(_id, dataBuffer, length);
+            WEBRTC_TRACE(kTraceWarning, kTraceRtpRtcp, _id,
+                         "Pacing queue full, re-transmit dropped");
+            return -1;
         }
-    }
-    if(i > 0)
+        i = length;
+    } else
     {
-        CriticalSectionScoped cs(_sendCritsect);
-
-        Bitrate::Update(i);
-
-        _packetsSent++;
-
-        // we on purpose don't add to _payloadBytesSent since this is a re-transmit and not new payload data
+        i = SendPacketToTransport(dataBuffer, (WebRtc_UWord16)length,
+                                  (WebRtc_UWord16)length);
     }
     if(_storeSentPackets && i > 0)
     {
@@ -1071,7 +1113,6 @@ RTPSender::SendToNetwork(const WebRtc_UWord8* buffer,
                          const WebRtc_UWord16 rtpLength,
                          const bool dontStore)
 {
-    WebRtc_Word32 retVal = -1;
     // sanity
     if(length + rtpLength > _maxPayloadLength)
     {
@@ -1107,12 +1148,40 @@ RTPSender::SendToNetwork(const WebRtc_UWord8* buffer,
             }
         }
     }
-    // Send packet
+    if(_pacer.QueuePackets())
+    {
+        // Audio shares the priority lane with re-transmits
+        const RTPPacer::Priority priority = _audioConfigured ?
+            RTPPacer::kHighPriority : RTPPacer::kNormalPriority;
+        if(_pacer.InsertPacket(buffer, length + rtpLength, rtpLength,
+                               priority) == 0)
+        {
+            return 0;
+        }
+        // the queue is full; sending the packet right away would overtake
+        // the queued ones, NACK can recover it instead
+        WEBRTC_TRACE(kTraceWarning, kTraceRtpRtcp, _id,
+                     "Pacing queue full, packet dropped");
+        return -1;
+    }
+    if(SendPacketToTransport(buffer, length + rtpLength, rtpLength) > 0)
+    {
+        return 0;
+    }
+    return -1;
+}
+
+WebRtc_Word32
+RTPSender::SendPacketToTransport(const WebRtc_UWord8* buffer,
+                                 const WebRtc_UWord16 length,
+                                 const WebRtc_UWord16 rtpHeaderLength)
+{
+    WebRtc_Word32 retVal = -1;
     {
         CriticalSectionScoped cs(_transportCritsect);
         if(_transport)
         {
-            retVal = _transport->SendPacket(_id, buffer, length + rtpLength);
+            retVal = _transport->SendPacket(_id, buffer, length);
         }
     }
     // success?
@@ -1124,13 +1193,12 @@ RTPSender::SendToNetwork(const WebRtc_UWord8* buffer,
 
         _packetsSent++;
 
-        if(retVal > rtpLength)
+        if(retVal > rtpHeaderLength)
         {
-            _payloadBytesSent += retVal-rtpLength;
+            _payloadBytesSent += retVal-rtpHeaderLength;
         }
-        return 0;
     }
-    return -1;
+    return retVal;
 }
 
 void
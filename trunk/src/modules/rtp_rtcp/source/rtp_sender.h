@@ -19,6 +19,7 @@
 #include "map_wrapper.h"
 #include "Bitrate.h"
 #include "rtp_header_extension.h"
+#include "rtp_pacer.h"
 #include "video_codec_information.h"
 
 #include <cassert>
@@ -82,6 +83,22 @@ public:
 
     WebRtc_Word32 SetTargetSendBitrate(const WebRtc_UWord32 bits);
 
+    /*
+    *    Pacing
+    */
+    WebRtc_Word32 SetPacingStatus(const bool enable,
+                                  const float bitrateMultiplier);
+    void PacingStatus(bool* enable, float* bitrateMultiplier) const;
+
+    void PacingStatistics(RtpPacerStatistics* statistics) const;
+
+    // Sends the queued packets that the pacing budget allows.
+    void ProcessPacing();
+
+    // Returns the time in ms until ProcessPacing() should be called, or -1 if
+    // no packets are queued.
+    WebRtc_Word32 TimeUntilNextPacedPacket() const;
+
     WebRtc_UWord16 MaxDataPayloadLength() const; // with RTP and FEC headers
 
     // callback
@@ -281,6 +298,12 @@ public:
 protected:
     WebRtc_Word32 CheckPayloadType(const WebRtc_Word8 payloadType, RtpVideoCodecTypes& videoType);
 
+    // Hands a packet to the transport and updates the send statistics. The
+    // bytes after |rtpHeaderLength| are counted as payload.
+    WebRtc_Word32 SendPacketToTransport(const WebRtc_UWord8* buffer,
+                                        const WebRtc_UWord16 length,
+                                        const WebRtc_UWord16 rtpHeaderLength);
+
 private:
     WebRtc_Word32             _id;
     const bool              _audioConfigured;
@@ -323,6 +346,8 @@ private:
     WebRtc_Word32             _nackByteCount[NACK_BYTECOUNT_SIZE];
     Bitrate                   _nackBitrate;
 
+    RTPPacer                  _pacer;
+
     // statistics
     WebRtc_UWord32            _packetsSent;
     WebRtc_UWord32            _payloadBytesSent;
@@ -14,6 +14,7 @@
 #include <cmath>   // ceil
 #include <cassert>
 
+#include "clock.h"
 #include "trace.h"
 
 #if defined(_WIN32)
@@ -261,6 +262,16 @@ RtpRtcpClock* GetSystemClock()
     return &system_clock;
 }
 
+WebRtc_UWord32 ClockAdapter::GetTimeInMS()
+{
+    return static_cast<WebRtc_UWord32>(_clock.TimeInMilliseconds());
+}
+
+void ClockAdapter::CurrentNTP(WebRtc_UWord32& secs, WebRtc_UWord32& frac)
+{
+    _clock.CurrentNtp(secs, frac);
+}
+
 WebRtc_UWord32 GetCurrentRTP(RtpRtcpClock* clock, WebRtc_UWord32 freq)
 {
     if (clock == NULL)
@@ -553,7 +564,8 @@ ModuleRTPUtility::RTPHeaderParser::RTCP() const
 
 bool
 ModuleRTPUtility::RTPHeaderParser::Parse(
-    WebRtcRTPHeader& parsedPacket, RtpHeaderExtensionMap* ptrExtensionMap) const
+    WebRtcRTPHeader& parsedPacket,
+    const RtpHeaderExtensionMap* ptrExtensionMap) const
 {
     const ptrdiff_t length = _ptrRTPDataEnd - _ptrRTPDataBegin;
 
@@ -19,6 +19,8 @@
 #include "rtp_rtcp_defines.h"
 
 namespace webrtc {
+class Clock;
+
 enum RtpVideoCodecTypes
 {
     kRtpNoVideo       = 0,
@@ -69,6 +71,21 @@ namespace ModuleRTPUtility
     // the same base.
     RtpRtcpClock* GetSystemClock();
 
+    // A clock reading the times of a Clock, which must outlive it.
+    class ClockAdapter : public RtpRtcpClock
+    {
+    public:
+        explicit ClockAdapter(Clock* clock) : _clock(*clock) {}
+        virtual ~ClockAdapter() {}
+
+        virtual WebRtc_UWord32 GetTimeInMS();
+
+        virtual void CurrentNTP(WebRtc_UWord32& secs, WebRtc_UWord32& frac);
+
+    private:
+        Clock& _clock;
+    };
+
     // Return the current RTP timestamp from the NTP timestamp
     // returned by the specified clock.
     WebRtc_UWord32 GetCurrentRTP(RtpRtcpClock* clock, WebRtc_UWord32 freq);
@@ -130,7 +147,7 @@ namespace ModuleRTPUtility
 
         bool RTCP() const;
         bool Parse(WebRtcRTPHeader& parsedPacket,
-                   RtpHeaderExtensionMap* ptrExtensionMap = NULL) const;
+                   const RtpHeaderExtensionMap* ptrExtensionMap = NULL) const;
 
     private:
         void ParseOneByteExtensionHeader(
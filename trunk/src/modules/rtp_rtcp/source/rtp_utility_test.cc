@@ -15,7 +15,9 @@
 
 #include "gtest/gtest.h"
 #include "modules/rtp_rtcp/source/rtp_format_vp8.h"
+#include "modules/rtp_rtcp/interface/rtp_rtcp.h"
 #include "modules/rtp_rtcp/source/rtp_utility.h"
+#include "system_wrappers/interface/clock.h"
 #include "typedefs.h"  // NOLINT(build/include)
 
 namespace webrtc {
@@ -285,4 +287,32 @@ TEST(ParseVP8Test, TestWithPacketizer) {
   EXPECT_EQ(send_bytes - 5, parsedPacket.info.VP8.dataLength);
 }
 
+TEST(ClockAdapterTest, ReadsSimulatedClock) {
+  SimulatedClock clock(1000000);
+  ModuleRTPUtility::ClockAdapter adapter(&clock);
+  EXPECT_EQ(1000u, adapter.GetTimeInMS());
+  clock.AdvanceTimeMs(20);
+  EXPECT_EQ(1020u, adapter.GetTimeInMS());
+
+  WebRtc_UWord32 secs = 0;
+  WebRtc_UWord32 frac = 0;
+  adapter.CurrentNTP(secs, frac);
+  EXPECT_EQ(ModuleRTPUtility::NTP_JAN_1970 + 1, secs);
+  EXPECT_EQ(8000u * 1 + 160u,
+            ModuleRTPUtility::GetCurrentRTP(&adapter, 8000) -
+            ModuleRTPUtility::NTP_JAN_1970 * 8000u);
+}
+
+TEST(ClockAdapterTest, ModuleRunsOnSimulatedClock) {
+  SimulatedClock clock(0);
+  RtpRtcp* module = RtpRtcp::CreateRtpRtcp(0, true, &clock);
+  ASSERT_TRUE(module != NULL);
+  EXPECT_EQ(kRtpRtcpMaxIdleTimeProcess, module->TimeUntilNextProcess());
+  clock.AdvanceTimeMs(4);
+  EXPECT_EQ(kRtpRtcpMaxIdleTimeProcess - 4, module->TimeUntilNextProcess());
+  EXPECT_EQ(0, module->Process());
+  EXPECT_EQ(kRtpRtcpMaxIdleTimeProcess, module->TimeUntilNextProcess());
+  RtpRtcp::DestroyRtpRtcp(module);
+}
+
 }  // namespace
@@ -0,0 +1,154 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/*
+ * Benchmark of the RTP receive path with a registered header extension.
+ * Reports the heap allocations and the time per received packet.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <new>
+
+#include "common_types.h"
+#include "rtp_header_extension.h"
+#include "rtp_rtcp_impl.h"
+#include "rtp_utility.h"
+#include "tick_util.h"
+
+// Counts the heap allocations of this tool.
+static int allocation_count = 0;
+
+void* operator new(size_t size) throw (std::bad_alloc) {
+  ++allocation_count;
+  void* memory = malloc(size > 0 ? size : 1);
+  if (memory == NULL) {
+    throw std::bad_alloc();
+  }
+  return memory;
+}
+
+void operator delete(void* memory) throw () {
+  free(memory);
+}
+
+namespace {
+
+using namespace webrtc;
+
+enum { kPayloadType = 0 };
+enum { kPayloadLength = 160 };
+enum { kExtensionId = 3 };
+enum { kTimeOffset = 0x123456 };
+const int kNumPackets = 20000;
+
+class FakeRtpRtcpClock : public RtpRtcpClock {
+ public:
+  FakeRtpRtcpClock() : time_ms_(1000) {}
+  virtual WebRtc_UWord32 GetTimeInMS() { return time_ms_; }
+  virtual void CurrentNTP(WebRtc_UWord32& secs, WebRtc_UWord32& frac) {
+    secs = time_ms_ / 1000;
+    frac = 0;
+  }
+  void AdvanceTimeMs(WebRtc_UWord32 ms) { time_ms_ += ms; }
+ private:
+  WebRtc_UWord32 time_ms_;
+};
+
+class ReceivedHeader : public RtpData {
+ public:
+  ReceivedHeader() : num_packets_(0), time_offset_(0) {}
+  virtual WebRtc_Word32 OnReceivedPayloadData(
+      const WebRtc_UWord8* payloadData,
+      const WebRtc_UWord16 payloadSize,
+      const WebRtcRTPHeader* rtpHeader) {
+    time_offset_ = rtpHeader->extension.transmissionTimeOffset;
+    ++num_packets_;
+    return 0;
+  }
+  int num_packets_;
+  WebRtc_Word32 time_offset_;
+};
+
+// Builds packet |sequence_number| with a transmission time offset extension
+// and returns its length.
+WebRtc_UWord16 BuildPacket(WebRtc_UWord16 sequence_number,
+                           WebRtc_UWord8* packet) {
+  WebRtc_UWord8* ptr = packet;
+  *ptr++ = 0x90;  // Version 2, extension.
+  *ptr++ = kPayloadType;
+  ModuleRTPUtility::AssignUWord16ToBuffer(ptr, sequence_number);
+  ModuleRTPUtility::AssignUWord32ToBuffer(ptr + 2, sequence_number * 160);
+  ModuleRTPUtility::AssignUWord32ToBuffer(ptr + 6, 0x11223344);
+  ptr += 10;
+  ModuleRTPUtility::AssignUWord16ToBuffer(ptr, RTP_ONE_BYTE_HEADER_EXTENSION);
+  ModuleRTPUtility::AssignUWord16ToBuffer(ptr + 2, 1);
+  ptr += 4;
+  *ptr++ = (kExtensionId << 4) + 2;
+  *ptr++ = kTimeOffset >> 16;
+  *ptr++ = (kTimeOffset >> 8) & 0xff;
+  *ptr++ = kTimeOffset & 0xff;
+  memset(ptr, 0xff, kPayloadLength);
+  ptr += kPayloadLength;
+  return static_cast<WebRtc_UWord16>(ptr - packet);
+}
+
+}  // namespace
+
+int main() {
+  FakeRtpRtcpClock clock;
+  ReceivedHeader received;
+  ModuleRtpRtcpImpl* rtp_rtcp_impl = new ModuleRtpRtcpImpl(0, true, &clock);
+  CodecInst codec = { kPayloadType, "PCMU", 8000, 160, 1, 64000 };
+  if (rtp_rtcp_impl->RegisterReceivePayload(codec) != 0 ||
+      rtp_rtcp_impl->RegisterIncomingDataCallback(&received) != 0 ||
+      rtp_rtcp_impl->RegisterReceiveRtpHeaderExtension(
+          TRANSMISSION_TIME_OFFSET, kExtensionId) != 0) {
+    printf("Could not set up the RTP module\n");
+    delete rtp_rtcp_impl;
+    return 1;
+  }
+
+  WebRtc_UWord8 packet[IP_PACKET_SIZE];
+  WebRtc_UWord16 sequence_number = 0;
+  // Let the first packet set up the receive state.
+  WebRtc_UWord16 packet_length = BuildPacket(sequence_number++, packet);
+  clock.AdvanceTimeMs(20);
+  rtp_rtcp_impl->IncomingPacket(packet, packet_length);
+
+  const int allocations_before = allocation_count;
+  TickInterval acc_ticks;
+  for (int i = 0; i < kNumPackets; i++) {
+    packet_length = BuildPacket(sequence_number++, packet);
+    clock.AdvanceTimeMs(20);
+    TickTime t0 = TickTime::Now();
+    if (rtp_rtcp_impl->IncomingPacket(packet, packet_length) != 0) {
+      printf("Packet %d was not received\n", i);
+      delete rtp_rtcp_impl;
+      return 1;
+    }
+    acc_ticks += TickTime::Now() - t0;
+  }
+  const int allocations = allocation_count - allocations_before;
+  delete rtp_rtcp_impl;
+
+  if (received.num_packets_ != kNumPackets + 1 ||
+      received.time_offset_ != kTimeOffset) {
+    printf("The header extension was not parsed\n");
+    return 1;
+  }
+  printf("RTP receive path with a header extension: %.3f allocations, "
+         "%.3f us / packet\n",
+         static_cast<double>(allocations) / kNumPackets,
+         static_cast<double>(acc_ticks.Microseconds()) / kNumPackets);
+  return 0;
+}
@@ -114,6 +114,10 @@ public:
            const CodecSpecificInfo* codecSpecificInfo,
            const VideoFrameType* frameTypes) = 0;
 
+    // Returns true if Encode() accepts images given by RawImage::_planes and
+    // _strides, e.g. with aligned or padded rows, instead of a packed buffer.
+    virtual bool AcceptsImagePlanes() const {return false;}
+
     // Register an encode complete callback object.
     //
     // Input:
@@ -182,6 +186,12 @@ public:
     // Return value                    : 0 if OK, < 0 otherwise.
     virtual WebRtc_Word32 Decoded(RawImage& decodedImage) = 0;
 
+    // Returns true if Decoded() accepts images that reference the decoder's
+    // own planes (RawImage::_planes) instead of a copy in a packed buffer.
+    // Such an image must be released, directly or by a VideoFrame wrapping
+    // it, before the decoder is called again.
+    virtual bool AcceptsImagePlanes() const {return false;}
+
     virtual WebRtc_Word32 ReceivedDecodedReferenceFrame(const WebRtc_UWord64 pictureId) {return -1;}
 
     virtual WebRtc_Word32 ReceivedDecodedFrame(const WebRtc_UWord64 pictureId) {return -1;}
@@ -36,6 +36,7 @@ VideoProcessorImpl::VideoProcessorImpl(webrtc::VideoEncoder* encoder,
       encode_callback_(NULL),
       decode_callback_(NULL),
       source_buffer_(NULL),
+      quality_calculator_(NULL),
       first_key_frame_has_been_excluded_(false),
       last_frame_missing_(false),
       initialized_(false) {
@@ -99,6 +100,12 @@ bool VideoProcessorImpl::Init() {
     return false;
   }
 
+  if (config_.calculate_quality_metrics) {
+    quality_calculator_ = new FrameQualityCalculator(
+        config_.codec_settings.width, config_.codec_settings.height,
+        FrameQualityCalculator::kPsnr | FrameQualityCalculator::kSsim, 0);
+  }
+
   if (config_.verbose) {
     printf("Video Processor:\n");
     printf("  #CPU cores used  : %d\n", nbr_of_cores);
@@ -114,6 +121,7 @@ bool VideoProcessorImpl::Init() {
 }
 
 VideoProcessorImpl::~VideoProcessorImpl() {
+  delete quality_calculator_;
   delete[] source_buffer_;
   delete[] last_successful_frame_buffer_;
   encoder_->RegisterEncodeCompleteCallback(NULL);
@@ -207,6 +215,10 @@ void VideoProcessorImpl::FrameEncoded(EncodedImage* encoded_image) {
     // Write the last successful frame the output file to avoid getting it out
     // of sync with the source file for SSIM and PSNR comparisons:
     frame_writer_->WriteFrame(last_successful_frame_buffer_);
+    if (quality_calculator_) {
+      quality_calculator_->AddFrame(frame_number, source_buffer_,
+                                    last_successful_frame_buffer_);
+    }
   }
   // save status for losses so we can inform the decoder for the next frame:
   last_frame_missing_ = encoded_image->_length == 0;
@@ -227,6 +239,20 @@ void VideoProcessorImpl::FrameDecoded(const RawImage& image) {
   if (!write_success) {
     fprintf(stderr, "Failed to write frame %d to disk!", frame_number);
   }
+  // The decoding is synchronous, so the source buffer still holds the source
+  // frame of this image.
+  if (quality_calculator_) {
+    quality_calculator_->AddFrame(frame_number, source_buffer_, image._buffer);
+  }
+}
+
+int VideoProcessorImpl::QualityMetrics(QualityMetricsResult* psnr_result,
+                                       QualityMetricsResult* ssim_result) {
+  if (!quality_calculator_) {
+    fprintf(stderr, "Quality metrics are not enabled in the TestConfig!\n");
+    return -1;
+  }
+  return quality_calculator_->GetResults(psnr_result, ssim_result);
 }
 
 int VideoProcessorImpl::GetElapsedTimeMicroseconds(
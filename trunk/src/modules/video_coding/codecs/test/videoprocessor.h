@@ -19,6 +19,7 @@
 #include "system_wrappers/interface/tick_util.h"
 #include "testsupport/frame_reader.h"
 #include "testsupport/frame_writer.h"
+#include "testsupport/metrics/video_metrics.h"
 
 namespace webrtc {
 namespace test {
@@ -42,7 +43,7 @@ struct TestConfig {
       input_filename(""), output_filename(""), output_dir("out"),
       networking_config(), exclude_frame_types(kExcludeOnlyFirstKeyFrame),
       frame_length_in_bytes(-1), use_single_core(false), keyframe_interval(0),
-      verbose(true) {
+      calculate_quality_metrics(false), verbose(true) {
   };
 
   // Name of the test. This is purely metadata and does not affect
@@ -98,6 +99,12 @@ struct TestConfig {
   // Default: 0.
   int keyframe_interval;
 
+  // If set to true, the PSNR and SSIM of each decoded frame against its source
+  // frame are calculated on worker threads while the encoding continues. The
+  // results are available from VideoProcessor::QualityMetrics().
+  // Default: false.
+  bool calculate_quality_metrics;
+
   // The codec settings to use for the test (target bitrate, video size,
   // framerate and so on)
   webrtc::VideoCodec codec_settings;
@@ -139,6 +146,12 @@ class VideoProcessor {
   // available in the source clip.
   // Frame number must be an integer >=0.
   virtual bool ProcessFrame(int frame_number) = 0;
+
+  // Waits for the quality metrics of all processed frames and fills them into
+  // the result structs. Requires calculate_quality_metrics in the TestConfig.
+  // Returns 0 if successful, negative if no metrics have been calculated.
+  virtual int QualityMetrics(QualityMetricsResult* psnr_result,
+                             QualityMetricsResult* ssim_result) = 0;
 };
 
 class VideoProcessorImpl : public VideoProcessor {
@@ -153,6 +166,8 @@ class VideoProcessorImpl : public VideoProcessor {
   virtual ~VideoProcessorImpl();
   virtual bool Init();
   virtual bool ProcessFrame(int frame_number);
+  virtual int QualityMetrics(QualityMetricsResult* psnr_result,
+                             QualityMetricsResult* ssim_result);
 
  private:
   // Invoked by the callback when a frame has completed encoding.
@@ -180,6 +195,8 @@ class VideoProcessorImpl : public VideoProcessor {
   // when decoding fails:
   WebRtc_UWord8* last_successful_frame_buffer_;
   webrtc::RawImage source_frame_;
+  // Calculates PSNR and SSIM of the output frames if enabled, else NULL:
+  FrameQualityCalculator* quality_calculator_;
   // To keep track of if we have excluded the first key frame from packet loss:
   bool first_key_frame_has_been_excluded_;
   // To tell the decoder previous frame have been dropped due to packet loss:
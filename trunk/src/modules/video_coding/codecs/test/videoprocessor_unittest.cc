@@ -86,5 +86,31 @@ TEST_F(VideoProcessorTest, ProcessFrame) {
   video_processor.ProcessFrame(0);
 }
 
+TEST_F(VideoProcessorTest, QualityMetrics) {
+  ExpectInit();
+  VideoProcessorImpl disabled_processor(&encoder_mock_, &decoder_mock_,
+                                        &frame_reader_mock_,
+                                        &frame_writer_mock_,
+                                        &packet_manipulator_mock_, config_,
+                                        &stats_);
+  disabled_processor.Init();
+  QualityMetricsResult psnr_result;
+  QualityMetricsResult ssim_result;
+  EXPECT_EQ(-1, disabled_processor.QualityMetrics(&psnr_result, &ssim_result));
+
+  ExpectInit();
+  config_.calculate_quality_metrics = true;
+  config_.codec_settings.width = 352;
+  config_.codec_settings.height = 288;
+  VideoProcessorImpl video_processor(&encoder_mock_, &decoder_mock_,
+                                     &frame_reader_mock_,
+                                     &frame_writer_mock_,
+                                     &packet_manipulator_mock_, config_,
+                                     &stats_);
+  video_processor.Init();
+  // No frames have been decoded.
+  EXPECT_EQ(-3, video_processor.QualityMetrics(&psnr_result, &ssim_result));
+}
+
 }  // namespace test
 }  // namespace webrtc
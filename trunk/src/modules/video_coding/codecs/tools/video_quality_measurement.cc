@@ -243,33 +243,16 @@ int HandleCommandLineFlags(webrtc::test::TestConfig* config) {
   config->networking_config.packet_loss_burst_length =
       FLAGS_packet_loss_burst_length;
   config->verbose = FLAGS_verbose;
+  // SSIM and PSNR are calculated while the frames are processed.
+  config->calculate_quality_metrics = true;
   return 0;
 }
 
-void CalculateSsimVideoMetrics(webrtc::test::TestConfig* config,
-                               QualityMetricsResult* ssimResult) {
-  Log("Calculating SSIM...\n");
-  SsimFromFiles(config->input_filename.c_str(), config->output_filename.c_str(),
-                config->codec_settings.width,
-                config->codec_settings.height, ssimResult);
-  Log("  Average: %3.2f\n", ssimResult->average);
-  Log("  Min    : %3.2f (frame %d)\n", ssimResult->min,
-      ssimResult->min_frame_number);
-  Log("  Max    : %3.2f (frame %d)\n", ssimResult->max,
-      ssimResult->max_frame_number);
-}
-
-void CalculatePsnrVideoMetrics(webrtc::test::TestConfig* config,
-                                 QualityMetricsResult* psnrResult) {
-  Log("Calculating PSNR...\n");
-  PsnrFromFiles(config->input_filename.c_str(), config->output_filename.c_str(),
-                    config->codec_settings.width,
-                    config->codec_settings.height, psnrResult);
-  Log("  Average: %3.2f\n", psnrResult->average);
-  Log("  Min    : %3.2f (frame %d)\n", psnrResult->min,
-      psnrResult->min_frame_number);
-  Log("  Max    : %3.2f (frame %d)\n", psnrResult->max,
-      psnrResult->max_frame_number);
+void PrintVideoMetrics(const char* name, const QualityMetricsResult& result) {
+  Log("%s:\n", name);
+  Log("  Average: %3.2f\n", result.average);
+  Log("  Min    : %3.2f (frame %d)\n", result.min, result.min_frame_number);
+  Log("  Max    : %3.2f (frame %d)\n", result.max, result.max_frame_number);
 }
 
 void PrintConfigurationSummary(const webrtc::test::TestConfig& config) {
@@ -480,16 +463,21 @@ int main(int argc, char* argv[]) {
   // Verify statistics are correct:
   assert(frame_number == static_cast<int>(stats.stats_.size()));
 
-  // Close the files before we start using them for SSIM/PSNR calculations.
+  // Close the files to flush the output file.
   frame_reader.Close();
   frame_writer.Close();
 
   stats.PrintSummary();
 
+  // Waits for the SSIM/PSNR calculations that ran during the processing.
   QualityMetricsResult ssimResult;
-  CalculateSsimVideoMetrics(&config, &ssimResult);
   QualityMetricsResult psnrResult;
-  CalculatePsnrVideoMetrics(&config, &psnrResult);
+  if (processor.QualityMetrics(&psnrResult, &ssimResult) != 0) {
+    fprintf(stderr, "Failed to calculate the SSIM/PSNR of the output.\n");
+    return 13;
+  }
+  PrintVideoMetrics("SSIM", ssimResult);
+  PrintVideoMetrics("PSNR", psnrResult);
 
   if (FLAGS_csv) {
     PrintCsvOutput(stats, ssimResult, psnrResult);
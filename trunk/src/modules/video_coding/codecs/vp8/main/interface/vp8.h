@@ -17,6 +17,7 @@
 #ifndef WEBRTC_MODULES_VIDEO_CODING_CODECS_VP8_H_
 #define WEBRTC_MODULES_VIDEO_CODING_CODECS_VP8_H_
 
+#include "module_common_types.h"
 #include "video_codec_interface.h"
 
 // VPX forward declaration
@@ -91,6 +92,9 @@ public:
                                  const CodecSpecificInfo* codecSpecificInfo,
                                  const VideoFrameType* frameTypes);
 
+// The encoder reads images with any row stride.
+    virtual bool AcceptsImagePlanes() const {return true;}
+
 // Register an encode complete callback object.
 //
 // Input:
@@ -181,7 +185,7 @@ private:
 /******************************/
 /* VP8Decoder class           */
 /******************************/
-class VP8Decoder : public VideoDecoder
+class VP8Decoder : public VideoDecoder, public PlaneReleaseCallback
 {
 public:
     VP8Decoder();
@@ -246,6 +250,11 @@ public:
 // Return value                : A copy of the instance if OK, NULL otherwise.
     virtual VideoDecoder* Copy();
 
+// Called by the consumer of a decoded image that references the planes of
+// the decoder (see DecodedImageCallback::AcceptsImagePlanes()) when it no
+// longer uses them. The planes are overwritten by the next Decode() call.
+    virtual void ReleasePlanes();
+
 private:
 // Copy reference image from this _decoder to the _decoder in copyTo. Set which
 // frame type to copy in _refFrame->frame_type before the call to this function.
@@ -268,6 +277,9 @@ private:
     vpx_ref_frame_t*           _refFrame;
     int                        _propagationCnt;
     bool                       _latestKeyFrameComplete;
+    bool                       _planesLent;
+    // True once a frame has been returned, packed or lent.
+    bool                       _frameDecoded;
 };// end of VP8Decoder class
 } // namespace webrtc
 
@@ -14,6 +14,9 @@
  * Creates up to kMaxSimulcastStreams number of VP8 encoders
  * Automatically scale the input frame to the right size for all VP8 encoders
  * Runtime it divides the available bitrate beteween the VP8 Encoders 
+ * The input frame is scaled once into a pyramid, where each stream is scaled
+ * from the smallest larger stream, and the streams are encoded in parallel
+ * when there is more than one core.
  */
 
 
@@ -22,11 +25,16 @@
 
 #include "common_video/libyuv/include/scaler.h"
 
+#include "module_common_types.h"
 #include "video_codec_interface.h"
 #include "vp8.h"
 
 namespace webrtc
 {
+class CriticalSectionWrapper;
+class EventWrapper;
+class ThreadWrapper;
+
 class VP8SimulcastEncoder : public VideoEncoder
 {
 public:
@@ -88,6 +96,8 @@ public:
                                const CodecSpecificInfo* codecSpecificInfo,
                                const VideoFrameType* frameTypes);
 
+  virtual bool AcceptsImagePlanes() const {return true;}
+
 // Register an encode complete callback object.
 //
 // Input:
@@ -135,12 +145,92 @@ public:
   static WebRtc_Word32  VersionStatic(WebRtc_Word8 *version,
                                       WebRtc_Word32 length);
 
+// Choose the pyramid level each stream of codec is scaled from.
+//
+// Output:
+//          - scaleOrder        : The streams ordered by decreasing size, the
+//                                order they are scaled in.
+//          - scaleSource       : For each stream, the stream whose level it
+//                                is scaled from, or -1 for the input image.
+//                                A stream is scaled from the smallest level
+//                                that is at least as large.
+  static void SelectScaleSources(const VideoCodec& codec,
+                                 int* scaleOrder,
+                                 int* scaleSource);
+
 private:
+  // Keeps the image encoded for one stream, so that all streams are
+  // delivered on the calling thread and in stream order. The payload stays
+  // in the encoder's buffer, which is valid until its next Encode().
+  class DeferredCallback : public EncodedImageCallback {
+   public:
+    DeferredCallback();
+    virtual WebRtc_Word32 Encoded(
+        EncodedImage& encodedImage,
+        const CodecSpecificInfo* codecSpecificInfo = NULL,
+        const RTPFragmentationHeader* fragmentation = NULL);
+    // Hands the kept image, if any, to callback.
+    void Deliver(EncodedImageCallback* callback);
+
+   private:
+    bool pending_;
+    EncodedImage encoded_image_;
+    CodecSpecificInfo codec_specific_;
+    bool has_codec_specific_;
+    RTPFragmentationHeader fragmentation_;
+    bool has_fragmentation_;
+  };
+
+  // Thread that encodes one stream while the calling thread encodes
+  // another.
+  class EncodeWorker {
+   public:
+    EncodeWorker(VP8SimulcastEncoder* parent, int stream);
+    ~EncodeWorker();
+    bool Start();
+    // Starts encoding the stream; Wait() returns the result.
+    void Signal();
+    WebRtc_Word32 Wait();
+
+   private:
+    static bool Run(void* obj);
+    bool Process();
+
+    VP8SimulcastEncoder* parent_;
+    const int stream_;
+    ThreadWrapper* thread_;
+    CriticalSectionWrapper& crit_;
+    EventWrapper& start_event_;
+    EventWrapper& done_event_;
+    bool stop_;  // Protected by crit_.
+    WebRtc_Word32 result_;
+  };
+
+  // Chooses the pyramid level each stream is scaled from, and allocates
+  // the levels that are scaled.
+  WebRtc_Word32 SetupPyramid();
+  // Scales the input into the pyramid levels that are needed this frame.
+  WebRtc_Word32 ScalePyramid(const RawImage& inputImage);
+  // Encodes stream i with its pyramid level, or with the input image.
+  WebRtc_Word32 EncodeStream(int i);
+  void StopWorkers();
+
   VP8Encoder* encoder_[kMaxSimulcastStreams];
   bool encode_stream_[kMaxSimulcastStreams];
   VideoFrameType frame_type_[kMaxSimulcastStreams];
   Scaler* scaler_[kMaxSimulcastStreams];
+  // Stream whose pyramid level stream i is scaled from, or -1 for the input.
+  int scale_source_[kMaxSimulcastStreams];
+  // Streams ordered by decreasing size, the order they are scaled in.
+  int scale_order_[kMaxSimulcastStreams];
+  VideoFrame pyramid_[kMaxSimulcastStreams];
   RawImage video_frame_[kMaxSimulcastStreams];
+  DeferredCallback deferred_[kMaxSimulcastStreams];
+  EncodeWorker* worker_[kMaxSimulcastStreams];
+  // Per-frame state for the workers.
+  const RawImage* input_image_;
+  CodecSpecificInfo info_[kMaxSimulcastStreams];
+  EncodedImageCallback* callback_;
   VideoCodec video_codec_;
 };// end of VP8SimulcastEncoder class
 } // namespace webrtc
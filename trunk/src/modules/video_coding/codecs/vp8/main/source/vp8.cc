@@ -30,10 +30,53 @@
 #include "vpx/vp8dx.h"
 
 enum { kVp8ErrorPropagationTh = 30 };
+// Most threads used by one encoder or decoder instance.
+enum { kVp8MaxThreads = 8 };
 
 namespace webrtc
 {
 
+// Returns the number of threads worth using for a frame of the given size,
+// but never more than numberOfCores. VP8 spreads macroblock rows over the
+// threads, so small frames gain little from more than one.
+static int NumberOfThreads(int width, int height, int numberOfCores)
+{
+    const int pixels = width * height;
+    int threads = 1;
+    if (pixels >= 1920 * 1080)
+    {
+        threads = kVp8MaxThreads;
+    }
+    else if (pixels >= 1280 * 720)
+    {
+        threads = 4;
+    }
+    else if (pixels > 704 * 576)
+    {
+        threads = 2;
+    }
+    return (threads < numberOfCores) ? threads : numberOfCores;
+}
+
+// Returns the token partition setting that lets a decoder with
+// NumberOfThreads() threads decode the macroblock rows of a frame in
+// parallel. The decoder only runs multi-threaded on streams with more than
+// one token partition.
+static vp8e_token_partitions TokenPartitions(int width, int height)
+{
+    switch (NumberOfThreads(width, height, kVp8MaxThreads))
+    {
+        case 8:
+            return VP8_EIGHT_TOKENPARTITION;
+        case 4:
+            return VP8_FOUR_TOKENPARTITION;
+        case 2:
+            return VP8_TWO_TOKENPARTITION;
+        default:
+            return VP8_ONE_TOKENPARTITION;
+    }
+}
+
 VP8Encoder::VP8Encoder():
     _encodedImage(),
     _encodedCompleteCallback(NULL),
@@ -299,13 +342,11 @@ VP8Encoder::InitEncode(const VideoCodec* inst,
 #endif
     _cfg->g_lag_in_frames = 0; // 0- no frame lagging
 
-    // Determining number of threads based on the image size
-
-    if (_width * _height > 704 * 576 && numberOfCores > 1)
-      // 2 threads when larger than 4CIF
-      _cfg->g_threads = 2;
-    else
-      _cfg->g_threads = 1;
+    // Determining number of threads based on the image size and the cores
+    // given to this encoder. The token partitions depend on the image size
+    // only, since they are for the benefit of the remote decoder.
+    _cfg->g_threads = NumberOfThreads(_width, _height, numberOfCores);
+    _tokenPartitions = TokenPartitions(_width, _height);
 
     // rate control settings
     _cfg->rc_dropframe_thresh = 30;
@@ -424,7 +465,7 @@ VP8Encoder::Encode(const RawImage& inputImage,
     {
         return WEBRTC_VIDEO_CODEC_UNINITIALIZED;
     }
-    if (inputImage._buffer == NULL)
+    if (inputImage._buffer == NULL && inputImage._planes[0] == NULL)
     {
         return WEBRTC_VIDEO_CODEC_ERR_PARAMETER;
     }
@@ -441,9 +482,25 @@ VP8Encoder::Encode(const RawImage& inputImage,
         _simulcastIdx = 0; 
     }
     // image in vpx_image_t format
-    _raw->planes[PLANE_Y] =  inputImage._buffer;
-    _raw->planes[PLANE_U] =  &inputImage._buffer[_height * _width];
-    _raw->planes[PLANE_V] =  &inputImage._buffer[_height * _width * 5 >> 2];
+    if (inputImage._planes[0] != NULL)
+    {
+        for (int plane = 0; plane < 3; plane++)
+        {
+            _raw->planes[plane] = inputImage._planes[plane];
+            _raw->stride[plane] = inputImage._strides[plane];
+        }
+    }
+    else
+    {
+        _raw->planes[PLANE_Y] =  inputImage._buffer;
+        _raw->planes[PLANE_U] =  &inputImage._buffer[_height * _width];
+        _raw->planes[PLANE_V] =  &inputImage._buffer[_height * _width * 5 >> 2];
+        // The strides set by vpx_img_alloc() in InitEncode().
+        const int stride = (_width + 1) & ~1;
+        _raw->stride[PLANE_Y] = stride;
+        _raw->stride[PLANE_U] = stride >> 1;
+        _raw->stride[PLANE_V] = stride >> 1;
+    }
 
     int flags = 0;
 #if WEBRTC_LIBVPX_VERSION >= 971
@@ -656,7 +713,9 @@ VP8Decoder::VP8Decoder():
     _imageFormat(VPX_IMG_FMT_NONE),
     _refFrame(NULL),
     _propagationCnt(-1),
-    _latestKeyFrameComplete(false)
+    _latestKeyFrameComplete(false),
+    _planesLent(false),
+    _frameDecoded(false)
 {
 }
 
@@ -706,8 +765,14 @@ VP8Decoder::InitDecode(const VideoCodec* inst,
     }
 
     vpx_codec_dec_cfg_t  cfg;
-    // Setting number of threads to a constant value (1)
+    // Determining number of threads based on the expected image size and the
+    // cores given to this decoder. Use one thread if the size is unknown.
     cfg.threads = 1;
+    if (inst && numberOfCores > 1)
+    {
+        cfg.threads = NumberOfThreads(inst->width, inst->height,
+                                      numberOfCores);
+    }
     cfg.h = cfg.w = 0; // set after decode
 
     vpx_codec_flags_t flags = 0;
@@ -765,6 +830,8 @@ VP8Decoder::Decode(const EncodedImage& inputImage,
     {
         return WEBRTC_VIDEO_CODEC_UNINITIALIZED;
     }
+    // The previous picture must not be referenced when it is overwritten.
+    assert(!_planesLent);
     if (inputImage._buffer == NULL && inputImage._length > 0)
     {
         // Reset to avoid requesting key frames too often.
@@ -965,6 +1032,31 @@ VP8Decoder::ReturnFrame(const vpx_image_t* img, WebRtc_UWord32 timeStamp)
         return WEBRTC_VIDEO_CODEC_NO_OUTPUT;
     }
 
+    if (_decodeCompleteCallback->AcceptsImagePlanes())
+    {
+        // Lend the planes of the decoder to the callback instead of packing
+        // them into _decodedImage. They stay valid until the next decode.
+        RawImage image;
+        for (int plane = 0; plane < 3; plane++)
+        {
+            image._planes[plane] = img->planes[plane];
+            image._strides[plane] = img->stride[plane];
+        }
+        image._releaseCallback = this;
+        image._height = img->d_h;
+        image._width = img->d_w;
+        image._timeStamp = timeStamp;
+        // Copy() sizes the reference frames from these, since _decodedImage
+        // has no buffer in this mode.
+        _decodedImage._height = img->d_h;
+        _decodedImage._width = img->d_w;
+        _imageFormat = img->fmt;
+        _frameDecoded = true;
+
+        _planesLent = true;
+        return _decodeCompleteCallback->Decoded(image);
+    }
+
     // Allocate memory for decoded image
     WebRtc_UWord32 requiredSize = (3 * img->d_h * img->d_w) >> 1;
     if (requiredSize > _decodedImage._size)
@@ -1000,15 +1092,21 @@ VP8Decoder::ReturnFrame(const vpx_image_t* img, WebRtc_UWord32 timeStamp)
     _decodedImage._width = img->d_w;
     _decodedImage._length = (3 * img->d_h * img->d_w) >> 1;
     _decodedImage._timeStamp = timeStamp;
+    // Remember image format for later
+    _imageFormat = img->fmt;
+    _frameDecoded = true;
     WebRtc_Word32 ret = _decodeCompleteCallback->Decoded(_decodedImage);
     if (ret != 0)
         return ret;
-
-    // Remember image format for later
-    _imageFormat = img->fmt;
     return WEBRTC_VIDEO_CODEC_OK;
 }
 
+void
+VP8Decoder::ReleasePlanes()
+{
+    _planesLent = false;
+}
+
 WebRtc_Word32
 VP8Decoder::RegisterDecodeCompleteCallback(DecodedImageCallback* callback)
 {
@@ -1050,6 +1148,7 @@ VP8Decoder::Release()
         _refFrame = NULL;
     }
 
+    _frameDecoded = false;
     _inited = false;
     return WEBRTC_VIDEO_CODEC_OK;
 }
@@ -1064,7 +1163,7 @@ VP8Decoder::Copy()
         assert(false);
         return NULL;
     }
-    if (_decodedImage._buffer == NULL)
+    if (!_frameDecoded)
     {
         // Nothing has been decoded before; cannot clone.
         return NULL;
@@ -1139,6 +1238,7 @@ VP8Decoder::Copy()
     // Copy all member variables (that are not set in initialization).
     copyTo->_feedbackModeOn = _feedbackModeOn;
     copyTo->_imageFormat = _imageFormat;
+    copyTo->_frameDecoded = _frameDecoded;
     copyTo->_lastKeyFrame = _lastKeyFrame; // Shallow copy.
     // Allocate memory. (Discard copied _buffer pointer.)
     copyTo->_lastKeyFrame._buffer = new WebRtc_UWord8[_lastKeyFrame._size];
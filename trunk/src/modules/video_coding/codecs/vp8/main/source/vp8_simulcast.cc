@@ -17,37 +17,182 @@
 
 #include <string.h>
 
+#include "critical_section_wrapper.h"
+#include "event_wrapper.h"
 #include "module_common_types.h"
+#include "thread_wrapper.h"
 #include "trace.h"
 
 namespace webrtc {
 
-VP8SimulcastEncoder::VP8SimulcastEncoder() {
+namespace {
+
+// Time the encode threads wait for work before checking if they are stopped.
+const unsigned long kWorkerWaitTimeMs = 100;
+
+void PyramidLevelPlanes(const VideoFrame& frame, I420Planes* planes) {
+  for (int i = 0; i < kNumOfI420Planes; i++) {
+    planes->plane[i] = frame.Plane(i);
+    planes->stride[i] = frame.Stride(i);
+  }
+  planes->width = frame.Width();
+  planes->height = frame.Height();
+}
+
+}  // namespace
+
+VP8SimulcastEncoder::DeferredCallback::DeferredCallback()
+    : pending_(false),
+      has_codec_specific_(false),
+      has_fragmentation_(false) {
+}
+
+WebRtc_Word32 VP8SimulcastEncoder::DeferredCallback::Encoded(
+    EncodedImage& encodedImage,
+    const CodecSpecificInfo* codecSpecificInfo,
+    const RTPFragmentationHeader* fragmentation) {
+  encoded_image_ = encodedImage;
+  has_codec_specific_ = (codecSpecificInfo != NULL);
+  if (has_codec_specific_) {
+    codec_specific_ = *codecSpecificInfo;
+  }
+  has_fragmentation_ = (fragmentation != NULL);
+  if (has_fragmentation_) {
+    fragmentation_ = *fragmentation;
+  }
+  pending_ = true;
+  return 0;
+}
+
+void VP8SimulcastEncoder::DeferredCallback::Deliver(
+    EncodedImageCallback* callback) {
+  if (!pending_) {
+    return;
+  }
+  pending_ = false;
+  if (callback) {
+    callback->Encoded(encoded_image_,
+                      has_codec_specific_ ? &codec_specific_ : NULL,
+                      has_fragmentation_ ? &fragmentation_ : NULL);
+  }
+}
+
+VP8SimulcastEncoder::EncodeWorker::EncodeWorker(VP8SimulcastEncoder* parent,
+                                                int stream)
+    : parent_(parent),
+      stream_(stream),
+      thread_(NULL),
+      crit_(*CriticalSectionWrapper::CreateCriticalSection()),
+      start_event_(*EventWrapper::Create()),
+      done_event_(*EventWrapper::Create()),
+      stop_(false),
+      result_(0) {
+}
+
+VP8SimulcastEncoder::EncodeWorker::~EncodeWorker() {
+  if (thread_) {
+    thread_->SetNotAlive();
+    {
+      CriticalSectionScoped cs(crit_);
+      stop_ = true;
+    }
+    start_event_.Set();
+    if (thread_->Stop()) {
+      delete thread_;
+    } else {
+      WEBRTC_TRACE(webrtc::kTraceError, webrtc::kTraceVideoCoding, -1,
+                   "Could not stop the encode thread of stream:%d", stream_);
+    }
+  }
+  delete &start_event_;
+  delete &done_event_;
+  delete &crit_;
+}
+
+bool VP8SimulcastEncoder::EncodeWorker::Start() {
+  thread_ = ThreadWrapper::CreateThread(Run, this, kHighPriority,
+                                        "VP8SimulcastEncodeThread");
+  if (thread_ == NULL) {
+    return false;
+  }
+  unsigned int id = 0;
+  if (!thread_->Start(id)) {
+    delete thread_;
+    thread_ = NULL;
+    return false;
+  }
+  return true;
+}
+
+void VP8SimulcastEncoder::EncodeWorker::Signal() {
+  start_event_.Set();
+}
+
+WebRtc_Word32 VP8SimulcastEncoder::EncodeWorker::Wait() {
+  if (done_event_.Wait(WEBRTC_EVENT_INFINITE) != kEventSignaled) {
+    return WEBRTC_VIDEO_CODEC_ERROR;
+  }
+  return result_;
+}
+
+bool VP8SimulcastEncoder::EncodeWorker::Run(void* obj) {
+  return static_cast<EncodeWorker*>(obj)->Process();
+}
+
+bool VP8SimulcastEncoder::EncodeWorker::Process() {
+  if (start_event_.Wait(kWorkerWaitTimeMs) != kEventSignaled) {
+    return true;
+  }
+  {
+    CriticalSectionScoped cs(crit_);
+    if (stop_) {
+      return false;
+    }
+  }
+  result_ = parent_->EncodeStream(stream_);
+  done_event_.Set();
+  return true;
+}
+
+VP8SimulcastEncoder::VP8SimulcastEncoder()
+    : input_image_(NULL),
+      callback_(NULL) {
   for (int i = 0; i < kMaxSimulcastStreams; i++) {
     encoder_[i] = NULL;
     encode_stream_[i] = false;
     frame_type_[i] = kKeyFrame;
     scaler_[i] = NULL;
+    scale_source_[i] = -1;
+    scale_order_[i] = i;
+    worker_[i] = NULL;
   }
+  memset(&video_codec_, 0, sizeof(VideoCodec));
 }
 
 VP8SimulcastEncoder::~VP8SimulcastEncoder() {
+  StopWorkers();
   for (int i = 0; i < kMaxSimulcastStreams; i++) {
     delete encoder_[i];
     delete scaler_[i];
-    delete [] video_frame_[i]._buffer;
+  }
+}
+
+void VP8SimulcastEncoder::StopWorkers() {
+  for (int i = 0; i < kMaxSimulcastStreams; i++) {
+    delete worker_[i];
+    worker_[i] = NULL;
   }
 }
 
 WebRtc_Word32 VP8SimulcastEncoder::Release() {
+  StopWorkers();
   for (int i = 0; i < kMaxSimulcastStreams; i++) {
     delete encoder_[i];
     encoder_[i] = NULL;
     delete scaler_[i];
     scaler_[i] = NULL;
-    delete [] video_frame_[i]._buffer;
-    video_frame_[i]._buffer = NULL;
-    video_frame_[i]._size = 0;
+    pyramid_[i].Free();
+    video_frame_[i] = RawImage();
   }
   return 0;
 }
@@ -64,17 +209,29 @@ WebRtc_Word32 VP8SimulcastEncoder::Reset() {
 WebRtc_Word32 VP8SimulcastEncoder::InitEncode(const VideoCodec* codecSettings,
                                               WebRtc_Word32 numberOfCores,
                                               WebRtc_UWord32 maxPayloadSize) {
+  StopWorkers();
+
   // Store a config copy
   memcpy(&video_codec_, codecSettings, sizeof(VideoCodec));
+  if (SetupPyramid() != 0) {
+    return WEBRTC_VIDEO_CODEC_MEMORY;
+  }
 
   // local copy
   VideoCodec video_codec;
   memcpy(&video_codec, codecSettings, sizeof(VideoCodec));
   video_codec.numberOfSimulcastStreams = 0;
 
+  // With more than one core the streams are encoded in parallel, and the
+  // largest stream gets the cores that are left. Otherwise the streams are
+  // encoded one at a time and each may use all cores.
+  const int number_of_streams = codecSettings->numberOfSimulcastStreams;
+  const bool parallel = (numberOfCores > 1 && number_of_streams > 1);
+  const int largest_stream = scale_order_[0];
+
   WebRtc_UWord32 bitrate_sum = 0;
   WebRtc_Word32 ret_val = 0;
-  for (int i = 0; i < codecSettings->numberOfSimulcastStreams; i++) {
+  for (int i = 0; i < number_of_streams; i++) {
     if (encoder_[i] == NULL) {
       encoder_[i] = new VP8Encoder();
     }
@@ -103,10 +260,12 @@ WebRtc_Word32 VP8SimulcastEncoder::InitEncode(const VideoCodec* codecSettings,
     video_codec.width = codecSettings->simulcastStream[i].width;
     video_codec.height = codecSettings->simulcastStream[i].height;
 
-    WebRtc_Word32 cores = 1;
-    if (video_codec.width > 640 &&
-        numberOfCores > codecSettings->numberOfSimulcastStreams) {
-      cores = 2;
+    WebRtc_Word32 cores = numberOfCores;
+    if (parallel) {
+      cores = 1;
+      if (i == largest_stream && numberOfCores > number_of_streams) {
+        cores = numberOfCores - number_of_streams + 1;
+      }
     }
     ret_val = encoder_[i]->InitEncode(&video_codec,
                                       cores,
@@ -119,27 +278,169 @@ WebRtc_Word32 VP8SimulcastEncoder::InitEncode(const VideoCodec* codecSettings,
                    i);
       return ret_val;
     }
-    if (codecSettings->width != video_codec.width ||
-        codecSettings->height != video_codec.height) {
-      if (scaler_[i] == NULL) {
-        scaler_[i] = new Scaler();
+    encoder_[i]->RegisterEncodeCompleteCallback(&deferred_[i]);
+  }
+
+  if (parallel) {
+    // The calling thread encodes the largest stream.
+    for (int i = 0; i < number_of_streams; i++) {
+      if (i == largest_stream || encoder_[i] == NULL) {
+        continue;
       }
-      scaler_[i]->Set(codecSettings->width, codecSettings->height,
-                      video_codec.width, video_codec.height,
-                      kI420, kI420, kScaleBox);
-
-      if (video_frame_[i]._size <
-          (3u * video_codec.width * video_codec.height / 2u)) {
-        video_frame_[i]._size = 3 * video_codec.width * video_codec.height / 2;
-        delete video_frame_[i]._buffer;
-        video_frame_[i]._buffer = new WebRtc_UWord8[video_frame_[i]._size];
-        video_frame_[i]._length = 0;
+      worker_[i] = new EncodeWorker(this, i);
+      if (!worker_[i]->Start()) {
+        WEBRTC_TRACE(webrtc::kTraceWarning, webrtc::kTraceVideoCoding, -1,
+                     "Could not start an encode thread for stream:%d", i);
+        delete worker_[i];
+        worker_[i] = NULL;
       }
     }
   }
   return ret_val;
 }
 
+void VP8SimulcastEncoder::SelectScaleSources(const VideoCodec& codec,
+                                             int* scaleOrder,
+                                             int* scaleSource) {
+  const int number_of_streams = codec.numberOfSimulcastStreams;
+  const SimulcastStream* streams = codec.simulcastStream;
+
+  // Order the streams by decreasing size.
+  for (int k = 0; k < number_of_streams; k++) {
+    const int i = k;
+    const WebRtc_UWord32 area = streams[i].width * streams[i].height;
+    int j = k;
+    for (; j > 0; j--) {
+      const int prev = scaleOrder[j - 1];
+      if (streams[prev].width * streams[prev].height >= area) {
+        break;
+      }
+      scaleOrder[j] = prev;
+    }
+    scaleOrder[j] = i;
+  }
+
+  for (int k = 0; k < number_of_streams; k++) {
+    const int i = scaleOrder[k];
+    scaleSource[i] = -1;
+    // Scale from the smallest level that is at least as large, since it
+    // is the cheapest source. For the box filter and the usual factors of
+    // two the result differs from scaling the input by at most one.
+    // Streams of the input size have no level of their own.
+    WebRtc_UWord32 source_area = 0;
+    for (int m = 0; m < k; m++) {
+      const int j = scaleOrder[m];
+      const WebRtc_UWord32 area = streams[j].width * streams[j].height;
+      const bool has_level = (streams[j].width != codec.width ||
+                              streams[j].height != codec.height);
+      if (has_level &&
+          streams[j].width >= streams[i].width &&
+          streams[j].height >= streams[i].height &&
+          (scaleSource[i] < 0 || area < source_area)) {
+        scaleSource[i] = j;
+        source_area = area;
+      }
+    }
+  }
+}
+
+WebRtc_Word32 VP8SimulcastEncoder::SetupPyramid() {
+  const int number_of_streams = video_codec_.numberOfSimulcastStreams;
+  const SimulcastStream* streams = video_codec_.simulcastStream;
+
+  SelectScaleSources(video_codec_, scale_order_, scale_source_);
+
+  for (int k = 0; k < number_of_streams; k++) {
+    const int i = scale_order_[k];
+    const WebRtc_UWord16 width = streams[i].width;
+    const WebRtc_UWord16 height = streams[i].height;
+    if (width == video_codec_.width && height == video_codec_.height) {
+      // Encoded straight from the input.
+      delete scaler_[i];
+      scaler_[i] = NULL;
+      pyramid_[i].Free();
+      video_frame_[i] = RawImage();
+      continue;
+    }
+    const int source = scale_source_[i];
+    if (scaler_[i] == NULL) {
+      scaler_[i] = new Scaler();
+    }
+    scaler_[i]->Set(source < 0 ? video_codec_.width : streams[source].width,
+                    source < 0 ? video_codec_.height : streams[source].height,
+                    width, height, kI420, kI420, kScaleBox);
+
+    if (pyramid_[i].AllocatePlanes(width, height) != 0) {
+      return -1;
+    }
+    video_frame_[i] = RawImage();
+    for (int plane = 0; plane < kNumOfI420Planes; plane++) {
+      video_frame_[i]._planes[plane] = pyramid_[i].Plane(plane);
+      video_frame_[i]._strides[plane] = pyramid_[i].Stride(plane);
+    }
+    video_frame_[i]._width = width;
+    video_frame_[i]._height = height;
+  }
+  return 0;
+}
+
+WebRtc_Word32 VP8SimulcastEncoder::ScalePyramid(const RawImage& inputImage) {
+  const int number_of_streams = video_codec_.numberOfSimulcastStreams;
+
+  I420Planes input;
+  if (inputImage._planes[0] != NULL) {
+    for (int i = 0; i < kNumOfI420Planes; i++) {
+      input.plane[i] = inputImage._planes[i];
+      input.stride[i] = inputImage._strides[i];
+    }
+    input.width = inputImage._width;
+    input.height = inputImage._height;
+  } else {
+    I420PlanesFromBuffer(inputImage._buffer, inputImage._width,
+                         inputImage._height, &input);
+  }
+
+  // A level is needed if its stream is encoded, or if a needed level is
+  // scaled from it. The smaller levels come later in scale_order_.
+  bool needed[kMaxSimulcastStreams];
+  for (int i = 0; i < number_of_streams; i++) {
+    needed[i] = (encoder_[i] != NULL && encode_stream_[i]);
+  }
+  for (int k = number_of_streams - 1; k >= 0; k--) {
+    const int i = scale_order_[k];
+    if (needed[i] && scale_source_[i] >= 0) {
+      needed[scale_source_[i]] = true;
+    }
+  }
+
+  for (int k = 0; k < number_of_streams; k++) {
+    const int i = scale_order_[k];
+    if (!needed[i] || scaler_[i] == NULL) {
+      continue;
+    }
+    I420Planes source = input;
+    if (scale_source_[i] >= 0) {
+      PyramidLevelPlanes(pyramid_[scale_source_[i]], &source);
+    }
+    I420Planes level;
+    PyramidLevelPlanes(pyramid_[i], &level);
+    if (scaler_[i]->Scale(source, level) != 0) {
+      WEBRTC_TRACE(webrtc::kTraceError, webrtc::kTraceVideoCoding, -1,
+                   "Scale error on stream:%d", i);
+      return WEBRTC_VIDEO_CODEC_ERROR;
+    }
+    video_frame_[i]._timeStamp = inputImage._timeStamp;
+  }
+  return WEBRTC_VIDEO_CODEC_OK;
+}
+
+WebRtc_Word32 VP8SimulcastEncoder::EncodeStream(int i) {
+  VideoFrameType requested_frame_type = frame_type_[i];
+  return encoder_[i]->Encode(scaler_[i] ? video_frame_[i] : *input_image_,
+                             &info_[i],
+                             &requested_frame_type);
+}
+
 WebRtc_Word32  VP8SimulcastEncoder::Encode(
     const RawImage& inputImage,
     const CodecSpecificInfo* codecSpecificInfo,
@@ -147,14 +448,17 @@ WebRtc_Word32  VP8SimulcastEncoder::Encode(
 
   WebRtc_Word32 ret_val = -1;
   // we need a local copy since we modify it
-  CodecSpecificInfo info = *codecSpecificInfo;
+  CodecSpecificInfo info;
+  if (codecSpecificInfo) {
+    info = *codecSpecificInfo;
+  } else {
+    memset(&info, 0, sizeof(info));
+    info.codecType = kVideoCodecVP8;
+  }
 
   const int numberOfStreams = video_codec_.numberOfSimulcastStreams;
 
   for (int i = 0; i < numberOfStreams; i++) {
-    if (encode_stream_[i]) {
-       video_frame_[i]._timeStamp = inputImage._timeStamp;
-    }
     if (requestedFrameTypes[i] == kKeyFrame) {
       // always do a keyframe if asked to
       frame_type_[i] = kKeyFrame;
@@ -176,31 +480,54 @@ WebRtc_Word32  VP8SimulcastEncoder::Encode(
     }
   }
 
+  WebRtc_Word32 scale_ret = ScalePyramid(inputImage);
+  if (scale_ret < 0) {
+    return scale_ret;
+  }
+
+  // Start the encode threads first, then encode the other streams here.
+  input_image_ = &inputImage;
+  WebRtc_Word32 stream_ret[kMaxSimulcastStreams];
   for (int i = 0; i < numberOfStreams; i++) {
     if (encoder_[i] && encode_stream_[i]) {
       // Need the simulcastIdx to keep track of which encoder encoded the frame.
-      info.codecSpecific.VP8.simulcastIdx = i;
-      VideoFrameType requested_frame_type = frame_type_[i];
-      if (scaler_[i]) {
-        int video_frame_size = static_cast<int>(video_frame_[i]._size);
-        scaler_[i]->Scale(inputImage._buffer,
-                          video_frame_[i]._buffer,
-                          video_frame_size);
-        video_frame_[i]._length = video_frame_[i]._size = video_frame_size;
-        ret_val = encoder_[i]->Encode(video_frame_[i],
-                                      &info,
-                                      &requested_frame_type);
-      } else {
-        ret_val = encoder_[i]->Encode(inputImage,
-                                      &info,
-                                      &requested_frame_type);
+      info_[i] = info;
+      info_[i].codecSpecific.VP8.simulcastIdx = i;
+      if (worker_[i]) {
+        worker_[i]->Signal();
       }
-      if (ret_val < 0) {
+    }
+  }
+  for (int i = 0; i < numberOfStreams; i++) {
+    if (encoder_[i] && encode_stream_[i] && !worker_[i]) {
+      stream_ret[i] = EncodeStream(i);
+    }
+  }
+  for (int i = 0; i < numberOfStreams; i++) {
+    if (encoder_[i] && encode_stream_[i] && worker_[i]) {
+      stream_ret[i] = worker_[i]->Wait();
+    }
+  }
+  input_image_ = NULL;
+
+  // Deliver in stream order, and report the first error.
+  bool failed = false;
+  for (int i = 0; i < numberOfStreams; i++) {
+    if (encoder_[i] && encode_stream_[i]) {
+      if (stream_ret[i] < 0) {
         WEBRTC_TRACE(webrtc::kTraceError, webrtc::kTraceVideoCoding, -1,
-                     "Encode error:%d on stream:%d", ret_val, i);
-        return ret_val;
+                     "Encode error:%d on stream:%d", stream_ret[i], i);
+        if (!failed) {
+          ret_val = stream_ret[i];
+          failed = true;
+        }
+        continue;
       }
       frame_type_[i] = kDeltaFrame;
+      deferred_[i].Deliver(callback_);
+      if (!failed) {
+        ret_val = stream_ret[i];
+      }
     }
   }
   return ret_val;
@@ -208,22 +535,9 @@ WebRtc_Word32  VP8SimulcastEncoder::Encode(
 
 WebRtc_Word32 VP8SimulcastEncoder::RegisterEncodeCompleteCallback(
     EncodedImageCallback* callback) {
-  WebRtc_Word32 ret_val = 0;
-  for (int i = 0; i < kMaxSimulcastStreams; i++) {
-    if (encoder_[i]) {
-      ret_val = encoder_[i]->RegisterEncodeCompleteCallback(callback);
-      if (ret_val < 0) {
-        WEBRTC_TRACE(webrtc::kTraceError,
-                     webrtc::kTraceVideoCoding,
-                     -1,
-                     "RegisterEncodeCompleteCallback error:%d on stream:%d",
-                     ret_val,
-                     i);
-        return ret_val;
-      }
-    }
-  }
-  return ret_val;
+  // The encoders deliver to deferred_, which forwards to callback.
+  callback_ = callback;
+  return 0;
 }
 
 WebRtc_Word32 VP8SimulcastEncoder::SetChannelParameters(
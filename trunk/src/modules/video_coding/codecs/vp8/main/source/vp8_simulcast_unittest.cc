@@ -0,0 +1,395 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "vp8_simulcast.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <vector>
+
+#include "common_video/libyuv/include/scaler.h"
+#include "gtest/gtest.h"
+#include "module_common_types.h"
+#include "vp8.h"
+
+namespace webrtc {
+
+namespace {
+
+const int kWidth = 320;
+const int kHeight = 240;
+const int kNumberOfStreams = 3;
+const int kNumberOfFrames = 10;
+const int kFrameRate = 30;
+const WebRtc_UWord32 kTimestampDelta = 90000 / kFrameRate;
+const WebRtc_UWord32 kMaxPayloadSize = 1440;
+// A stale or misplaced picture is some 20 levels off, far below this.
+const double kMinPsnr = 30.0;
+
+// Sets up codec for kNumberOfStreams streams, scaled by factors of two
+// from kWidth x kHeight.
+void SetUpCodec(VideoCodec* codec) {
+  memset(codec, 0, sizeof(*codec));
+  codec->codecType = kVideoCodecVP8;
+  codec->width = kWidth;
+  codec->height = kHeight;
+  codec->maxFramerate = kFrameRate;
+  codec->qpMax = 56;
+  codec->numberOfSimulcastStreams = kNumberOfStreams;
+  const unsigned int kMaxBitrates[kNumberOfStreams] = {150, 500, 1200};
+  for (int i = 0; i < kNumberOfStreams; ++i) {
+    const int shift = kNumberOfStreams - 1 - i;
+    codec->simulcastStream[i].width = kWidth >> shift;
+    codec->simulcastStream[i].height = kHeight >> shift;
+    codec->simulcastStream[i].maxBitrate = kMaxBitrates[i];
+    codec->simulcastStream[i].qpMax = 56;
+    codec->startBitrate += kMaxBitrates[i];
+  }
+  codec->maxBitrate = codec->startBitrate;
+}
+
+// Fills frame with a smooth pattern whose brightness changes with number,
+// so that a picture of another frame is easy to tell apart.
+void FillFrame(int number, VideoFrame* frame) {
+  ASSERT_EQ(0, frame->AllocatePlanes(kWidth, kHeight));
+  const int offset = 20 * (number % 4);
+  for (int y = 0; y < kHeight; ++y) {
+    WebRtc_UWord8* row = frame->Plane(kYPlane) + y * frame->Stride(kYPlane);
+    for (int x = 0; x < kWidth; ++x) {
+      row[x] = static_cast<WebRtc_UWord8>(
+          32 + offset + 64 * x / kWidth + 64 * y / kHeight);
+    }
+  }
+  for (int i = kUPlane; i <= kVPlane; ++i) {
+    for (int y = 0; y < kHeight / 2; ++y) {
+      memset(frame->Plane(i) + y * frame->Stride(i), 128, kWidth / 2);
+    }
+  }
+  frame->SetTimeStamp(number * kTimestampDelta);
+}
+
+void FramePlanes(const VideoFrame& frame, I420Planes* planes) {
+  for (int i = 0; i < kNumOfI420Planes; ++i) {
+    planes->plane[i] = frame.Plane(i);
+    planes->stride[i] = frame.Stride(i);
+  }
+  planes->width = frame.Width();
+  planes->height = frame.Height();
+}
+
+void FrameImage(const VideoFrame& frame, RawImage* image) {
+  for (int i = 0; i < kNumOfI420Planes; ++i) {
+    image->_planes[i] = frame.Plane(i);
+    image->_strides[i] = frame.Stride(i);
+  }
+  image->_width = frame.Width();
+  image->_height = frame.Height();
+  image->_timeStamp = frame.TimeStamp();
+}
+
+// Scales source to a new frame of width x height with the box filter.
+void ScaleFrame(const VideoFrame& source, int width, int height,
+                VideoFrame* scaled) {
+  ASSERT_EQ(0, scaled->AllocatePlanes(width, height));
+  Scaler scaler;
+  ASSERT_EQ(0, scaler.Set(source.Width(), source.Height(), width, height,
+                          kI420, kI420, kScaleBox));
+  I420Planes source_planes;
+  I420Planes scaled_planes;
+  FramePlanes(source, &source_planes);
+  FramePlanes(*scaled, &scaled_planes);
+  ASSERT_EQ(0, scaler.Scale(source_planes, scaled_planes));
+}
+
+struct EncodedFrame {
+  int simulcast_idx;
+  EncodedImage image;
+  std::vector<WebRtc_UWord8> payload;
+};
+
+// Keeps a copy of every encoded image, in the order they are delivered.
+class EncodedFrameCollector : public EncodedImageCallback {
+ public:
+  virtual WebRtc_Word32 Encoded(
+      EncodedImage& encoded_image,
+      const CodecSpecificInfo* codec_specific_info,
+      const RTPFragmentationHeader* /*fragmentation*/) {
+    EXPECT_TRUE(codec_specific_info != NULL);
+    EncodedFrame frame;
+    frame.simulcast_idx = codec_specific_info ?
+        codec_specific_info->codecSpecific.VP8.simulcastIdx : -1;
+    frame.image = encoded_image;
+    frame.payload.assign(encoded_image._buffer,
+                         encoded_image._buffer + encoded_image._length);
+    frames_.push_back(frame);
+    return 0;
+  }
+
+  std::vector<EncodedFrame>& frames() { return frames_; }
+
+ private:
+  std::vector<EncodedFrame> frames_;
+};
+
+// Keeps the luma plane of the last decoded picture.
+class DecodedFrameCollector : public DecodedImageCallback {
+ public:
+  DecodedFrameCollector() : width_(0), height_(0), timestamp_(0) {}
+
+  virtual WebRtc_Word32 Decoded(RawImage& decoded_image) {
+    width_ = decoded_image._width;
+    height_ = decoded_image._height;
+    timestamp_ = decoded_image._timeStamp;
+    luma_.assign(decoded_image._buffer,
+                 decoded_image._buffer + width_ * height_);
+    return 0;
+  }
+
+  // Returns the PSNR of the last luma plane against the one of reference.
+  double LumaPsnr(const VideoFrame& reference) const {
+    double sse = 0.0;
+    for (int y = 0; y < height_; ++y) {
+      const WebRtc_UWord8* row =
+          reference.Plane(kYPlane) + y * reference.Stride(kYPlane);
+      for (int x = 0; x < width_; ++x) {
+        const double diff = luma_[y * width_ + x] - row[x];
+        sse += diff * diff;
+      }
+    }
+    if (sse == 0.0) {
+      return 99.0;
+    }
+    return 10.0 * log10(255.0 * 255.0 * width_ * height_ / sse);
+  }
+
+  int width() const { return width_; }
+  int height() const { return height_; }
+  WebRtc_UWord32 timestamp() const { return timestamp_; }
+
+ private:
+  int width_;
+  int height_;
+  WebRtc_UWord32 timestamp_;
+  std::vector<WebRtc_UWord8> luma_;
+};
+
+void ExpectScaleSources(const VideoCodec& codec,
+                        const int expected_order[],
+                        const int expected_source[]) {
+  int order[kMaxSimulcastStreams];
+  int source[kMaxSimulcastStreams];
+  VP8SimulcastEncoder::SelectScaleSources(codec, order, source);
+  for (int i = 0; i < codec.numberOfSimulcastStreams; ++i) {
+    EXPECT_EQ(expected_order[i], order[i]) << "order " << i;
+    EXPECT_EQ(expected_source[i], source[i]) << "stream " << i;
+  }
+}
+
+}  // namespace
+
+TEST(VP8SimulcastScaleSourcesTest, ScalesFromTheSmallestLargerStream) {
+  VideoCodec codec;
+  SetUpCodec(&codec);
+  codec.width = 2 * kWidth;
+  codec.height = 2 * kHeight;
+  // Every stream is scaled from the next larger, the largest from the input.
+  const int kOrder[] = {2, 1, 0};
+  const int kSource[] = {1, 2, -1};
+  ExpectScaleSources(codec, kOrder, kSource);
+}
+
+TEST(VP8SimulcastScaleSourcesTest, InputSizedStreamIsNoSource) {
+  VideoCodec codec;
+  SetUpCodec(&codec);
+  // Stream 2 is encoded from the input, so stream 1 is scaled from the input
+  // as well.
+  const int kOrder[] = {2, 1, 0};
+  const int kSource[] = {1, -1, -1};
+  ExpectScaleSources(codec, kOrder, kSource);
+}
+
+TEST(VP8SimulcastScaleSourcesTest, SourceCoversBothDimensions) {
+  VideoCodec codec;
+  SetUpCodec(&codec);
+  codec.width = 640;
+  codec.height = 480;
+  // Stream 0 is smaller than stream 1 but taller, so both are scaled from
+  // stream 2.
+  codec.simulcastStream[0].width = 120;
+  codec.simulcastStream[0].height = 100;
+  codec.simulcastStream[1].width = 160;
+  codec.simulcastStream[1].height = 90;
+  codec.simulcastStream[2].width = 320;
+  codec.simulcastStream[2].height = 180;
+  const int kOrder[] = {2, 1, 0};
+  const int kSource[] = {2, 2, -1};
+  ExpectScaleSources(codec, kOrder, kSource);
+}
+
+TEST(VP8SimulcastScaleSourcesTest, OrdersStreamsByDecreasingSize) {
+  VideoCodec codec;
+  SetUpCodec(&codec);
+  codec.simulcastStream[0].width = kWidth / 2;
+  codec.simulcastStream[0].height = kHeight / 2;
+  codec.simulcastStream[1].width = kWidth;
+  codec.simulcastStream[1].height = kHeight;
+  codec.simulcastStream[2].width = kWidth / 4;
+  codec.simulcastStream[2].height = kHeight / 4;
+  const int kOrder[] = {1, 0, 2};
+  const int kSource[] = {-1, -1, 0};
+  ExpectScaleSources(codec, kOrder, kSource);
+}
+
+// Scaling through the pyramid differs from scaling the input directly by at
+// most one, for the box filter and factors of two.
+TEST(VP8SimulcastScaleSourcesTest, PyramidDiffersFromDirectScalingByOne) {
+  VideoFrame input;
+  ASSERT_EQ(0, input.AllocatePlanes(kWidth, kHeight));
+  srand(17);
+  for (int i = 0; i < kNumOfI420Planes; ++i) {
+    const int width = (i == kYPlane) ? kWidth : kWidth / 2;
+    const int height = (i == kYPlane) ? kHeight : kHeight / 2;
+    for (int y = 0; y < height; ++y) {
+      for (int x = 0; x < width; ++x) {
+        input.Plane(i)[y * input.Stride(i) + x] =
+            static_cast<WebRtc_UWord8>(rand() & 0xff);
+      }
+    }
+  }
+  VideoFrame half;
+  VideoFrame quarter_from_half;
+  VideoFrame quarter;
+  ScaleFrame(input, kWidth / 2, kHeight / 2, &half);
+  ScaleFrame(half, kWidth / 4, kHeight / 4, &quarter_from_half);
+  ScaleFrame(input, kWidth / 4, kHeight / 4, &quarter);
+
+  for (int i = 0; i < kNumOfI420Planes; ++i) {
+    const int width = (i == kYPlane) ? kWidth / 4 : kWidth / 8;
+    const int height = (i == kYPlane) ? kHeight / 4 : kHeight / 8;
+    for (int y = 0; y < height; ++y) {
+      for (int x = 0; x < width; ++x) {
+        const int diff =
+            quarter_from_half.Plane(i)[y * quarter_from_half.Stride(i) + x] -
+            quarter.Plane(i)[y * quarter.Stride(i) + x];
+        ASSERT_LE(abs(diff), 1) << "plane " << i << " (" << x << ", " << y
+                                << ")";
+      }
+    }
+  }
+}
+
+class VP8SimulcastEncoderTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    SetUpCodec(&codec_);
+    ASSERT_EQ(0, encoder_.RegisterEncodeCompleteCallback(&collector_));
+  }
+
+  virtual void TearDown() {
+    encoder_.Release();
+  }
+
+  // Encodes kNumberOfFrames frames, and checks that every stream decodes to
+  // the input scaled to the size of the stream.
+  void EncodeAndVerify(int number_of_cores) {
+    ASSERT_GE(encoder_.InitEncode(&codec_, number_of_cores, kMaxPayloadSize),
+              0);
+    VP8Decoder decoders[kNumberOfStreams];
+    DecodedFrameCollector decoded[kNumberOfStreams];
+    for (int i = 0; i < kNumberOfStreams; ++i) {
+      ASSERT_EQ(0, decoders[i].InitDecode(&codec_, 1));
+      ASSERT_EQ(0, decoders[i].RegisterDecodeCompleteCallback(&decoded[i]));
+    }
+
+    const VideoFrameType frame_types[kNumberOfStreams] = {
+      kDeltaFrame, kDeltaFrame, kDeltaFrame
+    };
+    for (int number = 0; number < kNumberOfFrames; ++number) {
+      VideoFrame frame;
+      FillFrame(number, &frame);
+      RawImage image;
+      FrameImage(frame, &image);
+      collector_.frames().clear();
+      ASSERT_EQ(0, encoder_.Encode(image, NULL, frame_types));
+
+      for (size_t k = 0; k < collector_.frames().size(); ++k) {
+        EncodedFrame& encoded = collector_.frames()[k];
+        const int i = encoded.simulcast_idx;
+        ASSERT_GE(i, 0);
+        ASSERT_LT(i, kNumberOfStreams);
+        encoded.image._buffer = &encoded.payload[0];
+        ASSERT_EQ(0, decoders[i].Decode(encoded.image, false, NULL, NULL, 0));
+        const int width = codec_.simulcastStream[i].width;
+        const int height = codec_.simulcastStream[i].height;
+        ASSERT_EQ(width, decoded[i].width());
+        ASSERT_EQ(height, decoded[i].height());
+        EXPECT_EQ(frame.TimeStamp(), decoded[i].timestamp());
+        VideoFrame reference;
+        ScaleFrame(frame, width, height, &reference);
+        EXPECT_GT(decoded[i].LumaPsnr(reference), kMinPsnr)
+            << "frame " << number << " stream " << i;
+      }
+    }
+  }
+
+  VideoCodec codec_;
+  VP8SimulcastEncoder encoder_;
+  EncodedFrameCollector collector_;
+};
+
+TEST_F(VP8SimulcastEncoderTest, EncodesStreamsOneAtATime) {
+  EncodeAndVerify(1);
+}
+
+// With a core per stream the smaller streams are encoded on the encode
+// threads, at the same time as the largest.
+TEST_F(VP8SimulcastEncoderTest, EncodesStreamsInParallel) {
+  EncodeAndVerify(kNumberOfStreams);
+}
+
+TEST_F(VP8SimulcastEncoderTest, DeliversStreamsInStreamOrder) {
+  ASSERT_GE(encoder_.InitEncode(&codec_, kNumberOfStreams, kMaxPayloadSize),
+            0);
+  const VideoFrameType frame_types[kNumberOfStreams] = {
+    kDeltaFrame, kDeltaFrame, kDeltaFrame
+  };
+  for (int number = 0; number < kNumberOfFrames; ++number) {
+    VideoFrame frame;
+    FillFrame(number, &frame);
+    RawImage image;
+    FrameImage(frame, &image);
+    collector_.frames().clear();
+    ASSERT_EQ(0, encoder_.Encode(image, NULL, frame_types));
+
+    const std::vector<EncodedFrame>& frames = collector_.frames();
+    if (number == 0) {
+      // Key frames are not dropped.
+      ASSERT_EQ(static_cast<size_t>(kNumberOfStreams), frames.size());
+    }
+    int last_idx = -1;
+    for (size_t k = 0; k < frames.size(); ++k) {
+      const int i = frames[k].simulcast_idx;
+      EXPECT_GT(i, last_idx);
+      last_idx = i;
+      EXPECT_EQ(codec_.simulcastStream[i].width,
+                frames[k].image._encodedWidth);
+      EXPECT_EQ(codec_.simulcastStream[i].height,
+                frames[k].image._encodedHeight);
+      EXPECT_EQ(frame.TimeStamp(), frames[k].image._timeStamp);
+      if (number == 0) {
+        EXPECT_EQ(kKeyFrame, frames[k].image._frameType);
+      }
+    }
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,209 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "decode_speed_test.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <iostream>
+#include <sstream>
+
+#include "cpu_info.h"
+#include "module_common_types.h"
+#include "testsupport/fileutils.h"
+#include "tick_util.h"
+
+using namespace webrtc;
+
+// Keeps a copy of every encoded frame, with its partition boundaries.
+class DecodeSpeedEncodeCallback : public EncodedImageCallback
+{
+public:
+    DecodeSpeedEncodeCallback(VP8DecodeSpeedTest& test) : _test(test) {}
+    virtual WebRtc_Word32 Encoded(EncodedImage& encodedImage,
+                                  const CodecSpecificInfo* codecSpecificInfo,
+                                  const RTPFragmentationHeader* fragmentation);
+private:
+    VP8DecodeSpeedTest& _test;
+};
+
+WebRtc_Word32
+DecodeSpeedEncodeCallback::Encoded(
+    EncodedImage& encodedImage,
+    const CodecSpecificInfo* /*codecSpecificInfo*/,
+    const RTPFragmentationHeader* fragmentation)
+{
+    EncodedImage* frame = new EncodedImage(encodedImage);
+    frame->_buffer = new WebRtc_UWord8[encodedImage._length];
+    frame->_size = encodedImage._length;
+    memcpy(frame->_buffer, encodedImage._buffer, encodedImage._length);
+    _test._frames.push_back(frame);
+
+    RTPFragmentationHeader* copy = new RTPFragmentationHeader;
+    if (fragmentation != NULL)
+    {
+        *copy = *fragmentation;
+    }
+    _test._fragmentations.push_back(copy);
+    return 0;
+}
+
+// Throws the decoded frames away.
+class DecodeSpeedDecodeCallback : public DecodedImageCallback
+{
+public:
+    virtual WebRtc_Word32 Decoded(RawImage& /*decodedImage*/) { return 0; }
+};
+
+VP8DecodeSpeedTest::VP8DecodeSpeedTest()
+:
+Test("VP8 Decode Speed Test", "Decode speed at 720p and 1080p", 2000)
+{
+}
+
+VP8DecodeSpeedTest::~VP8DecodeSpeedTest()
+{
+    ClearFrames();
+}
+
+void
+VP8DecodeSpeedTest::Perform()
+{
+    const VideoSource source(webrtc::test::ProjectRootPath() +
+                             "resources/foreman_cif.yuv", kCIF);
+    const VideoSize sizes[] = {kWHD, kWFullHD};
+    const int bitRates[] = {2000, 4000};
+    const int maxCores = CpuInfo::DetectNumberOfCores();
+
+    for (int i = 0; i < static_cast<int>(sizeof(sizes)/sizeof(*sizes)); i++)
+    {
+        const std::string fileName = source.GetFilePath() + "/" +
+            source.GetName() + "_" + VideoSource::GetSizeString(sizes[i]) +
+            "_30.yuv";
+        const VideoSource target(fileName, sizes[i], 30);
+        source.Convert(target);
+        _inname = fileName;
+
+        CodecSettings(target.GetWidth(), target.GetHeight(), 30, bitRates[i]);
+        EncodeSequence();
+
+        // Powers of two, and all cores.
+        for (int cores = 1; ; cores = (2 * cores < maxCores) ? 2 * cores :
+                                                                maxCores)
+        {
+            const double fps = DecodeSequence(cores);
+            std::stringstream ss;
+            ss << VideoSource::GetSizeString(sizes[i]) << ", " << cores
+                << " core(s): " << fps << " fps";
+            std::cout << ss.str() << std::endl;
+            _results.push_back(ss.str());
+            if (cores >= maxCores)
+            {
+                break;
+            }
+        }
+        ClearFrames();
+    }
+}
+
+void
+VP8DecodeSpeedTest::Print()
+{
+    std::cout << "VP8 Decode Speed Test completed!" << std::endl;
+    (*_log) << "VP8 Decode Speed Test" << std::endl;
+    for (size_t i = 0; i < _results.size(); i++)
+    {
+        (*_log) << _results[i] << std::endl;
+    }
+    (*_log) << std::endl;
+}
+
+void
+VP8DecodeSpeedTest::EncodeSequence()
+{
+    Setup();
+    FILE* sourceFile = fopen(_inname.c_str(), "rb");
+    if (sourceFile == NULL)
+    {
+        fprintf(stderr, "Cannot open %s\n", _inname.c_str());
+        exit(EXIT_FAILURE);
+    }
+
+    // The encoder uses token partitions for these sizes, regardless of how
+    // many cores it is given itself.
+    const int numberOfCores = CpuInfo::DetectNumberOfCores();
+    if (_encoder->InitEncode(&_inst, numberOfCores, 1440) < 0)
+    {
+        exit(EXIT_FAILURE);
+    }
+    DecodeSpeedEncodeCallback encodeCallback(*this);
+    _encoder->RegisterEncodeCompleteCallback(&encodeCallback);
+
+    RawImage image(_sourceBuffer, _lengthSourceFrame, _lengthSourceFrame);
+    image._width = _inst.width;
+    image._height = _inst.height;
+    while (fread(_sourceBuffer, 1, _lengthSourceFrame, sourceFile) ==
+           _lengthSourceFrame)
+    {
+        VideoFrameType frameType = _frames.empty() ? kKeyFrame : kDeltaFrame;
+        if (_encoder->Encode(image, NULL, &frameType) < 0)
+        {
+            exit(EXIT_FAILURE);
+        }
+        image._timeStamp += 90000 / _inst.maxFramerate;
+    }
+    _encoder->Release();
+    fclose(sourceFile);
+    Teardown();
+}
+
+double
+VP8DecodeSpeedTest::DecodeSequence(int numberOfCores)
+{
+    DecodeSpeedDecodeCallback decodeCallback;
+    if (_decoder->InitDecode(&_inst, numberOfCores) < 0)
+    {
+        exit(EXIT_FAILURE);
+    }
+    _decoder->RegisterDecodeCompleteCallback(&decodeCallback);
+
+    const TickTime startTime = TickTime::Now();
+    for (size_t i = 0; i < _frames.size(); i++)
+    {
+        if (_decoder->Decode(*_frames[i], false, _fragmentations[i], NULL,
+                             0) < 0)
+        {
+            exit(EXIT_FAILURE);
+        }
+    }
+    const WebRtc_Word64 elapsedUs =
+        (TickTime::Now() - startTime).Microseconds();
+    _decoder->Release();
+
+    if (elapsedUs <= 0)
+    {
+        return 0.0;
+    }
+    return _frames.size() * 1000000.0 / elapsedUs;
+}
+
+void
+VP8DecodeSpeedTest::ClearFrames()
+{
+    for (size_t i = 0; i < _frames.size(); i++)
+    {
+        delete [] _frames[i]->_buffer;
+        delete _frames[i];
+        delete _fragmentations[i];
+    }
+    _frames.clear();
+    _fragmentations.clear();
+}
@@ -0,0 +1,43 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_VIDEO_CODING_CODECS_VP8_DECODE_SPEED_TEST_H_
+#define WEBRTC_MODULES_VIDEO_CODING_CODECS_VP8_DECODE_SPEED_TEST_H_
+
+#include <vector>
+
+#include "../../../test_framework/test.h"
+#include "../../../test_framework/video_source.h"
+
+// Encodes a sequence at 720p and 1080p once, then measures the decode
+// speed in frames per second with an increasing number of decoder cores.
+class VP8DecodeSpeedTest : public Test
+{
+public:
+    VP8DecodeSpeedTest();
+    virtual ~VP8DecodeSpeedTest();
+    virtual void Perform();
+    virtual void Print();
+
+protected:
+    // Encodes all frames of _inname and keeps them in _frames.
+    void EncodeSequence();
+    // Decodes all of _frames with numberOfCores and returns the speed [fps].
+    double DecodeSequence(int numberOfCores);
+    void ClearFrames();
+
+    std::vector<webrtc::EncodedImage*>           _frames;
+    std::vector<webrtc::RTPFragmentationHeader*> _fragmentations;
+    std::vector<std::string>                     _results;
+
+    friend class DecodeSpeedEncodeCallback;
+};
+
+#endif // WEBRTC_MODULES_VIDEO_CODING_CODECS_VP8_DECODE_SPEED_TEST_H_
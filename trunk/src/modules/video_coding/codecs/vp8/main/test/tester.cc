@@ -13,6 +13,7 @@
 #include <vector>
 
 #include "benchmark.h"
+#include "decode_speed_test.h"
 #include "dual_decoder_test.h"
 #include "normal_async_test.h"
 #include "packet_loss_test.h"
@@ -29,6 +30,7 @@ void PopulateTests(std::vector<Test*>* tests)
 //    tests->push_back(new VP8UnitTest());
 //    tests->push_back(new VP8DualDecoderTest());
 //    tests->push_back(new VP8Benchmark());
+//    tests->push_back(new VP8DecodeSpeedTest());
 //    tests->push_back(new VP8PacketLossTest(0.05, false, 5));
     tests->push_back(new VP8NormalAsyncTest());
 }
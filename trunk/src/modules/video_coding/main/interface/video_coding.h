@@ -18,6 +18,7 @@
 namespace webrtc
 {
 
+class Clock;
 class VideoEncoder;
 class VideoDecoder;
 struct CodecSpecificInfo;
@@ -27,6 +28,13 @@ class VideoCodingModule : public Module
 public:
     static VideoCodingModule* Create(const WebRtc_Word32 id);
 
+    // Creates a module that reads all its times from |clock|, e.g. a
+    // SimulatedClock when replaying a recorded stream. The clock must outlive
+    // the module. Decode() still waits on events for up to |maxWaitTimeMs|,
+    // so when running on a simulated clock it should be called with a max
+    // wait time of zero.
+    static VideoCodingModule* Create(const WebRtc_Word32 id, Clock* clock);
+
     static void Destroy(VideoCodingModule* module);
 
     // Get number of supported codecs
@@ -338,6 +346,17 @@ public:
     virtual WebRtc_Word32 RegisterReceiveStatisticsCallback(
                                VCMReceiveStatisticsCallback* receiveStats) = 0;
 
+    // Register a receive latency callback which will be called for every decoded frame
+    // with the time it spent in the jitter buffer and in the decoder.
+    //
+    // Input:
+    //      - latencyCallback : The callback object to register.
+    //
+    // Return value      : VCM_OK, on success.
+    //                     < 0,         on error.
+    virtual WebRtc_Word32 RegisterReceiveLatencyCallback(
+                               VCMReceiveLatencyCallback* latencyCallback) = 0;
+
     // Register a frame type request callback. This callback will be called when the
     // module needs to request specific frame types from the send side.
     //
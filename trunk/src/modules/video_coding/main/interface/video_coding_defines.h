@@ -111,6 +111,10 @@ class VCMReceiveCallback
 public:
     virtual WebRtc_Word32 FrameToRender(VideoFrame& videoFrame) = 0;
     virtual WebRtc_Word32 ReceivedDecodedReferenceFrame(const WebRtc_UWord64 pictureId) {return -1;}
+    // Return true to let FrameToRender() get frames that reference the
+    // decoder's picture (see VideoFrame::SetPlanes()) instead of a packed
+    // buffer. Such frames are only valid during the call.
+    virtual bool AcceptsFramePlanes() const {return false;}
 
 protected:
     virtual ~VCMReceiveCallback() {}
@@ -139,6 +143,20 @@ protected:
     virtual ~VCMReceiveStatisticsCallback() {}
 };
 
+// Callback class used for informing the user of how long each decoded frame waited
+// in the jitter buffer and how long it took to decode.
+class VCMReceiveLatencyCallback
+{
+public:
+    // |jitterBufferMs| is the time from the arrival of the last packet of the frame
+    // until decoding started, or -1 if the frame did not pass the jitter buffer.
+    virtual void FrameLatency(const WebRtc_Word32 jitterBufferMs,
+                              const WebRtc_Word32 decodeMs) = 0;
+
+protected:
+    virtual ~VCMReceiveLatencyCallback() {}
+};
+
 // Callback class used for telling the user about the requested amount of
 // bit stream protection: FEC rate for key and delta frame;
 // whether the FEC uses unequal protection (UEP) across packets,
@@ -35,6 +35,7 @@ LOCAL_SRC_FILES := \
     jitter_estimator.cc \
     media_opt_util.cc \
     media_optimization.cc \
+    nack_tracker.cc \
     packet.cc \
     qm_select.cc \
     receiver.cc \
@@ -0,0 +1,119 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <cstring>
+
+#include "gtest/gtest.h"
+#include "modules/video_coding/codecs/vp8/main/interface/vp8.h"
+#include "modules/video_coding/main/interface/video_coding_defines.h"
+#include "modules/video_coding/main/source/codec_database.h"
+#include "modules/video_coding/main/source/encoded_frame.h"
+#include "modules/video_coding/main/source/generic_decoder.h"
+#include "modules/video_coding/main/source/timing.h"
+#include "system_wrappers/interface/clock.h"
+
+namespace webrtc {
+
+namespace {
+
+const int kWidth = 176;
+const int kHeight = 144;
+
+// Keeps a copy of the last encoded image.
+class EncodedImageKeeper : public EncodedImageCallback {
+ public:
+  EncodedImageKeeper() : buffer_(NULL) {}
+  ~EncodedImageKeeper() { delete [] buffer_; }
+
+  virtual WebRtc_Word32 Encoded(
+      EncodedImage& encoded_image,
+      const CodecSpecificInfo* /*codec_specific_info*/,
+      const RTPFragmentationHeader* /*fragmentation*/) {
+    delete [] buffer_;
+    buffer_ = new WebRtc_UWord8[encoded_image._length];
+    memcpy(buffer_, encoded_image._buffer, encoded_image._length);
+    image_ = encoded_image;
+    image_._buffer = buffer_;
+    image_._size = encoded_image._length;
+    return 0;
+  }
+
+  const EncodedImage& image() const { return image_; }
+
+ private:
+  WebRtc_UWord8* buffer_;
+  EncodedImage image_;
+};
+
+}  // namespace
+
+class TestCodecDataBase : public ::testing::Test {
+ protected:
+  TestCodecDataBase()
+      : clock_(0),
+        timing_(&clock_),
+        callback_(timing_, &clock_),
+        codec_data_base_(0) {}
+
+  virtual void SetUp() {
+    ASSERT_EQ(VCM_OK, VCMCodecDataBase::Codec(kVideoCodecVP8, &codec_));
+    codec_.width = kWidth;
+    codec_.height = kHeight;
+  }
+
+  // Encodes a gray key frame into |keeper_|.
+  void EncodeKeyFrame() {
+    VP8Encoder encoder;
+    ASSERT_EQ(WEBRTC_VIDEO_CODEC_OK, encoder.InitEncode(&codec_, 1, 1440));
+    ASSERT_EQ(WEBRTC_VIDEO_CODEC_OK,
+              encoder.RegisterEncodeCompleteCallback(&keeper_));
+    const WebRtc_UWord32 length = kWidth * kHeight * 3 / 2;
+    WebRtc_UWord8* buffer = new WebRtc_UWord8[length];
+    memset(buffer, 128, length);
+    RawImage image(buffer, length, length);
+    image._width = kWidth;
+    image._height = kHeight;
+    image._timeStamp = 90000;
+    const VideoFrameType frame_type = kKeyFrame;
+    EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK, encoder.Encode(image, NULL, &frame_type));
+    delete [] buffer;
+    encoder.Release();
+    ASSERT_EQ(kKeyFrame, keeper_.image()._frameType);
+  }
+
+  SimulatedClock clock_;
+  VCMTiming timing_;
+  VCMDecodedFrameCallback callback_;
+  VCMCodecDataBase codec_data_base_;
+  VideoCodec codec_;
+  EncodedImageKeeper keeper_;
+};
+
+// The decoder lends its planes to the VCM callback, and must still be
+// possible to copy for the dual decoder.
+TEST_F(TestCodecDataBase, CreatesDecoderCopyAfterDecode) {
+  ASSERT_EQ(VCM_OK, codec_data_base_.RegisterReceiveCodec(&codec_, 1, false));
+  VCMGenericDecoder* decoder =
+      codec_data_base_.SetDecoder(codec_.plType, callback_);
+  ASSERT_TRUE(decoder != NULL);
+  // Nothing to copy before the first decode.
+  EXPECT_TRUE(codec_data_base_.CreateDecoderCopy() == NULL);
+
+  EncodeKeyFrame();
+  VCMEncodedFrame frame(keeper_.image());
+  ASSERT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            decoder->Decode(frame, clock_.TimeInMilliseconds()));
+
+  VCMGenericDecoder* decoder_copy = codec_data_base_.CreateDecoderCopy();
+  ASSERT_TRUE(decoder_copy != NULL);
+  codec_data_base_.ReleaseDecoder(decoder_copy);
+}
+
+}  // namespace webrtc
@@ -44,6 +44,7 @@ _fragmentation()
     {
         VerifyAndAllocate(rhs._length);
         memcpy(_buffer, rhs._buffer, rhs._length);
+        _length = rhs._length;
     }
 }
 
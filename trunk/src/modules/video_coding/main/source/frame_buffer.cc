@@ -232,6 +232,12 @@ VCMFrameBuffer::ZeroOutSeqNumHybrid(WebRtc_Word32* list,
     return _sessionInfo.ZeroOutSeqNumHybrid(list, num, rttMs);
 }
 
+void
+VCMFrameBuffer::ExcludeFromNack(VCMNackTracker* nackTracker) const
+{
+    _sessionInfo.ExcludeFromNack(nackTracker);
+}
+
 void
 VCMFrameBuffer::IncrementNackCount()
 {
@@ -22,6 +22,8 @@
 namespace webrtc
 {
 
+class VCMNackTracker;
+
 class VCMFrameBuffer : public VCMEncodedFrame
 {
 public:
@@ -73,6 +75,9 @@ public:
     WebRtc_Word32 ZeroOutSeqNumHybrid(WebRtc_Word32* list,
                                       WebRtc_Word32 num,
                                       WebRtc_UWord32 rttMs);
+    // Hybrid extension: exclude the packets which are not worth a
+    // retransmission from the NACK list
+    void ExcludeFromNack(VCMNackTracker* nackTracker) const;
     void IncrementNackCount();
     WebRtc_Word16 GetNackCount() const;
 
@@ -12,15 +12,18 @@
 #include "trace.h"
 #include "generic_decoder.h"
 #include "internal_defines.h"
-#include "tick_time.h"
+#include "clock.h"
 
 namespace webrtc {
 
-VCMDecodedFrameCallback::VCMDecodedFrameCallback(VCMTiming& timing)
+VCMDecodedFrameCallback::VCMDecodedFrameCallback(VCMTiming& timing,
+                                                 Clock* clock)
 :
 _critSect(CriticalSectionWrapper::CreateCriticalSection()),
 _receiveCallback(NULL),
+_latencyCallback(NULL),
 _timing(timing),
+_clock(clock),
 _timestampMap(kDecoderFrameMemoryLength)
 {
 }
@@ -37,6 +40,13 @@ void VCMDecodedFrameCallback::SetUserReceiveCallback(
     _receiveCallback = receiveCallback;
 }
 
+void VCMDecodedFrameCallback::SetLatencyCallback(
+    VCMReceiveLatencyCallback* latencyCallback)
+{
+    CriticalSectionScoped cs(_critSect);
+    _latencyCallback = latencyCallback;
+}
+
 WebRtc_Word32 VCMDecodedFrameCallback::Decoded(RawImage& decodedImage)
 {
     // TODO(holmer): We should improve this so that we can handle multiple
@@ -47,21 +57,51 @@ WebRtc_Word32 VCMDecodedFrameCallback::Decoded(RawImage& decodedImage)
     if (frameInfo == NULL)
     {
         // The map should never be empty or full if this callback is called.
+        if (decodedImage._releaseCallback != NULL)
+        {
+            decodedImage._releaseCallback->ReleasePlanes();
+        }
         return WEBRTC_VIDEO_CODEC_ERROR;
     }
 
+    const WebRtc_Word64 nowMs = _clock->TimeInMilliseconds();
     _timing.StopDecodeTimer(
         decodedImage._timeStamp,
         frameInfo->decodeStartTimeMs,
-        VCMTickTime::MillisecondTimestamp());
+        nowMs);
+
+    if (_latencyCallback != NULL)
+    {
+        const WebRtc_Word32 jitterBufferMs = (frameInfo->lastPacketTimeMs < 0) ?
+            -1 : static_cast<WebRtc_Word32>(frameInfo->decodeStartTimeMs -
+                                             frameInfo->lastPacketTimeMs);
+        _latencyCallback->FrameLatency(
+            jitterBufferMs,
+            static_cast<WebRtc_Word32>(nowMs - frameInfo->decodeStartTimeMs));
+    }
 
     if (_receiveCallback != NULL)
     {
-        _frame.Swap(decodedImage._buffer,
-                    decodedImage._length,
-                    decodedImage._size);
-        _frame.SetWidth(decodedImage._width);
-        _frame.SetHeight(decodedImage._height);
+        if (decodedImage._planes[0] != NULL)
+        {
+            // Wrap the planes of the decoder. Whoever keeps the frame beyond
+            // FrameToRender() copies it.
+            _frame.SetPlanes(decodedImage._planes, decodedImage._strides,
+                             decodedImage._width, decodedImage._height,
+                             decodedImage._releaseCallback);
+            if (!_receiveCallback->AcceptsFramePlanes())
+            {
+                _frame.Materialize();
+            }
+        }
+        else
+        {
+            _frame.Swap(decodedImage._buffer,
+                        decodedImage._length,
+                        decodedImage._size);
+            _frame.SetWidth(decodedImage._width);
+            _frame.SetHeight(decodedImage._height);
+        }
         _frame.SetTimeStamp(decodedImage._timeStamp);
         _frame.SetRenderTime(frameInfo->renderTimeMs);
         // Convert raw image to video frame
@@ -73,6 +113,11 @@ WebRtc_Word32 VCMDecodedFrameCallback::Decoded(RawImage& decodedImage)
                          -1,
                          "Render callback returned error: %d", callbackReturn);
         }
+        _frame.ReleasePlanes();
+    }
+    else if (decodedImage._releaseCallback != NULL)
+    {
+        decodedImage._releaseCallback->ReleasePlanes();
     }
     return WEBRTC_VIDEO_CODEC_OK;
 }
@@ -146,7 +191,9 @@ WebRtc_Word32 VCMGenericDecoder::InitDecode(const VideoCodec* settings,
     return _decoder.InitDecode(settings, numberOfCores);
 }
 
-WebRtc_Word32 VCMGenericDecoder::Decode(const VCMEncodedFrame& frame)
+WebRtc_Word32 VCMGenericDecoder::Decode(const VCMEncodedFrame& frame,
+                                        WebRtc_Word64 nowMs,
+                                        WebRtc_Word64 lastPacketTimeMs)
 {
     if (_requireKeyFrame &&
         !_keyFrameDecoded &&
@@ -157,7 +204,8 @@ WebRtc_Word32 VCMGenericDecoder::Decode(const VCMEncodedFrame& frame)
         // before we can decode delta frames.
         return VCM_CODEC_ERROR;
     }
-    _frameInfos[_nextFrameInfoIdx].decodeStartTimeMs = VCMTickTime::MillisecondTimestamp();
+    _frameInfos[_nextFrameInfoIdx].decodeStartTimeMs = nowMs;
+    _frameInfos[_nextFrameInfoIdx].lastPacketTimeMs = lastPacketTimeMs;
     _frameInfos[_nextFrameInfoIdx].renderTimeMs = frame.RenderTimeMs();
     _callback->Map(frame.TimeStamp(), &_frameInfos[_nextFrameInfoIdx]);
 
@@ -20,6 +20,7 @@
 namespace webrtc
 {
 
+class Clock;
 class VCMReceiveCallback;
 
 enum { kDecoderFrameMemoryLength = 10 };
@@ -28,17 +29,22 @@ struct VCMFrameInformation
 {
     WebRtc_Word64     renderTimeMs;
     WebRtc_Word64     decodeStartTimeMs;
+    WebRtc_Word64     lastPacketTimeMs;
     void*             userData;
 };
 
 class VCMDecodedFrameCallback : public DecodedImageCallback
 {
 public:
-    VCMDecodedFrameCallback(VCMTiming& timing);
+    VCMDecodedFrameCallback(VCMTiming& timing, Clock* clock);
     virtual ~VCMDecodedFrameCallback();
     void SetUserReceiveCallback(VCMReceiveCallback* receiveCallback);
+    void SetLatencyCallback(VCMReceiveLatencyCallback* latencyCallback);
 
     virtual WebRtc_Word32 Decoded(RawImage& decodedImage);
+    // Decoded pictures are handed to the receive callback by reference, and
+    // released when it returns.
+    virtual bool AcceptsImagePlanes() const {return true;}
     virtual WebRtc_Word32 ReceivedDecodedReferenceFrame(const WebRtc_UWord64 pictureId);
     virtual WebRtc_Word32 ReceivedDecodedFrame(const WebRtc_UWord64 pictureId);
 
@@ -51,7 +57,9 @@ private:
     CriticalSectionWrapper* _critSect;
     VideoFrame _frame;
     VCMReceiveCallback* _receiveCallback;
+    VCMReceiveLatencyCallback* _latencyCallback;
     VCMTiming& _timing;
+    Clock* _clock;
     VCMTimestampMap _timestampMap;
     WebRtc_UWord64 _lastReceivedPictureID;
 };
@@ -75,8 +83,12 @@ public:
     *	Decode to a raw I420 frame,
     *
     *	inputVideoBuffer	reference to encoded video frame
+    *	nowMs				time at which decoding starts
+    *	lastPacketTimeMs	arrival time of the last packet of the frame, or -1
     */
-    WebRtc_Word32 Decode(const VCMEncodedFrame& inputFrame);
+    WebRtc_Word32 Decode(const VCMEncodedFrame& inputFrame,
+                         WebRtc_Word64 nowMs,
+                         WebRtc_Word64 lastPacketTimeMs = -1);
 
     /**
     *	Free the decoder memory
@@ -73,6 +73,27 @@ VCMGenericEncoder::Encode(const VideoFrame& inputFrame,
     RawImage rawImage(inputFrame.Buffer(),
                       inputFrame.Length(),
                       inputFrame.Size());
+    if (inputFrame.HasPlanes())
+    {
+        if (_encoder.AcceptsImagePlanes())
+        {
+            for (int plane = 0; plane < 3; plane++)
+            {
+                rawImage._planes[plane] = inputFrame.Plane(plane);
+                rawImage._strides[plane] = inputFrame.Stride(plane);
+            }
+        }
+        else
+        {
+            if (_packedFrame.CopyFrame(inputFrame) != 0)
+            {
+                return VCM_MEMORY;
+            }
+            rawImage._buffer = _packedFrame.Buffer();
+            rawImage._length = _packedFrame.Length();
+            rawImage._size = _packedFrame.Size();
+        }
+    }
     rawImage._width     = inputFrame.Width();
     rawImage._height    = inputFrame.Height();
     rawImage._timeStamp = inputFrame.TimeStamp();
@@ -140,6 +140,8 @@ private:
     WebRtc_UWord32              _bitRate;
     WebRtc_UWord32              _frameRate;
     bool                        _internalSource;
+    // Packed copy of input frames for encoders that don't accept strides.
+    VideoFrame                  _packedFrame;
 }; // end of VCMGenericEncoder class
 
 } // namespace webrtc
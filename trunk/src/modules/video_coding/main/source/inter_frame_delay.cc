@@ -9,11 +9,13 @@
  */
 
 #include "inter_frame_delay.h"
-#include "tick_time.h"
+#include "clock.h"
 
 namespace webrtc {
 
-VCMInterFrameDelay::VCMInterFrameDelay()
+VCMInterFrameDelay::VCMInterFrameDelay(Clock* clock)
+:
+_clock(clock)
 {
     Reset();
 }
@@ -22,7 +24,7 @@ VCMInterFrameDelay::VCMInterFrameDelay()
 void
 VCMInterFrameDelay::Reset()
 {
-    _zeroWallClock = VCMTickTime::MillisecondTimestamp();
+    _zeroWallClock = _clock->TimeInMilliseconds();
     _wrapArounds = 0;
     _prevWallClock = 0;
     _prevTimestamp = 0;
@@ -38,7 +40,7 @@ VCMInterFrameDelay::CalculateDelay(WebRtc_UWord32 timestamp,
 {
     if (currentWallClock <= -1)
     {
-        currentWallClock = VCMTickTime::MillisecondTimestamp();
+        currentWallClock = _clock->TimeInMilliseconds();
     }
 
     if (_prevWallClock == 0)
@@ -16,10 +16,12 @@
 namespace webrtc
 {
 
+class Clock;
+
 class VCMInterFrameDelay
 {
 public:
-    VCMInterFrameDelay();
+    VCMInterFrameDelay(Clock* clock);
 
     // Resets the estimate. Zeros are given as parameters.
     void Reset();
@@ -51,6 +53,7 @@ private:
     //          - timestmap         : RTP timestamp of the current frame.
     void CheckForWrapArounds(WebRtc_UWord32 timestamp);
 
+    Clock*                _clock;
     WebRtc_Word64         _zeroWallClock; // Local timestamp of the first video packet received
     WebRtc_Word32         _wrapArounds;   // Number of wrapArounds detected
     // The previous timestamp passed to the delay estimate
@@ -8,6 +8,7 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include "clock.h"
 #include "critical_section_wrapper.h"
 
 #include "frame_buffer.h"
@@ -20,7 +21,6 @@
 
 #include "event.h"
 #include "trace.h"
-#include "tick_time.h"
 #include "list_wrapper.h"
 
 #include <cassert>
@@ -57,8 +57,11 @@ VCMJitterBuffer::CompleteDecodableKeyFrameCriteria(VCMFrameBuffer* frame,
 }
 
 // Constructor
-VCMJitterBuffer::VCMJitterBuffer(WebRtc_Word32 vcmId, WebRtc_Word32 receiverId,
+VCMJitterBuffer::VCMJitterBuffer(Clock* clock,
+                                 WebRtc_Word32 vcmId,
+                                 WebRtc_Word32 receiverId,
                                  bool master) :
+    _clock(clock),
     _vcmId(vcmId),
     _receiverId(receiverId),
     _running(false),
@@ -81,18 +84,18 @@ VCMJitterBuffer::VCMJitterBuffer(WebRtc_Word32 vcmId, WebRtc_Word32 receiverId,
     _numConsecutiveOldPackets(0),
     _discardedPackets(0),
     _jitterEstimate(vcmId, receiverId),
+    _delayEstimate(clock),
     _rttMs(0),
     _nackMode(kNoNack),
     _lowRttNackThresholdMs(-1),
     _highRttNackThresholdMs(-1),
+    _nackTracker(),
     _NACKSeqNum(),
-    _NACKSeqNumLength(0),
     _waitingForKeyFrame(false),
     _firstPacket(true)
 {
     memset(_frameBuffers, 0, sizeof(_frameBuffers));
     memset(_receiveStatistics, 0, sizeof(_receiveStatistics));
-    memset(_NACKSeqNumInternal, -1, sizeof(_NACKSeqNumInternal));
 
     for (int i = 0; i< kStartNumberOfFrames; i++)
     {
@@ -138,15 +141,13 @@ VCMJitterBuffer::CopyFrom(const VCMJitterBuffer& rhs)
         _delayEstimate = rhs._delayEstimate;
         _waitingForCompletion = rhs._waitingForCompletion;
         _rttMs = rhs._rttMs;
-        _NACKSeqNumLength = rhs._NACKSeqNumLength;
+        _nackTracker = rhs._nackTracker;
         _waitingForKeyFrame = rhs._waitingForKeyFrame;
         _firstPacket = rhs._firstPacket;
         _lastDecodedState =  rhs._lastDecodedState;
         _packetsNotDecodable = rhs._packetsNotDecodable;
         memcpy(_receiveStatistics, rhs._receiveStatistics,
                sizeof(_receiveStatistics));
-        memcpy(_NACKSeqNumInternal, rhs._NACKSeqNumInternal,
-               sizeof(_NACKSeqNumInternal));
         memcpy(_NACKSeqNum, rhs._NACKSeqNum, sizeof(_NACKSeqNum));
         for (int i = 0; i < kMaxNumberOfFrames; i++)
         {
@@ -180,7 +181,7 @@ VCMJitterBuffer::Start()
     _incomingFrameCount = 0;
     _incomingFrameRate = 0;
     _incomingBitCount = 0;
-    _timeLastIncomingFrameCount = VCMTickTime::MillisecondTimestamp();
+    _timeLastIncomingFrameCount = _clock->TimeInMilliseconds();
     memset(_receiveStatistics, 0, sizeof(_receiveStatistics));
 
     _numConsecutiveOldFrames = 0;
@@ -193,7 +194,7 @@ VCMJitterBuffer::Start()
     _waitingForCompletion.timestamp = 0;
     _waitingForCompletion.latestPacketTime = -1;
     _firstPacket = true;
-    _NACKSeqNumLength = 0;
+    _nackTracker.Reset();
     _waitingForKeyFrame = false;
     _rttMs = 0;
     _packetsNotDecodable = 0;
@@ -210,6 +211,7 @@ VCMJitterBuffer::Stop()
     _critSect->Enter();
     _running = false;
     _lastDecodedState.Reset();
+    _nackTracker.Reset();
     _frameBuffersTSOrder.Flush();
     for (int i = 0; i < kMaxNumberOfFrames; i++)
     {
@@ -270,7 +272,7 @@ VCMJitterBuffer::FlushInternal()
 
     _firstPacket = true;
 
-    _NACKSeqNumLength = 0;
+    _nackTracker.Reset();
 
     WEBRTC_TRACE(webrtc::kTraceDebug, webrtc::kTraceVideoCoding, VCMId(_vcmId,
                  _receiverId), "JB(0x%x): Jitter buffer: flush", this);
@@ -602,7 +604,7 @@ WebRtc_Word32
 VCMJitterBuffer::GetUpdate(WebRtc_UWord32& frameRate, WebRtc_UWord32& bitRate)
 {
     CriticalSectionScoped cs(_critSect);
-    const WebRtc_Word64 now = VCMTickTime::MillisecondTimestamp();
+    const WebRtc_Word64 now = _clock->TimeInMilliseconds();
     WebRtc_Word64 diff = now - _timeLastIncomingFrameCount;
     if (diff < 1000 && _incomingFrameRate > 0 && _incomingBitRate > 0)
     {
@@ -657,7 +659,7 @@ VCMJitterBuffer::GetUpdate(WebRtc_UWord32& frameRate, WebRtc_UWord32& bitRate)
     else
     {
         // No frames since last call
-        _timeLastIncomingFrameCount = VCMTickTime::MillisecondTimestamp();
+        _timeLastIncomingFrameCount = _clock->TimeInMilliseconds();
         frameRate = 0;
         bitRate = 0;
         _incomingBitRate = 0;
@@ -698,7 +700,7 @@ VCMJitterBuffer::GetCompleteFrameForDecoding(WebRtc_UWord32 maxWaitTimeMS)
             _critSect->Leave();
             return NULL;
         }
-        const WebRtc_Word64 endWaitTimeMs = VCMTickTime::MillisecondTimestamp()
+        const WebRtc_Word64 endWaitTimeMs = _clock->TimeInMilliseconds()
                                             + maxWaitTimeMS;
         WebRtc_Word64 waitTimeMs = maxWaitTimeMS;
         while (waitTimeMs > 0)
@@ -727,7 +729,7 @@ VCMJitterBuffer::GetCompleteFrameForDecoding(WebRtc_UWord32 maxWaitTimeMS)
                 if (oldestFrame == NULL)
                 {
                     waitTimeMs = endWaitTimeMs -
-                                 VCMTickTime::MillisecondTimestamp();
+                                 _clock->TimeInMilliseconds();
                 }
                 else
                 {
@@ -1237,7 +1239,6 @@ VCMJitterBuffer::CreateNackList(WebRtc_UWord16& nackSize, bool& listExtended)
 {
     // TODO (mikhal/stefan): Refactor to use lastDecodedState.
     CriticalSectionScoped cs(_critSect);
-    int i = 0;
     WebRtc_Word32 lowSeqNum = -1;
     WebRtc_Word32 highSeqNum = -1;
     listExtended = false;
@@ -1363,120 +1364,13 @@ VCMJitterBuffer::CreateNackList(WebRtc_UWord16& nackSize, bool& listExtended)
         return NULL;
     }
 
-    WebRtc_UWord16 seqNumberIterator = (WebRtc_UWord16)(lowSeqNum + 1);
-    for (i = 0; i < numberOfSeqNum; i++)
-    {
-        _NACKSeqNumInternal[i] = seqNumberIterator;
-        seqNumberIterator++;
-    }
-
-    // now we have a list of all sequence numbers that could have been sent
-
-    // zero out the ones we have received
-    for (i = 0; i < _maxNumberOfFrames; i++)
-    {
-        // loop all created frames
-        // We don't need to check if frame is decoding since lowSeqNum is based
-        // on _lastDecodedSeqNum
-        // Ignore free frames
-        VCMFrameBufferStateEnum state = _frameBuffers[i]->GetState();
-
-        if ((kStateFree != state) &&
-            (kStateEmpty != state) &&
-            (kStateDecoding != state))
-        {
-            // Reaching thus far means we are going to update the nack list
-            // When in hybrid mode, we also need to check empty frames, so as
-            // not to add empty packets to the nack list
-            if (_nackMode == kNackHybrid)
-            {
-                _frameBuffers[i]->ZeroOutSeqNumHybrid(_NACKSeqNumInternal,
-                                                      numberOfSeqNum,
-                                                      _rttMs);
-            }
-            else
-            {
-                // Used when the frame is being processed by the decoding thread
-                // don't need to use that info in this loop.
-                _frameBuffers[i]->ZeroOutSeqNum(_NACKSeqNumInternal,
-                                                numberOfSeqNum);
-            }
-        }
-    }
-
-    // compress list
-    int emptyIndex = -1;
-    for (i = 0; i < numberOfSeqNum; i++)
-    {
-        if (_NACKSeqNumInternal[i] == -1 || _NACKSeqNumInternal[i] == -2 )
-        {
-            // this is empty
-            if (emptyIndex == -1)
-            {
-                // no empty index before, remember this position
-                emptyIndex = i;
-            }
-        }
-        else
-        {
-            // this is not empty
-            if (emptyIndex == -1)
-            {
-                // no empty index, continue
-            }
-            else
-            {
-                _NACKSeqNumInternal[emptyIndex] = _NACKSeqNumInternal[i];
-                _NACKSeqNumInternal[i] = -1;
-                emptyIndex++;
-            }
-        }
-    } // for
-
-    if (emptyIndex == -1)
-    {
-        // no empty
-        nackSize = numberOfSeqNum;
-    }
-    else
-    {
-        nackSize = emptyIndex;
-    }
-
-    if (nackSize > _NACKSeqNumLength)
-    {
-        // Larger list: nack list was extended since the last call.
-        listExtended = true;
-    }
-
-    for (WebRtc_UWord32 j = 0; j < nackSize; j++)
-    {
-        // Check if the list has been extended since it was last created. I.e,
-        // new items have been added
-        if (_NACKSeqNumLength > j && !listExtended)
-        {
-            WebRtc_UWord32 k = 0;
-            for (k = j; k < _NACKSeqNumLength; k++)
-            {
-                // Found the item in the last list, i.e, no new items found yet.
-                if (_NACKSeqNum[k] == (WebRtc_UWord16)_NACKSeqNumInternal[j])
-                {
-                   break;
-                }
-            }
-            if (k == _NACKSeqNumLength) // New item not found in last list.
-            {
-                listExtended = true;
-            }
-        }
-        else
-        {
-            listExtended = true;
-        }
-        _NACKSeqNum[j] = (WebRtc_UWord16)_NACKSeqNumInternal[j];
-    }
-
-    _NACKSeqNumLength = nackSize;
+    // The missing sequence numbers in between which are due for a request.
+    // A packet is requested again if it hasn't arrived within an RTT.
+    nackSize = static_cast<WebRtc_UWord16>(_nackTracker.GetNackList(
+        static_cast<WebRtc_UWord16>(lowSeqNum),
+        static_cast<WebRtc_UWord16>(highSeqNum),
+        _clock->TimeInMilliseconds(), _rttMs, _NACKSeqNum,
+        kNackHistoryLength, &listExtended));
 
     return _NACKSeqNum;
 }
@@ -1514,7 +1408,7 @@ VCMFrameBufferEnum
 VCMJitterBuffer::InsertPacket(VCMEncodedFrame* buffer, const VCMPacket& packet)
 {
     CriticalSectionScoped cs(_critSect);
-    WebRtc_Word64 nowMs = VCMTickTime::MillisecondTimestamp();
+    WebRtc_Word64 nowMs = _clock->TimeInMilliseconds();
     VCMFrameBufferEnum bufferReturn = kSizeError;
     VCMFrameBufferEnum ret = kSizeError;
     VCMFrameBuffer* frame = static_cast<VCMFrameBuffer*>(buffer);
@@ -1573,11 +1467,15 @@ VCMJitterBuffer::InsertPacket(VCMEncodedFrame* buffer, const VCMPacket& packet)
         {
             _incomingBitCount += packet.sizeBytes << 3;
 
-            // Has this packet been nacked or is it about to be nacked?
-            if (IsPacketRetransmitted(packet))
+            // Has this packet been nacked?
+            if (_nackTracker.ReceivedPacket(packet.seqNum))
             {
                 frame->IncrementNackCount();
             }
+            if (_nackMode == kNackHybrid)
+            {
+                frame->ExcludeFromNack(&_nackTracker);
+            }
 
             // Insert each frame once on the arrival of the first packet
             // belonging to that frame (media or empty)
@@ -1652,23 +1550,6 @@ VCMJitterBuffer::UpdateOldJitterSample(const VCMPacket& packet)
     }
 }
 
-// Must be called from within _critSect
-bool
-VCMJitterBuffer::IsPacketRetransmitted(const VCMPacket& packet) const
-{
-    if (_NACKSeqNum && _NACKSeqNumLength > 0)
-    {
-        for (WebRtc_UWord16 i = 0; i < _NACKSeqNumLength; i++)
-        {
-            if (packet.seqNum == _NACKSeqNum[i])
-            {
-                return true;
-            }
-        }
-    }
-    return false;
-}
-
 // Get nack status (enabled/disabled)
 VCMNackMode
 VCMJitterBuffer::GetNackMode() const
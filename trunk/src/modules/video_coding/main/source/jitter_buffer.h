@@ -21,6 +21,7 @@
 #include "frame_list.h"
 #include "jitter_buffer_common.h"
 #include "jitter_estimator.h"
+#include "nack_tracker.h"
 
 namespace webrtc
 {
@@ -46,10 +47,16 @@ public:
     WebRtc_Word64 latestPacketTime;
 };
 
+class Clock;
+
 class VCMJitterBuffer
 {
 public:
-    VCMJitterBuffer(WebRtc_Word32 vcmId = -1,
+    // Time is read from |clock|, which must outlive the jitter buffer. Waiting
+    // for a frame still blocks on an event, so callers running on a simulated
+    // clock should not wait.
+    VCMJitterBuffer(Clock* clock,
+                    WebRtc_Word32 vcmId = -1,
                     WebRtc_Word32 receiverId = -1,
                     bool master = true);
     virtual ~VCMJitterBuffer();
@@ -132,7 +139,9 @@ public:
                      int lowRttNackThresholdMs,
                      int highRttNackThresholdMs);
     VCMNackMode GetNackMode() const;    // Get nack mode
-    // Get list of missing sequence numbers (size in number of elements)
+    // Get list of missing sequence numbers (size in number of elements).
+    // A missing packet is listed again when it hasn't arrived within an RTT
+    // of being listed.
     WebRtc_UWord16* GetNackList(WebRtc_UWord16& nackSize,
                                 bool& listExtended);
 
@@ -163,7 +172,6 @@ private:
     void CleanUpOldFrames();
 
     void VerifyAndSetPreviousFrameLost(VCMFrameBuffer& frame);
-    bool IsPacketRetransmitted(const VCMPacket& packet) const;
 
     void UpdateJitterAndDelayEstimates(VCMJitterSample& sample,
                                        bool incompleteFrame);
@@ -189,6 +197,7 @@ private:
     // Decide whether should wait for NACK (mainly relevant for hybrid mode)
     bool WaitForNack();
 
+    Clock*                        _clock;
     WebRtc_Word32                 _vcmId;
     WebRtc_Word32                 _receiverId;
     // If we are running (have started) or not
@@ -240,10 +249,10 @@ private:
     VCMNackMode             _nackMode;
     int                     _lowRttNackThresholdMs;
     int                     _highRttNackThresholdMs;
-    // Holds the internal nack list (the missing sequence numbers)
-    WebRtc_Word32           _NACKSeqNumInternal[kNackHistoryLength];
+    // Missing sequence numbers, updated as packets are inserted
+    VCMNackTracker          _nackTracker;
+    // Holds the nack list returned by GetNackList
     WebRtc_UWord16          _NACKSeqNum[kNackHistoryLength];
-    WebRtc_UWord32          _NACKSeqNumLength;
     bool                    _waitingForKeyFrame;
 
     bool                    _firstPacket;
@@ -18,6 +18,7 @@
 #include "modules/video_coding/codecs/vp8/main/interface/vp8_common_types.h"
 #include "modules/video_coding/main/interface/video_coding_defines.h"
 #include "modules/video_coding/main/source/er_tables_xor.h"
+#include "system_wrappers/interface/clock.h"
 #include "modules/video_coding/main/source/fec_tables_xor.h"
 #include "modules/video_coding/main/source/nack_fec_tables.h"
 #include "modules/video_coding/main/source/qm_select_data.h"
@@ -577,7 +578,8 @@ VCMFecMethod::UpdateParameters(const VCMProtectionParameters* parameters)
 
     return true;
 }
-VCMLossProtectionLogic::VCMLossProtectionLogic():
+VCMLossProtectionLogic::VCMLossProtectionLogic(Clock* clock):
+_clock(clock),
 _selectedMethod(NULL),
 _currentParameters(),
 _rtt(0),
@@ -690,7 +692,7 @@ VCMLossProtectionLogic::UpdateResidualPacketLoss(float residualPacketLoss)
 void
 VCMLossProtectionLogic::UpdateLossPr(WebRtc_UWord8 lossPr255)
 {
-    const WebRtc_Word64 now = VCMTickTime::MillisecondTimestamp();
+    const WebRtc_Word64 now = _clock->TimeInMilliseconds();
     UpdateMaxLossHistory(lossPr255, now);
     _lossPr255.Apply(static_cast<float> (now - _lastPrUpdateT),
                      static_cast<float> (lossPr255));
@@ -775,7 +777,7 @@ VCMLossProtectionLogic::FilteredLoss() const
          _selectedMethod->Type() == kNackFec))
     {
         // Take the windowed max of the received loss.
-        return MaxFilteredLossPr(VCMTickTime::MillisecondTimestamp());
+        return MaxFilteredLossPr(_clock->TimeInMilliseconds());
     }
     else
     {
@@ -799,7 +801,7 @@ VCMLossProtectionLogic::UpdateBitRate(float bitRate)
 void
 VCMLossProtectionLogic::UpdatePacketsPerFrame(float nPackets)
 {
-    const WebRtc_Word64 now = VCMTickTime::MillisecondTimestamp();
+    const WebRtc_Word64 now = _clock->TimeInMilliseconds();
     _packetsPerFrame.Apply(static_cast<float>(now - _lastPacketPerFrameUpdateT),
                            nPackets);
     _lastPacketPerFrameUpdateT = now;
@@ -808,7 +810,7 @@ VCMLossProtectionLogic::UpdatePacketsPerFrame(float nPackets)
 void
 VCMLossProtectionLogic::UpdatePacketsPerFrameKey(float nPackets)
 {
-    const WebRtc_Word64 now = VCMTickTime::MillisecondTimestamp();
+    const WebRtc_Word64 now = _clock->TimeInMilliseconds();
     _packetsPerFrameKey.Apply(static_cast<float>(now -
                               _lastPacketPerFrameUpdateTKey), nPackets);
     _lastPacketPerFrameUpdateTKey = now;
@@ -870,7 +872,7 @@ VCMLossProtectionLogic::SelectedType() const
 void
 VCMLossProtectionLogic::Reset()
 {
-    const WebRtc_Word64 now = VCMTickTime::MillisecondTimestamp();
+    const WebRtc_Word64 now = _clock->TimeInMilliseconds();
     _lastPrUpdateT = now;
     _lastPacketPerFrameUpdateT = now;
     _lastPacketPerFrameUpdateTKey = now;
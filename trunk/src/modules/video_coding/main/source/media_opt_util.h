@@ -15,7 +15,6 @@
 #include "trace.h"
 #include "exp_filter.h"
 #include "internal_defines.h"
-#include "tick_time.h"
 #include "qm_select.h"
 
 #include <cmath>
@@ -24,6 +23,7 @@
 
 namespace webrtc
 {
+class Clock;
 class ListWrapper;
 
 // Number of time periods used for (max) window filter for packet loss
@@ -216,7 +216,8 @@ private:
 class VCMLossProtectionLogic
 {
 public:
-    VCMLossProtectionLogic();
+    // Loss history is timed by |clock|, which must outlive this object.
+    VCMLossProtectionLogic(Clock* clock);
     ~VCMLossProtectionLogic();
 
     // Set the protection method to be used
@@ -344,6 +345,7 @@ private:
     // Sets the available loss protection methods.
     void UpdateMaxLossHistory(WebRtc_UWord8 lossPr255, WebRtc_Word64 now);
     WebRtc_UWord8 MaxFilteredLossPr(WebRtc_Word64 nowMs) const;
+    Clock*                    _clock;
     VCMProtectionMethod*      _selectedMethod;
     VCMProtectionParameters   _currentParameters;
     WebRtc_UWord32            _rtt;
@@ -0,0 +1,110 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/main/source/nack_tracker.h"
+
+#include "modules/video_coding/main/interface/video_coding_defines.h"
+
+namespace webrtc {
+
+VCMNackTracker::VCMNackTracker()
+    : has_received_(false),
+      newest_seq_num_(0),
+      missing_() {}
+
+void VCMNackTracker::Reset() {
+  has_received_ = false;
+  newest_seq_num_ = 0;
+  missing_.clear();
+}
+
+int64_t VCMNackTracker::Unwrap(uint16_t seq_num) const {
+  return newest_seq_num_ + static_cast<int16_t>(
+      seq_num - static_cast<uint16_t>(newest_seq_num_));
+}
+
+bool VCMNackTracker::ReceivedPacket(uint16_t seq_num) {
+  if (!has_received_) {
+    has_received_ = true;
+    newest_seq_num_ = seq_num;
+    return false;
+  }
+  const int64_t unwrapped = Unwrap(seq_num);
+  if (unwrapped <= newest_seq_num_) {
+    // Reordered or retransmitted.
+    MissingPacketMap::iterator it = missing_.find(unwrapped);
+    if (it == missing_.end())
+      return false;
+    const bool requested = it->second.requests > 0;
+    missing_.erase(it);
+    return requested;
+  }
+
+  // A NACK list spans at most kNackHistoryLength packets, up to the newest.
+  const int64_t oldest_kept = unwrapped - kNackHistoryLength + 1;
+  missing_.erase(missing_.begin(), missing_.lower_bound(oldest_kept));
+  int64_t missing_seq_num = newest_seq_num_ + 1;
+  if (missing_seq_num < oldest_kept)
+    missing_seq_num = oldest_kept;
+  for (; missing_seq_num < unwrapped; ++missing_seq_num) {
+    missing_.insert(missing_.end(),
+                    std::make_pair(missing_seq_num, MissingPacket()));
+  }
+  newest_seq_num_ = unwrapped;
+  return false;
+}
+
+void VCMNackTracker::Exclude(uint16_t first_seq_num, uint16_t last_seq_num) {
+  if (!has_received_)
+    return;
+  const int64_t last = Unwrap(last_seq_num);
+  for (MissingPacketMap::iterator it =
+           missing_.lower_bound(Unwrap(first_seq_num));
+       it != missing_.end() && it->first <= last; ++it) {
+    it->second.excluded = true;
+  }
+}
+
+int VCMNackTracker::GetNackList(uint16_t low_seq_num,
+                                uint16_t high_seq_num,
+                                int64_t now_ms,
+                                uint32_t rtt_ms,
+                                uint16_t* nack_list,
+                                int max_size,
+                                bool* extended) {
+  *extended = false;
+  if (!has_received_)
+    return 0;
+  const int64_t low = Unwrap(low_seq_num);
+  const int64_t high = Unwrap(high_seq_num);
+  missing_.erase(missing_.begin(), missing_.upper_bound(low));
+
+  int size = 0;
+  for (MissingPacketMap::iterator it = missing_.begin();
+       it != missing_.end() && it->first <= high && size < max_size; ++it) {
+    MissingPacket& packet = it->second;
+    if (packet.excluded)
+      continue;
+    if (packet.requests > 0 && now_ms - packet.last_request_ms < rtt_ms)
+      continue;
+    if (packet.requests == 0)
+      *extended = true;
+    ++packet.requests;
+    packet.last_request_ms = now_ms;
+    nack_list[size++] = static_cast<uint16_t>(it->first);
+  }
+  return size;
+}
+
+int VCMNackTracker::NumMissing() const {
+  return static_cast<int>(missing_.size());
+}
+
+}  // namespace webrtc
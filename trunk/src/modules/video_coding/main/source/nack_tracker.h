@@ -0,0 +1,77 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_VIDEO_CODING_NACK_TRACKER_H_
+#define WEBRTC_MODULES_VIDEO_CODING_NACK_TRACKER_H_
+
+#include <map>
+
+#include "typedefs.h"
+
+namespace webrtc {
+
+// Keeps track of the sequence numbers which are missing from the received
+// stream, as packets are received, so that the NACK list can be built from
+// the missing packets alone.
+class VCMNackTracker {
+ public:
+  VCMNackTracker();
+
+  void Reset();
+
+  // Registers a received packet. The sequence numbers between the newest
+  // received packet and |seq_num| become missing. Missing packets more than
+  // kNackHistoryLength behind the newest one are forgotten. Returns true if
+  // |seq_num| was missing and has been requested.
+  bool ReceivedPacket(uint16_t seq_num);
+
+  // Stops requesting the missing packets from |first_seq_num| to
+  // |last_seq_num|, inclusive, e.g. since they are not worth a
+  // retransmission.
+  void Exclude(uint16_t first_seq_num, uint16_t last_seq_num);
+
+  // Writes the missing sequence numbers after |low_seq_num| up to and
+  // including |high_seq_num| which are due for a request to |nack_list|, at
+  // most |max_size| of them, and returns their number. A missing packet is
+  // due if it has not been requested yet, or if it was last requested at
+  // least |rtt_ms| ago. |extended| is set if a packet is requested for the
+  // first time. Missing packets up to |low_seq_num| are forgotten.
+  int GetNackList(uint16_t low_seq_num,
+                  uint16_t high_seq_num,
+                  int64_t now_ms,
+                  uint32_t rtt_ms,
+                  uint16_t* nack_list,
+                  int max_size,
+                  bool* extended);
+
+  // Number of missing packets, including excluded ones.
+  int NumMissing() const;
+
+ private:
+  struct MissingPacket {
+    MissingPacket() : requests(0), last_request_ms(0), excluded(false) {}
+    int requests;
+    int64_t last_request_ms;
+    bool excluded;
+  };
+  // Keyed by unwrapped sequence number.
+  typedef std::map<int64_t, MissingPacket> MissingPacketMap;
+
+  // Unwraps |seq_num| relative to the newest received packet.
+  int64_t Unwrap(uint16_t seq_num) const;
+
+  bool has_received_;
+  int64_t newest_seq_num_;
+  MissingPacketMap missing_;
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_MODULES_VIDEO_CODING_NACK_TRACKER_H_
@@ -0,0 +1,149 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "gtest/gtest.h"
+#include "modules/video_coding/main/interface/video_coding_defines.h"
+#include "modules/video_coding/main/source/nack_tracker.h"
+
+namespace webrtc {
+
+class TestNackTracker : public ::testing::Test {
+ protected:
+  enum { kRttMs = 100 };
+
+  virtual void SetUp() {
+    tracker_.Reset();
+    now_ms_ = 0;
+  }
+
+  // Gets the NACK list for the range |low| to |high| into |nack_list_|.
+  int GetNackList(uint16_t low, uint16_t high, bool* extended) {
+    return tracker_.GetNackList(low, high, now_ms_, kRttMs, nack_list_,
+                                kNackHistoryLength, extended);
+  }
+
+  VCMNackTracker tracker_;
+  int64_t now_ms_;
+  uint16_t nack_list_[kNackHistoryLength];
+};
+
+TEST_F(TestNackTracker, NoLoss) {
+  for (uint16_t seq_num = 0; seq_num < 10; ++seq_num) {
+    EXPECT_FALSE(tracker_.ReceivedPacket(seq_num));
+  }
+  bool extended = true;
+  EXPECT_EQ(0, GetNackList(0, 9, &extended));
+  EXPECT_FALSE(extended);
+  EXPECT_EQ(0, tracker_.NumMissing());
+}
+
+TEST_F(TestNackTracker, EveryTenthPacketLost) {
+  for (uint16_t seq_num = 1; seq_num <= 100; ++seq_num) {
+    if (seq_num % 10 != 0)
+      tracker_.ReceivedPacket(seq_num);
+  }
+  tracker_.ReceivedPacket(101);
+  bool extended = false;
+  ASSERT_EQ(10, GetNackList(0, 101, &extended));
+  EXPECT_TRUE(extended);
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ((i + 1) * 10, nack_list_[i]);
+  }
+}
+
+TEST_F(TestNackTracker, Wrap) {
+  for (uint16_t seq_num = 65530; seq_num != 20; ++seq_num) {
+    if (seq_num % 10 != 0)
+      tracker_.ReceivedPacket(seq_num);
+  }
+  tracker_.ReceivedPacket(20);
+  bool extended = false;
+  ASSERT_EQ(2, GetNackList(65529, 20, &extended));
+  EXPECT_EQ(0, nack_list_[0]);
+  EXPECT_EQ(10, nack_list_[1]);
+}
+
+TEST_F(TestNackTracker, OnlyRangeIsListed) {
+  for (uint16_t seq_num = 0; seq_num <= 50; seq_num += 2) {
+    tracker_.ReceivedPacket(seq_num);
+  }
+  bool extended = false;
+  // Missing packets up to the low end are forgotten.
+  ASSERT_EQ(5, GetNackList(20, 30, &extended));
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(21 + 2 * i, nack_list_[i]);
+  }
+  EXPECT_EQ(15, tracker_.NumMissing());
+}
+
+TEST_F(TestNackTracker, RequestedAgainAfterRtt) {
+  tracker_.ReceivedPacket(0);
+  tracker_.ReceivedPacket(3);
+  bool extended = false;
+  EXPECT_EQ(2, GetNackList(0, 3, &extended));
+  EXPECT_TRUE(extended);
+
+  // Not again within an RTT, unless new packets are missing.
+  now_ms_ += kRttMs - 1;
+  EXPECT_EQ(0, GetNackList(0, 3, &extended));
+  EXPECT_FALSE(extended);
+  tracker_.ReceivedPacket(5);
+  ASSERT_EQ(1, GetNackList(0, 5, &extended));
+  EXPECT_TRUE(extended);
+  EXPECT_EQ(4, nack_list_[0]);
+
+  now_ms_ += 1;
+  ASSERT_EQ(2, GetNackList(0, 5, &extended));
+  EXPECT_FALSE(extended);
+  EXPECT_EQ(1, nack_list_[0]);
+  EXPECT_EQ(2, nack_list_[1]);
+}
+
+TEST_F(TestNackTracker, ReceivedPacketReportsRetransmission) {
+  tracker_.ReceivedPacket(0);
+  tracker_.ReceivedPacket(4);
+  bool extended = false;
+  // 1 arrives before it is requested.
+  EXPECT_FALSE(tracker_.ReceivedPacket(1));
+  EXPECT_EQ(2, GetNackList(0, 4, &extended));
+  EXPECT_TRUE(tracker_.ReceivedPacket(2));
+  EXPECT_TRUE(tracker_.ReceivedPacket(3));
+  // Duplicate.
+  EXPECT_FALSE(tracker_.ReceivedPacket(3));
+  EXPECT_EQ(0, tracker_.NumMissing());
+}
+
+TEST_F(TestNackTracker, Exclude) {
+  tracker_.ReceivedPacket(0);
+  tracker_.ReceivedPacket(10);
+  tracker_.Exclude(3, 7);
+  bool extended = false;
+  ASSERT_EQ(4, GetNackList(0, 10, &extended));
+  EXPECT_EQ(1, nack_list_[0]);
+  EXPECT_EQ(2, nack_list_[1]);
+  EXPECT_EQ(8, nack_list_[2]);
+  EXPECT_EQ(9, nack_list_[3]);
+  EXPECT_EQ(9, tracker_.NumMissing());
+}
+
+TEST_F(TestNackTracker, HistoryIsLimited) {
+  tracker_.ReceivedPacket(0);
+  tracker_.ReceivedPacket(2);
+  tracker_.ReceivedPacket(2 * kNackHistoryLength);
+  EXPECT_EQ(kNackHistoryLength - 1, tracker_.NumMissing());
+  tracker_.ReceivedPacket(3 * kNackHistoryLength);
+  EXPECT_EQ(kNackHistoryLength - 1, tracker_.NumMissing());
+  bool extended = false;
+  EXPECT_EQ(kNackHistoryLength - 1,
+            GetNackList(0, 3 * kNackHistoryLength, &extended));
+  EXPECT_EQ(2 * kNackHistoryLength + 1, nack_list_[0]);
+}
+
+}  // namespace webrtc
@@ -10,10 +10,10 @@
 
 #include "receiver.h"
 
+#include "clock.h"
 #include "encoded_frame.h"
 #include "internal_defines.h"
 #include "media_opt_util.h"
-#include "tick_time.h"
 #include "trace.h"
 #include "video_coding.h"
 
@@ -22,15 +22,17 @@
 namespace webrtc {
 
 VCMReceiver::VCMReceiver(VCMTiming& timing,
+                         Clock* clock,
                          WebRtc_Word32 vcmId,
                          WebRtc_Word32 receiverId,
                          bool master)
 :
 _critSect(CriticalSectionWrapper::CreateCriticalSection()),
+_clock(clock),
 _vcmId(vcmId),
 _receiverId(receiverId),
 _master(master),
-_jitterBuffer(vcmId, receiverId, master),
+_jitterBuffer(clock, vcmId, receiverId, master),
 _timing(timing),
 _renderWaitEvent(*new VCMEvent()),
 _state(kPassive)
@@ -118,10 +120,10 @@ VCMReceiver::InsertPacket(const VCMPacket& packet,
                          VCMId(_vcmId, _receiverId),
                          "Packet seqNo %u of frame %u at %u",
                          packet.seqNum, packet.timestamp,
-                         MaskWord64ToUWord32(VCMTickTime::MillisecondTimestamp()));
+                         MaskWord64ToUWord32(_clock->TimeInMilliseconds()));
         }
 
-        const WebRtc_Word64 nowMs = VCMTickTime::MillisecondTimestamp();
+        const WebRtc_Word64 nowMs = _clock->TimeInMilliseconds();
 
         WebRtc_Word64 renderTimeMs = _timing.RenderTimeMs(packet.timestamp, nowMs);
 
@@ -155,7 +157,7 @@ VCMReceiver::InsertPacket(const VCMPacket& packet,
         // First packet received belonging to this frame.
         if (buffer->Length() == 0)
         {
-            const WebRtc_Word64 nowMs = VCMTickTime::MillisecondTimestamp();
+            const WebRtc_Word64 nowMs = _clock->TimeInMilliseconds();
             if (_master)
             {
                 // Only trace the primary receiver to make it possible to parse and plot the trace file.
@@ -199,7 +201,7 @@ VCMReceiver::FrameForDecoding(WebRtc_UWord16 maxWaitTimeMs, WebRtc_Word64& nextR
     // is thread-safe.
     FrameType incomingFrameType = kVideoFrameDelta;
     nextRenderTimeMs = -1;
-    const WebRtc_Word64 startTimeMs = VCMTickTime::MillisecondTimestamp();
+    const WebRtc_Word64 startTimeMs = _clock->TimeInMilliseconds();
     WebRtc_Word64 ret = _jitterBuffer.GetNextTimeStamp(maxWaitTimeMs,
                                                        incomingFrameType,
                                                        nextRenderTimeMs);
@@ -215,7 +217,7 @@ VCMReceiver::FrameForDecoding(WebRtc_UWord16 maxWaitTimeMs, WebRtc_Word64& nextR
     _timing.UpdateCurrentDelay(timeStamp);
 
     const WebRtc_Word32 tempWaitTime = maxWaitTimeMs -
-            static_cast<WebRtc_Word32>(VCMTickTime::MillisecondTimestamp() - startTimeMs);
+            static_cast<WebRtc_Word32>(_clock->TimeInMilliseconds() - startTimeMs);
     WebRtc_UWord16 newMaxWaitTime = static_cast<WebRtc_UWord16>(VCM_MAX(tempWaitTime, 0));
 
     VCMEncodedFrame* frame = NULL;
@@ -256,7 +258,7 @@ VCMReceiver::FrameForDecoding(WebRtc_UWord16 maxWaitTimeMs,
 {
     // How long can we wait until we must decode the next frame
     WebRtc_UWord32 waitTimeMs = _timing.MaxWaitingTime(nextRenderTimeMs,
-                                          VCMTickTime::MillisecondTimestamp());
+                                          _clock->TimeInMilliseconds());
 
     // Try to get a complete frame from the jitter buffer
     VCMEncodedFrame* frame = _jitterBuffer.GetCompleteFrameForDecoding(0);
@@ -296,7 +298,7 @@ VCMReceiver::FrameForDecoding(WebRtc_UWord16 maxWaitTimeMs,
     {
         // Get an incomplete frame
         if (_timing.MaxWaitingTime(nextRenderTimeMs,
-                                   VCMTickTime::MillisecondTimestamp()) > 0)
+                                   _clock->TimeInMilliseconds()) > 0)
         {
             // Still time to wait for a complete frame
             return NULL;
@@ -328,7 +330,7 @@ VCMReceiver::FrameForRendering(WebRtc_UWord16 maxWaitTimeMs,
     // as possible before giving the frame to the decoder, which will render the frame as soon
     // as it has been decoded.
     WebRtc_UWord32 waitTimeMs = _timing.MaxWaitingTime(nextRenderTimeMs,
-                                                       VCMTickTime::MillisecondTimestamp());
+                                                       _clock->TimeInMilliseconds());
     if (maxWaitTimeMs < waitTimeMs)
     {
         // If we're not allowed to wait until the frame is supposed to be rendered
@@ -364,6 +366,13 @@ VCMReceiver::ReleaseFrame(VCMEncodedFrame* frame)
     _jitterBuffer.ReleaseFrame(frame);
 }
 
+WebRtc_Word64
+VCMReceiver::LastPacketTimeMs(VCMEncodedFrame* frame) const
+{
+    bool retransmitted = false;
+    return _jitterBuffer.LastPacketTime(frame, retransmitted);
+}
+
 WebRtc_Word32
 VCMReceiver::ReceiveStatistics(WebRtc_UWord32& bitRate, WebRtc_UWord32& frameRate)
 {
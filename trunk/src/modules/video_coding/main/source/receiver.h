@@ -19,6 +19,7 @@
 namespace webrtc
 {
 
+class Clock;
 class VCMEncodedFrame;
 
 enum VCMNackStatus
@@ -40,6 +41,7 @@ class VCMReceiver
 {
 public:
     VCMReceiver(VCMTiming& timing,
+                Clock* clock,
                 WebRtc_Word32 vcmId = -1,
                 WebRtc_Word32 receiverId = -1,
                 bool master = true);
@@ -56,6 +58,8 @@ public:
                                       bool renderTiming = true,
                                       VCMReceiver* dualReceiver = NULL);
     void ReleaseFrame(VCMEncodedFrame* frame);
+    // Arrival time of the last packet of a frame returned by FrameForDecoding().
+    WebRtc_Word64 LastPacketTimeMs(VCMEncodedFrame* frame) const;
     WebRtc_Word32 ReceiveStatistics(WebRtc_UWord32& bitRate, WebRtc_UWord32& frameRate);
     WebRtc_Word32 ReceivedFrameCount(VCMFrameCount& frameCount) const;
     WebRtc_UWord32 DiscardedPackets() const;
@@ -82,6 +86,7 @@ private:
     static WebRtc_Word32 GenerateReceiverId();
 
     CriticalSectionWrapper* _critSect;
+    Clock*                  _clock;
     WebRtc_Word32           _vcmId;
     WebRtc_Word32           _receiverId;
     bool                    _master;
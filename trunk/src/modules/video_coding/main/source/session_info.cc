@@ -10,6 +10,7 @@
 
 #include "modules/video_coding/main/source/session_info.h"
 
+#include "modules/video_coding/main/source/nack_tracker.h"
 #include "modules/video_coding/main/source/packet.h"
 
 namespace webrtc {
@@ -493,6 +494,17 @@ int VCMSessionInfo::ZeroOutSeqNumHybrid(int* seq_num_list,
   return 0;
 }
 
+void VCMSessionInfo::ExcludeFromNack(VCMNackTracker* nack_tracker) const {
+  if (TemporalId() > 0 && packets_.size() > 1) {
+    nack_tracker->Exclude(packets_.front().seqNum + 1,
+                          packets_.back().seqNum - 1);
+  }
+  // Empty packets are consecutive, see InformOfEmptyPacket().
+  if (empty_seq_num_low_ != -1 && empty_seq_num_high_ != -1) {
+    nack_tracker->Exclude(empty_seq_num_low_, empty_seq_num_high_);
+  }
+}
+
 int VCMSessionInfo::PacketsMissing(const PacketIterator& packet_it,
                                    const PacketIterator& prev_packet_it) {
   if (packet_it == prev_packet_it)
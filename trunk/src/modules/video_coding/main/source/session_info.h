@@ -20,6 +20,8 @@
 
 namespace webrtc {
 
+class VCMNackTracker;
+
 class VCMSessionInfo {
  public:
   VCMSessionInfo();
@@ -33,6 +35,11 @@ class VCMSessionInfo {
   int ZeroOutSeqNumHybrid(int* seq_num_list,
                           int seq_num_list_length,
                           int rtt_ms);
+
+  // Hybrid mode: Excludes the missing packets which ZeroOutSeqNumHybrid()
+  // wouldn't NACK from |nack_tracker|, i.e. the gaps between the packets of
+  // a session in an upper temporal layer, and the empty packets.
+  void ExcludeFromNack(VCMNackTracker* nack_tracker) const;
   void Reset();
   int InsertPacket(const VCMPacket& packet,
                    uint8_t* frame_buffer,
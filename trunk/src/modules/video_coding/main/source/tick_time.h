@@ -11,6 +11,7 @@
 #ifndef WEBRTC_MODULES_VIDEO_CODING_TICK_TIME_H_
 #define WEBRTC_MODULES_VIDEO_CODING_TICK_TIME_H_
 
+#include "clock.h"
 #include "tick_util.h"
 
 #include <assert.h>
@@ -50,6 +51,27 @@ public:
 #endif
 };
 
+// Reads VCMTickTime, so that the test tools built with TICK_TIME_DEBUG can run
+// the module on the debug clock.
+class VCMTickTimeClock : public Clock
+{
+public:
+    virtual WebRtc_Word64 TimeInMilliseconds()
+    {
+        return VCMTickTime::MillisecondTimestamp();
+    }
+
+    virtual WebRtc_Word64 TimeInMicroseconds()
+    {
+        return VCMTickTime::MicrosecondTimestamp();
+    }
+
+    virtual void CurrentNtp(WebRtc_UWord32& seconds, WebRtc_UWord32& fractions)
+    {
+        Clock::GetRealTimeClock()->CurrentNtp(seconds, fractions);
+    }
+};
+
 } // namespace webrtc
 
 #endif // WEBRTC_MODULES_VIDEO_CODING_TICK_TIME_H_
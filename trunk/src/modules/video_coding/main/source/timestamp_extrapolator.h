@@ -17,10 +17,14 @@
 namespace webrtc
 {
 
+class Clock;
+
 class VCMTimestampExtrapolator
 {
 public:
-    VCMTimestampExtrapolator(WebRtc_Word32 vcmId = 0, WebRtc_Word32 receiverId = 0);
+    VCMTimestampExtrapolator(Clock* clock,
+                             WebRtc_Word32 vcmId = 0,
+                             WebRtc_Word32 receiverId = 0);
     ~VCMTimestampExtrapolator();
     void Update(WebRtc_Word64 tMs, WebRtc_UWord32 ts90khz, bool trace = true);
     WebRtc_UWord32 ExtrapolateTimestamp(WebRtc_Word64 tMs) const;
@@ -30,6 +34,7 @@ public:
 private:
     void CheckForWrapArounds(WebRtc_UWord32 ts90khz);
     bool DelayChangeDetection(double error, bool trace = true);
+    Clock*                _clock;
     RWLockWrapper*        _rwLock;
     WebRtc_Word32         _vcmId;
     WebRtc_Word32         _id;
@@ -16,7 +16,10 @@
 
 namespace webrtc {
 
-VCMTiming::VCMTiming(WebRtc_Word32 vcmId, WebRtc_Word32 timingId, VCMTiming* masterTiming)
+VCMTiming::VCMTiming(Clock* clock,
+                     WebRtc_Word32 vcmId,
+                     WebRtc_Word32 timingId,
+                     VCMTiming* masterTiming)
 :
 _critSect(CriticalSectionWrapper::CreateCriticalSection()),
 _vcmId(vcmId),
@@ -33,7 +36,8 @@ _prevFrameTimestamp(0)
     if (masterTiming == NULL)
     {
         _master = true;
-        _tsExtrapolator = new VCMTimestampExtrapolator(vcmId, timingId);
+        _tsExtrapolator = new VCMTimestampExtrapolator(clock, vcmId,
+                                                       timingId);
     }
     else
     {
@@ -18,14 +18,17 @@
 namespace webrtc
 {
 
+class Clock;
 class VCMTimestampExtrapolator;
 
 class VCMTiming
 {
 public:
     // The primary timing component should be passed
-    // if this is the dual timing component.
-    VCMTiming(WebRtc_Word32 vcmId = 0,
+    // if this is the dual timing component. Time is read from |clock|, which
+    // must outlive the timing component.
+    VCMTiming(Clock* clock,
+              WebRtc_Word32 vcmId = 0,
               WebRtc_Word32 timingId = 0,
               VCMTiming* masterTiming = NULL);
     ~VCMTiming();
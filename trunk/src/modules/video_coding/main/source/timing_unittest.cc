@@ -0,0 +1,46 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "gtest/gtest.h"
+#include "modules/video_coding/main/source/timing.h"
+#include "system_wrappers/interface/clock.h"
+
+namespace webrtc {
+
+const int kFramePeriodMs = 40;
+const uint32_t kFramePeriod90kHz = 90 * kFramePeriodMs;
+
+TEST(TestTiming, ExtrapolatesOnSimulatedClock) {
+  SimulatedClock clock(0);
+  VCMTiming timing(&clock);
+  timing.Reset(clock.TimeInMilliseconds());
+
+  // Frames arriving exactly on time lock the extrapolator to the simulated
+  // clock, without any real time passing.
+  uint32_t timestamp = 0;
+  for (int i = 0; i < 100; ++i) {
+    clock.AdvanceTimeMs(kFramePeriodMs);
+    timestamp += kFramePeriod90kHz;
+    timing.IncomingTimestamp(timestamp, clock.TimeInMilliseconds());
+  }
+  clock.AdvanceTimeMs(kFramePeriodMs);
+  timestamp += kFramePeriod90kHz;
+  EXPECT_NEAR(clock.TimeInMilliseconds(),
+              timing.RenderTimeMs(timestamp, clock.TimeInMilliseconds()), 1);
+
+  // The first delay update jumps straight to the target delay, which is then
+  // added on top of the extrapolated arrival time.
+  timing.SetRequiredDelay(100);
+  timing.UpdateCurrentDelay(timestamp);
+  EXPECT_NEAR(clock.TimeInMilliseconds() + timing.TargetVideoDelay(),
+              timing.RenderTimeMs(timestamp, clock.TimeInMilliseconds()), 1);
+}
+
+}  // namespace webrtc
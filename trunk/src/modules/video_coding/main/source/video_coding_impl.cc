@@ -33,26 +33,28 @@ VCMProcessTimer::TimeUntilProcess() const
 {
     return static_cast<WebRtc_UWord32>(
         VCM_MAX(static_cast<WebRtc_Word64>(_periodMs) -
-                (VCMTickTime::MillisecondTimestamp() - _latestMs), 0));
+                (_clock->TimeInMilliseconds() - _latestMs), 0));
 }
 
 void
 VCMProcessTimer::Processed()
 {
-    _latestMs = VCMTickTime::MillisecondTimestamp();
+    _latestMs = _clock->TimeInMilliseconds();
 }
 
-VideoCodingModuleImpl::VideoCodingModuleImpl(const WebRtc_Word32 id)
+VideoCodingModuleImpl::VideoCodingModuleImpl(const WebRtc_Word32 id,
+                                             Clock* clock)
 :
 _id(id),
+_clock(clock),
 _receiveCritSect(CriticalSectionWrapper::CreateCriticalSection()),
 _receiverInited(false),
-_timing(id, 1),
-_dualTiming(id, 2, &_timing),
-_receiver(_timing, id, 1),
-_dualReceiver(_dualTiming, id, 2, false),
-_decodedFrameCallback(_timing),
-_dualDecodedFrameCallback(_dualTiming),
+_timing(clock, id, 1),
+_dualTiming(clock, id, 2, &_timing),
+_receiver(_timing, clock, id, 1),
+_dualReceiver(_dualTiming, clock, id, 2, false),
+_decodedFrameCallback(_timing, clock),
+_dualDecodedFrameCallback(_dualTiming, clock),
 _frameTypeCallback(NULL),
 _frameStorageCallback(NULL),
 _receiveStatsCallback(NULL),
@@ -67,16 +69,16 @@ _scheduleKeyRequest(false),
 _sendCritSect(CriticalSectionWrapper::CreateCriticalSection()),
 _encoder(),
 _encodedFrameCallback(),
-_mediaOpt(id),
+_mediaOpt(id, clock),
 _sendCodecType(kVideoCodecUnknown),
 _sendStatsCallback(NULL),
 _encoderInputFile(NULL),
 
 _codecDataBase(id),
-_receiveStatsTimer(1000),
-_sendStatsTimer(1000),
-_retransmissionTimer(10),
-_keyRequestTimer(500)
+_receiveStatsTimer(1000, clock),
+_sendStatsTimer(1000, clock),
+_retransmissionTimer(10, clock),
+_keyRequestTimer(500, clock)
 {
     for (int i = 0; i < kMaxSimulcastStreams; i++)
     {
@@ -108,12 +110,19 @@ VideoCodingModuleImpl::~VideoCodingModuleImpl()
 
 VideoCodingModule*
 VideoCodingModule::Create(const WebRtc_Word32 id)
+{
+    return Create(id, Clock::GetRealTimeClock());
+}
+
+VideoCodingModule*
+VideoCodingModule::Create(const WebRtc_Word32 id, Clock* clock)
 {
     WEBRTC_TRACE(webrtc::kTraceModuleCall,
                  webrtc::kTraceVideoCoding,
                  VCMId(id),
                  "VideoCodingModule::Create()");
-    return new VideoCodingModuleImpl(id);
+    assert(clock);
+    return new VideoCodingModuleImpl(id, clock);
 }
 
 void
@@ -828,8 +837,21 @@ VideoCodingModuleImpl::AddVideoFrame(const VideoFrame& videoFrame,
 #ifdef DEBUG_ENCODER_INPUT
         if (_encoderInputFile != NULL)
         {
-            fwrite(videoFrame.Buffer(), 1, videoFrame.Length(),
-                   _encoderInputFile);
+            // Write the I420 planes row by row, since a planar frame
+            // may have padded rows.
+            for (int plane = 0; plane < 3; plane++)
+            {
+                const WebRtc_UWord32 width = (plane == 0) ?
+                    videoFrame.Width() : (videoFrame.Width() + 1) / 2;
+                const WebRtc_UWord32 height = (plane == 0) ?
+                    videoFrame.Height() : (videoFrame.Height() + 1) / 2;
+                const WebRtc_UWord8* row = videoFrame.Plane(plane);
+                for (WebRtc_UWord32 i = 0; i < height; i++)
+                {
+                    fwrite(row, 1, width, _encoderInputFile);
+                    row += videoFrame.Stride(plane);
+                }
+            }
         }
 #endif
         if (ret < 0)
@@ -920,6 +942,7 @@ VideoCodingModuleImpl::InitializeReceiver()
 
     _decoder = NULL;
     _decodedFrameCallback.SetUserReceiveCallback(NULL);
+    _decodedFrameCallback.SetLatencyCallback(NULL);
     _receiverInited = true;
     _frameTypeCallback = NULL;
     _frameStorageCallback = NULL;
@@ -959,6 +982,19 @@ VideoCodingModuleImpl::RegisterReceiveStatisticsCallback(
     return VCM_OK;
 }
 
+WebRtc_Word32
+VideoCodingModuleImpl::RegisterReceiveLatencyCallback(
+                                     VCMReceiveLatencyCallback* latencyCallback)
+{
+    WEBRTC_TRACE(webrtc::kTraceModuleCall,
+                 webrtc::kTraceVideoCoding,
+                 VCMId(_id),
+                 "RegisterReceiveLatencyCallback()");
+    CriticalSectionScoped cs(_receiveCritSect);
+    _decodedFrameCallback.SetLatencyCallback(latencyCallback);
+    return VCM_OK;
+}
+
 // Register an externally defined decoder/render object.
 // Can be a decoder only or a decoder coupled with a renderer.
 WebRtc_Word32
@@ -1089,7 +1125,7 @@ VideoCodingModuleImpl::Decode(WebRtc_UWord16 maxWaitTimeMs)
 
         // If this frame was too late, we should adjust the delay accordingly
         _timing.UpdateCurrentDelay(frame->RenderTimeMs(),
-                                   VCMTickTime::MillisecondTimestamp());
+                                   _clock->TimeInMilliseconds());
 
 #ifdef DEBUG_DECODER_BIT_STREAM
         if (_bitStreamBeforeDecoder != NULL)
@@ -1108,7 +1144,8 @@ VideoCodingModuleImpl::Decode(WebRtc_UWord16 maxWaitTimeMs)
             }
         }
 
-        const WebRtc_Word32 ret = Decode(*frame);
+        const WebRtc_Word32 ret = Decode(*frame,
+                                         _receiver.LastPacketTimeMs(frame));
         _receiver.ReleaseFrame(frame);
         frame = NULL;
         if (ret != VCM_OK)
@@ -1206,7 +1243,8 @@ VideoCodingModuleImpl::DecodeDualFrame(WebRtc_UWord16 maxWaitTimeMs)
                      "Decoding frame %u with dual decoder",
                      dualFrame->TimeStamp());
         // Decode dualFrame and try to catch up
-        WebRtc_Word32 ret = _dualDecoder->Decode(*dualFrame);
+        WebRtc_Word32 ret = _dualDecoder->Decode(*dualFrame,
+                                                 _clock->TimeInMilliseconds());
         if (ret != WEBRTC_VIDEO_CODEC_OK)
         {
             WEBRTC_TRACE(webrtc::kTraceWarning,
@@ -1237,7 +1275,8 @@ VideoCodingModuleImpl::DecodeDualFrame(WebRtc_UWord16 maxWaitTimeMs)
 
 // Must be called from inside the receive side critical section.
 WebRtc_Word32
-VideoCodingModuleImpl::Decode(const VCMEncodedFrame& frame)
+VideoCodingModuleImpl::Decode(const VCMEncodedFrame& frame,
+                              WebRtc_Word64 lastPacketTimeMs)
 {
     // Change decoder if payload type has changed
     const bool renderTimingBefore = _codecDataBase.RenderTiming();
@@ -1254,7 +1293,8 @@ VideoCodingModuleImpl::Decode(const VCMEncodedFrame& frame)
         return VCM_NO_CODEC_REGISTERED;
     }
     // Decode a frame
-    WebRtc_Word32 ret = _decoder->Decode(frame);
+    WebRtc_Word32 ret = _decoder->Decode(frame, _clock->TimeInMilliseconds(),
+                                         lastPacketTimeMs);
 
     // Check for failed decoding, run frame type request callback if needed.
     if (ret < 0)
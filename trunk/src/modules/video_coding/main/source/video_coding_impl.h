@@ -12,6 +12,7 @@
 #define WEBRTC_MODULES_VIDEO_CODING_VIDEO_CODING_IMPL_H_
 
 #include "video_coding.h"
+#include "clock.h"
 #include "critical_section_wrapper.h"
 #include "frame_buffer.h"
 #include "receiver.h"
@@ -30,13 +31,16 @@ namespace webrtc
 class VCMProcessTimer
 {
 public:
-    VCMProcessTimer(WebRtc_UWord32 periodMs) :
-        _periodMs(periodMs), _latestMs(VCMTickTime::MillisecondTimestamp()) {}
+    VCMProcessTimer(WebRtc_UWord32 periodMs, Clock* clock)
+        : _clock(clock),
+          _periodMs(periodMs),
+          _latestMs(_clock->TimeInMilliseconds()) {}
     WebRtc_UWord32 Period() const;
     WebRtc_UWord32 TimeUntilProcess() const;
     void Processed();
 
 private:
+    Clock*                _clock;
     WebRtc_UWord32        _periodMs;
     WebRtc_Word64         _latestMs;
 };
@@ -53,7 +57,7 @@ enum VCMKeyRequestMode
 class VideoCodingModuleImpl : public VideoCodingModule
 {
 public:
-    VideoCodingModuleImpl(const WebRtc_Word32 id);
+    VideoCodingModuleImpl(const WebRtc_Word32 id, Clock* clock);
 
     virtual ~VideoCodingModuleImpl();
 
@@ -188,6 +192,10 @@ public:
     virtual WebRtc_Word32 RegisterReceiveStatisticsCallback(
         VCMReceiveStatisticsCallback* receiveStats);
 
+    // Register a receive latency callback.
+    virtual WebRtc_Word32 RegisterReceiveLatencyCallback(
+        VCMReceiveLatencyCallback* latencyCallback);
+
     // Register a frame type request callback.
     virtual WebRtc_Word32 RegisterFrameTypeCallback(
         VCMFrameTypeCallback* frameTypeCallback);
@@ -251,7 +259,8 @@ public:
     virtual WebRtc_UWord32 DiscardedPackets() const;
 
 protected:
-    WebRtc_Word32 Decode(const webrtc::VCMEncodedFrame& frame);
+    WebRtc_Word32 Decode(const webrtc::VCMEncodedFrame& frame,
+                         WebRtc_Word64 lastPacketTimeMs = -1);
     WebRtc_Word32 RequestKeyFrame();
     WebRtc_Word32 RequestSliceLossIndication(
         const WebRtc_UWord64 pictureID) const;
@@ -259,6 +268,7 @@ protected:
 
 private:
     WebRtc_Word32                       _id;
+    Clock*                              _clock;
     CriticalSectionWrapper*             _receiveCritSect;
     bool                                _receiverInited;
     VCMTiming                           _timing;
@@ -64,8 +64,9 @@ int DecodeFromStorageTest(CmdArgs& args)
     Trace::SetLevelFilter(webrtc::kTraceAll);
 
 
-    VideoCodingModule* vcm = VideoCodingModule::Create(1);
-    VideoCodingModule* vcmPlayback = VideoCodingModule::Create(2);
+    VCMTickTimeClock clock;
+    VideoCodingModule* vcm = VideoCodingModule::Create(1, &clock);
+    VideoCodingModule* vcmPlayback = VideoCodingModule::Create(2, &clock);
     FrameStorageCallback storageCallback(vcmPlayback);
     RtpDataCallback dataCallback(vcm);
     WebRtc_Word32 ret = vcm->InitializeReceiver();
@@ -27,7 +27,8 @@ int GenericCodecTest::RunTest(CmdArgs& args)
     printf("\n\nEnable debug time to run this test!\n\n");
     return -1;
 #endif
-    VideoCodingModule* vcm = VideoCodingModule::Create(1);
+    VCMTickTimeClock clock;
+    VideoCodingModule* vcm = VideoCodingModule::Create(1, &clock);
     GenericCodecTest* get = new GenericCodecTest(vcm);
     Trace::CreateTrace();
     Trace::SetTraceFile(
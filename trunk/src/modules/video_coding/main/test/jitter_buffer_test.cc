@@ -135,7 +135,7 @@ int JitterBufferTest(CmdArgs& args)
 
     //printf("DONE timestamp ordered frame list\n");
 
-    VCMJitterBuffer jb;
+    VCMJitterBuffer jb(Clock::GetRealTimeClock());
 
     seqNum = 1234;
     timeStamp = 123*90;
@@ -38,7 +38,8 @@ int NormalTest::RunTest(CmdArgs& args)
     Trace::SetTraceFile(
         (test::OutputPath() + "VCMNormalTestTrace.txt").c_str());
     Trace::SetLevelFilter(webrtc::kTraceAll);
-    VideoCodingModule* vcm = VideoCodingModule::Create(1);
+    VCMTickTimeClock clock;
+    VideoCodingModule* vcm = VideoCodingModule::Create(1, &clock);
     NormalTest VCMNTest(vcm);
     VCMNTest.Perform(args);
     VideoCodingModule::Destroy(vcm);
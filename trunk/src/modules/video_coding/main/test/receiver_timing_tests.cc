@@ -62,7 +62,7 @@ int ReceiverTimingTests(CmdArgs& args)
     // A static random seed
     srand(0);
 
-    VCMTiming timing;
+    VCMTiming timing(Clock::GetRealTimeClock());
     float clockInMs = 0.0;
     WebRtc_UWord32 waitTime = 0;
     WebRtc_UWord32 jitterDelayMs = 0;
@@ -44,6 +44,7 @@ WebRtc_Word32
 VPMBrightnessDetection::ProcessFrame(const WebRtc_UWord8* frame,
                                      const WebRtc_UWord32 width,
                                      const WebRtc_UWord32 height,
+                                     const WebRtc_UWord32 stride,
                                      const VideoProcessingModule::FrameStats& stats)
 {
     if (frame == NULL)
@@ -92,7 +93,7 @@ VPMBrightnessDetection::ProcessFrame(const WebRtc_UWord8* frame,
             float stdY = 0;
             for (WebRtc_UWord32 h = 0; h < height; h += (1 << stats.subSamplHeight))
             {
-                WebRtc_UWord32 row = h*width;
+                WebRtc_UWord32 row = h*stride;
                 for (WebRtc_UWord32 w = 0; w < width; w += (1 << stats.subSamplWidth))
                 {
                     stdY += (frame[w + row] - stats.mean) * (frame[w + row] - stats.mean);
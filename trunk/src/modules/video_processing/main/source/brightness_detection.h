@@ -32,6 +32,7 @@ public:
     WebRtc_Word32 ProcessFrame(const WebRtc_UWord8* frame,
                              WebRtc_UWord32 width,
                              WebRtc_UWord32 height,
+                             WebRtc_UWord32 stride,
                              const VideoProcessingModule::FrameStats& stats);
 
 private:
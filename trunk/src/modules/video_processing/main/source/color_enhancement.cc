@@ -22,43 +22,60 @@ namespace VideoProcessing
                      const WebRtc_UWord32 width,
                      const WebRtc_UWord32 height)
     {
-        // pointers to U and V color pixels
-        WebRtc_UWord8* ptrU;
-        WebRtc_UWord8* ptrV;
-        WebRtc_UWord8 tempChroma;
         const WebRtc_UWord32 numPixels = width * height;
 
-
         if (frame == NULL)
         {
             WEBRTC_TRACE(webrtc::kTraceError, webrtc::kTraceVideoPreocessing, -1, "Null frame pointer");
             return VPM_GENERAL_ERROR;
         }
 
-        if (width == 0 || height == 0)
+        // stream format:
+        // | numPixels bytes luminance | numPixels/4 bytes chroma U | numPixels/4 chroma V |
+        // The packed chroma planes are handled as a single row each.
+        WebRtc_UWord8* ptrU = frame + numPixels;       // skip luminance
+        WebRtc_UWord8* ptrV = ptrU + (numPixels>>2);
+        return ColorEnhancement(ptrU, ptrV, 0, 0, numPixels>>2,
+                                numPixels > 0 ? 1 : 0);
+    }
+
+    WebRtc_Word32
+    ColorEnhancement(WebRtc_UWord8* planeU,
+                     WebRtc_UWord8* planeV,
+                     const WebRtc_UWord32 strideU,
+                     const WebRtc_UWord32 strideV,
+                     const WebRtc_UWord32 chromaWidth,
+                     const WebRtc_UWord32 chromaHeight)
+    {
+        WebRtc_UWord8 tempChroma;
+
+        if (planeU == NULL || planeV == NULL)
+        {
+            WEBRTC_TRACE(webrtc::kTraceError, webrtc::kTraceVideoPreocessing, -1, "Null frame pointer");
+            return VPM_GENERAL_ERROR;
+        }
+
+        if (chromaWidth == 0 || chromaHeight == 0)
         {
             WEBRTC_TRACE(webrtc::kTraceError, webrtc::kTraceVideoPreocessing, -1, "Invalid frame size");
             return VPM_GENERAL_ERROR;
         }
-        
-        // set pointers to first U and V pixels
-        
-        // stream format:
-        // | numPixels bytes luminance | numPixels/4 bytes chroma U | numPixels/4 chroma V |
-        
-        ptrU = frame + numPixels;       // skip luminance
-        ptrV = ptrU + (numPixels>>2);
 
         // loop through all chrominance pixels and modify color
-        for (WebRtc_UWord32 ix = 0; ix < (numPixels>>2); ix++)
+        for (WebRtc_UWord32 row = 0; row < chromaHeight; row++)
         {
-            tempChroma = colorTable[*ptrU][*ptrV];
-            *ptrV = colorTable[*ptrV][*ptrU];
-            *ptrU = tempChroma;
-            
-            // increment pointers
-            ptrU++;
-            ptrV++;
+            WebRtc_UWord8* ptrU = planeU + row * strideU;
+            WebRtc_UWord8* ptrV = planeV + row * strideV;
+            for (WebRtc_UWord32 ix = 0; ix < chromaWidth; ix++)
+            {
+                tempChroma = colorTable[*ptrU][*ptrV];
+                *ptrV = colorTable[*ptrV][*ptrU];
+                *ptrU = tempChroma;
+
+                // increment pointers
+                ptrU++;
+                ptrV++;
+            }
         }
         return VPM_OK;
     }
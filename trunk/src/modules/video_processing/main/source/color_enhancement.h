@@ -24,6 +24,15 @@ namespace VideoProcessing
     WebRtc_Word32 ColorEnhancement(WebRtc_UWord8* frame,
                                  WebRtc_UWord32 width,
                                  WebRtc_UWord32 height);
+
+    // Same as above, for chroma planes of chromaWidth x chromaHeight pixels
+    // with rows strideU and strideV bytes apart.
+    WebRtc_Word32 ColorEnhancement(WebRtc_UWord8* planeU,
+                                 WebRtc_UWord8* planeV,
+                                 WebRtc_UWord32 strideU,
+                                 WebRtc_UWord32 strideV,
+                                 WebRtc_UWord32 chromaWidth,
+                                 WebRtc_UWord32 chromaHeight);
 }
 
 } //namespace
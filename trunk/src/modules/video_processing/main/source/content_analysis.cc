@@ -79,7 +79,19 @@ VPMContentAnalysis::ComputeContentMetrics(const VideoFrame* inputFrame)
         }
     }
 
-    _origFrame = inputFrame->Buffer();
+    if (inputFrame->HasPlanes())
+    {
+        // The metrics are computed on a packed luminance plane.
+        if (_packedFrame.CopyFrame(*inputFrame) != 0)
+        {
+            return NULL;
+        }
+        _origFrame = _packedFrame.Buffer();
+    }
+    else
+    {
+        _origFrame = inputFrame->Buffer();
+    }
 
     // compute spatial metrics: 3 spatial prediction errors
     (this->*ComputeSpatialMetrics)();
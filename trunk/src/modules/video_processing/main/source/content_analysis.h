@@ -68,6 +68,7 @@ private:
 #endif
 
     const WebRtc_UWord8*       _origFrame;
+    VideoFrame                 _packedFrame;
     WebRtc_UWord8*             _prevFrame;
     WebRtc_UWord16             _width;
     WebRtc_UWord16             _height;
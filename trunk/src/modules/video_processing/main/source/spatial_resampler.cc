@@ -83,14 +83,27 @@ VPMSimpleSpatialResampler::ResampleFrame(const VideoFrame& inFrame,
 
 
   // Disabling cut/pad for now - only scaling.
-  int requiredSize = (WebRtc_UWord32)(_targetWidth * _targetHeight * 3 >> 1);
-  outFrame.VerifyAndAllocate(requiredSize);
+  // The input may be packed or strided; the output gets aligned planes.
+  I420Planes srcPlanes;
+  I420Planes dstPlanes;
+  for (int i = 0; i < kNumOfI420Planes; i++) {
+    srcPlanes.plane[i] = inFrame.Plane(i);
+    srcPlanes.stride[i] = inFrame.Stride(i);
+  }
+  srcPlanes.width = inFrame.Width();
+  srcPlanes.height = inFrame.Height();
+
+  if (outFrame.AllocatePlanes(_targetWidth, _targetHeight) != 0)
+    return VPM_MEMORY;
   outFrame.SetTimeStamp(inFrame.TimeStamp());
-  outFrame.SetWidth(_targetWidth);
-  outFrame.SetHeight(_targetHeight);
+  for (int i = 0; i < kNumOfI420Planes; i++) {
+    dstPlanes.plane[i] = outFrame.Plane(i);
+    dstPlanes.stride[i] = outFrame.Stride(i);
+  }
+  dstPlanes.width = _targetWidth;
+  dstPlanes.height = _targetHeight;
 
-  retVal = _scaler.Scale(inFrame.Buffer(), outFrame.Buffer(), requiredSize);
-  outFrame.SetLength(requiredSize);
+  retVal = _scaler.Scale(srcPlanes, dstPlanes);
   if (retVal == 0)
     return VPM_OK;
   else
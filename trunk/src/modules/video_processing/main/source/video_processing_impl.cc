@@ -44,6 +44,50 @@ namespace
             stats.subSamplHeight = 0;
         }
     }
+
+    // Computes the histogram and mean of a luminance plane with rows
+    // stride bytes apart.
+    WebRtc_Word32
+    GetPlaneStats(VideoProcessingModule::FrameStats& stats,
+                  const WebRtc_UWord8* frame,
+                  const WebRtc_UWord32 width,
+                  const WebRtc_UWord32 height,
+                  const WebRtc_UWord32 stride)
+    {
+        if (frame == NULL)
+        {
+            WEBRTC_TRACE(webrtc::kTraceError, webrtc::kTraceVideoPreocessing, -1, "Null frame pointer");
+            return VPM_PARAMETER_ERROR;
+        }
+
+        if (width == 0 || height == 0)
+        {
+            WEBRTC_TRACE(webrtc::kTraceError, webrtc::kTraceVideoPreocessing, -1, "Invalid frame size");
+            return VPM_PARAMETER_ERROR;
+        }
+
+        VideoProcessingModule::ClearFrameStats(stats); // The histogram needs to be zeroed out.
+        SetSubSampling(stats, width, height);
+
+        // Compute histogram and sum of frame
+        for (WebRtc_UWord32 i = 0; i < height; i += (1 << stats.subSamplHeight))
+        {
+            WebRtc_Word32 k = i * stride;
+            for (WebRtc_UWord32 j = 0; j < width; j += (1 << stats.subSamplWidth))
+            {
+                stats.hist[frame[k + j]]++;
+                stats.sum += frame[k + j];
+            }
+        }
+
+        stats.numPixels = (width * height) / ((1 << stats.subSamplWidth) * (1 << stats.subSamplHeight));
+        assert(stats.numPixels > 0);
+
+        // Compute mean value of frame
+        stats.mean = stats.sum / stats.numPixels;
+
+        return VPM_OK;
+    }
 }
 
 VideoProcessingModule*
@@ -158,7 +202,8 @@ WebRtc_Word32
 VideoProcessingModule::GetFrameStats(FrameStats& stats,
                                          const VideoFrame& frame)
 {
-    return GetFrameStats(stats, frame.Buffer(), frame.Width(), frame.Height());
+    return GetPlaneStats(stats, frame.Plane(0), frame.Width(), frame.Height(),
+                         frame.Stride(0));
 }
 
 WebRtc_Word32
@@ -167,39 +212,7 @@ VideoProcessingModule::GetFrameStats(FrameStats& stats,
                                          const WebRtc_UWord32 width,
                                          const WebRtc_UWord32 height)
 {
-    if (frame == NULL)
-    {
-        WEBRTC_TRACE(webrtc::kTraceError, webrtc::kTraceVideoPreocessing, -1, "Null frame pointer");
-        return VPM_PARAMETER_ERROR;
-    }
-    
-    if (width == 0 || height == 0)
-    {
-        WEBRTC_TRACE(webrtc::kTraceError, webrtc::kTraceVideoPreocessing, -1, "Invalid frame size");
-        return VPM_PARAMETER_ERROR;
-    }
-
-    ClearFrameStats(stats); // The histogram needs to be zeroed out.
-    SetSubSampling(stats, width, height);
-
-    // Compute histogram and sum of frame
-    for (WebRtc_UWord32 i = 0; i < height; i += (1 << stats.subSamplHeight))
-    {
-        WebRtc_Word32 k = i * width;
-        for (WebRtc_UWord32 j = 0; j < width; j += (1 << stats.subSamplWidth))
-        { 
-            stats.hist[frame[k + j]]++;
-            stats.sum += frame[k + j];
-        }
-    }
-
-    stats.numPixels = (width * height) / ((1 << stats.subSamplWidth) * (1 << stats.subSamplHeight));
-    assert(stats.numPixels > 0);
-
-    // Compute mean value of frame
-    stats.mean = stats.sum / stats.numPixels;
-    
-    return VPM_OK;
+    return GetPlaneStats(stats, frame, width, height, width);
 }
 
 bool
@@ -227,7 +240,18 @@ VideoProcessingModule::ClearFrameStats(FrameStats& stats)
 WebRtc_Word32
 VideoProcessingModule::ColorEnhancement(VideoFrame& frame)
 {
-    return ColorEnhancement(frame.Buffer(), frame.Width(), frame.Height());
+    if (frame.ReferencesPlanes())
+    {
+        // The lent picture is read-only.
+        if (frame.Materialize() < 0)
+        {
+            return VPM_MEMORY;
+        }
+    }
+    return VideoProcessing::ColorEnhancement(frame.Plane(1), frame.Plane(2),
+                                             frame.Stride(1), frame.Stride(2),
+                                             (frame.Width() + 1) >> 1,
+                                             (frame.Height() + 1) >> 1);
 }
 
 WebRtc_Word32
@@ -257,6 +281,10 @@ WebRtc_Word32
 VideoProcessingModuleImpl::Deflickering(VideoFrame& frame,
                                             FrameStats& stats)
 {
+    if (frame.Materialize() < 0)
+    {
+        return VPM_MEMORY;
+    }
     return Deflickering(frame.Buffer(), frame.Width(), frame.Height(), 
         frame.TimeStamp(), stats);
 }
@@ -275,6 +303,10 @@ VideoProcessingModuleImpl::Deflickering(WebRtc_UWord8* frame,
 WebRtc_Word32
 VideoProcessingModuleImpl::Denoising(VideoFrame& frame)
 {
+    if (frame.Materialize() < 0)
+    {
+        return VPM_MEMORY;
+    }
     return Denoising(frame.Buffer(), frame.Width(), frame.Height());
 }
 
@@ -291,7 +323,10 @@ WebRtc_Word32
 VideoProcessingModuleImpl::BrightnessDetection(const VideoFrame& frame,
                                                    const FrameStats& stats)
 {
-    return BrightnessDetection(frame.Buffer(), frame.Width(), frame.Height(), stats);
+    CriticalSectionScoped mutex(_mutex);
+    return _brightnessDetection.ProcessFrame(frame.Plane(0), frame.Width(),
+                                             frame.Height(), frame.Stride(0),
+                                             stats);
 }
 
 WebRtc_Word32
@@ -301,7 +336,8 @@ VideoProcessingModuleImpl::BrightnessDetection(const WebRtc_UWord8* frame,
                                                    const FrameStats& stats)
 {
     CriticalSectionScoped mutex(_mutex);
-    return _brightnessDetection.ProcessFrame(frame, width, height, stats);
+    return _brightnessDetection.ProcessFrame(frame, width, height, width,
+                                             stats);
 }
 
 
@@ -357,6 +357,10 @@ void TestSize(VideoFrame& sourceFrame, WebRtc_UWord32 targetWidth,
   // Length should be updated only if frame was resampled
   if (targetWidth != sourceFrame.Width() ||
       targetHeight != sourceFrame.Height())  {
+    // The resampled picture is in aligned planes; pack it.
+    ASSERT_EQ(targetWidth, outFrame->Width());
+    ASSERT_EQ(targetHeight, outFrame->Height());
+    ASSERT_EQ(0, outFrame->Materialize());
     ASSERT_EQ((targetWidth * targetHeight * 3 / 2), outFrame->Length());
     // Write to file for visual inspection
     fwrite(outFrame->Buffer(), 1, outFrame->Length(), standAloneFile);
@@ -113,6 +113,7 @@ WebRtc_Word32 IncomingVideoStream::RenderFrame(const WebRtc_UWord32 streamId,
 
     if (true == _mirrorFramesEnabled)
     {
+        videoFrame.Materialize();
         _transformedVideoFrame.VerifyAndAllocate(videoFrame.Length());
         if (_mirroring.mirrorXAxis)
         {
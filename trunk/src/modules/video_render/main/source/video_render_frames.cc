@@ -81,8 +81,17 @@ WebRtc_Word32 VideoRenderFrames::AddFrame(VideoFrame* ptrNewFrame)
         }
     }
 
-    ptrFrameToAdd->VerifyAndAllocate(ptrNewFrame->Length());
-    ptrFrameToAdd->SwapFrame(const_cast<VideoFrame&> (*ptrNewFrame)); //remove const ness. Copying will be costly.
+    if (ptrNewFrame->HasPlanes())
+    {
+        // The picture is only lent to us until the next decode, copy it
+        // straight into the queued frame.
+        ptrFrameToAdd->CopyFrame(*ptrNewFrame);
+    }
+    else
+    {
+        ptrFrameToAdd->VerifyAndAllocate(ptrNewFrame->Length());
+        ptrFrameToAdd->SwapFrame(const_cast<VideoFrame&> (*ptrNewFrame)); //remove const ness. Copying will be costly.
+    }
     _incomingFrames.PushBack(ptrFrameToAdd);
 
     return _incomingFrames.GetSize();
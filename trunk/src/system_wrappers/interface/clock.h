@@ -0,0 +1,66 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Injectable clock. Modules that are given a Clock read all their timestamps
+// from it instead of from the system, so that a recorded session can be
+// replayed on a SimulatedClock as fast as the CPU allows.
+#ifndef WEBRTC_SYSTEM_WRAPPERS_INTERFACE_CLOCK_H_
+#define WEBRTC_SYSTEM_WRAPPERS_INTERFACE_CLOCK_H_
+
+#include "typedefs.h"
+
+namespace webrtc {
+class CriticalSectionWrapper;
+
+class Clock
+{
+public:
+    virtual ~Clock() {}
+
+    // Return a timestamp in milliseconds relative to some arbitrary source;
+    // the source is fixed for this clock.
+    virtual WebRtc_Word64 TimeInMilliseconds() = 0;
+
+    // Return a timestamp in microseconds relative to the same source.
+    virtual WebRtc_Word64 TimeInMicroseconds() = 0;
+
+    // Retrieve an NTP absolute timestamp.
+    virtual void CurrentNtp(WebRtc_UWord32& seconds,
+                            WebRtc_UWord32& fractions) = 0;
+
+    // Returns the clock reading real time. It is shared by the whole process
+    // and must not be deleted.
+    static Clock* GetRealTimeClock();
+};
+
+// A clock that only moves when it is advanced. Its NTP time is the simulated
+// time counted from the start of 1970. It may be read and advanced from
+// different threads.
+class SimulatedClock : public Clock
+{
+public:
+    explicit SimulatedClock(WebRtc_Word64 initialTimeUs);
+    virtual ~SimulatedClock();
+
+    virtual WebRtc_Word64 TimeInMilliseconds();
+    virtual WebRtc_Word64 TimeInMicroseconds();
+    virtual void CurrentNtp(WebRtc_UWord32& seconds,
+                            WebRtc_UWord32& fractions);
+
+    void AdvanceTimeMs(WebRtc_Word64 milliseconds);
+    void AdvanceTimeUs(WebRtc_Word64 microseconds);
+
+private:
+    CriticalSectionWrapper* _critSect;
+    WebRtc_Word64 _timeUs;
+};
+} // namespace webrtc
+
+#endif // WEBRTC_SYSTEM_WRAPPERS_INTERFACE_CLOCK_H_
@@ -0,0 +1,46 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Collects latency histograms for the stages of the media pipeline of one
+// channel. Samples may be added from any thread; adding a sample costs one
+// lock and a few comparisons.
+#ifndef WEBRTC_SYSTEM_WRAPPERS_INTERFACE_LATENCY_STATS_H_
+#define WEBRTC_SYSTEM_WRAPPERS_INTERFACE_LATENCY_STATS_H_
+
+#include "common_types.h"
+#include "typedefs.h"
+
+namespace webrtc {
+class CriticalSectionWrapper;
+
+class LatencyStats
+{
+public:
+    LatencyStats();
+    ~LatencyStats();
+
+    // Adds one sample of |delayMs| to the histogram of |stage|. Negative
+    // delays, e.g. from a frame without a capture time, are ignored.
+    void Add(const LatencyStage stage, const WebRtc_Word64 delayMs);
+
+    // Returns the histograms of all stages. Stages without samples have all
+    // fields set to zero.
+    void GetStatistics(LatencyStatistics& statistics) const;
+
+    void Reset();
+
+private:
+    CriticalSectionWrapper* _critSect;
+    LatencyStatistics _statistics;
+    WebRtc_Word64 _sumMs[kNumLatencyStages];
+};
+} // namespace webrtc
+
+#endif // WEBRTC_SYSTEM_WRAPPERS_INTERFACE_LATENCY_STATS_H_
@@ -22,6 +22,7 @@ LOCAL_SRC_FILES := \
     sort.cc \
     aligned_malloc.cc \
     atomic32.cc \
+    clock.cc \
     condition_variable.cc \
     cpu_no_op.cc \
     cpu_features.cc \
@@ -30,6 +31,7 @@ LOCAL_SRC_FILES := \
     critical_section.cc \
     event.cc \
     file_impl.cc \
+    latency_stats.cc \
     list_no_stl.cc \
     rw_lock.cc \
     thread.cc \
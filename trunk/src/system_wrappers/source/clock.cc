@@ -0,0 +1,121 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "clock.h"
+
+#if defined(_WIN32)
+#include <Windows.h>
+#else
+#include <sys/time.h>
+#include <time.h>
+#endif
+
+#include "critical_section_wrapper.h"
+#include "tick_util.h"
+
+namespace webrtc {
+
+namespace {
+// January 1970, in NTP seconds.
+const WebRtc_UWord32 kNtpJan1970 = 2208988800UL;
+
+// Magic NTP fractional unit.
+const double kMagicNtpFractionalUnit = 4.294967296E+9;
+
+void MicrosecondsToNtp(WebRtc_Word64 timeUs, WebRtc_UWord32& seconds,
+                       WebRtc_UWord32& fractions)
+{
+    seconds = static_cast<WebRtc_UWord32>(timeUs / 1000000) + kNtpJan1970;
+    fractions = static_cast<WebRtc_UWord32>(
+        (timeUs % 1000000) * kMagicNtpFractionalUnit / 1e6);
+}
+
+class RealTimeClock : public Clock
+{
+public:
+    virtual WebRtc_Word64 TimeInMilliseconds()
+    {
+        return TickTime::MillisecondTimestamp();
+    }
+
+    virtual WebRtc_Word64 TimeInMicroseconds()
+    {
+        return TickTime::MicrosecondTimestamp();
+    }
+
+    virtual void CurrentNtp(WebRtc_UWord32& seconds,
+                            WebRtc_UWord32& fractions)
+    {
+#if defined(_WIN32)
+        // 100 ns intervals between 1601 and 1970.
+        const WebRtc_UWord64 kFileTime1970 = 0x019db1ded53e8000;
+        FILETIME fileTime;
+        GetSystemTimeAsFileTime(&fileTime);
+        const WebRtc_UWord64 time =
+            ((static_cast<WebRtc_UWord64>(fileTime.dwHighDateTime) << 32) +
+             fileTime.dwLowDateTime) - kFileTime1970;
+        MicrosecondsToNtp(static_cast<WebRtc_Word64>(time / 10), seconds,
+                          fractions);
+#else
+        struct timeval tv;
+        gettimeofday(&tv, NULL);
+        MicrosecondsToNtp(static_cast<WebRtc_Word64>(tv.tv_sec) * 1000000 +
+                          tv.tv_usec, seconds, fractions);
+#endif
+    }
+};
+} // namespace
+
+Clock* Clock::GetRealTimeClock()
+{
+    static RealTimeClock realTimeClock;
+    return &realTimeClock;
+}
+
+SimulatedClock::SimulatedClock(WebRtc_Word64 initialTimeUs)
+    : _critSect(CriticalSectionWrapper::CreateCriticalSection()),
+      _timeUs(initialTimeUs)
+{
+}
+
+SimulatedClock::~SimulatedClock()
+{
+    delete _critSect;
+}
+
+WebRtc_Word64 SimulatedClock::TimeInMilliseconds()
+{
+    CriticalSectionScoped lock(_critSect);
+    return _timeUs / 1000;
+}
+
+WebRtc_Word64 SimulatedClock::TimeInMicroseconds()
+{
+    CriticalSectionScoped lock(_critSect);
+    return _timeUs;
+}
+
+void SimulatedClock::CurrentNtp(WebRtc_UWord32& seconds,
+                                WebRtc_UWord32& fractions)
+{
+    MicrosecondsToNtp(TimeInMicroseconds(), seconds, fractions);
+}
+
+void SimulatedClock::AdvanceTimeMs(WebRtc_Word64 milliseconds)
+{
+    AdvanceTimeUs(milliseconds * 1000);
+}
+
+void SimulatedClock::AdvanceTimeUs(WebRtc_Word64 microseconds)
+{
+    CriticalSectionScoped lock(_critSect);
+    _timeUs += microseconds;
+}
+} // namespace webrtc
@@ -0,0 +1,61 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "gtest/gtest.h"
+
+#include "system_wrappers/interface/clock.h"
+
+using ::webrtc::Clock;
+using ::webrtc::SimulatedClock;
+
+// NTP seconds at the start of 1970.
+const WebRtc_UWord32 kNtpJan1970 = 2208988800UL;
+
+TEST(ClockTest, RealTimeClockIsShared) {
+    Clock* clock = Clock::GetRealTimeClock();
+    ASSERT_TRUE(clock != NULL);
+    EXPECT_EQ(clock, Clock::GetRealTimeClock());
+
+    const WebRtc_Word64 startMs = clock->TimeInMilliseconds();
+    EXPECT_GE(clock->TimeInMilliseconds(), startMs);
+    EXPECT_GE(clock->TimeInMicroseconds(), startMs * 1000);
+
+    WebRtc_UWord32 seconds = 0;
+    WebRtc_UWord32 fractions = 0;
+    clock->CurrentNtp(seconds, fractions);
+    EXPECT_GT(seconds, kNtpJan1970);
+}
+
+TEST(ClockTest, SimulatedClockOnlyMovesWhenAdvanced) {
+    SimulatedClock clock(1000000);
+    EXPECT_EQ(1000, clock.TimeInMilliseconds());
+    EXPECT_EQ(1000000, clock.TimeInMicroseconds());
+    EXPECT_EQ(1000, clock.TimeInMilliseconds());
+
+    clock.AdvanceTimeMs(5);
+    EXPECT_EQ(1005, clock.TimeInMilliseconds());
+    clock.AdvanceTimeUs(999);
+    EXPECT_EQ(1005, clock.TimeInMilliseconds());
+    EXPECT_EQ(1005999, clock.TimeInMicroseconds());
+}
+
+TEST(ClockTest, SimulatedClockNtpTime) {
+    SimulatedClock clock(2500000);
+    WebRtc_UWord32 seconds = 0;
+    WebRtc_UWord32 fractions = 0;
+    clock.CurrentNtp(seconds, fractions);
+    EXPECT_EQ(kNtpJan1970 + 2, seconds);
+    EXPECT_EQ(0x80000000u, fractions);
+
+    clock.AdvanceTimeMs(500);
+    clock.CurrentNtp(seconds, fractions);
+    EXPECT_EQ(kNtpJan1970 + 3, seconds);
+    EXPECT_EQ(0u, fractions);
+}
@@ -0,0 +1,85 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "latency_stats.h"
+
+#include <string.h>  // memset
+
+#include "critical_section_wrapper.h"
+
+namespace webrtc {
+
+namespace {
+// Upper limits of all bins but the last, see LatencyHistogram.
+const int kBinLimitsMs[kLatencyHistogramBins - 1] =
+    {1, 2, 5, 10, 20, 50, 100, 200, 500};
+} // namespace
+
+LatencyStats::LatencyStats()
+    : _critSect(CriticalSectionWrapper::CreateCriticalSection())
+{
+    Reset();
+}
+
+LatencyStats::~LatencyStats()
+{
+    delete _critSect;
+}
+
+void LatencyStats::Add(const LatencyStage stage, const WebRtc_Word64 delayMs)
+{
+    if (delayMs < 0 || stage < 0 || stage >= kNumLatencyStages)
+    {
+        return;
+    }
+    const int delay = (delayMs > 0x7fffffff) ? 0x7fffffff :
+                                               static_cast<int>(delayMs);
+    int bin = 0;
+    while (bin < kLatencyHistogramBins - 1 && delay > kBinLimitsMs[bin])
+    {
+        bin++;
+    }
+
+    CriticalSectionScoped lock(_critSect);
+    LatencyHistogram& histogram = _statistics.stages[stage];
+    if (histogram.samples == 0 || delay < histogram.minMs)
+    {
+        histogram.minMs = delay;
+    }
+    if (delay > histogram.maxMs)
+    {
+        histogram.maxMs = delay;
+    }
+    histogram.samples++;
+    histogram.bins[bin]++;
+    _sumMs[stage] += delay;
+}
+
+void LatencyStats::GetStatistics(LatencyStatistics& statistics) const
+{
+    CriticalSectionScoped lock(_critSect);
+    statistics = _statistics;
+    for (int i = 0; i < kNumLatencyStages; i++)
+    {
+        if (statistics.stages[i].samples > 0)
+        {
+            statistics.stages[i].averageMs = static_cast<int>(
+                _sumMs[i] / statistics.stages[i].samples);
+        }
+    }
+}
+
+void LatencyStats::Reset()
+{
+    CriticalSectionScoped lock(_critSect);
+    memset(&_statistics, 0, sizeof(_statistics));
+    memset(_sumMs, 0, sizeof(_sumMs));
+}
+} // namespace webrtc
@@ -0,0 +1,60 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "gtest/gtest.h"
+
+#include "system_wrappers/interface/latency_stats.h"
+
+using ::webrtc::LatencyHistogram;
+using ::webrtc::LatencyStatistics;
+using ::webrtc::LatencyStats;
+
+TEST(LatencyStatsTest, StartsEmpty) {
+    LatencyStats stats;
+    LatencyStatistics statistics;
+    stats.GetStatistics(statistics);
+    for (int i = 0; i < webrtc::kNumLatencyStages; ++i) {
+        EXPECT_EQ(0u, statistics.stages[i].samples);
+        EXPECT_EQ(0, statistics.stages[i].maxMs);
+    }
+}
+
+TEST(LatencyStatsTest, BinsSamplesPerStage) {
+    LatencyStats stats;
+    stats.Add(webrtc::kLatencyDecode, 0);
+    stats.Add(webrtc::kLatencyDecode, 1);
+    stats.Add(webrtc::kLatencyDecode, 7);
+    stats.Add(webrtc::kLatencyDecode, 500);
+    stats.Add(webrtc::kLatencyDecode, 2000);
+    stats.Add(webrtc::kLatencyDecode, -1);  // Ignored.
+    stats.Add(webrtc::kLatencyRender, 30);
+
+    LatencyStatistics statistics;
+    stats.GetStatistics(statistics);
+    const LatencyHistogram& decode = statistics.stages[webrtc::kLatencyDecode];
+    EXPECT_EQ(5u, decode.samples);
+    EXPECT_EQ(0, decode.minMs);
+    EXPECT_EQ(2000, decode.maxMs);
+    EXPECT_EQ((0 + 1 + 7 + 500 + 2000) / 5, decode.averageMs);
+    EXPECT_EQ(2u, decode.bins[0]);  // <= 1 ms
+    EXPECT_EQ(1u, decode.bins[3]);  // <= 10 ms
+    EXPECT_EQ(1u, decode.bins[8]);  // <= 500 ms
+    EXPECT_EQ(1u, decode.bins[9]);  // > 500 ms
+
+    const LatencyHistogram& render = statistics.stages[webrtc::kLatencyRender];
+    EXPECT_EQ(1u, render.samples);
+    EXPECT_EQ(30, render.minMs);
+    EXPECT_EQ(1u, render.bins[5]);  // <= 50 ms
+    EXPECT_EQ(0u, statistics.stages[webrtc::kLatencyEncode].samples);
+
+    stats.Reset();
+    stats.GetStatistics(statistics);
+    EXPECT_EQ(0u, statistics.stages[webrtc::kLatencyDecode].samples);
+}
@@ -24,6 +24,7 @@
       'sources': [
         '../interface/aligned_malloc.h',
         '../interface/atomic32_wrapper.h',
+        '../interface/clock.h',
         '../interface/condition_variable_wrapper.h',
         '../interface/cpu_info.h',
         '../interface/cpu_wrapper.h',
@@ -35,6 +36,7 @@
         '../interface/event_wrapper.h',
         '../interface/file_wrapper.h',
         '../interface/fix_interlocked_exchange_pointer_win.h',
+        '../interface/latency_stats.h',
         '../interface/list_wrapper.h',
         '../interface/map_wrapper.h',
         '../interface/ref_count.h',
@@ -51,6 +53,7 @@
         'atomic32_linux.h',
         'atomic32_mac.h',
         'atomic32_win.h',
+        'clock.cc',
         'condition_variable.cc',
         'condition_variable_posix.cc',
         'condition_variable_posix.h',
@@ -81,6 +84,7 @@
         'event_win.h',
         'file_impl.cc',
         'file_impl.h',
+        'latency_stats.cc',
         'list_no_stl.cc',
         'map.cc',
         'rw_lock.cc',
@@ -158,7 +162,9 @@
             '<(webrtc_root)/../test/test.gyp:test_support_main',
           ],
           'sources': [
+            'clock_unittest.cc',
             'cpu_wrapper_unittest.cc',
+            'latency_stats_unittest.cc',
             'list_unittest.cc',
             'map_unittest.cc',
             'data_log_unittest.cc',
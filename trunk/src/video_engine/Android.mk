@@ -20,6 +20,7 @@ LOCAL_SRC_FILES := \
     vie_base_impl.cc \
     vie_capture_impl.cc \
     vie_codec_impl.cc \
+    vie_compositor_impl.cc \
     vie_encryption_impl.cc \
     vie_external_codec_impl.cc \
     vie_file_impl.cc \
@@ -37,6 +38,7 @@ LOCAL_SRC_FILES := \
     vie_file_image.cc \
     vie_file_player.cc \
     vie_file_recorder.cc \
+    vie_frame_compositor.cc \
     vie_frame_provider_base.cc \
     vie_input_manager.cc \
     vie_manager_base.cc \
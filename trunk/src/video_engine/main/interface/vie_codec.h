@@ -144,6 +144,16 @@ public:
     // arrived too late.
     virtual unsigned int GetDiscardedPackets(const int videoChannel) const = 0;
 
+    // Gets latency histograms for the stages of the media pipeline of
+    // |videoChannel|, from captured frames to packets handed to the transport
+    // on the sending side and from received packets to rendered frames on the
+    // receiving side.
+    virtual int GetLatencyStatistics(const int videoChannel,
+                                     LatencyStatistics& statistics) const = 0;
+
+    // Clears the latency histograms of |videoChannel|.
+    virtual int ResetLatencyStatistics(const int videoChannel) = 0;
+
     // Enables key frame request callback in ViEDecoderObserver.
     virtual int SetKeyFrameRequestCallbackStatus(const int videoChannel,
                                                  const bool enable) = 0;
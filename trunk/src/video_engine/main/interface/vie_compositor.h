@@ -0,0 +1,83 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// This sub-API supports the following functionalities:
+//  - Allocating compositors, which combine the decoded video of several
+//    channels into one picture.
+//  - Placing incoming video streams in the layout of a compositor.
+//  - Connecting a compositor to a channel to send the combined picture.
+//
+// The compositor id can also be used as render id in ViERender.
+
+
+#ifndef WEBRTC_VIDEO_ENGINE_MAIN_INTERFACE_VIE_COMPOSITOR_H_
+#define WEBRTC_VIDEO_ENGINE_MAIN_INTERFACE_VIE_COMPOSITOR_H_
+
+#include "common_types.h"
+
+namespace webrtc
+{
+class VideoEngine;
+
+// ----------------------------------------------------------------------------
+//	ViECompositor
+// ----------------------------------------------------------------------------
+
+class WEBRTC_DLLEXPORT ViECompositor
+{
+public:
+    // Factory for the ViECompositor sub‐API and increases an internal
+    // reference counter if successful. Returns NULL if the API is not
+    // supported or if construction fails.
+    static ViECompositor* GetInterface(VideoEngine* videoEngine);
+
+    // Releases the ViECompositor sub-API and decreases an internal reference
+    // counter. Returns the new reference count. This value should be zero
+    // for all sub-API:s before the VideoEngine object can be safely deleted.
+    virtual int Release() = 0;
+
+    // Allocates a compositor producing width x height pictures, at most
+    // maxFrameRate per second. A picture is only produced when one of its
+    // streams has delivered a new frame or the layout has changed.
+    virtual int AllocateCompositor(const unsigned int width,
+                                   const unsigned int height,
+                                   const unsigned int maxFrameRate,
+                                   int& compositorId) = 0;
+
+    // Releases a compositor. Any streams still added are removed.
+    virtual int ReleaseCompositor(const int compositorId) = 0;
+
+    // Places the decoded video of videoChannel in the compositor. The
+    // position is given as for ViERender::AddRenderer(), with coordinates
+    // between 0.0 and 1.0 of the picture, and streams with a higher zOrder
+    // are drawn on top.
+    virtual int AddStream(const int compositorId, const int videoChannel,
+                          const unsigned int zOrder, const float left,
+                          const float top, const float right,
+                          const float bottom) = 0;
+
+    // Removes the video of videoChannel from the compositor.
+    virtual int RemoveStream(const int compositorId,
+                             const int videoChannel) = 0;
+
+    // Sends the composed picture on videoChannel, in place of a capture
+    // device or file.
+    virtual int ConnectCompositor(const int compositorId,
+                                  const int videoChannel) = 0;
+
+    // Stops sending the composed picture on videoChannel.
+    virtual int DisconnectCompositor(const int videoChannel) = 0;
+
+protected:
+    ViECompositor() {};
+    virtual ~ViECompositor() {};
+};
+} // namespace webrtc
+#endif  // WEBRTC_VIDEO_ENGINE_MAIN_INTERFACE_VIE_COMPOSITOR_H_
@@ -115,7 +115,18 @@ enum ViEErrors {
     kViEImageProcessFilterDoesNotExist,        // DeRegisterCaptureEffectFilter,DeRegisterSendEffectFilter,DeRegisterRenderEffectFilter - Effect filter not registered.
     kViEImageProcessAlreadyEnabled,            // EnableDeflickering,EnableDenoising,EnableColorEnhancement- Function already enabled.
     kViEImageProcessAlreadyDisabled,           // EnableDeflickering,EnableDenoising,EnableColorEnhancement- Function already disabled.
-    kViEImageProcessUnknownError               // An unknown error has occurred. Check the log file.
+    kViEImageProcessUnknownError,              // An unknown error has occurred. Check the log file.
+
+    //ViECompositor
+    kViECompositorInvalidChannelId = 12900,   // No Channel exist with the provided channel id.
+    kViECompositorInvalidArgument,            // AllocateCompositor, AddStream - Incorrect picture size, frame rate or stream position.
+    kViECompositorMaxNoOfCompositors,         // AllocateCompositor - Maximum supported number of compositors already allocated.
+    kViECompositorDoesNotExist,               // No compositor exist with the provided compositor id.
+    kViECompositorStreamAlreadyAdded,         // AddStream - The channel is already placed in the compositor.
+    kViECompositorStreamNotAdded,             // RemoveStream - The channel is not placed in the compositor.
+    kViECompositorInputAlreadyConnected,      // ConnectCompositor - The video channel already have a connected input.
+    kViECompositorNotConnected,               // DisconnectCompositor - No compositor is connected to the channel.
+    kViECompositorUnknownError                // An unknown error has occurred. Check the log file.
 };
 
 #endif  // WEBRTC_VIDEO_ENGINE_MAIN_INTERFACE_VIE_ERRORS_H_
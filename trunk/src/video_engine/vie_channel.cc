@@ -52,7 +52,7 @@ ViEChannel::ViEChannel(WebRtc_Word32 channel_id,
 #endif
   vcm_(*VideoCodingModule::Create(ViEModuleId(engine_id, channel_id))),
   vie_receiver_(*(new ViEReceiver(engine_id, channel_id, rtp_rtcp_, vcm_))),
-  vie_sender_(*(new ViESender(engine_id, channel_id))),
+  vie_sender_(*(new ViESender(engine_id, channel_id, &latency_stats_))),
   vie_sync_(*(new ViESyncModule(ViEId(engine_id, channel_id), vcm_,
                                 rtp_rtcp_))),
   module_process_thread_(module_process_thread),
@@ -154,6 +154,11 @@ WebRtc_Word32 ViEChannel::Init() {
                  "%s: VCM::RegisterReceiveStatisticsCallback failure",
                  __FUNCTION__);
   }
+  if (vcm_.RegisterReceiveLatencyCallback(this) != 0) {
+    WEBRTC_TRACE(kTraceWarning, kTraceVideo, ViEId(engine_id_, channel_id_),
+                 "%s: VCM::RegisterReceiveLatencyCallback failure",
+                 __FUNCTION__);
+  }
   if (vcm_.SetRenderDelay(kViEDefaultRenderDelayMs) != 0) {
     WEBRTC_TRACE(kTraceWarning, kTraceVideo, ViEId(engine_id_, channel_id_),
                  "%s: VCM::SetRenderDelay failure", __FUNCTION__);
@@ -515,6 +520,14 @@ WebRtc_UWord32 ViEChannel::DiscardedPackets() const {
   return vcm_.DiscardedPackets();
 }
 
+void ViEChannel::GetLatencyStatistics(LatencyStatistics& statistics) const {
+  latency_stats_.GetStatistics(statistics);
+}
+
+void ViEChannel::ResetLatencyStatistics() {
+  latency_stats_.Reset();
+}
+
 WebRtc_Word32 ViEChannel::WaitForKeyFrame(bool wait) {
   WEBRTC_TRACE(kTraceInfo, kTraceVideo, ViEId(engine_id_, channel_id_),
                "%s(wait: %d)", __FUNCTION__, wait);
@@ -522,6 +535,12 @@ WebRtc_Word32 ViEChannel::WaitForKeyFrame(bool wait) {
   return 0;
 }
 
+void ViEChannel::SetNumberOfCores(WebRtc_UWord32 number_of_cores) {
+  WEBRTC_TRACE(kTraceInfo, kTraceVideo, ViEId(engine_id_, channel_id_),
+               "%s(number_of_cores: %u)", __FUNCTION__, number_of_cores);
+  number_of_cores_ = number_of_cores;
+}
+
 WebRtc_Word32 ViEChannel::SetSignalPacketLossStatus(bool enable,
                                                     bool only_key_frames) {
   WEBRTC_TRACE(kTraceInfo, kTraceVideo, ViEId(engine_id_, channel_id_),
@@ -2077,6 +2096,10 @@ WebRtc_Word32 ViEChannel::DeregisterSendRtpRtcpModule() {
 }
 
 WebRtc_Word32 ViEChannel::FrameToRender(VideoFrame& video_frame) {
+  // The frame is held by the renderer until its render time.
+  latency_stats_.Add(kLatencyRender, video_frame.RenderTimeMs() -
+                                     TickTime::MillisecondTimestamp());
+
   CriticalSectionScoped cs(callbackCritsect_);
 
   if (decoder_reset_) {
@@ -2100,6 +2123,9 @@ WebRtc_Word32 ViEChannel::FrameToRender(VideoFrame& video_frame) {
     decoder_reset_ = false;
   }
   if (effect_filter_) {
+    // The frame may reference the decoder's picture, which must not be
+    // modified in place.
+    video_frame.Materialize();
     effect_filter_->Transform(video_frame.Length(), video_frame.Buffer(),
                               video_frame.TimeStamp(), video_frame.Width(),
                               video_frame.Height());
@@ -2121,6 +2147,11 @@ WebRtc_Word32 ViEChannel::FrameToRender(VideoFrame& video_frame) {
   return 0;
 }
 
+bool ViEChannel::AcceptsFramePlanes() const {
+  // Frame observers copy or materialize the frame if they keep it.
+  return true;
+}
+
 WebRtc_Word32 ViEChannel::ReceivedDecodedReferenceFrame(
   const WebRtc_UWord64 picture_id) {
   return rtp_rtcp_.SendRTCPReferencePictureSelection(picture_id);
@@ -2143,6 +2174,12 @@ WebRtc_Word32 ViEChannel::ReceiveStatistics(const WebRtc_UWord32 bit_rate,
   return 0;
 }
 
+void ViEChannel::FrameLatency(const WebRtc_Word32 jitter_buffer_ms,
+                              const WebRtc_Word32 decode_ms) {
+  latency_stats_.Add(kLatencyJitterBuffer, jitter_buffer_ms);
+  latency_stats_.Add(kLatencyDecode, decode_ms);
+}
+
 WebRtc_Word32 ViEChannel::FrameTypeRequest(const FrameType frame_type) {
   WEBRTC_TRACE(kTraceStream, kTraceVideo, ViEId(engine_id_, channel_id_),
                "%s(frame_type: %d)", __FUNCTION__, frame_type);
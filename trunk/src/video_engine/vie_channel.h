@@ -18,6 +18,7 @@
 #include "modules/rtp_rtcp/interface/rtp_rtcp_defines.h"
 #include "modules/udp_transport/interface/udp_transport.h"
 #include "modules/video_coding/main/interface/video_coding_defines.h"
+#include "system_wrappers/interface/latency_stats.h"
 #include "system_wrappers/interface/tick_util.h"
 #include "typedefs.h"
 #include "video_engine/main/interface/vie_network.h"
@@ -50,6 +51,7 @@ class ViEChannel
     : public VCMFrameTypeCallback,
       public VCMReceiveCallback,
       public VCMReceiveStatisticsCallback,
+      public VCMReceiveLatencyCallback,
       public VCMPacketRequestCallback,
       public VCMFrameStorageCallback,
       public RtcpFeedback,
@@ -82,10 +84,17 @@ class ViEChannel
   WebRtc_Word32 ReceiveCodecStatistics(WebRtc_UWord32& num_key_frames,
                                        WebRtc_UWord32& num_delta_frames);
   WebRtc_UWord32 DiscardedPackets() const;
+  // Latency of the transport stage and of the receive side stages.
+  void GetLatencyStatistics(LatencyStatistics& statistics) const;
+  void ResetLatencyStatistics();
 
   // Only affects calls to SetReceiveCodec done after this call.
   WebRtc_Word32 WaitForKeyFrame(bool wait);
 
+  // Number of cores for the decoders. Only affects calls to SetReceiveCodec
+  // done after this call.
+  void SetNumberOfCores(WebRtc_UWord32 number_of_cores);
+
   // If enabled, a key frame request will be sent as soon as there are lost
   // packets. If |only_key_frames| are set, requests are only sent for loss in
   // key frames.
@@ -296,6 +305,9 @@ class ViEChannel
   virtual WebRtc_Word32 ReceivedDecodedReferenceFrame(
       const WebRtc_UWord64 picture_id);
 
+  // Implements VCMReceiveCallback.
+  virtual bool AcceptsFramePlanes() const;
+
   // Implements VCM.
   virtual WebRtc_Word32 StoreReceivedFrame(
       const EncodedVideoData& frame_to_store);
@@ -304,6 +316,10 @@ class ViEChannel
   virtual WebRtc_Word32 ReceiveStatistics(const WebRtc_UWord32 bit_rate,
                                           const WebRtc_UWord32 frame_rate);
 
+  // Implements VCMReceiveLatencyCallback.
+  virtual void FrameLatency(const WebRtc_Word32 jitter_buffer_ms,
+                            const WebRtc_Word32 decode_ms);
+
   // Implements VideoFrameTypeCallback.
   virtual WebRtc_Word32 FrameTypeRequest(const FrameType frame_type);
 
@@ -354,6 +370,9 @@ class ViEChannel
   // Used for all registered callbacks except rendering.
   CriticalSectionWrapper& callbackCritsect_;
 
+  // Filled in by the sender, the VCM and FrameToRender().
+  LatencyStats latency_stats_;
+
   // Owned modules/classes.
   RtpRtcp& rtp_rtcp_;
   RtpRtcp* default_rtp_rtcp_;
@@ -10,6 +10,8 @@
 
 #include "video_engine/vie_channel_manager.h"
 
+#include <algorithm>
+
 #include "engine_configurations.h"
 #include "modules/utility/interface/process_thread.h"
 #include "system_wrappers/interface/critical_section_wrapper.h"
@@ -74,6 +76,8 @@ void ViEChannelManager::SetModuleProcessThread(
 }
 
 int ViEChannelManager::CreateChannel(int& channel_id) {
+  // Write lock to rebalance the cores of the other channels.
+  ViEManagerWriteScoped wl(*this);
   CriticalSectionScoped cs(*channel_id_critsect_);
 
   // Get a free id for the new channel.
@@ -83,8 +87,9 @@ int ViEChannelManager::CreateChannel(int& channel_id) {
     return -1;
   }
 
+  const int cores_per_channel = NumberOfCoresPerChannel();
   ViEChannel* vie_channel = new ViEChannel(channel_id, engine_id_,
-                                           number_of_cores_,
+                                           cores_per_channel,
                                            *module_process_thread_);
   if (!vie_channel) {
     ReturnChannelId(channel_id);
@@ -101,7 +106,7 @@ int ViEChannelManager::CreateChannel(int& channel_id) {
 
   // There is no ViEEncoder for this channel, create one with default settings.
   ViEEncoder* vie_encoder = new ViEEncoder(engine_id_, channel_id,
-                                           number_of_cores_,
+                                           cores_per_channel,
                                            *module_process_thread_);
   if (!vie_encoder) {
     WEBRTC_TRACE(kTraceError, kTraceVideo, ViEId(engine_id_),
@@ -134,6 +139,7 @@ int ViEChannelManager::CreateChannel(int& channel_id) {
                  channel_id);
     return -1;
   }
+  RebalanceCores();
   return 0;
 }
 
@@ -165,8 +171,11 @@ int ViEChannelManager::CreateChannel(int& channel_id, int original_channel) {
                  "Max number of channels reached: %d", channel_map_.Size());
     return -1;
   }
+  // The caller holds a read lock, so the other channels can't be rebalanced
+  // here. They are at the next CreateChannel() or DeleteChannel().
+  const int cores_per_channel = NumberOfCoresPerChannel();
   ViEChannel* vie_channel = new ViEChannel(channel_id, engine_id_,
-                                           number_of_cores_,
+                                           cores_per_channel,
                                            *module_process_thread_);
   if (!vie_channel) {
     ReturnChannelId(channel_id);
@@ -267,6 +276,7 @@ int ViEChannelManager::DeleteChannel(int channel_id) {
     // We can't erase the item before we've checked for other channels using
     // same ViEEncoder.
     vie_encoder_map_.Erase(map_item);
+    RebalanceCores();
   }
 
   // Leave the write critsect before deleting the objects.
@@ -409,6 +419,38 @@ void ViEChannelManager::ReturnChannelId(int channel_id) {
   free_channel_ids_[channel_id - kViEChannelIdBase] = true;
 }
 
+int ViEChannelManager::NumberOfCoresPerChannel() const {
+  CriticalSectionScoped cs(*channel_id_critsect_);
+  // Split the cores evenly between the existing channels and the one about
+  // to be created, but always allow at least one.
+  const int number_of_channels = channel_map_.Size() + 1;
+  if (number_of_cores_ <= number_of_channels) {
+    return 1;
+  }
+  return number_of_cores_ / number_of_channels;
+}
+
+void ViEChannelManager::RebalanceCores() {
+  CriticalSectionScoped cs(*channel_id_critsect_);
+  const int number_of_channels = channel_map_.Size();
+  if (number_of_channels == 0) {
+    return;
+  }
+  const int cores_per_channel = std::max(1,
+                                         number_of_cores_ / number_of_channels);
+  for (MapItem* item = channel_map_.First(); item != NULL;
+       item = channel_map_.Next(item)) {
+    static_cast<ViEChannel*>(item->GetItem())->SetNumberOfCores(
+        cores_per_channel);
+  }
+  // Channels sharing an encoder set the same value twice, which is a no-op.
+  for (MapItem* item = vie_encoder_map_.First(); item != NULL;
+       item = vie_encoder_map_.Next(item)) {
+    static_cast<ViEEncoder*>(item->GetItem())->SetNumberOfCores(
+        cores_per_channel);
+  }
+}
+
 bool ViEChannelManager::ChannelUsingViEEncoder(int channel_id) const {
   CriticalSectionScoped cs(*channel_id_critsect_);
   MapItem* channel_item = vie_encoder_map_.Find(channel_id);
@@ -76,6 +76,16 @@ class ViEChannelManager: private ViEManagerBase {
   // Returns a previously allocated channel id.
   void ReturnChannelId(int channel_id);
 
+  // Returns the number of cores the codecs of a new channel may use, so that
+  // many simultaneous channels don't oversubscribe the machine.
+  int NumberOfCoresPerChannel() const;
+
+  // Splits the cores evenly between the existing channels and their
+  // encoders. The new counts apply from the next codec change, so running
+  // encoders are not re-created. Must be called with the manager write
+  // locked, since the codec settings are read under the read lock.
+  void RebalanceCores();
+
   // Returns true if at least one other channels uses the same ViEEncoder as
   // channel_id.
   bool ChannelUsingViEEncoder(int channel_id) const;
@@ -0,0 +1,134 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video_engine/vie_channel_manager.h"
+
+#include "gtest/gtest.h"
+#include "modules/utility/interface/process_thread.h"
+#include "modules/video_coding/codecs/interface/video_codec_interface.h"
+#include "modules/video_coding/main/interface/video_coding.h"
+#include "video_engine/vie_encoder.h"
+#include "video_engine/vie_performance_monitor.h"
+
+namespace webrtc {
+
+namespace {
+
+const int kNumberOfCores = 4;
+
+// Counts how often it is (re-)initialized.
+class FakeEncoder : public VideoEncoder {
+ public:
+  FakeEncoder() : init_encode_calls_(0), number_of_cores_(0) {}
+
+  virtual WebRtc_Word32 Version(WebRtc_Word8* /*version*/,
+                                WebRtc_Word32 /*length*/) const {
+    return 0;
+  }
+  virtual WebRtc_Word32 InitEncode(const VideoCodec* /*codec_settings*/,
+                                   WebRtc_Word32 number_of_cores,
+                                   WebRtc_UWord32 /*max_payload_size*/) {
+    ++init_encode_calls_;
+    number_of_cores_ = number_of_cores;
+    return WEBRTC_VIDEO_CODEC_OK;
+  }
+  virtual WebRtc_Word32 Encode(const RawImage& /*input_image*/,
+                               const CodecSpecificInfo* /*codec_specific*/,
+                               const VideoFrameType* /*frame_types*/) {
+    return WEBRTC_VIDEO_CODEC_OK;
+  }
+  virtual WebRtc_Word32 RegisterEncodeCompleteCallback(
+      EncodedImageCallback* /*callback*/) {
+    return WEBRTC_VIDEO_CODEC_OK;
+  }
+  virtual WebRtc_Word32 Release() { return WEBRTC_VIDEO_CODEC_OK; }
+  virtual WebRtc_Word32 Reset() { return WEBRTC_VIDEO_CODEC_OK; }
+  virtual WebRtc_Word32 SetChannelParameters(WebRtc_UWord32 /*packet_loss*/,
+                                             int /*rtt*/) {
+    return WEBRTC_VIDEO_CODEC_OK;
+  }
+  virtual WebRtc_Word32 SetRates(WebRtc_UWord32 /*new_bit_rate*/,
+                                 WebRtc_UWord32 /*frame_rate*/) {
+    return WEBRTC_VIDEO_CODEC_OK;
+  }
+
+  int init_encode_calls() const { return init_encode_calls_; }
+  int number_of_cores() const { return number_of_cores_; }
+
+ private:
+  int init_encode_calls_;
+  int number_of_cores_;
+};
+
+}  // namespace
+
+class ViEChannelManagerTest : public ::testing::Test {
+ protected:
+  ViEChannelManagerTest()
+      : process_thread_(ProcessThread::CreateProcessThread()),
+        performance_monitor_(0),
+        channel_manager_(new ViEChannelManager(0, kNumberOfCores,
+                                               performance_monitor_)) {
+    channel_manager_->SetModuleProcessThread(*process_thread_);
+  }
+
+  virtual ~ViEChannelManagerTest() {
+    delete channel_manager_;
+    ProcessThread::DestroyProcessThread(process_thread_);
+  }
+
+  // Makes |encoder_| the send codec of |channel_id|.
+  void SetExternalEncoder(int channel_id) {
+    ViEChannelManagerScoped cs(*channel_manager_);
+    ViEEncoder* vie_encoder = cs.Encoder(channel_id);
+    ASSERT_TRUE(vie_encoder != NULL);
+    VideoCodec codec;
+    ASSERT_EQ(VCM_OK, VideoCodingModule::Codec(kVideoCodecI420, &codec));
+    ASSERT_EQ(0, vie_encoder->RegisterExternalEncoder(&encoder_,
+                                                      codec.plType));
+    ASSERT_EQ(0, vie_encoder->SetEncoder(codec));
+  }
+
+  ProcessThread* process_thread_;
+  ViEPerformanceMonitor performance_monitor_;
+  ViEChannelManager* channel_manager_;
+  FakeEncoder encoder_;
+};
+
+TEST_F(ViEChannelManagerTest, NewChannelDoesNotRecreateRunningEncoder) {
+  int first_channel = -1;
+  ASSERT_EQ(0, channel_manager_->CreateChannel(first_channel));
+  SetExternalEncoder(first_channel);
+  EXPECT_EQ(1, encoder_.init_encode_calls());
+  EXPECT_EQ(kNumberOfCores, encoder_.number_of_cores());
+
+  // The running encoder keeps its cores, and its stream, when a channel is
+  // added or deleted.
+  int second_channel = -1;
+  ASSERT_EQ(0, channel_manager_->CreateChannel(second_channel));
+  EXPECT_EQ(1, encoder_.init_encode_calls());
+  ASSERT_EQ(0, channel_manager_->DeleteChannel(second_channel));
+  ASSERT_EQ(0, channel_manager_->CreateChannel(second_channel));
+  EXPECT_EQ(1, encoder_.init_encode_calls());
+
+  // The next codec change uses the share of the two channels.
+  SetExternalEncoder(first_channel);
+  EXPECT_EQ(2, encoder_.init_encode_calls());
+  EXPECT_EQ(kNumberOfCores / 2, encoder_.number_of_cores());
+
+  // Deregister before |encoder_| goes away.
+  VideoCodec codec;
+  ASSERT_EQ(VCM_OK, VideoCodingModule::Codec(kVideoCodecI420, &codec));
+  ViEChannelManagerScoped cs(*channel_manager_);
+  EXPECT_EQ(0, cs.Encoder(first_channel)->DeRegisterExternalEncoder(
+      codec.plType));
+}
+
+}  // namespace webrtc
@@ -598,6 +598,57 @@ unsigned int ViECodecImpl::GetDiscardedPackets(const int videoChannel) const {
   return vieChannel->DiscardedPackets();
 }
 
+int ViECodecImpl::GetLatencyStatistics(const int videoChannel,
+                                       LatencyStatistics& statistics) const {
+  WEBRTC_TRACE(webrtc::kTraceApiCall, webrtc::kTraceVideo,
+               ViEId(instance_id_, videoChannel),
+               "%s(videoChannel: %d)", __FUNCTION__, videoChannel);
+
+  ViEChannelManagerScoped cs(channel_manager_);
+  ViEChannel* vieChannel = cs.Channel(videoChannel);
+  ViEEncoder* vieEncoder = cs.Encoder(videoChannel);
+  if (vieChannel == NULL || vieEncoder == NULL)
+  {
+    WEBRTC_TRACE(webrtc::kTraceError, webrtc::kTraceVideo,
+                 ViEId(instance_id_, videoChannel), "%s: No channel %d",
+                 __FUNCTION__, videoChannel);
+    SetLastError(kViECodecInvalidChannelId);
+    return -1;
+  }
+  // The channel measures the transport and the receiving side, the encoder,
+  // which may be shared with other channels, the stages before it.
+  vieChannel->GetLatencyStatistics(statistics);
+  LatencyStatistics encoderStatistics;
+  vieEncoder->GetLatencyStatistics(encoderStatistics);
+  for (int stage = kLatencyCaptureToEncode; stage <= kLatencyPacketize;
+       stage++)
+  {
+    statistics.stages[stage] = encoderStatistics.stages[stage];
+  }
+  return 0;
+}
+
+int ViECodecImpl::ResetLatencyStatistics(const int videoChannel) {
+  WEBRTC_TRACE(webrtc::kTraceApiCall, webrtc::kTraceVideo,
+               ViEId(instance_id_, videoChannel),
+               "%s(videoChannel: %d)", __FUNCTION__, videoChannel);
+
+  ViEChannelManagerScoped cs(channel_manager_);
+  ViEChannel* vieChannel = cs.Channel(videoChannel);
+  ViEEncoder* vieEncoder = cs.Encoder(videoChannel);
+  if (vieChannel == NULL || vieEncoder == NULL)
+  {
+    WEBRTC_TRACE(webrtc::kTraceError, webrtc::kTraceVideo,
+                 ViEId(instance_id_, videoChannel), "%s: No channel %d",
+                 __FUNCTION__, videoChannel);
+    SetLastError(kViECodecInvalidChannelId);
+    return -1;
+  }
+  vieChannel->ResetLatencyStatistics();
+  vieEncoder->ResetLatencyStatistics();
+  return 0;
+}
+
 // Callbacks
 // ----------------------------------------------------------------------------
 // SetKeyFrameRequestCallbackStatus
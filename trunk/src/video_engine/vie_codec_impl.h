@@ -74,6 +74,10 @@ public:
 
     virtual unsigned int GetDiscardedPackets(const int videoChannel) const;
 
+    virtual int GetLatencyStatistics(const int videoChannel,
+                                     LatencyStatistics& statistics) const;
+    virtual int ResetLatencyStatistics(const int videoChannel);
+
     // Callbacks
     virtual int SetKeyFrameRequestCallbackStatus(const int videoChannel,
                                                  const bool enable);
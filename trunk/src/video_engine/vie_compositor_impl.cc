@@ -0,0 +1,275 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video_engine/vie_compositor_impl.h"
+
+#include "system_wrappers/interface/trace.h"
+#include "video_engine/main/interface/vie_errors.h"
+#include "video_engine/vie_channel.h"
+#include "video_engine/vie_channel_manager.h"
+#include "video_engine/vie_defines.h"
+#include "video_engine/vie_encoder.h"
+#include "video_engine/vie_frame_compositor.h"
+#include "video_engine/vie_impl.h"
+#include "video_engine/vie_input_manager.h"
+
+namespace webrtc {
+
+ViECompositor* ViECompositor::GetInterface(VideoEngine* video_engine) {
+#ifdef WEBRTC_VIDEO_ENGINE_COMPOSITOR_API
+  if (!video_engine) {
+    return NULL;
+  }
+  VideoEngineImpl* vie_impl = reinterpret_cast<VideoEngineImpl*>(video_engine);
+  ViECompositorImpl* vie_compositor_impl = vie_impl;
+  // Increase ref count.
+  (*vie_compositor_impl)++;
+  return vie_compositor_impl;
+#else
+  return NULL;
+#endif
+}
+
+int ViECompositorImpl::Release() {
+  WEBRTC_TRACE(kTraceApiCall, kTraceVideo, instance_id_,
+               "ViECompositor::Release()");
+  // Decrease ref count
+  (*this)--;
+
+  WebRtc_Word32 ref_count = GetCount();
+  if (ref_count < 0) {
+    WEBRTC_TRACE(kTraceWarning, kTraceVideo, instance_id_,
+                 "ViECompositor release too many times");
+    SetLastError(kViEAPIDoesNotExist);
+    return -1;
+  }
+  WEBRTC_TRACE(kTraceInfo, kTraceVideo, instance_id_,
+               "ViECompositor reference count: %d", ref_count);
+  return ref_count;
+}
+
+ViECompositorImpl::ViECompositorImpl() {
+  WEBRTC_TRACE(kTraceMemory, kTraceVideo, instance_id_,
+               "ViECompositorImpl::ViECompositorImpl() Ctor");
+}
+
+ViECompositorImpl::~ViECompositorImpl() {
+  WEBRTC_TRACE(kTraceMemory, kTraceVideo, instance_id_,
+               "ViECompositorImpl::~ViECompositorImpl() Dtor");
+}
+
+int ViECompositorImpl::AllocateCompositor(const unsigned int width,
+                                          const unsigned int height,
+                                          const unsigned int max_frame_rate,
+                                          int& compositor_id) {
+  WEBRTC_TRACE(kTraceApiCall, kTraceVideo, ViEId(instance_id_),
+               "%s(%ux%u, max_frame_rate: %u)", __FUNCTION__, width, height,
+               max_frame_rate);
+  if (!Initialized()) {
+    SetLastError(kViENotInitialized);
+    WEBRTC_TRACE(kTraceError, kTraceVideo, ViEId(instance_id_),
+                 "%s - ViE instance %d not initialized", __FUNCTION__,
+                 instance_id_);
+    return -1;
+  }
+  if (width < 2 || width > kViEMaxCodecWidth ||
+      height < 2 || height > kViEMaxCodecHeight ||
+      max_frame_rate < 1 || max_frame_rate > kViEMaxCodecFramerate) {
+    WEBRTC_TRACE(kTraceError, kTraceVideo, ViEId(instance_id_),
+                 "%s: Invalid picture size or frame rate", __FUNCTION__);
+    SetLastError(kViECompositorInvalidArgument);
+    return -1;
+  }
+  const int result = input_manager_.CreateCompositor(width, height,
+                                                     max_frame_rate,
+                                                     compositor_id);
+  if (result != 0) {
+    SetLastError(result);
+    return -1;
+  }
+  return 0;
+}
+
+int ViECompositorImpl::ReleaseCompositor(const int compositor_id) {
+  WEBRTC_TRACE(kTraceApiCall, kTraceVideo, ViEId(instance_id_),
+               "%s(compositor_id: %d)", __FUNCTION__, compositor_id);
+  {
+    ViEInputManagerScoped is(input_manager_);
+    ViEFrameCompositor* vie_compositor = is.Compositor(compositor_id);
+    if (!vie_compositor) {
+      WEBRTC_TRACE(kTraceError, kTraceVideo, ViEId(instance_id_),
+                   "%s: Compositor %d doesn't exist", __FUNCTION__,
+                   compositor_id);
+      SetLastError(kViECompositorDoesNotExist);
+      return -1;
+    }
+    // Remove the streams while the channels are kept alive, as in
+    // RemoveStream(). The compositor is deleted without the channel manager
+    // lock, so it must not use its providers then.
+    ViEChannelManagerScoped cs(channel_manager_);
+    vie_compositor->Close();
+  }
+  return input_manager_.DestroyCompositor(compositor_id);
+}
+
+int ViECompositorImpl::AddStream(const int compositor_id,
+                                 const int video_channel,
+                                 const unsigned int z_order,
+                                 const float left, const float top,
+                                 const float right, const float bottom) {
+  WEBRTC_TRACE(kTraceApiCall, kTraceVideo, ViEId(instance_id_, video_channel),
+               "%s(compositor_id: %d, video_channel: %d)", __FUNCTION__,
+               compositor_id, video_channel);
+
+  ViEInputManagerScoped is(input_manager_);
+  ViEFrameCompositor* vie_compositor = is.Compositor(compositor_id);
+  if (!vie_compositor) {
+    WEBRTC_TRACE(kTraceError, kTraceVideo, ViEId(instance_id_, video_channel),
+                 "%s: Compositor %d doesn't exist", __FUNCTION__,
+                 compositor_id);
+    SetLastError(kViECompositorDoesNotExist);
+    return -1;
+  }
+
+  ViEChannelManagerScoped cs(channel_manager_);
+  ViEChannel* vie_channel = cs.Channel(video_channel);
+  if (!vie_channel) {
+    WEBRTC_TRACE(kTraceError, kTraceVideo, ViEId(instance_id_, video_channel),
+                 "%s: Channel %d doesn't exist", __FUNCTION__,
+                 video_channel);
+    SetLastError(kViECompositorInvalidChannelId);
+    return -1;
+  }
+  if (vie_compositor->HasStream(video_channel)) {
+    WEBRTC_TRACE(kTraceError, kTraceVideo, ViEId(instance_id_, video_channel),
+                 "%s: Channel %d already added to compositor %d",
+                 __FUNCTION__, video_channel, compositor_id);
+    SetLastError(kViECompositorStreamAlreadyAdded);
+    return -1;
+  }
+  if (left < 0.0f || top < 0.0f || right > 1.0f || bottom > 1.0f ||
+      left >= right || top >= bottom) {
+    WEBRTC_TRACE(kTraceError, kTraceVideo, ViEId(instance_id_, video_channel),
+                 "%s: Invalid stream position", __FUNCTION__);
+    SetLastError(kViECompositorInvalidArgument);
+    return -1;
+  }
+  if (vie_compositor->AddStream(vie_channel, z_order, left, top, right,
+                                bottom) != 0) {
+    SetLastError(kViECompositorUnknownError);
+    return -1;
+  }
+  return 0;
+}
+
+int ViECompositorImpl::RemoveStream(const int compositor_id,
+                                    const int video_channel) {
+  WEBRTC_TRACE(kTraceApiCall, kTraceVideo, ViEId(instance_id_, video_channel),
+               "%s(compositor_id: %d, video_channel: %d)", __FUNCTION__,
+               compositor_id, video_channel);
+
+  ViEInputManagerScoped is(input_manager_);
+  ViEFrameCompositor* vie_compositor = is.Compositor(compositor_id);
+  if (!vie_compositor) {
+    WEBRTC_TRACE(kTraceError, kTraceVideo, ViEId(instance_id_, video_channel),
+                 "%s: Compositor %d doesn't exist", __FUNCTION__,
+                 compositor_id);
+    SetLastError(kViECompositorDoesNotExist);
+    return -1;
+  }
+  // Keep the channel while the compositor deregisters from it.
+  ViEChannelManagerScoped cs(channel_manager_);
+  if (!vie_compositor->HasStream(video_channel)) {
+    WEBRTC_TRACE(kTraceError, kTraceVideo, ViEId(instance_id_, video_channel),
+                 "%s: Channel %d not added to compositor %d", __FUNCTION__,
+                 video_channel, compositor_id);
+    SetLastError(kViECompositorStreamNotAdded);
+    return -1;
+  }
+  if (vie_compositor->RemoveStream(video_channel) != 0) {
+    SetLastError(kViECompositorUnknownError);
+    return -1;
+  }
+  return 0;
+}
+
+int ViECompositorImpl::ConnectCompositor(const int compositor_id,
+                                         const int video_channel) {
+  WEBRTC_TRACE(kTraceApiCall, kTraceVideo, ViEId(instance_id_, video_channel),
+               "%s(compositor_id: %d, video_channel: %d)", __FUNCTION__,
+               compositor_id, video_channel);
+
+  ViEInputManagerScoped is(input_manager_);
+  ViEFrameCompositor* vie_compositor = is.Compositor(compositor_id);
+  if (!vie_compositor) {
+    WEBRTC_TRACE(kTraceError, kTraceVideo, ViEId(instance_id_, video_channel),
+                 "%s: Compositor %d doesn't exist", __FUNCTION__,
+                 compositor_id);
+    SetLastError(kViECompositorDoesNotExist);
+    return -1;
+  }
+
+  ViEChannelManagerScoped cs(channel_manager_);
+  ViEEncoder* vie_encoder = cs.Encoder(video_channel);
+  if (!vie_encoder) {
+    WEBRTC_TRACE(kTraceError, kTraceVideo, ViEId(instance_id_, video_channel),
+                 "%s: Channel %d doesn't exist", __FUNCTION__,
+                 video_channel);
+    SetLastError(kViECompositorInvalidChannelId);
+    return -1;
+  }
+  // Check if the encoder already has a connected frame provider.
+  if (is.FrameProvider(vie_encoder) != NULL) {
+    WEBRTC_TRACE(kTraceError, kTraceVideo, ViEId(instance_id_, video_channel),
+                 "%s: Channel %d already connected to a capture device, file "
+                 "or compositor.", __FUNCTION__, video_channel);
+    SetLastError(kViECompositorInputAlreadyConnected);
+    return -1;
+  }
+  if (vie_compositor->RegisterFrameCallback(video_channel, vie_encoder) != 0) {
+    SetLastError(kViECompositorUnknownError);
+    return -1;
+  }
+  return 0;
+}
+
+int ViECompositorImpl::DisconnectCompositor(const int video_channel) {
+  WEBRTC_TRACE(kTraceApiCall, kTraceVideo, ViEId(instance_id_, video_channel),
+               "%s(video_channel: %d)", __FUNCTION__, video_channel);
+
+  ViEChannelManagerScoped cs(channel_manager_);
+  ViEEncoder* vie_encoder = cs.Encoder(video_channel);
+  if (!vie_encoder) {
+    WEBRTC_TRACE(kTraceError, kTraceVideo, ViEId(instance_id_),
+                 "%s: Channel %d doesn't exist", __FUNCTION__,
+                 video_channel);
+    SetLastError(kViECompositorInvalidChannelId);
+    return -1;
+  }
+
+  ViEInputManagerScoped is(input_manager_);
+  ViEFrameProviderBase* frame_provider = is.FrameProvider(vie_encoder);
+  if (!frame_provider ||
+      frame_provider->Id() < kViECompositorIdBase ||
+      frame_provider->Id() > kViECompositorIdMax) {
+    WEBRTC_TRACE(kTraceWarning, kTraceVideo, ViEId(instance_id_),
+                 "%s: No compositor connected to channel %d",
+                 __FUNCTION__, video_channel);
+    SetLastError(kViECompositorNotConnected);
+    return -1;
+  }
+  if (frame_provider->DeregisterFrameCallback(vie_encoder) != 0) {
+    SetLastError(kViECompositorUnknownError);
+    return -1;
+  }
+  return 0;
+}
+
+}  // namespace webrtc
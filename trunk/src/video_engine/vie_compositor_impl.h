@@ -0,0 +1,50 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_VIDEO_ENGINE_VIE_COMPOSITOR_IMPL_H_
+#define WEBRTC_VIDEO_ENGINE_VIE_COMPOSITOR_IMPL_H_
+
+#include "typedefs.h"
+#include "video_engine/main/interface/vie_compositor.h"
+#include "video_engine/vie_defines.h"
+#include "video_engine/vie_ref_count.h"
+#include "video_engine/vie_shared_data.h"
+
+namespace webrtc {
+
+class ViECompositorImpl
+    : public virtual ViESharedData,
+      public ViECompositor,
+      public ViERefCount {
+ public:
+  // Implements ViECompositor.
+  virtual int Release();
+  virtual int AllocateCompositor(const unsigned int width,
+                                 const unsigned int height,
+                                 const unsigned int max_frame_rate,
+                                 int& compositor_id);
+  virtual int ReleaseCompositor(const int compositor_id);
+  virtual int AddStream(const int compositor_id, const int video_channel,
+                        const unsigned int z_order, const float left,
+                        const float top, const float right,
+                        const float bottom);
+  virtual int RemoveStream(const int compositor_id, const int video_channel);
+  virtual int ConnectCompositor(const int compositor_id,
+                                const int video_channel);
+  virtual int DisconnectCompositor(const int video_channel);
+
+ protected:
+  ViECompositorImpl();
+  virtual ~ViECompositorImpl();
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_VIDEO_ENGINE_VIE_COMPOSITOR_IMPL_H_
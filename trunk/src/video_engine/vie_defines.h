@@ -73,6 +73,10 @@ enum { kViEMaxSrtpAuthSh1Length = 20};
 enum { kViEMaxSrtpTagAuthNullLength = 12};
 enum { kViEMaxSrtpKeyAuthNullLength = 256};
 
+// ViECompositor
+enum { kViEMaxCompositors = 4};
+enum { kViEMaxCompositorStreams = 16};
+
 // ViEExternalCodec
 
 // ViEFile
@@ -103,6 +107,8 @@ enum {
     kViECaptureIdMax=0x10FF,
     kViEFileIdBase=0x2000,
     kViEFileIdMax=0x200F,
+    kViECompositorIdBase=0x3000,
+    kViECompositorIdMax=0x300F,
     kViEDummyChannelId=0xFFFF
 };
 
@@ -40,6 +40,7 @@ class QMTestVideoSettingsCallback : public VCMQMSettingsCallback {
                                    const WebRtc_UWord32 height);
 
   void SetMaxPayloadLength(WebRtc_Word32 max_payload_length);
+  void SetNumberOfCores(WebRtc_Word32 num_cores);
 
  private:
   VideoProcessingModule* vpm_;
@@ -75,7 +76,8 @@ ViEEncoder::ViEEncoder(WebRtc_Word32 engine_id, WebRtc_Word32 channel_id,
     picture_id_sli_(0),
     has_received_rpsi_(false),
     picture_id_rpsi_(0),
-    file_recorder_(channel_id) {
+    file_recorder_(channel_id),
+    encode_start_ms_(-1) {
   WEBRTC_TRACE(webrtc::kTraceMemory, webrtc::kTraceVideo,
                ViEId(engine_id, channel_id),
                "%s(engine_id: %d) 0x%p - Constructor", __FUNCTION__, engine_id,
@@ -338,6 +340,22 @@ WebRtc_Word32 ViEEncoder::GetEncoder(webrtc::VideoCodec& video_codec) {
   return 0;
 }
 
+WebRtc_Word32 ViEEncoder::SetNumberOfCores(WebRtc_UWord32 number_of_cores) {
+  WEBRTC_TRACE(webrtc::kTraceInfo, webrtc::kTraceVideo,
+               ViEId(engine_id_, channel_id_), "%s: %u", __FUNCTION__,
+               number_of_cores);
+
+  if (number_of_cores == number_of_cores_) {
+    return 0;
+  }
+  // Re-registering the send codec would re-create the encoder and force a
+  // key frame, so the running encoder keeps its cores until the next codec
+  // change.
+  number_of_cores_ = number_of_cores;
+  qm_callback_->SetNumberOfCores(number_of_cores);
+  return 0;
+}
+
 WebRtc_Word32 ViEEncoder::GetCodecConfigParameters(
     unsigned char config_parameters[kConfigParameterSize],
     unsigned char& config_parameters_size) {
@@ -413,6 +431,8 @@ void ViEEncoder::DeliverFrame(int id, webrtc::VideoFrame& video_frame,
   {
     CriticalSectionScoped cs(callback_critsect_);
     if (effect_filter_) {
+      // The effect filter works on a packed I420 buffer.
+      video_frame.Materialize();
       effect_filter_->Transform(video_frame.Length(), video_frame.Buffer(),
                                 video_frame.TimeStamp(),
                                 video_frame.Width(), video_frame.Height());
@@ -473,6 +493,7 @@ void ViEEncoder::DeliverFrame(int id, webrtc::VideoFrame& video_frame,
       decimated_frame = &video_frame;
     }
 
+    StartEncodeTimer(video_frame);
     if (vcm_.AddVideoFrame(*decimated_frame, content_metrics,
                            &codec_specific_info) != VCM_OK) {
       WEBRTC_TRACE(webrtc::kTraceError, webrtc::kTraceVideo,
@@ -502,6 +523,7 @@ void ViEEncoder::DeliverFrame(int id, webrtc::VideoFrame& video_frame,
   if (decimated_frame == NULL)  {
     decimated_frame = &video_frame;
   }
+  StartEncodeTimer(video_frame);
   if (vcm_.AddVideoFrame(*decimated_frame) != VCM_OK) {
     WEBRTC_TRACE(webrtc::kTraceError, webrtc::kTraceVideo,
                  ViEId(engine_id_, channel_id_), "%s: Error encoding frame %u",
@@ -562,6 +584,22 @@ WebRtc_Word32 ViEEncoder::SendCodecStatistics(
   return 0;
 }
 
+void ViEEncoder::GetLatencyStatistics(LatencyStatistics& statistics) const {
+  latency_stats_.GetStatistics(statistics);
+}
+
+void ViEEncoder::ResetLatencyStatistics() {
+  latency_stats_.Reset();
+}
+
+void ViEEncoder::StartEncodeTimer(const VideoFrame& video_frame) {
+  // The render time of a captured frame is its capture time.
+  const WebRtc_Word64 now_ms = TickTime::MillisecondTimestamp();
+  latency_stats_.Add(kLatencyCaptureToEncode,
+                     now_ms - video_frame.RenderTimeMs());
+  encode_start_ms_ = now_ms;
+}
+
 WebRtc_Word32 ViEEncoder::UpdateProtectionMethod() {
   bool fec_enabled = false;
   WebRtc_UWord8 dummy_ptype_red = 0;
@@ -642,11 +680,22 @@ WebRtc_Word32 ViEEncoder::SendData(
     }
   }
 
+  // Encoding is synchronous, so this runs on the thread that called
+  // StartEncodeTimer(). Only the first output of a frame is counted as encode
+  // time; further outputs, e.g. simulcast streams, come from the same call.
+  const WebRtc_Word64 packetize_start_ms = TickTime::MillisecondTimestamp();
+  if (encode_start_ms_ >= 0) {
+    latency_stats_.Add(kLatencyEncode, packetize_start_ms - encode_start_ms_);
+    encode_start_ms_ = -1;
+  }
+
   // New encoded data, hand over to the rtp module.
-  return default_rtp_rtcp_.SendOutgoingData(frame_type, payload_type,
-                                            time_stamp, payload_data,
-                                            payload_size, &fragmentation_header,
-                                            rtp_video_hdr);
+  const WebRtc_Word32 ret = default_rtp_rtcp_.SendOutgoingData(
+      frame_type, payload_type, time_stamp, payload_data, payload_size,
+      &fragmentation_header, rtp_video_hdr);
+  latency_stats_.Add(kLatencyPacketize,
+                     TickTime::MillisecondTimestamp() - packetize_start_ms);
+  return ret;
 }
 
 WebRtc_Word32 ViEEncoder::ProtectionRequest(
@@ -845,4 +894,8 @@ void QMTestVideoSettingsCallback::SetMaxPayloadLength(
   max_payload_length_ = max_payload_length;
 }
 
+void QMTestVideoSettingsCallback::SetNumberOfCores(WebRtc_Word32 num_cores) {
+  num_cores_ = num_cores;
+}
+
 }  // namespace webrtc
@@ -12,6 +12,7 @@
 #define WEBRTC_VIDEO_ENGINE_VIE_ENCODER_H_
 
 #include "common_types.h"
+#include "latency_stats.h"
 #include "rtp_rtcp_defines.h"
 #include "typedefs.h"
 #include "video_coding_defines.h"
@@ -58,6 +59,10 @@ class ViEEncoder
   WebRtc_Word32 DeRegisterExternalEncoder(WebRtc_UWord8 pl_type);
   WebRtc_Word32 SetEncoder(const VideoCodec& video_codec);
   WebRtc_Word32 GetEncoder(VideoCodec& video_codec);
+  // Number of cores for the encoder. Only affects send codecs registered after
+  // this call, e.g. by SetEncoder. Must not be called concurrently with the
+  // other codec settings.
+  WebRtc_Word32 SetNumberOfCores(WebRtc_UWord32 number_of_cores);
 
   WebRtc_Word32 GetCodecConfigParameters(
     unsigned char config_parameters[kConfigParameterSize],
@@ -87,6 +92,9 @@ class ViEEncoder
   WebRtc_Word32 SendKeyFrame();
   WebRtc_Word32 SendCodecStatistics(WebRtc_UWord32& num_key_frames,
                                     WebRtc_UWord32& num_delta_frames);
+  // Latency of the capture to encode, encode and packetize stages.
+  void GetLatencyStatistics(LatencyStatistics& statistics) const;
+  void ResetLatencyStatistics();
   // Loss protection.
   WebRtc_Word32 UpdateProtectionMethod();
 
@@ -139,9 +147,13 @@ class ViEEncoder
   ViEFileRecorder& GetOutgoingFileRecorder();
 
  private:
+  // Records the capture to encode latency of |video_frame| and starts timing
+  // its encoding.
+  void StartEncodeTimer(const VideoFrame& video_frame);
+
   WebRtc_Word32 engine_id_;
   WebRtc_Word32 channel_id_;
-  const WebRtc_UWord32 number_of_cores_;
+  WebRtc_UWord32 number_of_cores_;
 
   VideoCodingModule& vcm_;
   VideoProcessingModule& vpm_;
@@ -169,6 +181,11 @@ class ViEEncoder
 
   ViEFileRecorder file_recorder_;
 
+  LatencyStats latency_stats_;
+  // Time the frame being encoded was handed to the VCM, -1 once its first
+  // encoded output has been delivered.
+  WebRtc_Word64 encode_start_ms_;
+
   // Quality modes callback
   QMTestVideoSettingsCallback* qm_callback_;
 };
@@ -192,6 +192,7 @@ void ViEFileRecorder::RecordVideoFrame(const VideoFrame& video_frame) {
     const WebRtc_UWord32 time_stamp = video_frame.TimeStamp();
     const WebRtc_Word64 render_time_stamp = video_frame.RenderTimeMs();
     VideoFrame& unconst_video_frame = const_cast<VideoFrame&>(video_frame);
+    unconst_video_frame.Materialize();
     unconst_video_frame.SetTimeStamp(time_stamp - 90 * frame_delay_);
     unconst_video_frame.SetRenderTime(render_time_stamp - frame_delay_);
 
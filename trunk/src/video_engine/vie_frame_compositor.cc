@@ -0,0 +1,424 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video_engine/vie_frame_compositor.h"
+
+#include <cassert>
+#include <cstring>
+
+#include "system_wrappers/interface/critical_section_wrapper.h"
+#include "system_wrappers/interface/event_wrapper.h"
+#include "system_wrappers/interface/thread_wrapper.h"
+#include "system_wrappers/interface/tick_util.h"
+#include "system_wrappers/interface/trace.h"
+#include "video_engine/vie_defines.h"
+
+namespace webrtc {
+
+const int kThreadWaitTimeMs = 100;
+
+// Background of the picture where no stream is placed: black.
+const WebRtc_UWord8 kBackgroundLuma = 16;
+const WebRtc_UWord8 kBackgroundChroma = 128;
+
+namespace {
+
+void FramePlanes(const VideoFrame& frame, I420Planes* planes) {
+  for (int i = 0; i < kNumOfI420Planes; ++i) {
+    planes->plane[i] = frame.Plane(i);
+    planes->stride[i] = frame.Stride(i);
+  }
+  planes->width = frame.Width();
+  planes->height = frame.Height();
+}
+
+// Converts a relative coordinate to an even pixel position.
+int EvenPosition(float relative, int size) {
+  return static_cast<int>(relative * size) & ~1;
+}
+
+bool Overlaps(int left_a, int top_a, int width_a, int height_a,
+              int left_b, int top_b, int width_b, int height_b) {
+  return left_a < left_b + width_b && left_b < left_a + width_a &&
+         top_a < top_b + height_b && top_b < top_a + height_a;
+}
+
+}  // namespace
+
+ViEFrameCompositor::Stream::Stream()
+    : provider(NULL),
+      id(-1),
+      z_order(0),
+      left(0),
+      top(0),
+      width(0),
+      height(0),
+      cs(CriticalSectionWrapper::CreateCriticalSection()),
+      updated(false) {
+}
+
+ViEFrameCompositor::Stream::~Stream() {
+  delete cs;
+}
+
+ViEFrameCompositor* ViEFrameCompositor::CreateViEFrameCompositor(
+    int compositor_id,
+    int engine_id,
+    int width,
+    int height,
+    int max_frame_rate) {
+  ViEFrameCompositor* vie_compositor = new ViEFrameCompositor(
+      compositor_id, engine_id, width, height, max_frame_rate);
+  if (!vie_compositor || vie_compositor->Init() != 0) {
+    delete vie_compositor;
+    return NULL;
+  }
+  return vie_compositor;
+}
+
+ViEFrameCompositor::ViEFrameCompositor(int compositor_id,
+                                       int engine_id,
+                                       int width,
+                                       int height,
+                                       int max_frame_rate)
+    : ViEFrameProviderBase(compositor_id, engine_id),
+      width_(width),
+      height_(height),
+      max_frame_rate_(max_frame_rate),
+      streams_cs_(*CriticalSectionWrapper::CreateCriticalSection()),
+      clear_picture_(true),
+      closed_(false),
+      compose_thread_(*ThreadWrapper::CreateThread(ViEComposeThreadFunction,
+                                                   this, kHighPriority,
+                                                   "ViEComposeThread")),
+      compose_event_(*EventWrapper::Create()),
+      pace_event_(*EventWrapper::Create()),
+      last_compose_time_ms_(0) {
+  WEBRTC_TRACE(kTraceMemory, kTraceVideo, ViEId(engine_id, compositor_id),
+               "%s(compositor_id: %d, %dx%d)", __FUNCTION__, compositor_id,
+               width, height);
+}
+
+int ViEFrameCompositor::Init() {
+  if (picture_.AllocatePlanes(width_, height_) != 0) {
+    WEBRTC_TRACE(kTraceError, kTraceVideo, ViEId(engine_id_, id_),
+                 "%s: Could not allocate the picture", __FUNCTION__);
+    return -1;
+  }
+  FramePlanes(picture_, &picture_planes_);
+
+  unsigned int t_id = 0;
+  if (!compose_thread_.Start(t_id)) {
+    WEBRTC_TRACE(kTraceError, kTraceVideo, ViEId(engine_id_, id_),
+                 "%s: Could not start the compositor thread", __FUNCTION__);
+    return -1;
+  }
+  WEBRTC_TRACE(kTraceInfo, kTraceVideo, ViEId(engine_id_, id_),
+               "%s: thread started: %u", __FUNCTION__, t_id);
+  return 0;
+}
+
+ViEFrameCompositor::~ViEFrameCompositor() {
+  WEBRTC_TRACE(kTraceMemory, kTraceVideo, ViEId(engine_id_, id_),
+               "ViEFrameCompositor::~ViEFrameCompositor() - compositor_id: %d",
+               id_);
+
+  // Stop the providers from delivering before the thread and streams go.
+  // This is normally done by Close() already.
+  Close();
+
+  compose_thread_.SetNotAlive();
+  compose_event_.Set();
+  pace_event_.Set();
+  if (compose_thread_.Stop()) {
+    delete &compose_thread_;
+  } else {
+    assert(false);
+    WEBRTC_TRACE(kTraceMemory, kTraceVideo, ViEId(engine_id_, id_),
+                 "%s: Not able to stop compositor thread, leaking",
+                 __FUNCTION__);
+  }
+  delete &compose_event_;
+  delete &pace_event_;
+
+  for (size_t i = 0; i < streams_.size(); ++i) {
+    delete streams_[i];
+  }
+  streams_.clear();
+  delete &streams_cs_;
+}
+
+int ViEFrameCompositor::AddStream(ViEFrameProviderBase* provider,
+                                  unsigned int z_order,
+                                  float left, float top,
+                                  float right, float bottom) {
+  assert(provider);
+  const int stream_id = provider->Id();
+  const int pixel_left = EvenPosition(left, width_);
+  const int pixel_top = EvenPosition(top, height_);
+  const int pixel_right = EvenPosition(right, width_);
+  const int pixel_bottom = EvenPosition(bottom, height_);
+  if (left < 0.0f || top < 0.0f || right > 1.0f || bottom > 1.0f ||
+      pixel_right <= pixel_left || pixel_bottom <= pixel_top) {
+    WEBRTC_TRACE(kTraceError, kTraceVideo, ViEId(engine_id_, id_),
+                 "%s: Invalid place for stream %d", __FUNCTION__, stream_id);
+    return -1;
+  }
+  {
+    CriticalSectionScoped cs(streams_cs_);
+    if (closed_) {
+      WEBRTC_TRACE(kTraceError, kTraceVideo, ViEId(engine_id_, id_),
+                   "%s: Compositor is closed", __FUNCTION__);
+      return -1;
+    }
+    if (FindStream(stream_id)) {
+      WEBRTC_TRACE(kTraceError, kTraceVideo, ViEId(engine_id_, id_),
+                   "%s: Stream %d already added", __FUNCTION__, stream_id);
+      return -1;
+    }
+    Stream* stream = new Stream;
+    stream->provider = provider;
+    stream->id = stream_id;
+    stream->z_order = z_order;
+    stream->left = pixel_left;
+    stream->top = pixel_top;
+    stream->width = pixel_right - pixel_left;
+    stream->height = pixel_bottom - pixel_top;
+
+    std::vector<Stream*>::iterator it = streams_.begin();
+    while (it != streams_.end() && (*it)->z_order <= z_order) {
+      ++it;
+    }
+    streams_.insert(it, stream);
+  }
+  if (provider->RegisterFrameCallback(id_, this) != 0) {
+    EraseStream(stream_id);
+    return -1;
+  }
+  return 0;
+}
+
+int ViEFrameCompositor::RemoveStream(int stream_id) {
+  ViEFrameProviderBase* provider = NULL;
+  {
+    CriticalSectionScoped cs(streams_cs_);
+    Stream* stream = FindStream(stream_id);
+    if (!stream) {
+      WEBRTC_TRACE(kTraceError, kTraceVideo, ViEId(engine_id_, id_),
+                   "%s: Stream %d not added", __FUNCTION__, stream_id);
+      return -1;
+    }
+    provider = stream->provider;
+  }
+  // Deregistering waits for a frame being delivered, so the stream isn't
+  // used by the provider's thread once it is erased. streams_cs_ must not be
+  // held here, since DeliverFrame() takes it with the provider's lock held.
+  provider->DeregisterFrameCallback(this);
+  EraseStream(stream_id);
+  return 0;
+}
+
+void ViEFrameCompositor::Close() {
+  std::vector<ViEFrameProviderBase*> providers;
+  {
+    CriticalSectionScoped cs(streams_cs_);
+    closed_ = true;
+    for (size_t i = 0; i < streams_.size(); ++i) {
+      providers.push_back(streams_[i]->provider);
+    }
+  }
+  // As in RemoveStream(), streams_cs_ must not be held while deregistering.
+  for (size_t i = 0; i < providers.size(); ++i) {
+    const int stream_id = providers[i]->Id();
+    providers[i]->DeregisterFrameCallback(this);
+    EraseStream(stream_id);
+  }
+}
+
+bool ViEFrameCompositor::HasStream(int stream_id) const {
+  CriticalSectionScoped cs(streams_cs_);
+  return FindStream(stream_id) != NULL;
+}
+
+int ViEFrameCompositor::FrameCallbackChanged() {
+  // The picture size is fixed when the compositor is created.
+  return 0;
+}
+
+void ViEFrameCompositor::DeliverFrame(int id,
+                                      VideoFrame& video_frame,
+                                      int /*num_csrcs*/,
+                                      const WebRtc_UWord32 /*CSRC*/[]) {
+  if (video_frame.Width() == 0 || video_frame.Height() == 0) {
+    return;
+  }
+  Stream* stream = NULL;
+  {
+    CriticalSectionScoped cs(streams_cs_);
+    stream = FindStream(id);
+  }
+  if (!stream) {
+    return;
+  }
+
+  // Scale outside streams_cs_, so that the streams are scaled in parallel on
+  // the threads delivering them.
+  CriticalSectionScoped cs(*stream->cs);
+  if (!stream->frame.HasPlanes() &&
+      stream->frame.AllocatePlanes(stream->width, stream->height) != 0) {
+    WEBRTC_TRACE(kTraceError, kTraceVideo, ViEId(engine_id_, id_),
+                 "%s: Could not allocate frame for stream %d", __FUNCTION__,
+                 id);
+    return;
+  }
+  if (stream->scaler.Set(video_frame.Width(), video_frame.Height(),
+                         stream->width, stream->height, kI420, kI420,
+                         kScaleBilinear) != 0) {
+    return;
+  }
+  I420Planes src_planes;
+  I420Planes dst_planes;
+  FramePlanes(video_frame, &src_planes);
+  FramePlanes(stream->frame, &dst_planes);
+  if (stream->scaler.Scale(src_planes, dst_planes) != 0) {
+    WEBRTC_TRACE(kTraceError, kTraceVideo, ViEId(engine_id_, id_),
+                 "%s: Could not scale frame for stream %d", __FUNCTION__, id);
+    return;
+  }
+  stream->updated = true;
+  compose_event_.Set();
+}
+
+void ViEFrameCompositor::DelayChanged(int /*id*/, int /*frame_delay*/) {
+  // The picture is delivered as soon as it is composed.
+}
+
+int ViEFrameCompositor::GetPreferedFrameSettings(int& /*width*/,
+                                                 int& /*height*/,
+                                                 int& /*frame_rate*/) {
+  // Any size is scaled to the place of the stream.
+  return -1;
+}
+
+void ViEFrameCompositor::ProviderDestroyed(int id) {
+  WEBRTC_TRACE(kTraceInfo, kTraceVideo, ViEId(engine_id_, id_),
+               "%s(stream: %d)", __FUNCTION__, id);
+  EraseStream(id);
+}
+
+bool ViEFrameCompositor::ViEComposeThreadFunction(void* obj) {
+  return static_cast<ViEFrameCompositor*>(obj)->ViEComposeProcess();
+}
+
+bool ViEFrameCompositor::ViEComposeProcess() {
+  if (compose_event_.Wait(kThreadWaitTimeMs) != kEventSignaled) {
+    return true;
+  }
+  // Wait until the next picture is due, letting the streams that change
+  // meanwhile share it.
+  const WebRtc_Word64 wait_ms = last_compose_time_ms_ +
+      1000 / max_frame_rate_ - TickTime::MillisecondTimestamp();
+  if (wait_ms > 0) {
+    pace_event_.Wait(static_cast<unsigned long>(wait_ms));
+  }
+
+  {
+    CriticalSectionScoped cs(streams_cs_);
+    if (!Compose()) {
+      return true;
+    }
+  }
+  last_compose_time_ms_ = TickTime::MillisecondTimestamp();
+
+  // Lend the picture to the callbacks; a callback that keeps it copies it.
+  WebRtc_UWord8* planes[kNumOfI420Planes];
+  int strides[kNumOfI420Planes];
+  for (int i = 0; i < kNumOfI420Planes; ++i) {
+    planes[i] = picture_.Plane(i);
+    strides[i] = picture_.Stride(i);
+  }
+  if (deliver_frame_.SetPlanes(planes, strides, width_, height_, NULL) != 0) {
+    return true;
+  }
+  deliver_frame_.SetRenderTime(last_compose_time_ms_);
+  ViEFrameProviderBase::DeliverFrame(deliver_frame_);
+  deliver_frame_.ReleasePlanes();
+  return true;
+}
+
+bool ViEFrameCompositor::Compose() {
+  bool changed = false;
+  if (clear_picture_) {
+    const int chroma_height = (height_ + 1) / 2;
+    memset(picture_planes_.plane[kYPlane], kBackgroundLuma,
+           picture_planes_.stride[kYPlane] * height_);
+    memset(picture_planes_.plane[kUPlane], kBackgroundChroma,
+           picture_planes_.stride[kUPlane] * chroma_height);
+    memset(picture_planes_.plane[kVPlane], kBackgroundChroma,
+           picture_planes_.stride[kVPlane] * chroma_height);
+    changed = true;
+  }
+
+  // A stream is copied if it has changed, or if a stream below it that
+  // overlaps it has been copied, so that it stays on top.
+  std::vector<const Stream*> copied;
+  for (size_t i = 0; i < streams_.size(); ++i) {
+    Stream* stream = streams_[i];
+    CriticalSectionScoped cs(*stream->cs);
+    bool copy = clear_picture_ || stream->updated;
+    for (size_t j = 0; !copy && j < copied.size(); ++j) {
+      copy = Overlaps(stream->left, stream->top, stream->width,
+                      stream->height, copied[j]->left, copied[j]->top,
+                      copied[j]->width, copied[j]->height);
+    }
+    if (!copy || !stream->frame.HasPlanes()) {
+      continue;
+    }
+    I420Planes src_planes;
+    I420Planes dst_planes;
+    FramePlanes(stream->frame, &src_planes);
+    if (CropI420Planes(picture_planes_, stream->left, stream->top,
+                       stream->width, stream->height, &dst_planes) != 0 ||
+        CopyI420(src_planes, dst_planes) != 0) {
+      continue;
+    }
+    stream->updated = false;
+    copied.push_back(stream);
+    changed = true;
+  }
+  clear_picture_ = false;
+  return changed;
+}
+
+ViEFrameCompositor::Stream* ViEFrameCompositor::FindStream(
+    int stream_id) const {
+  for (size_t i = 0; i < streams_.size(); ++i) {
+    if (streams_[i]->id == stream_id) {
+      return streams_[i];
+    }
+  }
+  return NULL;
+}
+
+void ViEFrameCompositor::EraseStream(int stream_id) {
+  CriticalSectionScoped cs(streams_cs_);
+  for (std::vector<Stream*>::iterator it = streams_.begin();
+       it != streams_.end(); ++it) {
+    if ((*it)->id == stream_id) {
+      delete *it;
+      streams_.erase(it);
+      clear_picture_ = true;
+      compose_event_.Set();
+      return;
+    }
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,149 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_VIDEO_ENGINE_VIE_FRAME_COMPOSITOR_H_
+#define WEBRTC_VIDEO_ENGINE_VIE_FRAME_COMPOSITOR_H_
+
+#include <vector>
+
+#include "common_video/libyuv/include/libyuv.h"
+#include "common_video/libyuv/include/scaler.h"
+#include "modules/interface/module_common_types.h"
+#include "typedefs.h"
+#include "video_engine/vie_frame_provider_base.h"
+
+namespace webrtc {
+
+class CriticalSectionWrapper;
+class EventWrapper;
+class ThreadWrapper;
+
+// ViEFrameCompositor combines the frames of several frame providers, e.g.
+// decoding channels, into one picture and delivers it to its own frame
+// callbacks, e.g. a ViEEncoder or a renderer.
+//
+// Each stream is scaled to its place in the picture on the thread delivering
+// it, i.e. the decoding thread of its channel, so all streams are scaled in
+// parallel. The compositor thread then copies the streams that have changed
+// into the picture and delivers it, at most max_frame_rate times per second.
+// No picture is delivered while nothing changes.
+class ViEFrameCompositor
+    : public ViEFrameProviderBase,
+      public ViEFrameCallback {
+ public:
+  static ViEFrameCompositor* CreateViEFrameCompositor(int compositor_id,
+                                                      int engine_id,
+                                                      int width,
+                                                      int height,
+                                                      int max_frame_rate);
+  ~ViEFrameCompositor();
+
+  // Places the frames of |provider| in the picture, with coordinates relative
+  // to the picture size as for renderers, and registers for its frames.
+  // Streams with a higher |z_order| are drawn on top.
+  int AddStream(ViEFrameProviderBase* provider, unsigned int z_order,
+                float left, float top, float right, float bottom);
+
+  // Deregisters from the provider with id |stream_id| and clears its place.
+  int RemoveStream(int stream_id);
+
+  bool HasStream(int stream_id) const;
+
+  // Removes all streams and rejects new ones, before the compositor is
+  // deleted. Must be called with the providers kept alive, i.e. with the
+  // channel manager locked, since deregistering uses them.
+  void Close();
+
+  // Implements ViEFrameProviderBase.
+  virtual int FrameCallbackChanged();
+
+  // Implements ViEFrameCallback.
+  virtual void DeliverFrame(int id,
+                            VideoFrame& video_frame,
+                            int num_csrcs = 0,
+                            const WebRtc_UWord32 CSRC[kRtpCsrcSize] = NULL);
+  virtual void DelayChanged(int id, int frame_delay);
+  virtual int GetPreferedFrameSettings(int& width,
+                                       int& height,
+                                       int& frame_rate);
+  virtual void ProviderDestroyed(int id);
+
+ protected:
+  ViEFrameCompositor(int compositor_id, int engine_id, int width, int height,
+                     int max_frame_rate);
+  int Init();
+
+  static bool ViEComposeThreadFunction(void* obj);
+  bool ViEComposeProcess();
+
+ private:
+  // A provider placed in the picture.
+  struct Stream {
+    Stream();
+    ~Stream();
+
+    ViEFrameProviderBase* provider;
+    int id;
+    unsigned int z_order;
+    // Place in the picture in pixels. left and top are even.
+    int left;
+    int top;
+    int width;
+    int height;
+
+    // Protects the members below, which are written by the delivering
+    // thread.
+    CriticalSectionWrapper* cs;
+    Scaler scaler;
+    // The last frame, scaled to width x height.
+    VideoFrame frame;
+    // Set when frame is written, cleared when it is copied to the picture.
+    bool updated;
+  };
+
+  // Copies the changed streams into picture_. Returns false if the picture
+  // hasn't changed. Assumed protected by streams_cs_.
+  bool Compose();
+
+  // Assumed protected by streams_cs_.
+  Stream* FindStream(int stream_id) const;
+
+  // Removes the stream without deregistering from its provider.
+  void EraseStream(int stream_id);
+
+  const int width_;
+  const int height_;
+  const int max_frame_rate_;
+
+  CriticalSectionWrapper& streams_cs_;
+  // Sorted by increasing z order.
+  std::vector<Stream*> streams_;
+  // Set when a stream leaves the picture, so that its place is cleared.
+  bool clear_picture_;
+  // Set by Close(); no streams are added afterwards.
+  bool closed_;
+
+  ThreadWrapper& compose_thread_;
+  // Set when a stream has a new frame or the layout changes.
+  EventWrapper& compose_event_;
+  // Only set to stop the thread while it waits for the next picture time.
+  EventWrapper& pace_event_;
+  WebRtc_Word64 last_compose_time_ms_;
+
+  // Written by the compositor thread only.
+  VideoFrame picture_;
+  I420Planes picture_planes_;
+  // References picture_ while it is delivered.
+  VideoFrame deliver_frame_;
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_VIDEO_ENGINE_VIE_FRAME_COMPOSITOR_H_
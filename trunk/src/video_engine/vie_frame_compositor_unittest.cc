@@ -0,0 +1,225 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video_engine/vie_frame_compositor.h"
+
+#include <cstring>
+
+#include "gtest/gtest.h"
+#include "system_wrappers/interface/critical_section_wrapper.h"
+#include "system_wrappers/interface/event_wrapper.h"
+#include "video_engine/vie_defines.h"
+
+namespace webrtc {
+
+namespace {
+
+const int kWidth = 64;
+const int kHeight = 48;
+const int kMaxFrameRate = 100;
+const unsigned long kWaitTimeMs = 2000;
+
+// A provider, e.g. a decoding channel, delivering frames of a single luma
+// value.
+class FakeProvider : public ViEFrameProviderBase {
+ public:
+  explicit FakeProvider(int id) : ViEFrameProviderBase(id, 0) {}
+  virtual int FrameCallbackChanged() { return 0; }
+
+  void Deliver(int width, int height, WebRtc_UWord8 luma) {
+    VideoFrame frame;
+    ASSERT_EQ(0, frame.AllocatePlanes(width, height));
+    for (int i = 0; i < kNumOfI420Planes; ++i) {
+      const int plane_width = (i == kYPlane) ? width : (width + 1) / 2;
+      const int plane_height = (i == kYPlane) ? height : (height + 1) / 2;
+      for (int row = 0; row < plane_height; ++row) {
+        memset(frame.Plane(i) + row * frame.Stride(i),
+               (i == kYPlane) ? luma : 128, plane_width);
+      }
+    }
+    DeliverFrame(frame);
+  }
+};
+
+// Keeps the luma plane of the last picture from the compositor.
+class FakeEncoder : public ViEFrameCallback {
+ public:
+  FakeEncoder()
+      : cs_(CriticalSectionWrapper::CreateCriticalSection()),
+        event_(EventWrapper::Create()),
+        pictures_(0) {
+    memset(luma_, 0, sizeof(luma_));
+  }
+  ~FakeEncoder() {
+    delete event_;
+    delete cs_;
+  }
+
+  virtual void DeliverFrame(int /*id*/, VideoFrame& video_frame,
+                            int /*num_csrcs*/,
+                            const WebRtc_UWord32 /*CSRC*/[]) {
+    ASSERT_EQ(kWidth, static_cast<int>(video_frame.Width()));
+    ASSERT_EQ(kHeight, static_cast<int>(video_frame.Height()));
+    CriticalSectionScoped cs(cs_);
+    for (int row = 0; row < kHeight; ++row) {
+      memcpy(luma_ + row * kWidth,
+             video_frame.Plane(kYPlane) + row * video_frame.Stride(kYPlane),
+             kWidth);
+    }
+    ++pictures_;
+    event_->Set();
+  }
+  virtual void DelayChanged(int /*id*/, int /*frame_delay*/) {}
+  virtual int GetPreferedFrameSettings(int& /*width*/, int& /*height*/,
+                                       int& /*frame_rate*/) {
+    return -1;
+  }
+  virtual void ProviderDestroyed(int /*id*/) {}
+
+  // Waits until a picture has |value| at (x, y).
+  bool WaitForLuma(int x, int y, WebRtc_UWord8 value) {
+    while (Luma(x, y) != value) {
+      if (event_->Wait(kWaitTimeMs) != kEventSignaled) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  int Luma(int x, int y) {
+    CriticalSectionScoped cs(cs_);
+    return luma_[y * kWidth + x];
+  }
+
+  int pictures() {
+    CriticalSectionScoped cs(cs_);
+    return pictures_;
+  }
+
+ private:
+  CriticalSectionWrapper* cs_;
+  EventWrapper* event_;
+  WebRtc_UWord8 luma_[kWidth * kHeight];
+  int pictures_;
+};
+
+}  // namespace
+
+class ViEFrameCompositorTest : public ::testing::Test {
+ protected:
+  ViEFrameCompositorTest()
+      : compositor_(ViEFrameCompositor::CreateViEFrameCompositor(
+            kViECompositorIdBase, 0, kWidth, kHeight, kMaxFrameRate)),
+        first_(1),
+        second_(2) {}
+
+  virtual void SetUp() {
+    ASSERT_TRUE(compositor_ != NULL);
+    ASSERT_EQ(0, compositor_->RegisterFrameCallback(0, &encoder_));
+  }
+
+  virtual void TearDown() {
+    if (compositor_) {
+      compositor_->DeregisterFrameCallback(&encoder_);
+      compositor_->Close();
+      delete compositor_;
+    }
+  }
+
+  ViEFrameCompositor* compositor_;
+  FakeEncoder encoder_;
+  FakeProvider first_;
+  FakeProvider second_;
+};
+
+TEST_F(ViEFrameCompositorTest, AddsAndRemovesStreams) {
+  EXPECT_EQ(0, compositor_->AddStream(&first_, 0, 0.0f, 0.0f, 0.5f, 1.0f));
+  EXPECT_TRUE(compositor_->HasStream(first_.Id()));
+  EXPECT_EQ(1, first_.NumberOfRegisteredFrameCallbacks());
+  // A provider is only added once, and needs a place in the picture.
+  EXPECT_EQ(-1, compositor_->AddStream(&first_, 1, 0.5f, 0.0f, 1.0f, 1.0f));
+  EXPECT_EQ(-1, compositor_->AddStream(&second_, 0, 0.5f, 0.0f, 0.5f, 1.0f));
+  EXPECT_FALSE(compositor_->HasStream(second_.Id()));
+
+  EXPECT_EQ(0, compositor_->RemoveStream(first_.Id()));
+  EXPECT_FALSE(compositor_->HasStream(first_.Id()));
+  EXPECT_EQ(0, first_.NumberOfRegisteredFrameCallbacks());
+  EXPECT_EQ(-1, compositor_->RemoveStream(first_.Id()));
+}
+
+TEST_F(ViEFrameCompositorTest, PlacesStreamsInLayout) {
+  // The first stream fills the left half, the second the right half.
+  ASSERT_EQ(0, compositor_->AddStream(&first_, 0, 0.0f, 0.0f, 0.5f, 1.0f));
+  ASSERT_EQ(0, compositor_->AddStream(&second_, 0, 0.5f, 0.0f, 1.0f, 1.0f));
+  first_.Deliver(176, 144, 50);
+  second_.Deliver(32, 24, 200);
+  ASSERT_TRUE(encoder_.WaitForLuma(kWidth / 4, kHeight / 2, 50));
+  ASSERT_TRUE(encoder_.WaitForLuma(3 * kWidth / 4, kHeight / 2, 200));
+
+  // A stream with higher z order stays on top of the streams below it, also
+  // when only those are updated.
+  FakeProvider top(3);
+  ASSERT_EQ(0, compositor_->AddStream(&top, 1, 0.25f, 0.25f, 0.75f, 0.75f));
+  top.Deliver(16, 16, 100);
+  ASSERT_TRUE(encoder_.WaitForLuma(kWidth / 2, kHeight / 2, 100));
+  first_.Deliver(176, 144, 60);
+  ASSERT_TRUE(encoder_.WaitForLuma(2, 2, 60));
+  EXPECT_EQ(100, encoder_.Luma(kWidth / 2 - 2, kHeight / 2));
+  EXPECT_EQ(200, encoder_.Luma(kWidth - 2, kHeight - 2));
+
+  // A removed stream leaves the background.
+  ASSERT_EQ(0, compositor_->RemoveStream(second_.Id()));
+  ASSERT_TRUE(encoder_.WaitForLuma(kWidth - 2, kHeight - 2, 16));
+  EXPECT_EQ(100, encoder_.Luma(kWidth / 2, kHeight / 2));
+  ASSERT_EQ(0, compositor_->RemoveStream(top.Id()));
+}
+
+TEST_F(ViEFrameCompositorTest, NoPictureWithoutChanges) {
+  ASSERT_EQ(0, compositor_->AddStream(&first_, 0, 0.0f, 0.0f, 1.0f, 1.0f));
+  first_.Deliver(kWidth, kHeight, 80);
+  ASSERT_TRUE(encoder_.WaitForLuma(0, 0, 80));
+  const int pictures = encoder_.pictures();
+  EventWrapper* event = EventWrapper::Create();
+  event->Wait(100);
+  delete event;
+  EXPECT_EQ(pictures, encoder_.pictures());
+}
+
+TEST_F(ViEFrameCompositorTest, ReleasesWithStreamsAttached) {
+  ASSERT_EQ(0, compositor_->AddStream(&first_, 0, 0.0f, 0.0f, 0.5f, 1.0f));
+  ASSERT_EQ(0, compositor_->AddStream(&second_, 1, 0.5f, 0.0f, 1.0f, 1.0f));
+  first_.Deliver(kWidth, kHeight, 50);
+
+  compositor_->Close();
+  EXPECT_EQ(0, first_.NumberOfRegisteredFrameCallbacks());
+  EXPECT_EQ(0, second_.NumberOfRegisteredFrameCallbacks());
+  EXPECT_FALSE(compositor_->HasStream(first_.Id()));
+  // No streams are added to a closed compositor.
+  EXPECT_EQ(-1, compositor_->AddStream(&first_, 0, 0.0f, 0.0f, 1.0f, 1.0f));
+  EXPECT_EQ(0, first_.NumberOfRegisteredFrameCallbacks());
+
+  compositor_->DeregisterFrameCallback(&encoder_);
+  delete compositor_;
+  compositor_ = NULL;
+  // The providers no longer deliver to the compositor.
+  first_.Deliver(kWidth, kHeight, 60);
+}
+
+TEST_F(ViEFrameCompositorTest, ProviderDestroyedRemovesStream) {
+  FakeProvider* provider = new FakeProvider(3);
+  ASSERT_EQ(0, compositor_->AddStream(provider, 0, 0.0f, 0.0f, 1.0f, 1.0f));
+  provider->Deliver(kWidth, kHeight, 90);
+  ASSERT_TRUE(encoder_.WaitForLuma(0, 0, 90));
+  delete provider;
+  EXPECT_FALSE(compositor_->HasStream(3));
+  ASSERT_TRUE(encoder_.WaitForLuma(0, 0, 16));
+}
+
+}  // namespace webrtc
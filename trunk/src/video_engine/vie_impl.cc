@@ -130,6 +130,15 @@ bool VideoEngine::Delete(VideoEngine*& videoEngine)
         return false;
     }
 #endif
+#ifdef WEBRTC_VIDEO_ENGINE_COMPOSITOR_API
+    ViECompositorImpl* vieCompositor = vieImpl;
+    if (vieCompositor->GetCount() > 0)
+    {
+        WEBRTC_TRACE(webrtc::kTraceError, webrtc::kTraceVideo, gViEActiveInstanceCounter,
+                   "ViECompositor ref count: %d", vieCompositor->GetCount());
+        return false;
+    }
+#endif
 #ifdef WEBRTC_VIDEO_ENGINE_ENCRYPTION_API
     ViEEncryptionImpl* vieEncryption = vieImpl;
     if (vieEncryption->GetCount() > 0)
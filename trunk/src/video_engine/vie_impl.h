@@ -28,6 +28,9 @@
 #ifdef WEBRTC_VIDEO_ENGINE_CODEC_API
 #include "vie_codec_impl.h"
 #endif
+#ifdef WEBRTC_VIDEO_ENGINE_COMPOSITOR_API
+#include "vie_compositor_impl.h"
+#endif
 #ifdef WEBRTC_VIDEO_ENGINE_ENCRYPTION_API
 #include "vie_encryption_impl.h"
 #endif
@@ -60,6 +63,9 @@ class VideoEngineImpl: public ViEBaseImpl
 #ifdef WEBRTC_VIDEO_ENGINE_CAPTURE_API
     , public ViECaptureImpl
 #endif
+#ifdef WEBRTC_VIDEO_ENGINE_COMPOSITOR_API
+    , public ViECompositorImpl
+#endif
 #ifdef WEBRTC_VIDEO_ENGINE_ENCRYPTION_API
     , public ViEEncryptionImpl
 #endif
@@ -23,6 +23,7 @@
 #include "video_engine/vie_capturer.h"
 #include "video_engine/vie_defines.h"
 #include "video_engine/vie_file_player.h"
+#include "video_engine/vie_frame_compositor.h"
 
 namespace webrtc {
 
@@ -43,6 +44,9 @@ ViEInputManager::ViEInputManager(const int engine_id)
   for (int idx = 0; idx < kViEMaxFilePlayers; idx++) {
     free_file_id_[idx] = true;
   }
+  for (int idx = 0; idx < kViEMaxCompositors; idx++) {
+    free_compositor_id_[idx] = true;
+  }
 }
 
 ViEInputManager::~ViEInputManager() {
@@ -444,6 +448,81 @@ int ViEInputManager::DestroyFilePlayer(int file_id) {
   return 0;
 }
 
+int ViEInputManager::CreateCompositor(int width, int height,
+                                      int max_frame_rate,
+                                      int& compositor_id) {
+  WEBRTC_TRACE(webrtc::kTraceInfo, webrtc::kTraceVideo, ViEId(engine_id_),
+               "%s(%dx%d, max_frame_rate: %d)", __FUNCTION__, width, height,
+               max_frame_rate);
+
+  CriticalSectionScoped cs(map_cs_);
+  int new_compositor_id = 0;
+  if (!GetFreeCompositorId(new_compositor_id)) {
+    WEBRTC_TRACE(webrtc::kTraceError, webrtc::kTraceVideo, ViEId(engine_id_),
+                 "%s: Maximum supported number of compositors already in use",
+                 __FUNCTION__);
+    return kViECompositorMaxNoOfCompositors;
+  }
+
+  ViEFrameCompositor* vie_compositor =
+      ViEFrameCompositor::CreateViEFrameCompositor(new_compositor_id,
+                                                   engine_id_, width, height,
+                                                   max_frame_rate);
+  if (!vie_compositor) {
+    ReturnCompositorId(new_compositor_id);
+    WEBRTC_TRACE(webrtc::kTraceError, webrtc::kTraceVideo, ViEId(engine_id_),
+                 "%s: Could not create compositor", __FUNCTION__);
+    return kViECompositorUnknownError;
+  }
+
+  if (vie_frame_provider_map_.Insert(new_compositor_id, vie_compositor) != 0) {
+    ReturnCompositorId(new_compositor_id);
+    WEBRTC_TRACE(webrtc::kTraceError, webrtc::kTraceVideo, ViEId(engine_id_),
+                 "%s: Could not insert compositor", __FUNCTION__);
+    delete vie_compositor;
+    return kViECompositorUnknownError;
+  }
+
+  compositor_id = new_compositor_id;
+  WEBRTC_TRACE(webrtc::kTraceInfo, webrtc::kTraceVideo, ViEId(engine_id_),
+               "%s, compositor_id: %d", __FUNCTION__, compositor_id);
+  return 0;
+}
+
+int ViEInputManager::DestroyCompositor(int compositor_id) {
+  WEBRTC_TRACE(webrtc::kTraceInfo, webrtc::kTraceVideo, ViEId(engine_id_),
+               "%s(compositor_id: %d)", __FUNCTION__, compositor_id);
+
+  ViEFrameCompositor* vie_compositor = NULL;
+  {
+    // We need exclusive access to the object to delete it.
+    // Take this write lock first since the read lock is taken before map_cs_.
+    ViEManagerWriteScoped wl(*this);
+
+    CriticalSectionScoped cs(map_cs_);
+    vie_compositor = ViECompositorPtr(compositor_id);
+    if (!vie_compositor) {
+      WEBRTC_TRACE(webrtc::kTraceError, webrtc::kTraceVideo, ViEId(engine_id_),
+                   "%s(compositor_id: %d) - No such compositor", __FUNCTION__,
+                   compositor_id);
+      return -1;
+    }
+    int num_callbacks = vie_compositor->NumberOfRegisteredFrameCallbacks();
+    if (num_callbacks > 0) {
+      WEBRTC_TRACE(webrtc::kTraceWarning, webrtc::kTraceVideo,
+                   ViEId(engine_id_), "%s(compositor_id: %d) - %u registered "
+                   "callbacks when destroying compositor", __FUNCTION__,
+                   compositor_id, num_callbacks);
+    }
+    vie_frame_provider_map_.Erase(compositor_id);
+    ReturnCompositorId(compositor_id);
+    // Leave cs before deleting the compositor, since deleting it waits for
+    // the providers it is registered with.
+  }
+  delete vie_compositor;
+  return 0;
+}
+
 bool ViEInputManager::GetFreeCaptureId(int& freecapture_id) {
   WEBRTC_TRACE(webrtc::kTraceInfo, webrtc::kTraceVideo, ViEId(engine_id_), "%s",
                __FUNCTION__);
@@ -500,6 +579,33 @@ void ViEInputManager::ReturnFileId(int file_id) {
   return;
 }
 
+bool ViEInputManager::GetFreeCompositorId(int& free_compositor_id) {
+  WEBRTC_TRACE(webrtc::kTraceInfo, webrtc::kTraceVideo, ViEId(engine_id_), "%s",
+               __FUNCTION__);
+
+  for (int id = 0; id < kViEMaxCompositors; id++) {
+    if (free_compositor_id_[id]) {
+      free_compositor_id_[id] = false;
+      free_compositor_id = id + kViECompositorIdBase;
+      WEBRTC_TRACE(webrtc::kTraceInfo, webrtc::kTraceVideo, ViEId(engine_id_),
+                   "%s: new id: %d", __FUNCTION__, free_compositor_id);
+      return true;
+    }
+  }
+  return false;
+}
+
+void ViEInputManager::ReturnCompositorId(int compositor_id) {
+  WEBRTC_TRACE(webrtc::kTraceInfo, webrtc::kTraceVideo, ViEId(engine_id_),
+               "%s(%d)", __FUNCTION__, compositor_id);
+
+  CriticalSectionScoped cs(map_cs_);
+  if (compositor_id >= kViECompositorIdBase &&
+      compositor_id < kViEMaxCompositors + kViECompositorIdBase) {
+    free_compositor_id_[compositor_id - kViECompositorIdBase] = true;
+  }
+}
+
 ViEFrameProviderBase* ViEInputManager::ViEFrameProvider(
     const ViEFrameCallback* capture_observer) const {
   assert(capture_observer);
@@ -573,6 +679,22 @@ ViEFilePlayer* ViEInputManager::ViEFilePlayerPtr(int file_id) const {
   return vie_file_player;
 }
 
+ViEFrameCompositor* ViEInputManager::ViECompositorPtr(
+    int compositor_id) const {
+  if (compositor_id < kViECompositorIdBase ||
+      compositor_id > kViECompositorIdMax) {
+    return NULL;
+  }
+  CriticalSectionScoped cs(map_cs_);
+  MapItem* map_item = vie_frame_provider_map_.Find(compositor_id);
+  if (!map_item) {
+    return NULL;
+  }
+  ViEFrameCompositor* vie_compositor =
+      static_cast<ViEFrameCompositor*>(map_item->GetItem());
+  return vie_compositor;
+}
+
 ViEInputManagerScoped::ViEInputManagerScoped(
     const ViEInputManager& vie_input_manager)
     : ViEManagerScopedBase(vie_input_manager) {
@@ -600,4 +722,9 @@ ViEFilePlayer* ViEInputManagerScoped::FilePlayer(int file_id) const {
       file_id);
 }
 
+ViEFrameCompositor* ViEInputManagerScoped::Compositor(int compositor_id) const {
+  return static_cast<const ViEInputManager*>(vie_manager_)->ViECompositorPtr(
+      compositor_id);
+}
+
 }  // namespace webrtc
@@ -27,6 +27,7 @@ class RWLockWrapper;
 class ViECapturer;
 class ViEExternalCapture;
 class ViEFilePlayer;
+class ViEFrameCompositor;
 class VoiceEngine;
 
 class ViEInputManager : private ViEManagerBase {
@@ -82,6 +83,13 @@ class ViEInputManager : private ViEManagerBase {
                        int& file_id);
   int DestroyFilePlayer(int file_id);
 
+  // Creates a compositor producing width x height pictures at most
+  // max_frame_rate times per second, and assigns a compositor id for it.
+  // Return zero on success, ViEError on failure.
+  int CreateCompositor(int width, int height, int max_frame_rate,
+                       int& compositor_id);
+  int DestroyCompositor(int compositor_id);
+
  private:
   // Gets and allocates a free capture device id. Assumed protected by caller.
   bool GetFreeCaptureId(int& freecapture_id);
@@ -95,6 +103,12 @@ class ViEInputManager : private ViEManagerBase {
   // Frees a file id assigned in GetFreeFileId.
   void ReturnFileId(int file_id);
 
+  // Gets and allocates a free compositor id. Assumed protected by caller.
+  bool GetFreeCompositorId(int& free_compositor_id);
+
+  // Frees a compositor id assigned in GetFreeCompositorId.
+  void ReturnCompositorId(int compositor_id);
+
   // Gets the ViEFrameProvider for this capture observer.
   ViEFrameProviderBase* ViEFrameProvider(
       const ViEFrameCallback* capture_observer) const;
@@ -111,6 +125,9 @@ class ViEInputManager : private ViEManagerBase {
   // Gets the ViEFilePlayer for this file_id.
   ViEFilePlayer* ViEFilePlayerPtr(int file_id) const;
 
+  // Gets the ViEFrameCompositor for this compositor_id.
+  ViEFrameCompositor* ViECompositorPtr(int compositor_id) const;
+
   int engine_id_;
   CriticalSectionWrapper& map_cs_;
   MapWrapper vie_frame_provider_map_;
@@ -122,6 +139,9 @@ class ViEInputManager : private ViEManagerBase {
   // File Players.
   int free_file_id_[kViEMaxFilePlayers];
 
+  // Compositors.
+  int free_compositor_id_[kViEMaxCompositors];
+
   ProcessThread* module_process_thread_;
 };
 
@@ -132,6 +152,7 @@ class ViEInputManagerScoped: private ViEManagerScopedBase {
 
   ViECapturer* Capture(int capture_id) const;
   ViEFilePlayer* FilePlayer(int file_id) const;
+  ViEFrameCompositor* Compositor(int compositor_id) const;
   ViEFrameProviderBase* FrameProvider(int provider_id) const;
   ViEFrameProviderBase* FrameProvider(const ViEFrameCallback*
                                       capture_observer) const;
@@ -164,6 +164,8 @@ int ViEExternalRendererImpl::SetViEExternalRenderer(
 WebRtc_Word32 ViEExternalRendererImpl::RenderFrame(
     const WebRtc_UWord32 stream_id,
     VideoFrame&   video_frame) {
+  // External renderers get a packed buffer.
+  video_frame.Materialize();
   VideoFrame converted_frame;
   VideoFrame* p_converted_frame = &converted_frame;
 
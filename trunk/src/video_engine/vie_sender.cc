@@ -11,20 +11,24 @@
 #include <cassert>
 
 #include "critical_section_wrapper.h"
+#include "latency_stats.h"
 #include "rtp_dump.h"
+#include "tick_util.h"
 #include "vie_sender.h"
 #include "trace.h"
 
 namespace webrtc {
 
-ViESender::ViESender(int engine_id, int channel_id)
+ViESender::ViESender(int engine_id, int channel_id,
+                     LatencyStats* latency_stats)
     : engine_id_(engine_id),
       channel_id_(channel_id),
       critsect_(*CriticalSectionWrapper::CreateCriticalSection()),
       external_encryption_(NULL),
       encryption_buffer_(NULL),
       transport_(NULL),
-      rtp_dump_(NULL) {
+      rtp_dump_(NULL),
+      latency_stats_(latency_stats) {
 }
 
 ViESender::~ViESender() {
@@ -157,8 +161,11 @@ int ViESender::SendPacket(int vie_id, const void* data, int len) {
     send_packet = encryption_buffer_;
   }
 
+  const WebRtc_Word64 send_start_ms = TickTime::MillisecondTimestamp();
   const int bytes_sent = transport_->SendPacket(channel_id_, send_packet,
                                                 send_packet_length);
+  latency_stats_->Add(kLatencyTransport,
+                      TickTime::MillisecondTimestamp() - send_start_ms);
   if (bytes_sent != send_packet_length) {
     WEBRTC_TRACE(webrtc::kTraceWarning, webrtc::kTraceVideo,
                  ViEId(engine_id_, channel_id_),
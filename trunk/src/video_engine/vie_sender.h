@@ -22,13 +22,15 @@
 namespace webrtc {
 
 class CriticalSectionWrapper;
+class LatencyStats;
 class RtpDump;
 class Transport;
 class VideoCodingModule;
 
 class ViESender: public Transport {
  public:
-  ViESender(int engine_id, int channel_id);
+  // The time spent in the transport is added to |latency_stats|.
+  ViESender(int engine_id, int channel_id, LatencyStats* latency_stats);
   ~ViESender();
 
   // Registers an encryption class to use before sending packets.
@@ -57,6 +59,7 @@ class ViESender: public Transport {
   WebRtc_UWord8* encryption_buffer_;
   Transport* transport_;
   RtpDump* rtp_dump_;
+  LatencyStats* latency_stats_;
 };
 
 }  // namespace webrtc
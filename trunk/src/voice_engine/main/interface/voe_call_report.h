@@ -14,6 +14,7 @@
 //  - Long-term echo metric statistics.
 //  - Round Trip Time (RTT) statistics.
 //  - Dead-or-Alive connection summary.
+//  - Latency of the stages of the media pipeline.
 //  - Generation of call reports to text files.
 //
 // Usage example, omitting error checking:
@@ -72,6 +73,12 @@ public:
     virtual int GetDeadOrAliveSummary(int channel, int& numOfDeadDetections,
                                       int& numOfAliveDetections) = 0;
 
+    // Gets latency histograms for the stages of the media pipeline of
+    // |channel|, from captured audio to packets handed to the transport on
+    // the sending side and from received packets to played out audio on the
+    // receiving side.
+    virtual int GetLatencySummary(int channel, LatencyStatistics& stats) = 0;
+
     // Creates a text file in ASCII format, which contains a summary
     // of all the statistics that can be obtained by the call report sub-API.
     virtual int WriteReportToFile(const char* fileNameUTF8) = 0;
@@ -18,6 +18,7 @@
 #include "process_thread.h"
 #include "rtp_dump.h"
 #include "statistics.h"
+#include "tick_util.h"
 #include "trace.h"
 #include "transmit_mixer.h"
 #include "utility.h"
@@ -57,6 +58,14 @@ Channel::SendData(FrameType frameType,
         _rtpRtcpModule.SetAudioLevel(_rtpAudioProc->level_estimator()->RMS());
     }
 
+    // Called from Process() in EncodeAndSend(), on the same thread.
+    const WebRtc_Word64 packetizeStartMs = TickTime::MillisecondTimestamp();
+    if (_encodeStartMs >= 0)
+    {
+        _latencyStats.Add(kLatencyEncode, packetizeStartMs - _encodeStartMs);
+        _encodeStartMs = -1;
+    }
+
     // Push data from ACM to RTP/RTCP-module to deliver audio frame for
     // packetization.
     // This call will trigger Transport::SendPacket() from the RTP/RTCP module.
@@ -72,6 +81,8 @@ Channel::SendData(FrameType frameType,
             "Channel::SendData() failed to send data to RTP/RTCP module");
         return -1;
     }
+    _latencyStats.Add(kLatencyPacketize,
+                      TickTime::MillisecondTimestamp() - packetizeStartMs);
 
     _lastLocalTimeStamp = timeStamp;
     _lastPayloadType = payloadType;
@@ -206,11 +217,15 @@ Channel::SendPacket(int channel, const void *data, int len)
         }
     }
 
+    const WebRtc_Word64 sendStartMs = TickTime::MillisecondTimestamp();
+
     // Packet transmission using WebRtc socket transport
     if (!_externalTransport)
     {
         int n = _transportPtr->SendPacket(channel, bufferToSendPtr,
                                           bufferLength);
+        _latencyStats.Add(kLatencyTransport,
+                          TickTime::MillisecondTimestamp() - sendStartMs);
         if (n < 0)
         {
             WEBRTC_TRACE(kTraceError, kTraceVoice,
@@ -229,6 +244,8 @@ Channel::SendPacket(int channel, const void *data, int len)
         int n = _transportPtr->SendPacket(channel,
                                           bufferToSendPtr,
                                           bufferLength);
+        _latencyStats.Add(kLatencyTransport,
+                          TickTime::MillisecondTimestamp() - sendStartMs);
         if (n < 0)
         {
             WEBRTC_TRACE(kTraceError, kTraceVoice,
@@ -829,6 +846,7 @@ WebRtc_Word32 Channel::GetAudioFrame(const WebRtc_Word32 id,
                  "Channel::GetAudioFrame(id=%d)", id);
 
     // Get 10ms raw PCM data from the ACM (mixer limits output frequency)
+    const WebRtc_Word64 decodeStartMs = TickTime::MillisecondTimestamp();
     if (_audioCodingModule.PlayoutData10Ms(
         audioFrame._frequencyInHz, (AudioFrame&)audioFrame) == -1)
     {
@@ -836,6 +854,15 @@ WebRtc_Word32 Channel::GetAudioFrame(const WebRtc_Word32 id,
                      VoEId(_instanceId,_channelId),
                      "Channel::GetAudioFrame() PlayoutData10Ms() failed!");
     }
+    _latencyStats.Add(kLatencyDecode,
+                      TickTime::MillisecondTimestamp() - decodeStartMs);
+
+    // The audio is played out after the buffering in the audio device.
+    WebRtc_UWord16 playoutDelayMs(0);
+    if (_audioDeviceModulePtr->PlayoutDelay(&playoutDelayMs) == 0)
+    {
+        _latencyStats.Add(kLatencyRender, playoutDelayMs);
+    }
 
     if (_RxVadDetection)
     {
@@ -1164,6 +1191,7 @@ Channel::Channel(const WebRtc_Word32 channelId,
     _countAliveDetections(0),
     _countDeadDetections(0),
     _outputSpeechType(AudioFrame::kNormalSpeech),
+    _encodeStartMs(-1),
     _averageDelayMs(0),
     _previousSequenceNumber(0),
     _previousTimestamp(0),
@@ -5962,7 +5990,7 @@ Channel::PrepareEncodeAndSend(int mixingFrequency)
 }
 
 WebRtc_UWord32
-Channel::EncodeAndSend()
+Channel::EncodeAndSend(WebRtc_Word64 captureTimeMs)
 {
     WEBRTC_TRACE(kTraceStream, kTraceVoice, VoEId(_instanceId,_channelId),
                  "Channel::EncodeAndSend()");
@@ -5992,6 +6020,13 @@ Channel::EncodeAndSend()
 
     // --- Encode if complete frame is ready
 
+    const WebRtc_Word64 nowMs = TickTime::MillisecondTimestamp();
+    if (captureTimeMs >= 0)
+    {
+        _latencyStats.Add(kLatencyCaptureToEncode, nowMs - captureTimeMs);
+    }
+    _encodeStartMs = nowMs;
+
     // This call will trigger AudioPacketizationCallback::SendData if encoding
     // is done and payload is ready for packetization and transmission.
     return _audioCodingModule.Process();
@@ -6492,6 +6527,18 @@ Channel::GetPlayoutTimeStamp(WebRtc_UWord32& playoutTimestamp)
     return 0;
 }
 
+void
+Channel::GetLatencyStatistics(LatencyStatistics& stats) const
+{
+    _latencyStats.GetStatistics(stats);
+}
+
+void
+Channel::ResetLatencyStatistics()
+{
+    _latencyStats.Reset();
+}
+
 void
 Channel::ResetDeadOrAliveCounters()
 {
@@ -6594,6 +6641,11 @@ Channel::UpdatePacketDelay(const WebRtc_UWord32 timestamp,
         {
             timeStampDiffMs = 0;
         }
+        else
+        {
+            // The packet is played out this much later.
+            _latencyStats.Add(kLatencyJitterBuffer, timeStampDiffMs);
+        }
 
         if (_averageDelayMs == 0)
         {
@@ -18,6 +18,7 @@
 #include "dtmf_inband_queue.h"
 #include "file_player.h"
 #include "file_recorder.h"
+#include "latency_stats.h"
 #include "level_indicator.h"
 #include "resampler.h"
 #include "rtp_rtcp.h"
@@ -239,6 +240,8 @@ public:
     int ResetRTCPStatistics();
     int GetRoundTripTimeSummary(StatVal& delaysMs) const;
     int GetDeadOrAliveCounters(int& countDead, int& countAlive) const;
+    void GetLatencyStatistics(LatencyStatistics& stats) const;
+    void ResetLatencyStatistics();
 
     // VoENetEqStats
     int GetNetworkStatistics(NetworkStatistics& stats);
@@ -515,7 +518,8 @@ public:
 #endif
     WebRtc_UWord32 Demultiplex(const AudioFrame& audioFrame);
     WebRtc_UWord32 PrepareEncodeAndSend(int mixingFrequency);
-    WebRtc_UWord32 EncodeAndSend();
+    // |captureTimeMs| is the time the audio was delivered by the audio device.
+    WebRtc_UWord32 EncodeAndSend(WebRtc_Word64 captureTimeMs);
 
 private:
     int InsertInbandDtmfTone();
@@ -640,6 +644,9 @@ private:
     WebRtc_UWord32 _countAliveDetections;
     WebRtc_UWord32 _countDeadDetections;
     AudioFrame::SpeechType _outputSpeechType;
+    // VoECallReport latency
+    LatencyStats _latencyStats;
+    WebRtc_Word64 _encodeStartMs;
     // VoEVideoSync
     WebRtc_UWord32 _averageDelayMs;
     WebRtc_UWord16 _previousSequenceNumber;
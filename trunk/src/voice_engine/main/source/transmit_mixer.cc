@@ -16,6 +16,7 @@
 #include "critical_section_wrapper.h"
 #include "event_wrapper.h"
 #include "statistics.h"
+#include "tick_util.h"
 #include "trace.h"
 #include "utility.h"
 #include "voe_base_impl.h"
@@ -196,7 +197,8 @@ TransmitMixer::TransmitMixer(const WebRtc_UWord32 instanceId) :
     _mute(false),
     _remainingMuteMicTimeMs(0),
     _mixingFrequency(0),
-    _includeAudioLevelIndication(false)
+    _includeAudioLevelIndication(false),
+    _captureTimeMs(-1)
 {
     WEBRTC_TRACE(kTraceMemory, kTraceVoice, VoEId(_instanceId, -1),
                  "TransmitMixer::TransmitMixer() - ctor");
@@ -313,6 +315,7 @@ TransmitMixer::PrepareDemux(const WebRtc_Word8* audioSamples,
                  "currentMicLevel=%u)", nSamples, nChannels, samplesPerSec,
                  totalDelayMS, clockDrift, currentMicLevel);
 
+    _captureTimeMs = TickTime::MillisecondTimestamp();
 
     const int mixingFrequency = _mixingFrequency;
 
@@ -437,6 +440,7 @@ TransmitMixer::PrepareDemux(const WebRtc_Word8* audioSamples,
                  "currentMicLevel=%u)", nSamples, nChannels, samplesPerSec,
                  totalDelayMS, clockDrift, currentMicLevel);
 
+    _captureTimeMs = TickTime::MillisecondTimestamp();
 
     const int mixingFrequency = _mixingFrequency;
 
@@ -585,7 +589,7 @@ TransmitMixer::EncodeAndSend()
     {
         if (channelPtr->Sending() && !channelPtr->InputIsOnHold())
         {
-            channelPtr->EncodeAndSend();
+            channelPtr->EncodeAndSend(_captureTimeMs);
         }
         channelPtr = sc.GetNextChannel(iterator);
     }
@@ -233,6 +233,8 @@ private:
     WebRtc_Word32 _remainingMuteMicTimeMs;
     int _mixingFrequency;
     bool _includeAudioLevelIndication;
+    // Time the audio being processed was delivered by the audio device.
+    WebRtc_Word64 _captureTimeMs;
 };
 
 #endif // WEBRTC_VOICE_ENGINE_TRANSMIT_MIXER_H
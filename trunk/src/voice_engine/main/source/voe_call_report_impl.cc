@@ -118,6 +118,7 @@ int VoECallReportImpl::ResetCallReportStatistics(int channel)
         }
         channelPtr->ResetDeadOrAliveCounters();
         channelPtr->ResetRTCPStatistics();
+        channelPtr->ResetLatencyStatistics();
     }
     else
     {
@@ -136,6 +137,7 @@ int VoECallReportImpl::ResetCallReportStatistics(int channel)
             {
                 channelPtr->ResetDeadOrAliveCounters();
                 channelPtr->ResetRTCPStatistics();
+                channelPtr->ResetLatencyStatistics();
             }
         }
         delete[] channelsArray;
@@ -309,6 +311,31 @@ int VoECallReportImpl::GetDeadOrAliveSummaryInternal(int channel,
                                               numOfAliveDetections);
 }
 
+int VoECallReportImpl::GetLatencySummary(int channel,
+                                         LatencyStatistics& stats)
+{
+    WEBRTC_TRACE(kTraceApiCall, kTraceVoice, VoEId(_instanceId, -1),
+                 "GetLatencySummary(channel=%d)", channel);
+
+    if (!_engineStatistics.Initialized())
+    {
+        _engineStatistics.SetLastError(VE_NOT_INITED, kTraceError);
+        return -1;
+    }
+    voe::ScopedChannel sc(_channelManager, channel);
+    voe::Channel* channelPtr = sc.ChannelPtr();
+    if (channelPtr == NULL)
+    {
+        _engineStatistics.SetLastError(VE_CHANNEL_NOT_VALID, kTraceError,
+                                       "GetLatencySummary() failed to "
+                                       "locate channel");
+        return -1;
+    }
+
+    channelPtr->GetLatencyStatistics(stats);
+    return 0;
+}
+
 int VoECallReportImpl::WriteReportToFile(const char* fileNameUTF8)
 {
     WEBRTC_TRACE(kTraceApiCall, kTraceVoice, VoEId(_instanceId, -1),
@@ -389,6 +416,31 @@ int VoECallReportImpl::WriteReportToFile(const char* fileNameUTF8)
         }
     }
 
+    _file.WriteText("\nPipeline Latency\n");
+    _file.WriteText("----------------\n\n");
+
+    const char* stageNames[kNumLatencyStages] = {
+        "capture to encode", "encode", "packetize", "transport",
+        "jitter buffer", "decode", "render"};
+    for (int ch = 0; ch < numOfChannels; ch++)
+    {
+        voe::ScopedChannel sc(_channelManager, channelsArray[ch]);
+        voe::Channel* channelPtr = sc.ChannelPtr();
+        if (channelPtr)
+        {
+            LatencyStatistics latency;
+            _file.WriteText("channel %d:\n", ch);
+            channelPtr->GetLatencyStatistics(latency);
+            for (int i = 0; i < kNumLatencyStages; i++)
+            {
+                _file.WriteText("  %-17s min:%5d max:%5d avg:%5d [ms]\n",
+                                stageNames[i], latency.stages[i].minMs,
+                                latency.stages[i].maxMs,
+                                latency.stages[i].averageMs);
+            }
+        }
+    }
+
     delete[] channelsArray;
 
     EchoStatistics echo;
@@ -38,6 +38,8 @@ public:
     virtual int GetDeadOrAliveSummary(int channel, int& numOfDeadDetections,
                                       int& numOfAliveDetections);
 
+    virtual int GetLatencySummary(int channel, LatencyStatistics& stats);
+
     virtual int WriteReportToFile(const char* fileNameUTF8);
 
 protected:
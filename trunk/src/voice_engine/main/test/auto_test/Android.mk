@@ -18,6 +18,7 @@ LOCAL_MODULE_TAGS := tests
 LOCAL_CPP_EXTENSION := .cc
 LOCAL_SRC_FILES:= \
     automated_mode.cc \
+    voe_capacity_test.cc \
     voe_cpu_test.cc \
     voe_standard_test.cc \
     voe_stress_test.cc \
@@ -35,6 +36,7 @@ LOCAL_C_INCLUDES := \
     $(LOCAL_PATH)/../../interface \
     $(LOCAL_PATH)/../../../.. \
     $(LOCAL_PATH)/../../../../modules/audio_device/main/interface \
+    $(LOCAL_PATH)/../../../../modules/audio_device/main/source/virtual_clock \
     $(LOCAL_PATH)/../../../../modules/interface \
     $(LOCAL_PATH)/../../../../system_wrappers/interface \
     $(LOCAL_PATH)/../../../../../test \
@@ -0,0 +1,159 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "voe_capacity_test.h"
+
+#include "../../source/voice_engine_defines.h"
+#include "audio_device_virtual_clock.h"
+#include "tick_util.h"
+
+using namespace webrtc;
+
+namespace voetest {
+
+#define CHECK(expr)                                             \
+    if (expr)                                                   \
+    {                                                           \
+        printf("Error at line: %i, %s \n", __LINE__, #expr);    \
+        printf("Error code: %i \n", base->LastError());         \
+        return -1;                                              \
+    }
+
+// Virtual call length of each scenario.
+const unsigned int kScenarioTimeMs = 10000;
+const int kBasePort = 12000;
+
+static void PrintHistogram(
+    const char* name,
+    const AudioDeviceVirtualClock::TickHistogram& histogram) {
+  if (histogram.ticks == 0) {
+    TEST_LOG("  %s: no ticks\n", name);
+    return;
+  }
+  TEST_LOG("  %s: %u ticks, mean %u us, min %u us, max %u us\n", name,
+           histogram.ticks,
+           static_cast<unsigned int>(histogram.totalUs / histogram.ticks),
+           histogram.minUs, histogram.maxUs);
+  for (int i = 0; i < AudioDeviceVirtualClock::TickHistogram::kNumBuckets;
+      i++) {
+    if (histogram.buckets[i] == 0) {
+      continue;
+    }
+    const unsigned int low = (i == 0) ? 0 : (1u << (i - 1));
+    const unsigned int high = 1u << i;
+    TEST_LOG("    [%6u, %6u) us: %6u (%5.1f%%)\n", low, high,
+             histogram.buckets[i],
+             100.0 * histogram.buckets[i] / histogram.ticks);
+  }
+}
+
+VoECapacityTest::VoECapacityTest(VoETestManager& mgr)
+    : _mgr(mgr) {
+}
+
+int VoECapacityTest::DoTest() {
+  printf("------------------------------------------------\n");
+  printf(" Engine Capacity Test (virtual clock)\n");
+  printf("------------------------------------------------\n");
+
+  const int kScenarios[] = { 1, 8, 16, 32 };
+  const int maxChannels = _mgr.BasePtr()->MaxNumOfChannels();
+  for (size_t i = 0; i < sizeof(kScenarios) / sizeof(kScenarios[0]); i++) {
+    if (kScenarios[i] > maxChannels) {
+      break;
+    }
+    if (RunScenario(kScenarios[i]) != 0) {
+      return -1;
+    }
+  }
+  return 0;
+}
+
+int VoECapacityTest::RunScenario(int numChannels) {
+  VoEBase* base = _mgr.BasePtr();
+  VoEFile* file = _mgr.FilePtr();
+  VoECodec* codec = _mgr.CodecPtr();
+  VoEAudioProcessing* apm = _mgr.APMPtr();
+
+  CodecInst isac;
+  isac.pltype = 103;
+  strcpy(isac.plname, "ISAC");
+  isac.pacsize = 480;
+  isac.plfreq = 16000;
+  isac.channels = 1;
+  isac.rate = -1;
+
+  AudioDeviceVirtualClock* adm = AudioDeviceVirtualClock::Create(0);
+  adm->AddRef();
+  // Run the clock as fast as the engine can process audio.
+  adm->SetSpeed(0.0f);
+
+  CHECK(base->Init(adm));
+  CHECK(apm->SetAgcStatus(true, kAgcAdaptiveAnalog));
+  CHECK(apm->SetNsStatus(true, kNsModerateSuppression));
+  CHECK(apm->SetEcStatus(true, kEcAec));
+
+  int channels[kVoiceEngineMaxNumOfChannels];
+  for (int i = 0; i < numChannels; i++) {
+    const int channel = base->CreateChannel();
+    CHECK(channel == -1);
+    channels[i] = channel;
+    const int port = kBasePort + 2 * i;
+    CHECK(base->SetLocalReceiver(channel, port));
+    CHECK(base->SetSendDestination(channel, port, "127.0.0.1"));
+    CHECK(codec->SetRecPayloadType(channel, isac));
+    CHECK(codec->SetSendCodec(channel, isac));
+    CHECK(codec->SetVADStatus(channel, true));
+    CHECK(base->StartReceive(channel));
+    CHECK(base->StartPlayout(channel));
+    CHECK(base->StartSend(channel));
+    CHECK(file->StartPlayingFileAsMicrophone(channel, _mgr.AudioFilename(),
+                                             true, true));
+  }
+
+  adm->ResetTickHistograms();
+  const unsigned int startVirtualMs = adm->VirtualTimeMs();
+  const TickTime startTime = TickTime::Now();
+  while (adm->VirtualTimeMs() - startVirtualMs < kScenarioTimeMs) {
+    SLEEP(10);
+  }
+  const WebRtc_Word64 wallMs = (TickTime::Now() - startTime).Milliseconds();
+  const unsigned int virtualMs = adm->VirtualTimeMs() - startVirtualMs;
+
+  AudioDeviceVirtualClock::TickHistogram recording;
+  AudioDeviceVirtualClock::TickHistogram playout;
+  adm->GetTickHistograms(&recording, &playout);
+
+  const double realTimeFactor = (wallMs > 0) ?
+      static_cast<double>(virtualMs) / wallMs : 0.0;
+  TEST_LOG("\n%d channel(s): %u ms of audio in %d ms, %.1fx real time, "
+           "~%.0f channels in real time\n", numChannels, virtualMs,
+           static_cast<int>(wallMs), realTimeFactor,
+           realTimeFactor * numChannels);
+  PrintHistogram("recording", recording);
+  PrintHistogram("playout", playout);
+
+  for (int i = 0; i < numChannels; i++) {
+    CHECK(file->StopPlayingFileAsMicrophone(channels[i]));
+    CHECK(base->StopSend(channels[i]));
+    CHECK(base->StopPlayout(channels[i]));
+    CHECK(base->StopReceive(channels[i]));
+    CHECK(base->DeleteChannel(channels[i]));
+  }
+  CHECK(base->Terminate());
+  adm->Release();
+
+  return 0;
+}
+
+} //  namespace voetest
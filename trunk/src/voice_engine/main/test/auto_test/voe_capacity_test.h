@@ -0,0 +1,36 @@
+/*
+ *  Copyright (c) 2011 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_VOICE_ENGINE_VOE_CAPACITY_TEST_H
+#define WEBRTC_VOICE_ENGINE_VOE_CAPACITY_TEST_H
+
+#include "voe_standard_test.h"
+
+namespace voetest {
+
+class VoETestManager;
+
+// Measures how many full-duplex channels the engine can process per core.
+// The engine is driven by a virtual-clock audio device that runs faster than
+// real time, so no sound card is needed and the run time does not depend on
+// the call length.
+class VoECapacityTest {
+ public:
+  VoECapacityTest(VoETestManager& mgr);
+  ~VoECapacityTest() {}
+  int DoTest();
+ private:
+  int RunScenario(int numChannels);
+  VoETestManager& _mgr;
+};
+
+} // namespace voetest
+
+#endif // WEBRTC_VOICE_ENGINE_VOE_CAPACITY_TEST_H
@@ -43,6 +43,7 @@
 #include "voe_stress_test.h"
 #include "voe_unit_test.h"
 #include "voe_cpu_test.h"
+#include "voe_capacity_test.h"
 
 using namespace webrtc;
 
@@ -3290,6 +3291,9 @@ int runAutoTest(TestType testType, ExtendedSelection extendedSel) {
   } else if (testType == CPU) {
     VoECpuTest cpuTest(tm);
     mainRet = cpuTest.DoTest();
+  } else if (testType == Capacity) {
+    VoECapacityTest capacityTest(tm);
+    mainRet = capacityTest.DoTest();
   } else {
     // Should never end up here
     TEST_LOG("INVALID SELECTION \n");
@@ -3674,6 +3678,7 @@ int RunInManualMode() {
   printf(" (3)  Stress test(s)...\n");
   printf(" (4)  Unit test(s)...\n");
   printf(" (5)  CPU & memory reference test [Windows]...\n");
+  printf(" (6)  Engine capacity test [virtual clock]...\n");
   printf("\n: ");
 
   int selection(0);
@@ -3704,6 +3709,9 @@ int RunInManualMode() {
     case 5:
       testType = CPU;
       break;
+    case 6:
+      testType = Capacity;
+      break;
     default:
       TEST_LOG("Invalid selection!\n");
       return 0;
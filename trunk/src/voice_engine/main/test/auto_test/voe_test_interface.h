@@ -30,7 +30,8 @@ using namespace webrtc;
 
 // TestType enumerator
 enum TestType {
-  Invalid = -1, Standard = 0, Extended = 1, Stress = 2, Unit = 3, CPU = 4
+  Invalid = -1, Standard = 0, Extended = 1, Stress = 2, Unit = 3, CPU = 4,
+  Capacity = 5
 };
 
 // ExtendedSelection enumerator
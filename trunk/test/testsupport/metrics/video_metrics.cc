@@ -10,9 +10,30 @@
 
 #include "testsupport/metrics/video_metrics.h"
 
-#include <algorithm> // min_element, max_element
+#include <algorithm> // min_element, max_element, sort
 #include <cmath>
-#include <fstream>
+#include <cstdio>
+#include <cstring>
+
+#if defined(WEBRTC_USE_SSE2)
+#include <emmintrin.h>
+#endif
+
+#include "system_wrappers/interface/condition_variable_wrapper.h"
+#include "system_wrappers/interface/cpu_info.h"
+#include "system_wrappers/interface/critical_section_wrapper.h"
+#include "system_wrappers/interface/thread_wrapper.h"
+#include "testsupport/frame_reader.h"
+
+using webrtc::ConditionVariableWrapper;
+using webrtc::CriticalSectionScoped;
+using webrtc::CriticalSectionWrapper;
+using webrtc::ThreadWrapper;
+
+// Frame buffers per worker thread; one is calculated while the next is
+// being filled.
+static const int kJobsPerThread = 2;
+static const int kMaxThreads = 32;
 
 // Calculates PSNR from MSE
 static inline double CalcPsnr(double mse) {
@@ -26,103 +47,27 @@ static bool LessForFrameResultValue (const FrameResult& s1,
     return s1.value < s2.value;
 }
 
-int
-PsnrFromFiles(const WebRtc_Word8 *refFileName, const WebRtc_Word8 *testFileName,
-              WebRtc_Word32 width, WebRtc_Word32 height, QualityMetricsResult *result)
-{
-    FILE *refFp = fopen(refFileName, "rb");
-    if (refFp == NULL )
-    {
-        // cannot open reference file
-        fprintf(stderr, "Cannot open file %s\n", refFileName);
-        return -1;
-    }
-
-    FILE *testFp = fopen(testFileName, "rb");
-    if (testFp == NULL )
-    {
-        // cannot open test file
-        fprintf(stderr, "Cannot open file %s\n", testFileName);
-        fclose(refFp);
-        return -2;
-    }
-
-    double mse = 0.0;
-    double mseSum = 0.0;
-    WebRtc_Word32 frames = 0;
-
-    // Allocating size for one I420 frame.
-    WebRtc_Word32 frameBytes = 3 * width * height >> 1;
-    WebRtc_UWord8 *ref = new WebRtc_UWord8[frameBytes];
-    WebRtc_UWord8 *test = new WebRtc_UWord8[frameBytes];
-
-    WebRtc_Word32 refBytes = (WebRtc_Word32) fread(ref, 1, frameBytes, refFp);
-    WebRtc_Word32 testBytes = (WebRtc_Word32) fread(test, 1, frameBytes, testFp);
-
-    while (refBytes == frameBytes && testBytes == frameBytes)
-    {
-        mse = 0.0;
-
-        WebRtc_Word32 sh = 8; //boundary offset
-        for (WebRtc_Word32 k2 = sh; k2 < height - sh; k2++)
-        for (WebRtc_Word32 k = sh; k < width - sh; k++)
-        {
-            WebRtc_Word32 kk = k2 * width + k;
-            mse += (test[kk] - ref[kk]) * (test[kk] - ref[kk]);
-        }
-
-        // divide by number of pixels
-        mse /= (double) (width * height);
-
-        // Save statistics for this specific frame
-        FrameResult frame_result;
-        frame_result.value = CalcPsnr(mse);
-        frame_result.frame_number = frames;
-        result->frames.push_back(frame_result);
-
-        // accumulate for total average
-        mseSum += mse;
-        frames++;
-
-        refBytes = (WebRtc_Word32) fread(ref, 1, frameBytes, refFp);
-        testBytes = (WebRtc_Word32) fread(test, 1, frameBytes, testFp);
-    }
+// Used for putting the frames in order
+static bool LessForFrameResultNumber (const FrameResult& s1,
+                                      const FrameResult& s2) {
+    return s1.frame_number < s2.frame_number;
+}
 
-    if (mseSum == 0)
-    {
-        // The PSNR value is undefined in this case.
-        // This value effectively means that the files are equal.
-        result->average = std::numeric_limits<double>::max();
-    }
-    else
-    {
-        result->average = CalcPsnr(mseSum / frames);
-    }
-    int return_code = 0;
-    if (result->frames.size() == 0)
-    {
-      fprintf(stderr, "Tried to measure SSIM from empty files (reference "
-              "file: %s  test file: %s\n", refFileName, testFileName);
-      return_code = -3;
-    }
-    else
-    {
-        // Calculate min/max statistics
-        std::vector<FrameResult>::iterator element;
-        element = min_element(result->frames.begin(),
-                              result->frames.end(), LessForFrameResultValue);
-        result->min = element->value;
-        result->min_frame_number = element->frame_number;
-        element = max_element(result->frames.begin(),
-                              result->frames.end(), LessForFrameResultValue);
-        result->max = element->value;
-        result->max_frame_number = element->frame_number;
-    }
-    delete [] ref;
-    delete [] test;
-    fclose(refFp);
-    fclose(testFp);
-    return return_code;
+// Appends |frames| to |result| and updates the min/max statistics
+static void AddFrameResults(const std::vector<FrameResult>& frames,
+                            QualityMetricsResult *result)
+{
+    result->frames.insert(result->frames.end(), frames.begin(), frames.end());
+
+    std::vector<FrameResult>::iterator element;
+    element = min_element(result->frames.begin(),
+                          result->frames.end(), LessForFrameResultValue);
+    result->min = element->value;
+    result->min_frame_number = element->frame_number;
+    element = max_element(result->frames.begin(),
+                          result->frames.end(), LessForFrameResultValue);
+    result->max = element->value;
+    result->max_frame_number = element->frame_number;
 }
 
 static double
@@ -148,111 +93,158 @@ Similarity(WebRtc_UWord64 sum_s, WebRtc_UWord64 sum_r, WebRtc_UWord64 sum_sq_s,
     return ssim_n * 1.0 / ssim_d;
 }
 
-#if !defined(WEBRTC_USE_SSE2)
-static double
-Ssim8x8C(WebRtc_UWord8 *s, WebRtc_Word32 sp,
-         WebRtc_UWord8 *r, WebRtc_Word32 rp)
+// Sums of one 4x4 block of the two planes
+struct BlockSums
+{
+    WebRtc_UWord32 sum_s;
+    WebRtc_UWord32 sum_r;
+    WebRtc_UWord32 sum_sq_s;
+    WebRtc_UWord32 sum_sq_r;
+    WebRtc_UWord32 sum_sxr;
+};
+
+// Calculates the sums of |numBlocks| 4x4 blocks next to each other
+static void
+BlockSums4x4C(const WebRtc_UWord8 *s, WebRtc_Word32 sp,
+              const WebRtc_UWord8 *r, WebRtc_Word32 rp,
+              WebRtc_Word32 numBlocks, BlockSums *sums)
 {
-    WebRtc_UWord64 sum_s    = 0;
-    WebRtc_UWord64 sum_r    = 0;
-    WebRtc_UWord64 sum_sq_s = 0;
-    WebRtc_UWord64 sum_sq_r = 0;
-    WebRtc_UWord64 sum_sxr  = 0;
-
-    WebRtc_Word32 i, j;
-    for (i = 0; i < 8; i++, s += sp,r += rp)
+    for (WebRtc_Word32 b = 0; b < numBlocks; b++, s += 4, r += 4)
     {
-        for (j = 0; j < 8; j++)
+        BlockSums& block = sums[b];
+        memset(&block, 0, sizeof(block));
+        const WebRtc_UWord8 *sRow = s;
+        const WebRtc_UWord8 *rRow = r;
+        for (WebRtc_Word32 i = 0; i < 4; i++, sRow += sp, rRow += rp)
         {
-            sum_s += s[j];
-            sum_r += r[j];
-            sum_sq_s += s[j] * s[j];
-            sum_sq_r += r[j] * r[j];
-            sum_sxr += s[j] * r[j];
+            for (WebRtc_Word32 j = 0; j < 4; j++)
+            {
+                block.sum_s += sRow[j];
+                block.sum_r += rRow[j];
+                block.sum_sq_s += sRow[j] * sRow[j];
+                block.sum_sq_r += rRow[j] * rRow[j];
+                block.sum_sxr += sRow[j] * rRow[j];
+            }
         }
     }
-    return Similarity(sum_s, sum_r, sum_sq_s, sum_sq_r, sum_sxr, 64);
 }
-#endif
+
+// Squared error of |length| pixels
+static WebRtc_UWord64
+SseRowC(const WebRtc_UWord8 *ref, const WebRtc_UWord8 *test,
+        WebRtc_Word32 length)
+{
+    WebRtc_UWord64 sse = 0;
+    for (WebRtc_Word32 k = 0; k < length; k++)
+    {
+        const WebRtc_Word32 diff = test[k] - ref[k];
+        sse += diff * diff;
+    }
+    return sse;
+}
 
 #if defined(WEBRTC_USE_SSE2)
-#include <emmintrin.h>
-#include <xmmintrin.h>
-static double
-Ssim8x8Sse2(WebRtc_UWord8 *s, WebRtc_Word32 sp,
-            WebRtc_UWord8 *r, WebRtc_Word32 rp)
+// Adds the two 32-bit elements of each 64-bit half of |v| and stores the
+// sums of the low and the high half.
+static inline void
+StoreBlockPairSums(__m128i v, WebRtc_UWord32 *low, WebRtc_UWord32 *high)
+{
+    v = _mm_add_epi32(v, _mm_srli_epi64(v, 32));
+    *low = static_cast<WebRtc_UWord32>(_mm_cvtsi128_si32(v));
+    *high = static_cast<WebRtc_UWord32>(
+        _mm_cvtsi128_si32(_mm_srli_si128(v, 8)));
+}
+
+// Four blocks per iteration; each 16-bit element sums one column of four
+// rows, and _mm_madd_epi16 adds neighbouring columns to 32 bits.
+static void
+BlockSums4x4Sse2(const WebRtc_UWord8 *s, WebRtc_Word32 sp,
+                 const WebRtc_UWord8 *r, WebRtc_Word32 rp,
+                 WebRtc_Word32 numBlocks, BlockSums *sums)
 {
-    WebRtc_Word32 i;
-    const __m128i z     = _mm_setzero_si128();
-    __m128i sum_s_16    = _mm_setzero_si128();
-    __m128i sum_r_16    = _mm_setzero_si128();
-    __m128i sum_sq_s_32 = _mm_setzero_si128();
-    __m128i sum_sq_r_32 = _mm_setzero_si128();
-    __m128i sum_sxr_32  = _mm_setzero_si128();
-
-    for (i = 0; i < 8; i++, s += sp,r += rp)
+    const __m128i z    = _mm_setzero_si128();
+    const __m128i ones = _mm_set1_epi16(1);
+    WebRtc_Word32 b = 0;
+
+    for (; b + 4 <= numBlocks; b += 4)
     {
-        const __m128i s_8 = _mm_loadl_epi64((__m128i*)(s));
-        const __m128i r_8 = _mm_loadl_epi64((__m128i*)(r));
-
-        const __m128i s_16 = _mm_unpacklo_epi8(s_8,z);
-        const __m128i r_16 = _mm_unpacklo_epi8(r_8,z);
-
-        sum_s_16 = _mm_adds_epu16(sum_s_16, s_16);
-        sum_r_16 = _mm_adds_epu16(sum_r_16, r_16);
-        const __m128i sq_s_32 = _mm_madd_epi16(s_16, s_16);
-        sum_sq_s_32 = _mm_add_epi32(sum_sq_s_32, sq_s_32);
-        const __m128i sq_r_32 = _mm_madd_epi16(r_16, r_16);
-        sum_sq_r_32 = _mm_add_epi32(sum_sq_r_32, sq_r_32);
-        const __m128i sxr_32 = _mm_madd_epi16(s_16, r_16);
-        sum_sxr_32 = _mm_add_epi32(sum_sxr_32, sxr_32);
+        // The low and high halves hold two blocks each
+        __m128i sum_s_lo = z, sum_s_hi = z;
+        __m128i sum_r_lo = z, sum_r_hi = z;
+        __m128i sq_s_lo = z, sq_s_hi = z;
+        __m128i sq_r_lo = z, sq_r_hi = z;
+        __m128i sxr_lo = z, sxr_hi = z;
+
+        const WebRtc_UWord8 *sRow = s + 4 * b;
+        const WebRtc_UWord8 *rRow = r + 4 * b;
+        for (WebRtc_Word32 i = 0; i < 4; i++, sRow += sp, rRow += rp)
+        {
+            const __m128i s_8 = _mm_loadu_si128((const __m128i*)(sRow));
+            const __m128i r_8 = _mm_loadu_si128((const __m128i*)(rRow));
+            const __m128i s_lo = _mm_unpacklo_epi8(s_8, z);
+            const __m128i s_hi = _mm_unpackhi_epi8(s_8, z);
+            const __m128i r_lo = _mm_unpacklo_epi8(r_8, z);
+            const __m128i r_hi = _mm_unpackhi_epi8(r_8, z);
+
+            sum_s_lo = _mm_add_epi16(sum_s_lo, s_lo);
+            sum_s_hi = _mm_add_epi16(sum_s_hi, s_hi);
+            sum_r_lo = _mm_add_epi16(sum_r_lo, r_lo);
+            sum_r_hi = _mm_add_epi16(sum_r_hi, r_hi);
+            sq_s_lo = _mm_add_epi32(sq_s_lo, _mm_madd_epi16(s_lo, s_lo));
+            sq_s_hi = _mm_add_epi32(sq_s_hi, _mm_madd_epi16(s_hi, s_hi));
+            sq_r_lo = _mm_add_epi32(sq_r_lo, _mm_madd_epi16(r_lo, r_lo));
+            sq_r_hi = _mm_add_epi32(sq_r_hi, _mm_madd_epi16(r_hi, r_hi));
+            sxr_lo = _mm_add_epi32(sxr_lo, _mm_madd_epi16(s_lo, r_lo));
+            sxr_hi = _mm_add_epi32(sxr_hi, _mm_madd_epi16(s_hi, r_hi));
+        }
+
+        BlockSums *block = sums + b;
+        StoreBlockPairSums(_mm_madd_epi16(sum_s_lo, ones),
+                           &block[0].sum_s, &block[1].sum_s);
+        StoreBlockPairSums(_mm_madd_epi16(sum_s_hi, ones),
+                           &block[2].sum_s, &block[3].sum_s);
+        StoreBlockPairSums(_mm_madd_epi16(sum_r_lo, ones),
+                           &block[0].sum_r, &block[1].sum_r);
+        StoreBlockPairSums(_mm_madd_epi16(sum_r_hi, ones),
+                           &block[2].sum_r, &block[3].sum_r);
+        StoreBlockPairSums(sq_s_lo, &block[0].sum_sq_s, &block[1].sum_sq_s);
+        StoreBlockPairSums(sq_s_hi, &block[2].sum_sq_s, &block[3].sum_sq_s);
+        StoreBlockPairSums(sq_r_lo, &block[0].sum_sq_r, &block[1].sum_sq_r);
+        StoreBlockPairSums(sq_r_hi, &block[2].sum_sq_r, &block[3].sum_sq_r);
+        StoreBlockPairSums(sxr_lo, &block[0].sum_sxr, &block[1].sum_sxr);
+        StoreBlockPairSums(sxr_hi, &block[2].sum_sxr, &block[3].sum_sxr);
     }
+    BlockSums4x4C(s + 4 * b, sp, r + 4 * b, rp, numBlocks - b, sums + b);
+}
 
-    const __m128i sum_s_32  = _mm_add_epi32(_mm_unpackhi_epi16(sum_s_16, z),
-                                            _mm_unpacklo_epi16(sum_s_16, z));
-    const __m128i sum_r_32  = _mm_add_epi32(_mm_unpackhi_epi16(sum_r_16, z),
-                                            _mm_unpacklo_epi16(sum_r_16, z));
-
-    __m128i sum_s_128;
-    __m128i sum_r_128;
-    __m128i sum_sq_s_128;
-    __m128i sum_sq_r_128;
-    __m128i sum_sxr_128;
-
-    _mm_store_si128 (&sum_s_128,
-                      _mm_add_epi64(_mm_unpackhi_epi32(sum_s_32, z),
-                                    _mm_unpacklo_epi32(sum_s_32, z)));
-    _mm_store_si128 (&sum_r_128,
-                      _mm_add_epi64(_mm_unpackhi_epi32(sum_r_32, z),
-                                    _mm_unpacklo_epi32(sum_r_32, z)));
-    _mm_store_si128 (&sum_sq_s_128,
-                      _mm_add_epi64(_mm_unpackhi_epi32(sum_sq_s_32, z),
-                                    _mm_unpacklo_epi32(sum_sq_s_32, z)));
-    _mm_store_si128 (&sum_sq_r_128,
-                      _mm_add_epi64(_mm_unpackhi_epi32(sum_sq_r_32, z),
-                                    _mm_unpacklo_epi32(sum_sq_r_32, z)));
-    _mm_store_si128 (&sum_sxr_128,
-                      _mm_add_epi64(_mm_unpackhi_epi32(sum_sxr_32, z),
-                                    _mm_unpacklo_epi32(sum_sxr_32, z)));
-
-    const WebRtc_UWord64 *sum_s_64 =
-                          reinterpret_cast<WebRtc_UWord64*>(&sum_s_128);
-    const WebRtc_UWord64 *sum_r_64 =
-                          reinterpret_cast<WebRtc_UWord64*>(&sum_r_128);
-    const WebRtc_UWord64 *sum_sq_s_64 =
-                          reinterpret_cast<WebRtc_UWord64*>(&sum_sq_s_128);
-    const WebRtc_UWord64 *sum_sq_r_64 =
-                          reinterpret_cast<WebRtc_UWord64*>(&sum_sq_r_128);
-    const WebRtc_UWord64 *sum_sxr_64 =
-                          reinterpret_cast<WebRtc_UWord64*>(&sum_sxr_128);
-
-    const WebRtc_UWord64 sum_s    = sum_s_64[0]    + sum_s_64[1];
-    const WebRtc_UWord64 sum_r    = sum_r_64[0]    + sum_r_64[1];
-    const WebRtc_UWord64 sum_sq_s = sum_sq_s_64[0] + sum_sq_s_64[1];
-    const WebRtc_UWord64 sum_sq_r = sum_sq_r_64[0] + sum_sq_r_64[1];
-    const WebRtc_UWord64 sum_sxr  = sum_sxr_64[0]  + sum_sxr_64[1];
-
-    return Similarity(sum_s, sum_r, sum_sq_s, sum_sq_r, sum_sxr, 64);
+// |test - ref| is formed with saturating subtractions and squared and summed
+// in pairs by _mm_madd_epi16. A row of up to 200000 pixels fits the 32-bit
+// sums.
+static WebRtc_UWord64
+SseRowSse2(const WebRtc_UWord8 *ref, const WebRtc_UWord8 *test,
+           WebRtc_Word32 length)
+{
+    const __m128i z = _mm_setzero_si128();
+    __m128i sse_32  = _mm_setzero_si128();
+    WebRtc_Word32 k = 0;
+
+    for (; k + 16 <= length; k += 16)
+    {
+        const __m128i r_8 = _mm_loadu_si128((const __m128i*)(ref + k));
+        const __m128i t_8 = _mm_loadu_si128((const __m128i*)(test + k));
+        const __m128i d_8 = _mm_or_si128(_mm_subs_epu8(r_8, t_8),
+                                         _mm_subs_epu8(t_8, r_8));
+        const __m128i d_lo = _mm_unpacklo_epi8(d_8, z);
+        const __m128i d_hi = _mm_unpackhi_epi8(d_8, z);
+        sse_32 = _mm_add_epi32(sse_32, _mm_madd_epi16(d_lo, d_lo));
+        sse_32 = _mm_add_epi32(sse_32, _mm_madd_epi16(d_hi, d_hi));
+    }
+
+    WebRtc_UWord64 sse_64[2];
+    _mm_storeu_si128((__m128i*)(sse_64),
+                     _mm_add_epi64(_mm_unpackhi_epi32(sse_32, z),
+                                   _mm_unpacklo_epi32(sse_32, z)));
+    return sse_64[0] + sse_64[1] + SseRowC(ref + k, test + k, length - k);
 }
 #endif
 
@@ -260,36 +252,327 @@ double
 SsimFrame(WebRtc_UWord8 *img1, WebRtc_UWord8 *img2, WebRtc_Word32 stride_img1,
           WebRtc_Word32 stride_img2, WebRtc_Word32 width, WebRtc_Word32 height)
 {
-    WebRtc_Word32 i,j;
     WebRtc_UWord32 samples = 0;
     double ssim_total = 0;
-    double (*ssim_8x8)(WebRtc_UWord8*, WebRtc_Word32,
-                       WebRtc_UWord8*, WebRtc_Word32 rp);
+    void (*block_sums_4x4)(const WebRtc_UWord8*, WebRtc_Word32,
+                           const WebRtc_UWord8*, WebRtc_Word32,
+                           WebRtc_Word32, BlockSums*);
 
 #if defined(WEBRTC_USE_SSE2)
-    ssim_8x8 = Ssim8x8Sse2;
+    block_sums_4x4 = BlockSums4x4Sse2;
 #else
-    ssim_8x8 = Ssim8x8C;
+    block_sums_4x4 = BlockSums4x4C;
 #endif
 
-    // Sample point start with each 4x4 location
-    for (i = 0; i < height - 8; i += 4, img1 += stride_img1 * 4,
-         img2 += stride_img2 * 4)
+    // Sample point start with each 4x4 location. The 8x8 window of a sample
+    // point covers the 2x2 blocks below and to the right of it.
+    const WebRtc_Word32 windowRows = (height - 8 + 3) / 4;
+    const WebRtc_Word32 windowCols = (width - 8 + 3) / 4;
+    if (windowRows > 0 && windowCols > 0)
     {
-        for (j = 0; j < width - 8; j += 4 )
+        std::vector<BlockSums> above(windowCols + 1);
+        std::vector<BlockSums> below(windowCols + 1);
+        block_sums_4x4(img1, stride_img1, img2, stride_img2,
+                       windowCols + 1, &above[0]);
+        for (WebRtc_Word32 i = 0; i < windowRows; i++)
         {
-            double v = ssim_8x8(img1 + j, stride_img1, img2 + j, stride_img2);
-            ssim_total += v;
-            samples++;
+            img1 += stride_img1 * 4;
+            img2 += stride_img2 * 4;
+            block_sums_4x4(img1, stride_img1, img2, stride_img2,
+                           windowCols + 1, &below[0]);
+            for (WebRtc_Word32 j = 0; j < windowCols; j++)
+            {
+                const BlockSums& a = above[j];
+                const BlockSums& b = above[j + 1];
+                const BlockSums& c = below[j];
+                const BlockSums& d = below[j + 1];
+                ssim_total += Similarity(
+                    a.sum_s + b.sum_s + c.sum_s + d.sum_s,
+                    a.sum_r + b.sum_r + c.sum_r + d.sum_r,
+                    a.sum_sq_s + b.sum_sq_s + c.sum_sq_s + d.sum_sq_s,
+                    a.sum_sq_r + b.sum_sq_r + c.sum_sq_r + d.sum_sq_r,
+                    a.sum_sxr + b.sum_sxr + c.sum_sxr + d.sum_sxr,
+                    64);
+                samples++;
+            }
+            above.swap(below);
         }
     }
     ssim_total /= samples;
     return ssim_total;
 }
 
+double
+MseFrame(const WebRtc_UWord8 *ref_frame, const WebRtc_UWord8 *test_frame,
+         WebRtc_Word32 width, WebRtc_Word32 height)
+{
+    WebRtc_UWord64 (*sse_row)(const WebRtc_UWord8*, const WebRtc_UWord8*,
+                              WebRtc_Word32);
+#if defined(WEBRTC_USE_SSE2)
+    sse_row = SseRowSse2;
+#else
+    sse_row = SseRowC;
+#endif
+
+    WebRtc_UWord64 sse = 0;
+    WebRtc_Word32 sh = 8; //boundary offset
+    for (WebRtc_Word32 k2 = sh; k2 < height - sh; k2++)
+    {
+        const WebRtc_Word32 kk = k2 * width + sh;
+        sse += sse_row(ref_frame + kk, test_frame + kk, width - 2 * sh);
+    }
+
+    // divide by number of pixels
+    return sse / (double) (width * height);
+}
+
+struct FrameQualityCalculator::Job
+{
+    explicit Job(int frame_length)
+        : frame_number(0),
+          ref(new WebRtc_UWord8[frame_length]),
+          test(new WebRtc_UWord8[frame_length]),
+          mse(0.0),
+          ssim(0.0) {}
+    ~Job()
+    {
+        delete [] ref;
+        delete [] test;
+    }
+
+    int frame_number;
+    WebRtc_UWord8 *ref;
+    WebRtc_UWord8 *test;
+    double mse;
+    double ssim;
+};
+
+FrameQualityCalculator::FrameQualityCalculator(WebRtc_Word32 width,
+                                               WebRtc_Word32 height,
+                                               int metrics,
+                                               int num_threads)
+    : width_(width),
+      height_(height),
+      frame_length_(3 * width * height / 2),
+      metrics_(metrics),
+      crit_(CriticalSectionWrapper::CreateCriticalSection()),
+      cond_(ConditionVariableWrapper::CreateConditionVariable()),
+      stop_(false)
+{
+    if (num_threads <= 0)
+    {
+        num_threads = webrtc::CpuInfo::DetectNumberOfCores();
+    }
+    if (num_threads > kMaxThreads)
+    {
+        num_threads = kMaxThreads;
+    }
+    for (int i = 0; i < num_threads; i++)
+    {
+        ThreadWrapper *thread = ThreadWrapper::CreateThread(
+            Run, this, webrtc::kNormalPriority, "FrameQualityCalculator");
+        unsigned int id = 0;
+        if (thread == NULL || !thread->Start(id))
+        {
+            fprintf(stderr, "Could not start worker thread\n");
+            delete thread;
+            break;
+        }
+        threads_.push_back(thread);
+    }
+
+    // Without threads the frames are calculated in AddFrame, one at a time
+    const size_t num_jobs = threads_.empty() ? 1 :
+                            kJobsPerThread * threads_.size();
+    for (size_t i = 0; i < num_jobs; i++)
+    {
+        jobs_.push_back(new Job(frame_length_));
+        free_jobs_.push_back(jobs_.back());
+    }
+}
+
+FrameQualityCalculator::~FrameQualityCalculator()
+{
+    {
+        CriticalSectionScoped lock(crit_);
+        stop_ = true;
+        cond_->WakeAll();
+    }
+    for (size_t i = 0; i < threads_.size(); i++)
+    {
+        threads_[i]->Stop();
+        delete threads_[i];
+    }
+    for (size_t i = 0; i < jobs_.size(); i++)
+    {
+        delete jobs_[i];
+    }
+    delete cond_;
+    delete crit_;
+}
+
+void
+FrameQualityCalculator::AddFrame(int frame_number,
+                                 const WebRtc_UWord8 *ref_frame,
+                                 const WebRtc_UWord8 *test_frame)
+{
+    Job *job = NULL;
+    {
+        CriticalSectionScoped lock(crit_);
+        while (free_jobs_.empty())
+        {
+            cond_->SleepCS(*crit_);
+        }
+        job = free_jobs_.back();
+        free_jobs_.pop_back();
+    }
+
+    job->frame_number = frame_number;
+    memcpy(job->ref, ref_frame, frame_length_);
+    memcpy(job->test, test_frame, frame_length_);
+
+    if (threads_.empty())
+    {
+        Calculate(job);
+        CriticalSectionScoped lock(crit_);
+        Finish(job);
+        return;
+    }
+    CriticalSectionScoped lock(crit_);
+    queued_jobs_.push_back(job);
+    cond_->WakeAll();
+}
+
 int
-SsimFromFiles(const WebRtc_Word8 *refFileName, const WebRtc_Word8 *testFileName,
-              WebRtc_Word32 width, WebRtc_Word32 height, QualityMetricsResult *result)
+FrameQualityCalculator::GetResults(QualityMetricsResult *psnr_result,
+                                   QualityMetricsResult *ssim_result)
+{
+    std::vector<FrameResult> mse_frames;
+    std::vector<FrameResult> ssim_frames;
+    {
+        CriticalSectionScoped lock(crit_);
+        while (free_jobs_.size() < jobs_.size())
+        {
+            cond_->SleepCS(*crit_);
+        }
+        mse_frames.swap(mse_frames_);
+        ssim_frames.swap(ssim_frames_);
+    }
+    if (mse_frames.empty() && ssim_frames.empty())
+    {
+        return -3;
+    }
+
+    // Sorted, the averages are summed in the same order for any number of
+    // threads
+    if (psnr_result != NULL && (metrics_ & kPsnr))
+    {
+        std::sort(mse_frames.begin(), mse_frames.end(),
+                  LessForFrameResultNumber);
+        double mseSum = 0.0;
+        for (size_t i = 0; i < mse_frames.size(); i++)
+        {
+            mseSum += mse_frames[i].value;
+            mse_frames[i].value = CalcPsnr(mse_frames[i].value);
+        }
+        if (mseSum == 0)
+        {
+            // The PSNR value is undefined in this case.
+            // This value effectively means that the files are equal.
+            psnr_result->average = std::numeric_limits<double>::max();
+        }
+        else
+        {
+            psnr_result->average = CalcPsnr(mseSum / mse_frames.size());
+        }
+        AddFrameResults(mse_frames, psnr_result);
+    }
+    if (ssim_result != NULL && (metrics_ & kSsim))
+    {
+        std::sort(ssim_frames.begin(), ssim_frames.end(),
+                  LessForFrameResultNumber);
+        double ssimScene = 0.0; //average SSIM for sequence
+        for (size_t i = 0; i < ssim_frames.size(); i++)
+        {
+            ssimScene += ssim_frames[i].value;
+        }
+        ssim_result->average = ssimScene / ssim_frames.size();
+        AddFrameResults(ssim_frames, ssim_result);
+    }
+    return 0;
+}
+
+bool
+FrameQualityCalculator::Run(void *obj)
+{
+    return static_cast<FrameQualityCalculator*>(obj)->Process();
+}
+
+bool
+FrameQualityCalculator::Process()
+{
+    Job *job = NULL;
+    {
+        CriticalSectionScoped lock(crit_);
+        while (queued_jobs_.empty() && !stop_)
+        {
+            cond_->SleepCS(*crit_);
+        }
+        if (queued_jobs_.empty())
+        {
+            return false;  // stopped and all frames calculated
+        }
+        job = queued_jobs_.front();
+        queued_jobs_.pop_front();
+    }
+
+    Calculate(job);
+
+    CriticalSectionScoped lock(crit_);
+    Finish(job);
+    return true;
+}
+
+void
+FrameQualityCalculator::Calculate(Job *job)
+{
+    if (metrics_ & kPsnr)
+    {
+        job->mse = MseFrame(job->ref, job->test, width_, height_);
+    }
+    if (metrics_ & kSsim)
+    {
+        job->ssim = SsimFrame(job->ref, job->test, width_, width_,
+                              width_, height_);
+    }
+}
+
+void
+FrameQualityCalculator::Finish(Job *job)
+{
+    FrameResult frame_result;
+    frame_result.frame_number = job->frame_number;
+    if (metrics_ & kPsnr)
+    {
+        frame_result.value = job->mse;
+        mse_frames_.push_back(frame_result);
+    }
+    if (metrics_ & kSsim)
+    {
+        frame_result.value = job->ssim;
+        ssim_frames_.push_back(frame_result);
+    }
+    free_jobs_.push_back(job);
+    cond_->WakeAll();
+}
+
+// Streams the frames of both files through a FrameQualityCalculator
+static int
+MetricsFromFiles(const WebRtc_Word8 *refFileName,
+                 const WebRtc_Word8 *testFileName,
+                 WebRtc_Word32 width, WebRtc_Word32 height,
+                 FrameQualityCalculator::Metrics metric,
+                 QualityMetricsResult *result)
 {
     FILE *refFp = fopen(refFileName, "rb");
     if (refFp == NULL)
@@ -298,70 +581,74 @@ SsimFromFiles(const WebRtc_Word8 *refFileName, const WebRtc_Word8 *testFileName,
         fprintf(stderr, "Cannot open file %s\n", refFileName);
         return -1;
     }
+    fclose(refFp);
 
     FILE *testFp = fopen(testFileName, "rb");
     if (testFp == NULL)
     {
         // cannot open test file
         fprintf(stderr, "Cannot open file %s\n", testFileName);
-        fclose(refFp);
         return -2;
     }
+    fclose(testFp);
 
-    WebRtc_Word32 frames = 0;
-
+    const char *metricName = (metric == FrameQualityCalculator::kPsnr) ?
+                             "PSNR" : "SSIM";
     // Bytes in one frame I420
-    const WebRtc_Word32 frameBytes = 3 * width  * height / 2;
-    WebRtc_UWord8 *ref = new WebRtc_UWord8[frameBytes];
-    WebRtc_UWord8 *test = new WebRtc_UWord8[frameBytes];
-
-    WebRtc_Word32 refBytes = (WebRtc_Word32) fread(ref, 1, frameBytes, refFp);
-    WebRtc_Word32 testBytes = (WebRtc_Word32) fread(test, 1, frameBytes, testFp);
-
-    double ssimScene = 0.0; //average SSIM for sequence
-
-    while (refBytes == frameBytes && testBytes == frameBytes )
+    const WebRtc_Word32 frameBytes = 3 * width * height / 2;
+    webrtc::test::FrameReaderImpl refReader(refFileName, frameBytes);
+    webrtc::test::FrameReaderImpl testReader(testFileName, frameBytes);
+    if (!refReader.Init() || !testReader.Init())
     {
-        double ssimFrameValue = SsimFrame(ref, test, width, width, width, height);
-        // Save statistics for this specific frame
-        FrameResult frame_result;
-        frame_result.value = ssimFrameValue;
-        frame_result.frame_number = frames;
-        result->frames.push_back(frame_result);
-
-        ssimScene += ssimFrameValue;
-        frames++;
-
-        refBytes = (WebRtc_Word32) fread(ref, 1, frameBytes, refFp);
-        testBytes = (WebRtc_Word32) fread(test, 1, frameBytes, testFp);
+        fprintf(stderr, "Tried to measure %s from empty files (reference "
+                "file: %s  test file: %s\n", metricName, refFileName,
+                testFileName);
+        return -3;
     }
+
+    WebRtc_UWord8 *ref = new WebRtc_UWord8[frameBytes];
+    WebRtc_UWord8 *test = new WebRtc_UWord8[frameBytes];
     int return_code = 0;
-    if (result->frames.size() == 0)
     {
-      fprintf(stderr, "Tried to measure SSIM from empty files (reference "
-              "file: %s  test file: %s\n", refFileName, testFileName);
-      return_code = -3;
+        FrameQualityCalculator calculator(width, height, metric, 0);
+        WebRtc_Word32 frames = 0;
+        while (refReader.ReadFrame(ref) && testReader.ReadFrame(test))
+        {
+            calculator.AddFrame(frames, ref, test);
+            frames++;
+        }
+        if (metric == FrameQualityCalculator::kPsnr)
+        {
+            return_code = calculator.GetResults(result, NULL);
+        }
+        else
+        {
+            return_code = calculator.GetResults(NULL, result);
+        }
     }
-    else
+    if (return_code != 0)
     {
-        // SSIM: normalize/average for sequence
-        ssimScene  = ssimScene / frames;
-        result->average = ssimScene;
-
-        // Calculate min/max statistics
-        std::vector<FrameResult>::iterator element;
-        element = min_element(result->frames.begin(),
-                              result->frames.end(), LessForFrameResultValue);
-        result->min = element->value;
-        result->min_frame_number = element->frame_number;
-        element = max_element(result->frames.begin(),
-                              result->frames.end(), LessForFrameResultValue);
-        result->max = element->value;
-        result->max_frame_number = element->frame_number;
+        fprintf(stderr, "Tried to measure %s from empty files (reference "
+                "file: %s  test file: %s\n", metricName, refFileName,
+                testFileName);
     }
     delete [] ref;
     delete [] test;
-    fclose(refFp);
-    fclose(testFp);
     return return_code;
 }
+
+int
+PsnrFromFiles(const WebRtc_Word8 *refFileName, const WebRtc_Word8 *testFileName,
+              WebRtc_Word32 width, WebRtc_Word32 height, QualityMetricsResult *result)
+{
+    return MetricsFromFiles(refFileName, testFileName, width, height,
+                            FrameQualityCalculator::kPsnr, result);
+}
+
+int
+SsimFromFiles(const WebRtc_Word8 *refFileName, const WebRtc_Word8 *testFileName,
+              WebRtc_Word32 width, WebRtc_Word32 height, QualityMetricsResult *result)
+{
+    return MetricsFromFiles(refFileName, testFileName, width, height,
+                            FrameQualityCalculator::kSsim, result);
+}
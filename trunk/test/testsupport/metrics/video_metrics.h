@@ -11,11 +11,18 @@
 #ifndef WEBRTC_MODULES_VIDEO_CODING_TEST_VIDEO_METRICS_H_
 #define WEBRTC_MODULES_VIDEO_CODING_TEST_VIDEO_METRICS_H_
 
+#include <deque>
 #include <limits>
 #include <vector>
 
 #include "typedefs.h"
 
+namespace webrtc {
+class ConditionVariableWrapper;
+class CriticalSectionWrapper;
+class ThreadWrapper;
+}
+
 // Contains video quality metrics result for a single frame.
 struct FrameResult {
   WebRtc_Word32 frame_number;
@@ -42,6 +49,10 @@ struct QualityMetricsResult {
 
 // PSNR & SSIM calculations
 
+// The file based calculations read the files on the calling thread and
+// calculate the frames on one worker thread per core, see
+// FrameQualityCalculator. The results do not depend on the number of threads.
+
 // PSNR values are filled into the QualityMetricsResult struct.
 // If the result is std::numerical_limits<double>::max() the videos were
 // equal. Otherwise, PSNR values are in decibel (higher is better). This
@@ -73,8 +84,74 @@ int SsimFromFiles(const WebRtc_Word8 *refFileName,
                   const WebRtc_Word8 *testFileName, WebRtc_Word32 width,
                   WebRtc_Word32 height, QualityMetricsResult *result);
 
+// Returns the mean SSIM of the 8x8 windows at every 4th row and column of two
+// planes. The sums of each 4x4 block are calculated once and shared by the
+// four windows that contain the block.
 double SsimFrame(WebRtc_UWord8 *img1, WebRtc_UWord8 *img2,
                  WebRtc_Word32 stride_img1, WebRtc_Word32 stride_img2,
                  WebRtc_Word32 width, WebRtc_Word32 height);
 
+// Returns the mean squared error of the luma planes of two I420 frames, as
+// used by PsnrFromFiles. A border of 8 pixels is not compared.
+double MseFrame(const WebRtc_UWord8 *ref_frame,
+                const WebRtc_UWord8 *test_frame,
+                WebRtc_Word32 width, WebRtc_Word32 height);
+
+// Calculates the PSNR and/or SSIM of pairs of I420 frames on worker threads,
+// so that the thread adding the frames, e.g. a file reader or an encoding
+// loop, does not wait for the calculations. The frames are copied;
+// AddFrame() only blocks when all frame buffers are queued.
+class FrameQualityCalculator {
+ public:
+  enum Metrics {
+    kPsnr = 1,
+    kSsim = 2
+  };
+
+  // |metrics| is a combination of Metrics. If |num_threads| is 0 one thread
+  // per core is used. Without threads, the frames are calculated in
+  // AddFrame().
+  FrameQualityCalculator(WebRtc_Word32 width, WebRtc_Word32 height,
+                         int metrics, int num_threads);
+  ~FrameQualityCalculator();
+
+  // Queues the frames with number |frame_number| for calculation.
+  void AddFrame(int frame_number, const WebRtc_UWord8* ref_frame,
+                const WebRtc_UWord8* test_frame);
+
+  // Waits for all queued frames and adds their values, in frame number order,
+  // to the results of the calculated metrics. Either result may be NULL. The
+  // calculator may be reused afterwards.
+  // Returns 0 if successful, -3 if no frames have been added.
+  int GetResults(QualityMetricsResult* psnr_result,
+                 QualityMetricsResult* ssim_result);
+
+ private:
+  struct Job;
+
+  static bool Run(void* obj);
+  bool Process();
+  void Calculate(Job* job);
+  // Stores the results of |job| and returns it to the free jobs.
+  // The critical section must be held.
+  void Finish(Job* job);
+
+  const WebRtc_Word32 width_;
+  const WebRtc_Word32 height_;
+  const int frame_length_;
+  const int metrics_;
+
+  webrtc::CriticalSectionWrapper* crit_;
+  webrtc::ConditionVariableWrapper* cond_;
+  std::vector<webrtc::ThreadWrapper*> threads_;
+  std::vector<Job*> jobs_;
+  std::vector<Job*> free_jobs_;
+  std::deque<Job*> queued_jobs_;
+  bool stop_;
+
+  // Per frame MSE and SSIM, in the order the frames were finished.
+  std::vector<FrameResult> mse_frames_;
+  std::vector<FrameResult> ssim_frames_;
+};
+
 #endif // WEBRTC_MODULES_VIDEO_CODING_TEST_VIDEO_METRICS_H_
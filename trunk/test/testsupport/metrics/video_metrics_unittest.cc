@@ -11,6 +11,8 @@
 #include "testsupport/metrics/video_metrics.h"
 
 #include <cstdio>
+#include <cstdlib>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "testsupport/fileutils.h"
@@ -27,6 +29,65 @@ static const int kMissingTestFileReturnCode = -2;
 static const int kEmptyFileReturnCode = -3;
 static const double kPsnrPerfectResult =  std::numeric_limits<double>::max();
 static const double kSsimPerfectResult = 1.0;
+static const int kFrameLength = 3 * kWidth * kHeight / 2;
+static const int kNumberOfFrames = 10;
+
+// Fills |frame| with noise around a gradient, so that the frames differ
+// between seeds but are still similar.
+static void FillFrame(unsigned int seed, std::vector<WebRtc_UWord8>* frame) {
+  srand(seed);
+  frame->resize(kFrameLength);
+  for (int i = 0; i < kFrameLength; ++i) {
+    int value = (i % kWidth) / 2 + rand() % 64;
+    (*frame)[i] = static_cast<WebRtc_UWord8>(value > 255 ? 255 : value);
+  }
+}
+
+// SSIM of every 8x8 window at every 4th row and column, calculated directly.
+static double ReferenceSsim(const WebRtc_UWord8* img1,
+                            const WebRtc_UWord8* img2) {
+  double ssim_total = 0;
+  int samples = 0;
+  for (int i = 0; i < kHeight - 8; i += 4) {
+    for (int j = 0; j < kWidth - 8; j += 4) {
+      WebRtc_Word64 sum_s = 0, sum_r = 0, sum_sq_s = 0, sum_sq_r = 0;
+      WebRtc_Word64 sum_sxr = 0;
+      for (int y = i; y < i + 8; ++y) {
+        for (int x = j; x < j + 8; ++x) {
+          const int s = img1[y * kWidth + x];
+          const int r = img2[y * kWidth + x];
+          sum_s += s;
+          sum_r += r;
+          sum_sq_s += s * s;
+          sum_sq_r += r * r;
+          sum_sxr += s * r;
+        }
+      }
+      const WebRtc_Word64 c1 = (26634 * 64 * 64) >> 12;
+      const WebRtc_Word64 c2 = (239708 * 64 * 64) >> 12;
+      const WebRtc_Word64 ssim_n = (2 * sum_s * sum_r + c1) *
+          (2 * 64 * sum_sxr - 2 * sum_s * sum_r + c2);
+      const WebRtc_Word64 ssim_d = (sum_s * sum_s + sum_r * sum_r + c1) *
+          (64 * sum_sq_s - sum_s * sum_s + 64 * sum_sq_r - sum_r * sum_r + c2);
+      ssim_total += ssim_n * 1.0 / ssim_d;
+      ++samples;
+    }
+  }
+  return ssim_total / samples;
+}
+
+// MSE of the luma plane without the 8 pixel border, calculated directly.
+static double ReferenceMse(const WebRtc_UWord8* ref,
+                           const WebRtc_UWord8* test) {
+  double mse = 0.0;
+  for (int y = 8; y < kHeight - 8; ++y) {
+    for (int x = 8; x < kWidth - 8; ++x) {
+      const int diff = test[y * kWidth + x] - ref[y * kWidth + x];
+      mse += diff * diff;
+    }
+  }
+  return mse / (kWidth * kHeight);
+}
 
 class VideoMetricsTest: public testing::Test {
  protected:
@@ -93,5 +154,110 @@ TEST_F(VideoMetricsTest, EmptyFiles) {
                           &result_));
 }
 
+// Tests that the frame kernels give the same values as a direct calculation.
+TEST_F(VideoMetricsTest, FrameKernelsMatchReference) {
+  std::vector<WebRtc_UWord8> ref;
+  std::vector<WebRtc_UWord8> test;
+  for (unsigned int seed = 1; seed <= 3; ++seed) {
+    FillFrame(seed, &ref);
+    FillFrame(seed + 100, &test);
+    EXPECT_EQ(ReferenceSsim(&ref[0], &test[0]),
+              SsimFrame(&ref[0], &test[0], kWidth, kWidth, kWidth, kHeight));
+    EXPECT_EQ(ReferenceMse(&ref[0], &test[0]),
+              MseFrame(&ref[0], &test[0], kWidth, kHeight));
+  }
+  EXPECT_EQ(1.0, SsimFrame(&ref[0], &ref[0], kWidth, kWidth, kWidth, kHeight));
+  EXPECT_EQ(0.0, MseFrame(&ref[0], &ref[0], kWidth, kHeight));
+}
+
+// Tests that the results of the calculator do not depend on the number of
+// threads and that the frames are reported in frame number order.
+TEST_F(VideoMetricsTest, CalculatorResultsIndependentOfThreads) {
+  std::vector<std::vector<WebRtc_UWord8> > refs(kNumberOfFrames);
+  std::vector<std::vector<WebRtc_UWord8> > tests(kNumberOfFrames);
+  for (int i = 0; i < kNumberOfFrames; ++i) {
+    FillFrame(i, &refs[i]);
+    FillFrame(i + 100, &tests[i]);
+  }
+  const int kThreads[] = {0, 1, 4};
+  QualityMetricsResult first_psnr;
+  QualityMetricsResult first_ssim;
+  for (size_t t = 0; t < sizeof(kThreads) / sizeof(kThreads[0]); ++t) {
+    FrameQualityCalculator calculator(
+        kWidth, kHeight,
+        FrameQualityCalculator::kPsnr | FrameQualityCalculator::kSsim,
+        kThreads[t]);
+    for (int i = 0; i < kNumberOfFrames; ++i) {
+      calculator.AddFrame(i, &refs[i][0], &tests[i][0]);
+    }
+    QualityMetricsResult psnr;
+    QualityMetricsResult ssim;
+    ASSERT_EQ(0, calculator.GetResults(&psnr, &ssim));
+    ASSERT_EQ(static_cast<size_t>(kNumberOfFrames), psnr.frames.size());
+    ASSERT_EQ(static_cast<size_t>(kNumberOfFrames), ssim.frames.size());
+    for (int i = 0; i < kNumberOfFrames; ++i) {
+      EXPECT_EQ(i, psnr.frames[i].frame_number);
+      EXPECT_EQ(i, ssim.frames[i].frame_number);
+    }
+    if (t == 0) {
+      first_psnr = psnr;
+      first_ssim = ssim;
+      continue;
+    }
+    EXPECT_EQ(first_psnr.average, psnr.average);
+    EXPECT_EQ(first_ssim.average, ssim.average);
+    EXPECT_EQ(first_ssim.min_frame_number, ssim.min_frame_number);
+    EXPECT_EQ(first_psnr.max_frame_number, psnr.max_frame_number);
+  }
+  // All results have been taken.
+  FrameQualityCalculator calculator(kWidth, kHeight,
+                                    FrameQualityCalculator::kPsnr, 2);
+  EXPECT_EQ(kEmptyFileReturnCode, calculator.GetResults(&result_, NULL));
+}
+
+// Tests that the file based calculations agree with the calculator.
+TEST_F(VideoMetricsTest, FilesMatchCalculator) {
+  const char* kRefFileName = "video_metrics_unittest_ref.tmp";
+  const char* kTestFileName = "video_metrics_unittest_test.tmp";
+  FILE* ref_file = fopen(kRefFileName, "wb");
+  FILE* test_file = fopen(kTestFileName, "wb");
+  ASSERT_TRUE(ref_file != NULL);
+  ASSERT_TRUE(test_file != NULL);
+  FrameQualityCalculator calculator(
+      kWidth, kHeight,
+      FrameQualityCalculator::kPsnr | FrameQualityCalculator::kSsim, 1);
+  std::vector<WebRtc_UWord8> ref;
+  std::vector<WebRtc_UWord8> test;
+  for (int i = 0; i < kNumberOfFrames; ++i) {
+    FillFrame(i, &ref);
+    FillFrame(i + 100, &test);
+    fwrite(&ref[0], 1, kFrameLength, ref_file);
+    fwrite(&test[0], 1, kFrameLength, test_file);
+    calculator.AddFrame(i, &ref[0], &test[0]);
+  }
+  // A partial frame at the end is ignored.
+  fwrite(&ref[0], 1, kFrameLength / 2, ref_file);
+  fclose(ref_file);
+  fclose(test_file);
+
+  QualityMetricsResult psnr;
+  QualityMetricsResult ssim;
+  ASSERT_EQ(0, calculator.GetResults(&psnr, &ssim));
+  QualityMetricsResult file_psnr;
+  QualityMetricsResult file_ssim;
+  EXPECT_EQ(0, PsnrFromFiles(kRefFileName, kTestFileName, kWidth, kHeight,
+                             &file_psnr));
+  EXPECT_EQ(0, SsimFromFiles(kRefFileName, kTestFileName, kWidth, kHeight,
+                             &file_ssim));
+  std::remove(kRefFileName);
+  std::remove(kTestFileName);
+
+  ASSERT_EQ(psnr.frames.size(), file_psnr.frames.size());
+  EXPECT_EQ(psnr.average, file_psnr.average);
+  EXPECT_EQ(ssim.average, file_ssim.average);
+  EXPECT_EQ(psnr.min, file_psnr.min);
+  EXPECT_EQ(ssim.max, file_ssim.max);
+}
+
 }  // namespace webrtc
 